@@ -0,0 +1,89 @@
+#ifndef CLUSTERED_LIGHTS_GLSL
+#define CLUSTERED_LIGHTS_GLSL
+
+#include "PointLight.glsl"
+
+// Filled by ClusteredLighting. Every texture is laid out in rows of
+// B_ClusterTexRowWidth texels:
+//   - Light data: 2 texels per light, (pos, range) and (color, intensity).
+//     Shadow casting lights have a negative intensity.
+//   - Grid: 1 texel per cluster, (offset, count) into the indices.
+//   - Indices: 4 light indices per texel.
+uniform sampler2D B_ClusterLightData;
+uniform sampler2D B_ClusterGrid;
+uniform sampler2D B_ClusterLightIndices;
+uniform int  B_ClusterNumTilesX;
+uniform int  B_ClusterNumTilesY;
+uniform int  B_ClusterNumSlices;
+uniform int  B_ClusterTexRowWidth;
+uniform vec2 B_ClusterDepthSliceParams;
+uniform int  B_ClusterNumLights;
+
+vec4 B_FetchClusterTexel(const sampler2D tex, const int texelIndex)
+{
+    ivec2 coord = ivec2(texelIndex % B_ClusterTexRowWidth,
+                        texelIndex / B_ClusterTexRowWidth);
+    return texelFetch(tex, coord, 0);
+}
+
+vec3 GetClusteredPointLightsApport(const vec3  pixelPosWorld,
+                                   const vec3  pixelNormalWorld,
+                                   const vec3  pixelAlbedo,
+                                   const float pixelRoughness,
+                                   const float pixelMetalness,
+                                   const bool  skipShadowCasters)
+{
+    vec3 lightApport = vec3(0);
+    if (B_ClusterNumLights <= 0)
+    {
+        return lightApport;
+    }
+
+    float pixelDepth = -(B_View * vec4(pixelPosWorld, 1)).z;
+    float slice = log(max(pixelDepth, 0.0001)) * B_ClusterDepthSliceParams.x +
+                  B_ClusterDepthSliceParams.y;
+
+    vec2 viewportUv = clamp(B_GetViewportUv(), 0.0, 0.9999);
+    ivec3 cluster = ivec3(int(viewportUv.x * B_ClusterNumTilesX),
+                          int(viewportUv.y * B_ClusterNumTilesY),
+                          clamp(int(slice), 0, B_ClusterNumSlices - 1));
+    int clusterIndex = (cluster.z * B_ClusterNumTilesY + cluster.y) *
+                       B_ClusterNumTilesX + cluster.x;
+
+    vec2 offsetCount = B_FetchClusterTexel(B_ClusterGrid, clusterIndex).xy;
+    int offset = int(offsetCount.x);
+    int count  = int(offsetCount.y);
+    for (int i = offset; i < offset + count; ++i)
+    {
+        int lightIndex =
+            int(B_FetchClusterTexel(B_ClusterLightIndices, i / 4)[i % 4]);
+        vec4 lightPosRange = B_FetchClusterTexel(B_ClusterLightData,
+                                                 lightIndex * 2 + 0);
+        vec4 lightColorIntensity = B_FetchClusterTexel(B_ClusterLightData,
+                                                       lightIndex * 2 + 1);
+        float lightIntensity = lightColorIntensity.a;
+        if (lightIntensity < 0.0)
+        {
+            if (skipShadowCasters)
+            {
+                continue;
+            }
+            lightIntensity = -lightIntensity;
+        }
+
+        lightApport += GetPointLightColorApportation(lightPosRange.xyz,
+                                                     lightPosRange.w,
+                                                     lightIntensity,
+                                                     lightColorIntensity.rgb,
+                                                     B_Camera_WorldPos.xyz,
+                                                     pixelPosWorld,
+                                                     pixelNormalWorld,
+                                                     pixelAlbedo,
+                                                     false,
+                                                     pixelRoughness,
+                                                     pixelMetalness);
+    }
+    return lightApport;
+}
+
+#endif
@@ -0,0 +1,28 @@
+#define BANG_FRAGMENT
+#define BANG_DEFERRED_RENDERING
+
+#include "ClusteredLights.glsl"
+
+in vec3 B_FIn_Position;
+in vec2 B_FIn_AlbedoUv;
+
+layout(location = 0) out vec4 B_GIn_Light;
+
+void main()
+{
+    if (B_SampleReceivesLight())
+    {
+        vec3 lightApport =
+                GetClusteredPointLightsApport(B_ComputeWorldPosition(),
+                                              B_SampleNormal(),
+                                              B_SampleAlbedoColor().rgb,
+                                              B_SampleRoughness(),
+                                              B_SampleMetalness(),
+                                              true);
+        B_GIn_Light = vec4(lightApport, 1);
+    }
+    else
+    {
+        B_GIn_Light = vec4(0);
+    }
+}
@@ -3,6 +3,7 @@
 #include "LightCommon.glsl"
 
 uniform sampler2D B_DecalTexture;
+uniform float B_DecalFade;
 uniform mat4 B_DecalViewMatrix;
 uniform mat4 B_DecalProjectionMatrix;
 
@@ -29,6 +30,7 @@ void main()
     uv = vec2(uv.x, 1.0f - uv.y);
 
     vec4 pixelAlbedo = texture(B_DecalTexture, uv);
+    pixelAlbedo.a *= B_DecalFade;
     vec3 pixelNormal = B_SampleNormal();
     float pixelRoughness = B_SampleRoughness();
     float pixelMetalness = B_SampleMetalness();
@@ -0,0 +1,22 @@
+#define BANG_FRAGMENT
+#include "Common.glsl"
+
+uniform sampler2D B_RenderTexture_Texture;
+
+// Size of the padding around the atlas entry, relative to the entry size.
+// The padding gets the edge texels of the texture
+uniform vec2 B_DecalAtlasEntryPadding;
+
+in vec2 B_FIn_AlbedoUv;
+
+layout(location = 0) out vec4 B_GIn_Color;
+
+void main()
+{
+    vec2 halfTexelSize = 0.5 / vec2(textureSize(B_RenderTexture_Texture, 0));
+    vec2 uv = mix(-B_DecalAtlasEntryPadding,
+                  1.0 + B_DecalAtlasEntryPadding,
+                  B_FIn_AlbedoUv);
+    uv = clamp(uv, halfTexelSize, 1.0 - halfTexelSize);
+    B_GIn_Color = texture(B_RenderTexture_Texture, uv);
+}
@@ -0,0 +1,125 @@
+#define BANG_FRAGMENT
+#include "Common.glsl"
+#include "LightCommon.glsl"
+
+// Filled by DecalBatcher. Every data texture is laid out in rows of
+// B_DecalTexRowWidth texels:
+//   - Decal data: 6 texels per decal, the 4 columns of the world to decal
+//     clip space matrix, the atlas uv rect (min, max), and (fade, -, -, -).
+//   - Grid: 1 texel per screen tile of B_DecalTileSize pixels, (offset,
+//     count) into the indices.
+//   - Indices: 4 decal indices per texel, in the order they were added.
+uniform sampler2D B_DecalData;
+uniform sampler2D B_DecalGrid;
+uniform sampler2D B_DecalIndices;
+uniform sampler2D B_DecalAtlas;
+uniform float B_DecalAtlasMaxMipLevel;
+uniform int B_DecalTileSize;
+uniform int B_DecalNumTilesX;
+uniform int B_DecalNumTilesY;
+uniform int B_DecalTexRowWidth;
+
+in vec2 B_FIn_AlbedoUv;
+
+layout(location = 0) out vec4 B_GIn_Albedo;
+layout(location = 1) out vec4 B_GIn_Color;
+
+vec4 B_FetchDecalTexel(const sampler2D tex, const int texelIndex)
+{
+    ivec2 coord = ivec2(texelIndex % B_DecalTexRowWidth,
+                        texelIndex / B_DecalTexRowWidth);
+    return texelFetch(tex, coord, 0);
+}
+
+void main()
+{
+    // The world position derivatives are taken before any discard, they give
+    // the atlas mip level of every decal
+    vec3 pixelWorldPos = B_ComputeWorldPosition();
+    vec3 pixelWorldPosDx = dFdx(pixelWorldPos);
+    vec3 pixelWorldPosDy = dFdy(pixelWorldPos);
+
+    ivec2 tile = ivec2(B_GetViewportPos()) / B_DecalTileSize;
+    tile = min(tile, ivec2(B_DecalNumTilesX, B_DecalNumTilesY) - 1);
+    int tileIndex = tile.y * B_DecalNumTilesX + tile.x;
+    vec2 offsetCount = B_FetchDecalTexel(B_DecalGrid, tileIndex).xy;
+    int offset = int(offsetCount.x);
+    int count  = int(offsetCount.y);
+    if (count == 0)
+    {
+        discard;
+    }
+
+    // Premultiplied "over" of the tile decals, in order. The output is
+    // unpremultiplied again, so that the SRC_ALPHA blending of the decals
+    // pass gives the same as blending them one by one
+    vec2 atlasSize = vec2(textureSize(B_DecalAtlas, 0));
+    vec3 albedoPremult = vec3(0);
+    float alpha = 0.0;
+    for (int i = offset; i < offset + count; ++i)
+    {
+        int decalIndex = int(B_FetchDecalTexel(B_DecalIndices, i / 4)[i % 4]);
+        int texelIndex = decalIndex * 6;
+        mat4 worldToDecal =
+                mat4(B_FetchDecalTexel(B_DecalData, texelIndex + 0),
+                     B_FetchDecalTexel(B_DecalData, texelIndex + 1),
+                     B_FetchDecalTexel(B_DecalData, texelIndex + 2),
+                     B_FetchDecalTexel(B_DecalData, texelIndex + 3));
+        vec4 pixelProj = worldToDecal * vec4(pixelWorldPos, 1);
+        if (pixelProj.w <= 0.0)
+        {
+            continue;
+        }
+        pixelProj.xyz /= pixelProj.w;
+        if (pixelProj.x < -1.0 || pixelProj.x > 1.0 ||
+            pixelProj.y < -1.0 || pixelProj.y > 1.0 ||
+            pixelProj.z < -1.0 || pixelProj.z > 1.0)
+        {
+            continue;
+        }
+
+        vec4 atlasUvRect = B_FetchDecalTexel(B_DecalData, texelIndex + 4);
+        float fade = B_FetchDecalTexel(B_DecalData, texelIndex + 5).x;
+        vec2 uv = pixelProj.xy * 0.5 + 0.5;
+        uv = vec2(uv.x, 1.0f - uv.y);
+
+        // Atlas texels per pixel, from the neighbour pixels projected into
+        // the decal. Clamped to the mip levels the atlas padding allows
+        vec4 projDx = worldToDecal * vec4(pixelWorldPos + pixelWorldPosDx, 1);
+        vec4 projDy = worldToDecal * vec4(pixelWorldPos + pixelWorldPosDy, 1);
+        vec2 atlasRectSize = (atlasUvRect.zw - atlasUvRect.xy) * atlasSize;
+        vec2 texelsDx = (projDx.xy / projDx.w - pixelProj.xy) * 0.5 *
+                        atlasRectSize;
+        vec2 texelsDy = (projDy.xy / projDy.w - pixelProj.xy) * 0.5 *
+                        atlasRectSize;
+        float maxTexelsSq = max(dot(texelsDx, texelsDx),
+                                dot(texelsDy, texelsDy));
+        float mipLevel = clamp(0.5 * log2(max(maxTexelsSq, 1e-8)),
+                               0.0,
+                               B_DecalAtlasMaxMipLevel);
+
+        vec4 decalAlbedo = textureLod(B_DecalAtlas,
+                                      mix(atlasUvRect.xy, atlasUvRect.zw, uv),
+                                      mipLevel);
+        float decalAlpha = decalAlbedo.a * fade;
+        albedoPremult = decalAlbedo.rgb * decalAlpha +
+                        albedoPremult * (1.0 - decalAlpha);
+        alpha = decalAlpha + alpha * (1.0 - decalAlpha);
+    }
+
+    if (alpha <= 0.0)
+    {
+        discard;
+    }
+
+    // The ambient is computed once with the blended albedo
+    vec4 pixelAlbedo = vec4(albedoPremult / alpha, alpha);
+    vec3 pixelNormal = B_SampleNormal();
+    float pixelRoughness = B_SampleRoughness();
+    float pixelMetalness = B_SampleMetalness();
+    vec4 finalColor = GetIBLAmbientColor(true,
+                                         pixelWorldPos, pixelNormal, pixelAlbedo,
+                                         pixelRoughness, pixelMetalness);
+    B_GIn_Albedo = pixelAlbedo;
+    B_GIn_Color = finalColor;
+}
@@ -45,7 +45,13 @@ void DefaultFragCommonMain(vec4 albedoColor)
         if (B_HasNormalMapTexture)
         {
             vec3 normalFromMap = texture(B_NormalMapTexture, B_FIn_NormalMapUv).xyz;
-            normalFromMap.xy = (normalFromMap.xy * 2.0f - 1.0f) * B_NormalMapMultiplyFactor;
+            normalFromMap.xy = (normalFromMap.xy * 2.0f - 1.0f);
+            if (B_NormalMapIsRG)
+            {
+                // Two channels map (BC5), z is not stored
+                normalFromMap.z = sqrt(max(1.0f - dot(normalFromMap.xy, normalFromMap.xy), 0.0f));
+            }
+            normalFromMap.xy *= B_NormalMapMultiplyFactor;
             normalFromMap = B_TBN * normalFromMap;
             finalNormal = normalFromMap;
         }
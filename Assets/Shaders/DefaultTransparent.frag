@@ -1,3 +1,3 @@
-#define BANG_NORMAL_MAPPING
+#pragma multi_compile _ BANG_NORMAL_MAPPING
 #define BANG_FORWARD_RENDERING
 #include "DefaultFragCommon.glsl"
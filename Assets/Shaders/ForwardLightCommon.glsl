@@ -3,7 +3,7 @@
 
 #if defined(BANG_FORWARD_RENDERING)
 
-#include "PointLight.glsl"
+#include "ClusteredLights.glsl"
 #include "DirectionalLight.glsl"
 
 vec3 GetForwardLightApport(const vec3  pixelPosWorld,
@@ -15,6 +15,16 @@ vec3 GetForwardLightApport(const vec3  pixelPosWorld,
     vec3 lightColorApportation = vec3(0.0f);
     if (B_MaterialReceivesLighting)
     {
+        // Point lights come from the clusters, the arrays only have the
+        // directional ones
+        lightColorApportation +=
+            GetClusteredPointLightsApport(pixelPosWorld,
+                                          pixelNormalWorld,
+                                          pixelAlbedo,
+                                          pixelRoughness,
+                                          pixelMetalness,
+                                          false);
+
         for (int i = 0; i < B_ForwardRenderingLightNumber; ++i)
         {
             int lightType = B_ForwardRenderingLightTypes[i];
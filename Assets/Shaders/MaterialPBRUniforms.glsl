@@ -10,6 +10,7 @@ uniform float     B_MaterialRoughness;
 uniform float     B_MaterialMetalness;
 uniform vec2      B_NormalMapUvMultiply;
 uniform bool      B_HasNormalMapTexture;
+uniform bool      B_NormalMapIsRG;
 uniform float     B_NormalMapMultiplyFactor;
 
 #endif
@@ -10,14 +10,17 @@ uniform vec3 B_RandomHemisphereOffsetsArray[MAX_RANDOM_OFFSETS];
 
 void main()
 {
-    float depth   = B_SampleDepth();
+    // It can be rendered at a lower resolution than the viewport one, so
+    // use the screen pass uvs instead of the fragment coords
+    vec2 vpUv = B_FIn_AlbedoUv;
+
+    float depth   = B_SampleDepth(vpUv);
     if (depth > 0.99999f) { B_GIn_Color = vec4( vec3(0), 1 ); return; }
 
-    vec3 normal   = normalize( B_SampleNormal() );
-    vec3 worldPos = B_ComputeWorldPosition(depth);
+    vec3 normal   = normalize( B_SampleNormal(vpUv) );
+    vec3 worldPos = B_ComputeWorldPosition(depth, vpUv);
 
     // Get random rotation vector
-    vec2 vpUv = B_GetViewportUv(); // Get viewport uv
     vec3 randomAxes = texture(B_RandomAxes, vpUv * B_RandomAxesUvMultiply).xyz;
     randomAxes.xyz = (randomAxes.xyz * 2.0f - 1.0f); // Map (0,1) to (-1,1)
 
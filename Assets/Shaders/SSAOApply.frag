@@ -1,13 +1,45 @@
 #include "ScreenPass.frag"
 
 uniform sampler2D B_SSAOMap;
+uniform vec2 B_SSAOMapSize;
 uniform float B_SSAOIntensity;
 
+// Bilateral upsampling of the (lower resolution) SSAO map: bilinear weights
+// of the 4 nearest texels, lowered for the texels whose depth is far from
+// the one of the pixel, so that occlusion does not bleed across edges
+float SampleSSAOBilateral(vec2 uv)
+{
+    float depthWorld = B_GetDepthWorld(B_SampleDepth(uv));
+
+    vec2 texelCoords = uv * B_SSAOMapSize - 0.5;
+    vec2 baseTexel = floor(texelCoords);
+    vec2 f = texelCoords - baseTexel;
+    ivec2 maxTexel = ivec2(B_SSAOMapSize) - 1;
+
+    float ssaoSum = 0.0;
+    float weightSum = 0.0;
+    for (int i = 0; i < 4; ++i)
+    {
+        vec2 offset = vec2(i % 2, i / 2);
+        vec2 bilinear = mix(1.0 - f, f, offset);
+        ivec2 texel = clamp(ivec2(baseTexel + offset), ivec2(0), maxTexel);
+
+        vec2 texelUv = (vec2(texel) + 0.5) / B_SSAOMapSize;
+        float texelDepthWorld = B_GetDepthWorld(B_SampleDepth(texelUv));
+        float depthWeight = 1.0 / (0.001 + abs(texelDepthWorld - depthWorld));
+
+        float weight = bilinear.x * bilinear.y * depthWeight;
+        ssaoSum += texelFetch(B_SSAOMap, texel, 0).r * weight;
+        weightSum += weight;
+    }
+    return (weightSum > 0.0) ? (ssaoSum / weightSum) : 0.0;
+}
+
 void main()
 {
     vec2 uv = B_FIn_AlbedoUv;
     vec4 inColor = B_SampleColor();
-    float ssao = texture(B_SSAOMap, uv).r;
+    float ssao = SampleSSAOBilateral(uv);
     ssao = ((1.0f - ssao * B_SSAOIntensity));
     B_GIn_Color = vec4(inColor.rgb * ssao, inColor.a);
 }
@@ -2,9 +2,18 @@
 
 uniform float B_Exposure;
 
+uniform bool B_CompositeBloom;
+uniform float B_BloomIntensity;
+uniform sampler2D B_BloomTexture;
+
 void main()
 {
     vec3 inHDRColor = B_SampleColor().rgb;
+    if (B_CompositeBloom)
+    {
+        vec3 bloom = texture(B_BloomTexture, B_FIn_AlbedoUv).rgb;
+        inHDRColor += bloom * B_BloomIntensity;
+    }
 
     float exposure = B_Exposure;
     vec3 outColor = vec3(1.0) - exp(-inHDRColor * exposure);
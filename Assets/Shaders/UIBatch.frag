@@ -0,0 +1,75 @@
+#define BANG_FRAGMENT
+#include "Common.glsl"
+
+const int MODE_IMAGE = 0;
+const int MODE_TEXT  = 1;
+
+uniform sampler2D B_BatchTexture0;
+uniform sampler2D B_BatchTexture1;
+uniform sampler2D B_BatchTexture2;
+uniform sampler2D B_BatchTexture3;
+uniform sampler2D B_BatchTexture4;
+uniform sampler2D B_BatchTexture5;
+uniform sampler2D B_BatchTexture6;
+uniform sampler2D B_BatchTexture7;
+
+in vec2 B_FIn_AlbedoUv;
+in vec4 B_FIn_Color;
+flat in vec3 B_FIn_BatchParams;
+
+layout(location = 0) out vec4 B_GIn_Color;
+
+vec4 SampleBatchTexture(int slot, vec2 uv)
+{
+    // Derivatives are taken outside the branches, since implicit ones are
+    // undefined in non-uniform control flow
+    vec2 uvDx = dFdx(uv);
+    vec2 uvDy = dFdy(uv);
+    switch (slot)
+    {
+        case 0: return textureGrad(B_BatchTexture0, uv, uvDx, uvDy);
+        case 1: return textureGrad(B_BatchTexture1, uv, uvDx, uvDy);
+        case 2: return textureGrad(B_BatchTexture2, uv, uvDx, uvDy);
+        case 3: return textureGrad(B_BatchTexture3, uv, uvDx, uvDy);
+        case 4: return textureGrad(B_BatchTexture4, uv, uvDx, uvDy);
+        case 5: return textureGrad(B_BatchTexture5, uv, uvDx, uvDy);
+        case 6: return textureGrad(B_BatchTexture6, uv, uvDx, uvDy);
+        case 7: return textureGrad(B_BatchTexture7, uv, uvDx, uvDy);
+    }
+    return vec4(1);
+}
+
+void main()
+{
+    int   slot        = int(round(B_FIn_BatchParams.x));
+    float alphaCutoff = B_FIn_BatchParams.y;
+    int   mode        = int(round(B_FIn_BatchParams.z));
+
+    vec4 color = B_FIn_Color;
+    vec4 texColor = SampleBatchTexture(slot, B_FIn_AlbedoUv);
+
+    // Text atlases are R8 distance fields. Derivatives are taken out of the
+    // branch, since the mode can change inside a pixel quad
+    float dist = texColor.r;
+    float distSmoothing = max(fwidth(dist), 0.0001);
+    if (mode == MODE_TEXT)
+    {
+        // Same as UITextRenderer.frag
+        float texA = smoothstep(0.5 - distSmoothing, 0.5 + distSmoothing,
+                                dist);
+        B_GIn_Color = vec4(color.rgb, color.a * texA);
+        return;
+    }
+
+    // Same as UIImageRenderer.frag
+    if (slot >= 0)
+    {
+        color *= texColor;
+    }
+
+    if (color.a <= alphaCutoff)
+    {
+        discard;
+    }
+    B_GIn_Color = color;
+}
@@ -0,0 +1,20 @@
+#define BANG_VERTEX
+#include "Common.glsl"
+
+layout(location = 0) in vec3 B_VIn_Position;
+layout(location = 2) in vec2 B_VIn_Uv;
+layout(location = 3) in vec4 B_VIn_Color;
+layout(location = 4) in vec3 B_VIn_BatchParams;
+
+out vec2 B_FIn_AlbedoUv;
+out vec4 B_FIn_Color;
+flat out vec3 B_FIn_BatchParams;
+
+void main()
+{
+    // Positions come already transformed to canvas space
+    B_FIn_AlbedoUv    = B_VIn_Uv;
+    B_FIn_Color       = B_VIn_Color;
+    B_FIn_BatchParams = B_VIn_BatchParams;
+    gl_Position       = B_PVM * vec4(B_VIn_Position, 1);
+}
@@ -2,7 +2,12 @@
 
 void main()
 {
-    float texA = texture(B_AlbedoTexture, B_FIn_AlbedoUv).a;
+    // The font atlas (R8) stores the glyphs signed distance field, with the
+    // glyph edge at 0.5. Smooth it over about one screen pixel, whatever the
+    // size
+    float dist = texture(B_AlbedoTexture, B_FIn_AlbedoUv).r;
+    float smoothing = max(fwidth(dist), 0.0001);
+    float texA = smoothstep(0.5 - smoothing, 0.5 + smoothing, dist);
     B_GIn_Color  = vec4(B_MaterialAlbedoColor.rgb,
                         B_MaterialAlbedoColor.a * texA);
 }
@@ -0,0 +1,132 @@
+#include <random>
+
+#include "BangTest.h"
+
+#include "Bang/AABox.h"
+#include "Bang/AABoxBVH.h"
+#include "Bang/Array.tcc"
+#include "Bang/Vector3.h"
+
+using namespace Bang;
+
+namespace
+{
+// Small boxes scattered in a big one, with some empty (unbounded) ones
+Array<AABox> CreateRandomBoxes(uint numBoxes, uint seed)
+{
+    std::mt19937 randomEngine(seed);
+    auto Random = [&randomEngine](float minValue, float maxValue) {
+        return std::uniform_real_distribution<float>(minValue,
+                                                     maxValue)(randomEngine);
+    };
+
+    Array<AABox> aaBoxes;
+    for (uint i = 0; i < numBoxes; ++i)
+    {
+        if (i % 37 == 0)
+        {
+            aaBoxes.PushBack(AABox::Empty());
+            continue;
+        }
+
+        const Vector3 min(Random(-100.0f, 100.0f),
+                          Random(-100.0f, 100.0f),
+                          Random(-5.0f, 5.0f));
+        const Vector3 size(
+            Random(0.0f, 4.0f), Random(0.0f, 4.0f), Random(0.0f, 4.0f));
+        aaBoxes.PushBack(AABox(min, min + size));
+    }
+    return aaBoxes;
+}
+
+bool Overlap(const AABox &lhs, const AABox &rhs)
+{
+    return lhs.GetMin().x <= rhs.GetMax().x &&
+           rhs.GetMin().x <= lhs.GetMax().x &&
+           lhs.GetMin().y <= rhs.GetMax().y &&
+           rhs.GetMin().y <= lhs.GetMax().y &&
+           lhs.GetMin().z <= rhs.GetMax().z && rhs.GetMin().z <= lhs.GetMax().z;
+}
+}  // namespace
+
+BANG_TEST(AABoxBVH_QueriesMatchBruteForce)
+{
+    const Array<AABox> aaBoxes = CreateRandomBoxes(2000, 7);
+    AABoxBVH bvh;
+    bvh.Build(aaBoxes);
+    BANG_CHECK(bvh.GetNumNodes() > 1);
+
+    const Array<AABox> queryBoxes = {AABox(Vector3(-10), Vector3(10)),
+                                     AABox(Vector3(50, -80, -1),
+                                           Vector3(90, -20, 1)),
+                                     AABox(Vector3(500), Vector3(600)),
+                                     AABox(Vector3(-1000), Vector3(1000))};
+    for (const AABox &queryBox : queryBoxes)
+    {
+        auto Overlaps = [&queryBox](const AABox &aaBox) {
+            return Overlap(aaBox, queryBox);
+        };
+
+        Array<uint> expectedIndices;
+        for (uint i = 0; i < aaBoxes.Size(); ++i)
+        {
+            if (aaBoxes[i] == AABox::Empty() || Overlaps(aaBoxes[i]))
+            {
+                expectedIndices.PushBack(i);
+            }
+        }
+
+        // Indices already in the output array are kept
+        Array<uint> indices = {12345u};
+        bvh.Query(Overlaps, &indices);
+        BANG_CHECK(indices.Front() == 12345u);
+        indices.RemoveByIndex(0);
+        BANG_CHECK(indices == expectedIndices);
+    }
+}
+
+BANG_TEST(AABoxBVH_SphereQueriesMatchBruteForce)
+{
+    const Array<AABox> aaBoxes = CreateRandomBoxes(777, 3);
+    AABoxBVH bvh;
+    bvh.Build(aaBoxes);
+
+    const Vector3 center(20.0f, -30.0f, 0.0f);
+    const float sqRange = (25.0f * 25.0f);
+    auto Overlaps = [&](const AABox &aaBox) {
+        return Vector3::SqDistance(aaBox.GetClosestPointInAABB(center),
+                                   center) <= sqRange;
+    };
+
+    Array<uint> expectedIndices;
+    for (uint i = 0; i < aaBoxes.Size(); ++i)
+    {
+        if (aaBoxes[i] == AABox::Empty() || Overlaps(aaBoxes[i]))
+        {
+            expectedIndices.PushBack(i);
+        }
+    }
+    BANG_CHECK(!expectedIndices.IsEmpty());
+
+    Array<uint> indices;
+    bvh.Query(Overlaps, &indices);
+    BANG_CHECK(indices == expectedIndices);
+}
+
+BANG_TEST(AABoxBVH_EmptyAndRebuilt)
+{
+    AABoxBVH bvh;
+    Array<uint> indices;
+    bvh.Query([](const AABox &) { return true; }, &indices);
+    BANG_CHECK(indices.IsEmpty());
+
+    bvh.Build({AABox::Empty(), AABox(Vector3(0), Vector3(1))});
+    bvh.Query([](const AABox &) { return false; }, &indices);
+    BANG_CHECK(indices == Array<uint>({0u}));
+
+    bvh.Clear();
+    indices.Clear();
+    bvh.Query([](const AABox &) { return true; }, &indices);
+    BANG_CHECK(indices.IsEmpty());
+    BANG_CHECK(bvh.GetNumNodes() == 0);
+}
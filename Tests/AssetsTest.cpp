@@ -0,0 +1,75 @@
+#include <atomic>
+
+#include "BangTest.h"
+
+#include "Bang/Array.tcc"
+#include "Bang/Assets.h"
+#include "Bang/Assets.tcc"
+#include "Bang/Extensions.h"
+#include "Bang/File.h"
+#include "Bang/JobSystem.h"
+#include "Bang/MetaFilesManager.h"
+#include "Bang/Paths.h"
+#include "Bang/Prefab.h"
+#include "Bang/Thread.h"
+#include "Bang/Time.h"
+
+using namespace Bang;
+
+// Needs the whole engine (Assets), so it runs with the GL tests
+BANG_GL_TEST(Assets_WaitRunsThePreImportOnTheWaitingThread)
+{
+    JobSystem *jobSystem = JobSystem::GetInstance();
+    const Path prevProjectDir = Paths::GetProjectDir();
+    const Path projectDir = Paths::GetExecutableDir().Append("AssetsTest");
+    File::Remove(projectDir);
+    BANG_CHECK(File::CreateDir(projectDir));
+    BANG_CHECK(File::CreateDir(projectDir.Append("Assets")));
+    Paths::SetProjectRoot(projectDir);
+
+    const Path prefabPath =
+        Paths::GetProjectAssetsDir().Append("Test").AppendExtension(
+            Extensions::GetPrefabExtension());
+    File::Write(prefabPath, "");
+    MetaFilesManager::CreateMissingMetaFiles(Paths::GetProjectAssetsDir());
+    MetaFilesManager::LoadMetaFilepathGUIDs(Paths::GetProjectAssetsDir());
+
+    // Keep every worker busy, so that the pre-import job can only run in
+    // this thread while it waits. Workers give up after a while, so that a
+    // waiting thread that sleeps fails instead of hanging
+    const uint numWorkers = jobSystem->GetNumWorkers();
+    std::atomic<uint> numBusyWorkers(0);
+    std::atomic<bool> released(false);
+    std::atomic<bool> timedOut(false);
+    Array<JobHandle> busyJobs;
+    for (uint i = 0; i < numWorkers; ++i)
+    {
+        busyJobs.PushBack(jobSystem->Schedule([&]() {
+            ++numBusyWorkers;
+            const Time beginTime = Time::GetNow();
+            while (!released)
+            {
+                if (Time::GetPassedTimeSince(beginTime) > Time::Seconds(10))
+                {
+                    timedOut = true;
+                    break;
+                }
+                Thread::SleepCurrentThread(0.001f);
+            }
+        }));
+    }
+    while (numBusyWorkers < numWorkers)
+    {
+        Thread::SleepCurrentThread(0.001f);
+    }
+
+    AssetLoadHandle<Prefab> loadHandle = Assets::LoadAsync<Prefab>(prefabPath);
+    BANG_CHECK(loadHandle.Wait().Get() != nullptr);
+    BANG_CHECK(!timedOut);
+
+    released = true;
+    jobSystem->Wait(busyJobs);
+
+    Paths::SetProjectRoot(prevProjectDir);
+    File::Remove(projectDir);
+}
@@ -0,0 +1,105 @@
+#include "BangTest.h"
+
+#include "Bang/AARect.h"
+#include "Bang/Array.tcc"
+#include "Bang/AtlasPacker.h"
+
+using namespace Bang;
+
+namespace
+{
+bool Overlap(const AARecti &lhs, const AARecti &rhs)
+{
+    return lhs.GetMin().x < rhs.GetMax().x && rhs.GetMin().x < lhs.GetMax().x &&
+           lhs.GetMin().y < rhs.GetMax().y && rhs.GetMin().y < lhs.GetMax().y;
+}
+
+bool InsidePage(const AARecti &rect, const Vector2i &pageSize)
+{
+    return rect.GetMin() >= Vector2i::Zero() && rect.GetMax() <= pageSize;
+}
+}  // namespace
+
+BANG_TEST(AtlasPacker_RectsDoNotOverlap)
+{
+    AtlasPacker packer(Vector2i(128), 1);
+
+    Array<AARecti> rects;
+    Array<uint> evictedKeys;
+    for (uint key = 0; key < 40; ++key)
+    {
+        const Vector2i size(4 + (key * 7) % 13, 5 + (key * 3) % 11);
+        AARecti rect;
+        BANG_CHECK(packer.Insert(key, size, &rect, &evictedKeys));
+        BANG_CHECK(rect.GetSize() == size);
+        BANG_CHECK(InsidePage(rect, packer.GetPageSize()));
+        rects.PushBack(rect);
+    }
+    BANG_CHECK(evictedKeys.IsEmpty());
+    BANG_CHECK(packer.GetNumEntries() == 40);
+
+    for (uint i = 0; i < rects.Size(); ++i)
+    {
+        BANG_CHECK(packer.GetRect(i) == rects[i]);
+        for (uint j = i + 1; j < rects.Size(); ++j)
+        {
+            BANG_CHECK(!Overlap(rects[i], rects[j]));
+        }
+    }
+}
+
+BANG_TEST(AtlasPacker_EvictsLeastRecentlyUsed)
+{
+    // Exactly four 30x30 slots (plus margins) fit in a 64x64 page
+    AtlasPacker packer(Vector2i(64), 1);
+    Array<uint> evictedKeys;
+    AARecti rect;
+    for (uint key = 0; key < 4; ++key)
+    {
+        BANG_CHECK(packer.Insert(key, Vector2i(30), &rect, &evictedKeys));
+    }
+    BANG_CHECK(evictedKeys.IsEmpty());
+
+    // 0 is used again, so 1 is now the least recently used
+    packer.Touch(0);
+    BANG_CHECK(packer.Insert(4, Vector2i(30), &rect, &evictedKeys));
+    BANG_CHECK(evictedKeys.Size() == 1 && evictedKeys[0] == 1);
+    BANG_CHECK(!packer.Contains(1));
+    BANG_CHECK(packer.Contains(0));
+    BANG_CHECK(packer.Contains(4));
+    BANG_CHECK(packer.GetNumEntries() == 4);
+    for (uint key : {0u, 2u, 3u})
+    {
+        BANG_CHECK(!Overlap(packer.GetRect(key), packer.GetRect(4)));
+    }
+}
+
+BANG_TEST(AtlasPacker_RemovedSlotsAreReused)
+{
+    AtlasPacker packer(Vector2i(64), 1);
+    Array<uint> evictedKeys;
+    AARecti rect;
+    for (uint key = 0; key < 4; ++key)
+    {
+        BANG_CHECK(packer.Insert(key, Vector2i(30), &rect, &evictedKeys));
+    }
+
+    const AARecti removedRect = packer.GetRect(2);
+    packer.Remove(2);
+    BANG_CHECK(!packer.Contains(2));
+    BANG_CHECK(packer.Insert(5, Vector2i(20), &rect, &evictedKeys));
+    BANG_CHECK(evictedKeys.IsEmpty());
+    BANG_CHECK(Overlap(rect, removedRect));
+}
+
+BANG_TEST(AtlasPacker_TooBigDoesNotFit)
+{
+    AtlasPacker packer(Vector2i(64), 1);
+    Array<uint> evictedKeys;
+    AARecti rect;
+    BANG_CHECK(packer.Insert(0, Vector2i(16), &rect, &evictedKeys));
+    BANG_CHECK(!packer.Insert(1, Vector2i(65, 8), &rect, &evictedKeys));
+    BANG_CHECK(evictedKeys.IsEmpty());
+    BANG_CHECK(packer.Contains(0));
+    BANG_CHECK(!packer.Contains(1));
+}
@@ -0,0 +1,60 @@
+#include "BangTest.h"
+
+#include <iostream>
+
+using namespace Bang;
+
+int BangTest::s_numFailedChecks = 0;
+
+bool BangTest::Register(const std::string &name,
+                        bool needsGL,
+                        std::function<void()> function)
+{
+    TestCase testCase;
+    testCase.name = name;
+    testCase.needsGL = needsGL;
+    testCase.function = function;
+    GetTestCases().push_back(testCase);
+    return true;
+}
+
+void BangTest::Fail(const char *file, int line, const char *expression)
+{
+    std::cerr << file << ":" << line << ": check failed: " << expression
+              << std::endl;
+    ++s_numFailedChecks;
+}
+
+int BangTest::Run(bool glTests, const std::string &filter)
+{
+    int numRunTests = 0;
+    int numFailedTests = 0;
+    for (const TestCase &testCase : GetTestCases())
+    {
+        if (testCase.needsGL != glTests ||
+            testCase.name.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        std::cout << "[ RUN  ] " << testCase.name << std::endl;
+        s_numFailedChecks = 0;
+        testCase.function();
+        ++numRunTests;
+
+        const bool passed = (s_numFailedChecks == 0);
+        numFailedTests += (passed ? 0 : 1);
+        std::cout << (passed ? "[  OK  ] " : "[ FAIL ] ") << testCase.name
+                  << std::endl;
+    }
+
+    std::cout << (numRunTests - numFailedTests) << "/" << numRunTests
+              << " tests passed" << std::endl;
+    return numFailedTests;
+}
+
+std::vector<BangTest::TestCase> &BangTest::GetTestCases()
+{
+    static std::vector<TestCase> testCases;
+    return testCases;
+}
@@ -0,0 +1,59 @@
+#ifndef BANGTEST_H
+#define BANGTEST_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Bang
+{
+// Minimal registry of the engine tests. Every test registers itself at
+// static init time with BANG_TEST (or BANG_GL_TEST when it needs a GL
+// context), and BangTestMain runs them. A failed BANG_CHECK does not abort
+// the test, it only marks it as failed.
+class BangTest
+{
+public:
+    struct TestCase
+    {
+        std::string name;
+        bool needsGL = false;
+        std::function<void()> function;
+    };
+
+    static bool Register(const std::string &name,
+                         bool needsGL,
+                         std::function<void()> function);
+    static void Fail(const char *file, int line, const char *expression);
+
+    // Runs the registered tests of the given kind whose name contains the
+    // filter. Returns the number of failed tests
+    static int Run(bool glTests, const std::string &filter);
+
+    BangTest() = delete;
+
+private:
+    static std::vector<TestCase> &GetTestCases();
+    static int s_numFailedChecks;
+};
+}  // namespace Bang
+
+#define BANG_TEST_(Name, NeedsGL)                                          \
+    static void BangTest_##Name();                                         \
+    static const bool BangTest_##Name##_Registered =                       \
+        Bang::BangTest::Register(#Name, NeedsGL, &BangTest_##Name);        \
+    static void BangTest_##Name()
+
+#define BANG_TEST(Name) BANG_TEST_(Name, false)
+#define BANG_GL_TEST(Name) BANG_TEST_(Name, true)
+
+#define BANG_CHECK(expression)                                        \
+    do                                                                \
+    {                                                                 \
+        if (!(expression))                                            \
+        {                                                             \
+            Bang::BangTest::Fail(__FILE__, __LINE__, #expression);    \
+        }                                                             \
+    } while (false)
+
+#endif  // BANGTEST_H
@@ -0,0 +1,92 @@
+#include <SDL.h>
+#include <iostream>
+#include <string>
+
+#include "BangTest.h"
+
+#include "Bang/Application.h"
+#include "Bang/Path.h"
+
+using namespace Bang;
+
+namespace
+{
+// Reported to ctest when the GL tests can not run here
+constexpr int SkipReturnCode = 77;
+
+class BangTestApplication : public Application
+{
+public:
+    void InitHeadless(const Path &engineRootPath)
+    {
+        InitHeadless_(engineRootPath);
+    }
+};
+
+// Probes a hidden window with a core context, before the engine tries to
+// (and errors out) without a display or GL driver
+bool CanCreateGLContext()
+{
+    if (SDL_Init(SDL_INIT_VIDEO) < 0)
+    {
+        return false;
+    }
+
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK,
+                        SDL_GL_CONTEXT_PROFILE_CORE);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 1);
+    SDL_Window *sdlWindow = SDL_CreateWindow(
+        "BangTests", 0, 0, 1, 1, SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+    SDL_GLContext glContext =
+        (sdlWindow ? SDL_GL_CreateContext(sdlWindow) : nullptr);
+
+    const bool canCreate = (glContext != nullptr);
+    if (glContext)
+    {
+        SDL_GL_DeleteContext(glContext);
+    }
+    if (sdlWindow)
+    {
+        SDL_DestroyWindow(sdlWindow);
+    }
+    SDL_QuitSubSystem(SDL_INIT_VIDEO);
+    return canCreate;
+}
+}  // namespace
+
+// BangTests [--gl] [filter]
+int main(int argc, char **argv)
+{
+    bool glTests = false;
+    std::string filter = "";
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--gl")
+        {
+            glTests = true;
+        }
+        else
+        {
+            filter = arg;
+        }
+    }
+
+    BangTestApplication app;
+    if (glTests)
+    {
+        if (!CanCreateGLContext())
+        {
+            std::cout << "No GL context available, skipping the GL tests"
+                      << std::endl;
+            return SkipReturnCode;
+        }
+        app.Init(Path(BANG_TESTS_ENGINE_ROOT));
+    }
+    else
+    {
+        app.InitHeadless(Path(BANG_TESTS_ENGINE_ROOT));
+    }
+    return (BangTest::Run(glTests, filter) == 0) ? 0 : 1;
+}
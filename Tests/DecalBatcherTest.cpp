@@ -0,0 +1,207 @@
+#include <random>
+
+#include "BangTest.h"
+#include "ImageDiff.h"
+#include "TestScenes.h"
+
+#include "Bang/Array.tcc"
+#include "Bang/Color.h"
+#include "Bang/DecalBatcher.h"
+#include "Bang/DecalRenderer.h"
+#include "Bang/GEngine.h"
+#include "Bang/GameObject.h"
+#include "Bang/GameObject.tcc"
+#include "Bang/GameObjectFactory.h"
+#include "Bang/Image.h"
+#include "Bang/Quaternion.h"
+#include "Bang/Scene.h"
+#include "Bang/Texture2D.h"
+#include "Bang/Transform.h"
+
+using namespace Bang;
+
+namespace
+{
+// Decals drawn one by one round every blending to 8 bits. The error of
+// blending over a rounded color shrinks with every decal on top, so it does
+// not grow with the number of decals
+constexpr float Tolerance = 4.0f / 255.0f;
+
+// The tiles have no limit of decals: a tile takes as many indices as decals
+// touch it, and the data and index textures grow in rows of
+// DecalBatcher::TexRowWidth texels (10k decals take 59 rows of data)
+constexpr uint NumDecals = 10000;
+const Vector2i RenderSize(256, 192);
+
+struct DecalsScene
+{
+    Scene *scene = nullptr;
+    Array<AH<Texture2D>> textures;
+    uint numDecals = 0;
+};
+
+// A wall of spheres facing the camera, covered by small overlapping
+// translucent decals of a few solid colors, so that the result depends on
+// their order but not on the atlas filtering
+DecalsScene CreateDecalsScene()
+{
+    std::mt19937 randomEngine(50);
+    auto RandomFloat = [&randomEngine](float minValue, float maxValue) {
+        return std::uniform_real_distribution<float>(minValue,
+                                                     maxValue)(randomEngine);
+    };
+    auto RandomInt = [&randomEngine](int minValue, int maxValue) {
+        return std::uniform_int_distribution<int>(minValue,
+                                                  maxValue)(randomEngine);
+    };
+
+    DecalsScene decalsScene;
+    decalsScene.scene = TestScenes::CreateLitScene(
+        RenderSize, Vector3(0, 0, 8), Vector3::Zero());
+    decalsScene.textures =
+        TestScenes::CreateTextures({Color(1.0f, 0.0f, 0.0f, 0.5f),
+                                    Color(0.0f, 1.0f, 0.0f, 0.75f),
+                                    Color(0.0f, 0.0f, 1.0f, 0.25f),
+                                    Color(1.0f, 1.0f, 0.0f, 1.0f)},
+                                   8);
+
+    Array<Vector3> spherePositions;
+    for (int y = -1; y <= 1; ++y)
+    {
+        for (int x = 0; x < 4; ++x)
+        {
+            const Vector3 spherePos((x - 1.5f) * 2.0f, y * 2.0f, 0.0f);
+            TestScenes::AddSphere(decalsScene.scene, spherePos);
+            spherePositions.PushBack(spherePos);
+        }
+    }
+
+    // Boxes deeper than the spheres, projecting along the view direction
+    for (uint i = 0; i < NumDecals; ++i)
+    {
+        const Vector3 &spherePos =
+            spherePositions[RandomInt(0, spherePositions.Size() - 1)];
+        GameObject *decalGo = GameObjectFactory::CreateGameObject();
+        decalGo->GetTransform()->SetPosition(
+            spherePos +
+            Vector3(RandomFloat(-0.8f, 0.8f), RandomFloat(-0.8f, 0.8f), 0.0f));
+        DecalRenderer *decalRenderer = decalGo->AddComponent<DecalRenderer>();
+        decalRenderer->SetBoxSize(Vector3(
+            RandomFloat(0.1f, 0.4f), RandomFloat(0.1f, 0.4f), 3.0f));
+        decalRenderer->SetDecalTexture(
+            decalsScene.textures[i % decalsScene.textures.Size()].Get());
+        decalGo->SetParent(decalsScene.scene);
+        ++decalsScene.numDecals;
+    }
+    return decalsScene;
+}
+}  // namespace
+
+BANG_TEST(DecalBatcher_TilesAreSizedInPixels)
+{
+    constexpr int TileSize = DecalBatcher::TileSize;
+    BANG_CHECK(TileSize >= 32 && TileSize <= 64);
+    BANG_CHECK(DecalBatcher::ComputeNumTiles(Vector2i(TileSize)) ==
+               Vector2i(1));
+    BANG_CHECK(DecalBatcher::ComputeNumTiles(Vector2i(TileSize + 1)) ==
+               Vector2i(2));
+    BANG_CHECK(DecalBatcher::ComputeNumTiles(Vector2i(1920, 1080)) ==
+               Vector2i((1920 + TileSize - 1) / TileSize,
+                        (1080 + TileSize - 1) / TileSize));
+
+    // Empty viewports still get a tile
+    BANG_CHECK(DecalBatcher::ComputeNumTiles(Vector2i(0)) == Vector2i(1));
+}
+
+BANG_TEST(DecalBatcher_SpawnedDecalsBudget)
+{
+    DecalBatcher batcher;
+    BANG_CHECK(batcher.GetSpawnedDecalsBudget() > 0);
+    BANG_CHECK(batcher.GetNumSpawnedDecals() == 0);
+
+    batcher.SetSpawnedDecalsBudget(3);
+    BANG_CHECK(batcher.GetSpawnedDecalsBudget() == 3);
+    BANG_CHECK(batcher.GetNumSpawnedDecals() == 0);
+
+    // Decals without texture or life are not spawned
+    batcher.SpawnDecal(Vector3::Zero(),
+                       Quaternion::Identity(),
+                       Vector3::One(),
+                       nullptr,
+                       10.0f);
+    BANG_CHECK(batcher.GetNumSpawnedDecals() == 0);
+
+    batcher.SetSpawnedDecalsBudget(0);
+    BANG_CHECK(batcher.GetSpawnedDecalsBudget() == 0);
+    batcher.ClearSpawnedDecals();
+    BANG_CHECK(batcher.GetNumSpawnedDecals() == 0);
+}
+
+BANG_GL_TEST(DecalBatcher_SpawnedDecalsStayInTheBudget)
+{
+    const Array<AH<Texture2D>> textures = TestScenes::CreateTextures(
+        {Color::Red(), Color::Green(), Color::Blue(), Color::White()}, 4);
+    DecalBatcher batcher;
+    batcher.SetSpawnedDecalsBudget(3);
+    for (const AH<Texture2D> &tex : textures)
+    {
+        batcher.SpawnDecal(Vector3::Zero(),
+                           Quaternion::Identity(),
+                           Vector3::One(),
+                           tex.Get(),
+                           10.0f);
+    }
+    BANG_CHECK(batcher.GetNumSpawnedDecals() == 3);
+
+    // Changing the budget drops them
+    batcher.SetSpawnedDecalsBudget(2);
+    BANG_CHECK(batcher.GetNumSpawnedDecals() == 0);
+    batcher.SpawnDecal(Vector3::Zero(),
+                       Quaternion::Identity(),
+                       Vector3::One(),
+                       textures.Front().Get(),
+                       10.0f);
+    batcher.ClearSpawnedDecals();
+    BANG_CHECK(batcher.GetNumSpawnedDecals() == 0);
+}
+
+BANG_GL_TEST(DecalBatcher_OneDrawCallLooksLikeDrawingOneByOne)
+{
+    DecalsScene decalsScene = CreateDecalsScene();
+    DecalBatcher *batcher = GEngine::GetInstance()->GetDecalBatcher();
+    BANG_CHECK(decalsScene.numDecals == NumDecals);
+
+    batcher->SetEnabled(true);
+    const Image batchedImage = TestScenes::Render(decalsScene.scene);
+    BANG_CHECK(batcher->GetNumFlushDrawCalls() == 1);
+    BANG_CHECK(batcher->GetNumFlushedDecals() > decalsScene.numDecals / 2);
+    BANG_CHECK(batcher->GetNumFlushedDecals() <= decalsScene.numDecals);
+    BANG_CHECK(batcher->GetNumTiles() ==
+               DecalBatcher::ComputeNumTiles(RenderSize));
+    BANG_CHECK(batcher->GetNumAtlasEntries() >=
+               decalsScene.textures.Size());
+    BANG_CHECK(batcher->GetAtlasTexture()->GetFilterMode() ==
+               GL::FilterMode::TRILINEAR_LL);
+
+    batcher->SetEnabled(false);
+    const Image oneByOneImage = TestScenes::Render(decalsScene.scene);
+    BANG_CHECK(batcher->GetNumFlushDrawCalls() == 0);
+    batcher->SetEnabled(true);
+    BANG_CHECK(ImageDiff::Matches(
+        batchedImage, oneByOneImage, Tolerance, "DecalsBatchedVsOneByOne"));
+
+    // The decals do show, so the images above do compare something
+    for (GameObject *go : decalsScene.scene->GetChildren())
+    {
+        if (DecalRenderer *decalRenderer = go->GetComponent<DecalRenderer>())
+        {
+            decalRenderer->SetEnabled(false);
+        }
+    }
+    const Image noDecalsImage = TestScenes::Render(decalsScene.scene);
+    BANG_CHECK(ImageDiff::GetNumDifferentPixels(
+                   batchedImage, noDecalsImage, Tolerance) >
+               batchedImage.GetWidth() * batchedImage.GetHeight() / 10);
+
+    GameObject::DestroyImmediate(decalsScene.scene);
+}
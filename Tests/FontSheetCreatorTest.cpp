@@ -0,0 +1,115 @@
+#include <cstdlib>
+
+#include "BangTest.h"
+
+#include "Bang/Color.h"
+#include "Bang/FontSheetCreator.h"
+#include "Bang/Image.h"
+#include "Bang/Math.h"
+
+using namespace Bang;
+
+namespace
+{
+constexpr int Spread = 4;
+
+// Binary coverage glyph, with the alpha set where isInside holds
+template <class InsideFunc>
+Image CreateGlyph(int width, int height, InsideFunc isInside)
+{
+    Image glyph;
+    glyph.Create(width, height, Color::White().WithAlpha(0.0f));
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            glyph.GetData()[(y * width + x) * 4 + 3] =
+                (isInside(x, y) ? 255 : 0);
+        }
+    }
+    return glyph;
+}
+
+// Brute force distance between pixel centers to the nearest pixel of the
+// other side, mapped the same way CreateSDF does
+int GetReferenceValue(const Image &glyph, int px, int py)
+{
+    auto IsInside = [&glyph](int x, int y) {
+        x -= Spread;
+        y -= Spread;
+        return x >= 0 && y >= 0 && x < glyph.GetWidth() &&
+               y < glyph.GetHeight() &&
+               glyph.GetData()[(y * glyph.GetWidth() + x) * 4 + 3] >= 128;
+    };
+
+    const int width = glyph.GetWidth() + Spread * 2;
+    const int height = glyph.GetHeight() + Spread * 2;
+    const bool inside = IsInside(px, py);
+    float minSqDist = Math::Infinity<float>();
+    for (int y = -Spread * 4; y < height + Spread * 4; ++y)
+    {
+        for (int x = -Spread * 4; x < width + Spread * 4; ++x)
+        {
+            if (IsInside(x, y) != inside)
+            {
+                const float dx = SCAST<float>(x - px);
+                const float dy = SCAST<float>(y - py);
+                minSqDist = Math::Min(minSqDist, dx * dx + dy * dy);
+            }
+        }
+    }
+
+    const float edgeDist = (Math::Sqrt(minSqDist) - 0.5f);
+    const float dist = (inside ? -edgeDist : edgeDist);
+    const float value = Math::Clamp(0.5f - dist / (2.0f * Spread), 0.0f, 1.0f);
+    return SCAST<int>(Math::Round(value * 255.0f));
+}
+
+void CheckAgainstReference(const Image &glyph)
+{
+    const Image sdf = FontSheetCreator::CreateSDF(glyph, Spread);
+    BANG_CHECK(sdf.GetWidth() == glyph.GetWidth() + Spread * 2);
+    BANG_CHECK(sdf.GetHeight() == glyph.GetHeight() + Spread * 2);
+
+    int maxError = 0;
+    for (int y = 0; y < sdf.GetHeight(); ++y)
+    {
+        for (int x = 0; x < sdf.GetWidth(); ++x)
+        {
+            const int value = sdf.GetData()[(y * sdf.GetWidth() + x) * 4 + 3];
+            const int reference = GetReferenceValue(glyph, x, y);
+            maxError = Math::Max(maxError, std::abs(value - reference));
+
+            // The edge is at 0.5
+            BANG_CHECK((reference > 127) == (value > 127));
+        }
+    }
+    BANG_CHECK(maxError <= 1);
+}
+}  // namespace
+
+BANG_TEST(FontSheetCreator_SDFSquareMatchesReference)
+{
+    CheckAgainstReference(CreateGlyph(12, 10, [](int x, int y) {
+        return x >= 3 && x < 9 && y >= 2 && y < 8;
+    }));
+}
+
+BANG_TEST(FontSheetCreator_SDFDiscMatchesReference)
+{
+    CheckAgainstReference(CreateGlyph(16, 16, [](int x, int y) {
+        const float dx = (x + 0.5f - 8.0f);
+        const float dy = (y + 0.5f - 8.0f);
+        return (dx * dx + dy * dy) <= 36.0f;
+    }));
+}
+
+BANG_TEST(FontSheetCreator_SDFEmptyGlyphIsOutside)
+{
+    const Image sdf = FontSheetCreator::CreateSDF(
+        CreateGlyph(4, 4, [](int, int) { return false; }), Spread);
+    for (int i = 0; i < sdf.GetWidth() * sdf.GetHeight(); ++i)
+    {
+        BANG_CHECK(sdf.GetData()[i * 4 + 3] == 0);
+    }
+}
@@ -0,0 +1,361 @@
+#include <array>
+#include <functional>
+#include <random>
+
+#include "BangTest.h"
+
+#include "Bang/AARect.h"
+#include "Bang/Array.tcc"
+#include "Bang/GL.h"
+
+using namespace Bang;
+
+namespace
+{
+constexpr int NumTextureUnits = 4;
+constexpr int NumObjects = 3;
+
+// GL objects the recorded calls use. Index 0 of every array is 0, to unbind
+struct ReplayObjects
+{
+    std::array<GLId, NumObjects + 1> textures2D = {};
+    std::array<GLId, NumObjects + 1> texturesCubeMap = {};
+    std::array<GLId, NumObjects + 1> buffers = {};
+    std::array<GLId, NumObjects + 1> framebuffers = {};
+};
+
+int GetGLInteger(GLenum glEnum)
+{
+    GLint value = 0;
+    glGetIntegerv(glEnum, &value);
+    return value;
+}
+
+bool TextureBindingsMatchDriver()
+{
+    return (GetGLInteger(GL_TEXTURE_BINDING_2D) ==
+            SCAST<int>(GL::GetBoundId(GL::BindTarget::TEXTURE_2D))) &&
+           (GetGLInteger(GL_TEXTURE_BINDING_CUBE_MAP) ==
+            SCAST<int>(GL::GetBoundId(GL::BindTarget::TEXTURE_CUBE_MAP)));
+}
+
+// Whether everything GL keeps in its shadow state is what the driver has.
+// Texture bindings are checked in every unit, going through GL to change the
+// active unit so that the shadow state keeps tracking it
+bool ShadowStateMatchesDriver()
+{
+    bool matches = TextureBindingsMatchDriver();
+    const int activeTexture = GetGLInteger(GL_ACTIVE_TEXTURE);
+    for (int unit = 0; unit < NumTextureUnits; ++unit)
+    {
+        GL::ActiveTexture(GL_TEXTURE0 + unit);
+        matches &= TextureBindingsMatchDriver();
+    }
+    GL::ActiveTexture(activeTexture);
+
+    matches &= (GetGLInteger(GL_ARRAY_BUFFER_BINDING) ==
+                SCAST<int>(GL::GetBoundId(GL::BindTarget::ARRAY_BUFFER)));
+    matches &= (GetGLInteger(GL_UNIFORM_BUFFER_BINDING) ==
+                SCAST<int>(GL::GetBoundId(GL::BindTarget::UNIFORM_BUFFER)));
+    matches &= (GetGLInteger(GL_DRAW_FRAMEBUFFER_BINDING) ==
+                SCAST<int>(GL::GetBoundId(GL::BindTarget::DRAW_FRAMEBUFFER)));
+    matches &= (GetGLInteger(GL_READ_FRAMEBUFFER_BINDING) ==
+                SCAST<int>(GL::GetBoundId(GL::BindTarget::READ_FRAMEBUFFER)));
+
+    for (GL::Enablable enablable : {GL::Enablable::BLEND,
+                                    GL::Enablable::DEPTH_TEST,
+                                    GL::Enablable::CULL_FACE,
+                                    GL::Enablable::SCISSOR_TEST,
+                                    GL::Enablable::STENCIL_TEST})
+    {
+        matches &=
+            ((glIsEnabled(SCAST<GLenum>(enablable)) == GL_TRUE) ==
+             GL::IsEnabled(enablable));
+    }
+
+    matches &= (GetGLInteger(GL_BLEND_SRC_RGB) ==
+                SCAST<int>(GL::GetBlendSrcFactorColor()));
+    matches &= (GetGLInteger(GL_BLEND_DST_RGB) ==
+                SCAST<int>(GL::GetBlendDstFactorColor()));
+    matches &= (GetGLInteger(GL_BLEND_SRC_ALPHA) ==
+                SCAST<int>(GL::GetBlendSrcFactorAlpha()));
+    matches &= (GetGLInteger(GL_BLEND_DST_ALPHA) ==
+                SCAST<int>(GL::GetBlendDstFactorAlpha()));
+    matches &= (GetGLInteger(GL_DEPTH_FUNC) ==
+                SCAST<int>(GL::GetDepthFunc()));
+    matches &= (GetGLInteger(GL_CULL_FACE_MODE) ==
+                SCAST<int>(GL::GetCullFace()));
+
+    GLboolean depthMask = GL_FALSE;
+    glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask);
+    matches &= ((depthMask == GL_TRUE) == GL::GetDepthMask());
+
+    std::array<GLboolean, 4> colorMask;
+    glGetBooleanv(GL_COLOR_WRITEMASK, colorMask.data());
+    for (int i = 0; i < 4; ++i)
+    {
+        matches &= ((colorMask[i] == GL_TRUE) == GL::GetColorMask()[i]);
+    }
+
+    std::array<GLint, 4> viewport;
+    glGetIntegerv(GL_VIEWPORT, viewport.data());
+    const AARecti viewportRect = GL::GetViewportRect();
+    matches &= (viewport[0] == viewportRect.GetMin().x &&
+                viewport[1] == viewportRect.GetMin().y &&
+                viewport[2] == viewportRect.GetWidth() &&
+                viewport[3] == viewportRect.GetHeight());
+
+    std::array<GLint, 4> scissorBox;
+    glGetIntegerv(GL_SCISSOR_BOX, scissorBox.data());
+    const AARecti scissorRect = GL::GetScissorRect();
+    matches &= (scissorBox[0] == scissorRect.GetMin().x &&
+                scissorBox[1] == scissorRect.GetMin().y &&
+                scissorBox[2] == scissorRect.GetWidth() &&
+                scissorBox[3] == scissorRect.GetHeight());
+    return matches;
+}
+
+// A stream of state calls like the ones of a frame, with many redundant
+// ones (a third of them repeat the previous call), and deletions of bound
+// textures whose ids can then be reused
+Array<std::function<void()>> RecordCallStream(ReplayObjects *objects,
+                                              int numCalls,
+                                              uint seed)
+{
+    std::mt19937 randomEngine(seed);
+    auto Random = [&randomEngine](int maxValue) {
+        return std::uniform_int_distribution<int>(0, maxValue)(randomEngine);
+    };
+
+    const std::array<GL::BlendFactor, 4> blendFactors = {
+        {GL::BlendFactor::ZERO,
+         GL::BlendFactor::ONE,
+         GL::BlendFactor::SRC_ALPHA,
+         GL::BlendFactor::ONE_MINUS_SRC_ALPHA}};
+    const std::array<GL::Function, 4> depthFuncs = {{GL::Function::LESS,
+                                                     GL::Function::LEQUAL,
+                                                     GL::Function::GREATER,
+                                                     GL::Function::ALWAYS}};
+    const std::array<GL::Enablable, 5> enablables = {
+        {GL::Enablable::BLEND,
+         GL::Enablable::DEPTH_TEST,
+         GL::Enablable::CULL_FACE,
+         GL::Enablable::SCISSOR_TEST,
+         GL::Enablable::STENCIL_TEST}};
+    const std::array<GL::BindTarget, 3> framebufferTargets = {
+        {GL::BindTarget::FRAMEBUFFER,
+         GL::BindTarget::DRAW_FRAMEBUFFER,
+         GL::BindTarget::READ_FRAMEBUFFER}};
+
+    Array<std::function<void()>> calls;
+    while (SCAST<int>(calls.Size()) < numCalls)
+    {
+        if (!calls.IsEmpty() && Random(2) == 0)
+        {
+            calls.PushBack(calls.Back());
+            continue;
+        }
+
+        const int object = Random(NumObjects);
+        std::function<void()> call;
+        switch (Random(14))
+        {
+            case 0:
+            {
+                const int unit = Random(NumTextureUnits - 1);
+                call = [unit]() { GL::ActiveTexture(GL_TEXTURE0 + unit); };
+            }
+            break;
+
+            case 1:
+                call = [objects, object]() {
+                    GL::Bind(GL::BindTarget::TEXTURE_2D,
+                             objects->textures2D[object]);
+                };
+                break;
+
+            case 2:
+                call = [objects, object]() {
+                    GL::Bind(GL::BindTarget::TEXTURE_CUBE_MAP,
+                             objects->texturesCubeMap[object]);
+                };
+                break;
+
+            case 3:
+                call = [objects, object]() {
+                    GL::Bind(GL::BindTarget::ARRAY_BUFFER,
+                             objects->buffers[object]);
+                };
+                break;
+
+            case 4:
+                call = [objects, object]() {
+                    GL::Bind(GL::BindTarget::UNIFORM_BUFFER,
+                             objects->buffers[object]);
+                };
+                break;
+
+            case 5:
+            {
+                const GL::BindTarget target = framebufferTargets[Random(2)];
+                call = [objects, object, target]() {
+                    GL::Bind(target, objects->framebuffers[object]);
+                };
+            }
+            break;
+
+            case 6:
+            {
+                const GL::Enablable enablable = enablables[Random(4)];
+                const bool enabled = (Random(1) == 0);
+                call = [enablable, enabled]() {
+                    GL::SetEnabled(enablable, enabled);
+                };
+            }
+            break;
+
+            case 7:
+            {
+                const GL::BlendFactor srcFactor = blendFactors[Random(3)];
+                const GL::BlendFactor dstFactor = blendFactors[Random(3)];
+                call = [srcFactor, dstFactor]() {
+                    GL::BlendFunc(srcFactor, dstFactor);
+                };
+            }
+            break;
+
+            case 8:
+            {
+                const GL::Function depthFunc = depthFuncs[Random(3)];
+                call = [depthFunc]() { GL::SetDepthFunc(depthFunc); };
+            }
+            break;
+
+            case 9:
+            {
+                const GL::Face face =
+                    (Random(1) == 0 ? GL::Face::BACK : GL::Face::FRONT);
+                call = [face]() { GL::SetCullFace(face); };
+            }
+            break;
+
+            case 10:
+            {
+                const bool depthMask = (Random(1) == 0);
+                call = [depthMask]() { GL::SetDepthMask(depthMask); };
+            }
+            break;
+
+            case 11:
+            {
+                const int mask = Random(15);
+                call = [mask]() {
+                    GL::SetColorMask(
+                        mask & 1, mask & 2, mask & 4, mask & 8);
+                };
+            }
+            break;
+
+            case 12:
+            {
+                const AARecti rect(Random(1) * 16,
+                                   Random(1) * 16,
+                                   32 + Random(1) * 32,
+                                   32 + Random(1) * 32);
+                call = [rect]() { GL::SetViewport(rect); };
+            }
+            break;
+
+            case 13:
+            {
+                const AARecti rect(Random(1) * 8,
+                                   Random(1) * 8,
+                                   16 + Random(1) * 16,
+                                   16 + Random(1) * 16);
+                call = [rect]() { GL::Scissor(rect); };
+            }
+            break;
+
+            case 14:
+            {
+                const int texture = 1 + Random(NumObjects - 1);
+                call = [objects, texture]() {
+                    GL::DeleteTextures(1, &objects->textures2D[texture]);
+                    GL::GenTextures(1, &objects->textures2D[texture]);
+                };
+            }
+            break;
+        }
+        calls.PushBack(call);
+    }
+    return calls;
+}
+
+void CreateReplayObjects(ReplayObjects *objects)
+{
+    GL::GenTextures(NumObjects, &objects->textures2D[1]);
+    GL::GenTextures(NumObjects, &objects->texturesCubeMap[1]);
+    GL::GenBuffers(NumObjects, &objects->buffers[1]);
+    GL::GenFramebuffers(NumObjects, &objects->framebuffers[1]);
+}
+
+void DestroyReplayObjects(ReplayObjects *objects)
+{
+    GL::DeleteTextures(NumObjects, &objects->textures2D[1]);
+    GL::DeleteTextures(NumObjects, &objects->texturesCubeMap[1]);
+    GL::DeleteBuffers(NumObjects, &objects->buffers[1]);
+    GL::DeleteFramebuffers(NumObjects, &objects->framebuffers[1]);
+    GL::ActiveTexture(GL_TEXTURE0);
+}
+}  // namespace
+
+BANG_GL_TEST(GL_ReplayedCallStreamsKeepTheShadowState)
+{
+    ReplayObjects objects;
+    CreateReplayObjects(&objects);
+    while (glGetError() != GL_NO_ERROR)
+    {
+    }
+
+    for (uint seed : {1u, 2u, 3u})
+    {
+        const Array<std::function<void()>> calls =
+            RecordCallStream(&objects, 600, seed);
+        for (const std::function<void()> &call : calls)
+        {
+            call();
+            BANG_CHECK(ShadowStateMatchesDriver());
+        }
+        BANG_CHECK(glGetError() == GL_NO_ERROR);
+    }
+
+    DestroyReplayObjects(&objects);
+}
+
+BANG_GL_TEST(GL_RedundantCallsAreSkipped)
+{
+    ReplayObjects objects;
+    CreateReplayObjects(&objects);
+
+    // Every call twice in a row, so the second one is always skipped
+    const Array<std::function<void()>> calls =
+        RecordCallStream(&objects, 300, 4u);
+    GL::EndFrame();
+    for (const std::function<void()> &call : calls)
+    {
+        call();
+        GL::EndFrame();
+        const uint numFirstCallStateCalls =
+            GL::GetNumIssuedStateCalls() + GL::GetNumSkippedStateCalls();
+
+        call();
+        GL::EndFrame();
+        BANG_CHECK(GL::GetNumSkippedStateCalls() >= 1 ||
+                   numFirstCallStateCalls == 0);
+        BANG_CHECK(GL::GetNumIssuedStateCalls() == 0 ||
+                   numFirstCallStateCalls == 0);
+    }
+    BANG_CHECK(ShadowStateMatchesDriver());
+
+    DestroyReplayObjects(&objects);
+}
@@ -0,0 +1,114 @@
+#include "ImageDiff.h"
+
+#include <iostream>
+
+#include "Bang/Color.h"
+#include "Bang/Math.h"
+#include "Bang/Path.h"
+#include "Bang/Paths.h"
+
+using namespace Bang;
+
+namespace
+{
+float GetMaxChannelDifference(const Color &lhs, const Color &rhs)
+{
+    return Math::Max(Math::Max(Math::Abs(lhs.r - rhs.r),
+                               Math::Abs(lhs.g - rhs.g)),
+                     Math::Max(Math::Abs(lhs.b - rhs.b),
+                               Math::Abs(lhs.a - rhs.a)));
+}
+}  // namespace
+
+float ImageDiff::GetMaxDifference(const Image &lhs, const Image &rhs)
+{
+    if (lhs.GetSize() != rhs.GetSize())
+    {
+        return 1.0f;
+    }
+
+    float maxDifference = 0.0f;
+    for (int y = 0; y < lhs.GetHeight(); ++y)
+    {
+        for (int x = 0; x < lhs.GetWidth(); ++x)
+        {
+            maxDifference = Math::Max(
+                maxDifference,
+                GetMaxChannelDifference(lhs.GetPixel(x, y),
+                                        rhs.GetPixel(x, y)));
+        }
+    }
+    return maxDifference;
+}
+
+uint ImageDiff::GetNumDifferentPixels(const Image &lhs,
+                                      const Image &rhs,
+                                      float tolerance)
+{
+    if (lhs.GetSize() != rhs.GetSize())
+    {
+        return SCAST<uint>(Math::Max(lhs.GetWidth() * lhs.GetHeight(),
+                                     rhs.GetWidth() * rhs.GetHeight()));
+    }
+
+    uint numDifferentPixels = 0;
+    for (int y = 0; y < lhs.GetHeight(); ++y)
+    {
+        for (int x = 0; x < lhs.GetWidth(); ++x)
+        {
+            if (GetMaxChannelDifference(lhs.GetPixel(x, y),
+                                        rhs.GetPixel(x, y)) > tolerance)
+            {
+                ++numDifferentPixels;
+            }
+        }
+    }
+    return numDifferentPixels;
+}
+
+Image ImageDiff::GetDifferenceImage(const Image &lhs, const Image &rhs)
+{
+    // Over the common area, opaque so that it can be looked at
+    const int width = Math::Min(lhs.GetWidth(), rhs.GetWidth());
+    const int height = Math::Min(lhs.GetHeight(), rhs.GetHeight());
+    Image diffImage;
+    diffImage.Create(width, height);
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            const Color lhsPixel = lhs.GetPixel(x, y);
+            const Color rhsPixel = rhs.GetPixel(x, y);
+            diffImage.SetPixel(x,
+                               y,
+                               Color(Math::Abs(lhsPixel.r - rhsPixel.r),
+                                     Math::Abs(lhsPixel.g - rhsPixel.g),
+                                     Math::Abs(lhsPixel.b - rhsPixel.b),
+                                     1.0f));
+        }
+    }
+    return diffImage;
+}
+
+bool ImageDiff::Matches(const Image &lhs,
+                        const Image &rhs,
+                        float tolerance,
+                        const String &name)
+{
+    const float maxDifference = ImageDiff::GetMaxDifference(lhs, rhs);
+    if (maxDifference <= tolerance)
+    {
+        return true;
+    }
+
+    const Path dir = Paths::GetExecutableDir();
+    lhs.Export(dir.Append(name + ".lhs.png"));
+    rhs.Export(dir.Append(name + ".rhs.png"));
+    ImageDiff::GetDifferenceImage(lhs, rhs).Export(
+        dir.Append(name + ".diff.png"));
+    std::cerr << "Images '" << name << "' differ by " << maxDifference
+              << " (" << ImageDiff::GetNumDifferentPixels(lhs, rhs, tolerance)
+              << " pixels over " << tolerance << "), exported to "
+              << dir.GetAbsolute() << std::endl;
+    return false;
+}
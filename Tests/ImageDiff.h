@@ -0,0 +1,36 @@
+#ifndef IMAGEDIFF_H
+#define IMAGEDIFF_H
+
+#include "Bang/BangDefines.h"
+#include "Bang/Image.h"
+#include "Bang/String.h"
+
+namespace Bang
+{
+// Compares the images that the GL tests render. When they do not match, the
+// two images and their difference are exported next to the tests
+// executable, as "<name>.lhs.png", "<name>.rhs.png" and "<name>.diff.png"
+class ImageDiff
+{
+public:
+    // Largest difference of any channel of any pixel, in [0, 1]. Images of
+    // different sizes differ by 1
+    static float GetMaxDifference(const Image &lhs, const Image &rhs);
+
+    // Number of pixels with a channel that differs more than the tolerance
+    static uint GetNumDifferentPixels(const Image &lhs,
+                                      const Image &rhs,
+                                      float tolerance);
+
+    static Image GetDifferenceImage(const Image &lhs, const Image &rhs);
+
+    static bool Matches(const Image &lhs,
+                        const Image &rhs,
+                        float tolerance,
+                        const String &name);
+
+    ImageDiff() = delete;
+};
+}  // namespace Bang
+
+#endif  // IMAGEDIFF_H
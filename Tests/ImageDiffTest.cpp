@@ -0,0 +1,41 @@
+#include "BangTest.h"
+#include "ImageDiff.h"
+
+#include "Bang/Color.h"
+#include "Bang/Image.h"
+#include "Bang/Math.h"
+
+using namespace Bang;
+
+BANG_TEST(ImageDiff_FindsTheDifferentPixels)
+{
+    Image lhs;
+    lhs.Create(16, 8, Color(0.2f, 0.4f, 0.6f, 1.0f));
+    Image rhs;
+    rhs.Create(16, 8, Color(0.2f, 0.4f, 0.6f, 1.0f));
+    BANG_CHECK(ImageDiff::GetMaxDifference(lhs, rhs) == 0.0f);
+    BANG_CHECK(ImageDiff::GetNumDifferentPixels(lhs, rhs, 0.0f) == 0);
+
+    // Within an 8 bit rounding, and then over it
+    rhs.SetPixel(3, 5, Color(0.2f, 0.4f, 0.6f + 1.0f / 255.0f, 1.0f));
+    BANG_CHECK(ImageDiff::GetMaxDifference(lhs, rhs) <= 1.5f / 255.0f);
+    BANG_CHECK(ImageDiff::GetNumDifferentPixels(lhs, rhs, 2.0f / 255.0f) == 0);
+
+    rhs.SetPixel(15, 0, Color(0.2f, 0.9f, 0.6f, 1.0f));
+    BANG_CHECK(Math::Abs(ImageDiff::GetMaxDifference(lhs, rhs) - 0.5f) <
+               2.0f / 255.0f);
+    BANG_CHECK(ImageDiff::GetNumDifferentPixels(lhs, rhs, 2.0f / 255.0f) == 1);
+    BANG_CHECK(ImageDiff::GetNumDifferentPixels(lhs, rhs, 0.0f) == 2);
+
+    const Image diffImage = ImageDiff::GetDifferenceImage(lhs, rhs);
+    BANG_CHECK(diffImage.GetSize() == lhs.GetSize());
+    BANG_CHECK(diffImage.GetPixel(0, 0).g == 0.0f);
+    BANG_CHECK(diffImage.GetPixel(15, 0).g > 0.45f);
+
+    // Different sizes never match
+    Image smaller;
+    smaller.Create(8, 8, Color(0.2f, 0.4f, 0.6f, 1.0f));
+    BANG_CHECK(ImageDiff::GetMaxDifference(lhs, smaller) == 1.0f);
+    BANG_CHECK(ImageDiff::GetNumDifferentPixels(lhs, smaller, 1.0f) ==
+               16 * 8);
+}
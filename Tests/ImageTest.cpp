@@ -0,0 +1,36 @@
+#include "BangTest.h"
+
+#include "Bang/Image.h"
+
+using namespace Bang;
+
+BANG_TEST(Image_LinearDownsizeRoundsTheAverage)
+{
+    // Three source pixels per destination one: 1, 1, 0 averages to 0.67,
+    // and 254, 255, 255 to 254.67, which truncated would both lose a level
+    Image image;
+    image.Create(6, 1);
+    const Byte values[6] = {1, 1, 0, 254, 255, 255};
+    for (int x = 0; x < 6; ++x)
+    {
+        for (int c = 0; c < 4; ++c)
+        {
+            image.GetData()[x * 4 + c] = values[x];
+        }
+    }
+
+    image.Resize(2, 1, ImageResizeMode::LINEAR);
+    BANG_CHECK(image.GetSize() == Vector2i(2, 1));
+    for (int c = 0; c < 4; ++c)
+    {
+        BANG_CHECK(image.GetData()[c] == 1);
+        BANG_CHECK(image.GetData()[4 + c] == 255);
+    }
+
+    // An exact half rounds up
+    image.Create(2, 1);
+    image.GetData()[0] = 0;
+    image.GetData()[4] = 3;
+    image.Resize(1, 1, ImageResizeMode::LINEAR);
+    BANG_CHECK(image.GetData()[0] == 2);
+}
@@ -0,0 +1,88 @@
+#include "BangTest.h"
+
+#include <cstring>
+
+#include "Bang/Array.tcc"
+#include "Bang/MetaNode.h"
+#include "Bang/MetaNode.tcc"
+
+using namespace Bang;
+
+namespace
+{
+// Offset of the given consecutive uints in the bytes, or -1
+int FindUints(const Array<Byte> &bytes, const Array<uint> &values)
+{
+    const std::size_t valuesSize = values.Size() * sizeof(uint);
+    for (std::size_t i = 0; i + valuesSize <= bytes.Size(); ++i)
+    {
+        if (std::memcmp(bytes.Data() + i, values.Data(), valuesSize) == 0)
+        {
+            return SCAST<int>(i);
+        }
+    }
+    return -1;
+}
+}  // namespace
+
+BANG_TEST(MetaNode_BinaryRejectsWrappingNumElements)
+{
+    MetaNode metaNode;
+    metaNode.SetArray<int>("Array", {12345});
+    Array<Byte> bytes;
+    metaNode.ToBinary(&bytes);
+
+    MetaNode importedMetaNode;
+    BANG_CHECK(importedMetaNode.ImportBinary(bytes));
+    BANG_CHECK(importedMetaNode.GetArray<int>("Array") ==
+               Array<int>({12345}));
+
+    // (isArray, numElements, value). With 4 bytes per int, 0x40000001
+    // elements wrap to 4 bytes in 32 bits
+    const int numElementsOffset = FindUints(bytes, {1, 1, 12345});
+    BANG_CHECK(numElementsOffset >= 0);
+    if (numElementsOffset >= 0)
+    {
+        const uint corruptNumElements = 0x40000001;
+        std::memcpy(bytes.Data() + numElementsOffset + sizeof(uint),
+                    &corruptNumElements,
+                    sizeof(uint));
+        MetaNode corruptMetaNode;
+        BANG_CHECK(!corruptMetaNode.ImportBinary(bytes));
+        BANG_CHECK(corruptMetaNode.GetArray<int>("Array").IsEmpty());
+    }
+}
+
+BANG_TEST(MetaNode_NativeArrayReplacesFlattenedArray)
+{
+    // Like an array imported from YAML
+    MetaNode flattenedMetaNode;
+    flattenedMetaNode.Set("Array_0", "1");
+    flattenedMetaNode.Set("Array_1", "2");
+    flattenedMetaNode.Set("Array_2", "3");
+
+    MetaNode metaNode;
+    metaNode.Import(flattenedMetaNode);
+    metaNode.SetArray<int>("Array", {7, 8});
+    BANG_CHECK(metaNode.GetAttributes().Size() == 1);
+    BANG_CHECK(metaNode.GetArray<int>("Array") == Array<int>({7, 8}));
+
+    // The YAML round trip has no duplicated keys nor old elements
+    MetaNode roundTripMetaNode;
+    roundTripMetaNode.Import(metaNode.ToString());
+    BANG_CHECK(roundTripMetaNode.GetAttributes().Size() == 2);
+    BANG_CHECK(roundTripMetaNode.GetArray<int>("Array") ==
+               Array<int>({7, 8}));
+
+    // And the other way around, a shorter flattened array
+    roundTripMetaNode.SetArray<String>("Array", {"9"});
+    BANG_CHECK(roundTripMetaNode.GetAttributes().Size() == 1);
+    BANG_CHECK(roundTripMetaNode.GetArray<int>("Array") == Array<int>({9}));
+
+    // Merging a native array over a flattened one
+    MetaNode mergedMetaNode;
+    mergedMetaNode.Import(flattenedMetaNode);
+    mergedMetaNode.Import(metaNode);
+    BANG_CHECK(mergedMetaNode.GetAttributes().Size() == 1);
+    BANG_CHECK(mergedMetaNode.GetArray<int>("Array") == Array<int>({7, 8}));
+}
@@ -0,0 +1,124 @@
+#include "BangTest.h"
+#include "ImageDiff.h"
+#include "TestScenes.h"
+
+#include "Bang/Camera.h"
+#include "Bang/GameObject.h"
+#include "Bang/GameObject.tcc"
+#include "Bang/Image.h"
+#include "Bang/PostProcessEffectBloom.h"
+#include "Bang/PostProcessEffectSSAO.h"
+#include "Bang/PostProcessEffectToneMapping.h"
+#include "Bang/Scene.h"
+
+using namespace Bang;
+
+namespace
+{
+// Up to the rounding to 8 bits of the different passes
+constexpr float Tolerance = 2.0f / 255.0f;
+
+struct BloomScene
+{
+    Scene *scene = nullptr;
+    Camera *camera = nullptr;
+    PostProcessEffectBloom *bloom = nullptr;
+    PostProcessEffectSSAO *ssao = nullptr;
+    PostProcessEffectToneMapping *toneMapping = nullptr;
+};
+
+// A grid of lit spheres going away from the camera, with the camera
+// effects in the pass after the lights. The SSAO, if any, renders between
+// the bloom and the tone mapping
+BloomScene CreateBloomScene(bool withSSAO)
+{
+    BloomScene bloomScene;
+    bloomScene.scene = TestScenes::CreateLitScene(
+        Vector2i(128, 96), Vector3(0, 3, 0), Vector3(0, 0, -12));
+    bloomScene.camera = bloomScene.scene->GetCamera();
+    for (int z = 0; z < 3; ++z)
+    {
+        for (int x = 0; x < 3; ++x)
+        {
+            TestScenes::AddSphere(
+                bloomScene.scene,
+                Vector3((x - 1.5f) * 3.0f, 0.0f, -z * 4.0f - 2.0f));
+        }
+    }
+
+    GameObject *cameraGo = bloomScene.camera->GetGameObject();
+    bloomScene.bloom = cameraGo->AddComponent<PostProcessEffectBloom>();
+    bloomScene.bloom->SetType(PostProcessEffect::Type::AFTER_SCENE_AND_LIGHT);
+    bloomScene.bloom->SetBrightnessThreshold(0.2f);
+    bloomScene.bloom->SetIntensity(2.0f);
+    if (withSSAO)
+    {
+        bloomScene.ssao = cameraGo->AddComponent<PostProcessEffectSSAO>();
+    }
+    bloomScene.toneMapping =
+        cameraGo->AddComponent<PostProcessEffectToneMapping>();
+    return bloomScene;
+}
+}  // namespace
+
+BANG_GL_TEST(PostProcessEffectBloom_CompositeInToneMappingLooksTheSame)
+{
+    BloomScene bloomScene = CreateBloomScene(false);
+    PostProcessEffectBloom *bloom = bloomScene.bloom;
+
+    bloom->SetCompositeInToneMapping(true);
+    const Image foldedImage = TestScenes::Render(bloomScene.scene);
+    BANG_CHECK(bloom->GetCompositingToneMapping() == bloomScene.toneMapping);
+
+    bloom->SetCompositeInToneMapping(false);
+    const Image compositedImage = TestScenes::Render(bloomScene.scene);
+    BANG_CHECK(bloom->GetCompositingToneMapping() == nullptr);
+    BANG_CHECK(ImageDiff::Matches(
+        foldedImage, compositedImage, Tolerance, "BloomFoldedVsComposited"));
+
+    // The bloom does show, so the images above do compare something
+    bloom->SetEnabled(false);
+    const Image noBloomImage = TestScenes::Render(bloomScene.scene);
+    BANG_CHECK(ImageDiff::GetNumDifferentPixels(
+                   compositedImage, noBloomImage, Tolerance) > 0);
+
+    // A tone mapping of another pass can not add it
+    bloom->SetEnabled(true);
+    bloom->SetCompositeInToneMapping(true);
+    bloom->SetType(PostProcessEffect::Type::AFTER_SCENE);
+    TestScenes::Render(bloomScene.scene);
+    BANG_CHECK(bloom->GetCompositingToneMapping() == nullptr);
+
+    GameObject::DestroyImmediate(bloomScene.scene);
+}
+
+BANG_GL_TEST(PostProcessEffectBloom_NotFoldedAcrossOtherEffects)
+{
+    BloomScene bloomScene = CreateBloomScene(true);
+    PostProcessEffectBloom *bloom = bloomScene.bloom;
+
+    // The SSAO darkens the color after the bloom was added, so it must be
+    // composited before it
+    bloom->SetCompositeInToneMapping(true);
+    const Image withSSAOImage = TestScenes::Render(bloomScene.scene);
+    BANG_CHECK(bloom->GetCompositingToneMapping() == nullptr);
+
+    bloom->SetCompositeInToneMapping(false);
+    const Image compositedImage = TestScenes::Render(bloomScene.scene);
+    BANG_CHECK(ImageDiff::Matches(
+        withSSAOImage, compositedImage, Tolerance, "BloomAcrossSSAO"));
+
+    // A disabled effect in between does not count
+    bloom->SetCompositeInToneMapping(true);
+    bloomScene.ssao->SetEnabled(false);
+    const Image foldedImage = TestScenes::Render(bloomScene.scene);
+    BANG_CHECK(bloom->GetCompositingToneMapping() == bloomScene.toneMapping);
+
+    bloom->SetCompositeInToneMapping(false);
+    BANG_CHECK(ImageDiff::Matches(foldedImage,
+                                  TestScenes::Render(bloomScene.scene),
+                                  Tolerance,
+                                  "BloomFoldedWithoutSSAO"));
+
+    GameObject::DestroyImmediate(bloomScene.scene);
+}
@@ -0,0 +1,128 @@
+#include <memory>
+
+#include "BangTest.h"
+
+#include "Bang/RingBuffer.h"
+
+using namespace Bang;
+
+namespace
+{
+bool Contains(const RingBuffer<int> &ringBuffer, const Array<int> &expected)
+{
+    if (ringBuffer.Size() != expected.Size())
+    {
+        return false;
+    }
+
+    for (uint i = 0; i < expected.Size(); ++i)
+    {
+        if (ringBuffer[i] != expected[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+BANG_TEST(RingBuffer_FullOneRecyclesTheOldest)
+{
+    RingBuffer<int> ringBuffer(3);
+    BANG_CHECK(ringBuffer.GetCapacity() == 3);
+    BANG_CHECK(ringBuffer.IsEmpty());
+
+    ringBuffer.PushBack(1);
+    ringBuffer.PushBack(2);
+    ringBuffer.PushBack(3);
+    BANG_CHECK(ringBuffer.IsFull());
+    BANG_CHECK(Contains(ringBuffer, {1, 2, 3}));
+
+    // Goes around the end of the storage a few times
+    for (int i = 4; i <= 10; ++i)
+    {
+        ringBuffer.PushBack(i);
+        BANG_CHECK(ringBuffer.Size() == 3);
+        BANG_CHECK(ringBuffer.Front() == i - 2);
+        BANG_CHECK(ringBuffer.Back() == i);
+    }
+    BANG_CHECK(Contains(ringBuffer, {8, 9, 10}));
+
+    ringBuffer.Clear();
+    BANG_CHECK(ringBuffer.IsEmpty());
+    BANG_CHECK(ringBuffer.GetCapacity() == 3);
+    ringBuffer.PushBack(11);
+    BANG_CHECK(Contains(ringBuffer, {11}));
+}
+
+BANG_TEST(RingBuffer_CapacityIsTheBudget)
+{
+    RingBuffer<int> ringBuffer;
+    BANG_CHECK(ringBuffer.GetCapacity() == 0);
+    ringBuffer.PushBack(1);
+    BANG_CHECK(ringBuffer.IsEmpty());
+
+    ringBuffer.SetCapacity(2);
+    ringBuffer.PushBack(1);
+    ringBuffer.PushBack(2);
+    ringBuffer.PushBack(3);
+    BANG_CHECK(Contains(ringBuffer, {2, 3}));
+
+    // Changing it drops everything
+    ringBuffer.SetCapacity(4);
+    BANG_CHECK(ringBuffer.IsEmpty());
+    BANG_CHECK(ringBuffer.GetCapacity() == 4);
+}
+
+BANG_TEST(RingBuffer_RemoveIfKeepsTheOrder)
+{
+    // Starting in the middle of the storage, so that it wraps around
+    RingBuffer<int> ringBuffer(5);
+    for (int i = 0; i < 8; ++i)
+    {
+        ringBuffer.PushBack(i);
+    }
+    BANG_CHECK(Contains(ringBuffer, {3, 4, 5, 6, 7}));
+
+    Array<int> visited;
+    ringBuffer.RemoveIf([&visited](int x) {
+        visited.PushBack(x);
+        return (x % 2 == 0);
+    });
+    BANG_CHECK(visited == Array<int>({3, 4, 5, 6, 7}));
+    BANG_CHECK(Contains(ringBuffer, {3, 5, 7}));
+
+    // The room left is used before recycling
+    ringBuffer.PushBack(8);
+    ringBuffer.PushBack(9);
+    BANG_CHECK(Contains(ringBuffer, {3, 5, 7, 8, 9}));
+    ringBuffer.PushBack(10);
+    BANG_CHECK(Contains(ringBuffer, {5, 7, 8, 9, 10}));
+
+    ringBuffer.RemoveIf([](int) { return true; });
+    BANG_CHECK(ringBuffer.IsEmpty());
+}
+
+BANG_TEST(RingBuffer_DroppedElementsAreReleased)
+{
+    // Like the texture handles of the spawned decals
+    std::shared_ptr<int> first = std::make_shared<int>(1);
+    std::shared_ptr<int> second = std::make_shared<int>(2);
+    std::shared_ptr<int> third = std::make_shared<int>(3);
+
+    RingBuffer<std::shared_ptr<int>> ringBuffer(2);
+    ringBuffer.PushBack(first);
+    ringBuffer.PushBack(second);
+    ringBuffer.PushBack(third);
+    BANG_CHECK(first.use_count() == 1);
+    BANG_CHECK(second.use_count() == 2);
+
+    ringBuffer.RemoveIf(
+        [](const std::shared_ptr<int> &x) { return (*x == 2); });
+    BANG_CHECK(second.use_count() == 1);
+    BANG_CHECK(third.use_count() == 2);
+    BANG_CHECK(*ringBuffer.Front() == 3);
+
+    ringBuffer.Clear();
+    BANG_CHECK(third.use_count() == 1);
+}
@@ -0,0 +1,43 @@
+#include "BangTest.h"
+
+#include "Bang/Array.tcc"
+#include "Bang/ShaderPreprocessor.h"
+
+using namespace Bang;
+
+BANG_TEST(ShaderPreprocessor_MultiCompileKeywordSets)
+{
+    const String sourceCode =
+        "#version 330 core\n"
+        "#pragma multi_compile A B\n"
+        "#pragma   multi_compile  C _ C\n"
+        "#pragma multi_compile A B\n"
+        "#pragma multi_compile\n"
+        "#pragma once\n"
+        "void main() {}\n";
+
+    // Repeated sets and keywords only count once, empty sets do not count
+    const Array<Array<String>> keywordSets =
+        ShaderPreprocessor::GetMultiCompileKeywordSets(sourceCode);
+    BANG_CHECK(keywordSets.Size() == 2);
+    BANG_CHECK(keywordSets.Size() == 2 &&
+               keywordSets[0] == Array<String>({"A", "B"}));
+    BANG_CHECK(keywordSets.Size() == 2 &&
+               keywordSets[1] == Array<String>({"C", "_"}));
+}
+
+BANG_TEST(ShaderPreprocessor_AddDefines)
+{
+    String sourceCode = "#version 330 core\nvoid main() {}\n";
+    ShaderPreprocessor::AddDefines(&sourceCode, {"A", "_", "C"});
+    BANG_CHECK(sourceCode ==
+               "#version 330 core\n#define A\n#define C\nvoid main() {}\n");
+
+    String noVersionSourceCode = "void main() {}\n";
+    ShaderPreprocessor::AddDefines(&noVersionSourceCode, {"B"});
+    BANG_CHECK(noVersionSourceCode == "#define B\nvoid main() {}\n");
+
+    String versionOnlySourceCode = "#version 330 core";
+    ShaderPreprocessor::AddDefines(&versionOnlySourceCode, {"B"});
+    BANG_CHECK(versionOnlySourceCode == "#version 330 core\n#define B\n");
+}
@@ -0,0 +1,127 @@
+#include "BangTest.h"
+
+#include "Bang/Array.tcc"
+#include "Bang/Assets.h"
+#include "Bang/Assets.tcc"
+#include "Bang/File.h"
+#include "Bang/GL.h"
+#include "Bang/MetaFilesManager.h"
+#include "Bang/Paths.h"
+#include "Bang/Shader.h"
+#include "Bang/ShaderProgram.h"
+#include "Bang/ShaderProgramBinaryCache.h"
+
+using namespace Bang;
+
+namespace
+{
+constexpr const char *VertexSource =
+    "void main() { gl_Position = vec4(0.0, 0.0, 0.0, 1.0); }\n";
+constexpr const char *FragmentSource =
+    "out vec4 color;\n"
+    "void main() { color = vec4(1.0); }\n";
+constexpr const char *EditedFragmentSource =
+    "out vec4 color;\n"
+    "void main() { color = vec4(0.5); }\n";
+
+Array<Path> GetCacheFilepaths()
+{
+    return Paths::GetProjectCacheDir().Append("ShaderPrograms").GetFiles(
+        FindFlag::SIMPLE_HIDDEN,
+        {ShaderProgramBinaryCache::GetCacheExtension()});
+}
+}  // namespace
+
+BANG_TEST(ShaderProgramBinaryCache_IdentityHash)
+{
+    const Array<Path> shaderPaths = {Path("a.vert"), Path("a.frag")};
+    const Hash::HashType identityHash =
+        ShaderProgramBinaryCache::GetIdentityHash(shaderPaths, {});
+    BANG_CHECK(identityHash != 0);
+    BANG_CHECK(identityHash ==
+               ShaderProgramBinaryCache::GetIdentityHash(shaderPaths, {}));
+
+    // Variants and other shaders are other programs
+    BANG_CHECK(identityHash != ShaderProgramBinaryCache::GetIdentityHash(
+                                   shaderPaths, {"KEYWORD"}));
+    BANG_CHECK(identityHash !=
+               ShaderProgramBinaryCache::GetIdentityHash(
+                   {Path("a.vert"), Path("b.frag")}, {}));
+
+    // In-memory shaders have no identity
+    BANG_CHECK(ShaderProgramBinaryCache::GetIdentityHash(
+                   {Path::Empty(), Path::Empty()}, {"KEYWORD"}) == 0);
+}
+
+BANG_GL_TEST(ShaderProgramBinaryCache_HitsAndInvalidation)
+{
+    if (!GL::IsProgramBinarySupported())
+    {
+        return;
+    }
+
+    const Path prevProjectDir = Paths::GetProjectDir();
+    const Path projectDir =
+        Paths::GetExecutableDir().Append("ShaderProgramBinaryCacheTest");
+    File::Remove(projectDir);
+    BANG_CHECK(File::CreateDir(projectDir));
+    BANG_CHECK(File::CreateDir(projectDir.Append("Assets")));
+    Paths::SetProjectRoot(projectDir);
+
+    const Path vShaderPath = Paths::GetProjectAssetsDir().Append("Test.vert");
+    const Path fShaderPath = Paths::GetProjectAssetsDir().Append("Test.frag");
+    File::Write(vShaderPath, VertexSource);
+    File::Write(fShaderPath, FragmentSource);
+    MetaFilesManager::CreateMissingMetaFiles(Paths::GetProjectAssetsDir());
+    MetaFilesManager::LoadMetaFilepathGUIDs(Paths::GetProjectAssetsDir());
+
+    // The first link is a miss that saves the binary
+    uint numHits = ShaderProgramBinaryCache::GetNumHits();
+    uint numMisses = ShaderProgramBinaryCache::GetNumMisses();
+    AH<ShaderProgram> firstProgram =
+        Assets::Create<ShaderProgram>(vShaderPath, fShaderPath);
+    BANG_CHECK(firstProgram.Get()->IsLinked());
+    BANG_CHECK(ShaderProgramBinaryCache::GetNumHits() == numHits);
+    BANG_CHECK(ShaderProgramBinaryCache::GetNumMisses() == numMisses + 1);
+    Array<Path> cacheFilepaths = GetCacheFilepaths();
+    BANG_CHECK(cacheFilepaths.Size() == 1);
+    const Path firstCacheFilepath =
+        (cacheFilepaths.Size() == 1 ? cacheFilepaths.Front() : Path::Empty());
+
+    // The same sources are a hit
+    AH<ShaderProgram> secondProgram =
+        Assets::Create<ShaderProgram>(vShaderPath, fShaderPath);
+    BANG_CHECK(secondProgram.Get()->IsLinked());
+    BANG_CHECK(ShaderProgramBinaryCache::GetNumHits() == numHits + 1);
+    BANG_CHECK(ShaderProgramBinaryCache::GetNumMisses() == numMisses + 1);
+
+    // Editing a shader is a miss, and its new binary replaces the old one
+    Assets::Load<Shader>(fShaderPath).Get()->SetSourceCode(
+        EditedFragmentSource);
+    AH<ShaderProgram> editedProgram =
+        Assets::Create<ShaderProgram>(vShaderPath, fShaderPath);
+    BANG_CHECK(editedProgram.Get()->IsLinked());
+    BANG_CHECK(ShaderProgramBinaryCache::GetNumMisses() == numMisses + 2);
+    cacheFilepaths = GetCacheFilepaths();
+    BANG_CHECK(cacheFilepaths.Size() == 1);
+    BANG_CHECK(!firstCacheFilepath.IsFile());
+
+    // A corrupt binary is a miss, and gets replaced by a valid one
+    const Path editedCacheFilepath =
+        (cacheFilepaths.Size() == 1 ? cacheFilepaths.Front() : Path::Empty());
+    File::Write(editedCacheFilepath, "corrupt");
+    numHits = ShaderProgramBinaryCache::GetNumHits();
+    numMisses = ShaderProgramBinaryCache::GetNumMisses();
+    AH<ShaderProgram> repairedProgram =
+        Assets::Create<ShaderProgram>(vShaderPath, fShaderPath);
+    BANG_CHECK(repairedProgram.Get()->IsLinked());
+    BANG_CHECK(ShaderProgramBinaryCache::GetNumMisses() == numMisses + 1);
+    AH<ShaderProgram> cachedProgram =
+        Assets::Create<ShaderProgram>(vShaderPath, fShaderPath);
+    BANG_CHECK(cachedProgram.Get()->IsLinked());
+    BANG_CHECK(ShaderProgramBinaryCache::GetNumHits() == numHits + 1);
+    BANG_CHECK(GetCacheFilepaths().Size() == 1);
+
+    Paths::SetProjectRoot(prevProjectDir);
+    File::Remove(projectDir);
+}
@@ -0,0 +1,155 @@
+#include "BangTest.h"
+
+#include "Bang/Array.tcc"
+#include "Bang/Assets.h"
+#include "Bang/Assets.tcc"
+#include "Bang/GL.h"
+#include "Bang/Material.h"
+#include "Bang/Shader.h"
+#include "Bang/ShaderProgram.h"
+#include "Bang/USet.tcc"
+
+using namespace Bang;
+
+namespace
+{
+constexpr const char *VertexSource =
+    "void main() { gl_Position = vec4(0.0, 0.0, 0.0, 1.0); }\n";
+
+// Keywords A, B and C in two sets: A or B, and C or none
+constexpr const char *FragmentSource =
+    "#pragma multi_compile A B\n"
+    "#pragma multi_compile C _\n"
+    "out vec4 color;\n"
+    "void main() { color = vec4(1.0); }\n";
+
+AH<ShaderProgram> CreateShaderProgram(const String &fragmentSource)
+{
+    AH<Shader> vShader = Assets::Create<Shader>(GL::ShaderType::VERTEX);
+    vShader.Get()->SetSourceCode(VertexSource);
+    AH<Shader> fShader = Assets::Create<Shader>(GL::ShaderType::FRAGMENT);
+    fShader.Get()->SetSourceCode(fragmentSource);
+
+    AH<ShaderProgram> shaderProgram = Assets::Create<ShaderProgram>();
+    shaderProgram.Get()->Load(vShader.Get(), fShader.Get());
+    return shaderProgram;
+}
+
+USet<String> GetKeywords(const Array<String> &keywords)
+{
+    USet<String> keywordsSet;
+    keywordsSet.Add(keywords.Begin(), keywords.End());
+    return keywordsSet;
+}
+}  // namespace
+
+BANG_GL_TEST(ShaderProgram_KeywordsMask)
+{
+    AH<ShaderProgram> spAH = CreateShaderProgram(FragmentSource);
+    ShaderProgram *sp = spAH.Get();
+    BANG_CHECK(sp->IsLinked());
+    BANG_CHECK(sp->GetKeywordSets().Size() == 2);
+
+    // A set without "_" defaults to its first keyword, unknown keywords
+    // are ignored, and the first enabled keyword of a set wins
+    const uint64_t maskA = sp->GetKeywordsMask(GetKeywords({"A"}));
+    BANG_CHECK(maskA != 0);
+    BANG_CHECK(sp->GetKeywordsMask(GetKeywords({})) == maskA);
+    BANG_CHECK(sp->GetKeywordsMask(GetKeywords({"Z"})) == maskA);
+    BANG_CHECK(sp->GetKeywordsMask(GetKeywords({"A", "B"})) == maskA);
+
+    const uint64_t maskB = sp->GetKeywordsMask(GetKeywords({"B"}));
+    const uint64_t maskAC = sp->GetKeywordsMask(GetKeywords({"A", "C"}));
+    const uint64_t maskBC = sp->GetKeywordsMask(GetKeywords({"B", "C"}));
+    BANG_CHECK(maskB != maskA);
+    BANG_CHECK(maskAC == (maskA | sp->GetKeywordsMask(GetKeywords({"C"}))));
+    BANG_CHECK(maskBC == (maskB | (maskAC & ~maskA)));
+
+    // Same mask, same variant
+    ShaderProgram *variantA = sp->GetVariant(GetKeywords({"A"}));
+    BANG_CHECK(variantA != sp);
+    BANG_CHECK(variantA->IsVariant());
+    BANG_CHECK(variantA->IsLinked());
+    BANG_CHECK(sp->GetVariant(GetKeywords({"Z"})) == variantA);
+    BANG_CHECK(sp->GetVariant(GetKeywords({"B"})) != variantA);
+    BANG_CHECK(variantA->GetVariant(GetKeywords({"B"})) == variantA);
+
+    // Programs without keywords are their only variant
+    AH<ShaderProgram> noKeywordsAH =
+        CreateShaderProgram("out vec4 color;\n"
+                            "void main() { color = vec4(1.0); }\n");
+    ShaderProgram *noKeywords = noKeywordsAH.Get();
+    BANG_CHECK(noKeywords->GetKeywordSets().IsEmpty());
+    BANG_CHECK(noKeywords->GetKeywordsMask(GetKeywords({"A"})) == 0);
+    BANG_CHECK(noKeywords->GetVariant(GetKeywords({"A"})) == noKeywords);
+}
+
+BANG_GL_TEST(ShaderProgram_VariantsPermutations)
+{
+    AH<ShaderProgram> spAH = CreateShaderProgram(FragmentSource);
+    ShaderProgram *sp = spAH.Get();
+
+    // One keyword per set, all the masks different
+    const Array<Array<String>> variantsKeywords = sp->GetVariantsKeywords();
+    BANG_CHECK(variantsKeywords.Size() == 4);
+    USet<uint64_t> masks;
+    for (const Array<String> &variantKeywords : variantsKeywords)
+    {
+        BANG_CHECK(variantKeywords.Size() == 2);
+        masks.Add(sp->GetKeywordsMask(GetKeywords(variantKeywords)));
+    }
+    BANG_CHECK(masks.Size() == 4);
+
+    // Stripped variants are not enumerated, and fall back to the program
+    ShaderProgram::SetVariantStrippingFunction(
+        [](const ShaderProgram *, const Array<String> &variantKeywords) {
+            return variantKeywords.Contains("B") &&
+                   variantKeywords.Contains("C");
+        });
+    AH<ShaderProgram> strippedAH = CreateShaderProgram(FragmentSource);
+    ShaderProgram *stripped = strippedAH.Get();
+    BANG_CHECK(stripped->GetVariantsKeywords().Size() == 3);
+    BANG_CHECK(stripped->GetVariant(GetKeywords({"B", "C"})) == stripped);
+    BANG_CHECK(stripped->GetVariant(GetKeywords({"B"})) != stripped);
+    ShaderProgram::SetVariantStrippingFunction(nullptr);
+}
+
+BANG_GL_TEST(Material_CachesTheShaderProgramVariant)
+{
+    AH<ShaderProgram> spAH = CreateShaderProgram(FragmentSource);
+    ShaderProgram *sp = spAH.Get();
+    AH<Material> materialAH = Assets::Create<Material>();
+    Material *material = materialAH.Get();
+    material->SetShaderProgram(sp);
+
+    ShaderProgram *variantA = sp->GetVariant(GetKeywords({"A"}));
+    BANG_CHECK(material->GetBaseShaderProgram() == sp);
+    BANG_CHECK(material->GetShaderProgram() == variantA);
+    BANG_CHECK(material->GetShaderProgram() == variantA);
+
+    // Changing the keywords changes the variant
+    material->SetKeywordEnabled("B", true);
+    BANG_CHECK(material->GetShaderProgram() ==
+               sp->GetVariant(GetKeywords({"B"})));
+    material->SetKeywordEnabled("C", true);
+    BANG_CHECK(material->GetShaderProgram() ==
+               sp->GetVariant(GetKeywords({"B", "C"})));
+
+    // Loading other shaders drops the variants of the program
+    AH<Shader> vShader = Assets::Create<Shader>(GL::ShaderType::VERTEX);
+    vShader.Get()->SetSourceCode(VertexSource);
+    AH<Shader> fShader = Assets::Create<Shader>(GL::ShaderType::FRAGMENT);
+    fShader.Get()->SetSourceCode(FragmentSource);
+    sp->Load(vShader.Get(), fShader.Get());
+    ShaderProgram *relinkedVariant = sp->GetVariant(GetKeywords({"B", "C"}));
+    BANG_CHECK(relinkedVariant->IsLinked());
+    BANG_CHECK(material->GetShaderProgram() == relinkedVariant);
+
+    // And so does changing the program
+    AH<ShaderProgram> otherSpAH = CreateShaderProgram(FragmentSource);
+    material->SetShaderProgram(otherSpAH.Get());
+    BANG_CHECK(material->GetShaderProgram() ==
+               otherSpAH.Get()->GetVariant(GetKeywords({"B", "C"})));
+    material->SetShaderProgram(nullptr);
+    BANG_CHECK(material->GetShaderProgram() == nullptr);
+}
@@ -0,0 +1,79 @@
+#include "TestScenes.h"
+
+#include "Bang/Array.tcc"
+#include "Bang/Assets.h"
+#include "Bang/Assets.tcc"
+#include "Bang/Camera.h"
+#include "Bang/Color.h"
+#include "Bang/DirectionalLight.h"
+#include "Bang/GBuffer.h"
+#include "Bang/GEngine.h"
+#include "Bang/GameObject.h"
+#include "Bang/GameObject.tcc"
+#include "Bang/GameObjectFactory.h"
+#include "Bang/Material.h"
+#include "Bang/MaterialFactory.h"
+#include "Bang/Mesh.h"
+#include "Bang/MeshFactory.h"
+#include "Bang/MeshRenderer.h"
+#include "Bang/Scene.h"
+#include "Bang/Texture2D.h"
+#include "Bang/Transform.h"
+
+using namespace Bang;
+
+Scene *TestScenes::CreateLitScene(const Vector2i &renderSize,
+                                  const Vector3 &cameraPosition,
+                                  const Vector3 &lookAtPosition)
+{
+    Scene *scene = GameObjectFactory::CreateScene();
+
+    GameObject *cameraGo = GameObjectFactory::CreateGameObjectNamed("Camera");
+    Camera *camera = GameObjectFactory::CreateDefaultCameraInto(cameraGo);
+    camera->SetRenderSize(renderSize);
+    cameraGo->GetTransform()->SetPosition(cameraPosition);
+    cameraGo->GetTransform()->LookAt(lookAtPosition);
+    cameraGo->SetParent(scene);
+    scene->SetCamera(camera);
+
+    GameObject *lightGo = GameObjectFactory::CreateGameObjectNamed("Light");
+    DirectionalLight *light = lightGo->AddComponent<DirectionalLight>();
+    light->SetCastShadows(true);
+    lightGo->GetTransform()->SetPosition(Vector3(10, 10, 10));
+    lightGo->GetTransform()->LookAt(Vector3::Zero());
+    lightGo->SetParent(scene);
+
+    return scene;
+}
+
+GameObject *TestScenes::AddSphere(Scene *scene, const Vector3 &position)
+{
+    GameObject *sphereGo = GameObjectFactory::CreateGameObjectNamed("Sphere");
+    MeshRenderer *mr = sphereGo->AddComponent<MeshRenderer>();
+    mr->SetMaterial(MaterialFactory::GetDefault().Get());
+    mr->SetMesh(MeshFactory::GetSphere().Get());
+    sphereGo->GetTransform()->SetPosition(position);
+    sphereGo->SetParent(scene);
+    return sphereGo;
+}
+
+Array<AH<Texture2D>> TestScenes::CreateTextures(const Array<Color> &colors,
+                                                int size)
+{
+    Array<AH<Texture2D>> textures;
+    for (const Color &color : colors)
+    {
+        AH<Texture2D> tex = Assets::Create<Texture2D>();
+        tex.Get()->SetFormat(GL::ColorFormat::RGBA8);
+        tex.Get()->Fill(color, size, size);
+        textures.PushBack(tex);
+    }
+    return textures;
+}
+
+Image TestScenes::Render(Scene *scene)
+{
+    Camera *camera = scene->GetCamera();
+    GEngine::GetInstance()->Render(scene, camera);
+    return camera->GetGBuffer()->GetDrawColorTexture()->ToImage();
+}
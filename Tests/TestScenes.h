@@ -0,0 +1,42 @@
+#ifndef TESTSCENES_H
+#define TESTSCENES_H
+
+#include "Bang/Array.h"
+#include "Bang/AssetHandle.h"
+#include "Bang/BangDefines.h"
+#include "Bang/Image.h"
+#include "Bang/Vector2.h"
+#include "Bang/Vector3.h"
+
+namespace Bang
+{
+class Color;
+class GameObject;
+class Scene;
+class Texture2D;
+
+// Building blocks of the scenes that the GL tests render. Each test places
+// its own objects, so that changing one test does not change the others
+class TestScenes
+{
+public:
+    // Scene with a camera looking at lookAtPosition from cameraPosition,
+    // and a directional light casting shadows. It is the caller's to destroy
+    static Scene *CreateLitScene(const Vector2i &renderSize,
+                                 const Vector3 &cameraPosition,
+                                 const Vector3 &lookAtPosition);
+
+    static GameObject *AddSphere(Scene *scene, const Vector3 &position);
+
+    // Solid color RGBA8 textures of the given size, one per color
+    static Array<AH<Texture2D>> CreateTextures(const Array<Color> &colors,
+                                               int size);
+
+    // Renders the scene with its camera, and reads back its color
+    static Image Render(Scene *scene);
+
+    TestScenes() = delete;
+};
+}  // namespace Bang
+
+#endif  // TESTSCENES_H
@@ -0,0 +1,53 @@
+#include "BangTest.h"
+
+#include "Bang/Array.tcc"
+#include "Bang/String.h"
+#include "Bang/TextFormatter.h"
+
+using namespace Bang;
+
+namespace
+{
+constexpr uint ReplacementChar = 0xFFFD;
+
+bool DecodesTo(const String &content, const Array<uint> &expectedCodepoints)
+{
+    return TextFormatter::GetCodepoints(content) == expectedCodepoints;
+}
+}  // namespace
+
+BANG_TEST(TextFormatter_DecodesUTF8)
+{
+    BANG_CHECK(DecodesTo("", {}));
+    BANG_CHECK(DecodesTo("ab", {'a', 'b'}));
+
+    // 2, 3 and 4 bytes sequences: e acute, euro sign and a smiley
+    BANG_CHECK(DecodesTo("\xC3\xA9", {0xE9}));
+    BANG_CHECK(DecodesTo("\xE2\x82\xAC", {0x20AC}));
+    BANG_CHECK(DecodesTo("\xF0\x9F\x98\x80", {0x1F600}));
+    BANG_CHECK(DecodesTo("a\xE2\x82\xAC" "b", {'a', 0x20AC, 'b'}));
+}
+
+BANG_TEST(TextFormatter_InvalidUTF8IsReplaced)
+{
+    // Lead bytes that can not start any sequence
+    BANG_CHECK(DecodesTo("\x80", {ReplacementChar}));
+    BANG_CHECK(DecodesTo("\xC0\x80", {ReplacementChar, ReplacementChar}));
+    BANG_CHECK(DecodesTo("\xF5\x80\x80\x80",
+                         {ReplacementChar,
+                          ReplacementChar,
+                          ReplacementChar,
+                          ReplacementChar}));
+    BANG_CHECK(DecodesTo("\xF8\x80\x80",
+                         {ReplacementChar, ReplacementChar, ReplacementChar}));
+    BANG_CHECK(DecodesTo("\xFF" "a", {ReplacementChar, 'a'}));
+
+    // Overlong, surrogate and out of range sequences
+    BANG_CHECK(DecodesTo("\xE0\x80\xAF", {ReplacementChar}));
+    BANG_CHECK(DecodesTo("\xED\xA0\x80", {ReplacementChar}));
+    BANG_CHECK(DecodesTo("\xF4\x90\x80\x80", {ReplacementChar}));
+
+    // Truncated sequences do not eat the next char
+    BANG_CHECK(DecodesTo("\xE2\x82" "a", {ReplacementChar, 'a'}));
+    BANG_CHECK(DecodesTo("\xE2\x82", {ReplacementChar}));
+}
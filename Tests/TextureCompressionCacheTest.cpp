@@ -0,0 +1,70 @@
+#include "BangTest.h"
+
+#include "Bang/Array.tcc"
+#include "Bang/File.h"
+#include "Bang/Image.h"
+#include "Bang/Paths.h"
+#include "Bang/TextureCompressionCache.h"
+#include "Bang/TextureCompressor.h"
+
+using namespace Bang;
+
+BANG_TEST(TextureCompressionCache_RoundTripAndStaleSweep)
+{
+    const Path dir =
+        Paths::GetExecutableDir().Append("TextureCompressionCacheTest");
+    File::Remove(dir);
+    BANG_CHECK(File::CreateDir(dir));
+
+    // The cache is keyed on the image file bytes, they do not need to be a
+    // valid image
+    const Path imageFilepath = dir.Append("image.png");
+    File::Write(imageFilepath, "first version");
+
+    Image image;
+    image.Create(8, 8);
+    Array<CompressedMipMap> mipMaps;
+    TextureCompressor::CompressMipMaps(
+        image, TextureCompression::BC3, &mipMaps);
+
+    const Hash::HashType firstHash = TextureCompressionCache::GetCacheHash(
+        imageFilepath, TextureCompression::BC3);
+    const Path firstCachePath =
+        TextureCompressionCache::GetCacheFilepath(imageFilepath, firstHash);
+    BANG_CHECK(
+        TextureCompressionCache::Write(firstCachePath, firstHash, mipMaps));
+
+    Array<CompressedMipMap> readMipMaps;
+    BANG_CHECK(TextureCompressionCache::Read(
+        firstCachePath, firstHash, &readMipMaps));
+    BANG_CHECK(readMipMaps.Size() == mipMaps.Size());
+    for (uint i = 0; i < readMipMaps.Size() && i < mipMaps.Size(); ++i)
+    {
+        BANG_CHECK(readMipMaps[i].size == mipMaps[i].size);
+        BANG_CHECK(readMipMaps[i].data == mipMaps[i].data);
+    }
+
+    // Other compression settings make a different key
+    BANG_CHECK(firstHash != TextureCompressionCache::GetCacheHash(
+                                imageFilepath, TextureCompression::BC1));
+    BANG_CHECK(!TextureCompressionCache::Read(
+        firstCachePath,
+        TextureCompressionCache::GetCacheHash(imageFilepath,
+                                              TextureCompression::BC1),
+        &readMipMaps));
+
+    // Editing the image and writing the new entry sweeps the outdated one
+    File::Write(imageFilepath, "second version");
+    const Hash::HashType secondHash = TextureCompressionCache::GetCacheHash(
+        imageFilepath, TextureCompression::BC3);
+    const Path secondCachePath =
+        TextureCompressionCache::GetCacheFilepath(imageFilepath, secondHash);
+    BANG_CHECK(secondHash != firstHash);
+    BANG_CHECK(
+        TextureCompressionCache::Write(secondCachePath, secondHash, mipMaps));
+    BANG_CHECK(secondCachePath.IsFile());
+    BANG_CHECK(!firstCachePath.IsFile());
+    BANG_CHECK(imageFilepath.IsFile());
+
+    File::Remove(dir);
+}
@@ -0,0 +1,167 @@
+#include <cstdlib>
+
+#include "BangTest.h"
+
+#include "Bang/Array.tcc"
+#include "Bang/Image.h"
+#include "Bang/Math.h"
+#include "Bang/TextureCompressor.h"
+
+using namespace Bang;
+
+namespace
+{
+// Smooth RGBA gradients, the content BCn is meant for
+Image CreateGradientImage(int width, int height)
+{
+    Image image;
+    image.Create(width, height);
+    Byte *pixels = image.GetData();
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            Byte *pixel = pixels + (y * width + x) * 4;
+            pixel[0] = SCAST<Byte>((x * 255) / Math::Max(width - 1, 1));
+            pixel[1] = SCAST<Byte>((y * 255) / Math::Max(height - 1, 1));
+            pixel[2] = SCAST<Byte>(((x + y) * 255) /
+                                   Math::Max(width + height - 2, 1));
+            pixel[3] = SCAST<Byte>(255 - pixel[0]);
+        }
+    }
+    return image;
+}
+
+Image RoundTrip(const Image &image, TextureCompression compression)
+{
+    Array<Byte> compressedData;
+    TextureCompressor::Compress(image, compression, &compressedData);
+
+    Image decompressed;
+    TextureCompressor::Decompress(
+        compressedData.Data(), image.GetSize(), compression, &decompressed);
+    return decompressed;
+}
+
+int GetMaxChannelError(const Image &lhs, const Image &rhs, int channel)
+{
+    int maxError = 0;
+    const int numPixels = (lhs.GetWidth() * lhs.GetHeight());
+    for (int i = 0; i < numPixels; ++i)
+    {
+        const int lhsValue = lhs.GetData()[i * 4 + channel];
+        const int rhsValue = rhs.GetData()[i * 4 + channel];
+        maxError = Math::Max(maxError, std::abs(lhsValue - rhsValue));
+    }
+    return maxError;
+}
+}  // namespace
+
+BANG_TEST(TextureCompressor_CompressedBytesSize)
+{
+    // Partial blocks are padded up to whole 4x4 blocks
+    BANG_CHECK(TextureCompressor::GetCompressedBytesSize(
+                   Vector2i(8, 8), TextureCompression::BC1) == 4 * 8);
+    BANG_CHECK(TextureCompressor::GetCompressedBytesSize(
+                   Vector2i(7, 5), TextureCompression::BC1) == 4 * 8);
+    BANG_CHECK(TextureCompressor::GetCompressedBytesSize(
+                   Vector2i(7, 5), TextureCompression::BC3) == 4 * 16);
+    BANG_CHECK(TextureCompressor::GetCompressedBytesSize(
+                   Vector2i(1, 1), TextureCompression::BC5) == 16);
+}
+
+BANG_TEST(TextureCompressor_BC1SolidColorIsExact)
+{
+    // Colors representable in RGB565 must survive untouched
+    Image image;
+    image.Create(8, 8);
+    for (int i = 0; i < 8 * 8; ++i)
+    {
+        Byte *pixel = image.GetData() + i * 4;
+        pixel[0] = 255;
+        pixel[1] = 0;
+        pixel[2] = 255;
+        pixel[3] = 255;
+    }
+
+    const Image decompressed = RoundTrip(image, TextureCompression::BC1);
+    for (int channel = 0; channel < 4; ++channel)
+    {
+        BANG_CHECK(GetMaxChannelError(image, decompressed, channel) == 0);
+    }
+}
+
+BANG_TEST(TextureCompressor_BC1RoundTrip)
+{
+    const Image image = CreateGradientImage(64, 32);
+    const Image decompressed = RoundTrip(image, TextureCompression::BC1);
+    BANG_CHECK(decompressed.GetSize() == image.GetSize());
+    for (int channel = 0; channel < 3; ++channel)
+    {
+        BANG_CHECK(GetMaxChannelError(image, decompressed, channel) <= 16);
+    }
+
+    // Alpha is dropped
+    for (int i = 0; i < 64 * 32; ++i)
+    {
+        BANG_CHECK(decompressed.GetData()[i * 4 + 3] == 255);
+    }
+}
+
+BANG_TEST(TextureCompressor_BC3RoundTrip)
+{
+    const Image image = CreateGradientImage(64, 32);
+    const Image decompressed = RoundTrip(image, TextureCompression::BC3);
+    for (int channel = 0; channel < 3; ++channel)
+    {
+        BANG_CHECK(GetMaxChannelError(image, decompressed, channel) <= 16);
+    }
+
+    // Alpha has 8 interpolated levels per block
+    BANG_CHECK(GetMaxChannelError(image, decompressed, 3) <= 4);
+}
+
+BANG_TEST(TextureCompressor_BC5RoundTrip)
+{
+    const Image image = CreateGradientImage(64, 32);
+    const Image decompressed = RoundTrip(image, TextureCompression::BC5);
+    BANG_CHECK(GetMaxChannelError(image, decompressed, 0) <= 4);
+    BANG_CHECK(GetMaxChannelError(image, decompressed, 1) <= 4);
+
+    // Only RG are stored
+    for (int i = 0; i < 64 * 32; ++i)
+    {
+        BANG_CHECK(decompressed.GetData()[i * 4 + 2] == 0);
+        BANG_CHECK(decompressed.GetData()[i * 4 + 3] == 255);
+    }
+}
+
+BANG_TEST(TextureCompressor_PartialBlocksRoundTrip)
+{
+    const Image image = CreateGradientImage(7, 5);
+    const Image decompressed = RoundTrip(image, TextureCompression::BC3);
+    BANG_CHECK(decompressed.GetSize() == Vector2i(7, 5));
+
+    // The gradient is steep here (up to ~127 inside a block), and the 8
+    // alpha levels leave at most half a step (~9) of error
+    BANG_CHECK(GetMaxChannelError(image, decompressed, 3) <= 10);
+}
+
+BANG_TEST(TextureCompressor_MipMapChain)
+{
+    const Image image = CreateGradientImage(32, 8);
+    Array<CompressedMipMap> mipMaps;
+    TextureCompressor::CompressMipMaps(
+        image, TextureCompression::BC1, &mipMaps);
+
+    // 32x8, 16x4, 8x2, 4x1, 2x1, 1x1
+    BANG_CHECK(mipMaps.Size() == 6);
+    BANG_CHECK(mipMaps.Front().size == Vector2i(32, 8));
+    BANG_CHECK(mipMaps.Back().size == Vector2i(1, 1));
+    for (const CompressedMipMap &mipMap : mipMaps)
+    {
+        BANG_CHECK(mipMap.data.Size() ==
+                   TextureCompressor::GetCompressedBytesSize(
+                       mipMap.size, TextureCompression::BC1));
+    }
+}
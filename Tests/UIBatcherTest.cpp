@@ -0,0 +1,320 @@
+#include <random>
+
+#include "BangTest.h"
+#include "ImageDiff.h"
+#include "TestScenes.h"
+
+#include "Bang/Array.tcc"
+#include "Bang/Camera.h"
+#include "Bang/Color.h"
+#include "Bang/GameObject.h"
+#include "Bang/GameObjectFactory.h"
+#include "Bang/Image.h"
+#include "Bang/RectTransform.h"
+#include "Bang/Scene.h"
+#include "Bang/String.h"
+#include "Bang/Texture2D.h"
+#include "Bang/UIBatcher.h"
+#include "Bang/UICanvas.h"
+#include "Bang/UIImageRenderer.h"
+#include "Bang/UIMask.h"
+#include "Bang/UIRectMask.h"
+#include "Bang/UITextRenderer.h"
+#include "Bang/Vector2.h"
+#include "Bang/Vector3.h"
+
+using namespace Bang;
+
+namespace
+{
+// Each batched vertex is transformed in the CPU instead of in the shader
+constexpr float Tolerance = 4.0f / 255.0f;
+
+// Panels of widgets, cycling through: plain, rect masked, stencil masked,
+// and with a nested canvas
+constexpr int NumPanels = 8;
+constexpr int NumWidgetsPerPanel = 625;
+
+void AddQuad(UIBatcher *batcher, Texture2D *texture)
+{
+    const int slot = batcher->AcquireTextureSlot(texture);
+    for (int i = 0; i < 6; ++i)
+    {
+        batcher->AddVertex(Vector3::Zero(),
+                           Vector2::Zero(),
+                           Color::White(),
+                           slot,
+                           0.0f,
+                           UIBatcher::Mode::IMAGE);
+    }
+}
+
+struct WidgetsScene
+{
+    Scene *scene = nullptr;
+    Array<UICanvas *> canvases;
+    Array<AH<Texture2D>> textures;
+    uint numWidgets = 0;
+};
+
+// Overlapping translucent images (textured or not) and texts, some of them
+// sticking out of their panel, so that the result depends on their order
+// and on the masks
+WidgetsScene CreateWidgetsScene()
+{
+    std::mt19937 randomEngine(41);
+    auto RandomFloat = [&randomEngine](float minValue, float maxValue) {
+        return std::uniform_real_distribution<float>(minValue,
+                                                     maxValue)(randomEngine);
+    };
+
+    WidgetsScene widgetsScene;
+    widgetsScene.scene = GameObjectFactory::CreateUIScene();
+    widgetsScene.scene->GetCamera()->SetRenderSize(Vector2i(256, 128));
+    widgetsScene.canvases.PushBack(
+        widgetsScene.scene->GetComponent<UICanvas>());
+    widgetsScene.textures =
+        TestScenes::CreateTextures({Color(1.0f, 0.0f, 0.0f, 0.5f),
+                                    Color(0.0f, 1.0f, 0.0f, 0.75f),
+                                    Color(0.0f, 0.0f, 1.0f, 0.25f),
+                                    Color(1.0f, 1.0f, 0.0f, 1.0f)},
+                                   4);
+
+    for (int p = 0; p < NumPanels; ++p)
+    {
+        GameObject *panelGo = GameObjectFactory::CreateUIGameObject();
+        const Vector2 panelMin(-1.0f + (p % 4) * 0.5f, -1.0f + (p / 4) * 1.0f);
+        panelGo->GetRectTransform()->SetAnchors(panelMin,
+                                                panelMin + Vector2(0.5f, 1.0f));
+        panelGo->GetRectTransform()->SetMargins(4);
+        switch (p % 4)
+        {
+            case 1: panelGo->AddComponent<UIRectMask>(); break;
+
+            case 2:
+            {
+                // The mask goes first, to set the stencil up for its shape
+                panelGo->AddComponent<UIMask>();
+                UIImageRenderer *maskImg =
+                    panelGo->AddComponent<UIImageRenderer>();
+                maskImg->SetTint(Color(0.5f, 0.5f, 0.5f, 1.0f));
+            }
+            break;
+
+            case 3:
+                widgetsScene.canvases.PushBack(
+                    panelGo->AddComponent<UICanvas>());
+                break;
+        }
+        panelGo->SetParent(widgetsScene.scene);
+
+        for (int i = 0; i < NumWidgetsPerPanel; ++i)
+        {
+            GameObject *widgetGo = GameObjectFactory::CreateUIGameObject();
+            const Vector2 widgetMin(RandomFloat(-1.2f, 0.9f),
+                                    RandomFloat(-1.2f, 0.9f));
+            widgetGo->GetRectTransform()->SetAnchors(
+                widgetMin,
+                widgetMin + Vector2(RandomFloat(0.05f, 0.3f),
+                                    RandomFloat(0.05f, 0.3f)));
+            if (i % 8 == 0)
+            {
+                UITextRenderer *text = widgetGo->AddComponent<UITextRenderer>();
+                text->SetContent("Ab" + String::ToString(i % 10));
+                text->SetTextSize(10);
+                text->SetTextColor(Color(0.1f, 0.2f, 0.9f, 0.8f));
+            }
+            else
+            {
+                UIImageRenderer *img =
+                    widgetGo->AddComponent<UIImageRenderer>();
+                const uint texIndex = (widgetsScene.numWidgets %
+                                       (widgetsScene.textures.Size() + 1));
+                if (texIndex < widgetsScene.textures.Size())
+                {
+                    img->SetImageTexture(
+                        widgetsScene.textures[texIndex].Get());
+                }
+                img->SetTint(Color(1.0f, 1.0f, 1.0f, RandomFloat(0.3f, 1.0f)));
+            }
+            widgetGo->SetParent(panelGo);
+            ++widgetsScene.numWidgets;
+        }
+    }
+    return widgetsScene;
+}
+
+void SetBatchingEnabled(const WidgetsScene &widgetsScene, bool enabled)
+{
+    for (UICanvas *canvas : widgetsScene.canvases)
+    {
+        canvas->GetBatcher()->SetEnabled(enabled);
+    }
+}
+
+uint GetNumDrawCalls(const WidgetsScene &widgetsScene)
+{
+    uint numDrawCalls = 0;
+    for (UICanvas *canvas : widgetsScene.canvases)
+    {
+        numDrawCalls += canvas->GetBatcher()->GetNumDrawCalls();
+    }
+    return numDrawCalls;
+}
+}  // namespace
+
+BANG_TEST(UIBatcher_UntexturedQuadsAreOneDrawCall)
+{
+    UIBatcher batcher;
+    batcher.Begin();
+    for (int i = 0; i < 100; ++i)
+    {
+        AddQuad(&batcher, nullptr);
+    }
+    batcher.End();
+
+    BANG_CHECK(batcher.GetNumDrawCalls() == 1);
+    BANG_CHECK(batcher.GetNumBatchedVertices() == 100 * 6);
+}
+
+BANG_TEST(UIBatcher_DepthMaskChangeFlushes)
+{
+    UIBatcher batcher;
+    batcher.Begin();
+    AddQuad(&batcher, nullptr);
+    batcher.SetDepthMask(true);
+    BANG_CHECK(batcher.GetNumDrawCalls() == 0);
+
+    batcher.SetDepthMask(false);
+    AddQuad(&batcher, nullptr);
+    batcher.SetDepthMask(true);
+    AddQuad(&batcher, nullptr);
+    batcher.End();
+    BANG_CHECK(batcher.GetNumDrawCalls() == 3);
+}
+
+BANG_TEST(UIBatcher_NestedCanvases)
+{
+    UIBatcher outerBatcher;
+    UIBatcher innerBatcher;
+
+    outerBatcher.Begin();
+    BANG_CHECK(UIBatcher::GetActive() == &outerBatcher);
+    AddQuad(&outerBatcher, nullptr);
+
+    // Beginning the inner canvas flushes what the outer one had, to keep
+    // the paint order
+    innerBatcher.Begin();
+    BANG_CHECK(UIBatcher::GetActive() == &innerBatcher);
+    BANG_CHECK(outerBatcher.GetNumDrawCalls() == 1);
+    AddQuad(&innerBatcher, nullptr);
+    innerBatcher.End();
+    BANG_CHECK(innerBatcher.GetNumDrawCalls() == 1);
+
+    BANG_CHECK(UIBatcher::GetActive() == &outerBatcher);
+    AddQuad(&outerBatcher, nullptr);
+    UIBatcher::FlushActive();
+    BANG_CHECK(outerBatcher.GetNumDrawCalls() == 2);
+    outerBatcher.End();
+
+    BANG_CHECK(UIBatcher::GetActive() == nullptr);
+    BANG_CHECK(outerBatcher.GetNumDrawCalls() == 2);
+}
+
+BANG_TEST(UIBatcher_EmptyFlushIsNotADrawCall)
+{
+    UIBatcher batcher;
+    batcher.Begin();
+    batcher.Flush();
+    UIBatcher::FlushActive();
+    batcher.End();
+    BANG_CHECK(batcher.GetNumDrawCalls() == 0);
+}
+
+BANG_GL_TEST(UIBatcher_SameTexturesIsOneDrawCall)
+{
+    const Array<AH<Texture2D>> textures = TestScenes::CreateTextures(
+        {Color::Red(), Color::Green(), Color::Blue()}, 4);
+    UIBatcher batcher;
+    batcher.Begin();
+    for (int i = 0; i < 100; ++i)
+    {
+        AddQuad(&batcher, textures[i % 3].Get());
+    }
+    AddQuad(&batcher, nullptr);
+    batcher.End();
+
+    BANG_CHECK(batcher.GetNumDrawCalls() == 1);
+    BANG_CHECK(batcher.GetNumBatchedVertices() == 101 * 6);
+}
+
+BANG_GL_TEST(UIBatcher_RunningOutOfSlotsFlushes)
+{
+    Array<Color> colors;
+    for (uint i = 0; i <= UIBatcher::MaxTextureSlots; ++i)
+    {
+        colors.PushBack(Color(i / 10.0f, 0.0f, 0.0f, 1.0f));
+    }
+    const Array<AH<Texture2D>> textures =
+        TestScenes::CreateTextures(colors, 4);
+
+    UIBatcher batcher;
+    batcher.Begin();
+    for (uint i = 0; i < UIBatcher::MaxTextureSlots; ++i)
+    {
+        AddQuad(&batcher, textures[i].Get());
+    }
+    BANG_CHECK(batcher.GetNumDrawCalls() == 0);
+
+    Texture2D *lastTexture = textures.Back().Get();
+    AddQuad(&batcher, lastTexture);
+    BANG_CHECK(batcher.GetNumDrawCalls() == 1);
+
+    // The new batch starts with the texture that did not fit
+    BANG_CHECK(batcher.AcquireTextureSlot(lastTexture) == 0);
+    batcher.End();
+    BANG_CHECK(batcher.GetNumDrawCalls() == 2);
+}
+
+BANG_GL_TEST(UIBatcher_ManyWidgetsLookLikeDrawingOneByOne)
+{
+    WidgetsScene widgetsScene = CreateWidgetsScene();
+    BANG_CHECK(widgetsScene.numWidgets == NumPanels * NumWidgetsPerPanel);
+
+    // Five textures (four images and the font atlas) fit in the slots, so
+    // only the masks and canvases split the batches. Every two panels:
+    // - the plain panel is drawn by the rect mask flush of the next one
+    // - the rect masked panel is drawn before restoring the scissor
+    // - the stencil mask is drawn before its children, then the children,
+    //   and then the mask again, to restore the stencil
+    // - the nested canvas draws its panel once
+    SetBatchingEnabled(widgetsScene, true);
+    const Image batchedImage = TestScenes::Render(widgetsScene.scene);
+    const uint numPanelGroups = (NumPanels / 4);
+    BANG_CHECK(widgetsScene.canvases.Front()->GetBatcher()->GetNumDrawCalls() ==
+               numPanelGroups * 5);
+    BANG_CHECK(GetNumDrawCalls(widgetsScene) == numPanelGroups * 6);
+    BANG_CHECK(GetNumDrawCalls(widgetsScene) * 100 < widgetsScene.numWidgets);
+
+    SetBatchingEnabled(widgetsScene, false);
+    const Image oneByOneImage = TestScenes::Render(widgetsScene.scene);
+    BANG_CHECK(GetNumDrawCalls(widgetsScene) == 0);
+    SetBatchingEnabled(widgetsScene, true);
+    BANG_CHECK(ImageDiff::Matches(
+        batchedImage, oneByOneImage, Tolerance, "UIBatchedVsOneByOne"));
+
+    // The widgets do show, so the images above do compare something
+    for (GameObject *panelGo : widgetsScene.scene->GetChildren())
+    {
+        if (panelGo->GetRectTransform())
+        {
+            panelGo->SetEnabled(false);
+        }
+    }
+    const Image noWidgetsImage = TestScenes::Render(widgetsScene.scene);
+    BANG_CHECK(ImageDiff::GetNumDifferentPixels(
+                   batchedImage, noWidgetsImage, Tolerance) >
+               batchedImage.GetWidth() * batchedImage.GetHeight() / 2);
+
+    GameObject::DestroyImmediate(widgetsScene.scene);
+}
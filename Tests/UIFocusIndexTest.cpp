@@ -0,0 +1,332 @@
+#include <random>
+#include <utility>
+
+#include "BangTest.h"
+
+#include "Bang/AARect.h"
+#include "Bang/Array.tcc"
+#include "Bang/DPtr.tcc"
+#include "Bang/GL.h"
+#include "Bang/GameObject.h"
+#include "Bang/GameObjectFactory.h"
+#include "Bang/RectTransform.h"
+#include "Bang/UICanvas.h"
+#include "Bang/UIFocusIndex.h"
+#include "Bang/UIFocusable.h"
+#include "Bang/UILayoutElement.h"
+#include "Bang/UIRectMask.h"
+
+using namespace Bang;
+
+namespace
+{
+int BruteForceFirstIndexAt(const Array<AARect> &rects,
+                           const std::function<bool(uint)> &passesTest)
+{
+    for (uint i = 0; i < rects.Size(); ++i)
+    {
+        if (passesTest(i))
+        {
+            return SCAST<int>(i);
+        }
+    }
+    return -1;
+}
+
+GameObject *CreateFocusableGo(GameObject *parent)
+{
+    GameObject *go = GameObjectFactory::CreateUIGameObject();
+    go->AddComponent<UIFocusable>();
+    go->SetParent(parent);
+    return go;
+}
+
+void UpdateAll(const Array<UICanvas *> &canvases)
+{
+    for (UICanvas *canvas : canvases)
+    {
+        canvas->GetFocusIndex()->Update(canvas);
+    }
+}
+
+// Same tests as the canvas ones for the focusable under the mouse
+bool IsAt(UIFocusable *focusable,
+          const AARecti &maskRectVP,
+          const Vector2i &pointVP)
+{
+    RectTransform *rt = focusable->GetGameObject()->GetRectTransform();
+    const AARect rectVP = rt->GetViewportAARect();
+    return maskRectVP.Contains(pointVP) && rectVP.IsValid() &&
+           rectVP.Contains(Vector2(pointVP)) &&
+           focusable->IsEnabledRecursively();
+}
+
+// Checks the cached candidates and grid of the canvas against gathering the
+// candidates again and going through all of them
+void CheckAgainstCandidates(UICanvas *canvas, std::mt19937 *randomEngine)
+{
+    UIFocusIndex *focusIndex = canvas->GetFocusIndex();
+    focusIndex->Update(canvas);
+
+    Array<std::pair<UIFocusable *, AARecti>> candidates;
+    canvas->GetSortedFocusCandidatesByOcclusionOrder(canvas->GetGameObject(),
+                                                     &candidates);
+    const Array<DPtr<UIFocusable>> &focusables = focusIndex->GetFocusables();
+    const Array<AARecti> &maskRectsVP = focusIndex->GetMaskRectsVP();
+    BANG_CHECK(focusables.Size() == candidates.Size());
+    if (focusables.Size() != candidates.Size())
+    {
+        return;
+    }
+
+    for (uint i = 0; i < candidates.Size(); ++i)
+    {
+        BANG_CHECK(focusables[i].Get() == candidates[i].first);
+        BANG_CHECK(maskRectsVP[i] == candidates[i].second);
+    }
+
+    const Vector2i vpSize = GL::GetViewportRect().GetSize();
+    std::uniform_int_distribution<int> xDistribution(-10, vpSize.x + 10);
+    std::uniform_int_distribution<int> yDistribution(-10, vpSize.y + 10);
+    for (int j = 0; j < 200; ++j)
+    {
+        const Vector2i pointVP(xDistribution(*randomEngine),
+                               yDistribution(*randomEngine));
+        int expectedIndex = -1;
+        for (uint i = 0; i < candidates.Size(); ++i)
+        {
+            if (IsAt(candidates[i].first, candidates[i].second, pointVP))
+            {
+                expectedIndex = SCAST<int>(i);
+                break;
+            }
+        }
+
+        auto IsCandidateAt = [&](uint i) {
+            return IsAt(focusables[i].Get(), maskRectsVP[i], pointVP);
+        };
+        BANG_CHECK(focusIndex->GetFirstIndexAt(pointVP, IsCandidateAt) ==
+                   expectedIndex);
+    }
+}
+
+bool AreInvalid(const Array<UICanvas *> &canvases,
+                const Array<bool> &expectedInvalid)
+{
+    for (uint i = 0; i < canvases.Size(); ++i)
+    {
+        if (canvases[i]->GetFocusIndex()->IsInvalid() != expectedInvalid[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+BANG_TEST(UIFocusIndex_GridMatchesBruteForce)
+{
+    std::mt19937 randomEngine(4321);
+    auto RandomFloat = [&randomEngine](float minValue, float maxValue) {
+        return std::uniform_real_distribution<float>(minValue,
+                                                     maxValue)(randomEngine);
+    };
+    auto RandomInt = [&randomEngine](int minValue, int maxValue) {
+        return std::uniform_int_distribution<int>(minValue,
+                                                  maxValue)(randomEngine);
+    };
+
+    for (const Vector2i &vpSize : {Vector2i(800, 600),
+                                   Vector2i(333, 177),
+                                   Vector2i(64, 64),
+                                   Vector2i(1, 1)})
+    {
+        const AARecti viewportRect(Vector2i::Zero(), vpSize);
+        for (int numRects : {0, 1, 10, 300})
+        {
+            // Rects can be partially or fully out of the viewport, and
+            // some of them are empty or filtered out by the test
+            Array<AARect> rects;
+            Array<bool> enabled;
+            for (int i = 0; i < numRects; ++i)
+            {
+                const Vector2 min(RandomFloat(-100.0f, vpSize.x + 50.0f),
+                                  RandomFloat(-100.0f, vpSize.y + 50.0f));
+                const Vector2 size(RandomFloat(0.0f, 150.0f),
+                                   RandomFloat(0.0f, 150.0f));
+                rects.PushBack(AARect(min, min + size));
+                enabled.PushBack(RandomInt(0, 9) != 0);
+            }
+
+            UIFocusIndex focusIndex;
+            focusIndex.BuildGrid(viewportRect, rects);
+            for (int j = 0; j < 2000; ++j)
+            {
+                const Vector2i point(RandomInt(-20, vpSize.x + 20),
+                                     RandomInt(-20, vpSize.y + 20));
+                auto PassesTest = [&](uint i) {
+                    return enabled[i] && rects[i].Contains(Vector2(point));
+                };
+                BANG_CHECK(focusIndex.GetFirstIndexAt(point, PassesTest) ==
+                           BruteForceFirstIndexAt(rects, PassesTest));
+            }
+        }
+    }
+}
+
+BANG_TEST(UIFocusIndex_InvalidationIsPerCanvas)
+{
+    // Canvas C is nested inside canvas A, canvas B is apart
+    UICanvas *canvasA = GameObjectFactory::CreateUICanvas();
+    UICanvas *canvasB = GameObjectFactory::CreateUICanvas();
+    GameObject *leafA = CreateFocusableGo(canvasA->GetGameObject());
+    GameObject *leafB = CreateFocusableGo(canvasB->GetGameObject());
+    GameObject *nestedGo = GameObjectFactory::CreateUIGameObject();
+    nestedGo->SetParent(canvasA->GetGameObject());
+    UICanvas *canvasC = nestedGo->AddComponent<UICanvas>();
+    GameObject *leafC = CreateFocusableGo(nestedGo);
+
+    const Array<UICanvas *> canvases = {canvasA, canvasB, canvasC};
+    UpdateAll(canvases);
+    BANG_CHECK(AreInvalid(canvases, {false, false, false}));
+
+    leafB->SetVisible(false);
+    BANG_CHECK(AreInvalid(canvases, {false, true, false}));
+    UpdateAll(canvases);
+
+    // The nested canvas candidates are the outer canvas ones too
+    leafC->SetEnabled(false);
+    BANG_CHECK(AreInvalid(canvases, {true, false, true}));
+    UpdateAll(canvases);
+
+    leafA->GetRectTransform()->SetMarginLeft(5);
+    BANG_CHECK(AreInvalid(canvases, {true, false, false}));
+    UpdateAll(canvases);
+
+    // Changes where they start also invalidate the canvases nested below,
+    // even if they only reach them through the propagation
+    canvasA->GetGameObject()->GetRectTransform()->SetMarginLeft(3);
+    BANG_CHECK(AreInvalid(canvases, {true, false, true}));
+    UpdateAll(canvases);
+
+    canvasA->GetGameObject()->SetEnabled(false);
+    BANG_CHECK(AreInvalid(canvases, {true, false, true}));
+    UpdateAll(canvases);
+    canvasA->GetGameObject()->SetEnabled(true);
+    UpdateAll(canvases);
+
+    // Both the previous and the new canvases
+    leafB->SetParent(nestedGo);
+    BANG_CHECK(AreInvalid(canvases, {true, true, true}));
+    UpdateAll(canvases);
+
+    leafA->AddComponent<UILayoutElement>();
+    BANG_CHECK(AreInvalid(canvases, {true, false, false}));
+    UpdateAll(canvases);
+    BANG_CHECK(AreInvalid(canvases, {false, false, false}));
+
+    GameObject::DestroyImmediate(canvasA->GetGameObject());
+    GameObject::DestroyImmediate(canvasB->GetGameObject());
+}
+
+BANG_GL_TEST(UIFocusIndex_MatchesTheCandidatesOfRandomTrees)
+{
+    std::mt19937 randomEngine(45);
+    auto RandomFloat = [&randomEngine](float minValue, float maxValue) {
+        return std::uniform_real_distribution<float>(minValue,
+                                                     maxValue)(randomEngine);
+    };
+    auto RandomInt = [&randomEngine](int minValue, int maxValue) {
+        return std::uniform_int_distribution<int>(minValue,
+                                                  maxValue)(randomEngine);
+    };
+    auto SetRandomRect = [&](GameObject *go) {
+        RectTransform *rt = go->GetRectTransform();
+        const Vector2 anchorMin(RandomFloat(-1.2f, 0.8f),
+                                RandomFloat(-1.2f, 0.8f));
+        rt->SetAnchors(anchorMin,
+                       anchorMin + Vector2(RandomFloat(0.0f, 0.9f),
+                                           RandomFloat(0.0f, 0.9f)));
+        rt->SetLocalPosition(Vector3(0.0f, 0.0f, RandomFloat(-0.1f, 0.1f)));
+    };
+
+    GL::Push(GL::Pushable::VIEWPORT);
+    GL::SetViewport(0, 0, 320, 240);
+
+    // Focusables, rect masks and nested canvases, at random depths
+    UICanvas *rootCanvas = GameObjectFactory::CreateUICanvas();
+    Array<UICanvas *> canvases = {rootCanvas};
+    Array<GameObject *> gos = {rootCanvas->GetGameObject()};
+    for (int i = 0; i < 400; ++i)
+    {
+        GameObject *go = GameObjectFactory::CreateUIGameObject();
+        SetRandomRect(go);
+        const int type = RandomInt(0, 39);
+        if (type < 24)
+        {
+            go->AddComponent<UIFocusable>();
+        }
+        else if (type < 30)
+        {
+            go->AddComponent<UIRectMask>();
+        }
+        else if (type == 30)
+        {
+            canvases.PushBack(go->AddComponent<UICanvas>());
+        }
+        go->SetParent(gos[RandomInt(0, gos.Size() - 1)]);
+        gos.PushBack(go);
+    }
+
+    for (UICanvas *canvas : canvases)
+    {
+        CheckAgainstCandidates(canvas, &randomEngine);
+    }
+
+    // Every change is only invalidated where it starts, so the checks are
+    // done after a few of them at once
+    for (int i = 0; i < 300; ++i)
+    {
+        GameObject *go = gos[RandomInt(1, gos.Size() - 1)];
+        switch (RandomInt(0, 5))
+        {
+            case 0: SetRandomRect(go); break;
+
+            case 1:
+                go->GetRectTransform()->SetMarginLeft(RandomInt(-30, 30));
+                break;
+
+            case 2: go->SetEnabled(!go->IsEnabled()); break;
+
+            case 3: go->SetVisible(!go->IsVisible()); break;
+
+            case 4:
+            {
+                GameObject *newParent = gos[RandomInt(0, gos.Size() - 1)];
+                if (newParent != go && !newParent->IsChildOf(go))
+                {
+                    go->SetParent(newParent);
+                }
+            }
+            break;
+
+            case 5:
+                if (UIRectMask *rectMask = go->GetComponent<UIRectMask>())
+                {
+                    rectMask->SetMasking(!rectMask->IsMasking());
+                }
+                break;
+        }
+
+        if (i % 3 == 2)
+        {
+            for (UICanvas *canvas : canvases)
+            {
+                CheckAgainstCandidates(canvas, &randomEngine);
+            }
+        }
+    }
+
+    GameObject::DestroyImmediate(rootCanvas->GetGameObject());
+    GL::Pop(GL::Pushable::VIEWPORT);
+}
@@ -0,0 +1,146 @@
+#include "BangTest.h"
+
+#include "Bang/Array.tcc"
+#include "Bang/GameObject.h"
+#include "Bang/GameObject.tcc"
+#include "Bang/GameObjectFactory.h"
+#include "Bang/UICanvas.h"
+#include "Bang/UILabel.h"
+#include "Bang/UILayoutElement.h"
+#include "Bang/UILayoutManager.h"
+#include "Bang/UITextRenderer.h"
+#include "Bang/UIVerticalLayout.h"
+
+using namespace Bang;
+
+namespace
+{
+// Vertical layout of sections, each one a vertical layout of leaves. The
+// leaves are layout elements instead of labels, so that it needs no
+// renderer. Each leaf has a hidden low priority element too, which does not
+// change the leaf sizes
+struct LayoutTree
+{
+    GameObject *container = nullptr;
+    UILayoutElement *leaf = nullptr;
+    UILayoutElement *hiddenLeaf = nullptr;
+};
+
+LayoutTree CreateLayoutTree(int numSections, int numLeavesPerSection)
+{
+    LayoutTree tree;
+    tree.container = GameObjectFactory::CreateUIGameObject();
+    tree.container->AddComponent<UIVerticalLayout>();
+    for (int s = 0; s < numSections; ++s)
+    {
+        GameObject *sectionGo = GameObjectFactory::CreateUIGameObject();
+        sectionGo->AddComponent<UIVerticalLayout>();
+        sectionGo->SetParent(tree.container);
+
+        for (int l = 0; l < numLeavesPerSection; ++l)
+        {
+            GameObject *leafGo = GameObjectFactory::CreateUIGameObject();
+            UILayoutElement *leaf = leafGo->AddComponent<UILayoutElement>();
+            leaf->SetPreferredSize(Vector2i(10, 10));
+            leaf->SetLayoutPriority(1);
+            UILayoutElement *hiddenLeaf =
+                leafGo->AddComponent<UILayoutElement>();
+            hiddenLeaf->SetPreferredSize(Vector2i(5, 5));
+            leafGo->SetParent(sectionGo);
+
+            if (s == numSections / 2 && l == numLeavesPerSection / 2)
+            {
+                tree.leaf = leaf;
+                tree.hiddenLeaf = hiddenLeaf;
+            }
+        }
+    }
+    return tree;
+}
+}  // namespace
+
+BANG_TEST(UILayoutManager_OnlyRebuildsTheChangedBranch)
+{
+    UICanvas *canvas = GameObjectFactory::CreateUICanvas();
+    GameObject *canvasGo = canvas->GetGameObject();
+    UILayoutManager *layoutManager = canvas->GetLayoutManager();
+
+    // The tree is built out of the canvas, and claimed once attached
+    const LayoutTree tree = CreateLayoutTree(4, 20);
+    tree.container->SetParent(canvasGo);
+
+    // Container and sections, plus the two elements of every leaf. Layouts
+    // are calculated once per axis
+    layoutManager->RebuildLayout(canvasGo);
+    BANG_CHECK(layoutManager->GetNumCalculatedLayouts() ==
+               (1 + 4 + 4 * 20 * 2) * 2);
+    BANG_CHECK(layoutManager->GetNumAppliedLayouts() > 0);
+
+    layoutManager->RebuildLayout(canvasGo);
+    BANG_CHECK(layoutManager->GetNumCalculatedLayouts() == 0);
+    BANG_CHECK(layoutManager->GetNumAppliedLayouts() == 0);
+
+    // The leaf sizes do not change, so the invalidation stops there
+    tree.hiddenLeaf->SetPreferredSize(Vector2i(8, 8));
+    layoutManager->RebuildLayout(canvasGo);
+    BANG_CHECK(layoutManager->GetNumCalculatedLayouts() == 1 * 2);
+
+    // The section and the container grow with it
+    tree.leaf->SetPreferredSize(Vector2i(30, 12));
+    layoutManager->RebuildLayout(canvasGo);
+    BANG_CHECK(layoutManager->GetNumCalculatedLayouts() == 3 * 2);
+
+    layoutManager->RebuildLayout(canvasGo);
+    BANG_CHECK(layoutManager->GetNumCalculatedLayouts() == 0);
+
+    GameObject::DestroyImmediate(canvasGo);
+}
+
+BANG_TEST(UILayoutManager_CanvasAddedToBuiltHierarchy)
+{
+    const LayoutTree tree = CreateLayoutTree(2, 5);
+    UICanvas *canvas = GameObjectFactory::CreateUICanvasInto(tree.container);
+    UILayoutManager *layoutManager = canvas->GetLayoutManager();
+    layoutManager->RebuildLayout(tree.container);
+    BANG_CHECK(layoutManager->GetNumCalculatedLayouts() ==
+               (1 + 2 + 2 * 5 * 2) * 2);
+
+    // Invalidated out of the canvas, claimed when attached back
+    GameObject *leafGo = tree.leaf->GetGameObject();
+    GameObject *sectionGo = leafGo->GetParent();
+    leafGo->SetParent(nullptr);
+    layoutManager->RebuildLayout(tree.container);
+    tree.leaf->SetPreferredSize(Vector2i(50, 50));
+    layoutManager->RebuildLayout(tree.container);
+    BANG_CHECK(layoutManager->GetNumCalculatedLayouts() == 0);
+
+    leafGo->SetParent(sectionGo);
+    layoutManager->RebuildLayout(tree.container);
+    BANG_CHECK(layoutManager->GetNumCalculatedLayouts() == 3 * 2);
+
+    GameObject::DestroyImmediate(tree.container);
+}
+
+BANG_GL_TEST(UILayoutManager_LayoutBenchmarkLabelChange)
+{
+    UICanvas *canvas = GameObjectFactory::CreateUICanvas();
+    GameObject *canvasGo = canvas->GetGameObject();
+    UILayoutManager *layoutManager = canvas->GetLayoutManager();
+
+    GameObject *container = GameObjectFactory::CreateUIGameObject();
+    container->SetParent(canvasGo);
+    UILabel *label = GameObjectFactory::CreateUILayoutBenchmarkInto(container);
+    layoutManager->RebuildLayout(canvasGo);
+    BANG_CHECK(layoutManager->GetNumCalculatedLayouts() >= 10 * 10 * 100);
+
+    // Only the label layout elements, its grid cell size is fixed
+    label->GetText()->SetContent("Changed content");
+    layoutManager->RebuildLayout(canvasGo);
+    const uint numLabelLayoutElements = SCAST<uint>(
+        label->GetGameObject()->GetComponents<ILayoutElement>().Size());
+    BANG_CHECK(layoutManager->GetNumCalculatedLayouts() > 0);
+    BANG_CHECK(layoutManager->GetNumCalculatedLayouts() <=
+               numLabelLayoutElements * 2);
+
+    GameObject::DestroyImmediate(canvasGo);
+}
@@ -0,0 +1,140 @@
+#include "BangTest.h"
+
+#include "Bang/Array.tcc"
+#include "Bang/GameObject.h"
+#include "Bang/GameObjectFactory.h"
+#include "Bang/IUIListDataSource.h"
+#include "Bang/Math.h"
+#include "Bang/UICanvas.h"
+#include "Bang/UILayoutManager.h"
+#include "Bang/UIList.h"
+#include "Bang/UIScrollPanel.h"
+#include "Bang/UMap.tcc"
+#include "Bang/Vector2.h"
+
+using namespace Bang;
+
+namespace
+{
+constexpr int NumItems = 1000000;
+constexpr int ItemHeight = 20;
+
+// Remembers the model index each row was last bound to
+class IndexDataSource : public IUIListDataSource
+{
+public:
+    int GetNumItems() const override
+    {
+        return NumItems;
+    }
+
+    int GetItemHeight() const override
+    {
+        return ItemHeight;
+    }
+
+    GameObject *CreateItem() override
+    {
+        return GameObjectFactory::CreateUIGameObject();
+    }
+
+    void BindItem(GameObject *item, int index) override
+    {
+        m_boundIndices[item] = index;
+    }
+
+    int GetBoundIndex(GameObject *item) const
+    {
+        return m_boundIndices.ContainsKey(item) ? m_boundIndices.Get(item)
+                                                : -1;
+    }
+
+private:
+    UMap<GameObject *, int> m_boundIndices;
+};
+}  // namespace
+
+BANG_TEST(UIList_VirtualRangeScrollsAMillionItems)
+{
+    constexpr int ViewHeight = 600;
+    int firstIndex = 0, numRows = 0;
+    UIList::GetVirtualRange(
+        NumItems, ItemHeight, 0, ViewHeight, &firstIndex, &numRows);
+    const int numRowsAtTop = numRows;
+    BANG_CHECK(firstIndex == 0);
+    BANG_CHECK(numRows > ViewHeight / ItemHeight);
+    BANG_CHECK(numRows < 2 * (ViewHeight / ItemHeight));
+
+    // The number of rows does not depend on the scrolling, and they always
+    // cover the view
+    const int maxViewTop = (NumItems * ItemHeight - ViewHeight);
+    for (int viewTop = 0; viewTop <= maxViewTop; viewTop += 1999)
+    {
+        UIList::GetVirtualRange(
+            NumItems, ItemHeight, viewTop, ViewHeight, &firstIndex, &numRows);
+        const int lastVisibleIndex =
+            Math::Min((viewTop + ViewHeight) / ItemHeight, NumItems - 1);
+        BANG_CHECK(numRows == numRowsAtTop);
+        BANG_CHECK(firstIndex >= 0);
+        BANG_CHECK(firstIndex <= viewTop / ItemHeight);
+        BANG_CHECK(firstIndex + numRows > lastVisibleIndex);
+        BANG_CHECK(firstIndex + numRows <= NumItems);
+    }
+
+    UIList::GetVirtualRange(
+        NumItems, ItemHeight, maxViewTop, ViewHeight, &firstIndex, &numRows);
+    BANG_CHECK(numRows == numRowsAtTop);
+    BANG_CHECK(firstIndex + numRows == NumItems);
+
+    // Small models only get a row per item
+    UIList::GetVirtualRange(
+        3, ItemHeight, 0, ViewHeight, &firstIndex, &numRows);
+    BANG_CHECK(firstIndex == 0 && numRows == 3);
+    UIList::GetVirtualRange(
+        0, ItemHeight, 0, ViewHeight, &firstIndex, &numRows);
+    BANG_CHECK(firstIndex == 0 && numRows == 0);
+}
+
+BANG_GL_TEST(UIList_ScrollingAMillionItemsKeepsTheGameObjects)
+{
+    UICanvas *canvas = GameObjectFactory::CreateUICanvas();
+    GameObject *canvasGo = canvas->GetGameObject();
+    UILayoutManager *layoutManager = canvas->GetLayoutManager();
+
+    IndexDataSource dataSource;
+    UIList *list = GameObjectFactory::CreateUIList(true);
+    GameObject *listGo = list->GetGameObject();
+    listGo->SetParent(canvasGo);
+    list->SetDataSource(&dataSource);
+    layoutManager->RebuildLayout(canvasGo);
+
+    // Once the view has its size
+    list->RefreshItems();
+    layoutManager->RebuildLayout(canvasGo);
+
+    const uint numRows = list->GetItems().Size();
+    const uint numGameObjects = listGo->GetChildrenRecursively().Size();
+    BANG_CHECK(numRows > 0);
+    BANG_CHECK(numRows < 1000);
+
+    for (int i = 0; i <= 100; ++i)
+    {
+        list->GetScrollPanel()->SetScrollingPercent(Vector2(0.0f, i / 100.0f));
+        list->OnUpdate();
+        layoutManager->RebuildLayout(canvasGo);
+
+        const Array<GameObject *> &rows = list->GetItems();
+        BANG_CHECK(rows.Size() == numRows);
+        BANG_CHECK(listGo->GetChildrenRecursively().Size() == numGameObjects);
+        for (GameObject *row : rows)
+        {
+            BANG_CHECK(dataSource.GetBoundIndex(row) ==
+                       list->GetItemIndex(row));
+        }
+    }
+
+    // Scrolled to the bottom, the last item has its row
+    BANG_CHECK(list->GetItemIndex(list->GetItems().Back()) == NumItems - 1);
+
+    GameObject::DestroyImmediate(canvasGo);
+}
@@ -0,0 +1,290 @@
+#include <random>
+
+#include "BangTest.h"
+
+#include "Bang/Array.tcc"
+#include "Bang/GameObject.h"
+#include "Bang/GameObjectFactory.h"
+#include "Bang/IUITreeDataSource.h"
+#include "Bang/UICanvas.h"
+#include "Bang/UILayoutManager.h"
+#include "Bang/UIList.h"
+#include "Bang/UIScrollPanel.h"
+#include "Bang/UITree.h"
+#include "Bang/UIVirtualTree.h"
+#include "Bang/USet.tcc"
+#include "Bang/Vector2.h"
+
+using namespace Bang;
+
+namespace
+{
+using NodeId = IUITreeDataSource::NodeId;
+
+// Top level nodes 0..numTopNodes-1, each one with numChildren leaves
+class TwoLevelsDataSource : public IUITreeDataSource
+{
+public:
+    TwoLevelsDataSource(int numTopNodes, int numChildren)
+        : m_numTopNodes(numTopNodes), m_numChildren(numChildren)
+    {
+    }
+
+    int GetNumChildren(NodeId node) const override
+    {
+        if (node == RootNode)
+        {
+            return m_numTopNodes;
+        }
+        return (node < SCAST<NodeId>(m_numTopNodes)) ? m_numChildren : 0;
+    }
+
+    NodeId GetChild(NodeId node, int index) const override
+    {
+        if (node == RootNode)
+        {
+            return SCAST<NodeId>(index);
+        }
+        return SCAST<NodeId>(m_numTopNodes) + node * m_numChildren + index;
+    }
+
+    int GetItemHeight() const override
+    {
+        return 20;
+    }
+
+    GameObject *CreateItem() override
+    {
+        return GameObjectFactory::CreateUIGameObject();
+    }
+
+    void BindItem(GameObject *, NodeId) override
+    {
+    }
+
+private:
+    int m_numTopNodes = 0;
+    int m_numChildren = 0;
+};
+
+// Deeper tree to compare against: every node has its path as base 8 digits,
+// with 5 top level nodes and 3 children per node up to depth 3
+class DeepDataSource : public IUITreeDataSource
+{
+public:
+    static constexpr int MaxDepth = 3;
+
+    int GetNumChildren(NodeId node) const override
+    {
+        if (node == RootNode)
+        {
+            return 5;
+        }
+        return (GetDepth(node) < MaxDepth) ? 3 : 0;
+    }
+
+    NodeId GetChild(NodeId node, int index) const override
+    {
+        const NodeId parentKey = (node == RootNode) ? 0 : node;
+        return parentKey * 8 + index + 1;
+    }
+
+    int GetItemHeight() const override
+    {
+        return 20;
+    }
+
+    GameObject *CreateItem() override
+    {
+        return nullptr;
+    }
+
+    void BindItem(GameObject *, NodeId) override
+    {
+    }
+
+    static int GetDepth(NodeId node)
+    {
+        int depth = 0;
+        for (; node > 0; node /= 8)
+        {
+            ++depth;
+        }
+        return depth;
+    }
+};
+
+void ListVisibleNodes(const IUITreeDataSource &dataSource,
+                      const USet<NodeId> &expandedNodes,
+                      NodeId node,
+                      int depth,
+                      Array<std::pair<NodeId, int>> *visibleNodes)
+{
+    for (int i = 0; i < dataSource.GetNumChildren(node); ++i)
+    {
+        const NodeId child = dataSource.GetChild(node, i);
+        visibleNodes->PushBack(std::make_pair(child, depth));
+        if (expandedNodes.Contains(child))
+        {
+            ListVisibleNodes(
+                dataSource, expandedNodes, child, depth + 1, visibleNodes);
+        }
+    }
+}
+
+bool MatchesBruteForce(const UIVirtualTree &virtualTree,
+                       const USet<NodeId> &expandedNodes)
+{
+    Array<std::pair<NodeId, int>> visibleNodes;
+    ListVisibleNodes(*virtualTree.GetDataSource(),
+                     expandedNodes,
+                     IUITreeDataSource::RootNode,
+                     0,
+                     &visibleNodes);
+    if (SCAST<int>(visibleNodes.Size()) != virtualTree.GetNumVisibleNodes())
+    {
+        return false;
+    }
+
+    for (int i = 0; i < virtualTree.GetNumVisibleNodes(); ++i)
+    {
+        if (virtualTree.GetVisibleNode(i) != visibleNodes[i].first ||
+            virtualTree.GetVisibleNodeDepth(i) != visibleNodes[i].second)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void GetAllNodes(const IUITreeDataSource &dataSource,
+                 NodeId node,
+                 Array<NodeId> *nodes)
+{
+    for (int i = 0; i < dataSource.GetNumChildren(node); ++i)
+    {
+        const NodeId child = dataSource.GetChild(node, i);
+        nodes->PushBack(child);
+        GetAllNodes(dataSource, child, nodes);
+    }
+}
+}  // namespace
+
+constexpr int DeepDataSource::MaxDepth;
+
+BANG_TEST(UIVirtualTree_ExpandAndCollapseMatchBruteForce)
+{
+    DeepDataSource dataSource;
+    UIVirtualTree virtualTree;
+    virtualTree.SetDataSource(&dataSource);
+    BANG_CHECK(virtualTree.GetNumVisibleNodes() == 5);
+
+    Array<NodeId> allNodes;
+    GetAllNodes(dataSource, IUITreeDataSource::RootNode, &allNodes);
+
+    // Hidden nodes are toggled too, they must show their state once their
+    // parents get expanded
+    USet<NodeId> expandedNodes;
+    std::mt19937 randomEngine(1234);
+    for (int i = 0; i < 500; ++i)
+    {
+        const NodeId node = allNodes[randomEngine() % allNodes.Size()];
+        const bool expand = !expandedNodes.Contains(node);
+        if (expand)
+        {
+            expandedNodes.Add(node);
+        }
+        else
+        {
+            expandedNodes.Remove(node);
+        }
+
+        virtualTree.SetExpanded(node, expand);
+        BANG_CHECK(virtualTree.IsExpanded(node) == expand);
+        BANG_CHECK(MatchesBruteForce(virtualTree, expandedNodes));
+    }
+
+    virtualTree.Refresh();
+    BANG_CHECK(MatchesBruteForce(virtualTree, expandedNodes));
+
+    virtualTree.SetDataSource(nullptr);
+    BANG_CHECK(virtualTree.GetNumVisibleNodes() == 0);
+}
+
+BANG_TEST(UIVirtualTree_AMillionNodes)
+{
+    TwoLevelsDataSource dataSource(1000000, 2);
+    UIVirtualTree virtualTree;
+    virtualTree.SetDataSource(&dataSource);
+    BANG_CHECK(virtualTree.GetNumVisibleNodes() == 1000000);
+
+    virtualTree.SetExpanded(0, true);
+    virtualTree.SetExpanded(999999, true);
+    virtualTree.SetExpanded(500000, true);
+    BANG_CHECK(virtualTree.GetNumVisibleNodes() == 1000006);
+    BANG_CHECK(virtualTree.GetVisibleNode(1) == dataSource.GetChild(0, 0));
+    BANG_CHECK(virtualTree.GetVisibleNodeDepth(1) == 1);
+    BANG_CHECK(virtualTree.GetVisibleNode(3) == 1);
+    BANG_CHECK(virtualTree.GetVisibleNodeIndex(500000) == 500002);
+    BANG_CHECK(virtualTree.GetVisibleNode(500003) ==
+               dataSource.GetChild(500000, 0));
+    BANG_CHECK(virtualTree.GetVisibleNode(1000005) ==
+               dataSource.GetChild(999999, 1));
+
+    virtualTree.SetExpanded(0, false);
+    BANG_CHECK(virtualTree.GetNumVisibleNodes() == 1000004);
+    BANG_CHECK(virtualTree.GetVisibleNodeIndex(500000) == 500000);
+    BANG_CHECK(virtualTree.GetVisibleNodeIndex(dataSource.GetChild(0, 0)) ==
+               -1);
+}
+
+BANG_GL_TEST(UITree_ScrollingAMillionNodesKeepsTheGameObjects)
+{
+    UICanvas *canvas = GameObjectFactory::CreateUICanvas();
+    GameObject *canvasGo = canvas->GetGameObject();
+    UILayoutManager *layoutManager = canvas->GetLayoutManager();
+
+    TwoLevelsDataSource dataSource(1000000, 2);
+    UITree *tree = GameObjectFactory::CreateUITree();
+    GameObject *treeGo = tree->GetGameObject();
+    treeGo->SetParent(canvasGo);
+    tree->SetDataSource(&dataSource);
+    BANG_CHECK(tree->IsVirtualized());
+    tree->SetNodeCollapsed(0, false);
+    tree->SetNodeCollapsed(999999, false);
+    BANG_CHECK(tree->GetUIList()->GetNumItems() == 1000004);
+    layoutManager->RebuildLayout(canvasGo);
+    tree->RefreshItems();
+    layoutManager->RebuildLayout(canvasGo);
+
+    UIList *list = tree->GetUIList();
+    const uint numRows = list->GetItems().Size();
+    const uint numGameObjects = treeGo->GetChildrenRecursively().Size();
+    BANG_CHECK(numRows > 0);
+    BANG_CHECK(numRows < 1000);
+
+    for (int i = 0; i <= 100; ++i)
+    {
+        list->GetScrollPanel()->SetScrollingPercent(Vector2(0.0f, i / 100.0f));
+        list->OnUpdate();
+        layoutManager->RebuildLayout(canvasGo);
+        BANG_CHECK(list->GetItems().Size() == numRows);
+        BANG_CHECK(treeGo->GetChildrenRecursively().Size() == numGameObjects);
+    }
+
+    // The selection follows its node when the rows above it are collapsed
+    tree->SetSelectedNode(1);
+    BANG_CHECK(list->GetSelectedIndex() == 3);
+    tree->SetNodeCollapsed(0, true);
+    BANG_CHECK(list->GetSelectedIndex() == 1);
+    NodeId selectedNode = 0;
+    BANG_CHECK(tree->GetSelectedNode(&selectedNode) && selectedNode == 1);
+
+    // Collapsing its parent selects the parent
+    tree->SetSelectedNode(dataSource.GetChild(999999, 1));
+    tree->SetNodeCollapsed(999999, true);
+    BANG_CHECK(tree->GetSelectedNode(&selectedNode) && selectedNode == 999999);
+    BANG_CHECK(treeGo->GetChildrenRecursively().Size() == numGameObjects);
+
+    GameObject::DestroyImmediate(canvasGo);
+}
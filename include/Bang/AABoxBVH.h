@@ -0,0 +1,58 @@
+#ifndef AABOXBVH_H
+#define AABOXBVH_H
+
+#include <functional>
+
+#include "Bang/AABox.h"
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/Vector3.h"
+
+namespace Bang
+{
+// Bounding volume hierarchy over a set of boxes, to find the ones that
+// overlap a volume without testing all of them. It is rebuilt from scratch
+// (median split on the longest axis), which is cheap enough to do every
+// frame. Empty boxes stand for unbounded elements, and every query returns
+// them.
+class AABoxBVH
+{
+public:
+    using OverlapsFunction = std::function<bool(const AABox &aaBox)>;
+
+    AABoxBVH();
+
+    void Build(const Array<AABox> &aaBoxes);
+    void Clear();
+
+    // Indices (into the built boxes, in increasing order) of the boxes for
+    // which overlaps is true. overlaps must also be true for any box that
+    // contains one of those, since it is tested on the hierarchy nodes too
+    void Query(const OverlapsFunction &overlaps, Array<uint> *indices) const;
+
+    uint GetNumNodes() const;
+
+private:
+    static constexpr uint MaxLeafSize = 4;
+
+    // Nodes are laid out depth first, so the first child of a node is the
+    // next one. Leaves have a count of elements in m_indices
+    struct Node
+    {
+        AABox aaBox;
+        uint begin = 0;
+        uint count = 0;
+        uint secondChild = 0;
+    };
+
+    Array<Node> m_nodes;
+    Array<AABox> m_aaBoxes;
+    Array<Vector3> m_centers;
+    Array<uint> m_indices;
+    Array<uint> m_unboundedIndices;
+
+    void BuildNode(uint begin, uint end);
+};
+}  // namespace Bang
+
+#endif  // AABOXBVH_H
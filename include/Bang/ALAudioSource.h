@@ -14,6 +14,8 @@ namespace Bang
 {
 class IEventsDestroy;
 
+// Logical sound source. It only owns an OpenAL source while AudioManager has
+// given it a real voice, so its state and params are kept here too.
 class ALAudioSource : public virtual EventEmitter<IEventsDestroy>
 {
 public:
@@ -35,6 +37,8 @@ public:
     void SetPitch(float pitch);
     void SetRange(float range);
     void SetLooping(bool looping);
+    void SetPriority(uint priority);
+    void SetPlayOffset(float playOffsetSeconds);
     void SetPosition(const Vector3 &position);
     void SetParams(const AudioParams &audioParams);
     void SetALBufferId(ALuint bufferId);
@@ -43,10 +47,13 @@ public:
     bool IsPlaying() const;
     bool IsPaused() const;
     bool IsStopped() const;
+    bool IsVirtual() const;
     State GetState() const;
     float GetVolume() const;
     float GetPitch() const;
     float GetRange() const;
+    uint GetPriority() const;
+    float GetPlayOffset() const;
     ALuint GetALSourceId() const;
     const Vector3 &GetPosition() const;
     const AudioParams &GetParams();
@@ -55,11 +62,12 @@ public:
 private:
     uint m_bufferId = 0;
     ALuint m_alSourceId = 0;
+    State m_state = State::STOPPED;
+    bool m_streaming = false;
     AudioParams m_audioParams;
     bool m_autoDelete = false;
 
     friend class AudioManager;
-    friend class AudioPlayerRunnable;
 };
 }
 
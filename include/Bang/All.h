@@ -21,7 +21,6 @@
 #include "Bang/AudioListener.h"
 #include "Bang/AudioManager.h"
 #include "Bang/AudioParams.h"
-#include "Bang/AudioPlayerRunnable.h"
 #include "Bang/AudioSource.h"
 #include "Bang/Axis.h"
 #include "Bang/AxisFunctions.h"
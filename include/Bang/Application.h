@@ -12,6 +12,7 @@ class AudioManager;
 class ClassDB;
 class Debug;
 class GEngine;
+class JobSystem;
 class MetaFilesManager;
 class Paths;
 class Physics;
@@ -39,6 +40,7 @@ public:
     Paths *GetPaths() const;
     Debug *GetDebug() const;
     GEngine *GetGEngine() const;
+    JobSystem *GetJobSystem() const;
     Physics *GetPhysics() const;
     Settings *GetSettings() const;
     Assets *GetAssets() const;
@@ -62,6 +64,7 @@ protected:
     Paths *m_paths = nullptr;
     Physics *m_physics = nullptr;
     GEngine *m_gEngine = nullptr;
+    JobSystem *m_jobSystem = nullptr;
     Settings *m_settings = nullptr;
     Assets *m_assets = nullptr;
     SystemUtils *m_systemUtils = nullptr;
@@ -75,6 +78,11 @@ protected:
     virtual void Init_(const Path &engineRootPath = Path::Empty());
     virtual void InitAfterPathsInit_();
 
+    // Creates only the subsystems that do not need a window nor a GL context
+    // (class DB, time, jobs, debug, paths and meta files). For tests and
+    // command line tools
+    void InitHeadless_(const Path &engineRootPath);
+
 private:
     static Application *s_appSingleton;
 
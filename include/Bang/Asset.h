@@ -2,6 +2,7 @@
 #define ASSET_H
 
 #include <functional>
+#include <memory>
 #include <vector>
 
 #include "Bang/Array.h"
@@ -21,6 +22,7 @@
 
 namespace Bang
 {
+class AssetLoadRequest;
 class IEventsAsset;
 
 class Asset : public Serializable,
@@ -53,6 +55,18 @@ protected:
     // Asset
     virtual void Import(const Path &assetFilepath);
     void Import_(const Path &assetFilepath);
+    void Import_(const Path &assetFilepath, const MetaNode &metaNode);
+
+    // Called from a worker thread before Import when the asset is loaded with
+    // Assets::LoadAsync. It must not touch GL nor other assets, but it can
+    // leave the decoded file contents ready for Import.
+    virtual void PreImport(const Path &assetFilepath);
+
+    // Called in the main thread after PreImport. Assets that Import will use
+    // can be loaded asynchronously here, so that they load in parallel. Import
+    // is not called until all of them have finished loading.
+    virtual void LoadDependenciesAsync(
+        Array<std::shared_ptr<AssetLoadRequest>> *dependencies);
 
 private:
     // Embedded asset related variables
@@ -0,0 +1,109 @@
+#ifndef ASSETLOADREQUEST_H
+#define ASSETLOADREQUEST_H
+
+#include <atomic>
+#include <memory>
+
+#include "Bang/Array.h"
+#include "Bang/AssetHandle.h"
+#include "Bang/BangDefines.h"
+#include "Bang/GUID.h"
+#include "Bang/JobSystem.h"
+#include "Bang/MetaNode.h"
+#include "Bang/Path.h"
+
+namespace Bang
+{
+class Asset;
+
+// State of an asset being loaded through Assets::LoadAsync. The file reading
+// and decoding is done in a worker thread (Asset::PreImport), and the rest of
+// the import (GL objects creation, etc.) is done in the main thread, inside
+// the time budget Assets gives to async loads every frame.
+class AssetLoadRequest
+{
+public:
+    AssetLoadRequest();
+    ~AssetLoadRequest();
+
+    // Finishes the load right away, blocking the main thread if needed
+    void Wait();
+
+    bool IsFinished() const;
+    Asset *GetAsset() const;
+    const Path &GetAssetFilepath() const;
+
+private:
+    GUID m_assetGUID;
+    Path m_assetFilepath = Path::Empty();
+    Path m_metaFilepath = Path::Empty();
+
+    // Not registered in Assets until the load finishes, so that nobody else
+    // can reach it while a worker thread is pre-importing it
+    Asset *p_loadingAsset = nullptr;
+    AH<Asset> m_loadedAsset;
+
+    // Filled by the pre-import job
+    JobHandle m_preImportJob;
+    MetaNode m_metaNode;
+    bool m_hasMetaNode = false;
+    std::atomic<bool> m_preImported;
+
+    // Parent model request, for embedded assets
+    std::shared_ptr<AssetLoadRequest> m_parentRequest;
+    Array<std::shared_ptr<AssetLoadRequest>> m_dependencies;
+
+    bool m_preImportStarted = false;
+    bool m_dependenciesStarted = false;
+    bool m_finished = false;
+
+    friend class Assets;
+};
+
+template <class AssetClass>
+class AssetLoadHandle
+{
+public:
+    AssetLoadHandle() = default;
+
+    explicit AssetLoadHandle(const std::shared_ptr<AssetLoadRequest> &request)
+        : m_request(request)
+    {
+    }
+
+    AH<AssetClass> Wait() const
+    {
+        if (m_request)
+        {
+            m_request->Wait();
+        }
+        return Get();
+    }
+
+    bool IsFinished() const
+    {
+        return !m_request || m_request->IsFinished();
+    }
+
+    // Empty until the load has finished
+    AH<AssetClass> Get() const
+    {
+        AH<AssetClass> ah;
+        if (IsFinished() && m_request)
+        {
+            ah.Set(DCAST<AssetClass *>(m_request->GetAsset()));
+        }
+        return ah;
+    }
+
+    const std::shared_ptr<AssetLoadRequest> &GetRequest() const
+    {
+        return m_request;
+    }
+
+private:
+    std::shared_ptr<AssetLoadRequest> m_request;
+};
+}
+
+#endif  // ASSETLOADREQUEST_H
@@ -6,10 +6,12 @@
 #include "Bang/Array.h"
 #include "Bang/Asset.h"
 #include "Bang/AssetHandle.h"
+#include "Bang/AssetLoadRequest.h"
 #include "Bang/BangDefines.h"
 #include "Bang/IToString.h"
 #include "Bang/Path.h"
 #include "Bang/String.h"
+#include "Bang/Time.h"
 #include "Bang/UMap.h"
 #include "Bang/USet.h"
 
@@ -63,6 +65,19 @@ public:
 
     static AH<Asset> LoadFromExtension(const Path &filepath);
 
+    // Like Load, but the file reading and decoding is done in worker threads,
+    // and the rest of the import is spread among the next frames
+    template <class AssetClass = Asset>
+    static AssetLoadHandle<AssetClass> LoadAsync(const Path &filepath);
+    template <class AssetClass = Asset>
+    static AssetLoadHandle<AssetClass> LoadAsync(const GUID &guid);
+
+    // Finishes the async loads whose files have already been decoded, for as
+    // long as the async loads time budget allows. Called once per frame.
+    void UpdateAsyncLoads();
+    void SetAsyncLoadsTimeBudget(Time asyncLoadsTimeBudget);
+    Time GetAsyncLoadsTimeBudget() const;
+
     static void Import(Asset *asset);
 
     template <class AssetClass = Asset>
@@ -108,6 +123,9 @@ private:
     bool m_beingDestroyed = false;
     UMap<GUID, AssetEntry> m_assetsCache;
 
+    Time m_asyncLoadsTimeBudget = Time::Millis(4);
+    Array<std::shared_ptr<AssetLoadRequest>> m_asyncLoadRequests;
+
     MeshFactory *m_meshFactory = nullptr;
     TextureFactory *m_textureFactory = nullptr;
     MaterialFactory *m_materialFactory = nullptr;
@@ -125,11 +143,26 @@ private:
     AH<Asset> Load_(std::function<Asset *()> creator, const Path &path);
     AH<Asset> Load_(std::function<Asset *()> creator, const GUID &guid);
 
+    std::shared_ptr<AssetLoadRequest> LoadAsync_(
+        std::function<Asset *()> creator,
+        const Path &path);
+    std::shared_ptr<AssetLoadRequest> LoadAsync_(
+        std::function<Asset *()> creator,
+        const GUID &guid);
+    std::shared_ptr<AssetLoadRequest> GetAsyncLoadRequest(
+        const Path &path) const;
+    void TryStartPreImport(const std::shared_ptr<AssetLoadRequest> &request);
+    bool TryFinishAsyncLoad(const std::shared_ptr<AssetLoadRequest> &request);
+    void WaitForAsyncLoad(AssetLoadRequest *request);
+    void RemoveFinishedAsyncLoadRequests();
+    static void PreImport(AssetLoadRequest *request);
+
     Asset *GetCached_(const GUID &guid) const;
     Asset *GetCached_(const Path &path) const;
     bool Contains_(Asset *asset) const;
 
     friend class Window;
+    friend class AssetLoadRequest;
     friend class GUIDManager;
     friend class IAssetHandle;
 };
@@ -62,6 +62,26 @@ AH<AssetClass> Assets::Load(const GUID &guid)
     return resultAH;
 }
 
+template <class AssetClass>
+AssetLoadHandle<AssetClass> Assets::LoadAsync(const Path &filepath)
+{
+    auto creator = []() -> Asset * {
+        return SCAST<Asset *>(Assets::Create_<AssetClass>());
+    };
+    return AssetLoadHandle<AssetClass>(
+        Assets::GetInstance()->LoadAsync_(creator, filepath));
+}
+
+template <class AssetClass>
+AssetLoadHandle<AssetClass> Assets::LoadAsync(const GUID &guid)
+{
+    auto creator = []() -> Asset * {
+        return SCAST<Asset *>(Assets::Create_<AssetClass>());
+    };
+    return AssetLoadHandle<AssetClass>(
+        Assets::GetInstance()->LoadAsync_(creator, guid));
+}
+
 template <class AssetClass, class... Args>
 AH<AssetClass> Assets::Create(const Args &... args)
 {
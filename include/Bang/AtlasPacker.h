@@ -0,0 +1,67 @@
+#ifndef ATLASPACKER_H
+#define ATLASPACKER_H
+
+#include <cstdint>
+
+#include "Bang/AARect.h"
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/UMap.h"
+#include "Bang/Vector2.h"
+
+namespace Bang
+{
+// Shelf packer for a fixed size atlas page, with LRU eviction. Rects are
+// placed left to right in horizontal shelves. When the page is full, the
+// least recently used entries are evicted, and their slots are reused by
+// the new entries that fit in them.
+class AtlasPacker
+{
+public:
+    AtlasPacker(const Vector2i &pageSize = Vector2i(1024), int margin = 1);
+
+    // Finds room for a rect of the given size, evicting old entries if
+    // needed (their keys are added to evictedKeys). Returns false if the
+    // size does not fit even in an empty page
+    bool Insert(uint key,
+                const Vector2i &size,
+                AARecti *rect,
+                Array<uint> *evictedKeys);
+    void Remove(uint key);
+    void Touch(uint key);
+    void Clear();
+
+    bool Contains(uint key) const;
+    const AARecti &GetRect(uint key) const;
+    const Vector2i &GetPageSize() const;
+    uint GetNumEntries() const;
+
+private:
+    struct Shelf
+    {
+        int y = 0;
+        int height = 0;
+        int usedWidth = 0;
+    };
+
+    struct Entry
+    {
+        AARecti rect;
+        AARecti slot;
+        uint64_t lastUse = 0;
+    };
+
+    Vector2i m_pageSize = Vector2i::Zero();
+    int m_margin = 1;
+    uint64_t m_useCounter = 0;
+    Array<Shelf> m_shelves;
+    Array<AARecti> m_freeSlots;
+    UMap<uint, Entry> m_entries;
+
+    bool PackInShelves(const Vector2i &size, AARecti *slot);
+    bool PackInFreeSlots(const Vector2i &size, AARecti *slot);
+    bool EvictLeastRecentlyUsed(Array<uint> *evictedKeys);
+};
+}  // namespace Bang
+
+#endif  // ATLASPACKER_H
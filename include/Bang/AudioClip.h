@@ -22,8 +22,14 @@ public:
     int GetFrequency() const;
     float GetLength() const;
     bool IsLoaded() const;
+    bool IsStreaming() const;
     const Path &GetSoundFilepath() const;
 
+    // Clips whose decoded size is bigger than this are not fully loaded in
+    // memory, but streamed from their file while playing
+    static void SetStreamingSizeThreshold(uint streamingSizeThresholdBytes);
+    static uint GetStreamingSizeThreshold();
+
     // Asset
     void Import(const Path &soundFilepath) override;
 
@@ -35,6 +41,12 @@ private:
     ALuint m_alBufferId = 0;
     Path m_soundFilepath;
 
+    bool m_streaming = false;
+    int m_streamingFrequency = 0;
+    uint m_streamingNumFrames = 0;
+
+    static uint s_streamingSizeThreshold;
+
     AudioClip();
     virtual ~AudioClip() override;
 
@@ -43,7 +55,6 @@ private:
 
     friend class AudioSource;
     friend class AudioManager;
-    friend class AudioPlayerRunnable;
 };
 }
 
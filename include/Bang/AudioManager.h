@@ -3,6 +3,7 @@
 
 #include <AL/al.h>
 #include <AL/alc.h>
+#include <memory>
 #include <vector>
 
 #include "Bang/Array.tcc"
@@ -12,10 +13,10 @@
 #include "Bang/EventListener.h"
 #include "Bang/IEventsDestroy.h"
 #include "Bang/List.h"
-#include "Bang/Mutex.h"
 #include "Bang/String.h"
-#include "Bang/ThreadPool.h"
+#include "Bang/Time.h"
 #include "Bang/UMap.h"
+#include "Bang/Vector3.h"
 
 namespace Bang
 {
@@ -23,15 +24,21 @@ template <class>
 class EventEmitter;
 class ALAudioSource;
 class AudioClip;
-class AudioPlayerRunnable;
+class AudioStream;
 class IEventsDestroy;
 class Path;
 struct AudioParams;
 
+// Mixes every playing ALAudioSource into a fixed pool of OpenAL sources (real
+// voices), updated from the main loop. When there are more sounds playing
+// than real voices, or a sound can not be heard (out of its range, or muted),
+// it becomes a virtual voice: its playback time keeps advancing, but it does
+// not use any OpenAL source until it is promoted again.
 class AudioManager : public EventListener<IEventsDestroy>
 {
 public:
     void Init();
+    void Update();
 
     static ALAudioSource *Play(AudioClip *audioClip,
                                ALAudioSource *alAudioSource,
@@ -49,6 +56,9 @@ public:
     static void SetPlayOnStartBlocked(bool blocked);
 
     static bool GetPlayOnStartBlocked();
+    static uint GetNumRealVoices();
+    static uint GetNumVirtualVoices();
+    static uint GetMaxRealVoices();
     static void ClearALErrors();
     static bool CheckALError();
 
@@ -58,33 +68,67 @@ public:
     static AudioManager *GetInstance();
 
 private:
+    struct AudioVoice
+    {
+        ALAudioSource *alAudioSource = nullptr;
+        AudioClip *audioClip = nullptr;
+        std::unique_ptr<AudioStream> stream;  // For streaming clips
+
+        Time startTime;
+        float length = 0.0f;
+        float playOffset = 0.0f;  // Only tracked while virtual
+        float audibility = 0.0f;
+
+        bool started = false;
+        bool paused = false;
+        bool finished = false;
+    };
+
+    static constexpr uint MaxRealVoices = 128;
+
     ALCdevice *m_alDevice = nullptr;
     ALCcontext *m_alContext = nullptr;
 
-    ThreadPool m_threadPool;
-    Mutex m_mutexCurrentAudios;
     bool m_playOnStartBlocked = false;
-    UMap<ALAudioSource *, AudioPlayerRunnable *> m_sourcesToPlayers;
+    Time m_lastUpdateTime;
+    Array<ALuint> m_alSources;
+    Array<ALuint> m_freeALSources;
+    UMap<ALAudioSource *, AudioVoice *> m_sourcesToVoices;
 
     AudioManager();
     virtual ~AudioManager() override;
 
     bool InitAL();
+    void InitALSources();
     static List<String> GetAudioDevicesList();
 
+    bool StartVoice(ALAudioSource *alAudioSource,
+                    AudioClip *audioClip,
+                    float delay);
+    void PauseVoice(ALAudioSource *alAudioSource);
+    void ResumeVoice(ALAudioSource *alAudioSource);
+    void StopVoice(ALAudioSource *alAudioSource);
+    void SeekVoice(ALAudioSource *alAudioSource, float playOffset);
+    float GetVoicePlayOffset(const ALAudioSource *alAudioSource) const;
+    AudioVoice *GetVoice(const ALAudioSource *alAudioSource) const;
+
+    bool TryMakeVoiceReal(AudioVoice *voice);
+    void MakeVoiceVirtual(AudioVoice *voice);
+    void ReleaseVoiceALSource(AudioVoice *voice);
+    void RemoveFinishedVoices();
+    static bool IsVoiceReal(const AudioVoice *voice);
+    static float GetVoiceAudibility(const AudioVoice *voice,
+                                    const Vector3 &listenerPosition);
+
     // IEventsDestroy
     void OnDestroyed(EventEmitter<IEventsDestroy> *object) override;
-    void OnAudioPlayerDestroyed(AudioPlayerRunnable *audioPlayer);
-    void OnALAudioSourceDestroyed(ALAudioSource *alAudioSource);
 
     // Handling of real-time buffer change
     static void DettachSourcesFromAudioClip(AudioClip *ac);
 
-    void OnAudioFinishedPlaying(AudioPlayerRunnable *audioPlayer);
-
     friend class AudioClip;
     friend class Application;
-    friend class AudioPlayerRunnable;
+    friend class ALAudioSource;
 };
 
 #define BANG_AL_CALL(Call)                                                 \
@@ -1,6 +1,7 @@
 #ifndef AUDIOPARAMS_H
 #define AUDIOPARAMS_H
 
+#include "Bang/BangDefines.h"
 #include "Bang/Vector3.h"
 
 namespace Bang
@@ -14,18 +15,24 @@ struct AudioParams
     float range = 1000.0f;
     bool looping = false;
 
+    // When there are more sounds playing than real voices, the ones with
+    // lower priority are the first to become virtual
+    uint priority = 128;
+
     AudioParams(const Vector3 &_position = Vector3::Zero(),
                 float _volume = 1.0f,
                 float _delay = 0.0f,
                 float _pitch = 1.0f,
                 float _range = 1000.0f,
-                bool _looping = false)
+                bool _looping = false,
+                uint _priority = 128)
         : position(_position),
           volume(_volume),
           delay(_delay),
           pitch(_pitch),
           range(_range),
-          looping(_looping)
+          looping(_looping),
+          priority(_priority)
     {
     }
 };
@@ -0,0 +1,83 @@
+#ifndef AUDIOSTREAM_H
+#define AUDIOSTREAM_H
+
+#include <AL/al.h>
+
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/JobSystem.h"
+#include "Bang/List.h"
+#include "Bang/Path.h"
+
+typedef struct SNDFILE_tag SNDFILE;
+
+namespace Bang
+{
+// Plays a sound file through a small ring of OpenAL buffers queued into a
+// source. The file is decoded in chunks by a job, and the decoded chunks are
+// uploaded and queued from the main thread, in AudioManager::Update.
+class AudioStream
+{
+public:
+    AudioStream(const Path &soundFilepath);
+    ~AudioStream();
+
+    // Starts playing from the given offset in the source, which must have no
+    // static buffer set. Some chunks are decoded right away to avoid a gap
+    void Play(ALuint alSourceId, float offsetSeconds, bool looping);
+
+    // Unqueues the played buffers and queues the newly decoded ones.
+    // Returns false once the whole stream has been played
+    bool Update(ALuint alSourceId, bool looping);
+
+    // To be called after the source has been stopped and its queue cleared
+    void OnDetached();
+
+    bool IsOpen() const;
+    float GetPlayOffset(ALuint alSourceId) const;
+    float GetLength() const;
+
+    // Decodes up to numFrames frames, downmixing them to mono
+    static uint ReadMonoFrames(SNDFILE *soundFile,
+                               int numChannels,
+                               uint numFrames,
+                               Array<short> *monoSamples);
+
+private:
+    static constexpr uint NumBuffers = 4;
+    static constexpr uint ChunkFrames = 16384;
+
+    struct Chunk
+    {
+        Array<short> samples;
+        uint startFrame = 0;
+    };
+
+    SNDFILE *m_soundFile = nullptr;
+    int m_numChannels = 0;
+    int m_sampleRate = 0;
+    uint m_numFrames = 0;
+
+    Array<ALuint> m_alBufferIds;
+    Array<ALuint> m_freeALBufferIds;
+    List<uint> m_queuedChunksStartFrames;
+
+    // Only touched by the decode job while it is running
+    List<Chunk> m_decodedChunks;
+    uint m_decodeFrame = 0;
+    bool m_endOfFile = false;
+    JobHandle m_decodeJob;
+
+    // m_decodeFrame when the running decode job was scheduled, for the main
+    // thread to read meanwhile
+    uint m_scheduledDecodeFrame = 0;
+
+    void Seek(float offsetSeconds);
+    void WaitForDecode();
+    void ScheduleDecode(bool looping);
+    void DecodeChunks(uint numChunks, bool looping);
+    void QueueDecodedChunks(ALuint alSourceId);
+};
+}  // namespace Bang
+
+#endif  // AUDIOSTREAM_H
@@ -0,0 +1,131 @@
+#ifndef CACHEFILE_H
+#define CACHEFILE_H
+
+#include <cstddef>
+#include <cstring>
+
+#include "Bang/Array.h"
+#include "Bang/Array.tcc"
+#include "Bang/BangDefines.h"
+#include "Bang/Hash.h"
+#include "Bang/Path.h"
+#include "Bang/String.h"
+
+namespace Bang
+{
+// Helpers shared by the binary on-disk caches: raw value/array/string
+// serialization, and the naming and sweeping of the hidden cache files that
+// live next to their source file ("<source>.<key>.<ext>").
+class CacheFile
+{
+public:
+    template <class T>
+    static void WriteValue(Array<Byte> *bytes, const T &value);
+
+    template <class T>
+    static void WriteArray(Array<Byte> *bytes, const Array<T> &array);
+
+    static void WriteString(Array<Byte> *bytes, const String &str);
+
+    // (magic, version, key) header that every cache file starts with
+    static void WriteHeader(Array<Byte> *bytes,
+                            uint magic,
+                            uint version,
+                            Hash::HashType key);
+
+    // Readers return false (and leave the offset in an unspecified state)
+    // when the bytes are too short
+    template <class T>
+    static bool ReadValue(const Array<Byte> &bytes,
+                          std::size_t *offset,
+                          T *value);
+
+    template <class T>
+    static bool ReadArray(const Array<Byte> &bytes,
+                          std::size_t *offset,
+                          Array<T> *array);
+
+    static bool ReadString(const Array<Byte> &bytes,
+                           std::size_t *offset,
+                           String *str);
+
+    // False if the header is missing or does not match
+    static bool ReadHeader(const Array<Byte> &bytes,
+                           std::size_t *offset,
+                           uint magic,
+                           uint version,
+                           Hash::HashType key);
+
+    // Hidden "<sourceFilepath>.<key>.<extension>"
+    static Path GetFilepath(const Path &sourceFilepath,
+                            Hash::HashType key,
+                            const String &extension);
+
+    // Removes the cache files of the same source and extension with another
+    // key, so that editing the source does not pile up outdated entries.
+    // Returns the number of removed files
+    static uint RemoveStaleEntries(const Path &cacheFilepath);
+
+    CacheFile() = delete;
+};
+
+template <class T>
+void CacheFile::WriteValue(Array<Byte> *bytes, const T &value)
+{
+    const Byte *valueBytes = RCAST<const Byte *>(&value);
+    bytes->PushBack(valueBytes, valueBytes + sizeof(T));
+}
+
+template <class T>
+void CacheFile::WriteArray(Array<Byte> *bytes, const Array<T> &array)
+{
+    CacheFile::WriteValue<uint>(bytes, array.Size());
+    if (array.Size() > 0)
+    {
+        const Byte *arrayBytes = RCAST<const Byte *>(array.Data());
+        bytes->PushBack(arrayBytes, arrayBytes + sizeof(T) * array.Size());
+    }
+}
+
+template <class T>
+bool CacheFile::ReadValue(const Array<Byte> &bytes,
+                          std::size_t *offset,
+                          T *value)
+{
+    if (*offset + sizeof(T) > bytes.Size())
+    {
+        return false;
+    }
+    std::memcpy(value, bytes.Data() + *offset, sizeof(T));
+    *offset += sizeof(T);
+    return true;
+}
+
+template <class T>
+bool CacheFile::ReadArray(const Array<Byte> &bytes,
+                          std::size_t *offset,
+                          Array<T> *array)
+{
+    uint arraySize = 0;
+    if (!CacheFile::ReadValue(bytes, offset, &arraySize))
+    {
+        return false;
+    }
+
+    const std::size_t arrayBytesSize = sizeof(T) * arraySize;
+    if (*offset + arrayBytesSize > bytes.Size())
+    {
+        return false;
+    }
+
+    array->Resize(arraySize);
+    if (arraySize > 0)
+    {
+        std::memcpy(array->Data(), bytes.Data() + *offset, arrayBytesSize);
+    }
+    *offset += arrayBytesSize;
+    return true;
+}
+}  // namespace Bang
+
+#endif  // CACHEFILE_H
@@ -0,0 +1,97 @@
+#ifndef CLUSTEREDLIGHTING_H
+#define CLUSTEREDLIGHTING_H
+
+#include "Bang/AARect.h"
+#include "Bang/Array.h"
+#include "Bang/AssetHandle.h"
+#include "Bang/BangDefines.h"
+#include "Bang/Matrix4.h"
+#include "Bang/Vector4.h"
+
+namespace Bang
+{
+class Camera;
+class Light;
+class PointLight;
+class ShaderProgram;
+class Texture2D;
+
+// Splits the camera frustum in screen tiles x logarithmic depth slices, and
+// bins the point lights into the clusters they touch. The binning runs in
+// the JobSystem (one slice per task), and the result is uploaded to float
+// textures: the light data, a (offset, count) grid, and the light indices.
+// The deferred pass resolves all the clustered lights in one screen pass,
+// and forward shaders read the same data to light transparent stuff.
+class ClusteredLighting
+{
+public:
+    static constexpr uint NumTilesX = 16;
+    static constexpr uint NumTilesY = 9;
+    static constexpr uint NumSlices = 24;
+
+    ClusteredLighting();
+    ~ClusteredLighting();
+
+    void Init();
+
+    // Rebuilds the clusters for the given camera and lights
+    void Build(Camera *camera, const Array<Light *> &lights);
+
+    // Adds the clustered lights to the GBuffer light attachment
+    void ApplyClusteredLights(Camera *camera, const AARect &renderRect);
+
+    // Sets the cluster textures and uniforms into the bound shader program
+    void SetUniforms(ShaderProgram *sp) const;
+
+    // Whether the light is resolved in the clustered deferred pass. Lights
+    // that cast shadows are still applied one by one, since each one needs
+    // its own shadow map
+    static bool IsResolvedClustered(const Light *light);
+
+    uint GetNumClusteredLights() const;
+    uint GetNumLightIndices() const;
+
+private:
+    static constexpr uint TexRowWidth = 1024;
+    static constexpr uint NumClusters = (NumTilesX * NumTilesY * NumSlices);
+
+    struct ClusterLight
+    {
+        Vector4 positionRange;
+        Vector4 colorIntensity;
+        uint minTileX, maxTileX;
+        uint minTileY, maxTileY;
+        uint minSlice, maxSlice;
+        bool visible;
+    };
+
+    Array<ClusterLight> m_clusterLights;
+    Array<Array<uint>> m_slicesLightIndices;
+    Array<uint> m_slicesClusterOffsets;
+    Array<Vector4> m_gridData;
+    Array<Vector4> m_lightData;
+    Array<Vector4> m_indexData;
+    uint m_numLightIndices = 0;
+    uint m_numDeferredLights = 0;
+    float m_depthSliceScale = 0.0f;
+    float m_depthSliceBias = 0.0f;
+
+    AH<Texture2D> m_lightDataTex;
+    AH<Texture2D> m_gridTex;
+    AH<Texture2D> m_lightIndicesTex;
+    AH<ShaderProgram> p_clusteredLightsSP;
+
+    void ComputeLightClusterRange(ClusterLight *clusterLight,
+                                  const Matrix4 &viewMatrix,
+                                  const Matrix4 &projMatrix,
+                                  float zNear,
+                                  float zFar) const;
+    void BinSlices(uint beginSlice, uint endSlice);
+    void Upload();
+    uint GetSlice(float viewDepth) const;
+
+    static void UploadTexture(Texture2D *tex, Array<Vector4> *texels);
+};
+}  // namespace Bang
+
+#endif  // CLUSTEREDLIGHTING_H
@@ -13,6 +13,12 @@ class TextureCubeMap;
 class CubeMapIBLGenerator
 {
 public:
+    enum class IBLType
+    {
+        DIFFUSE,
+        SPECULAR
+    };
+
     static AH<TextureCubeMap> GenerateDiffuseIBLCubeMap(
         TextureCubeMap *textureCubeMap,
         uint IBLCubeMapSize = 32,
@@ -22,16 +28,32 @@ public:
         uint IBLCubeMapSize = 128,
         uint sampleCount = 256);
 
+    // Fill an already existing IBL cube map, so that it can be reused
+    // between generations. It is only reallocated when its size changes
+    static void FillDiffuseIBLCubeMap(TextureCubeMap *textureCubeMap,
+                                      TextureCubeMap *iblCubeMap,
+                                      uint IBLCubeMapSize,
+                                      uint sampleCount);
+
+    // Fills only one mip level of the specular IBL cube map, so that the
+    // generation can be split in several steps
+    static void FillSpecularIBLCubeMapMipMap(TextureCubeMap *textureCubeMap,
+                                             TextureCubeMap *iblCubeMap,
+                                             uint IBLCubeMapSize,
+                                             uint sampleCount,
+                                             uint mipMapLevel);
+    static uint GetSpecularIBLNumMipMaps(uint IBLCubeMapSize);
+
+    // Allocates the IBL cube map with the format (and the mip levels in the
+    // specular case) it is generated with, if it does not have them yet
+    static void PrepareIBLCubeMap(TextureCubeMap *iblCubeMap,
+                                  IBLType iblType,
+                                  uint IBLCubeMapSize);
+
     CubeMapIBLGenerator();
     virtual ~CubeMapIBLGenerator();
 
 private:
-    enum class IBLType
-    {
-        DIFFUSE,
-        SPECULAR
-    };
-
     Framebuffer *m_iblFramebuffer = nullptr;
     ShaderProgram *m_iblShaderProgram = nullptr;
 
@@ -39,6 +61,11 @@ private:
                                                  IBLType iblType,
                                                  uint IBLCubeMapSize,
                                                  uint sampleCount);
+    static void RenderIBLCubeMap(TextureCubeMap *textureCubeMap,
+                                 TextureCubeMap *iblCubeMap,
+                                 IBLType iblType,
+                                 uint sampleCount,
+                                 uint mipMapLevel);
 
     static CubeMapIBLGenerator *GetInstance();
 };
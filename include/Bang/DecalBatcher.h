@@ -0,0 +1,169 @@
+#ifndef DECALBATCHER_H
+#define DECALBATCHER_H
+
+#include "Bang/AARect.h"
+#include "Bang/Array.h"
+#include "Bang/AssetHandle.h"
+#include "Bang/AtlasPacker.h"
+#include "Bang/BangDefines.h"
+#include "Bang/EventListener.h"
+#include "Bang/IEventsAsset.h"
+#include "Bang/IEventsDestroy.h"
+#include "Bang/Matrix4.h"
+#include "Bang/Quaternion.h"
+#include "Bang/RingBuffer.h"
+#include "Bang/Time.h"
+#include "Bang/UMap.h"
+#include "Bang/Vector3.h"
+#include "Bang/Vector4.h"
+
+namespace Bang
+{
+class Camera;
+class Framebuffer;
+class ShaderProgram;
+class Texture2D;
+
+// Gathers the decals of the decals pass, and draws all of them in one screen
+// pass over the GBuffer. Decal textures are copied into a shared mipmapped
+// atlas (LRU evicted when full), the decals are binned into screen tiles of
+// TileSize pixels, and the result is uploaded to float textures: the decal
+// data, a (offset, count) grid, and the decal indices. Each pixel blends the
+// decals of its tile in the order they were added. It also keeps a budgeted
+// pool of spawned decals that are not backed by a GameObject, and that fade
+// out and expire on their own (impacts, footprints...).
+class DecalBatcher : public EventListener<IEventsAsset>,
+                     public EventListener<IEventsDestroy>
+{
+public:
+    static constexpr int TileSize = 32;
+    static constexpr int AtlasMaxMipLevel = 3;
+
+    DecalBatcher();
+    virtual ~DecalBatcher() override;
+
+    void Init();
+
+    // Queues a decal for the current decals pass. The matrix goes from world
+    // space to the decal clip space (the [-1, 1] box). Decals without
+    // texture or fully faded are skipped
+    void AddDecal(const Matrix4 &worldToDecalMatrix,
+                  Texture2D *texture,
+                  float fade);
+
+    // Spawns an ortho decal that lives for the given time, fading out during
+    // its last fadeOutSeconds. When the budget is full, the oldest spawned
+    // decal is recycled
+    void SpawnDecal(const Vector3 &position,
+                    const Quaternion &rotation,
+                    const Vector3 &boxSize,
+                    Texture2D *texture,
+                    float lifeTimeSeconds,
+                    float fadeOutSeconds = 1.0f);
+    void ClearSpawnedDecals();
+
+    // Draws the queued decals (and the alive spawned ones) into the GBuffer
+    // draw buffers that are set, and empties the queue
+    void Flush(Camera *camera);
+
+    void SetEnabled(bool enabled);
+    void SetSpawnedDecalsBudget(uint spawnedDecalsBudget);
+    void SetAtlasEntryMaxSize(int atlasEntryMaxSize);
+
+    bool IsEnabled() const;
+    uint GetSpawnedDecalsBudget() const;
+    int GetAtlasEntryMaxSize() const;
+    uint GetNumSpawnedDecals() const;
+    uint GetNumAtlasEntries() const;
+    Texture2D *GetAtlasTexture() const;
+
+    // Counters and tile grid of the last flush
+    uint GetNumFlushedDecals() const;
+    uint GetNumFlushDrawCalls() const;
+    const Vector2i &GetNumTiles() const;
+
+    // Number of TileSize tiles that cover a viewport
+    static Vector2i ComputeNumTiles(const Vector2i &viewportSize);
+
+    // IEventsAsset
+    void OnAssetChanged(Asset *asset) override;
+
+    // IEventsDestroy
+    void OnDestroyed(EventEmitter<IEventsDestroy> *object) override;
+
+private:
+    static constexpr uint TexRowWidth = 1024;
+    static constexpr uint NumTexelsPerDecal = 6;
+    static constexpr int AtlasSize = 2048;
+
+    // Every atlas entry is surrounded by its edge texels repeated, so that
+    // the mip levels up to AtlasMaxMipLevel do not bleed the neighbours
+    static constexpr int AtlasEntryPadding = (2 << AtlasMaxMipLevel);
+
+    struct QueuedDecal
+    {
+        Matrix4 worldToDecalMatrix;
+        Texture2D *texture;
+        float fade;
+        uint atlasKey;
+        Vector4 atlasUvRect;
+        uint minTileX, maxTileX;
+        uint minTileY, maxTileY;
+        bool visible;
+    };
+
+    struct SpawnedDecal
+    {
+        Matrix4 worldToDecalMatrix;
+        AH<Texture2D> texture;
+        Time spawnTime;
+        float lifeTimeSeconds;
+        float fadeOutSeconds;
+    };
+
+    bool m_enabled = true;
+    Array<QueuedDecal> m_queuedDecals;
+    Array<uint> m_tileOffsetsCounts;
+    Array<uint> m_decalIndices;
+    Array<Vector4> m_gridData;
+    Array<Vector4> m_decalData;
+    Array<Vector4> m_indexData;
+    uint m_numFlushedDecals = 0;
+    uint m_numFlushDrawCalls = 0;
+    Vector2i m_numTiles = Vector2i::Zero();
+    bool m_atlasMipMapsDirty = false;
+
+    // From the oldest to the newest, its capacity is the budget
+    RingBuffer<SpawnedDecal> m_spawnedDecals;
+
+    AtlasPacker m_atlasPacker;
+    UMap<Texture2D *, uint> m_atlasTexturesToKeys;
+    UMap<uint, Texture2D *> m_atlasKeysToTextures;
+    uint m_atlasKeysCounter = 0;
+    int m_atlasEntryMaxSize = 512;
+
+    AH<Texture2D> m_atlasTex;
+    AH<Texture2D> m_decalDataTex;
+    AH<Texture2D> m_gridTex;
+    AH<Texture2D> m_decalIndicesTex;
+    Framebuffer *m_atlasFramebuffer = nullptr;
+    AH<ShaderProgram> p_decalsSP;
+    AH<ShaderProgram> p_atlasCopySP;
+
+    void QueueSpawnedDecals();
+    void ResolveAtlasRects();
+    bool AddToAtlas(Texture2D *texture, uint *atlasKey);
+    void CopyToAtlas(Texture2D *texture, const AARecti &atlasRect);
+    void RemoveAtlasEntry(Texture2D *texture);
+    void ComputeDecalTileRange(QueuedDecal *decal,
+                               const Matrix4 &cameraViewProjMatrix,
+                               const Vector2i &viewportSize) const;
+    void BinTiles();
+    void Upload();
+    void SetUniforms(ShaderProgram *sp) const;
+
+    static void UploadTexture(Texture2D *tex, Array<Vector4> *texels);
+};
+}  // namespace Bang
+
+#endif  // DECALBATCHER_H
@@ -15,6 +15,9 @@ public:
     DecalRenderer();
     virtual ~DecalRenderer() override;
 
+    // Component
+    virtual void OnRender(RenderPass renderPass) override;
+
     // Renderer
     virtual void OnRender() override;
     virtual Matrix4 GetModelMatrixUniform() const override;
@@ -26,6 +29,7 @@ public:
     void SetZFar(float zFar);
     void SetBoxSize(const Vector3 &boxSize);
     void SetDecalTexture(Texture2D *decalTexture);
+    void SetFade(float fade);
 
     float GetZNear() const;
     float GetZFar() const;
@@ -34,6 +38,7 @@ public:
     float GetAspectRatio() const;
     bool GetIsPerspective() const;
     Texture2D *GetDecalTexture() const;
+    float GetFade() const;
     Matrix4 GetViewMatrix() const;
     Matrix4 GetProjectionMatrix() const;
 
@@ -49,6 +54,11 @@ private:
     float m_fieldOfViewDegrees = 60.0f;
     float m_aspectRatio = 1.0f;
     Vector3 m_boxSize = Vector3::One();
+    float m_fade = 1.0f;
+
+    // Decals with the default decal shader are queued into the
+    // DecalBatcher, and drawn all together at the end of the decals pass
+    bool AddToBatch();
 };
 }
 
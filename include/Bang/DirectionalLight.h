@@ -40,7 +40,7 @@ public:
     void Reflect() override;
 
 protected:
-    AH<Texture2D> m_blurredShadowMapTexture, m_blurAuxiliarTexture;
+    AH<Texture2D> m_blurredShadowMapTexture;
     Framebuffer *m_shadowMapFramebuffer = nullptr;
     Matrix4 m_lastUsedShadowMapViewProj = Matrix4::Identity();
     float m_shadowDistance = 100.0f;
@@ -49,7 +49,10 @@ protected:
     virtual ~DirectionalLight() override;
 
     AABox GetShadowCastersAABox(
-        const Array<Renderer *> &shadowCastersRenderers) const;
+        const Array<ShadowCaster> &shadowCasters) const;
+    Array<ShadowCaster> GetShadowCastersInRange(
+        const AABox &camAABoxLS,
+        const Matrix4 &worldToLight) const;
 
     // Light
     void RenderShadowMaps_(GameObject *go) override;
@@ -57,10 +60,12 @@ protected:
     void GetWorldToShadowMapMatrices(
         Matrix4 *viewMatrix,
         Matrix4 *projMatrix,
-        const Array<Renderer *> &shadowCastersRenderers) const;
+        const AABox &camAABoxLS,
+        const Array<ShadowCaster> &shadowCasters) const;
     Matrix4 GetLightToWorldMatrix() const;
-    AABox GetShadowMapOrthoBox(
-        const Array<Renderer *> &shadowCastersRenderers) const;
+    AABox GetCameraFrustumAABoxInLightSpace(const Matrix4 &worldToLight) const;
+    AABox GetShadowMapOrthoBox(const AABox &camAABoxLS,
+                               const Array<ShadowCaster> &shadowCasters) const;
 };
 }
 
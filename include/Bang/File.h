@@ -37,6 +37,7 @@ public:
     static void AddExecutablePermission(const Path &path);
 
     static String GetContents(const Path &filepath);
+    static Array<Byte> GetBytes(const Path &filepath);
     static void Write(const Path &filepath, const String &contents);
     static void Write(const Path &filepath, const Array<String> &lines);
     static void Write(const Path &filepath, const List<String> &lines);
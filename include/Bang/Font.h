@@ -5,6 +5,8 @@
 
 #include "Bang/AARect.h"
 #include "Bang/Asset.h"
+#include "Bang/AssetHandle.h"
+#include "Bang/AtlasPacker.h"
 #include "Bang/BangDefines.h"
 #include "Bang/MetaNode.h"
 #include "Bang/Path.h"
@@ -16,10 +18,10 @@ using TTF_Font = _TTF_Font;
 
 namespace Bang
 {
-template <class>
-class AssetHandle;
 class Texture2D;
 
+// Glyphs are rendered on demand, as signed distance fields, into a single
+// atlas shared by all the font sizes. Characters are unicode codepoints.
 class Font : public Asset
 {
     ASSET(Font)
@@ -36,18 +38,28 @@ public:
         float advance = 0;
     };
 
-    Texture2D *GetFontAtlas(int size) const;
+    // Size at which the glyphs distance fields are rendered, and maximum
+    // distance (in pixels at that size) they encode
+    static constexpr int SDFGlyphSize = 48;
+    static constexpr int SDFSpread = 6;
+    static constexpr int AtlasPageSize = 1024;
 
-    Font::GlyphMetrics GetCharMetrics(int fontSize, char c) const;
-    bool HasCharacter(char c) const;
-    float GetKerning(int fontSize, char leftChar, char rightChar) const;
+    Texture2D *GetFontAtlas() const;
+
+    // Incremented whenever glyphs are evicted from the atlas, so that the
+    // UVs got from it before need to be got again
+    uint GetAtlasGeneration() const;
+
+    Font::GlyphMetrics GetCharMetrics(int fontSize, uint c) const;
+    bool HasCharacter(uint c) const;
+    float GetKerning(int fontSize, uint leftChar, uint rightChar) const;
     float GetLineSkip(int fontSize) const;
     float GetFontAscent(int fontSize) const;
     float GetFontDescent(int fontSize) const;
     float GetFontHeight(int fontSize) const;
-    Vector2i GetAtlasCharRectSize(int fontSize, char c) const;
-    Vector2 GetCharMinUv(int fontSize, char c) const;
-    Vector2 GetCharMaxUv(int fontSize, char c) const;
+    Vector2i GetAtlasCharRectSize(int fontSize, uint c) const;
+    Vector2 GetCharMinUv(uint c) const;
+    Vector2 GetCharMaxUv(uint c) const;
 
     // Asset
     void Import(const Path &ttfFilepath) override;
@@ -60,25 +72,28 @@ private:
     Path m_ttfFilepath = Path::Empty();
     TTF_Font *m_referenceFont = nullptr;
 
+    TTF_Font *m_sdfFont = nullptr;
+
     struct FontDataCache
     {
         float height, ascent, descent, lineSkip;
-        UMap<char, GlyphMetrics> charMetrics;
+        mutable UMap<uint, GlyphMetrics> charMetrics;
     };
 
     // For each font style
     FontDataCache m_referenceFontDataCache;
-    mutable UMap<int, TTF_Font *> m_openFonts;
-    mutable UMap<int, AH<Texture2D>> m_cachedAtlas;
-    mutable UMap<int, UMap<char, AARecti>> m_cachedAtlasCharRects;
-    mutable UMap<int, String> m_cachedAtlasChars;
+
+    mutable AH<Texture2D> m_atlasTexture;
+    mutable AtlasPacker m_atlasPacker;
+    mutable UMap<uint, AARecti> m_atlasCharRects;
+    mutable uint m_atlasGeneration = 0;
 
     Font();
     virtual ~Font() override;
 
     TTF_Font *GetReferenceFont() const;
-    TTF_Font *GetTTFFont(int fontSize) const;
-    bool HasFontSizeLoaded(int fontSize) const;
+    TTF_Font *GetSDFFont() const;
+    const AARecti *GetAtlasCharRect(uint c) const;
     static float ScaleMagnitude(int fontSize, float magnitude);
     static Vector2 ScaleMagnitude(int fontSize, const Vector2 &magnitude);
     static float GetScaleProportion(int fontSize);
@@ -16,11 +16,14 @@ class Texture2D;
 class FontSheetCreator
 {
 public:
-    static bool LoadAtlasTexture(TTF_Font *fontFace,
-                                 Texture2D *resultTexture,
-                                 const String &charsToLoad,
-                                 Array<AARecti> *imagesOutputRects = nullptr,
-                                 int extraMargin = 0);
+    // Rasterizes the glyph coverage into the alpha of a white image. Returns
+    // an empty image if the font does not provide the glyph
+    static Image RenderGlyph(TTF_Font *ttfFont, uint codepoint);
+
+    // Signed distance field of the glyph coverage, padded by spread pixels.
+    // The distance is stored in the alpha, mapping [spread, -spread] (in
+    // pixels, negative inside) to [0, 1], so that the glyph edge is at 0.5
+    static Image CreateSDF(const Image &glyphImage, int spread);
 
     static Image PackImages(const Array<Image> &images,
                             int margin,
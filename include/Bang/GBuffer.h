@@ -61,6 +61,9 @@ public:
     Texture2D *GetDrawColorTexture() const;
     Texture2D *GetReadColorTexture() const;
 
+    // GPU memory of all the textures of this GBuffer
+    uint GetBytesSize() const;
+
     static String GetMiscTexName();
     static String GetLightTexName();
     static String GetColorsTexName();
@@ -4,6 +4,7 @@
 #include <functional>
 #include <vector>
 
+#include "Bang/AABoxBVH.h"
 #include "Bang/Array.h"
 #include "Bang/Array.tcc"
 #include "Bang/AssetHandle.h"
@@ -27,6 +28,8 @@ namespace Bang
 template <class>
 class EventEmitter;
 class Camera;
+class ClusteredLighting;
+class DecalBatcher;
 class DebugRenderer;
 class Framebuffer;
 class GBuffer;
@@ -36,6 +39,7 @@ class IEventsDestroy;
 class Material;
 class Mesh;
 class RenderFactory;
+class RenderTargetPool;
 class Renderer;
 class Scene;
 class ShaderProgram;
@@ -83,8 +87,40 @@ public:
     void FillTexture(Texture2D *texture, const Color &color);
     void CopyTexture(Texture2D *source, Texture2D *destiny);
 
+    // Renders the source into the (smaller) destiny, halving it in each step
+    // so that every source texel is averaged in
+    void DownscaleTexture(Texture2D *source, Texture2D *destiny);
+
     void SetReplacementMaterial(Material *material);
 
+    // Reflection probes are updated a few steps per frame (each step renders
+    // one face or one IBL mip level). The budget is shared by all the probes
+    void SetReflectionProbesUpdateStepsPerFrame(uint updateStepsPerFrame);
+    uint GetReflectionProbesUpdateStepsPerFrame() const;
+
+    void EndFrame();
+
+    // Automatic LOD selection. LOD bias > 1 keeps detail for longer, and
+    // shadow maps render with the LOD offset added to the camera one.
+    void SetLODBias(float lodBias);
+    void SetShadowMapsLODOffset(int shadowMapsLODOffset);
+    float GetLODBias() const;
+    int GetShadowMapsLODOffset() const;
+    bool IsRenderingShadowMaps() const;
+
+    // Shadow casters of the scene whose shadow maps are being rendered, all
+    // of them or (through their bounds hierarchy) the ones whose world box
+    // overlaps, in the same order
+    const Array<ShadowCaster> &GetShadowCasters() const;
+    void GetShadowCasters(const AABoxBVH::OverlapsFunction &overlaps,
+                          Array<ShadowCaster> *shadowCasters) const;
+
+    // Triangle stats of the last GEngine::Render call
+    void AddRenderedTriangles(uint numRenderedTriangles,
+                              uint numFullDetailTriangles);
+    uint GetNumRenderedTriangles() const;
+    uint GetNumFullDetailTriangles() const;
+
     void PushActiveRenderingCamera();
     void SetActiveRenderingCamera(Camera *camera);
     void PopActiveRenderingCamera();
@@ -108,6 +144,9 @@ public:
 
     GL *GetGL() const;
     TextureUnitManager *GetTextureUnitManager() const;
+    ClusteredLighting *GetClusteredLighting() const;
+    DecalBatcher *GetDecalBatcher() const;
+    RenderTargetPool *GetRenderTargetPool() const;
 
     // IEventsDestroy
     virtual void OnDestroyed(EventEmitter<IEventsDestroy> *object) override;
@@ -119,19 +158,36 @@ private:
     DebugRenderer *m_debugRenderer = nullptr;
     RenderFactory *m_renderFactory = nullptr;
     TextureUnitManager *m_texUnitManager = nullptr;
+    ClusteredLighting *m_clusteredLighting = nullptr;
+    DecalBatcher *m_decalBatcher = nullptr;
+    RenderTargetPool *m_renderTargetPool = nullptr;
 
     MultiObjectGatherer<ReflectionProbe, true> m_reflProbesCache;
     MultiObjectGatherer<Light, true> m_lightsCache;
+    MultiObjectGatherer<Renderer, true> m_renderersCache;
+    Array<ShadowCaster> m_shadowCasters;
+    Array<AABox> m_shadowCastersAABoxes;
+    AABoxBVH m_shadowCastersBVH;
+    mutable Array<uint> m_shadowCastersQueryIndices;
 
     StackAndValue<Camera *> p_renderingCameras;
     USet<Camera *> m_stackedCamerasThatHaveBeenDestroyed;
 
+    float m_lodBias = 1.0f;
+    int m_shadowMapsLODOffset = 1;
+    bool m_renderingShadowMaps = false;
+    uint m_numRenderedTriangles = 0;
+    uint m_numFullDetailTriangles = 0;
+    uint m_reflProbesUpdateStepsPerFrame = 1;
+    uint m_reflProbesUpdateStepsLeft = 1;
+
     AH<ShaderProgram> m_renderSkySP;
     AH<Material> m_replacementMaterial;
     AH<ShaderProgram> m_fillCubeMapFromTexturesSP;
     Framebuffer *m_fillCubeMapFromTexturesFB = nullptr;
 
-    // Forward rendering arrays
+    // Forward rendering arrays. Point lights are read from the clusters, so
+    // these only hold the directional lights
     bool m_currentlyForwardRendering = false;
     Array<int> m_currentForwardRenderingLightTypes;
     Array<Color> m_currentForwardRenderingLightColors;
@@ -152,6 +208,7 @@ private:
 
     void Render(Renderer *rend);
     void RenderShadowMaps(GameObject *go);
+    void GatherShadowCasters(GameObject *go);
     void RenderTexture_(Texture2D *texture, float gammaCorrection);
     void RenderReflectionProbes(GameObject *go);
     void RenderTransparentPass(GameObject *go);
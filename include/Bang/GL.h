@@ -29,10 +29,14 @@ namespace Bang
         GL::CheckError(                                                     \
             __LINE__, String(SCAST<const char *>(__FUNCTION__)), __FILE__), \
         "There was an OpenGL error, see previous message.");
+#define GL_CheckPassErrors(PASS_NAME)                       \
+    ASSERT_SOFT_MSG(GL::CheckPassErrors(String(PASS_NAME)), \
+                    "There was an OpenGL error, see previous message.");
 #else
 #define GL_CALL(CALL) CALL
-#define GL_ClearError()  // Empty
-#define GL_CheckError()  // Empty
+#define GL_ClearError()                // Empty
+#define GL_CheckError()                // Empty
+#define GL_CheckPassErrors(PASS_NAME)  // Empty
 #endif
 
 class GLObject;
@@ -441,6 +445,13 @@ public:
 
     static void ClearError();
     static bool CheckError(int line, const String &func, const String &file);
+
+    // With batched error checking, GL_CALL does not check the errors around
+    // every call. They are checked once per render pass instead, with
+    // GL_CheckPassErrors
+    static void SetBatchedErrorChecking(bool batchedErrorChecking);
+    static bool IsBatchedErrorChecking();
+    static bool CheckPassErrors(const String &passName);
     static bool CheckFramebufferError();
 
     static void Clear(GLbitfield bufferBit);
@@ -534,6 +545,15 @@ public:
                                      int location,
                                      const String &fragDataName);
     static void DeleteProgram(GLId programId);
+    static bool IsProgramBinarySupported();
+    static bool IsProgramBinaryFormatSupported(GLenum binaryFormat);
+    static void SetProgramBinaryRetrievable(GLId programId, bool retrievable);
+    static bool GetProgramBinary(GLId programId,
+                                 GLenum *binaryFormat,
+                                 Array<Byte> *binary);
+    static bool ProgramBinary(GLId programId,
+                              GLenum binaryFormat,
+                              const Array<Byte> &binary);
 
     static void FramebufferTexture(GL::FramebufferTarget target,
                                    GL::Attachment attachment,
@@ -622,7 +642,24 @@ public:
                            GL::ColorFormat textureColorFormat,
                            GL::ColorComp inputDataColorComp,
                            GL::DataType inputDataType,
-                           const void *data);
+                           const void *data,
+                           uint mipMapLevel = 0);
+    static void TexSubImage2D(GL::TextureTarget textureTarget,
+                              uint offsetX,
+                              uint offsetY,
+                              uint width,
+                              uint height,
+                              GL::ColorComp inputDataColorComp,
+                              GL::DataType inputDataType,
+                              const void *data,
+                              uint mipMapLevel = 0);
+    static void CompressedTexImage2D(GL::TextureTarget textureTarget,
+                                     uint textureWidth,
+                                     uint textureHeight,
+                                     GLenum compressedFormat,
+                                     uint dataSize,
+                                     const void *data,
+                                     uint mipMapLevel = 0);
     static void TexImage3D(GL::TextureTarget textureTarget,
                            uint textureWidth,
                            uint textureHeight,
@@ -797,6 +834,7 @@ public:
                                    GLint *ints);
 
     static int GetShaderInteger(GLId shaderId, GL::Enum glEnum);
+    static String GetString(GLenum glEnum);
     static String GetShaderErrorMsg(GLId shaderId);
 
     static AARecti GetViewportRect();
@@ -842,7 +880,8 @@ public:
     static void GetTexImage(GL::TextureTarget textureTarget,
                             GL::ColorComp colorComp,
                             GL::DataType dataType,
-                            void *pixels);
+                            void *pixels,
+                            uint mipMapLevel = 0);
 
     static void Bind(const GLObject *bindable);
     static void Bind(GL::BindTarget bindTarget, GLId glId);
@@ -879,6 +918,13 @@ public:
     static void PrintGLStats();
     static void PrintGLContext();
 
+    // State changes (binds, enables, blend, depth, stencil, viewport...)
+    // issued to the driver, and skipped because the cached state already had
+    // that value, during the last frame
+    static uint GetNumIssuedStateCalls();
+    static uint GetNumSkippedStateCalls();
+    static void EndFrame();
+
     static GL::ViewProjMode GetViewProjMode();
 
     static GL *GetInstance();
@@ -888,6 +934,12 @@ public:
     virtual ~GL();
 
 private:
+    bool m_batchedErrorChecking = false;
+    uint m_numIssuedStateCalls = 0;
+    uint m_numSkippedStateCalls = 0;
+    uint m_lastFrameNumIssuedStateCalls = 0;
+    uint m_lastFrameNumSkippedStateCalls = 0;
+
     void Init();
 
     // Context
@@ -905,6 +957,8 @@ private:
     StackAndValue<GLId> m_boundReadFramebufferIds;
     StackAndValue<GLId> m_boundShaderProgramIds;
     StackAndValue<GLId> m_boundUniformBufferIds;
+    int m_activeTextureUnit = 0;
+    Array<std::array<GLId, 4>> m_boundTextureIdsPerUnit;
     StackAndValue<float> m_lineWidths;
     StackAndValue<Byte> m_stencilValues;
     StackAndValue<uint> m_stencilMasks;
@@ -943,6 +997,9 @@ private:
 
     GLUniforms *m_glUniforms = nullptr;
 
+    static bool CountStateCall(bool issued);
+    static int GetTextureTargetIndex(GL::BindTarget textureTarget);
+
     friend class GEngine;
 };
 }  // namespace Bang
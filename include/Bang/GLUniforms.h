@@ -45,6 +45,7 @@ public:
     static const String UniformName_MetalnessTexture;
     static const String UniformName_NormalMapTexture;
     static const String UniformName_HasNormalMapTexture;
+    static const String UniformName_NormalMapIsRG;
     static const String UniformName_TimeSeconds;
     static const String UniformName_Model;
     static const String UniformName_ModelInv;
@@ -53,6 +53,20 @@ public:
     static void CreateUISceneInto(Scene *scene);
     static Scene *CreateDefaultSceneInto(Scene *scene);
 
+    // Grid of auto LOD spheres at increasing distances, to compare
+    // GEngine rendered vs full detail triangle counts
+    static Scene *CreateLODBenchmarkSceneInto(Scene *scene,
+                                              int gridSize = 16);
+
+    // Vertical layout of sections, each one a vertical layout of grids of
+    // labels (10k labels with the default sizes). Change the content of the
+    // returned label and check the UILayoutManager rebuild counters of the
+    // next frame: only the label and its grid should be recalculated
+    static UILabel *CreateUILayoutBenchmarkInto(GameObject *container,
+                                                int numSections = 10,
+                                                int numGridsPerSection = 10,
+                                                int numLabelsPerGrid = 100);
+
     static Camera *CreateDefaultCameraInto(GameObject *go);
     static Camera *CreateDefaultCameraInto(Camera *cam);
 
@@ -0,0 +1,57 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/String.h"
+
+namespace Bang
+{
+class Path;
+
+class Hash
+{
+public:
+    using HashType = uint64_t;
+
+    static constexpr HashType InitialSeed = 14695981039346656037ULL;
+
+    // FNV-1a, good enough to key caches by content. Not cryptographic.
+    static HashType Compute(const void *data,
+                            std::size_t dataSize,
+                            HashType seed = InitialSeed);
+    static HashType Compute(const String &str, HashType seed = InitialSeed);
+    static HashType ComputeFile(const Path &filepath,
+                                HashType seed = InitialSeed);
+
+    template <class T>
+    static HashType Compute(const Array<T> &array, HashType seed = InitialSeed);
+
+    template <class T>
+    static HashType ComputeValue(const T &value, HashType seed = InitialSeed);
+
+    static String ToHexString(HashType hash);
+
+    Hash() = delete;
+};
+
+template <class T>
+Hash::HashType Hash::Compute(const Array<T> &array, HashType seed)
+{
+    const uint size = array.Size();
+    seed = Hash::ComputeValue(size, seed);
+    return (size > 0) ? Hash::Compute(array.Data(), sizeof(T) * size, seed)
+                      : seed;
+}
+
+template <class T>
+Hash::HashType Hash::ComputeValue(const T &value, HashType seed)
+{
+    return Hash::Compute(&value, sizeof(T), seed);
+}
+}  // namespace Bang
+
+#endif  // HASH_H
@@ -0,0 +1,31 @@
+#ifndef IUILISTDATASOURCE_H
+#define IUILISTDATASOURCE_H
+
+#include "Bang/BangDefines.h"
+
+namespace Bang
+{
+class GameObject;
+
+// Model of a virtualized UIList. The list only keeps GameObjects for the
+// visible rows (plus a small margin), and binds them to the indices of the
+// model that are scrolled into view.
+class IUIListDataSource
+{
+public:
+    virtual ~IUIListDataSource() = default;
+
+    virtual int GetNumItems() const = 0;
+
+    // Height in pixels of every row
+    virtual int GetItemHeight() const = 0;
+
+    // Creates an unbound row. Rows are pooled and rebound while scrolling
+    virtual GameObject *CreateItem() = 0;
+
+    // Fills the row with the contents of the item at the given model index
+    virtual void BindItem(GameObject *item, int index) = 0;
+};
+}  // namespace Bang
+
+#endif  // IUILISTDATASOURCE_H
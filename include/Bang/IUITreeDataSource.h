@@ -0,0 +1,37 @@
+#ifndef IUITREEDATASOURCE_H
+#define IUITREEDATASOURCE_H
+
+#include "Bang/BangDefines.h"
+
+namespace Bang
+{
+class GameObject;
+
+// Model of a virtualized UITree. Nodes are ids of the model, and the tree
+// only keeps GameObjects for the visible rows (plus a small margin) of the
+// expanded nodes, binding them to the nodes scrolled into view.
+class IUITreeDataSource
+{
+public:
+    using NodeId = uint64_t;
+
+    // Parent of the top level nodes, it is never bound to a row
+    static constexpr NodeId RootNode = ~SCAST<NodeId>(0);
+
+    virtual ~IUITreeDataSource() = default;
+
+    virtual int GetNumChildren(NodeId node) const = 0;
+    virtual NodeId GetChild(NodeId node, int index) const = 0;
+
+    // Height in pixels of every row
+    virtual int GetItemHeight() const = 0;
+
+    // Creates an unbound item. Items are pooled and rebound while scrolling
+    virtual GameObject *CreateItem() = 0;
+
+    // Fills the item with the contents of the given node
+    virtual void BindItem(GameObject *item, NodeId node) = 0;
+};
+}  // namespace Bang
+
+#endif  // IUITREEDATASOURCE_H
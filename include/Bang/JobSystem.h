@@ -0,0 +1,111 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/Mutex.h"
+#include "Bang/String.h"
+
+namespace Bang
+{
+class Thread;
+
+class Job
+{
+public:
+    Job();
+    ~Job();
+
+    bool IsFinished() const;
+
+private:
+    std::function<void()> m_function;
+
+    // One for every unfinished dependency, plus one while being scheduled
+    std::atomic<int> m_pendingDependencies;
+    std::atomic<bool> m_finished;
+
+    Mutex m_continuationsMutex;
+    Array<std::shared_ptr<Job>> m_continuations;
+
+    friend class JobSystem;
+};
+
+using JobHandle = std::shared_ptr<Job>;
+
+// Persistent pool of worker threads. Each worker owns a deque of jobs: it
+// pushes and pops from the back, and idle workers steal from the front of
+// the others' deques. Jobs scheduled from outside the workers (main thread,
+// etc.) go to a shared queue that every worker also steals from.
+class JobSystem
+{
+public:
+    using JobFunction = std::function<void()>;
+    using RangeFunction = std::function<void(uint beginIndex, uint endIndex)>;
+
+    JobSystem();
+    ~JobSystem();
+
+    void Init(uint numWorkers = 0);
+
+    JobHandle Schedule(const JobFunction &jobFunction);
+
+    // The job will start once all the dependencies have finished
+    JobHandle Schedule(const JobFunction &jobFunction,
+                       const Array<JobHandle> &dependencies);
+
+    // Splits [beginIndex, endIndex) into chunks of at most grainSize indices,
+    // and calls rangeFunction for every chunk, in parallel. The returned job
+    // finishes when all the chunks have finished
+    JobHandle ScheduleParallelFor(uint beginIndex,
+                                  uint endIndex,
+                                  uint grainSize,
+                                  const RangeFunction &rangeFunction);
+    void ParallelFor(uint beginIndex,
+                     uint endIndex,
+                     uint grainSize,
+                     const RangeFunction &rangeFunction);
+
+    // Does not sleep, the calling thread executes other jobs while waiting
+    void Wait(const JobHandle &job);
+    void Wait(const Array<JobHandle> &jobs);
+
+    uint GetNumWorkers() const;
+    bool IsWorkerThread() const;
+
+    static uint GetDefaultNumWorkers();
+    static JobSystem *GetInstance();
+
+private:
+    struct JobQueue
+    {
+        Mutex mutex;
+        std::deque<JobHandle> jobs;
+    };
+
+    Array<Thread *> m_workers;
+    Array<JobQueue *> m_workerQueues;
+    JobQueue m_sharedQueue;
+
+    std::atomic<int> m_numQueuedJobs;
+    std::atomic<bool> m_exiting;
+    std::mutex m_sleepMutex;
+    std::condition_variable m_sleepCondition;
+
+    void Enqueue(const JobHandle &job);
+    JobHandle PopJob(int workerIndex);
+    JobHandle StealJob(int workerIndex);
+    bool TryExecuteOneJob();
+    void Execute(const JobHandle &job);
+    void WorkerLoop(int workerIndex);
+};
+}  // namespace Bang
+
+#endif  // JOBSYSTEM_H
@@ -1,6 +1,8 @@
 #ifndef LIGHT_H
 #define LIGHT_H
 
+#include "Bang/AABox.h"
+#include "Bang/AABoxBVH.h"
 #include "Bang/Array.h"
 #include "Bang/AssetHandle.h"
 #include "Bang/BangDefines.h"
@@ -20,6 +22,14 @@ class Renderer;
 class ShaderProgram;
 class Texture;
 
+// A renderer that can cast shadows, with its world bounds. GEngine gathers
+// them once per frame, so that every light only has to cull the list
+struct ShadowCaster
+{
+    Renderer *renderer = nullptr;
+    AABox aaBoxWorld = AABox::Empty();
+};
+
 class Light : public Component
 {
     COMPONENT_ABSTRACT(Light)
@@ -58,7 +68,8 @@ protected:
 
     void SetShadowMapShaderProgram(ShaderProgram *sp);
     void SetLightScreenPassShaderProgram(ShaderProgram *sp);
-    Array<Renderer *> GetShadowCastersIn(GameObject *go) const;
+    void GetShadowCasters(const AABoxBVH::OverlapsFunction &overlaps,
+                          Array<ShadowCaster> *shadowCasters) const;
     virtual void SetUniformsBeforeApplyingLight(ShaderProgram *sp) const;
 
 private:
@@ -18,6 +18,7 @@
 #include "Bang/RenderPass.h"
 #include "Bang/ShaderProgramProperties.h"
 #include "Bang/String.h"
+#include "Bang/USet.h"
 
 namespace Bang
 {
@@ -55,6 +56,7 @@ public:
     void SetNormalMapTexture(Texture2D *normalMapTexture);
     void SetShaderProgramProperties(const ShaderProgramProperties &spProps);
     void SetNeededUniforms(const NeededUniformFlags &neededUniformFlags);
+    void SetKeywordEnabled(const String &keyword, bool enabled);
     void BindMaterialUniforms(ShaderProgram *sp) const;
 
     NeededUniformFlags &GetNeededUniforms();
@@ -64,7 +66,11 @@ public:
     const Vector2 &GetNormalMapUvOffset() const;
     const Vector2 &GetNormalMapUvMultiply() const;
     float GetNormalMapMultiplyFactor() const;
+    // Variant of the shader program for the enabled keywords
     ShaderProgram *GetShaderProgram() const;
+    ShaderProgram *GetBaseShaderProgram() const;
+    bool IsKeywordEnabled(const String &keyword) const;
+    const USet<String> &GetEnabledKeywords() const;
     bool GetReceivesLighting() const;
     float GetMetalness() const;
     float GetRoughness() const;
@@ -84,6 +90,9 @@ public:
 
     // Asset
     void Import(const Path &materialFilepath) override;
+    void PreImport(const Path &materialFilepath) override;
+    void LoadDependenciesAsync(
+        Array<std::shared_ptr<AssetLoadRequest>> *dependencies) override;
 
     // Serializable
     virtual void Reflect() override;
@@ -95,6 +104,11 @@ protected:
     AH<Texture2D> p_normalMapTexture;
     AH<ShaderProgram> p_shaderProgram;
     ShaderProgramProperties m_shaderProgramProperties;
+    USet<String> m_enabledKeywords;
+
+    // Variant of p_shaderProgram for m_enabledKeywords, looked up again only
+    // after any of them changes (or the program gets linked again)
+    mutable ShaderProgram *p_shaderProgramVariant = nullptr;
 
     float m_normalMapMultiplyFactor = 1.0f;
     Color m_albedoColor = Color::White();
@@ -114,6 +128,8 @@ protected:
     virtual void CloneInto(ICloneable *clone, bool cloneGUID) const override;
 
 private:
+    MetaNode m_preImportedMeta;
+    bool m_hasPreImportedMeta = false;
 };
 }
 
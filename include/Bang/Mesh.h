@@ -3,6 +3,7 @@
 
 #include <array>
 #include <functional>
+#include <memory>
 
 #include "Bang/AABox.h"
 #include "Bang/Array.h"
@@ -66,9 +67,11 @@ public:
     void UpdateVAOsAndTables();
 
     void CalculateLODs();
+    void CalculateLODsAsync();
+    bool IsCalculatingLODs() const;
     int GetNumLODs() const;
     AH<Mesh> GetLODMesh(int lod) const;
-    const Array<AH<Mesh>> GetLODMeshes() const;
+    const Array<AH<Mesh>> &GetLODMeshes() const;
     String GetBoneName(uint boneId) const;
     uint GetBoneId(const String &boneName) const;
 
@@ -157,7 +160,7 @@ public:
     const Array<Vector3> &GetTangentsPool() const;
     const Map<String, uint> &GetBonesIds() const;
     const Map<String, Mesh::Bone> &GetBonesPool() const;
-    const Path &GetModelFilepath() const;
+    Path GetModelFilepath() const;
 
     UMap<Mesh::VertexId, Array<Mesh::TriangleId>> GetVertexIdsToTriangleIds()
         const;
@@ -173,8 +176,12 @@ public:
     virtual void ExportMeta(MetaNode *metaNode) const override;
 
 private:
-    bool m_areLodsValid = false;
-    Array<AH<Mesh>> m_lodMeshes;
+    struct LODsGenerationTask;
+
+    // LODs are swapped in lazily once their background generation finishes
+    mutable bool m_areLodsValid = false;
+    mutable Array<AH<Mesh>> m_lodMeshes;
+    mutable std::shared_ptr<LODsGenerationTask> m_lodsGenerationTask;
     Array<Vector3> m_positionsPool;
     Array<Vector3> m_normalsPool;
     Array<Vector2> m_uvsPool;
@@ -202,6 +209,10 @@ private:
     AABox m_bBox;
     Sphere m_bSphere;
 
+    void RetrieveGeneratedLODsIfReady() const;
+    static bool TryStartLODsGenerationTask(
+        const std::shared_ptr<LODsGenerationTask> &task);
+
     Mesh();
     virtual ~Mesh() override;
 };
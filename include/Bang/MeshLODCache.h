@@ -0,0 +1,44 @@
+#ifndef MESHLODCACHE_H
+#define MESHLODCACHE_H
+
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/GUID.h"
+#include "Bang/Hash.h"
+#include "Bang/MeshSimplifier.h"
+#include "Bang/Path.h"
+
+namespace Bang
+{
+// Persists generated mesh LODs in a hidden binary file next to the model
+// file (and its meta), one per mesh, keyed by the hash of the source mesh
+// contents. Writing an entry removes the outdated entries of that mesh.
+class MeshLODCache
+{
+public:
+    static Hash::HashType GetMeshDataHash(
+        const MeshSimplifier::MeshData &meshData,
+        MeshSimplifier::SimplificationMethod simplificationMethod);
+
+    static Path GetCacheFilepath(const Path &modelFilepath,
+                                 GUID::GUIDType meshEmbeddedGUID,
+                                 Hash::HashType meshDataHash);
+
+    static bool Read(const Path &cacheFilepath,
+                     Hash::HashType meshDataHash,
+                     Array<MeshSimplifier::LODData> *lodsData);
+    static bool Write(const Path &cacheFilepath,
+                      Hash::HashType meshDataHash,
+                      const Array<MeshSimplifier::LODData> &lodsData);
+
+    static String GetCacheExtension();
+
+    MeshLODCache() = delete;
+
+private:
+    static constexpr uint CacheMagic = 0x444F4C42;  // "BLOD"
+    static constexpr uint CacheVersion = 2;
+};
+}  // namespace Bang
+
+#endif  // MESHLODCACHE_H
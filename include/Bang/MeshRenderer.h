@@ -5,19 +5,23 @@
 #include "Bang/AssetHandle.h"
 #include "Bang/BangDefines.h"
 #include "Bang/ComponentMacros.h"
+#include "Bang/EventListener.h"
+#include "Bang/IEventsDestroy.h"
 #include "Bang/MetaNode.h"
 #include "Bang/Renderer.h"
 #include "Bang/String.h"
+#include "Bang/UMap.h"
 
 namespace Bang
 {
+class Camera;
 class ICloneable;
 class Mesh;
 class Ray;
 class ShaderProgram;
 class Texture2D;
 
-class MeshRenderer : public Renderer
+class MeshRenderer : public Renderer, public EventListener<IEventsDestroy>
 {
     COMPONENT(MeshRenderer)
 
@@ -33,6 +37,8 @@ public:
     bool GetAutoLOD() const;
     int GetCurrentLOD() const;
     Mesh *GetCurrentLODActiveMesh() const;
+    float GetScreenCoverage(Camera *camera) const;
+    int SelectAutoLOD(Camera *camera);
 
     void IntersectRay(const Ray &ray,
                       bool *outIntersected = nullptr,
@@ -48,6 +54,9 @@ public:
     virtual void SetUniformsOnBind(ShaderProgram *sp) override;
     virtual AABox GetAABBox() const override;
 
+    // IEventsDestroy
+    virtual void OnDestroyed(EventEmitter<IEventsDestroy> *object) override;
+
     // Serializable
     virtual void Reflect() override;
 
@@ -58,6 +67,10 @@ protected:
     bool m_autoLOD = false;
     int m_currentLOD = 0;
 
+    // Last auto LOD selected for each camera, used for hysteresis. Entries
+    // are removed when their camera is destroyed
+    UMap<const Camera *, int> m_camerasAutoLODs;
+
     void IntersectRay_(const Ray &ray,
                        Texture2D *textureToFilterBy = nullptr,
                        bool *outIntersected = nullptr,
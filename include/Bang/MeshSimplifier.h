@@ -1,6 +1,9 @@
 #ifndef MESHSIMPLIFIER_H
 #define MESHSIMPLIFIER_H
 
+#include <array>
+
+#include "Bang/AABox.h"
 #include "Bang/Array.h"
 #include "Bang/BangDefines.h"
 #include "Bang/Mesh.h"
@@ -34,10 +37,45 @@ public:
                                      float smoothFactor,
                                      uint steps = 2);
 
+    // CPU-only copy of the mesh data the simplification works on, so that
+    // LODs can be generated outside of the main (GL) thread.
+    struct MeshData
+    {
+        AABox aaBox;
+        Array<Vector3> positions;
+        Array<Vector3> normals;
+        Array<Vector2> uvs;
+        Array<Vector3> tangents;
+        Array<Mesh::VertexId> triangleVertexIds;
+
+        uint GetNumTriangles() const;
+        std::array<Mesh::VertexId, 3> GetVertexIdsFromTriangle(
+            Mesh::TriangleId triId) const;
+    };
+
+    // Resulting data of one level of detail
+    struct LODData
+    {
+        Array<Vector3> positions;
+        Array<Vector3> normals;
+        Array<Vector2> uvs;
+        Array<Vector3> tangents;
+        Array<Mesh::VertexId> triangleVertexIds;
+    };
+
     static Array<AH<Mesh>> GetAllMeshLODs(
         const Mesh *mesh,
         SimplificationMethod simplificationMethod);
 
+    // Thread-safe, does not touch GL nor Assets. Returned LODs go from most
+    // detailed to coarsest, the original mesh itself not being included.
+    static Array<LODData> GetAllMeshLODsData(
+        const MeshData &meshData,
+        SimplificationMethod simplificationMethod);
+
+    static MeshData GetMeshData(const Mesh *mesh);
+    static AH<Mesh> CreateMeshFromLODData(const LODData &lodData);
+
     MeshSimplifier() = delete;
 
 private:
@@ -51,7 +89,7 @@ private:
     using VertexCluster = UMap<Mesh::VertexId, VertexData>;
 
     static VertexData GetVertexRepresentativeForCluster(
-        const Mesh &mesh,
+        const MeshData &meshData,
         const VertexCluster &vertexCluster,
         const UMap<Mesh::VertexId, Array<Mesh::TriangleId>>
             &vertexIdxsToTriIdxs,
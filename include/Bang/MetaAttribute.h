@@ -1,8 +1,13 @@
 #ifndef METAATTRIBUTE_H
 #define METAATTRIBUTE_H
 
+#include <cstddef>
+#include <cstring>
 #include <ostream>
+#include <type_traits>
 
+#include "Bang/Array.h"
+#include "Bang/Array.tcc"
 #include "Bang/BangDefines.h"
 #include "Bang/IToString.h"
 #include "Bang/Path.h"
@@ -10,6 +15,59 @@
 
 namespace Bang
 {
+class Color;
+
+enum class MetaValueType
+{
+    STRING,
+    INT,
+    UINT,
+    FLOAT,
+    DOUBLE,
+    VECTOR2,
+    VECTOR3,
+    VECTOR4,
+    VECTOR2i,
+    VECTOR3i,
+    VECTOR4i,
+    QUATERNION,
+    COLOR
+};
+
+// Types whose values (and arrays) are kept as raw bytes, so that binary meta
+// files store them natively and reading them back does not parse strings.
+// Everything else is stored as a string
+template <class T>
+struct MetaNativeType
+{
+    static constexpr MetaValueType Type = MetaValueType::STRING;
+};
+
+#define BANG_META_NATIVE_TYPE(T, MetaType)                    \
+    template <>                                               \
+    struct MetaNativeType<T>                                  \
+    {                                                         \
+        static constexpr MetaValueType Type = MetaType;       \
+    };
+BANG_META_NATIVE_TYPE(int, MetaValueType::INT)
+BANG_META_NATIVE_TYPE(uint, MetaValueType::UINT)
+BANG_META_NATIVE_TYPE(float, MetaValueType::FLOAT)
+BANG_META_NATIVE_TYPE(double, MetaValueType::DOUBLE)
+BANG_META_NATIVE_TYPE(Vector2, MetaValueType::VECTOR2)
+BANG_META_NATIVE_TYPE(Vector3, MetaValueType::VECTOR3)
+BANG_META_NATIVE_TYPE(Vector4, MetaValueType::VECTOR4)
+BANG_META_NATIVE_TYPE(Vector2i, MetaValueType::VECTOR2i)
+BANG_META_NATIVE_TYPE(Vector3i, MetaValueType::VECTOR3i)
+BANG_META_NATIVE_TYPE(Vector4i, MetaValueType::VECTOR4i)
+BANG_META_NATIVE_TYPE(Quaternion, MetaValueType::QUATERNION)
+BANG_META_NATIVE_TYPE(Color, MetaValueType::COLOR)
+#undef BANG_META_NATIVE_TYPE
+
+template <class T>
+using IsMetaNativeType =
+    std::integral_constant<bool,
+                           MetaNativeType<T>::Type != MetaValueType::STRING>;
+
 class MetaAttribute : public IToString
 {
 public:
@@ -24,24 +82,63 @@ public:
     void SetValue(const String &value);
     const String &GetStringValue() const;
 
+    // Native values. An array holds numElements values, a single value holds
+    // one. The string value of native values is only built when asked for
+    void SetNativeValue(MetaValueType type,
+                        const Byte *bytes,
+                        std::size_t numElements,
+                        bool isArray);
+    MetaValueType GetType() const;
+    bool IsNative() const;
+    bool IsArray() const;
+    std::size_t GetNumElements() const;
+    const Array<Byte> &GetNativeBytes() const;
+    String GetElementStringValue(uint elementIndex) const;
+    static uint GetNativeTypeSize(MetaValueType type);
+
     String ToString() const;
     static MetaAttribute FromString(const String &string);
 
     template <class T>
     void Set(const String &name, const T &value)
     {
-        std::ostringstream oss;
-        oss << value;
-        Set(name, String(oss.str()));
+        SetName(name);
+        SetValue_<T>(value, IsMetaNativeType<T>());
     }
 
     template <class T>
     T Get() const
     {
-        T t;
-        std::istringstream iss(GetStringValue());
-        iss >> t;
-        return t;
+        return Get_<T>(IsMetaNativeType<T>());
+    }
+
+    template <class T>
+    void SetArray(const String &name, const Array<T> &array)
+    {
+        static_assert(IsMetaNativeType<T>::value, "Non native array type");
+        SetName(name);
+        SetNativeValue(MetaNativeType<T>::Type,
+                       RCAST<const Byte *>(array.Data()),
+                       array.Size(),
+                       true);
+    }
+
+    template <class T>
+    bool GetArray(Array<T> *array) const
+    {
+        static_assert(IsMetaNativeType<T>::value, "Non native array type");
+        if (!IsArray() || GetType() != MetaNativeType<T>::Type)
+        {
+            return false;
+        }
+        array->Resize(GetNumElements());
+        if (GetNumElements() > 0)
+        {
+            std::memcpy(array->Data(),
+                        GetNativeBytes().Data(),
+                        sizeof(T) * array->Size());
+        }
+        return true;
     }
 
     bool operator==(const MetaAttribute &rhs) const;
@@ -49,7 +146,49 @@ public:
 
 protected:
     String m_name = "";
-    String m_value = "";
+    mutable String m_value = "";
+    mutable bool m_valueStringOutdated = false;
+
+    MetaValueType m_type = MetaValueType::STRING;
+    bool m_isArray = false;
+    std::size_t m_numElements = 0;
+    Array<Byte> m_nativeBytes;
+
+    template <class T>
+    void SetValue_(const T &value, std::true_type)
+    {
+        SetNativeValue(
+            MetaNativeType<T>::Type, RCAST<const Byte *>(&value), 1, false);
+    }
+
+    template <class T>
+    void SetValue_(const T &value, std::false_type)
+    {
+        std::ostringstream oss;
+        oss << value;
+        SetValue(String(oss.str()));
+    }
+
+    template <class T>
+    T Get_(std::true_type) const
+    {
+        if (GetType() == MetaNativeType<T>::Type && !IsArray())
+        {
+            T t;
+            std::memcpy(&t, GetNativeBytes().Data(), sizeof(T));
+            return t;
+        }
+        return Get_<T>(std::false_type());
+    }
+
+    template <class T>
+    T Get_(std::false_type) const
+    {
+        T t;
+        std::istringstream iss(GetStringValue());
+        iss >> t;
+        return t;
+    }
 };
 
 template <>
@@ -8,6 +8,7 @@
 #include "Bang/GUID.h"
 #include "Bang/GUIDManager.h"
 #include "Bang/Map.h"
+#include "Bang/MetaNode.h"
 #include "Bang/Path.h"
 #include "Bang/String.h"
 
@@ -38,7 +39,14 @@ public:
 
     static void OnFilepathRenamed(const Path &oldPath, const Path &newPath);
 
+    // Format of the meta files created from now on. Existing meta files keep
+    // theirs when they are re-exported, unless they are converted
+    static void SetMetaFormat(MetaFormat metaFormat);
+    static MetaFormat GetMetaFormat();
+    static void ConvertMetaFiles(const Path &directory, MetaFormat metaFormat);
+
 private:
+    MetaFormat m_metaFormat = MetaFormat::YAML;
     Map<GUID, Path> m_GUIDToFilepath;
     Map<Path, GUID> m_filepathToGUID;
 
@@ -2,6 +2,7 @@
 #define METANODE_H
 
 #include <functional>
+#include <type_traits>
 
 #include "Bang/Array.h"
 #include "Bang/Array.tcc"
@@ -10,6 +11,7 @@
 #include "Bang/MetaAttribute.h"
 #include "Bang/StreamOperators.h"
 #include "Bang/String.h"
+#include "Bang/UMap.h"
 
 namespace YAML
 {
@@ -21,6 +23,12 @@ namespace Bang
 {
 class Path;
 
+enum class MetaFormat
+{
+    YAML,
+    BINARY
+};
+
 class MetaNode
 {
 public:
@@ -65,6 +73,8 @@ public:
     void SetName(const String name);
     String ToString() const;
     void ToString(YAML::Emitter &out) const;
+    void ToBinary(Array<Byte> *bytes) const;
+    void ExportToFile(const Path &filepath, MetaFormat format) const;
 
     const String &GetName() const;
     const Map<String, MetaAttribute> &GetAttributes() const;
@@ -77,6 +87,10 @@ public:
     void Import(const String &metaString);
     void Import(const YAML::Node &yamlNode);
     void Import(const Path &filepath);
+    bool ImportBinary(const Array<Byte> &bytes);
+
+    static bool IsBinary(const Array<Byte> &bytes);
+    static MetaFormat GetFileFormat(const Path &filepath);
 
     bool operator==(const MetaNode &rhs) const;
     bool operator!=(const MetaNode &rhs) const;
@@ -86,7 +100,33 @@ private:
     mutable Map<String, Array<MetaNode>> m_children;
     mutable Map<String, MetaAttribute> m_attributes;
 
+    static constexpr uint BinaryMagic = 0x4154454D;  // "META"
+    static constexpr uint BinaryVersion = 2;
+
+    // Native arrays are kept in a single attribute. Other arrays (and every
+    // array in YAML) are flattened into "name_i" attributes
+    template <class T>
+    void SetArray_(const String &name, const Array<T> &array, std::true_type);
+    template <class T>
+    void SetArray_(const String &name,
+                   const Array<T> &array,
+                   std::false_type);
+    template <class T>
+    Array<T> GetArray_(const String &attributeName, std::true_type) const;
+    template <class T>
+    Array<T> GetArray_(const String &attributeName, std::false_type) const;
+
+    // Removes an array in any of the two forms, so that setting it again
+    // does not leave old elements behind
+    void RemoveArray(const String &name);
+
     void ToStringInner(YAML::Emitter &out) const;
+    void ToBinaryInner(Array<Byte> *bytes,
+                       UMap<String, uint> *stringIds,
+                       Array<String> *strings) const;
+    bool ImportBinaryInner(const Array<Byte> &bytes,
+                           std::size_t *offset,
+                           const Array<String> &strings);
 };
 }
 
@@ -15,6 +15,25 @@ void MetaNode::Set(const String &attributeName, const T &value)
 template <class T>
 void MetaNode::SetArray(const String &name, const Array<T> &array)
 {
+    SetArray_(name, array, IsMetaNativeType<T>());
+}
+
+template <class T>
+void MetaNode::SetArray_(const String &name,
+                         const Array<T> &array,
+                         std::true_type)
+{
+    MetaAttribute attr;
+    attr.SetArray<T>(name, array);
+    Set(attr);
+}
+
+template <class T>
+void MetaNode::SetArray_(const String &name,
+                         const Array<T> &array,
+                         std::false_type)
+{
+    RemoveArray(name);
     for (uint i = 0; i < array.Size(); ++i)
     {
         const T &x = array[i];
@@ -31,6 +50,27 @@ T MetaNode::Get(const String &attributeName, const T &defaultValue) const
 
 template <class T>
 Array<T> MetaNode::GetArray(const String &attributeName) const
+{
+    return GetArray_<T>(attributeName, IsMetaNativeType<T>());
+}
+
+template <class T>
+Array<T> MetaNode::GetArray_(const String &attributeName, std::true_type) const
+{
+    Array<T> result;
+    MetaAttribute *attr = GetAttribute(attributeName);
+    if (attr && attr->GetArray<T>(&result))
+    {
+        return result;
+    }
+
+    // Arrays imported from YAML are flattened
+    return GetArray_<T>(attributeName, std::false_type());
+}
+
+template <class T>
+Array<T> MetaNode::GetArray_(const String &attributeName,
+                             std::false_type) const
 {
     int i = 0;
     Array<T> result;
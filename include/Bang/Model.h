@@ -1,6 +1,8 @@
 #ifndef MODEL_H
 #define MODEL_H
 
+#include <memory>
+
 #include "Bang/Asset.h"
 #include "Bang/BangDefines.h"
 #include "Bang/Map.h"
@@ -41,6 +43,9 @@ public:
 
     // Asset
     void Import(const Path &modelFilepath) override;
+    void PreImport(const Path &modelFilepath) override;
+    void LoadDependenciesAsync(
+        Array<std::shared_ptr<AssetLoadRequest>> *dependencies) override;
 
     // Serializable
     virtual void ImportMeta(const MetaNode &metaNode) override;
@@ -48,6 +53,11 @@ public:
 
 private:
     ModelIOScene m_modelScene;
+
+    // Filled by PreImport, and consumed by the next Import
+    ModelIOData m_preImportedModelData;
+    Array<Path> m_preImportedTexturesFilepaths;
+    bool m_hasPreImportedModelData = false;
 };
 }
 
@@ -0,0 +1,39 @@
+#ifndef MODELCACHE_H
+#define MODELCACHE_H
+
+#include "Bang/BangDefines.h"
+#include "Bang/Hash.h"
+#include "Bang/ModelIO.h"
+#include "Bang/Path.h"
+
+namespace Bang
+{
+// Persists the data read from a model file (meshes, materials, animations
+// and node hierarchy) in a hidden binary file next to the model, keyed by
+// the hash of the model file contents. Reading it back is a single file read
+// plus bulk copies, so Assimp and its post-processing are skipped entirely.
+// Writing an entry removes the outdated entries of that model.
+class ModelCache
+{
+public:
+    static Path GetCacheFilepath(const Path &modelFilepath,
+                                 Hash::HashType modelFileHash);
+
+    static bool Read(const Path &cacheFilepath,
+                     Hash::HashType modelFileHash,
+                     ModelIOData *modelData);
+    static bool Write(const Path &cacheFilepath,
+                      Hash::HashType modelFileHash,
+                      const ModelIOData &modelData);
+
+    static String GetCacheExtension();
+
+    ModelCache() = delete;
+
+private:
+    static constexpr uint CacheMagic = 0x4C444D42;  // "BMDL"
+    static constexpr uint CacheVersion = 1;
+};
+}  // namespace Bang
+
+#endif  // MODELCACHE_H
@@ -3,16 +3,19 @@
 
 #include <functional>
 
+#include "Bang/Animation.h"
 #include "Bang/Array.h"
 #include "Bang/Array.tcc"
 #include "Bang/AssetHandle.h"
 #include "Bang/BangDefines.h"
+#include "Bang/Color.h"
 #include "Bang/Map.h"
 #include "Bang/Map.tcc"
 #include "Bang/Matrix4.tcc"
 #include "Bang/Mesh.h"
 #include "Bang/String.h"
 
+struct aiAnimation;
 struct aiMaterial;
 struct aiMesh;
 struct aiNode;
@@ -42,6 +45,58 @@ struct ModelIONode
     Array<uint> meshMaterialIndices;  // Which material does each mesh have
 };
 
+// Plain data read from a model file (or from its compiled cache), before
+// any asset is created from it
+struct ModelIOMeshData
+{
+    String name;
+    Array<Mesh::VertexId> triangleVertexIds;
+    Array<Vector3> positions;
+    Array<Vector3> normals;
+    Array<Vector2> uvs;
+    Array<Vector3> tangents;
+    Map<String, Mesh::Bone> bones;
+    Map<String, uint> bonesIds;
+};
+
+struct ModelIOMaterialData
+{
+    String name;
+    Color albedoColor = Color::White();
+
+    // Relative to the model directory
+    String albedoTexturePath;
+    String normalMapTexturePath;
+};
+
+struct ModelIOAnimationChannel
+{
+    String boneName;
+    Array<Animation::KeyFrame<Vector3>> positionKeyFrames;
+    Array<Animation::KeyFrame<Quaternion>> rotationKeyFrames;
+    Array<Animation::KeyFrame<Vector3>> scaleKeyFrames;
+};
+
+struct ModelIOAnimationData
+{
+    String name;
+    float durationInFrames = 0.0f;
+    float framesPerSecond = 0.0f;
+    Array<ModelIOAnimationChannel> channels;
+};
+
+struct ModelIOData
+{
+    Array<ModelIOMeshData> meshes;
+    Array<ModelIOMaterialData> materials;
+    Array<ModelIOAnimationData> animations;
+
+    // Nodes in depth-first order, with the index of their parent (-1 for
+    // the root)
+    Array<ModelIONode> nodes;
+    Array<int> nodesParentIndices;
+};
+
 struct ModelIOScene
 {
     Array<AH<Mesh>> meshes;
@@ -69,6 +124,22 @@ public:
                             Model *model,
                             ModelIOScene *modelScene);
 
+    // Same, but creating the assets from an already read model
+    static void ImportModel(const Path &modelFilepath,
+                            const ModelIOData &modelData,
+                            Model *model,
+                            ModelIOScene *modelScene);
+
+    // Only reads the model into plain data. It is read from the compiled
+    // model cache when it is up to date, and otherwise with Assimp (writing
+    // the cache afterwards). It does not create any asset, so it can be
+    // called from any thread.
+    static bool ReadModel(const Path &modelFilepath, ModelIOData *modelData);
+
+    static void GetTexturesFilepaths(const Path &modelFilepath,
+                                     const ModelIOData &modelData,
+                                     Array<Path> *texturesFilepaths);
+
     static void ImportMeshRaw(aiMesh *aMesh,
                               Array<Mesh::VertexId> *vertexIndices,
                               Array<Vector3> *vertexPositionsPool,
@@ -92,15 +163,31 @@ private:
     static const aiScene *ImportScene(Assimp::Importer *importer,
                                       const Path &modelFilepath);
 
-    static void ImportEmbeddedMesh(aiMesh *aMesh,
+    static void ReadScene(const aiScene *aScene, ModelIOData *modelData);
+    static void ReadMesh(aiMesh *aMesh, ModelIOMeshData *meshData);
+    static void ReadMaterial(aiMaterial *aMaterial,
+                             ModelIOMaterialData *materialData);
+    static void ReadAnimation(aiAnimation *aAnimation,
+                              ModelIOAnimationData *animationData);
+    static void ReadNode(const aiScene *aScene,
+                         aiNode *aNode,
+                         int parentIndex,
+                         ModelIOData *modelData);
+
+    static void ImportEmbeddedMesh(const ModelIOMeshData &meshData,
                                    Model *model,
                                    AH<Mesh> *outMesh,
                                    String *outMeshName);
-    static void ImportEmbeddedMaterial(aiMaterial *aMaterial,
+    static void ImportEmbeddedMaterial(const ModelIOMaterialData &materialData,
                                        const Path &modelDirectory,
                                        Model *model,
                                        AH<Material> *outMaterial,
                                        String *outMaterialName);
+    static void ImportEmbeddedAnimation(
+        const ModelIOAnimationData &animationData,
+        Model *model,
+        AH<Animation> *outAnimation,
+        String *outAnimationName);
 };
 }  // namespace Bang
 
@@ -1,6 +1,7 @@
 #ifndef MUTEX_H
 #define MUTEX_H
 
+#include <atomic>
 #include <mutex>
 
 #include "Bang/BangDefines.h"
@@ -20,7 +21,7 @@ public:
     bool IsLocked() const;
 
 private:
-    bool m_isLocked = false;
+    std::atomic<bool> m_isLocked;
     std::mutex m_mutex;
 };
 }  // namespace Bang
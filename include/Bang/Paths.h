@@ -43,6 +43,7 @@ public:
     static const Path &GetProjectDir();
     static Path GetProjectAssetsDir();
     static Path GetProjectLibrariesDir();
+    static Path GetProjectCacheDir();
 
     static void SetEngineRoot(const Path &engineRootDir);
 
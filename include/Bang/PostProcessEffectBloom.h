@@ -6,6 +6,7 @@
 namespace Bang
 {
 class Framebuffer;
+class PostProcessEffectToneMapping;
 
 class PostProcessEffectBloom : public PostProcessEffect
 {
@@ -24,6 +25,7 @@ public:
     void SetUseKawaseBlur(bool useKawaseBlur);
     void SetBrightnessThreshold(float brightnessThreshold);
     void SetUseHighBitDepthTextures(bool useHighBitDepthTextures);
+    void SetCompositeInToneMapping(bool compositeInToneMapping);
 
     uint GetDownscale() const;
     float GetIntensity() const;
@@ -33,6 +35,15 @@ public:
     Texture2D *GetFinalBloomTexture() const;
     bool GetUseHighBitDepthTextures() const;
     ShaderProgram *GetBloomShaderProgram() const;
+    bool GetCompositeInToneMapping() const;
+
+    // Tone mapping effect of the same game object that adds the bloom of the
+    // last render in its own pass, instead of this effect having a composite
+    // pass of its own. Null if the bloom was composited by this effect
+    PostProcessEffectToneMapping *GetCompositingToneMapping() const;
+
+    // Gives back the bloom textures of this frame to the RenderTargetPool
+    void ReleaseBloomTextures();
 
     // IReflectable
     void Reflect() override;
@@ -45,11 +56,21 @@ private:
     float m_intensity = 1.0f;
     uint m_blurRadius = 5;
     uint m_downscale = 2;
+    bool m_compositeInToneMapping = true;
 
     AH<ShaderProgram> p_bloomSP;
-    AH<Texture2D> m_brightnessTexture;
-    AH<Texture2D> m_blurredBloomTexture;
-    AH<Texture2D> m_blurAuxiliarTexture;
+
+    // Taken from the RenderTargetPool only while rendering
+    Texture2D *p_brightnessTexture = nullptr;
+    Texture2D *p_blurredBloomTexture = nullptr;
+    Texture2D *p_blurAuxiliarTexture = nullptr;
+
+    PostProcessEffectToneMapping *p_compositingToneMapping = nullptr;
+
+    // The tone mapping can only add the bloom if it renders later in the
+    // same pass, and no other effect changes the color in between (SSAO
+    // darkens it, DOF blurs it...)
+    PostProcessEffectToneMapping *FindCompositingToneMapping() const;
 };
 }
 
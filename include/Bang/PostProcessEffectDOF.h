@@ -23,6 +23,7 @@ public:
     void SetFarDistance(float farDistance);
     void SetFarFadingSize(float farFadingSize);
     void SetBlurRadius(uint blurRadius);
+    void SetDownscale(uint downscale);
 
     float GetNearFadingSlope() const;
     float GetNearDistance() const;
@@ -31,14 +32,13 @@ public:
     float GetFarDistance() const;
     float GetFarFadingSize() const;
     uint GetBlurRadius() const;
+    uint GetDownscale() const;
 
     // IReflectable
     void Reflect() override;
 
 private:
     AH<ShaderProgram> m_dofSP;
-    AH<Texture2D> m_blurredTexture;
-    AH<Texture2D> m_blurAuxiliarTexture;
 
     float m_nearFadingSlope = 1.0f;
     float m_nearFadingSize = 1.0f;
@@ -47,6 +47,7 @@ private:
     float m_farFadingSize = 5.0f;
     float m_farDistance = 10.0f;
     uint m_blurRadius = 3;
+    uint m_downscale = 2;
 };
 }
 
@@ -33,6 +33,7 @@ public:
     void SetSeparable(bool separable);
     void SetBilateralBlurEnabled(bool bilateralBlurEnabled);
     void SetFBSize(const Vector2 &fbSize);
+    void SetDownscale(uint downscale);
 
     bool GetSeparable() const;
     int GetBlurRadius() const;
@@ -42,6 +43,7 @@ public:
     int GetNumRandomAxes() const;
     bool GetBilateralBlurEnabled() const;
     const Vector2 &GetFBSize() const;
+    uint GetDownscale() const;
     Texture2D *GetSSAOTexture() const;
 
     // IReflectable
@@ -55,12 +57,12 @@ private:
     bool m_separable = true;
     int m_numRandomOffsetsHemisphere = -1;
     Vector2 m_fbSize = Vector2::One();
+    uint m_downscale = 2;
 
     Array<Vector3> m_randomHemisphereOffsets;
     AH<Texture2D> m_randomAxesTexture;
 
     Framebuffer *m_ssaoFB = nullptr;
-    AH<Texture2D> m_blurAuxiliarTexture;
     AH<Texture2D> m_blurredSSAOTexture;
     AH<ShaderProgram> p_ssaoShaderProgram;
     AH<ShaderProgram> p_applySSAOShaderProgram;
@@ -33,6 +33,14 @@ public:
 private:
     String m_gameObjectMetaInfoContent = "";
 
+    // GameObject imported once from the meta content, out of any scene. The
+    // instances are cloned from it, so that they do not need to parse the
+    // meta content every time.
+    mutable GameObject *p_templateGameObject = nullptr;
+
+    GameObject *GetTemplateGameObject() const;
+    void InvalidateTemplateGameObject();
+
     Prefab();
     Prefab(GameObject *go);
     Prefab(const String &gameObjectMetaInfoContent);
@@ -25,6 +25,13 @@ public:
     virtual Project *OpenProject(const Path &projectFilepath);
     virtual bool CloseCurrentProject();
 
+    // When enabled, opening a project links all the shader programs and
+    // their variants before its initial scene (see
+    // ShaderProgramFactory::WarmUpBinaryCache), so that a build step or the
+    // first run fills the shader binary cache of the project
+    void SetWarmUpShaderBinaryCacheOnOpen(bool warmUp);
+    bool GetWarmUpShaderBinaryCacheOnOpen() const;
+
     Project *GetCurrentProject() const;
     static ProjectManager *GetInstance();
 
@@ -34,6 +41,7 @@ protected:
 
 private:
     Project *m_currentProject = nullptr;
+    bool m_warmUpShaderBinaryCacheOnOpen = false;
 };
 }
 
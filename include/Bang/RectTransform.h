@@ -123,6 +123,10 @@ public:
     const Matrix4 &GetRectLocalToWorldMatrix() const;
     const Matrix4 &GetRectLocalToWorldMatrixInv() const;
 
+    // IEventsTransform
+    void OnTransformChanged() override;
+    void OnParentTransformChanged() override;
+
     // IEventsObject
     void OnEnabled(Object *object) override;
     void OnDisabled(Object *object) override;
@@ -147,7 +151,12 @@ private:
     Vector2 m_anchorMin = -Vector2::One();
     Vector2 m_anchorMax = Vector2::One();
 
+    // Whether the change being notified was propagated from an ancestor,
+    // whose focus indices invalidation already covered this one
+    bool m_propagatedTransformChange = false;
+
     void WarnWrongAnchorsIfNeeded();
+    void OnEnabledChanged(Object *object);
 
     // Transform
     void CalculateLocalToParentMatrix() const override;
@@ -3,6 +3,7 @@
 
 #include <array>
 
+#include "Bang/Array.h"
 #include "Bang/AssetHandle.h"
 #include "Bang/BangDefines.h"
 #include "Bang/Camera.h"
@@ -10,9 +11,12 @@
 #include "Bang/Component.h"
 #include "Bang/ComponentMacros.h"
 #include "Bang/GL.h"
+#include "Bang/Hash.h"
 #include "Bang/MetaNode.h"
+#include "Bang/Path.h"
 #include "Bang/String.h"
 #include "Bang/Time.h"
+#include "Bang/Vector3.h"
 
 namespace Bang
 {
@@ -20,6 +24,7 @@ class Framebuffer;
 class ICloneable;
 class Renderer;
 class ShaderProgram;
+class Texture2D;
 class TextureCubeMap;
 
 class ReflectionProbe : public Component
@@ -30,8 +35,19 @@ public:
     ReflectionProbe();
     virtual ~ReflectionProbe() override;
 
+    // Renders all the update steps at once (finishing the one in progress)
     void RenderReflectionProbe(bool force = false);
 
+    // Time-sliced update. The capture is split in steps (the 6 faces, the
+    // cube map fill, and the diffuse and specular IBL mip levels), and at
+    // most maxSteps of them are rendered. Returns the used steps
+    uint RenderReflectionProbeSteps(uint maxSteps);
+    bool IsUpdateInProgress() const;
+
+    // Static probes are baked once and cached to disk. Rebake discards the
+    // cached capture, so that it is captured again in the next render
+    void Rebake();
+
     void SetCamerasClearColor(const Color &clearColor);
     void SetCamerasSkyBoxTexture(TextureCubeMap *skybox);
     void SetCamerasClearMode(CameraClearMode clearMode);
@@ -42,8 +58,10 @@ public:
     void SetIsBoxed(bool isBoxed);
     void SetFilterForIBL(bool filterForIBL);
     void SetRestTimeSeconds(double restTimeSeconds);
+    void SetIsStatic(bool isStatic);
 
     bool GetIsBoxed() const;
+    bool GetIsStatic() const;
     int GetRenderSize() const;
     bool GetFilterForIBL() const;
     const Vector3 &GetSize() const;
@@ -73,7 +91,30 @@ public:
     virtual void ExportMeta(MetaNode *metaNode) const override;
 
 private:
+    static constexpr uint DiffuseIBLSize = 16;
+    static constexpr uint DiffuseIBLSampleCount = 10;
+    static constexpr uint SpecularIBLSize = 128;
+    static constexpr uint SpecularIBLSampleCount = 64;
+    static constexpr uint BakeCacheMagic = 0x424F5250;  // "PROB"
+    static constexpr uint BakeCacheVersion = 2;
+
+    struct BakeCacheHeader
+    {
+        uint magic = 0;
+        uint version = 0;
+        uint renderSize = 0;
+        uint filterForIBL = 0;
+        uint diffuseIBLSize = 0;
+        uint specularIBLSize = 0;
+        Hash::HashType sceneGeometryHash = 0;
+        Vector3 position = Vector3::Zero();
+
+        bool operator!=(const BakeCacheHeader &rhs) const;
+    };
+
     bool m_isBoxed = false;
+    bool m_isStatic = false;
+    bool m_isBaked = false;
     bool m_filterForIBL = true;
     Vector3 m_size = Vector3::One();
     Time m_restTime;
@@ -86,12 +127,33 @@ private:
     AH<TextureCubeMap> m_camerasSkyBoxTexture;
 
     Time m_lastRenderTime;
+    bool m_hasBeenRendered = false;
+    bool m_updateInProgress = false;
+    uint m_updateStep = 0;
+    std::array<Texture2D *, 6> m_faceTextures;
     std::array<Camera *, 6> m_cameras;
     Framebuffer *m_textureCubeMapFB = nullptr;
     AH<TextureCubeMap> p_textureCubeMapWithoutFiltering;
     AH<TextureCubeMap> p_textureCubeMapDiffuse;
     AH<TextureCubeMap> p_textureCubeMapSpecular;
 
+    uint GetNumUpdateSteps() const;
+    void RenderUpdateStep(uint updateStep);
+    void RenderFace(uint faceIndex);
+    void FillCubeMapFromFaces();
+    void ReleaseFaceTextures();
+
+    Path GetBakeCachePath() const;
+    bool LoadBakeFromCache();
+    void SaveBakeToCache() const;
+    BakeCacheHeader GetBakeCacheHeader() const;
+    Hash::HashType GetSceneGeometryHash() const;
+    Array<TextureCubeMap *> GetBakedCubeMaps() const;
+    uint GetNumMipMaps(const TextureCubeMap *cubeMap) const;
+    std::size_t GetCubeMapBytesSize(const TextureCubeMap *cubeMap) const;
+    static std::size_t GetFaceBytesSize(const TextureCubeMap *cubeMap,
+                                        uint mipMapLevel);
+
     static ReflectionProbe *GetClosestReflectionProbe(Renderer *renderer);
 };
 }
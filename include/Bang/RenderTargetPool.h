@@ -0,0 +1,110 @@
+#ifndef RENDERTARGETPOOL_H
+#define RENDERTARGETPOOL_H
+
+#include <cstdint>
+
+#include "Bang/Array.h"
+#include "Bang/AssetHandle.h"
+#include "Bang/BangDefines.h"
+#include "Bang/GL.h"
+#include "Bang/String.h"
+#include "Bang/UMap.h"
+#include "Bang/Vector2.h"
+
+namespace Bang
+{
+class GBuffer;
+class Texture2D;
+
+struct RenderTargetDesc
+{
+    Vector2i size = Vector2i::One();
+    GL::ColorFormat format = GL::ColorFormat::RGBA8;
+    GL::FilterMode filterMode = GL::FilterMode::BILINEAR;
+    GL::WrapMode wrapMode = GL::WrapMode::CLAMP_TO_EDGE;
+
+    RenderTargetDesc() = default;
+    RenderTargetDesc(const Vector2i &size,
+                     GL::ColorFormat format,
+                     GL::FilterMode filterMode = GL::FilterMode::BILINEAR,
+                     GL::WrapMode wrapMode = GL::WrapMode::CLAMP_TO_EDGE);
+};
+
+struct RenderTargetMemoryEntry
+{
+    String owner;
+    uint numTargets = 0;
+    uint64_t bytes = 0;
+};
+
+// Frame-scoped allocator of render targets. Passes acquire textures (or
+// whole GBuffers) matching a descriptor, and release them once they are
+// done. Released targets are handed to the next pass asking for the same
+// descriptor, so passes that do not overlap in time share the same memory.
+// Targets that have not been used for a while are destroyed in EndFrame.
+class RenderTargetPool
+{
+public:
+    RenderTargetPool();
+    ~RenderTargetPool();
+
+    Texture2D *Acquire(const RenderTargetDesc &desc, const String &owner);
+    void Release(Texture2D *renderTarget);
+
+    GBuffer *AcquireGBuffer(const Vector2i &size, const String &owner);
+    void ReleaseGBuffer(GBuffer *gbuffer);
+
+    // Persistent GBuffers (the ones owned by cameras) are not pooled, but
+    // are tracked so that they show up in the memory report
+    void RegisterPersistentGBuffer(const GBuffer *gbuffer, const String &owner);
+    void UnRegisterPersistentGBuffer(const GBuffer *gbuffer);
+
+    void EndFrame();
+    void Clear();
+
+    void SetMaxIdleFrames(uint maxIdleFrames);
+    void SetLogMemoryReport(bool logMemoryReport);
+
+    uint GetMaxIdleFrames() const;
+    bool GetLogMemoryReport() const;
+
+    // GPU memory of every tracked target, grouped by owner. Free pooled
+    // targets are grouped under "Pool (free)"
+    Array<RenderTargetMemoryEntry> GetMemoryReport() const;
+    uint64_t GetTotalBytes() const;
+    String GetMemoryReportString() const;
+
+    static RenderTargetPool *GetInstance();
+
+private:
+    struct PooledTexture
+    {
+        AH<Texture2D> texture;
+        RenderTargetDesc desc;
+        String owner;
+        bool inUse = false;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    struct PooledGBuffer
+    {
+        GBuffer *gbuffer = nullptr;
+        String owner;
+        bool inUse = false;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    Array<PooledTexture> m_pooledTextures;
+    Array<PooledGBuffer> m_pooledGBuffers;
+    UMap<const GBuffer *, String> m_persistentGBuffers;
+    uint64_t m_frame = 0;
+    uint m_maxIdleFrames = 120;
+
+    // When enabled, the memory report is logged in EndFrame every time the
+    // total memory changes (targets created or destroyed)
+    bool m_logMemoryReport = false;
+    uint64_t m_lastLoggedTotalBytes = 0;
+};
+}  // namespace Bang
+
+#endif  // RENDERTARGETPOOL_H
@@ -0,0 +1,59 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+
+namespace Bang
+{
+// Fixed capacity queue, from the oldest element to the newest one. Pushing
+// into a full one drops the oldest element. Dropped and removed slots are
+// reset to T(), so that they do not keep references alive
+template <class T>
+class RingBuffer
+{
+public:
+    RingBuffer();
+    explicit RingBuffer(uint capacity);
+
+    // Clears it too
+    void SetCapacity(uint capacity);
+
+    // Does nothing when the capacity is zero
+    void PushBack(const T &x);
+
+    // Removes the elements for which predicate is true, keeping the order
+    // of the rest. It is called once per element, from the oldest
+    template <class Predicate>
+    void RemoveIf(const Predicate &predicate);
+
+    void Clear();
+
+    // Indices go from the oldest element (0) to the newest one
+    T &At(uint i);
+    const T &At(uint i) const;
+    T &operator[](uint i);
+    const T &operator[](uint i) const;
+
+    T &Front();
+    const T &Front() const;
+    T &Back();
+    const T &Back() const;
+
+    uint Size() const;
+    uint GetCapacity() const;
+    bool IsEmpty() const;
+    bool IsFull() const;
+
+private:
+    Array<T> m_elements;
+    uint m_begin = 0;
+    uint m_size = 0;
+
+    uint GetSlot(uint i) const;
+};
+}  // namespace Bang
+
+#include "Bang/RingBuffer.tcc"
+
+#endif  // RINGBUFFER_H
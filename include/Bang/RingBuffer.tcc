@@ -0,0 +1,163 @@
+#pragma once
+
+#include "Bang/Array.tcc"
+#include "Bang/Assert.h"
+#include "Bang/RingBuffer.h"
+
+namespace Bang
+{
+template <class T>
+RingBuffer<T>::RingBuffer()
+{
+}
+
+template <class T>
+RingBuffer<T>::RingBuffer(uint capacity)
+{
+    SetCapacity(capacity);
+}
+
+template <class T>
+void RingBuffer<T>::SetCapacity(uint capacity)
+{
+    m_elements.Clear();
+    m_elements.Resize(capacity);
+    m_begin = 0;
+    m_size = 0;
+}
+
+template <class T>
+void RingBuffer<T>::PushBack(const T &x)
+{
+    if (GetCapacity() == 0)
+    {
+        return;
+    }
+
+    if (IsFull())
+    {
+        m_elements[m_begin] = T();
+        m_begin = (m_begin + 1) % GetCapacity();
+        --m_size;
+    }
+
+    m_elements[GetSlot(m_size)] = x;
+    ++m_size;
+}
+
+template <class T>
+template <class Predicate>
+void RingBuffer<T>::RemoveIf(const Predicate &predicate)
+{
+    // Compacts the kept ones towards the oldest slot, in place
+    uint numKept = 0;
+    for (uint i = 0; i < m_size; ++i)
+    {
+        T &element = m_elements[GetSlot(i)];
+        if (predicate(element))
+        {
+            element = T();
+            continue;
+        }
+
+        if (numKept != i)
+        {
+            m_elements[GetSlot(numKept)] = element;
+            element = T();
+        }
+        ++numKept;
+    }
+    m_size = numKept;
+}
+
+template <class T>
+void RingBuffer<T>::Clear()
+{
+    for (uint i = 0; i < m_size; ++i)
+    {
+        m_elements[GetSlot(i)] = T();
+    }
+    m_begin = 0;
+    m_size = 0;
+}
+
+template <class T>
+T &RingBuffer<T>::At(uint i)
+{
+    ASSERT(i < m_size);
+    return m_elements[GetSlot(i)];
+}
+
+template <class T>
+const T &RingBuffer<T>::At(uint i) const
+{
+    ASSERT(i < m_size);
+    return m_elements[GetSlot(i)];
+}
+
+template <class T>
+T &RingBuffer<T>::operator[](uint i)
+{
+    return At(i);
+}
+
+template <class T>
+const T &RingBuffer<T>::operator[](uint i) const
+{
+    return At(i);
+}
+
+template <class T>
+T &RingBuffer<T>::Front()
+{
+    return At(0);
+}
+
+template <class T>
+const T &RingBuffer<T>::Front() const
+{
+    return At(0);
+}
+
+template <class T>
+T &RingBuffer<T>::Back()
+{
+    return At(m_size - 1);
+}
+
+template <class T>
+const T &RingBuffer<T>::Back() const
+{
+    return At(m_size - 1);
+}
+
+template <class T>
+uint RingBuffer<T>::Size() const
+{
+    return m_size;
+}
+
+template <class T>
+uint RingBuffer<T>::GetCapacity() const
+{
+    return m_elements.Size();
+}
+
+template <class T>
+bool RingBuffer<T>::IsEmpty() const
+{
+    return (m_size == 0);
+}
+
+template <class T>
+bool RingBuffer<T>::IsFull() const
+{
+    return (m_size == GetCapacity());
+}
+
+template <class T>
+uint RingBuffer<T>::GetSlot(uint i) const
+{
+    return (m_begin + i) % GetCapacity();
+}
+}  // namespace Bang
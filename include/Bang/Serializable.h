@@ -26,6 +26,7 @@ public:
 
     virtual bool ImportMetaFromFile(const Path &path);
     virtual bool ExportMetaToFile(const Path &path) const;
+    bool ExportMetaToFile(const Path &path, MetaFormat format) const;
 
     virtual String GetClassName() const = 0;
 
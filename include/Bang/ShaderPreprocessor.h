@@ -31,6 +31,17 @@ public:
     static ShaderProgramProperties GetShaderProperties(
         const String &sourceCode);
 
+    // Keyword sets of the "#pragma multi_compile A B _" lines of the code,
+    // in order of appearance. "_" stands for none of the set keywords
+    static Array<Array<String>> GetMultiCompileKeywordSets(
+        const String &sourceCode);
+
+    // Adds a "#define KEYWORD" line per keyword, after the #version line
+    static void AddDefines(String *shaderSourceCode,
+                           const Array<String> &keywords);
+
+    static const String NoKeyword;
+
 private:
     static const String GLSLVersionString;
     static Array<String> GetSectionKeywords();
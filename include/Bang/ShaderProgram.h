@@ -2,6 +2,8 @@
 #define SHADERPROGRAM_H
 
 #include <GL/glew.h>
+#include <cstdint>
+#include <functional>
 #include <vector>
 
 #include "Bang/Array.h"
@@ -12,6 +14,7 @@
 #include "Bang/EventListener.h"
 #include "Bang/GL.h"
 #include "Bang/GLObject.h"
+#include "Bang/Hash.h"
 #include "Bang/IEventsAsset.h"
 #include "Bang/IEventsDestroy.h"
 #include "Bang/Matrix3.h"
@@ -20,6 +23,7 @@
 #include "Bang/String.h"
 #include "Bang/Texture3D.h"
 #include "Bang/UMap.h"
+#include "Bang/USet.h"
 
 namespace Bang
 {
@@ -51,6 +55,8 @@ public:
     bool Load(Shader *vShader, Shader *fShader);
     bool Load(Shader *vShader, Shader *gShader, Shader *fShader);
 
+    // Drops the variants too. Unlike Load() and the reimports of the
+    // shaders, it does not tell the listeners (materials keep a variant)
     bool Link();
     bool IsLinked() const;
 
@@ -125,6 +131,26 @@ public:
 
     GLint GetUniformLocation(const String &name) const;
 
+    // Variant of this program with the "#pragma multi_compile" keywords that
+    // are enabled defined. Variants are compiled on demand, the first time
+    // their keyword mask is asked for, and cached by it. Returns this program
+    // when it has no keywords, or when the variant is stripped
+    ShaderProgram *GetVariant(const USet<String> &enabledKeywords);
+    uint64_t GetKeywordsMask(const USet<String> &enabledKeywords) const;
+    const Array<Array<String>> &GetKeywordSets() const;
+    bool IsVariant() const;
+
+    // Keywords of all the permutations of the keyword sets that are not
+    // stripped, one keyword per set ("_" for none)
+    Array<Array<String>> GetVariantsKeywords() const;
+
+    // Returns true for the variants that must not be compiled. Stripped
+    // variants fall back to the program without keywords
+    using VariantStrippingFunction =
+        std::function<bool(const ShaderProgram *, const Array<String> &)>;
+    static void SetVariantStrippingFunction(
+        const VariantStrippingFunction &strippingFunction);
+
     // Serializable
     void Reflect() override;
 
@@ -139,6 +165,14 @@ private:
     ShaderProgramProperties m_loadedProperties;
     bool m_isLinked = false;
 
+    static constexpr uint MaxNumKeywords = 64;
+    static VariantStrippingFunction s_variantStrippingFunction;
+    bool m_isVariant = false;
+    Hash::HashType m_variantIdentityHash = 0;
+    Array<Array<String>> m_keywordSets;
+    Array<String> m_keywords;
+    UMap<uint64_t, AH<ShaderProgram>> m_variants;
+
     UMap<String, int> m_uniformCacheInt;
     UMap<String, bool> m_uniformCacheBool;
     UMap<String, float> m_uniformCacheFloat;
@@ -170,6 +204,12 @@ private:
     bool SetDefaultTextureCubeMap(const String &name, bool warn = true);
     bool SetTexture(const String &name, Texture *texture, bool warn = true);
 
+    void GatherKeywordSets();
+    bool IsVariantStripped(const Array<String> &variantKeywords) const;
+    AH<ShaderProgram> CreateVariant(const Array<String> &variantKeywords);
+    Hash::HashType GetBinaryCacheIdentityHash(
+        const Array<String> &variantKeywords) const;
+
     void BindAllTexturesToUnits();
     void CheckTextureBindingsValidity() const;
     void BindTextureToFreeUnit(const String &textureName, Texture *texture);
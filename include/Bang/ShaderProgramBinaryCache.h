@@ -0,0 +1,66 @@
+#ifndef SHADERPROGRAMBINARYCACHE_H
+#define SHADERPROGRAMBINARYCACHE_H
+
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/GL.h"
+#include "Bang/Hash.h"
+#include "Bang/Path.h"
+#include "Bang/String.h"
+
+namespace Bang
+{
+// Persists the driver binaries of the linked shader programs in the project
+// cache dir, so that the next runs do not need to compile and link them.
+// They are keyed by the hash of the preprocessed sources and of the driver
+// (vendor, renderer and version), so any change in any of them is a miss.
+// The files are named "<identityHash>.<cacheHash>.bprog", and saving a
+// binary removes the ones of the same program with another cache hash.
+class ShaderProgramBinaryCache
+{
+public:
+    // Hash of what identifies a program across the edits of its sources: the
+    // paths of its shaders, plus the keywords of the variant. Returns 0 when
+    // all the paths are empty, since such a program has no stable identity
+    static Hash::HashType GetIdentityHash(const Array<Path> &shaderPaths,
+                                          const Array<String> &keywords);
+
+    static Hash::HashType GetCacheHash(const String &vShaderSource,
+                                       const String &gShaderSource,
+                                       const String &fShaderSource);
+
+    static Path GetCacheFilepath(Hash::HashType identityHash,
+                                 Hash::HashType cacheHash);
+
+    // Loads the cached binary into the program. Returns true if it is linked
+    static bool Load(GLId programId,
+                     Hash::HashType identityHash,
+                     Hash::HashType cacheHash);
+
+    // Saves the binary of the linked program, and removes the outdated
+    // binaries of the same identity
+    static bool Save(GLId programId,
+                     Hash::HashType identityHash,
+                     Hash::HashType cacheHash);
+
+    static void SetEnabled(bool enabled);
+    static bool IsEnabled();
+
+    static uint GetNumHits();
+    static uint GetNumMisses();
+
+    static String GetCacheExtension();
+
+    ShaderProgramBinaryCache() = delete;
+
+private:
+    static constexpr uint CacheMagic = 0x47525042;  // "BPRG"
+    static constexpr uint CacheVersion = 1;
+
+    static bool s_enabled;
+    static uint s_numHits;
+    static uint s_numMisses;
+};
+}  // namespace Bang
+
+#endif  // SHADERPROGRAMBINARYCACHE_H
@@ -28,7 +28,11 @@ public:
     static ShaderProgram *GetDefaultPostProcess();
     static ShaderProgram *GetPointLightShadowMap();
     static ShaderProgram *GetPointLightDeferredScreenPass();
+    static ShaderProgram *GetClusteredLightsDeferredScreenPass();
     static ShaderProgram *GetDecal();
+    static ShaderProgram *GetDecalsDeferredScreenPass();
+    static ShaderProgram *GetDecalAtlasCopy();
+    static ShaderProgram *GetUIBatch();
     static ShaderProgram *GetKawaseBlur();
     static ShaderProgram *GetSeparableBlur();
     static ShaderProgram *GetSeparableBlurCubeMap();
@@ -44,6 +48,13 @@ public:
 
     static Path GetEngineShadersDir();
 
+    // Loads and links all the engine programs, plus all the unified shaders
+    // and shader programs of the engine and project assets and their keyword
+    // variants, so that their binaries are in the ShaderProgramBinaryCache
+    // for the next runs.
+    // Returns the number of programs that were linked
+    static uint WarmUpBinaryCache();
+
 private:
     Map<Path, AH<ShaderProgram>> m_shaderCache;
     Map<std::tuple<Path, Path, Path>, AH<ShaderProgram>> m_cache;
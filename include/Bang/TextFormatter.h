@@ -20,8 +20,8 @@ public:
     struct CharRect
     {
         AARectf rectPx;
-        char character;
-        CharRect(char _c, const AARectf &_rect) : rectPx(_rect), character(_c)
+        uint character;
+        CharRect(uint _c, const AARectf &_rect) : rectPx(_rect), character(_c)
         {
         }
         friend std::ostream &operator<<(std::ostream &os,
@@ -44,11 +44,15 @@ public:
                                              int fontSize,
                                              const Vector2 &spacingMultiplier);
 
+    // Unicode codepoints of the UTF-8 content. Invalid sequences decode to
+    // the replacement character (U+FFFD)
+    static Array<uint> GetCodepoints(const String &content);
+
     TextFormatter() = delete;
 
 private:
     static Array<Array<CharRect>> SplitCharRectsInLines(
-        const String &content,
+        const Array<uint> &codepoints,
         const Font *font,
         int fontSize,
         const AARecti &limitsRect,
@@ -63,8 +67,8 @@ private:
                                HorizontalAlignment hAlignment,
                                VerticalAlignment vAlignment);
 
-    static AARectf GetCharRect(char c, const Font *font, int fontSize);
-    static float GetCharAdvanceX(const String &content,
+    static AARectf GetCharRect(uint c, const Font *font, int fontSize);
+    static float GetCharAdvanceX(const Array<uint> &codepoints,
                                  const Font *font,
                                  int fontSize,
                                  int currentCharIndex);
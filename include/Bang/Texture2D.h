@@ -9,6 +9,7 @@
 #include "Bang/MetaNode.h"
 #include "Bang/String.h"
 #include "Bang/Texture.h"
+#include "Bang/TextureCompressor.h"
 
 namespace Bang
 {
@@ -32,14 +33,29 @@ public:
               int height,
               GL::ColorComp inputDataColorComp,
               GL::DataType inputDataType);
+    void FillCompressed(const Array<CompressedMipMap> &mipMaps,
+                        TextureCompression compression);
+
+    // Overwrites a region of the texture, without reallocating it nor
+    // regenerating its mipmaps
+    void FillRegion(const Byte *newData,
+                    const AARecti &region,
+                    GL::ColorComp inputDataColorComp,
+                    GL::DataType inputDataType);
 
     void SetAlphaCutoff(float alphaCutoff);
 
+    // Compression applied when importing from an image file. The compressed
+    // mip chain is cached next to the image file
+    void SetCompression(TextureCompression compression);
+
     int GetWidth() const;
     int GetHeight() const;
     Image ToImage() const;
     const Vector2i &GetSize() const;
     float GetAlphaCutoff() const;
+    TextureCompression GetCompression() const;
+    bool IsCompressed() const;
     const Image &GetImage() const;
     uint GetBytesSize() const;
 
@@ -54,6 +70,7 @@ public:
 
     // Asset
     virtual void Import(const Path &imageFilepath) override;
+    virtual void PreImport(const Path &imageFilepath) override;
 
 protected:
     Texture2D();
@@ -68,8 +85,24 @@ protected:
 
 private:
     Image m_image;
+    Image m_preImportedImage;
+    Array<CompressedMipMap> m_preImportedCompressedMipMaps;
+    bool m_hasPreImportedImage = false;
+    TextureCompression m_compression = TextureCompression::NONE;
+    uint m_compressedBytesSize = 0;
     float m_alphaCutoff = 0.0f;
     Vector2i m_size = Vector2i::Zero();
+
+    void ImportFromFile(const Path &imageFilepath);
+    void ImportCompressed(const Image &image,
+                          const Array<CompressedMipMap> &mipMaps);
+
+    static TextureCompression GetCompressionFromMeta(const Path &imageFilepath);
+    static TextureCompression GetCompressionFromMeta(const MetaNode &metaNode);
+    static bool ImportCompressedMipMaps(const Path &imageFilepath,
+                                        TextureCompression compression,
+                                        Image *image,
+                                        Array<CompressedMipMap> *mipMaps);
 };
 }  // namespace Bang
 
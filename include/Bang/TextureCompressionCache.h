@@ -0,0 +1,42 @@
+#ifndef TEXTURECOMPRESSIONCACHE_H
+#define TEXTURECOMPRESSIONCACHE_H
+
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/Hash.h"
+#include "Bang/Path.h"
+#include "Bang/TextureCompressor.h"
+
+namespace Bang
+{
+// Persists the compressed mip chain of a texture in a hidden binary file
+// next to the image file, keyed by the hash of the image file contents and
+// the compression settings. Writing an entry removes the outdated entries of
+// that image.
+class TextureCompressionCache
+{
+public:
+    static Hash::HashType GetCacheHash(const Path &imageFilepath,
+                                       TextureCompression compression);
+
+    static Path GetCacheFilepath(const Path &imageFilepath,
+                                 Hash::HashType cacheHash);
+
+    static bool Read(const Path &cacheFilepath,
+                     Hash::HashType cacheHash,
+                     Array<CompressedMipMap> *mipMaps);
+    static bool Write(const Path &cacheFilepath,
+                      Hash::HashType cacheHash,
+                      const Array<CompressedMipMap> &mipMaps);
+
+    static String GetCacheExtension();
+
+    TextureCompressionCache() = delete;
+
+private:
+    static constexpr uint CacheMagic = 0x58455442;  // "BTEX"
+    static constexpr uint CacheVersion = 1;
+};
+}  // namespace Bang
+
+#endif  // TEXTURECOMPRESSIONCACHE_H
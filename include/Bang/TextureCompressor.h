@@ -0,0 +1,59 @@
+#ifndef TEXTURECOMPRESSOR_H
+#define TEXTURECOMPRESSOR_H
+
+#include <GL/glew.h>
+
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/Vector2.h"
+
+namespace Bang
+{
+class Image;
+
+enum class TextureCompression
+{
+    NONE = 0,
+    BC1,  // RGB, 4 bits per pixel. Alpha is dropped
+    BC3,  // RGBA, 8 bits per pixel
+    BC5   // RG only, 8 bits per pixel. Meant for normal maps, the shaders
+          // reconstruct z from xy (see B_NormalMapIsRG)
+};
+
+struct CompressedMipMap
+{
+    Vector2i size = Vector2i::Zero();
+    Array<Byte> data;
+};
+
+// CPU block compressor for the BCn formats (S3TC / RGTC). Every 4x4 block is
+// encoded independently, so the block rows are spread over the JobSystem.
+// The decoder is the exact inverse of what the GPU does, so it can be used
+// to check the encoded data without a GL context.
+class TextureCompressor
+{
+public:
+    static void Compress(const Image &image,
+                         TextureCompression compression,
+                         Array<Byte> *compressedData);
+    static void Decompress(const Byte *compressedData,
+                           const Vector2i &size,
+                           TextureCompression compression,
+                           Image *image);
+
+    // Compresses the image and the whole mip chain down to 1x1
+    static void CompressMipMaps(const Image &image,
+                                TextureCompression compression,
+                                Array<CompressedMipMap> *mipMaps);
+
+    static uint GetBlockBytesSize(TextureCompression compression);
+    static uint GetCompressedBytesSize(const Vector2i &size,
+                                       TextureCompression compression);
+    static GLenum GetGLInternalFormat(TextureCompression compression,
+                                      bool sRGB);
+
+    TextureCompressor() = delete;
+};
+}  // namespace Bang
+
+#endif  // TEXTURECOMPRESSOR_H
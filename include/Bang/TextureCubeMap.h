@@ -40,9 +40,23 @@ public:
               uint size,
               GL::ColorComp inputDataColorComp,
               GL::DataType inputDataType);
+
+    // Fill or read back one mip level of a face. The size of the level is
+    // derived from the size of the base level
+    void FillMipMap(GL::CubeMapDir cubeMapDir,
+                    const Byte *newData,
+                    uint mipMapLevel,
+                    GL::ColorComp inputDataColorComp,
+                    GL::DataType inputDataType);
+    void ReadMipMap(GL::CubeMapDir cubeMapDir,
+                    uint mipMapLevel,
+                    GL::ColorComp outputDataColorComp,
+                    GL::DataType outputDataType,
+                    Byte *outputData) const;
     void SetSideTexture(GL::CubeMapDir cubeMapDir, Texture2D *tex);
 
     uint GetSize() const;
+    uint GetMipMapSize(uint mipMapLevel) const;
     AH<Texture2D> GetSideTexture(GL::CubeMapDir cubeMapDir) const;
 
     // Serializable
@@ -1,6 +1,7 @@
 #ifndef THREAD_H
 #define THREAD_H
 
+#include <atomic>
 #include <functional>
 #include <thread>
 
@@ -38,7 +39,7 @@ private:
     String m_threadName = "";
     ThreadRunnable *p_runnable = nullptr;
 
-    bool m_hasFinished = false;
+    std::atomic<bool> m_hasFinished;
 
     friend int ThreadFunc(ThreadRunnable *runnable, Thread *thread);
 };
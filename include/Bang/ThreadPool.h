@@ -1,15 +1,20 @@
 #ifndef THREADPOOL_H
 #define THREADPOOL_H
 
+#include <atomic>
+#include <memory>
+
 #include "Bang/BangDefines.h"
-#include "Bang/List.h"
 #include "Bang/String.h"
 
 namespace Bang
 {
-class Thread;
 class ThreadRunnable;
 
+// Runs ThreadRunnables as jobs of the engine JobSystem, limiting how many of
+// them can be in flight at the same time. Runnables that block for a long
+// time (waiting on a device, etc.) should run in their own Thread instead, so
+// that they do not starve the job workers.
 class ThreadPool
 {
 public:
@@ -23,10 +28,13 @@ public:
 
     const String &GetName() const;
     int GetMaxThreadCount() const;
+    int GetNumRunningTasks() const;
 
 private:
     String m_threadsName = "BangPooledThread";
-    List<Thread *> m_threadList;
+
+    // Shared with the scheduled jobs, which may outlive the pool
+    std::shared_ptr<std::atomic<int>> m_numRunningTasks;
 
     uint m_maxThreadCount = 32;
 };
@@ -36,6 +36,9 @@ public:
     // ILayoutSelfController
     void ApplyLayout(Axis axis) override;
 
+    // ICloneable
+    virtual void CloneInto(ICloneable *clone, bool cloneGUID) const override;
+
     // Serializable
     virtual void ImportMeta(const MetaNode &metaNode) override;
     virtual void ExportMeta(MetaNode *metaNode) const override;
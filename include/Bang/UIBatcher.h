@@ -0,0 +1,94 @@
+#ifndef UIBATCHER_H
+#define UIBATCHER_H
+
+#include "Bang/Array.h"
+#include "Bang/AssetHandle.h"
+#include "Bang/BangDefines.h"
+#include "Bang/Color.h"
+#include "Bang/Vector2.h"
+#include "Bang/Vector3.h"
+
+namespace Bang
+{
+class ShaderProgram;
+class Texture2D;
+class VAO;
+class VBO;
+
+// Gathers the geometry of the UI renderers of a canvas in paint order, and
+// draws it with as few draw calls as possible. Vertices are transformed in
+// the CPU and written to a single streaming VBO, and each vertex carries
+// its tint and the slot of the texture it samples. A batch is flushed when
+// it runs out of texture slots, when the depth mask changes, or when some
+// code that touches the GL state (masks, non-batchable renderers...) asks
+// for it through FlushActive.
+class UIBatcher
+{
+public:
+    static constexpr uint MaxTextureSlots = 8;
+
+    enum class Mode
+    {
+        IMAGE = 0,
+        TEXT = 1
+    };
+
+    struct Vertex
+    {
+        Vector3 position;
+        Vector2 uv;
+        Color color;
+        Vector3 params;  // (textureSlot, alphaCutoff, mode)
+    };
+
+    UIBatcher();
+    ~UIBatcher();
+
+    // Makes this batcher the active one until End is called
+    void Begin();
+    void End();
+
+    // Returns the slot for the texture in the current batch (-1 if null),
+    // flushing the batch first if there are no free slots left
+    int AcquireTextureSlot(Texture2D *texture);
+    void SetDepthMask(bool depthMask);
+    void AddVertex(const Vector3 &position,
+                   const Vector2 &uv,
+                   const Color &color,
+                   int textureSlot,
+                   float alphaCutoff,
+                   UIBatcher::Mode mode);
+    void Flush();
+
+    // A disabled batcher takes no renderers, so that they draw one by one
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const;
+
+    // Counters since the last Begin. Every flushed batch counts as one draw
+    // call, even when there is no GL context to draw it (tests)
+    uint GetNumDrawCalls() const;
+    uint GetNumBatchedVertices() const;
+
+    static UIBatcher *GetActive();
+    static void FlushActive();
+
+private:
+    Array<Vertex> m_vertices;
+    Array<Texture2D *> p_textureSlots;
+    bool m_enabled = true;
+    bool m_depthMask = true;
+    uint m_numDrawCalls = 0;
+    uint m_numBatchedVertices = 0;
+
+    VAO *m_vao = nullptr;
+    VBO *m_vbo = nullptr;
+    AH<ShaderProgram> p_batchSP;
+    UIBatcher *p_previousActive = nullptr;
+
+    static UIBatcher *s_activeBatcher;
+
+    void Init();
+};
+}  // namespace Bang
+
+#endif  // UIBATCHER_H
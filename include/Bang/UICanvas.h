@@ -33,6 +33,8 @@ class IEventsDestroy;
 class IEventsDragDrop;
 struct InputEvent;
 class Object;
+class UIBatcher;
+class UIFocusIndex;
 class UILayoutManager;
 
 class UICanvas : public Component, public EventListener<IEventsDestroy>
@@ -47,6 +49,7 @@ public:
     virtual void OnStart() override;
     virtual void OnUpdate() override;
     virtual void OnBeforeChildrenRender(RenderPass rp) override;
+    virtual void OnAfterChildrenRender(RenderPass rp) override;
 
     void InvalidateCanvas();
 
@@ -68,6 +71,12 @@ public:
 
     Array<EventListener<IEventsDragDrop> *> GetDragDropListeners() const;
 
+    // All the focus candidates under the game object, with their mask rects,
+    // top most first. The focus index caches them for the canvas
+    void GetSortedFocusCandidatesByOcclusionOrder(
+        const GameObject *go,
+        Array<std::pair<UIFocusable *, AARecti>> *sortedCandidates) const;
+
     // ICloneable
     virtual void CloneInto(ICloneable *clone, bool cloneGUID) const override;
 
@@ -79,6 +88,8 @@ public:
     virtual void OnDestroyed(EventEmitter<IEventsDestroy> *object) override;
 
     UILayoutManager *GetLayoutManager() const;
+    UIBatcher *GetBatcher() const;
+    UIFocusIndex *GetFocusIndex() const;
 
     static UICanvas *GetActive(const GameObject *go);
     static UICanvas *GetActive(const Component *comp);
@@ -86,6 +97,8 @@ public:
 private:
     Set<UIFocusable *> p_focusablesBeingPressed;
     UILayoutManager *m_uiLayoutManager = nullptr;
+    UIBatcher *m_uiBatcher = nullptr;
+    UIFocusIndex *m_focusIndex = nullptr;
     uint m_framesSinceCreated = 0;
 
     DPtr<UIFocusable> p_focus = nullptr;
@@ -103,16 +116,13 @@ private:
     void RegisterFocusableBeingPressed(UIFocusable *focusable);
     void RegisterFocusableNotBeingPressedAnymore(UIFocusable *focusable);
 
-    void GetSortedFocusCandidatesByOcclusionOrder(
-        const GameObject *go,
-        Array<std::pair<UIFocusable *, AARecti>> *sortedCandidates) const;
-
     void GetSortedFocusCandidatesByPaintOrder(
         const GameObject *go,
         Array<std::pair<UIFocusable *, AARecti>> *sortedCandidates,
         std::stack<AARecti> *maskRectStack) const;
 
     friend class UIFocusable;
+    friend class UIFocusIndex;
 };
 }  // namespace Bang
 
@@ -26,6 +26,9 @@ public:
     // ILayoutElement
     virtual void ApplyLayout(Axis axis) override;
 
+    // ICloneable
+    virtual void CloneInto(ICloneable *clone, bool cloneGUID) const override;
+
     // Serializable
     virtual void ImportMeta(const MetaNode &metaNode) override;
     virtual void ExportMeta(MetaNode *metaNode) const override;
@@ -8,6 +8,7 @@
 #include "Bang/Component.h"
 #include "Bang/ComponentMacros.h"
 #include "Bang/GameObject.h"
+#include "Bang/IUIListDataSource.h"
 #include "Bang/List.h"
 #include "Bang/Path.h"
 #include "Bang/String.h"
@@ -15,9 +16,10 @@
 namespace Bang
 {
 class UIFileListItem;
+class UIList;
 class UITextRenderer;
 
-class UIFileList : public Component
+class UIFileList : public Component, public IUIListDataSource
 {
     COMPONENT(UIFileList)
 
@@ -27,6 +29,7 @@ public:
 
     void OnStart() override;
     void OnUpdate() override;
+    void OnDestroy() override;
 
     using PathCallback = std::function<void(const Path &)>;
 
@@ -41,15 +44,24 @@ public:
     bool GetShowOnlyDirectories() const;
     const Array<String> &GetFileExtensions() const;
 
+    // IUIListDataSource
+    int GetNumItems() const override;
+    int GetItemHeight() const override;
+    GameObject *CreateItem() override;
+    void BindItem(GameObject *item, int index) override;
+
 private:
+    static const int ItemHeightPx;
+
     Path m_currentPath;
+    Array<Path> m_paths;
     Array<String> m_fileExtensions;
-    UIFileListItem *p_selectedItem = nullptr;
     List<PathCallback> m_fileAcceptedCallback;
     List<PathCallback> m_pathChangedCallback;
     bool m_showOnlyDirectories = false;
 
     void UpdateEntries();
+    UIList *GetUIList() const;
 };
 
 class UIFileListItem : public GameObject
@@ -0,0 +1,81 @@
+#ifndef UIFOCUSINDEX_H
+#define UIFOCUSINDEX_H
+
+#include <functional>
+
+#include "Bang/AARect.h"
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/DPtr.h"
+#include "Bang/Vector2.h"
+
+namespace Bang
+{
+class GameObject;
+class UICanvas;
+class UIFocusable;
+
+// Focus candidates of a canvas, sorted by occlusion order, plus a grid of
+// their viewport rects to find the focusable under the mouse without going
+// through all of them. Gathering the candidates walks the whole canvas, so
+// it is only done again when something that can change them (rect
+// transforms, hierarchy, enabling, visibility, components, masks or the
+// viewport) has changed in the canvas since the last update.
+class UIFocusIndex
+{
+public:
+    UIFocusIndex();
+
+    void Update(const UICanvas *canvas);
+
+    // Top most enabled focusable that contains the point, with the same
+    // tests as the ones of the canvas full candidates scan
+    UIFocusable *GetFocusableUnderMouse(const Vector2i &mousePosVP,
+                                        const Vector2i &mousePosWindow) const;
+    const Array<DPtr<UIFocusable>> &GetFocusables() const;
+    const Array<AARecti> &GetMaskRectsVP() const;
+
+    // Grid of the viewport rects of the candidates, in occlusion order.
+    // GetFirstIndexAt returns the first candidate that passes the test among
+    // the ones whose rect is near the point (or among all of them if the
+    // point is out of the viewport), -1 if none
+    void BuildGrid(const AARecti &viewportRect, const Array<AARect> &rectsVP);
+    int GetFirstIndexAt(const Vector2i &pointVP,
+                        const std::function<bool(uint)> &passesTest) const;
+
+    void Invalidate();
+    bool IsInvalid() const;
+
+    // Invalidates the indices of all the canvases the game object is in
+    // (the nested ones too, their candidates are the outer ones' too), and
+    // of the canvases under it. Called by everything that can change the
+    // focus candidates, where the change starts: it covers the descendants
+    // it is propagated to. Canvases register their index, so that this only
+    // checks the ones that are still valid, and nothing without canvases
+    static void Invalidate(const GameObject *go);
+
+private:
+    static constexpr int GridCellSizePx = 64;
+
+    static Array<const UICanvas *> s_canvases;
+
+    bool m_invalid = true;
+    AARecti m_viewportRect;
+
+    Array<DPtr<UIFocusable>> m_focusables;
+    Array<AARecti> m_maskRectsVP;
+    uint m_numCandidates = 0;
+    Vector2i m_gridSize = Vector2i::Zero();
+    Array<Array<uint>> m_gridCells;
+
+    void Rebuild(const UICanvas *canvas);
+    int GetCellIndex(const Vector2i &cellCoords) const;
+
+    static void RegisterCanvas(const UICanvas *canvas);
+    static void UnRegisterCanvas(const UICanvas *canvas);
+
+    friend class UICanvas;
+};
+}  // namespace Bang
+
+#endif  // UIFOCUSINDEX_H
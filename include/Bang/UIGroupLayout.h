@@ -51,6 +51,9 @@ public:
     Stretch GetChildrenVerticalStretch() const;
     Stretch GetChildrenHorizontalStretch() const;
 
+    // ICloneable
+    virtual void CloneInto(ICloneable *clone, bool cloneGUID) const override;
+
     // Serializable
     virtual void ImportMeta(const MetaNode &metaNode) override;
     virtual void ExportMeta(MetaNode *metaNode) const override;
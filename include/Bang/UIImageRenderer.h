@@ -16,6 +16,7 @@ class ICloneable;
 class Mesh;
 class Path;
 class Texture2D;
+class UIBatcher;
 
 class UIImageRenderer : public UIRenderer
 {
@@ -60,6 +61,10 @@ public:
     virtual void ImportMeta(const MetaNode &metaNode) override;
     virtual void ExportMeta(MetaNode *metaNode) const override;
 
+protected:
+    // UIRenderer
+    virtual bool AddToBatch(UIBatcher *batcher) override;
+
 private:
     AH<Mesh> p_quadMesh;
     Color m_tint = Color::White();
@@ -13,6 +13,7 @@
 #include "Bang/IEventsDestroy.h"
 #include "Bang/LayoutSizeType.h"
 #include "Bang/UMap.h"
+#include "Bang/USet.h"
 
 namespace Bang
 {
@@ -26,6 +27,12 @@ class ILayoutElement;
 template <class ObjectType, bool RECURSIVE>
 class ObjectGatherer;
 
+// Keeps track of the layout elements and controllers that have been
+// invalidated, so that RebuildLayout only visits those instead of the whole
+// canvas. Elements are recalculated deepest first, and the parent layout is
+// only invalidated when the min, preferred or flexible size of the element
+// game object has actually changed. Then the invalid controllers are applied
+// parents first.
 class UILayoutManager : public EventListener<IEventsDestroy>
 {
 public:
@@ -36,6 +43,16 @@ public:
     void PropagateInvalidation(ILayoutElement *element);
     void PropagateInvalidation(ILayoutController *controller);
 
+    // Work done by the last RebuildLayout
+    uint GetNumCalculatedLayouts() const;
+    uint GetNumAppliedLayouts() const;
+
+    // Elements and controllers invalidated while out of any canvas only keep
+    // their invalid flag. These hand the invalid ones to the manager of the
+    // canvas they have just been attached to
+    static void ClaimInvalidations(GameObject *attachedGo);
+    static void ClaimInvalidations(Component *addedComponent);
+
     static Vector2i GetMinSize(GameObject *go);
     static Vector2i GetPreferredSize(GameObject *go);
     static Vector2 GetFlexibleSize(GameObject *go);
@@ -54,8 +71,21 @@ private:
     UMap<GameObject *, ObjectGatherer<ILayoutController, false> *>
         m_iLayoutControllersPerGameObject;
 
-    void CalculateLayout(GameObject *gameObject, Axis axis);
-    void ApplyLayout(GameObject *gameObject, Axis axis);
+    USet<GameObject *> m_invalidElementsGos;
+    USet<GameObject *> m_invalidControllersGos;
+    Array<GameObject *> m_newInvalidElementsGos;
+    Array<GameObject *> m_newInvalidControllersGos;
+    uint m_numCalculatedLayouts = 0;
+    uint m_numAppliedLayouts = 0;
+    bool m_claimedRootInvalidations = false;
+
+    void CalculateLayout(Axis axis);
+    void ApplyLayout(Axis axis);
+
+    void MarkInvalid(GameObject *elementsGo, GameObject *controllersGo);
+    bool ForwardIfNotOwned(GameObject *gameObject);
+    void InvalidateParentControllers(GameObject *gameObject);
+    static int GetDepth(GameObject *gameObject);
 
     // IEventsDestroy
     void OnDestroyed(EventEmitter<IEventsDestroy> *object) override;
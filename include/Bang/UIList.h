@@ -25,6 +25,7 @@
 
 namespace Bang
 {
+class IUIListDataSource;
 class UIDirLayout;
 class UIFocusable;
 class UIImageRenderer;
@@ -90,6 +91,29 @@ public:
 
     void SetWideSelectionMode(bool wideSelectionMode);
 
+    // Virtualized mode: the items come from the data source, and only the
+    // visible ones (plus a small margin) get a pooled GameObject, which is
+    // rebound while scrolling. Indices (selection, scrolling, keyboard
+    // navigation) are model indices, and GetItems/GetItem only return the
+    // rows currently bound. A null data source goes back to the normal mode
+    void SetDataSource(IUIListDataSource *dataSource);
+    void RefreshItems();
+    IUIListDataSource *GetDataSource() const;
+    bool IsVirtualized() const;
+    int GetItemIndex(GOItem *item) const;
+
+    // Model indices a virtualized list keeps rows for, given the scrolling
+    // (in pixels) of its view: the visible ones plus a margin on each side
+    static void GetVirtualRange(int numItems,
+                                int itemHeight,
+                                int viewTop,
+                                int viewHeight,
+                                int *firstIndex,
+                                int *numRows);
+
+    // Component
+    void OnUpdate() override;
+
     // IEventsDestroy
     virtual void OnDestroyed(EventEmitter<IEventsDestroy> *object) override;
 
@@ -104,12 +128,15 @@ protected:
 
     void AddItem_(GOItem *newItem, int index, bool moving);
     void RemoveItem_(GOItem *item, bool moving);
+    void SetupItem(GOItem *item, int indexInContainer);
 
     UIEventResult OnMouseMove(bool forceColorsUpdate = false,
                               bool callCallbacks = true);
     UIImageRenderer *GetItemBg(GOItem *item) const;
 
 private:
+    static const int VirtualMarginItems;
+
     Array<GOItem *> p_items;
     UIDirLayout *p_dirLayout = nullptr;
     UIFocusable *p_focusable = nullptr;
@@ -129,7 +156,16 @@ private:
     bool m_wideSelectionMode = true;
     bool m_notifySelectionOnFullClick = false;
 
+    IUIListDataSource *p_dataSource = nullptr;
+    GameObject *p_virtualTopSpacer = nullptr;
+    GameObject *p_virtualBotSpacer = nullptr;
+    int m_firstVirtualIndex = 0;
+    int m_virtualItemHeight = 0;
+    bool m_virtualItemsInvalid = false;
+
     void SetItemUnderMouse(GOItem *itemUnderMouse, bool callCallbacks);
+    void UpdateVirtualItems();
+    void DestroyVirtualItems(bool destroySpacers);
 
     // IEventsFocus
     UIEventResult OnUIEvent(UIFocusable *focusable,
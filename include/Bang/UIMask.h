@@ -31,6 +31,9 @@ public:
     bool IsMasking() const;
     bool IsDrawMask() const;
 
+    // ICloneable
+    virtual void CloneInto(ICloneable *clone, bool cloneGUID) const override;
+
     // Serializable
     virtual void ImportMeta(const MetaNode &metaNode) override;
     virtual void ExportMeta(MetaNode *metaNode) const override;
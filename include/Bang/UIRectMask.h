@@ -22,10 +22,17 @@ public:
     void OnBeforeChildrenRender(RenderPass renderPass) override;
     void OnAfterChildrenRender(RenderPass renderPass) override;
 
+    // IEventsObject
+    void OnEnabled(Object *object) override;
+    void OnDisabled(Object *object) override;
+
     void SetMasking(bool maskEnabled);
 
     bool IsMasking() const;
 
+    // ICloneable
+    virtual void CloneInto(ICloneable *clone, bool cloneGUID) const override;
+
     // Serializable
     virtual void ImportMeta(const MetaNode &metaNode) override;
     virtual void ExportMeta(MetaNode *metaNode) const override;
@@ -21,6 +21,7 @@ class GameObject;
 class IEventsChildren;
 class IEventsTransform;
 class Object;
+class UIBatcher;
 
 class UIRenderer : public Renderer,
                    public EventListener<IEventsChildren>,
@@ -57,8 +58,15 @@ protected:
     UIRenderer();
     virtual ~UIRenderer() override;
 
+    // Adds the geometry of this renderer to the canvas batcher, instead of
+    // drawing it. Returns false if it can not be batched, in which case it is
+    // drawn on its own
+    virtual bool AddToBatch(UIBatcher *batcher);
+
 private:
     bool m_cullByRectTransform = true;
+
+    bool TryAddToBatch(RenderPass renderPass);
 };
 }
 
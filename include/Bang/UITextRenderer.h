@@ -20,6 +20,7 @@ class Color;
 class Font;
 class ICloneable;
 class Mesh;
+class UIBatcher;
 
 class UITextRenderer : public UIRenderer,
                        public ILayoutElement,
@@ -73,6 +74,10 @@ public:
     virtual void ImportMeta(const MetaNode &metaNode) override;
     virtual void ExportMeta(MetaNode *metaNode) const override;
 
+protected:
+    // UIRenderer
+    virtual bool AddToBatch(UIBatcher *batcher) override;
+
 private:
     AH<Font> p_font;
     String m_content = "";
@@ -88,6 +93,7 @@ private:
     AH<Mesh> p_mesh;
     mutable uint m_numberOfLines = 0;
     mutable Array<AARect> m_charRectsLocalNDC;
+    mutable uint m_atlasGeneration = 0;
 
     UITextRenderer();
     virtual ~UITextRenderer() override;
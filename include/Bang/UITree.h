@@ -15,10 +15,13 @@
 #include "Bang/IEventsDragDrop.h"
 #include "Bang/IEventsFocus.h"
 #include "Bang/IEventsUITree.h"
+#include "Bang/IUIListDataSource.h"
+#include "Bang/IUITreeDataSource.h"
 #include "Bang/List.h"
 #include "Bang/String.h"
 #include "Bang/Tree.h"
 #include "Bang/UIList.h"
+#include "Bang/UIVirtualTree.h"
 #include "Bang/UMap.h"
 
 namespace Bang
@@ -33,11 +36,14 @@ class UITree : public Component,
                public EventListener<IEventsFocus>,
                public EventListener<IEventsDestroy>,
                public EventListener<IEventsDragDrop>,
-               public EventEmitter<IEventsUITree>
+               public EventEmitter<IEventsUITree>,
+               public IUIListDataSource
 {
     COMPONENT(UITree)
 
 public:
+    using NodeId = IUITreeDataSource::NodeId;
+
     enum class MouseItemRelativePosition
     {
         ABOVE,
@@ -73,6 +79,21 @@ public:
         UITree::MouseItemRelativePosition *itemRelPosOut) const;
     int GetFlatUIListIndex(GOItem *parentItem, int indexInsideParent);
 
+    // Virtualized mode: the nodes come from the data source, and only the
+    // visible rows get a pooled item container, which is rebound while
+    // scrolling. Items can not be added, moved or removed by hand, and the
+    // rows can not be dragged. A null data source goes back to the normal
+    // mode
+    void SetDataSource(IUITreeDataSource *dataSource);
+    void RefreshItems();
+    void SetNodeCollapsed(NodeId node, bool collapsed);
+    void SetSelectedNode(NodeId node);
+    IUITreeDataSource *GetDataSource() const;
+    bool IsVirtualized() const;
+    bool IsNodeCollapsed(NodeId node) const;
+    bool GetSelectedNode(NodeId *node) const;
+    const UIVirtualTree &GetVirtualTree() const;
+
     // Component
     void OnUpdate() override;
 
@@ -90,6 +111,12 @@ public:
     // IEventsDestroy
     void OnDestroyed(EventEmitter<IEventsDestroy> *object) override;
 
+    // IUIListDataSource
+    int GetNumItems() const override;
+    int GetItemHeight() const override;
+    GameObject *CreateItem() override;
+    void BindItem(GameObject *item, int index) override;
+
 protected:
     UITree();
     virtual ~UITree() override;
@@ -108,6 +135,8 @@ private:
     GameObject *p_dragMarker = nullptr;
     UIImageRenderer *p_dragMarkerImg = nullptr;
 
+    UIVirtualTree m_virtualTree;
+
     GOItem *AddItem_(GOItem *newItemTree,
                      GOItem *parentItem,
                      int indexInsideParent,
@@ -120,6 +149,9 @@ private:
     bool NeedsToBeEnabled(GOItem *item, bool recursive);
     void UpdateCollapsabilityOnThisAndDescendants(GOItem *item);
     void IndentItem(GOItem *item);
+    void SetRowCollapsed(UITreeItemContainer *itemCont, bool collapsed);
+    int GetRowNumChildren(UITreeItemContainer *itemCont) const;
+    NodeId GetRowNode(UITreeItemContainer *itemCont) const;
     bool IsValidDrag(UIDragDroppable *dd,
                      GOItem *itemBeingDragged,
                      GOItem *itemOver) const;
@@ -0,0 +1,58 @@
+#ifndef UIVIRTUALTREE_H
+#define UIVIRTUALTREE_H
+
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/IUITreeDataSource.h"
+#include "Bang/USet.h"
+
+namespace Bang
+{
+// The visible nodes of a tree data source, in the order they are listed:
+// every node of an expanded parent (starting from the root), depth first.
+// Nodes start collapsed. This is what a virtualized UITree feeds its UIList
+// with, and it does not create any GameObject.
+class UIVirtualTree
+{
+public:
+    using NodeId = IUITreeDataSource::NodeId;
+
+    UIVirtualTree() = default;
+
+    void SetDataSource(IUITreeDataSource *dataSource);
+
+    // Lists the visible nodes again, after the model has changed. The
+    // expanded nodes are kept
+    void Refresh();
+
+    void SetExpanded(NodeId node, bool expanded);
+    bool IsExpanded(NodeId node) const;
+
+    int GetNumVisibleNodes() const;
+    NodeId GetVisibleNode(int index) const;
+    int GetVisibleNodeDepth(int index) const;
+
+    // Linear in the number of visible nodes. Returns -1 if the node is not
+    // visible (or not in the model)
+    int GetVisibleNodeIndex(NodeId node) const;
+
+    IUITreeDataSource *GetDataSource() const;
+
+private:
+    struct VisibleNode
+    {
+        NodeId node;
+        int depth;
+    };
+
+    IUITreeDataSource *p_dataSource = nullptr;
+    USet<NodeId> m_expandedNodes;
+    Array<VisibleNode> m_visibleNodes;
+
+    void AppendVisibleChildren(NodeId node,
+                               int depth,
+                               Array<VisibleNode> *visibleNodes) const;
+};
+}  // namespace Bang
+
+#endif  // UIVIRTUALTREE_H
@@ -94,19 +94,40 @@ Array<AH<Mesh>> MeshSimplifier::GetAllMeshLODs(
     const Mesh *mesh,
     SimplificationMethod simplificationMethod)
 {
+    Array<AH<Mesh>> simplifiedMeshesArray;
     if (!mesh)
     {
-        return Array<AH<Mesh>>();
+        return simplifiedMeshesArray;
+    }
+
+    const Array<LODData> lodsData = MeshSimplifier::GetAllMeshLODsData(
+        MeshSimplifier::GetMeshData(mesh), simplificationMethod);
+    for (const LODData &lodData : lodsData)
+    {
+        simplifiedMeshesArray.PushBack(
+            MeshSimplifier::CreateMeshFromLODData(lodData));
+    }
+    return simplifiedMeshesArray;
+}
+
+Array<MeshSimplifier::LODData> MeshSimplifier::GetAllMeshLODsData(
+    const MeshData &meshData,
+    SimplificationMethod simplificationMethod)
+{
+    const uint numVertices = meshData.positions.Size();
+    const uint numVerticesIds = meshData.triangleVertexIds.Size();
+    if (numVertices == 0 || numVerticesIds == 0)
+    {
+        return Array<LODData>();
     }
 
     Array<OctreeData> octreeData;  // Retrieve all the octree data
     {
-        for (uint i = 0; i < mesh->GetNumVerticesIds(); ++i)
+        octreeData.Reserve(numVerticesIds);
+        for (uint i = 0; i < numVerticesIds; ++i)
         {
-            const int vIndex = (mesh->GetTriangleVertexIdsIBO()
-                                    ? mesh->GetTrianglesVertexIds()[i]
-                                    : i);
-            const Vector3 &position = mesh->GetPositionsPool()[vIndex];
+            const Mesh::VertexId vIndex = meshData.triangleVertexIds[i];
+            const Vector3 &position = meshData.positions[vIndex];
             octreeData.PushBack(std::make_pair(vIndex, position));
         }
     }
@@ -116,20 +137,21 @@ Array<AH<Mesh>> MeshSimplifier::GetAllMeshLODs(
     constexpr int MaxOctreeDepth = 12;
     constexpr float PaddingPercent = 0.1f;
     SimplOctree octree;
-    AABox meshAABox = mesh->GetAABBox();
+    AABox meshAABox = meshData.aaBox;
     octree.SetAABox(
         AABox(meshAABox.GetMin() - meshAABox.GetSize() * PaddingPercent,
               meshAABox.GetMax() + meshAABox.GetSize() * PaddingPercent));
     octree.Fill(octreeData, MaxOctreeDepth);
 
-    // Compute useful connectivity info for later
+    // Compute useful connectivity info for later. Vertex ids are dense, so
+    // index directly by them instead of hashing.
     using VertexIdPair = std::pair<Mesh::VertexId, Mesh::VertexId>;
-    UMap<Mesh::VertexId, Set<VertexIdPair>>
-        vertexIndexToTriangleOtherVerticesIndices;
-    for (uint tri = 0; tri < mesh->GetNumTriangles(); ++tri)
+    Array<Set<VertexIdPair>> vertexIndexToTriangleOtherVerticesIndices(
+        numVertices);
+    for (uint tri = 0; tri < meshData.GetNumTriangles(); ++tri)
     {
         const std::array<Mesh::VertexId, 3> triVertexIndices =
-            mesh->GetVertexIdsFromTriangle(tri);
+            meshData.GetVertexIdsFromTriangle(tri);
         for (uint i = 0; i < 3; ++i)
         {
             const Mesh::VertexId currentVertexIndex =
@@ -143,12 +165,6 @@ Array<AH<Mesh>> MeshSimplifier::GetAllMeshLODs(
             const VertexIdPair otherTriVertexIndices =
                 std::minmax(otherVertexIndex0, otherVertexIndex1);
 
-            if (!vertexIndexToTriangleOtherVerticesIndices.ContainsKey(
-                    currentVertexIndex))
-            {
-                vertexIndexToTriangleOtherVerticesIndices[currentVertexIndex] =
-                    Set<VertexIdPair>();
-            }
             vertexIndexToTriangleOtherVerticesIndices[currentVertexIndex].Add(
                 otherTriVertexIndices);
         }
@@ -157,7 +173,13 @@ Array<AH<Mesh>> MeshSimplifier::GetAllMeshLODs(
     UMap<Mesh::VertexId, Array<Mesh::TriangleId>> vertexIdxsToTriIdxs;
     if (simplificationMethod == SimplificationMethod::QUADRIC_ERROR_METRICS)
     {
-        vertexIdxsToTriIdxs = mesh->GetVertexIdsToTriangleIds();
+        for (uint ti = 0; ti < meshData.GetNumTriangles(); ++ti)
+        {
+            for (Mesh::VertexId tivi : meshData.GetVertexIdsFromTriangle(ti))
+            {
+                vertexIdxsToTriIdxs[tivi].PushBack(ti);
+            }
+        }
     }
 
     int octreeDepth = octree.GetDepth();
@@ -169,7 +191,7 @@ Array<AH<Mesh>> MeshSimplifier::GetAllMeshLODs(
     }
 
     // For each level of detail
-    Array<AH<Mesh>> simplifiedMeshesArray;
+    Array<LODData> lodsData;
     for (int level : levelsToGenerate)
     {
         // Get the octree nodes at that level (and leaves pruned before)
@@ -217,9 +239,9 @@ Array<AH<Mesh>> MeshSimplifier::GetAllMeshLODs(
                 {
                     const Mesh::VertexId vertexIndex = octNodeData.first;
                     Vector3 vNormal;
-                    if (vertexIndex < mesh->GetNormalsPool().Size())
+                    if (vertexIndex < meshData.normals.Size())
                     {
-                        vNormal = mesh->GetNormalsPool()[vertexIndex];
+                        vNormal = meshData.normals[vertexIndex];
                     }
 
                     bool coincidingNormal =
@@ -232,23 +254,23 @@ Array<AH<Mesh>> MeshSimplifier::GetAllMeshLODs(
                             !vertexIndexToClusterIndex.ContainsKey(vertexIndex))
                         {
                             VertexData vData;
-                            if (vertexIndex < mesh->GetPositionsPool().Size())
+                            if (vertexIndex < meshData.positions.Size())
                             {
                                 vData.pos =
-                                    mesh->GetPositionsPool()[vertexIndex];
+                                    meshData.positions[vertexIndex];
                             }
 
                             vData.normal = vNormal;
 
-                            if (vertexIndex < mesh->GetUvsPool().Size())
+                            if (vertexIndex < meshData.uvs.Size())
                             {
-                                vData.uv = mesh->GetUvsPool()[vertexIndex];
+                                vData.uv = meshData.uvs[vertexIndex];
                             }
 
-                            if (vertexIndex < mesh->GetTangentsPool().Size())
+                            if (vertexIndex < meshData.tangents.Size())
                             {
                                 vData.tangent =
-                                    mesh->GetTangentsPool()[vertexIndex];
+                                    meshData.tangents[vertexIndex];
                             }
 
                             ASSERT(!vertexIndexToClusterIndex.ContainsKey(
@@ -274,14 +296,13 @@ Array<AH<Mesh>> MeshSimplifier::GetAllMeshLODs(
         Array<Vector3> normalsLOD;
         Array<Vector2> uvsLOD;
         Array<Vector3> tangentsLOD;
-        AH<Mesh> simplifiedMesh = Assets::Create<Mesh>();
         for (const VertexCluster &vertexCluster : vertexClusters)
         {
             ASSERT(!vertexCluster.IsEmpty());
 
             VertexData vertexRepresentativeData =
                 MeshSimplifier::GetVertexRepresentativeForCluster(
-                    *mesh,
+                    meshData,
                     vertexCluster,
                     vertexIdxsToTriIdxs,
                     simplificationMethod);
@@ -290,10 +311,6 @@ Array<AH<Mesh>> MeshSimplifier::GetAllMeshLODs(
             uvsLOD.PushBack(vertexRepresentativeData.uv);
             tangentsLOD.PushBack(vertexRepresentativeData.tangent);
         }
-        simplifiedMesh.Get()->SetPositionsPool(positionsLOD);
-        simplifiedMesh.Get()->SetNormalsPool(normalsLOD);
-        simplifiedMesh.Get()->SetUvsPool(uvsLOD);
-        simplifiedMesh.Get()->SetTangentsPool(tangentsLOD);
         ASSERT(positionsLOD.Size() == vertexClusters.Size());
         ASSERT(normalsLOD.Size() == vertexClusters.Size());
         ASSERT(uvsLOD.Size() == vertexClusters.Size());
@@ -329,8 +346,8 @@ Array<AH<Mesh>> MeshSimplifier::GetAllMeshLODs(
 
                 ASSERT(vertexIndexToClusterIndex.ContainsKey(
                     vertexInClusterIndex));
-                ASSERT(vertexIndexToTriangleOtherVerticesIndices.ContainsKey(
-                    vertexInClusterIndex));
+                ASSERT(vertexInClusterIndex <
+                       vertexIndexToTriangleOtherVerticesIndices.Size());
 
                 const ClusterId vCId =
                     // cId;
@@ -338,8 +355,8 @@ Array<AH<Mesh>> MeshSimplifier::GetAllMeshLODs(
                 ASSERT(vCId == cId);
 
                 const Set<VertexIdPair> &otherVertexIndicesThatFormATri =
-                    vertexIndexToTriangleOtherVerticesIndices.Get(
-                        vertexInClusterIndex);
+                    vertexIndexToTriangleOtherVerticesIndices
+                        [vertexInClusterIndex];
 
                 // For each vertex pair that forms a tri with each vertex in
                 // each vertex cluster
@@ -441,29 +458,107 @@ Array<AH<Mesh>> MeshSimplifier::GetAllMeshLODs(
             }
         }
 
-        simplifiedMesh.Get()->SetTrianglesVertexIds(
-            vertexClusterTriVertsIndices);
-        simplifiedMesh.Get()->UpdateVertexNormals();
-        simplifiedMesh.Get()->UpdateVAOsAndTables();
+        // Recompute smooth vertex normals from the new triangles
+        Array<Vector3> smoothNormalsLOD(positionsLOD.Size(), Vector3::Zero());
+        for (uint i = 0; i + 2 < vertexClusterTriVertsIndices.Size(); i += 3)
+        {
+            const Mesh::VertexId vId0 = vertexClusterTriVertsIndices[i + 0];
+            const Mesh::VertexId vId1 = vertexClusterTriVertsIndices[i + 1];
+            const Mesh::VertexId vId2 = vertexClusterTriVertsIndices[i + 2];
+            const Vector3 triNormal =
+                Triangle(positionsLOD[vId0],
+                         positionsLOD[vId1],
+                         positionsLOD[vId2])
+                    .GetNormal();
+            smoothNormalsLOD[vId0] += triNormal;
+            smoothNormalsLOD[vId1] += triNormal;
+            smoothNormalsLOD[vId2] += triNormal;
+        }
+        for (Vector3 &smoothNormal : smoothNormalsLOD)
+        {
+            smoothNormal = smoothNormal.NormalizedSafe();
+        }
 
-        Debug_Log("Level " << level << ": "
-                           << vertexClusterTriVertsIndices.Size()
-                           << "/"
-                           << mesh->GetNumVerticesIds());
+        if (vertexClusterTriVertsIndices.Size() >= numVerticesIds)
+        {
+            // This is as detailed as the original mesh, going further makes
+            // no sense
+            break;
+        }
+
+        if (vertexClusterTriVertsIndices.IsEmpty())
+        {
+            // Too coarse, everything collapsed
+            continue;
+        }
+
+        LODData lodData;
+        lodData.positions = positionsLOD;
+        lodData.normals = smoothNormalsLOD;
+        lodData.uvs = uvsLOD;
+        lodData.tangents = tangentsLOD;
+        lodData.triangleVertexIds = vertexClusterTriVertsIndices;
+        lodsData.PushBack(lodData);
+    }
 
-        simplifiedMeshesArray.PushBack(simplifiedMesh);
+    // Return them from most detailed to coarsest
+    lodsData.Reverse();
+    return lodsData;
+}
 
-        if (vertexClusterTriVertsIndices.Size() == mesh->GetNumVerticesIds())
+MeshSimplifier::MeshData MeshSimplifier::GetMeshData(const Mesh *mesh)
+{
+    MeshData meshData;
+    if (mesh)
+    {
+        meshData.aaBox = mesh->GetAABBox();
+        meshData.positions = mesh->GetPositionsPool();
+        meshData.normals = mesh->GetNormalsPool();
+        meshData.uvs = mesh->GetUvsPool();
+        meshData.tangents = mesh->GetTangentsPool();
+        if (mesh->IsIndexed())
         {
-            // This was the max level, going further makes no sense
-            break;
+            meshData.triangleVertexIds = mesh->GetTrianglesVertexIds();
+        }
+        else
+        {
+            for (Mesh::VertexId vId = 0; vId < mesh->GetNumVertices(); ++vId)
+            {
+                meshData.triangleVertexIds.PushBack(vId);
+            }
         }
     }
-    return simplifiedMeshesArray;
+    return meshData;
+}
+
+AH<Mesh> MeshSimplifier::CreateMeshFromLODData(const LODData &lodData)
+{
+    AH<Mesh> lodMesh = Assets::Create<Mesh>();
+    lodMesh.Get()->SetPositionsPool(lodData.positions);
+    lodMesh.Get()->SetNormalsPool(lodData.normals);
+    lodMesh.Get()->SetUvsPool(lodData.uvs);
+    lodMesh.Get()->SetTangentsPool(lodData.tangents);
+    lodMesh.Get()->SetTrianglesVertexIds(lodData.triangleVertexIds);
+    lodMesh.Get()->UpdateVAOs();
+    return lodMesh;
+}
+
+uint MeshSimplifier::MeshData::GetNumTriangles() const
+{
+    return SCAST<uint>(triangleVertexIds.Size() / 3);
+}
+
+std::array<Mesh::VertexId, 3> MeshSimplifier::MeshData::GetVertexIdsFromTriangle(
+    Mesh::TriangleId triId) const
+{
+    ASSERT(triId < GetNumTriangles());
+    return {{triangleVertexIds[triId * 3 + 0],
+             triangleVertexIds[triId * 3 + 1],
+             triangleVertexIds[triId * 3 + 2]}};
 }
 
 MeshSimplifier::VertexData MeshSimplifier::GetVertexRepresentativeForCluster(
-    const Mesh &mesh,
+    const MeshData &meshData,
     const VertexCluster &vertexCluster,
     const UMap<Mesh::VertexId, Array<Mesh::TriangleId>> &vertexIdxsToTriIdxs,
     SimplificationMethod simplificationMethod)
@@ -540,13 +635,13 @@ MeshSimplifier::VertexData MeshSimplifier::GetVertexRepresentativeForCluster(
                     ++numTrisComputed;
 
                     const std::array<Mesh::VertexId, 3> triVertsIds =
-                        mesh.GetVertexIdsFromTriangle(triId);
+                        meshData.GetVertexIdsFromTriangle(triId);
                     const Mesh::VertexId triVId0 = triVertsIds[0];
                     const Mesh::VertexId triVId1 = triVertsIds[1];
                     const Mesh::VertexId triVId2 = triVertsIds[2];
-                    const Vector3 &triP0 = mesh.GetPositionsPool()[triVId0];
-                    const Vector3 &triP1 = mesh.GetPositionsPool()[triVId1];
-                    const Vector3 &triP2 = mesh.GetPositionsPool()[triVId2];
+                    const Vector3 &triP0 = meshData.positions[triVId0];
+                    const Vector3 &triP1 = meshData.positions[triVId1];
+                    const Vector3 &triP2 = meshData.positions[triVId2];
                     const Triangle neighborTri = Triangle(triP0, triP1, triP2);
                     const Plane neighborTriPlane = neighborTri.GetPlane();
                     const Vector3 &n = neighborTriPlane.GetNormal();
@@ -599,7 +694,7 @@ MeshSimplifier::VertexData MeshSimplifier::GetVertexRepresentativeForCluster(
 
             // To get normal, uvs, etc. use the clustering method.
             vertexRepresentativeData = GetVertexRepresentativeForCluster(
-                mesh,
+                meshData,
                 vertexCluster,
                 vertexIdxsToTriIdxs,
                 SimplificationMethod::CLUSTERING);
@@ -0,0 +1,463 @@
+#include "Bang/TextureCompressor.h"
+
+#include <cstring>
+#include <limits>
+
+#include "Bang/Array.tcc"
+#include "Bang/Assert.h"
+#include "Bang/Image.h"
+#include "Bang/JobSystem.h"
+#include "Bang/Math.h"
+
+using namespace Bang;
+
+namespace
+{
+constexpr int BlockSize = 4;
+constexpr int NumBlockPixels = (BlockSize * BlockSize);
+
+using BlockPixels = Byte[NumBlockPixels * 4];
+
+// Gathers a 4x4 block of RGBA8 pixels, clamping it to the image borders
+void ReadBlock(const Image &image, int blockX, int blockY, BlockPixels block)
+{
+    const Byte *pixels = image.GetData();
+    const int width = image.GetWidth();
+    for (int y = 0; y < BlockSize; ++y)
+    {
+        const int imgY =
+            Math::Min(blockY * BlockSize + y, image.GetHeight() - 1);
+        for (int x = 0; x < BlockSize; ++x)
+        {
+            const int imgX = Math::Min(blockX * BlockSize + x, width - 1);
+            std::memcpy(block + (y * BlockSize + x) * 4,
+                        pixels + (imgY * width + imgX) * 4,
+                        4);
+        }
+    }
+}
+
+void WriteBlock(const BlockPixels block, int blockX, int blockY, Image *image)
+{
+    Byte *pixels = image->GetData();
+    const int width = image->GetWidth();
+    for (int y = 0; y < BlockSize; ++y)
+    {
+        const int imgY = blockY * BlockSize + y;
+        for (int x = 0; x < BlockSize; ++x)
+        {
+            const int imgX = blockX * BlockSize + x;
+            if (imgX < width && imgY < image->GetHeight())
+            {
+                std::memcpy(pixels + (imgY * width + imgX) * 4,
+                            block + (y * BlockSize + x) * 4,
+                            4);
+            }
+        }
+    }
+}
+
+uint16_t ToRGB565(const Byte *rgb)
+{
+    const uint r = (rgb[0] * 31 + 127) / 255;
+    const uint g = (rgb[1] * 63 + 127) / 255;
+    const uint b = (rgb[2] * 31 + 127) / 255;
+    return SCAST<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+void FromRGB565(uint16_t color, Byte *rgb)
+{
+    const uint r = (color >> 11) & 31;
+    const uint g = (color >> 5) & 63;
+    const uint b = color & 31;
+    rgb[0] = SCAST<Byte>((r << 3) | (r >> 2));
+    rgb[1] = SCAST<Byte>((g << 2) | (g >> 4));
+    rgb[2] = SCAST<Byte>((b << 3) | (b >> 2));
+}
+
+void WriteUInt16(uint16_t value, Byte *out)
+{
+    out[0] = SCAST<Byte>(value & 0xFF);
+    out[1] = SCAST<Byte>(value >> 8);
+}
+
+uint16_t ReadUInt16(const Byte *in)
+{
+    return SCAST<uint16_t>(in[0] | (in[1] << 8));
+}
+
+// Color block (BC1, and the color half of BC3). The endpoints are the
+// corners of the colors bounding box, inset a bit to reduce the error
+void EncodeColorBlock(const BlockPixels block, Byte *out)
+{
+    Byte minColor[3] = {255, 255, 255};
+    Byte maxColor[3] = {0, 0, 0};
+    for (int i = 0; i < NumBlockPixels; ++i)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            minColor[c] = Math::Min(minColor[c], block[i * 4 + c]);
+            maxColor[c] = Math::Max(maxColor[c], block[i * 4 + c]);
+        }
+    }
+    for (int c = 0; c < 3; ++c)
+    {
+        const int inset = (maxColor[c] - minColor[c]) / 16;
+        minColor[c] = SCAST<Byte>(minColor[c] + inset);
+        maxColor[c] = SCAST<Byte>(maxColor[c] - inset);
+    }
+
+    uint16_t color0 = ToRGB565(maxColor);
+    uint16_t color1 = ToRGB565(minColor);
+    if (color0 < color1)
+    {
+        std::swap(color0, color1);
+    }
+
+    // color0 > color1 selects the 4 colors mode
+    Byte palette[4][3];
+    FromRGB565(color0, palette[0]);
+    FromRGB565(color1, palette[1]);
+    for (int c = 0; c < 3; ++c)
+    {
+        palette[2][c] = SCAST<Byte>((2 * palette[0][c] + palette[1][c]) / 3);
+        palette[3][c] = SCAST<Byte>((palette[0][c] + 2 * palette[1][c]) / 3);
+    }
+
+    uint32_t indices = 0;
+    if (color0 != color1)
+    {
+        for (int i = 0; i < NumBlockPixels; ++i)
+        {
+            uint bestIndex = 0;
+            int bestDist = std::numeric_limits<int>::max();
+            for (uint p = 0; p < 4; ++p)
+            {
+                int dist = 0;
+                for (int c = 0; c < 3; ++c)
+                {
+                    const int diff = (block[i * 4 + c] - palette[p][c]);
+                    dist += diff * diff;
+                }
+                if (dist < bestDist)
+                {
+                    bestDist = dist;
+                    bestIndex = p;
+                }
+            }
+            indices |= (bestIndex << (i * 2));
+        }
+    }
+
+    WriteUInt16(color0, out + 0);
+    WriteUInt16(color1, out + 2);
+    for (int i = 0; i < 4; ++i)
+    {
+        out[4 + i] = SCAST<Byte>((indices >> (i * 8)) & 0xFF);
+    }
+}
+
+void DecodeColorBlock(const Byte *in, bool forceFourColors, BlockPixels block)
+{
+    const uint16_t color0 = ReadUInt16(in + 0);
+    const uint16_t color1 = ReadUInt16(in + 2);
+
+    Byte palette[4][4];
+    FromRGB565(color0, palette[0]);
+    FromRGB565(color1, palette[1]);
+    palette[0][3] = palette[1][3] = palette[2][3] = palette[3][3] = 255;
+    if (forceFourColors || color0 > color1)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            palette[2][c] =
+                SCAST<Byte>((2 * palette[0][c] + palette[1][c]) / 3);
+            palette[3][c] =
+                SCAST<Byte>((palette[0][c] + 2 * palette[1][c]) / 3);
+        }
+    }
+    else
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            palette[2][c] = SCAST<Byte>((palette[0][c] + palette[1][c]) / 2);
+            palette[3][c] = 0;
+        }
+        palette[3][3] = 0;
+    }
+
+    const uint32_t indices =
+        (in[4] | (in[5] << 8) | (in[6] << 16) | (SCAST<uint32_t>(in[7]) << 24));
+    for (int i = 0; i < NumBlockPixels; ++i)
+    {
+        const uint index = (indices >> (i * 2)) & 3;
+        std::memcpy(block + i * 4, palette[index], 4);
+    }
+}
+
+// Single channel block (BC4), used for the alpha of BC3 and for both
+// channels of BC5
+void EncodeChannelBlock(const BlockPixels block, int channel, Byte *out)
+{
+    Byte minValue = 255, maxValue = 0;
+    for (int i = 0; i < NumBlockPixels; ++i)
+    {
+        minValue = Math::Min(minValue, block[i * 4 + channel]);
+        maxValue = Math::Max(maxValue, block[i * 4 + channel]);
+    }
+
+    // value0 > value1 selects the 8 values mode
+    int palette[8];
+    palette[0] = maxValue;
+    palette[1] = minValue;
+    for (int p = 2; p < 8; ++p)
+    {
+        palette[p] = ((8 - p) * palette[0] + (p - 1) * palette[1]) / 7;
+    }
+
+    uint64_t indices = 0;
+    if (maxValue != minValue)
+    {
+        for (int i = 0; i < NumBlockPixels; ++i)
+        {
+            uint64_t bestIndex = 0;
+            int bestDist = std::numeric_limits<int>::max();
+            for (int p = 0; p < 8; ++p)
+            {
+                const int dist =
+                    Math::Abs(SCAST<int>(block[i * 4 + channel]) - palette[p]);
+                if (dist < bestDist)
+                {
+                    bestDist = dist;
+                    bestIndex = p;
+                }
+            }
+            indices |= (bestIndex << (i * 3));
+        }
+    }
+
+    out[0] = maxValue;
+    out[1] = minValue;
+    for (int i = 0; i < 6; ++i)
+    {
+        out[2 + i] = SCAST<Byte>((indices >> (i * 8)) & 0xFF);
+    }
+}
+
+void DecodeChannelBlock(const Byte *in, int channel, BlockPixels block)
+{
+    int palette[8];
+    palette[0] = in[0];
+    palette[1] = in[1];
+    if (palette[0] > palette[1])
+    {
+        for (int p = 2; p < 8; ++p)
+        {
+            palette[p] = ((8 - p) * palette[0] + (p - 1) * palette[1]) / 7;
+        }
+    }
+    else
+    {
+        for (int p = 2; p < 6; ++p)
+        {
+            palette[p] = ((6 - p) * palette[0] + (p - 1) * palette[1]) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    uint64_t indices = 0;
+    for (int i = 0; i < 6; ++i)
+    {
+        indices |= (SCAST<uint64_t>(in[2 + i]) << (i * 8));
+    }
+    for (int i = 0; i < NumBlockPixels; ++i)
+    {
+        const uint index = SCAST<uint>((indices >> (i * 3)) & 7);
+        block[i * 4 + channel] = SCAST<Byte>(palette[index]);
+    }
+}
+
+void EncodeBlock(const BlockPixels block,
+                 TextureCompression compression,
+                 Byte *out)
+{
+    switch (compression)
+    {
+        case TextureCompression::BC1: EncodeColorBlock(block, out); break;
+
+        case TextureCompression::BC3:
+            EncodeChannelBlock(block, 3, out);
+            EncodeColorBlock(block, out + 8);
+            break;
+
+        case TextureCompression::BC5:
+            EncodeChannelBlock(block, 0, out);
+            EncodeChannelBlock(block, 1, out + 8);
+            break;
+
+        default: ASSERT(false);
+    }
+}
+
+void DecodeBlock(const Byte *in,
+                 TextureCompression compression,
+                 BlockPixels block)
+{
+    switch (compression)
+    {
+        case TextureCompression::BC1:
+            DecodeColorBlock(in, false, block);
+            break;
+
+        case TextureCompression::BC3:
+            DecodeColorBlock(in + 8, true, block);
+            DecodeChannelBlock(in, 3, block);
+            break;
+
+        case TextureCompression::BC5:
+            for (int i = 0; i < NumBlockPixels; ++i)
+            {
+                block[i * 4 + 2] = 0;
+                block[i * 4 + 3] = 255;
+            }
+            DecodeChannelBlock(in, 0, block);
+            DecodeChannelBlock(in + 8, 1, block);
+            break;
+
+        default: ASSERT(false);
+    }
+}
+
+Vector2i GetNumBlocks(const Vector2i &size)
+{
+    return (size + (BlockSize - 1)) / BlockSize;
+}
+}  // namespace
+
+void TextureCompressor::Compress(const Image &image,
+                                 TextureCompression compression,
+                                 Array<Byte> *compressedData)
+{
+    ASSERT(compression != TextureCompression::NONE);
+
+    const Vector2i numBlocks = GetNumBlocks(image.GetSize());
+    const uint blockBytesSize = GetBlockBytesSize(compression);
+    compressedData->Resize(
+        GetCompressedBytesSize(image.GetSize(), compression));
+    if (compressedData->IsEmpty())
+    {
+        return;
+    }
+
+    Byte *outData = compressedData->Data();
+    auto compressBlockRows = [&](uint beginBlockY, uint endBlockY) {
+        BlockPixels block;
+        for (uint blockY = beginBlockY; blockY < endBlockY; ++blockY)
+        {
+            for (int blockX = 0; blockX < numBlocks.x; ++blockX)
+            {
+                ReadBlock(image, blockX, blockY, block);
+                EncodeBlock(block,
+                            compression,
+                            outData + (blockY * numBlocks.x + blockX) *
+                                          blockBytesSize);
+            }
+        }
+    };
+
+    if (JobSystem *jobSystem = JobSystem::GetInstance())
+    {
+        jobSystem->ParallelFor(0, numBlocks.y, 4, compressBlockRows);
+    }
+    else
+    {
+        compressBlockRows(0, numBlocks.y);
+    }
+}
+
+void TextureCompressor::Decompress(const Byte *compressedData,
+                                   const Vector2i &size,
+                                   TextureCompression compression,
+                                   Image *image)
+{
+    ASSERT(compression != TextureCompression::NONE);
+
+    image->Create(size.x, size.y);
+
+    const Vector2i numBlocks = GetNumBlocks(size);
+    const uint blockBytesSize = GetBlockBytesSize(compression);
+    BlockPixels block;
+    for (int blockY = 0; blockY < numBlocks.y; ++blockY)
+    {
+        for (int blockX = 0; blockX < numBlocks.x; ++blockX)
+        {
+            DecodeBlock(compressedData + (blockY * numBlocks.x + blockX) *
+                                             blockBytesSize,
+                        compression,
+                        block);
+            WriteBlock(block, blockX, blockY, image);
+        }
+    }
+}
+
+void TextureCompressor::CompressMipMaps(const Image &image,
+                                        TextureCompression compression,
+                                        Array<CompressedMipMap> *mipMaps)
+{
+    mipMaps->Clear();
+
+    Image mipMapImage = image;
+    while (true)
+    {
+        CompressedMipMap mipMap;
+        mipMap.size = mipMapImage.GetSize();
+        Compress(mipMapImage, compression, &mipMap.data);
+        mipMaps->PushBack(mipMap);
+
+        if (mipMap.size.x <= 1 && mipMap.size.y <= 1)
+        {
+            break;
+        }
+
+        const Vector2i nextSize =
+            Vector2i::Max(mipMap.size / 2, Vector2i::One());
+        mipMapImage.Resize(nextSize, ImageResizeMode::LINEAR);
+    }
+}
+
+uint TextureCompressor::GetBlockBytesSize(TextureCompression compression)
+{
+    switch (compression)
+    {
+        case TextureCompression::BC1: return 8;
+        case TextureCompression::BC3:
+        case TextureCompression::BC5: return 16;
+        default: break;
+    }
+    return 0;
+}
+
+uint TextureCompressor::GetCompressedBytesSize(const Vector2i &size,
+                                               TextureCompression compression)
+{
+    const Vector2i numBlocks = GetNumBlocks(size);
+    return numBlocks.x * numBlocks.y * GetBlockBytesSize(compression);
+}
+
+GLenum TextureCompressor::GetGLInternalFormat(TextureCompression compression,
+                                              bool sRGB)
+{
+    switch (compression)
+    {
+        case TextureCompression::BC1:
+            return sRGB ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+                        : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case TextureCompression::BC3:
+            return sRGB ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+                        : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case TextureCompression::BC5: return GL_COMPRESSED_RG_RGTC2;
+        default: break;
+    }
+    return GL_NONE;
+}
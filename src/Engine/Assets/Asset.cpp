@@ -197,6 +197,26 @@ void Asset::Import_(const Path &assetFilepath)
                                                      this);
 }
 
+void Asset::Import_(const Path &assetFilepath, const MetaNode &metaNode)
+{
+    Import(assetFilepath);
+    ImportMeta(metaNode);
+
+    EventEmitter<IEventsAsset>::PropagateToListeners(&IEventsAsset::OnImported,
+                                                     this);
+}
+
+void Asset::PreImport(const Path &assetFilepath)
+{
+    BANG_UNUSED(assetFilepath);
+}
+
+void Asset::LoadDependenciesAsync(
+    Array<std::shared_ptr<AssetLoadRequest>> *dependencies)
+{
+    BANG_UNUSED(dependencies);
+}
+
 void Asset::ClearEmbeddedAssets()
 {
     while (!m_embeddedAssets.IsEmpty())
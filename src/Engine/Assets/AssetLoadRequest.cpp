@@ -0,0 +1,40 @@
+#include "Bang/AssetLoadRequest.h"
+
+#include "Bang/Asset.h"
+#include "Bang/Assets.h"
+
+using namespace Bang;
+
+AssetLoadRequest::AssetLoadRequest() : m_preImported(false)
+{
+}
+
+AssetLoadRequest::~AssetLoadRequest()
+{
+}
+
+void AssetLoadRequest::Wait()
+{
+    if (!IsFinished())
+    {
+        if (Assets *assets = Assets::GetInstance())
+        {
+            assets->WaitForAsyncLoad(this);
+        }
+    }
+}
+
+bool AssetLoadRequest::IsFinished() const
+{
+    return m_finished;
+}
+
+Asset *AssetLoadRequest::GetAsset() const
+{
+    return m_loadedAsset.Get();
+}
+
+const Path &AssetLoadRequest::GetAssetFilepath() const
+{
+    return m_assetFilepath;
+}
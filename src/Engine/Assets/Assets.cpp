@@ -18,6 +18,7 @@
 #include "Bang/File.h"
 #include "Bang/GUID.h"
 #include "Bang/IEventsDestroy.h"
+#include "Bang/JobSystem.h"
 #include "Bang/MaterialFactory.h"
 #include "Bang/MeshFactory.h"
 #include "Bang/MetaFilesManager.h"
@@ -82,7 +83,7 @@ void Assets::CreateAssetMetaAndImportFile(const Asset *asset,
 {
     File::Write(exportFilepath, "");
     Path metaFilePath = MetaFilesManager::GetMetaFilepath(exportFilepath);
-    asset->ExportMetaToFile(metaFilePath);
+    asset->ExportMetaToFile(metaFilePath, MetaFilesManager::GetMetaFormat());
     MetaFilesManager::RegisterMetaFilepath(metaFilePath);  // Once created
 }
 
@@ -174,6 +175,333 @@ AH<Asset> Assets::Load_(std::function<Asset *()> creator, const GUID &guid)
     return assetAH;
 }
 
+std::shared_ptr<AssetLoadRequest> Assets::LoadAsync_(
+    std::function<Asset *()> creator,
+    const Path &filepath)
+{
+    std::shared_ptr<AssetLoadRequest> request =
+        std::make_shared<AssetLoadRequest>();
+    request->m_assetFilepath = filepath;
+
+    if (m_beingDestroyed || filepath.IsEmpty())
+    {
+        request->m_finished = true;
+        return request;
+    }
+
+    if (std::shared_ptr<AssetLoadRequest> pendingRequest =
+            GetAsyncLoadRequest(filepath))
+    {
+        return pendingRequest;
+    }
+
+    if (Assets::IsEmbeddedAsset(filepath))
+    {
+        // Embedded assets are loaded along with their parent model
+        const Path parentPath = filepath.GetDirectory();
+        if (parentPath.HasExtension(Extensions::GetModelExtensions()))
+        {
+            auto modelCreator = []() -> Asset * {
+                return SCAST<Asset *>(Assets::Create_<Model>());
+            };
+            request->m_parentRequest = LoadAsync_(modelCreator, parentPath);
+        }
+        else
+        {
+            request->m_finished = true;
+            return request;
+        }
+    }
+    else if (!filepath.IsFile())
+    {
+        Debug_Warn("Filepath '" << filepath.GetAbsolute() << "' not found");
+        request->m_finished = true;
+        return request;
+    }
+    else if (Asset *cachedAsset = GetCached_(filepath))
+    {
+        request->m_loadedAsset.Set(cachedAsset);
+        request->m_finished = true;
+        return request;
+    }
+    else
+    {
+        Asset *asset = creator();
+        GUID assetGUID = MetaFilesManager::GetGUID(filepath);
+        if (assetGUID.IsEmpty())
+        {
+            // Not registered yet (e.g. no meta file yet): take the GUID of
+            // its meta, or a new one
+            assetGUID = MetaFilesManager::RegisterFilepath(filepath);
+        }
+        else
+        {
+            MetaFilesManager::RegisterFilepathGUID(filepath, assetGUID);
+        }
+        asset->SetGUID(assetGUID);
+
+        request->p_loadingAsset = asset;
+        request->m_assetGUID = assetGUID;
+        request->m_metaFilepath = MetaFilesManager::GetMetaFilepath(filepath);
+    }
+
+    m_asyncLoadRequests.PushBack(request);
+    TryStartPreImport(request);
+    return request;
+}
+
+std::shared_ptr<AssetLoadRequest> Assets::LoadAsync_(
+    std::function<Asset *()> creator,
+    const GUID &guid)
+{
+    if (guid.IsEmpty() || m_beingDestroyed)
+    {
+        std::shared_ptr<AssetLoadRequest> request =
+            std::make_shared<AssetLoadRequest>();
+        request->m_finished = true;
+        return request;
+    }
+
+    if (Asset *cachedAsset = GetCached_(guid))
+    {
+        std::shared_ptr<AssetLoadRequest> request =
+            std::make_shared<AssetLoadRequest>();
+        request->m_assetGUID = guid;
+        request->m_loadedAsset.Set(cachedAsset);
+        request->m_finished = true;
+        return request;
+    }
+
+    if (!Assets::IsEmbeddedAsset(guid))
+    {
+        return LoadAsync_(creator, MetaFilesManager::GetFilepath(guid));
+    }
+
+    std::shared_ptr<AssetLoadRequest> request =
+        std::make_shared<AssetLoadRequest>();
+    request->m_assetGUID = guid;
+
+    const Path parentPath =
+        MetaFilesManager::GetFilepath(guid.WithoutEmbeddedAssetGUID());
+    if (parentPath.HasExtension(Extensions::GetModelExtensions()))
+    {
+        auto modelCreator = []() -> Asset * {
+            return SCAST<Asset *>(Assets::Create_<Model>());
+        };
+        request->m_parentRequest = LoadAsync_(modelCreator, parentPath);
+        m_asyncLoadRequests.PushBack(request);
+    }
+    else
+    {
+        request->m_finished = true;
+    }
+    return request;
+}
+
+std::shared_ptr<AssetLoadRequest> Assets::GetAsyncLoadRequest(
+    const Path &path) const
+{
+    for (const std::shared_ptr<AssetLoadRequest> &request :
+         m_asyncLoadRequests)
+    {
+        if (request->GetAssetFilepath() == path)
+        {
+            return request;
+        }
+    }
+    return nullptr;
+}
+
+void Assets::PreImport(AssetLoadRequest *request)
+{
+    request->p_loadingAsset->PreImport(request->m_assetFilepath);
+    if (request->m_metaFilepath.IsFile())
+    {
+        request->m_metaNode.Import(request->m_metaFilepath);
+        request->m_hasMetaNode = true;
+    }
+    request->m_preImported = true;
+}
+
+void Assets::TryStartPreImport(
+    const std::shared_ptr<AssetLoadRequest> &request)
+{
+    if (request->m_preImportStarted || !request->p_loadingAsset)
+    {
+        return;
+    }
+
+    // The request is shared with the job, so that it stays alive even if
+    // everyone else drops it while it is being pre-imported
+    std::shared_ptr<AssetLoadRequest> sharedRequest = request;
+    auto preImport = [sharedRequest]() {
+        Assets::PreImport(sharedRequest.get());
+    };
+
+    request->m_preImportStarted = true;
+    if (JobSystem *jobSystem = JobSystem::GetInstance())
+    {
+        request->m_preImportJob = jobSystem->Schedule(preImport);
+    }
+    else
+    {
+        // No engine job workers (no Application), just run it right away
+        preImport();
+    }
+}
+
+bool Assets::TryFinishAsyncLoad(
+    const std::shared_ptr<AssetLoadRequest> &request)
+{
+    if (request->m_finished)
+    {
+        return true;
+    }
+
+    if (request->m_parentRequest)
+    {
+        const std::shared_ptr<AssetLoadRequest> &parentRequest =
+            request->m_parentRequest;
+        if (!parentRequest->IsFinished())
+        {
+            return false;
+        }
+
+        if (Asset *parentAsset = parentRequest->GetAsset())
+        {
+            request->m_loadedAsset.Set(
+                request->m_assetGUID.IsEmpty()
+                    ? parentAsset->GetEmbeddedAsset(
+                          request->GetAssetFilepath().GetNameExt())
+                    : parentAsset->GetEmbeddedAsset(request->m_assetGUID));
+        }
+        request->m_parentRequest = nullptr;
+        request->m_finished = true;
+        return true;
+    }
+
+    if (!request->m_preImported)
+    {
+        return false;
+    }
+
+    Asset *asset = request->p_loadingAsset;
+    if (!request->m_dependenciesStarted)
+    {
+        asset->LoadDependenciesAsync(&request->m_dependencies);
+        request->m_dependenciesStarted = true;
+    }
+
+    for (const std::shared_ptr<AssetLoadRequest> &dependency :
+         request->m_dependencies)
+    {
+        if (!dependency->IsFinished())
+        {
+            return false;
+        }
+    }
+
+    if (Asset *cachedAsset = GetCached_(asset->GetGUID()))
+    {
+        // It has been loaded synchronously in the meantime, discard ours
+        delete asset;
+        request->m_loadedAsset.Set(cachedAsset);
+    }
+    else
+    {
+        request->m_loadedAsset.Set(asset);
+        if (request->m_hasMetaNode)
+        {
+            asset->Import_(request->GetAssetFilepath(), request->m_metaNode);
+        }
+        else
+        {
+            asset->Import_(request->GetAssetFilepath());
+        }
+    }
+
+    request->p_loadingAsset = nullptr;
+    request->m_preImportJob = nullptr;
+    request->m_metaNode = MetaNode();
+    request->m_dependencies.Clear();
+    request->m_finished = true;
+    return true;
+}
+
+void Assets::UpdateAsyncLoads()
+{
+    const Time beginTime = Time::GetNow();
+
+    // Requests can be added while finishing others (dependencies), so work
+    // on a copy. Those will be handled in the next update.
+    const Array<std::shared_ptr<AssetLoadRequest>> requests =
+        m_asyncLoadRequests;
+    for (const std::shared_ptr<AssetLoadRequest> &request : requests)
+    {
+        TryStartPreImport(request);
+    }
+
+    for (const std::shared_ptr<AssetLoadRequest> &request : requests)
+    {
+        if (Time::GetPassedTimeSince(beginTime) >= GetAsyncLoadsTimeBudget())
+        {
+            break;
+        }
+        TryFinishAsyncLoad(request);
+    }
+
+    RemoveFinishedAsyncLoadRequests();
+}
+
+void Assets::WaitForAsyncLoad(AssetLoadRequest *request)
+{
+    // Finishing a request can add the requests of its dependencies, so this
+    // goes on until ours is finished. Waiting on the pre-import jobs runs
+    // jobs on this thread instead of sleeping
+    JobSystem *jobSystem = JobSystem::GetInstance();
+    while (!request->IsFinished())
+    {
+        const Array<std::shared_ptr<AssetLoadRequest>> requests =
+            m_asyncLoadRequests;
+        for (const std::shared_ptr<AssetLoadRequest> &pendingRequest :
+             requests)
+        {
+            TryStartPreImport(pendingRequest);
+            if (jobSystem)
+            {
+                jobSystem->Wait(pendingRequest->m_preImportJob);
+            }
+            TryFinishAsyncLoad(pendingRequest);
+        }
+
+        RemoveFinishedAsyncLoadRequests();
+    }
+}
+
+void Assets::RemoveFinishedAsyncLoadRequests()
+{
+    Array<std::shared_ptr<AssetLoadRequest>> pendingRequests;
+    for (const std::shared_ptr<AssetLoadRequest> &request :
+         m_asyncLoadRequests)
+    {
+        if (!request->IsFinished())
+        {
+            pendingRequests.PushBack(request);
+        }
+    }
+    m_asyncLoadRequests = pendingRequests;
+}
+
+void Assets::SetAsyncLoadsTimeBudget(Time asyncLoadsTimeBudget)
+{
+    m_asyncLoadsTimeBudget = asyncLoadsTimeBudget;
+}
+
+Time Assets::GetAsyncLoadsTimeBudget() const
+{
+    return m_asyncLoadsTimeBudget;
+}
+
 Asset *Assets::GetCached_(const GUID &guid) const
 {
     if (m_assetsCache.ContainsKey(guid))
@@ -340,6 +668,20 @@ void Assets::Destroy()
 {
     m_beingDestroyed = true;
 
+    for (const std::shared_ptr<AssetLoadRequest> &request :
+         m_asyncLoadRequests)
+    {
+        // Assets still being pre-imported by a worker are leaked on purpose,
+        // since they can not be deleted from under it
+        if (request->p_loadingAsset &&
+            (!request->m_preImportStarted || request->m_preImported))
+        {
+            delete request->p_loadingAsset;
+            request->p_loadingAsset = nullptr;
+        }
+    }
+    m_asyncLoadRequests.Clear();
+
 #define B_DESTROY_AND_NULL(p) \
     if (p)                    \
     {                         \
@@ -9,12 +9,15 @@
 #include "Bang/Array.h"
 #include "Bang/Array.tcc"
 #include "Bang/AudioManager.h"
+#include "Bang/AudioStream.h"
 #include "Bang/Debug.h"
 #include "Bang/MetaNode.h"
 #include "Bang/StreamOperators.h"
 
 using namespace Bang;
 
+uint AudioClip::s_streamingSizeThreshold = (1024 * 1024);
+
 AudioClip::AudioClip()
 {
     AudioManager::ClearALErrors();
@@ -24,6 +27,7 @@ AudioClip::AudioClip()
 
 AudioClip::~AudioClip()
 {
+    AudioManager::DettachSourcesFromAudioClip(this);
     FreeBuffer();
 }
 
@@ -37,35 +41,47 @@ void AudioClip::Import(const Path &soundFilepath)
     AudioManager::ClearALErrors();
     AudioManager::DettachSourcesFromAudioClip(this);
     FreeBuffer();
-    alGenBuffers(1, &m_alBufferId);
-    AudioManager::CheckALError();
+    m_streaming = false;
 
     SF_INFO soundInfo;
+    soundInfo.format = 0;
     SNDFILE *soundFile =
         sf_open(soundFilepath.GetAbsolute().ToCString(), SFM_READ, &soundInfo);
     if (!soundFile)
     {
         Debug_Error("Error loading sound file '" << soundFilepath << "'");
+        m_soundFilepath = Path::Empty();
+        return;
+    }
+
+    // Always mono, so that attenuation works
+    const uint numFrames = SCAST<uint>(soundInfo.frames);
+    const uint decodedSize = numFrames * sizeof(short);
+    if (decodedSize > AudioClip::GetStreamingSizeThreshold())
+    {
+        // Each played voice opens its own AudioStream
+        sf_close(soundFile);
+        m_streaming = true;
+        m_streamingFrequency = soundInfo.samplerate;
+        m_streamingNumFrames = numFrames;
+        m_soundFilepath = soundFilepath;
         return;
     }
 
-    constexpr int bufferSize = 4096;
-    Array<short> buffer(bufferSize);
     Array<short> readData;
-    while (true)
+    readData.Reserve(numFrames);
+    constexpr uint readFrames = 4096;
+    while (AudioStream::ReadMonoFrames(
+               soundFile, soundInfo.channels, readFrames, &readData) > 0)
     {
-        size_t readSize = sf_read_short(soundFile, &buffer.Front(), bufferSize);
-        if (readSize <= 0)
-        {
-            break;
-        }
-        readData.PushBack(buffer.begin(), buffer.begin() + readSize);
     }
+    sf_close(soundFile);
 
     AudioManager::ClearALErrors();
+    alGenBuffers(1, &m_alBufferId);
     alBufferData(m_alBufferId,
-                 AL_FORMAT_MONO16,  // Always mono, so that attenuation works
-                 &readData.Front(),
+                 AL_FORMAT_MONO16,
+                 readData.Data(),
                  readData.Size() * sizeof(short),
                  soundInfo.samplerate);
     bool hasError = AudioManager::CheckALError();
@@ -87,6 +103,11 @@ int AudioClip::GetChannels() const
         return 0;
     }
 
+    if (IsStreaming())
+    {
+        return 1;
+    }
+
     int channels;
     alGetBufferi(m_alBufferId, AL_CHANNELS, &channels);
     return channels;
@@ -99,6 +120,11 @@ int AudioClip::GetBufferSize() const
         return 0;
     }
 
+    if (IsStreaming())
+    {
+        return SCAST<int>(m_streamingNumFrames * sizeof(short));
+    }
+
     int bSize;
     alGetBufferi(m_alBufferId, AL_SIZE, &bSize);
     return bSize;
@@ -111,6 +137,11 @@ int AudioClip::GetBitDepth() const
         return 0;
     }
 
+    if (IsStreaming())
+    {
+        return 16;
+    }
+
     int bitDepth;
     alGetBufferi(m_alBufferId, AL_BITS, &bitDepth);
     return bitDepth;
@@ -123,6 +154,11 @@ int AudioClip::GetFrequency() const
         return 0;
     }
 
+    if (IsStreaming())
+    {
+        return m_streamingFrequency;
+    }
+
     int freq;
     alGetBufferi(m_alBufferId, AL_FREQUENCY, &freq);
     return freq;
@@ -146,7 +182,22 @@ ALuint AudioClip::GetALBufferId() const
 
 bool AudioClip::IsLoaded() const
 {
-    return m_alBufferId != 0;
+    return (m_alBufferId != 0) || IsStreaming();
+}
+
+bool AudioClip::IsStreaming() const
+{
+    return m_streaming;
+}
+
+void AudioClip::SetStreamingSizeThreshold(uint streamingSizeThresholdBytes)
+{
+    AudioClip::s_streamingSizeThreshold = streamingSizeThresholdBytes;
+}
+
+uint AudioClip::GetStreamingSizeThreshold()
+{
+    return AudioClip::s_streamingSizeThreshold;
 }
 
 const Path &AudioClip::GetSoundFilepath() const
@@ -156,7 +207,7 @@ const Path &AudioClip::GetSoundFilepath() const
 
 void AudioClip::FreeBuffer()
 {
-    if (IsLoaded())
+    if (m_alBufferId != 0)
     {
         alDeleteBuffers(1, &m_alBufferId);
         m_alBufferId = 0;
@@ -14,6 +14,7 @@
 #include "Bang/Shader.h"
 #include "Bang/ShaderProgram.h"
 #include "Bang/ShaderProgramFactory.h"
+#include "Bang/USet.tcc"
 #include "Bang/Texture2D.h"
 #include "Bang/TextureFactory.h"
 
@@ -96,22 +97,22 @@ void Material::SetNormalMapMultiplyFactor(float normalMapMultiplyFactor)
 
 void Material::SetShaderProgram(ShaderProgram *program)
 {
-    if (program != GetShaderProgram())
+    if (program != GetBaseShaderProgram())
     {
-        if (GetShaderProgram())
+        if (ShaderProgram *prevProgram = GetBaseShaderProgram())
         {
-            GetShaderProgram()->EventEmitter<IEventsAsset>::UnRegisterListener(
-                this);
+            prevProgram->EventEmitter<IEventsAsset>::UnRegisterListener(this);
         }
 
         p_shaderProgram.Set(program);
+        p_shaderProgramVariant = nullptr;
 
-        if (GetShaderProgram())
+        if (GetBaseShaderProgram())
         {
             SetShaderProgramProperties(
-                GetShaderProgram()->GetLoadedProperties());
-            GetShaderProgram()->EventEmitter<IEventsAsset>::RegisterListener(
-                this);
+                GetBaseShaderProgram()->GetLoadedProperties());
+            GetBaseShaderProgram()
+                ->EventEmitter<IEventsAsset>::RegisterListener(this);
         }
 
         PropagateAssetChanged();
@@ -202,6 +203,7 @@ void Material::SetNormalMapTexture(Texture2D *texture)
         }
 
         p_normalMapTexture.Set(texture);
+        SetKeywordEnabled("BANG_NORMAL_MAPPING", (texture != nullptr));
         if (ShaderProgram *sp = GetShaderProgram())
         {
             sp->SetTexture2D(GLUniforms::UniformName_NormalMapTexture,
@@ -218,6 +220,23 @@ void Material::SetNormalMapTexture(Texture2D *texture)
     }
 }
 
+void Material::SetKeywordEnabled(const String &keyword, bool enabled)
+{
+    if (enabled != IsKeywordEnabled(keyword))
+    {
+        if (enabled)
+        {
+            m_enabledKeywords.Add(keyword);
+        }
+        else
+        {
+            m_enabledKeywords.Remove(keyword);
+        }
+        p_shaderProgramVariant = nullptr;
+        PropagateAssetChanged();
+    }
+}
+
 void Material::SetShaderProgramProperties(
     const ShaderProgramProperties &spProps)
 {
@@ -245,9 +264,28 @@ float Material::GetNormalMapMultiplyFactor() const
     return m_normalMapMultiplyFactor;
 }
 ShaderProgram *Material::GetShaderProgram() const
+{
+    if (!p_shaderProgramVariant)
+    {
+        if (ShaderProgram *sp = GetBaseShaderProgram())
+        {
+            p_shaderProgramVariant = sp->GetVariant(GetEnabledKeywords());
+        }
+    }
+    return p_shaderProgramVariant;
+}
+ShaderProgram *Material::GetBaseShaderProgram() const
 {
     return p_shaderProgram.Get();
 }
+bool Material::IsKeywordEnabled(const String &keyword) const
+{
+    return GetEnabledKeywords().Contains(keyword);
+}
+const USet<String> &Material::GetEnabledKeywords() const
+{
+    return m_enabledKeywords;
+}
 Texture2D *Material::GetAlbedoTexture() const
 {
     return p_albedoTexture.Get();
@@ -384,11 +422,15 @@ void Material::BindMaterialUniforms(ShaderProgram *sp) const
             sp->SetFloat(GLUniforms::UniformName_NormalMapMultiplyFactor,
                          GetNormalMapMultiplyFactor());
             sp->SetBool(GLUniforms::UniformName_HasNormalMapTexture, true);
+            sp->SetBool(GLUniforms::UniformName_NormalMapIsRG,
+                        normalMapTex->GetCompression() ==
+                            TextureCompression::BC5);
         }
         else
         {
             sp->SetTexture2D(GLUniforms::UniformName_NormalMapTexture, nullptr);
             sp->SetBool(GLUniforms::UniformName_HasNormalMapTexture, false);
+            sp->SetBool(GLUniforms::UniformName_NormalMapIsRG, false);
         }
     }
 }
@@ -401,14 +443,52 @@ void Material::UnBind() const
     }
 }
 
-void Material::OnAssetChanged(Asset *)
+void Material::OnAssetChanged(Asset *changedAsset)
 {
+    // A linked again program has dropped its variants
+    if (changedAsset == GetBaseShaderProgram())
+    {
+        p_shaderProgramVariant = nullptr;
+    }
     PropagateAssetChanged();
 }
 
 void Material::Import(const Path &materialFilepath)
 {
-    ImportMetaFromFile(materialFilepath);
+    if (m_hasPreImportedMeta)
+    {
+        ImportMeta(m_preImportedMeta);
+        m_preImportedMeta = MetaNode();
+        m_hasPreImportedMeta = false;
+    }
+    else
+    {
+        ImportMetaFromFile(materialFilepath);
+    }
+}
+
+void Material::PreImport(const Path &materialFilepath)
+{
+    m_preImportedMeta = MetaNode();
+    m_preImportedMeta.Import(materialFilepath);
+    m_hasPreImportedMeta = true;
+}
+
+void Material::LoadDependenciesAsync(
+    Array<std::shared_ptr<AssetLoadRequest>> *dependencies)
+{
+    for (const char *textureVarName : {"Albedo Texture",
+                                       "Normal Texture",
+                                       "Roughness Texture",
+                                       "Metalness Texture"})
+    {
+        const GUID textureGUID = m_preImportedMeta.Get<GUID>(textureVarName);
+        if (!textureGUID.IsEmpty())
+        {
+            dependencies->PushBack(
+                Assets::LoadAsync<Texture2D>(textureGUID).GetRequest());
+        }
+    }
 }
 
 void Material::Reflect()
@@ -502,10 +582,31 @@ void Material::Reflect()
 
     BANG_REFLECT_VAR_ASSET("Shader Program",
                            SetShaderProgram,
-                           GetShaderProgram,
+                           GetBaseShaderProgram,
                            ShaderProgram,
                            BANG_REFLECT_HINT_ZOOMABLE_PREVIEW(false) +
                                BANG_REFLECT_HINT_EXTENSIONS(extensions));
+
+    ReflectVar<String>(
+        "Keywords",
+        [this](const String &keywordsStr) {
+            for (const String &keyword : GetEnabledKeywords().GetKeys())
+            {
+                SetKeywordEnabled(keyword, false);
+            }
+            for (const String &keyword : keywordsStr.Split<Array>(' ', true))
+            {
+                if (!keyword.IsEmpty())
+                {
+                    SetKeywordEnabled(keyword, true);
+                }
+            }
+        },
+        [this]() {
+            Array<String> keywords = GetEnabledKeywords().GetKeys();
+            keywords.Sort();
+            return String::Join(keywords, " ");
+        });
 }
 
 void Material::CloneInto(ICloneable *clone, bool cloneGUID) const
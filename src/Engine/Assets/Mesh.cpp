@@ -1,6 +1,7 @@
 #include "Bang/Mesh.h"
 
 #include <sys/types.h>
+#include <atomic>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -15,11 +16,14 @@
 #include "Bang/IBO.h"
 #include "Bang/IToString.h"
 #include "Bang/Math.h"
+#include "Bang/MeshLODCache.h"
 #include "Bang/MeshSimplifier.h"
 #include "Bang/MetaNode.h"
 #include "Bang/Ray.h"
 #include "Bang/Set.h"
 #include "Bang/Set.tcc"
+#include "Bang/Thread.h"
+#include "Bang/ThreadPool.h"
 #include "Bang/Triangle.h"
 #include "Bang/UMap.tcc"
 #include "Bang/USet.h"
@@ -36,6 +40,74 @@ class Path;
 
 using namespace Bang;
 
+struct Mesh::LODsGenerationTask
+{
+    MeshSimplifier::MeshData meshData;
+    Path modelFilepath;
+    GUID::GUIDType meshEmbeddedGUID;
+    Array<MeshSimplifier::LODData> lodsData;
+    std::atomic<bool> started;
+    std::atomic<bool> finished;
+
+    LODsGenerationTask() : started(false), finished(false)
+    {
+    }
+};
+
+static constexpr MeshSimplifier::SimplificationMethod LODsSimplificationMethod =
+    MeshSimplifier::SimplificationMethod::QUADRIC_ERROR_METRICS;
+
+static Array<MeshSimplifier::LODData> GetOrGenerateLODsData(
+    const MeshSimplifier::MeshData &meshData,
+    const Path &modelFilepath,
+    GUID::GUIDType meshEmbeddedGUID)
+{
+    const Hash::HashType meshDataHash =
+        MeshLODCache::GetMeshDataHash(meshData, LODsSimplificationMethod);
+    const Path cacheFilepath = MeshLODCache::GetCacheFilepath(
+        modelFilepath, meshEmbeddedGUID, meshDataHash);
+
+    Array<MeshSimplifier::LODData> lodsData;
+    if (!MeshLODCache::Read(cacheFilepath, meshDataHash, &lodsData))
+    {
+        lodsData = MeshSimplifier::GetAllMeshLODsData(meshData,
+                                                      LODsSimplificationMethod);
+        MeshLODCache::Write(cacheFilepath, meshDataHash, lodsData);
+    }
+    return lodsData;
+}
+
+static ThreadPool *GetLODsThreadPool()
+{
+    static ThreadPool lodsThreadPool;
+    lodsThreadPool.SetName("BangLODsThread");
+    lodsThreadPool.SetMaxThreadCount(
+        Math::Max(SCAST<int>(std::thread::hardware_concurrency()) - 1, 1));
+    return &lodsThreadPool;
+}
+
+bool Mesh::TryStartLODsGenerationTask(
+    const std::shared_ptr<LODsGenerationTask> &task)
+{
+    // The task is shared, so that it stays alive if the mesh is destroyed or
+    // discards it while it is being generated
+    std::shared_ptr<LODsGenerationTask> sharedTask = task;
+    ThreadRunnable *runnable = new ThreadRunnableLambda([sharedTask]() {
+        sharedTask->lodsData =
+            GetOrGenerateLODsData(sharedTask->meshData,
+                                  sharedTask->modelFilepath,
+                                  sharedTask->meshEmbeddedGUID);
+        sharedTask->finished = true;
+    });
+
+    task->started = GetLODsThreadPool()->TryStart(runnable);
+    if (!task->started)
+    {
+        delete runnable;  // Pool is full, we will retry later
+    }
+    return task->started;
+}
+
 Mesh::Mesh() : m_bBox(Vector3::Zero())
 {
     m_vao = new VAO();
@@ -79,6 +151,7 @@ void Mesh::SetTrianglesVertexIds(const Array<Mesh::VertexId> &trisVerticesIds)
     }
     m_vao->SetIBO(m_vertexIdsIBO);  // Bind to VAO
     m_areLodsValid = false;
+    m_lodsGenerationTask = nullptr;
 }
 
 void Mesh::SetBonesIds(const Map<String, uint> &bonesIds)
@@ -523,32 +596,86 @@ void Mesh::CalculateLODs()
 {
     if (!m_areLodsValid)
     {
-        m_lodMeshes = MeshSimplifier::GetAllMeshLODs(
-            this,
-            // MeshSimplifier::Method::CLUSTERING);
-            MeshSimplifier::SimplificationMethod::QUADRIC_ERROR_METRICS);
+        m_lodsGenerationTask = nullptr;
+
+        const Array<MeshSimplifier::LODData> lodsData =
+            GetOrGenerateLODsData(MeshSimplifier::GetMeshData(this),
+                                  GetModelFilepath(),
+                                  GetGUID().GetEmbeddedAssetGUID());
+
+        m_lodMeshes.Clear();
+        for (const MeshSimplifier::LODData &lodData : lodsData)
+        {
+            m_lodMeshes.PushBack(
+                MeshSimplifier::CreateMeshFromLODData(lodData));
+        }
+        m_areLodsValid = true;
+    }
+}
+
+void Mesh::CalculateLODsAsync()
+{
+    if (m_areLodsValid || IsCalculatingLODs())
+    {
+        return;
+    }
+
+    m_lodsGenerationTask = std::make_shared<LODsGenerationTask>();
+    m_lodsGenerationTask->meshData = MeshSimplifier::GetMeshData(this);
+    m_lodsGenerationTask->modelFilepath = GetModelFilepath();
+    m_lodsGenerationTask->meshEmbeddedGUID = GetGUID().GetEmbeddedAssetGUID();
+    TryStartLODsGenerationTask(m_lodsGenerationTask);
+}
+
+bool Mesh::IsCalculatingLODs() const
+{
+    return (m_lodsGenerationTask != nullptr);
+}
+
+void Mesh::RetrieveGeneratedLODsIfReady() const
+{
+    if (!m_lodsGenerationTask)
+    {
+        return;
+    }
+
+    if (!m_lodsGenerationTask->started)
+    {
+        TryStartLODsGenerationTask(m_lodsGenerationTask);
+    }
+    else if (m_lodsGenerationTask->finished)
+    {
+        m_lodMeshes.Clear();
+        for (const MeshSimplifier::LODData &lodData :
+             m_lodsGenerationTask->lodsData)
+        {
+            m_lodMeshes.PushBack(
+                MeshSimplifier::CreateMeshFromLODData(lodData));
+        }
         m_areLodsValid = true;
+        m_lodsGenerationTask = nullptr;
     }
 }
 
 int Mesh::GetNumLODs() const
 {
-    return GetLODMeshes().Size();
+    // LOD 0 is always the mesh itself
+    return GetLODMeshes().Size() + 1;
 }
 
 AH<Mesh> Mesh::GetLODMesh(int lod) const
 {
-    if (GetLODMeshes().IsEmpty())
+    const int clampedLODLevel = Math::Clamp(lod, 0, GetNumLODs() - 1);
+    if (clampedLODLevel == 0)
     {
         return AH<Mesh>(const_cast<Mesh *>(this));
     }
-
-    const int clampedLODLevel = Math::Clamp(lod, 0, GetNumLODs() - 1);
-    return GetLODMeshes()[clampedLODLevel];
+    return GetLODMeshes()[clampedLODLevel - 1];
 }
 
-const Array<AH<Mesh>> Mesh::GetLODMeshes() const
+const Array<AH<Mesh>> &Mesh::GetLODMeshes() const
 {
+    RetrieveGeneratedLODsIfReady();
     return m_lodMeshes;
 }
 
@@ -1133,6 +1260,12 @@ const Map<String, Mesh::Bone> &Mesh::GetBonesPool() const
 {
     return m_bonesPool;
 }
+Path Mesh::GetModelFilepath() const
+{
+    Asset *parentAsset = GetParentAsset();
+    return parentAsset ? parentAsset->GetAssetFilepath() : Path::Empty();
+}
+
 const Array<Mesh::VertexId> &Mesh::GetTrianglesVertexIds() const
 {
     return m_triangleVertexIds;
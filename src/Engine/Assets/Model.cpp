@@ -23,6 +23,7 @@
 #include "Bang/ModelIO.h"
 #include "Bang/SkinnedMeshRenderer.h"
 #include "Bang/StreamOperators.h"
+#include "Bang/Texture2D.h"
 #include "Bang/Transform.h"
 #include "Bang/Tree.h"
 #include "Bang/Tree.tcc"
@@ -166,13 +167,53 @@ void Model::Import(const Path &modelFilepath)
 {
     m_modelScene.Clear();
     ClearEmbeddedAssets();
-    if (!ModelIO::ImportModel(modelFilepath, this, &m_modelScene))
+
+    bool ok;
+    if (m_hasPreImportedModelData)
+    {
+        ModelIO::ImportModel(
+            modelFilepath, m_preImportedModelData, this, &m_modelScene);
+        ok = true;
+        m_preImportedModelData = ModelIOData();
+        m_preImportedTexturesFilepaths.Clear();
+        m_hasPreImportedModelData = false;
+    }
+    else
+    {
+        ok = ModelIO::ImportModel(modelFilepath, this, &m_modelScene);
+    }
+
+    if (!ok)
     {
         Debug_Error("Can not load model " << modelFilepath << ". "
                                           << "Look for errors above.");
     }
 }
 
+void Model::PreImport(const Path &modelFilepath)
+{
+    m_preImportedModelData = ModelIOData();
+    m_preImportedTexturesFilepaths.Clear();
+    m_hasPreImportedModelData =
+        ModelIO::ReadModel(modelFilepath, &m_preImportedModelData);
+    if (m_hasPreImportedModelData)
+    {
+        ModelIO::GetTexturesFilepaths(modelFilepath,
+                                      m_preImportedModelData,
+                                      &m_preImportedTexturesFilepaths);
+    }
+}
+
+void Model::LoadDependenciesAsync(
+    Array<std::shared_ptr<AssetLoadRequest>> *dependencies)
+{
+    for (const Path &textureFilepath : m_preImportedTexturesFilepaths)
+    {
+        dependencies->PushBack(
+            Assets::LoadAsync<Texture2D>(textureFilepath).GetRequest());
+    }
+}
+
 void Model::ImportMeta(const MetaNode &metaNode)
 {
     Asset::ImportMeta(metaNode);
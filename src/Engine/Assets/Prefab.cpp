@@ -30,6 +30,7 @@ Prefab::Prefab(const String &gameObjectMetaInfoContent)
 
 Prefab::~Prefab()
 {
+    InvalidateTemplateGameObject();
 }
 
 GameObject *Prefab::Instantiate() const
@@ -41,15 +42,32 @@ GameObject *Prefab::Instantiate() const
 
 GameObject *Prefab::InstantiateRaw() const
 {
-    GameObject *go = GameObjectFactory::CreateGameObject(false);
+    if (GameObject *templateGo = GetTemplateGameObject())
+    {
+        return templateGo->Clone(true);
+    }
+    return GameObjectFactory::CreateGameObject(false);
+}
 
-    if (!GetMetaContent().IsEmpty())
+GameObject *Prefab::GetTemplateGameObject() const
+{
+    if (!p_templateGameObject && !GetMetaContent().IsEmpty())
     {
         MetaNode metaNode;
         metaNode.Import(GetMetaContent());
-        go->ImportMeta(metaNode);
+        p_templateGameObject = GameObjectFactory::CreateGameObject(false);
+        p_templateGameObject->ImportMeta(metaNode);
+    }
+    return p_templateGameObject;
+}
+
+void Prefab::InvalidateTemplateGameObject()
+{
+    if (p_templateGameObject)
+    {
+        GameObject::DestroyImmediate(p_templateGameObject);
+        p_templateGameObject = nullptr;
     }
-    return go;
 }
 
 void Prefab::SetGameObject(GameObject *go)
@@ -62,6 +80,7 @@ void Prefab::SetGameObject(GameObject *go)
     {
         m_gameObjectMetaInfoContent = "";
     }
+    InvalidateTemplateGameObject();
 }
 
 const String &Prefab::GetMetaContent() const
@@ -82,6 +101,7 @@ void Prefab::ImportMeta(const MetaNode &metaNode)
     if (newMetaInfo != GetMetaContent())
     {
         m_gameObjectMetaInfoContent = newMetaInfo;
+        InvalidateTemplateGameObject();
     }
 }
 
@@ -160,10 +160,11 @@ void Serializable::ExportMeta(MetaNode *metaNode) const
 
 bool Serializable::ImportMetaFromFile(const Path &path)
 {
-    if (path.Exists())
+    if (path.IsFile())
     {
-        String fileContents = File::GetContents(path);
-        ImportMeta(fileContents);
+        MetaNode metaNode;
+        metaNode.Import(path);
+        ImportMeta(metaNode);
         return true;
     }
     return false;
@@ -171,7 +172,13 @@ bool Serializable::ImportMetaFromFile(const Path &path)
 
 bool Serializable::ExportMetaToFile(const Path &path) const
 {
-    File::Write(path, GetSerializedString());
+    // Keep the format the file already has
+    return ExportMetaToFile(path, MetaNode::GetFileFormat(path));
+}
+
+bool Serializable::ExportMetaToFile(const Path &path, MetaFormat format) const
+{
+    GetMeta().ExportToFile(path, format);
     return true;
 }
 
@@ -9,8 +9,6 @@ using namespace Bang;
 
 ALAudioSource::ALAudioSource()
 {
-    BANG_AL_CALL(alGenSources(1, &m_alSourceId));
-    UpdateALProperties();  // Initialize AL source
 }
 
 ALAudioSource::~ALAudioSource()
@@ -18,31 +16,36 @@ ALAudioSource::~ALAudioSource()
     Stop();
     EventEmitter<IEventsDestroy>::PropagateToListeners(
         &IEventsDestroy::OnDestroyed, this);
-    BANG_AL_CALL(alDeleteSources(1, &m_alSourceId));
 }
 
 void ALAudioSource::Play()
 {
-    UpdateALProperties();
-    if (GetALSourceId() > 0)
+    if (AudioManager *am = AudioManager::GetInstance())
     {
-        BANG_AL_CALL(alSourcePlay(GetALSourceId()));
+        if (IsPaused())
+        {
+            am->ResumeVoice(this);
+        }
+        else
+        {
+            am->StartVoice(this, nullptr, 0.0f);
+        }
     }
 }
 
 void ALAudioSource::Pause()
 {
-    if (GetALSourceId() > 0)
+    if (AudioManager *am = AudioManager::GetInstance())
     {
-        BANG_AL_CALL(alSourcePause(GetALSourceId()));
+        am->PauseVoice(this);
     }
 }
 
 void ALAudioSource::Stop()
 {
-    if (GetALSourceId() > 0)
+    if (AudioManager *am = AudioManager::GetInstance())
     {
-        BANG_AL_CALL(alSourceStop(GetALSourceId()));
+        am->StopVoice(this);
     }
 }
 
@@ -80,6 +83,19 @@ void ALAudioSource::SetLooping(bool looping)
     }
 }
 
+void ALAudioSource::SetPriority(uint priority)
+{
+    m_audioParams.priority = priority;
+}
+
+void ALAudioSource::SetPlayOffset(float playOffsetSeconds)
+{
+    if (AudioManager *am = AudioManager::GetInstance())
+    {
+        am->SeekVoice(this, playOffsetSeconds);
+    }
+}
+
 void ALAudioSource::SetPosition(const Vector3 &position)
 {
     if (position != GetPosition())
@@ -100,14 +116,18 @@ void ALAudioSource::SetParams(const AudioParams &audioParams)
     SetRange(audioParams.range);
     SetLooping(audioParams.looping);
     SetPosition(audioParams.position);
+    SetPriority(audioParams.priority);
 }
 
 void ALAudioSource::SetALBufferId(ALuint bufferId)
 {
-    if (bufferId != m_bufferId && (GetALSourceId() > 0))
+    if (bufferId != m_bufferId)
     {
         m_bufferId = bufferId;
-        BANG_AL_CALL(alSourcei(GetALSourceId(), AL_BUFFER, bufferId));
+        if (GetALSourceId() > 0)
+        {
+            BANG_AL_CALL(alSourcei(GetALSourceId(), AL_BUFFER, bufferId));
+        }
     }
 }
 
@@ -123,7 +143,9 @@ void ALAudioSource::UpdateALProperties() const
         BANG_AL_CALL(alSourcef(GetALSourceId(),
                                AL_REFERENCE_DISTANCE,
                                Math::Max(GetRange() * 0.5f, 0.01f)));
-        BANG_AL_CALL(alSourcei(GetALSourceId(), AL_LOOPING, GetLooping()));
+        // Streams loop by themselves, through their buffer queue
+        BANG_AL_CALL(alSourcei(
+            GetALSourceId(), AL_LOOPING, GetLooping() && !m_streaming));
         BANG_AL_CALL(
             alSourcefv(GetALSourceId(), AL_POSITION, GetPosition().Data()));
     }
@@ -141,6 +163,10 @@ bool ALAudioSource::IsStopped() const
 {
     return GetState() == State::STOPPED;
 }
+bool ALAudioSource::IsVirtual() const
+{
+    return IsPlaying() && (GetALSourceId() == 0);
+}
 float ALAudioSource::GetVolume() const
 {
     return m_audioParams.volume;
@@ -153,6 +179,15 @@ float ALAudioSource::GetRange() const
 {
     return m_audioParams.range;
 }
+uint ALAudioSource::GetPriority() const
+{
+    return m_audioParams.priority;
+}
+float ALAudioSource::GetPlayOffset() const
+{
+    AudioManager *am = AudioManager::GetInstance();
+    return am ? am->GetVoicePlayOffset(this) : 0.0f;
+}
 ALuint ALAudioSource::GetALSourceId() const
 {
     return m_alSourceId;
@@ -171,10 +206,5 @@ bool ALAudioSource::GetLooping() const
 }
 ALAudioSource::State ALAudioSource::GetState() const
 {
-    ALint state;
-    if (GetALSourceId() > 0)
-    {
-        alGetSourcei(GetALSourceId(), AL_SOURCE_STATE, &state);
-    }
-    return static_cast<State>(state);
+    return m_state;
 }
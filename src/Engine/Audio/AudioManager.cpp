@@ -2,6 +2,7 @@
 
 #include <AL/al.h>
 #include <AL/alc.h>
+#include <cmath>
 #include <cstring>
 #include <ostream>
 #include <unordered_map>
@@ -15,36 +16,72 @@
 #include "Bang/Assets.h"
 #include "Bang/Assets.tcc"
 #include "Bang/AudioClip.h"
-#include "Bang/AudioPlayerRunnable.h"
+#include "Bang/AudioStream.h"
 #include "Bang/Debug.h"
 #include "Bang/EventEmitter.h"
 #include "Bang/EventListener.tcc"
 #include "Bang/IEventsDestroy.h"
 #include "Bang/List.tcc"
-#include "Bang/MutexLocker.h"
+#include "Bang/Math.h"
 #include "Bang/UMap.tcc"
 
 using namespace Bang;
 
+static float GetALBufferLength(ALuint alBufferId)
+{
+    ALint size = 0, bits = 0, channels = 0, frequency = 0;
+    alGetBufferi(alBufferId, AL_SIZE, &size);
+    alGetBufferi(alBufferId, AL_BITS, &bits);
+    alGetBufferi(alBufferId, AL_CHANNELS, &channels);
+    alGetBufferi(alBufferId, AL_FREQUENCY, &frequency);
+
+    const int bytesPerSample = (bits / 8) * channels;
+    if (bytesPerSample <= 0 || frequency <= 0)
+    {
+        return 0.0f;
+    }
+    return (SCAST<float>(size) / bytesPerSample) / frequency;
+}
+
 AudioManager::AudioManager()
 {
 }
 
 void AudioManager::Init()
 {
-    InitAL();
-    m_threadPool.SetMaxThreadCount(256);
+    if (InitAL())
+    {
+        InitALSources();
+    }
 }
 
 AudioManager::~AudioManager()
 {
-    for (const auto &pair : m_sourcesToPlayers)
+    Array<ALAudioSource *> alAudioSourcesToDelete;
+    for (const auto &pair : m_sourcesToVoices)
+    {
+        AudioVoice *voice = pair.second;
+        ALAudioSource *alAudioSource = voice->alAudioSource;
+        ReleaseVoiceALSource(voice);
+        alAudioSource->m_state = ALAudioSource::State::STOPPED;
+        alAudioSource->EventEmitter<IEventsDestroy>::UnRegisterListener(this);
+        if (alAudioSource->m_autoDelete)
+        {
+            alAudioSourcesToDelete.PushBack(alAudioSource);
+        }
+        delete voice;
+    }
+    m_sourcesToVoices.Clear();
+
+    for (ALAudioSource *alAudioSource : alAudioSourcesToDelete)
     {
-        AudioPlayerRunnable *audioPlayer = pair.second;
-        ALuint sourceId = audioPlayer->GetALAudioSource()->GetALSourceId();
-        alDeleteSources(1, &sourceId);
+        delete alAudioSource;
+    }
+
+    if (!m_alSources.IsEmpty())
+    {
+        alDeleteSources(m_alSources.Size(), m_alSources.Data());
     }
-    StopAllSounds();
 
     alcDestroyContext(m_alContext);
     alcCloseDevice(m_alDevice);
@@ -87,6 +124,23 @@ bool AudioManager::InitAL()
     return true;
 }
 
+void AudioManager::InitALSources()
+{
+    // Keep as many sources as the device lets us have, up to the max
+    for (uint i = 0; i < AudioManager::MaxRealVoices; ++i)
+    {
+        ALuint alSourceId = 0;
+        alGetError();
+        alGenSources(1, &alSourceId);
+        if (alGetError() != AL_NO_ERROR)
+        {
+            break;
+        }
+        m_alSources.PushBack(alSourceId);
+        m_freeALSources.PushBack(alSourceId);
+    }
+}
+
 String AudioManager::GetALErrorEnumString(ALenum errorEnum)
 {
     switch (errorEnum)
@@ -117,37 +171,127 @@ String AudioManager::GetALCErrorEnumString(ALCenum errorEnum)
     return "";
 }
 
-void AudioManager::OnDestroyed(EventEmitter<IEventsDestroy> *object)
+void AudioManager::Update()
 {
-    if (ALAudioSource *alAudioSource = DCAST<ALAudioSource *>(object))
+    const Time now = Time::GetNow();
+    const float deltaSeconds =
+        (m_lastUpdateTime > Time::Zero())
+            ? SCAST<float>((now - m_lastUpdateTime).GetSeconds())
+            : 0.0f;
+    m_lastUpdateTime = now;
+
+    Vector3 listenerPosition = Vector3::Zero();
+    alGetListenerfv(AL_POSITION, listenerPosition.Data());
+
+    Array<AudioVoice *> activeVoices;
+    for (const auto &pair : m_sourcesToVoices)
     {
-        OnALAudioSourceDestroyed(alAudioSource);
+        AudioVoice *voice = pair.second;
+        ALAudioSource *alAudioSource = voice->alAudioSource;
+        if (voice->finished)
+        {
+            continue;
+        }
+
+        if (!voice->started)  // Delayed start
+        {
+            if (now < voice->startTime)
+            {
+                continue;
+            }
+            voice->started = true;
+            alAudioSource->m_state = ALAudioSource::State::PLAYING;
+        }
+
+        if (voice->paused)
+        {
+            continue;
+        }
+
+        if (IsVoiceReal(voice))
+        {
+            if (voice->stream)
+            {
+                voice->finished =
+                    !voice->stream->Update(alAudioSource->GetALSourceId(),
+                                           alAudioSource->GetLooping());
+            }
+            else
+            {
+                ALint alState = AL_STOPPED;
+                alGetSourcei(
+                    alAudioSource->GetALSourceId(), AL_SOURCE_STATE, &alState);
+                voice->finished = (alState == AL_STOPPED);
+            }
+        }
+        else
+        {
+            voice->playOffset += deltaSeconds * alAudioSource->GetPitch();
+            if (voice->playOffset >= voice->length)
+            {
+                if (alAudioSource->GetLooping() && voice->length > 0.0f)
+                {
+                    voice->playOffset =
+                        std::fmod(voice->playOffset, voice->length);
+                }
+                else
+                {
+                    voice->finished = true;
+                }
+            }
+        }
+
+        if (!voice->finished)
+        {
+            voice->audibility = GetVoiceAudibility(voice, listenerPosition);
+            activeVoices.PushBack(voice);
+        }
     }
-    else if (AudioPlayerRunnable *audioPlayer =
-                 DCAST<AudioPlayerRunnable *>(object))
+
+    // Highest priority first, and then the most audible ones
+    activeVoices.Sort([](const AudioVoice *lhs, const AudioVoice *rhs) {
+        const uint lhsPriority = lhs->alAudioSource->GetPriority();
+        const uint rhsPriority = rhs->alAudioSource->GetPriority();
+        if (lhsPriority != rhsPriority)
+        {
+            return lhsPriority > rhsPriority;
+        }
+        return lhs->audibility > rhs->audibility;
+    });
+
+    // Steal the sources first, so that they can be given to the promoted ones
+    const uint maxRealVoices = m_alSources.Size();
+    for (uint i = 0; i < activeVoices.Size(); ++i)
     {
-        OnAudioPlayerDestroyed(audioPlayer);
+        AudioVoice *voice = activeVoices[i];
+        bool mustBeReal = (i < maxRealVoices && voice->audibility > 0.0f);
+        if (!mustBeReal && IsVoiceReal(voice))
+        {
+            MakeVoiceVirtual(voice);
+        }
     }
-}
 
-void AudioManager::OnALAudioSourceDestroyed(ALAudioSource *alAudioSource)
-{
-    alAudioSource->Stop();
-    if (m_sourcesToPlayers.ContainsKey(alAudioSource))
+    for (uint i = 0; i < activeVoices.Size(); ++i)
     {
-        AudioPlayerRunnable *audioPlayer =
-            m_sourcesToPlayers.Get(alAudioSource);
-        audioPlayer->Stop();
+        AudioVoice *voice = activeVoices[i];
+        bool mustBeReal = (i < maxRealVoices && voice->audibility > 0.0f);
+        if (mustBeReal && !IsVoiceReal(voice))
+        {
+            TryMakeVoiceReal(voice);
+        }
     }
+
+    RemoveFinishedVoices();
 }
 
-void AudioManager::OnAudioPlayerDestroyed(AudioPlayerRunnable *audioPlayer)
+void AudioManager::OnDestroyed(EventEmitter<IEventsDestroy> *object)
 {
-    if (m_sourcesToPlayers.ContainsValue(audioPlayer))
+    ALAudioSource *alAudioSource = DCAST<ALAudioSource *>(object);
+    if (AudioVoice *voice = GetVoice(alAudioSource))
     {
-        ALAudioSource *audioSource =
-            m_sourcesToPlayers.GetKeysWithValue(audioPlayer).Front();
-        audioSource->Stop();
+        ReleaseVoiceALSource(voice);
+        m_sourcesToVoices.Remove(alAudioSource);
+        delete voice;
     }
 }
 
@@ -157,17 +301,8 @@ ALAudioSource *AudioManager::Play(AudioClip *audioClip,
 {
     if (audioClip)
     {
-        AudioPlayerRunnable *player =
-            new AudioPlayerRunnable(audioClip, aas, delay);
         AudioManager *am = AudioManager::GetInstance();
-        bool started = am->m_threadPool.TryStart(player);
-        if (started)
-        {
-            MutexLocker ml(&am->m_mutexCurrentAudios);
-            BANG_UNUSED(ml);
-            aas->EventEmitter<IEventsDestroy>::RegisterListener(am);
-            am->m_sourcesToPlayers.Add(aas, player);
-        }
+        am->StartVoice(aas, audioClip, delay);
     }
     return aas;
 }
@@ -180,10 +315,15 @@ ALAudioSource *AudioManager::Play(AudioClip *audioClip,
     if (audioClip)
     {
         aas = new ALAudioSource();
-        aas->SetALBufferId(audioClip->GetALBufferId());
         aas->SetParams(params);
         aas->m_autoDelete = true;
-        AudioManager::Play(audioClip, aas, delay);
+
+        AudioManager *am = AudioManager::GetInstance();
+        if (!am->StartVoice(aas, audioClip, delay))
+        {
+            delete aas;
+            aas = nullptr;
+        }
     }
     return aas;
 }
@@ -199,34 +339,29 @@ ALAudioSource *AudioManager::Play(const Path &audioClipFilepath,
 void AudioManager::PauseAllSounds()
 {
     AudioManager *am = AudioManager::GetInstance();
-    for (const auto &pair : am->m_sourcesToPlayers)
+    for (const auto &pair : am->m_sourcesToVoices)
     {
-        AudioPlayerRunnable *audioPlayer = pair.second;
-        audioPlayer->Pause();
+        am->PauseVoice(pair.first);
     }
 }
 
 void AudioManager::ResumeAllSounds()
 {
     AudioManager *am = AudioManager::GetInstance();
-    for (const auto &pair : am->m_sourcesToPlayers)
+    for (const auto &pair : am->m_sourcesToVoices)
     {
-        AudioPlayerRunnable *audioPlayer = pair.second;
-        audioPlayer->Resume();
+        am->ResumeVoice(pair.first);
     }
 }
 
 void AudioManager::StopAllSounds()
 {
     AudioManager *am = AudioManager::GetInstance();
-    for (const auto &pair : am->m_sourcesToPlayers)
+    for (const auto &pair : am->m_sourcesToVoices)
     {
-        AudioPlayerRunnable *audioPlayer = pair.second;
-        audioPlayer->Stop();
+        am->StopVoice(pair.first);
     }
-
-    MutexLocker m(&am->m_mutexCurrentAudios);
-    am->m_sourcesToPlayers.Clear();
+    am->RemoveFinishedVoices();
 }
 
 void AudioManager::SetPlayOnStartBlocked(bool blocked)
@@ -241,10 +376,316 @@ bool AudioManager::GetPlayOnStartBlocked()
     return am->m_playOnStartBlocked;
 }
 
-void AudioManager::OnAudioFinishedPlaying(AudioPlayerRunnable *audioPlayer)
+uint AudioManager::GetNumRealVoices()
+{
+    AudioManager *am = AudioManager::GetInstance();
+    return (am->m_alSources.Size() - am->m_freeALSources.Size());
+}
+
+uint AudioManager::GetNumVirtualVoices()
+{
+    uint numVirtualVoices = 0;
+    AudioManager *am = AudioManager::GetInstance();
+    for (const auto &pair : am->m_sourcesToVoices)
+    {
+        const AudioVoice *voice = pair.second;
+        if (voice->started && !voice->paused && !voice->finished &&
+            !IsVoiceReal(voice))
+        {
+            ++numVirtualVoices;
+        }
+    }
+    return numVirtualVoices;
+}
+
+uint AudioManager::GetMaxRealVoices()
+{
+    AudioManager *am = AudioManager::GetInstance();
+    return am->m_alSources.Size();
+}
+
+bool AudioManager::StartVoice(ALAudioSource *alAudioSource,
+                              AudioClip *audioClip,
+                              float delay)
+{
+    if (audioClip && !audioClip->IsLoaded())
+    {
+        return false;
+    }
+
+    const bool streaming = (audioClip && audioClip->IsStreaming());
+    const ALuint alBufferId =
+        audioClip ? audioClip->GetALBufferId() : alAudioSource->m_bufferId;
+    if (!streaming && alBufferId == 0)
+    {
+        return false;
+    }
+
+    AudioVoice *voice = GetVoice(alAudioSource);
+    if (!voice)
+    {
+        voice = new AudioVoice();
+        voice->alAudioSource = alAudioSource;
+        alAudioSource->EventEmitter<IEventsDestroy>::RegisterListener(this);
+        m_sourcesToVoices.Add(alAudioSource, voice);
+    }
+    else
+    {
+        // Restart it
+        ReleaseVoiceALSource(voice);
+    }
+    alAudioSource->SetALBufferId(alBufferId);
+
+    voice->audioClip = audioClip;
+    voice->stream.reset(
+        streaming ? new AudioStream(audioClip->GetSoundFilepath()) : nullptr);
+    voice->length = streaming ? voice->stream->GetLength()
+                              : GetALBufferLength(alAudioSource->m_bufferId);
+    alAudioSource->m_streaming = streaming;
+    voice->playOffset = 0.0f;
+    voice->startTime = Time::GetNow() + Time::Seconds(delay);
+    voice->started = false;
+    voice->paused = false;
+    voice->finished = false;
+
+    if (delay <= 0.0f)
+    {
+        // Start right away if there is a free source, the next Update will
+        // steal one for it otherwise
+        voice->started = true;
+        alAudioSource->m_state = ALAudioSource::State::PLAYING;
+
+        Vector3 listenerPosition = Vector3::Zero();
+        alGetListenerfv(AL_POSITION, listenerPosition.Data());
+        voice->audibility = GetVoiceAudibility(voice, listenerPosition);
+        if (voice->audibility > 0.0f)
+        {
+            TryMakeVoiceReal(voice);
+        }
+    }
+    return true;
+}
+
+void AudioManager::PauseVoice(ALAudioSource *alAudioSource)
+{
+    AudioVoice *voice = GetVoice(alAudioSource);
+    if (voice && !voice->finished && !voice->paused)
+    {
+        // Paused voices do not keep their source
+        MakeVoiceVirtual(voice);
+        voice->paused = true;
+        if (voice->started)
+        {
+            alAudioSource->m_state = ALAudioSource::State::PAUSED;
+        }
+    }
+}
+
+void AudioManager::ResumeVoice(ALAudioSource *alAudioSource)
+{
+    AudioVoice *voice = GetVoice(alAudioSource);
+    if (voice && !voice->finished && voice->paused)
+    {
+        voice->paused = false;
+        if (voice->started)
+        {
+            alAudioSource->m_state = ALAudioSource::State::PLAYING;
+            TryMakeVoiceReal(voice);
+        }
+    }
+}
+
+void AudioManager::SeekVoice(ALAudioSource *alAudioSource, float playOffset)
 {
-    MutexLocker m(&m_mutexCurrentAudios);
-    m_sourcesToPlayers.RemoveValues(audioPlayer);
+    AudioVoice *voice = GetVoice(alAudioSource);
+    if (!voice || voice->finished)
+    {
+        return;
+    }
+
+    voice->playOffset = Math::Clamp(playOffset, 0.0f, voice->length);
+    if (IsVoiceReal(voice))
+    {
+        ALuint alSourceId = alAudioSource->GetALSourceId();
+        if (voice->stream)
+        {
+            BANG_AL_CALL(alSourceStop(alSourceId));
+            BANG_AL_CALL(alSourcei(alSourceId, AL_BUFFER, 0));
+            voice->stream->OnDetached();
+            voice->stream->Play(alSourceId,
+                                voice->playOffset,
+                                alAudioSource->GetLooping());
+        }
+        else
+        {
+            BANG_AL_CALL(
+                alSourcef(alSourceId, AL_SEC_OFFSET, voice->playOffset));
+        }
+    }
+}
+
+void AudioManager::StopVoice(ALAudioSource *alAudioSource)
+{
+    if (AudioVoice *voice = GetVoice(alAudioSource))
+    {
+        ReleaseVoiceALSource(voice);
+        voice->finished = true;
+    }
+    alAudioSource->m_state = ALAudioSource::State::STOPPED;
+}
+
+float AudioManager::GetVoicePlayOffset(const ALAudioSource *alAudioSource) const
+{
+    float playOffset = 0.0f;
+    if (AudioVoice *voice = GetVoice(alAudioSource))
+    {
+        if (IsVoiceReal(voice))
+        {
+            if (voice->stream)
+            {
+                playOffset = voice->stream->GetPlayOffset(
+                    alAudioSource->GetALSourceId());
+            }
+            else
+            {
+                alGetSourcef(
+                    alAudioSource->GetALSourceId(), AL_SEC_OFFSET, &playOffset);
+            }
+        }
+        else
+        {
+            playOffset = voice->playOffset;
+        }
+    }
+    return playOffset;
+}
+
+AudioManager::AudioVoice *AudioManager::GetVoice(
+    const ALAudioSource *alAudioSource) const
+{
+    auto it =
+        m_sourcesToVoices.Find(const_cast<ALAudioSource *>(alAudioSource));
+    return (it != m_sourcesToVoices.End()) ? it->second : nullptr;
+}
+
+bool AudioManager::TryMakeVoiceReal(AudioVoice *voice)
+{
+    if (IsVoiceReal(voice))
+    {
+        return true;
+    }
+
+    if (m_freeALSources.IsEmpty())
+    {
+        return false;
+    }
+
+    ALAudioSource *alAudioSource = voice->alAudioSource;
+    ALuint alSourceId = m_freeALSources.Back();
+    m_freeALSources.PopBack();
+
+    alAudioSource->m_alSourceId = alSourceId;
+    if (voice->stream)
+    {
+        alAudioSource->UpdateALProperties();
+        voice->stream->Play(
+            alSourceId, voice->playOffset, alAudioSource->GetLooping());
+    }
+    else
+    {
+        BANG_AL_CALL(
+            alSourcei(alSourceId, AL_BUFFER, alAudioSource->m_bufferId));
+        alAudioSource->UpdateALProperties();
+        BANG_AL_CALL(alSourcef(alSourceId, AL_SEC_OFFSET, voice->playOffset));
+        BANG_AL_CALL(alSourcePlay(alSourceId));
+    }
+    return true;
+}
+
+void AudioManager::MakeVoiceVirtual(AudioVoice *voice)
+{
+    if (IsVoiceReal(voice))
+    {
+        voice->playOffset = GetVoicePlayOffset(voice->alAudioSource);
+        ReleaseVoiceALSource(voice);
+    }
+}
+
+void AudioManager::ReleaseVoiceALSource(AudioVoice *voice)
+{
+    if (IsVoiceReal(voice))
+    {
+        ALAudioSource *alAudioSource = voice->alAudioSource;
+        ALuint alSourceId = alAudioSource->GetALSourceId();
+        BANG_AL_CALL(alSourceStop(alSourceId));
+        BANG_AL_CALL(alSourcei(alSourceId, AL_BUFFER, 0));
+        if (voice->stream)
+        {
+            voice->stream->OnDetached();
+        }
+        alAudioSource->m_alSourceId = 0;
+        m_freeALSources.PushBack(alSourceId);
+    }
+}
+
+void AudioManager::RemoveFinishedVoices()
+{
+    Array<ALAudioSource *> alAudioSourcesToDelete;
+    for (auto it = m_sourcesToVoices.Begin(); it != m_sourcesToVoices.End();)
+    {
+        AudioVoice *voice = it->second;
+        if (voice->finished)
+        {
+            ALAudioSource *alAudioSource = voice->alAudioSource;
+            ReleaseVoiceALSource(voice);
+            alAudioSource->m_state = ALAudioSource::State::STOPPED;
+            alAudioSource->EventEmitter<IEventsDestroy>::UnRegisterListener(
+                this);
+            if (alAudioSource->m_autoDelete)
+            {
+                alAudioSourcesToDelete.PushBack(alAudioSource);
+            }
+
+            delete voice;
+            it = m_sourcesToVoices.Remove(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (ALAudioSource *alAudioSource : alAudioSourcesToDelete)
+    {
+        delete alAudioSource;
+    }
+}
+
+bool AudioManager::IsVoiceReal(const AudioVoice *voice)
+{
+    return (voice->alAudioSource->GetALSourceId() > 0);
+}
+
+float AudioManager::GetVoiceAudibility(const AudioVoice *voice,
+                                       const Vector3 &listenerPosition)
+{
+    // Same as the linear clamped distance model the AudioListener sets
+    const ALAudioSource *alAudioSource = voice->alAudioSource;
+    const float range = Math::Max(alAudioSource->GetRange(), 0.01f);
+    const float referenceDistance = (range * 0.5f);
+    const float distance =
+        Vector3::Distance(alAudioSource->GetPosition(), listenerPosition);
+    if (distance >= range)
+    {
+        return 0.0f;
+    }
+
+    const float attenuation =
+        1.0f - Math::Clamp((distance - referenceDistance) /
+                               (range - referenceDistance),
+                           0.0f,
+                           1.0f);
+    return Math::Max(alAudioSource->GetVolume(), 0.0f) * attenuation;
 }
 
 void AudioManager::DettachSourcesFromAudioClip(AudioClip *ac)
@@ -252,15 +693,25 @@ void AudioManager::DettachSourcesFromAudioClip(AudioClip *ac)
     // Dettach all audioSources using this AudioClip.
     // Otherwise OpenAL throws error.
     AudioManager *am = AudioManager::GetInstance();
-    for (const auto &pair : am->m_sourcesToPlayers)
+    if (!am)
+    {
+        return;
+    }
+
+    for (const auto &pair : am->m_sourcesToVoices)
     {
-        AudioPlayerRunnable *audioPlayer = pair.second;
-        if (audioPlayer->GetAudioClip() == ac)
+        ALAudioSource *alAudioSource = pair.first;
+        const AudioVoice *voice = pair.second;
+        const bool usesClipBuffer =
+            (ac->GetALBufferId() != 0 &&
+             alAudioSource->m_bufferId == ac->GetALBufferId());
+        if (voice->audioClip == ac || usesClipBuffer)
         {
-            audioPlayer->Stop();
-            audioPlayer->GetALAudioSource()->SetALBufferId(0);
+            am->StopVoice(alAudioSource);
+            alAudioSource->SetALBufferId(0);
         }
     }
+    am->RemoveFinishedVoices();
 }
 
 void AudioManager::ClearALErrors()
@@ -332,5 +783,6 @@ List<String> AudioManager::GetAudioDevicesList()
 
 AudioManager *AudioManager::GetInstance()
 {
-    return Application::GetInstance()->GetAudioManager();
+    Application *app = Application::GetInstance();
+    return app ? app->GetAudioManager() : nullptr;
 }
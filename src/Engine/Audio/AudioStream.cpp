@@ -0,0 +1,278 @@
+#include "Bang/AudioStream.h"
+
+#include <sndfile.h>
+
+#include "Bang/Array.tcc"
+#include "Bang/AudioManager.h"
+#include "Bang/Debug.h"
+#include "Bang/List.tcc"
+#include "Bang/Math.h"
+#include "Bang/StreamOperators.h"
+
+using namespace Bang;
+
+constexpr uint AudioStream::NumBuffers;
+constexpr uint AudioStream::ChunkFrames;
+
+AudioStream::AudioStream(const Path &soundFilepath)
+{
+    SF_INFO soundInfo;
+    soundInfo.format = 0;
+    m_soundFile =
+        sf_open(soundFilepath.GetAbsolute().ToCString(), SFM_READ, &soundInfo);
+    if (!m_soundFile)
+    {
+        Debug_Error("Error opening sound file '" << soundFilepath
+                                                 << "' for streaming");
+        return;
+    }
+
+    m_numChannels = soundInfo.channels;
+    m_sampleRate = soundInfo.samplerate;
+    m_numFrames = SCAST<uint>(soundInfo.frames);
+
+    m_alBufferIds.Resize(AudioStream::NumBuffers, 0);
+    BANG_AL_CALL(alGenBuffers(m_alBufferIds.Size(), m_alBufferIds.Data()));
+    m_freeALBufferIds = m_alBufferIds;
+}
+
+AudioStream::~AudioStream()
+{
+    WaitForDecode();
+
+    if (!m_alBufferIds.IsEmpty())
+    {
+        alDeleteBuffers(m_alBufferIds.Size(), m_alBufferIds.Data());
+    }
+
+    if (m_soundFile)
+    {
+        sf_close(m_soundFile);
+    }
+}
+
+void AudioStream::Play(ALuint alSourceId, float offsetSeconds, bool looping)
+{
+    if (!IsOpen())
+    {
+        return;
+    }
+
+    Seek(offsetSeconds);
+    DecodeChunks(AudioStream::NumBuffers / 2, looping);
+    QueueDecodedChunks(alSourceId);
+    ScheduleDecode(looping);
+    BANG_AL_CALL(alSourcePlay(alSourceId));
+}
+
+bool AudioStream::Update(ALuint alSourceId, bool looping)
+{
+    if (!IsOpen())
+    {
+        return false;
+    }
+
+    ALint numProcessedBuffers = 0;
+    alGetSourcei(alSourceId, AL_BUFFERS_PROCESSED, &numProcessedBuffers);
+    for (int i = 0; i < numProcessedBuffers; ++i)
+    {
+        ALuint alBufferId = 0;
+        BANG_AL_CALL(alSourceUnqueueBuffers(alSourceId, 1, &alBufferId));
+        m_freeALBufferIds.PushBack(alBufferId);
+        if (!m_queuedChunksStartFrames.IsEmpty())
+        {
+            m_queuedChunksStartFrames.PopFront();
+        }
+    }
+
+    const bool isDecoding = (m_decodeJob && !m_decodeJob->IsFinished());
+    if (!isDecoding)
+    {
+        m_decodeJob = nullptr;
+        QueueDecodedChunks(alSourceId);
+        ScheduleDecode(looping);
+    }
+
+    if (m_queuedChunksStartFrames.IsEmpty())
+    {
+        const bool hasFinished = (!isDecoding && m_decodedChunks.IsEmpty() &&
+                                  m_endOfFile && !looping);
+        return !hasFinished;
+    }
+
+    // Also restarts it if the decoding could not keep up and it run out of
+    // buffers (OpenAL stops the source in that case)
+    ALint alState = AL_STOPPED;
+    alGetSourcei(alSourceId, AL_SOURCE_STATE, &alState);
+    if (alState != AL_PLAYING && alState != AL_PAUSED)
+    {
+        BANG_AL_CALL(alSourcePlay(alSourceId));
+    }
+    return true;
+}
+
+void AudioStream::OnDetached()
+{
+    m_freeALBufferIds = m_alBufferIds;
+    m_queuedChunksStartFrames.Clear();
+}
+
+bool AudioStream::IsOpen() const
+{
+    return (m_soundFile != nullptr) && (m_sampleRate > 0);
+}
+
+float AudioStream::GetPlayOffset(ALuint alSourceId) const
+{
+    if (!IsOpen())
+    {
+        return 0.0f;
+    }
+
+    const bool isDecoding = (m_decodeJob && !m_decodeJob->IsFinished());
+    uint frame = (isDecoding ? m_scheduledDecodeFrame : m_decodeFrame);
+    if (!m_queuedChunksStartFrames.IsEmpty())
+    {
+        // The sample offset counts from the first queued buffer
+        ALint sampleOffset = 0;
+        alGetSourcei(alSourceId, AL_SAMPLE_OFFSET, &sampleOffset);
+        frame = m_queuedChunksStartFrames.Front() + SCAST<uint>(sampleOffset);
+    }
+
+    if (m_numFrames > 0)
+    {
+        frame %= m_numFrames;
+    }
+    return SCAST<float>(frame) / m_sampleRate;
+}
+
+float AudioStream::GetLength() const
+{
+    return IsOpen() ? (SCAST<float>(m_numFrames) / m_sampleRate) : 0.0f;
+}
+
+uint AudioStream::ReadMonoFrames(SNDFILE *soundFile,
+                                 int numChannels,
+                                 uint numFrames,
+                                 Array<short> *monoSamples)
+{
+    if (numChannels <= 0)
+    {
+        return 0;
+    }
+
+    Array<short> frames(numFrames * numChannels);
+    const uint numReadFrames =
+        SCAST<uint>(sf_readf_short(soundFile, frames.Data(), numFrames));
+
+    const uint prevSize = monoSamples->Size();
+    monoSamples->Resize(prevSize + numReadFrames);
+    short *monoData = monoSamples->Data() + prevSize;
+    for (uint i = 0; i < numReadFrames; ++i)
+    {
+        int sum = 0;
+        for (int c = 0; c < numChannels; ++c)
+        {
+            sum += frames[i * numChannels + c];
+        }
+        monoData[i] = SCAST<short>(sum / numChannels);
+    }
+    return numReadFrames;
+}
+
+void AudioStream::Seek(float offsetSeconds)
+{
+    WaitForDecode();
+    m_decodedChunks.Clear();
+
+    const uint frame = Math::Min(
+        SCAST<uint>(Math::Max(offsetSeconds, 0.0f) * m_sampleRate),
+        m_numFrames);
+    sf_seek(m_soundFile, frame, SEEK_SET);
+    m_decodeFrame = frame;
+    m_endOfFile = (frame >= m_numFrames);
+}
+
+void AudioStream::WaitForDecode()
+{
+    if (m_decodeJob)
+    {
+        if (JobSystem *jobSystem = JobSystem::GetInstance())
+        {
+            jobSystem->Wait(m_decodeJob);
+        }
+        m_decodeJob = nullptr;
+    }
+}
+
+void AudioStream::ScheduleDecode(bool looping)
+{
+    if (m_decodeJob || (m_endOfFile && !looping) ||
+        m_decodedChunks.Size() >= AudioStream::NumBuffers)
+    {
+        return;
+    }
+
+    const uint numChunks = (AudioStream::NumBuffers - m_decodedChunks.Size());
+    m_scheduledDecodeFrame = m_decodeFrame;
+    if (JobSystem *jobSystem = JobSystem::GetInstance())
+    {
+        m_decodeJob = jobSystem->Schedule(
+            [this, numChunks, looping]() { DecodeChunks(numChunks, looping); });
+    }
+    else
+    {
+        DecodeChunks(numChunks, looping);
+    }
+}
+
+void AudioStream::DecodeChunks(uint numChunks, bool looping)
+{
+    for (uint i = 0; i < numChunks; ++i)
+    {
+        if (m_endOfFile)
+        {
+            if (!looping || m_numFrames == 0)
+            {
+                break;
+            }
+            sf_seek(m_soundFile, 0, SEEK_SET);
+            m_decodeFrame = 0;
+            m_endOfFile = false;
+        }
+
+        Chunk chunk;
+        chunk.startFrame = m_decodeFrame;
+        uint numReadFrames =
+            AudioStream::ReadMonoFrames(m_soundFile,
+                                        m_numChannels,
+                                        AudioStream::ChunkFrames,
+                                        &chunk.samples);
+        m_decodeFrame += numReadFrames;
+        m_endOfFile = (numReadFrames < AudioStream::ChunkFrames);
+
+        if (numReadFrames > 0)
+        {
+            m_decodedChunks.PushBack(chunk);
+        }
+    }
+}
+
+void AudioStream::QueueDecodedChunks(ALuint alSourceId)
+{
+    while (!m_freeALBufferIds.IsEmpty() && !m_decodedChunks.IsEmpty())
+    {
+        const Chunk &chunk = m_decodedChunks.Front();
+        ALuint alBufferId = m_freeALBufferIds.Back();
+        m_freeALBufferIds.PopBack();
+
+        BANG_AL_CALL(alBufferData(alBufferId,
+                                  AL_FORMAT_MONO16,
+                                  chunk.samples.Data(),
+                                  chunk.samples.Size() * sizeof(short),
+                                  m_sampleRate));
+        BANG_AL_CALL(alSourceQueueBuffers(alSourceId, 1, &alBufferId));
+        m_queuedChunksStartFrames.PushBack(chunk.startFrame);
+        m_decodedChunks.PopFront();
+    }
+}
@@ -150,7 +150,42 @@ MetaNode ReflectStruct::GetMeta() const
     MetaNode meta;
     for (const ReflectVariable &reflVar : GetVariables())
     {
-        meta.Set(reflVar.GetName(), reflVar.GetCurrentValue());
+        // Numeric and vector values are set natively, so that binary metas
+        // store them as raw values
+        const String &name = reflVar.GetName();
+        const Variant value = reflVar.GetCurrentValue();
+        switch (value.GetType())
+        {
+            case Variant::Type::INT: meta.Set(name, value.GetInt()); break;
+            case Variant::Type::UINT: meta.Set(name, value.GetUint()); break;
+            case Variant::Type::FLOAT: meta.Set(name, value.GetFloat()); break;
+            case Variant::Type::DOUBLE:
+                meta.Set(name, value.GetDouble());
+                break;
+            case Variant::Type::VECTOR2:
+                meta.Set(name, value.GetVector2());
+                break;
+            case Variant::Type::VECTOR3:
+                meta.Set(name, value.GetVector3());
+                break;
+            case Variant::Type::VECTOR4:
+                meta.Set(name, value.GetVector4());
+                break;
+            case Variant::Type::VECTOR2i:
+                meta.Set(name, value.GetVector2i());
+                break;
+            case Variant::Type::VECTOR3i:
+                meta.Set(name, value.GetVector3i());
+                break;
+            case Variant::Type::VECTOR4i:
+                meta.Set(name, value.GetVector4i());
+                break;
+            case Variant::Type::QUATERNION:
+                meta.Set(name, value.GetQuaternion());
+                break;
+            case Variant::Type::COLOR: meta.Set(name, value.GetColor()); break;
+            default: meta.Set(name, value); break;
+        }
     }
     return meta;
 }
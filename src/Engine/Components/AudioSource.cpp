@@ -1,6 +1,5 @@
 #include "Bang/AudioSource.h"
 
-#include <AL/al.h>
 #include <vector>
 
 #include "Bang/Array.tcc"
@@ -99,10 +98,7 @@ AudioClip *AudioSource::GetAudioClip() const
 
 float AudioSource::GetPlayProgress() const
 {
-    float secondsOffset;
-    alGetSourcef(GetALSourceId(), AL_SEC_OFFSET, &secondsOffset);
-    alGetSourcef(GetALSourceId(), AL_SEC_OFFSET, &secondsOffset);
-    return secondsOffset / GetAudioClip()->GetLength();
+    return GetPlayOffset() / GetAudioClip()->GetLength();
 }
 
 void AudioSource::Reflect()
@@ -121,6 +117,9 @@ void AudioSource::Reflect()
                       [this](float r) { SetRange(r); },
                       [this]() -> float { return GetRange(); },
                       BANG_REFLECT_HINT_MIN_VALUE(0.01f));
+    ReflectVar<uint>("Priority",
+                     [this](uint priority) { SetPriority(priority); },
+                     [this]() -> uint { return GetPriority(); });
     ReflectVar<bool>("Looping",
                      [this](bool looping) { SetLooping(looping); },
                      [this]() -> bool { return GetLooping(); });
@@ -27,6 +27,7 @@
 #include "Bang/MetaNode.h"
 #include "Bang/MetaNode.tcc"
 #include "Bang/Quad.h"
+#include "Bang/RenderTargetPool.h"
 #include "Bang/Scene.h"
 #include "Bang/SceneManager.h"
 #include "Bang/TextureCubeMap.h"
@@ -61,6 +62,10 @@ Camera::Camera()
     AddRenderPass(RenderPass::OVERLAY_POSTPROCESS);
 
     m_gbuffer = new GBuffer(1, 1);
+    if (RenderTargetPool *rtPool = RenderTargetPool::GetInstance())
+    {
+        rtPool->RegisterPersistentGBuffer(m_gbuffer, "Camera");
+    }
 
     SetSkyBoxTexture(TextureFactory::GetDefaultSkybox());
     SetHDR(true);
@@ -68,6 +73,10 @@ Camera::Camera()
 
 Camera::~Camera()
 {
+    if (RenderTargetPool *rtPool = RenderTargetPool::GetInstance())
+    {
+        rtPool->UnRegisterPersistentGBuffer(m_gbuffer);
+    }
     delete m_gbuffer;
 }
 
@@ -1,6 +1,7 @@
 #include "Bang/DecalRenderer.h"
 
 #include "Bang/Assets.h"
+#include "Bang/DecalBatcher.h"
 #include "Bang/Extensions.h"
 #include "Bang/GBuffer.h"
 #include "Bang/GEngine.h"
@@ -11,7 +12,6 @@
 #include "Bang/ShaderProgram.h"
 #include "Bang/ShaderProgramFactory.h"
 #include "Bang/Texture2D.h"
-#include "Bang/Texture2D.h"
 #include "Bang/TextureFactory.h"
 #include "Bang/Transform.h"
 
@@ -36,6 +36,18 @@ DecalRenderer::~DecalRenderer()
 {
 }
 
+void DecalRenderer::OnRender(RenderPass renderPass)
+{
+    if (renderPass == RenderPass::SCENE_DECALS && AddToBatch())
+    {
+        Component::OnRender(renderPass);
+    }
+    else
+    {
+        Renderer::OnRender(renderPass);
+    }
+}
+
 void DecalRenderer::OnRender()
 {
     Renderer::OnRender();
@@ -49,6 +61,7 @@ void DecalRenderer::OnRender()
     sp->SetMatrix4("B_DecalViewMatrix", GetViewMatrix());
     sp->SetMatrix4("B_DecalProjectionMatrix", projMatrix);
     sp->SetTexture2D("B_DecalTexture", GetDecalTexture());
+    sp->SetFloat("B_DecalFade", GetFade(), false);
 
     GL::Push(GL::Enablable::DEPTH_TEST);
     GL::Disable(GL::Enablable::DEPTH_TEST);
@@ -115,6 +128,11 @@ void DecalRenderer::SetDecalTexture(Texture2D *decalTexture)
     GetMaterial()->SetAlbedoTexture(decalTexture);
 }
 
+void DecalRenderer::SetFade(float fade)
+{
+    m_fade = Math::Clamp(fade, 0.0f, 1.0f);
+}
+
 float DecalRenderer::GetZNear() const
 {
     return m_zNear;
@@ -150,6 +168,11 @@ Texture2D *DecalRenderer::GetDecalTexture() const
     return GetActiveMaterial()->GetAlbedoTexture();
 }
 
+float DecalRenderer::GetFade() const
+{
+    return m_fade;
+}
+
 Matrix4 DecalRenderer::GetViewMatrix() const
 {
     Matrix4 viewMatrix;
@@ -189,6 +212,26 @@ Matrix4 DecalRenderer::GetProjectionMatrix() const
     return projMatrix;
 }
 
+bool DecalRenderer::AddToBatch()
+{
+    GEngine *ge = GEngine::GetInstance();
+    DecalBatcher *batcher = ge->GetDecalBatcher();
+    Material *mat = GetActiveMaterial();
+    if (!batcher || !batcher->IsEnabled() || ge->GetReplacementMaterial() ||
+        !mat || mat->GetBaseShaderProgram() != ShaderProgramFactory::GetDecal())
+    {
+        return false;
+    }
+
+    if (GetGameObject()->IsVisibleRecursively() && IsVisible())
+    {
+        batcher->AddDecal(GetProjectionMatrix() * GetViewMatrix(),
+                          GetDecalTexture(),
+                          GetFade());
+    }
+    return true;
+}
+
 void DecalRenderer::Reflect()
 {
     Renderer::Reflect();
@@ -217,6 +260,12 @@ void DecalRenderer::Reflect()
         Texture2D,
         BANG_REFLECT_HINT_EXTENSIONS(Extensions::GetImageExtensions()));
 
+    BANG_REFLECT_VAR_MEMBER_HINTED(DecalRenderer,
+                                   "Fade",
+                                   SetFade,
+                                   GetFade,
+                                   BANG_REFLECT_HINT_MINMAX_VALUE(0.0f, 1.0f));
+
     BANG_REFLECT_VAR_MEMBER(
         DecalRenderer, "Perspective", SetIsPerspective, GetIsPerspective);
 
@@ -23,6 +23,7 @@
 #include "Bang/MetaNode.tcc"
 #include "Bang/Quad.h"
 #include "Bang/RenderPass.h"
+#include "Bang/RenderTargetPool.h"
 #include "Bang/Renderer.h"
 #include "Bang/ShaderProgram.h"
 #include "Bang/ShaderProgramFactory.h"
@@ -43,11 +44,6 @@ DirectionalLight::DirectionalLight()
 {
     SET_INSTANCE_CLASS_ID(DirectionalLight)
 
-    m_blurAuxiliarTexture = Assets::Create<Texture2D>();
-    m_blurAuxiliarTexture.Get()->SetFormat(GL::ColorFormat::RGBA32F);
-    m_blurAuxiliarTexture.Get()->SetFilterMode(GL::FilterMode::BILINEAR);
-    m_blurAuxiliarTexture.Get()->SetWrapMode(GL::WrapMode::CLAMP_TO_EDGE);
-
     m_blurredShadowMapTexture = Assets::Create<Texture2D>();
     m_blurredShadowMapTexture.Get()->SetFormat(GL::ColorFormat::RGBA32F);
     m_blurredShadowMapTexture.Get()->SetFilterMode(GL::FilterMode::BILINEAR);
@@ -75,19 +71,14 @@ DirectionalLight::~DirectionalLight()
 }
 
 AABox DirectionalLight::GetShadowCastersAABox(
-    const Array<Renderer *> &shadowCastersRenderers) const
+    const Array<ShadowCaster> &shadowCasters) const
 {
     Array<Vector3> casterPoints;
-    for (Renderer *shadowCasterRend : shadowCastersRenderers)
+    for (const ShadowCaster &shadowCaster : shadowCasters)
     {
-        Matrix4 localToWorld = shadowCasterRend->GetGameObject()
-                                   ->GetTransform()
-                                   ->GetLocalToWorldMatrix();
-        AABox rendAABox = shadowCasterRend->GetAABBox();
-        if (rendAABox != AABox::Empty())
+        if (shadowCaster.aaBoxWorld != AABox::Empty())
         {
-            AABox rendAABoxWorld = localToWorld * rendAABox;
-            casterPoints.PushBack(rendAABoxWorld.GetPoints());
+            casterPoints.PushBack(shadowCaster.aaBoxWorld.GetPoints());
         }
     }
 
@@ -96,8 +87,31 @@ AABox DirectionalLight::GetShadowCastersAABox(
     return sceneAABox;
 }
 
+Array<ShadowCaster> DirectionalLight::GetShadowCastersInRange(
+    const AABox &camAABoxLS,
+    const Matrix4 &worldToLight) const
+{
+    // A caster can shadow the camera frustum only if they overlap when seen
+    // from the light. The light space z is the light direction, so casters
+    // can be at any depth. Only the boxes of the visited hierarchy nodes are
+    // transformed to light space
+    Array<ShadowCaster> shadowCastersInRange;
+    GetShadowCasters(
+        [&](const AABox &aaBoxWorld) {
+            const AABox aaBoxLS = worldToLight * aaBoxWorld;
+            return (aaBoxLS.GetMax().x >= camAABoxLS.GetMin().x &&
+                    aaBoxLS.GetMin().x <= camAABoxLS.GetMax().x &&
+                    aaBoxLS.GetMax().y >= camAABoxLS.GetMin().y &&
+                    aaBoxLS.GetMin().y <= camAABoxLS.GetMax().y);
+        },
+        &shadowCastersInRange);
+    return shadowCastersInRange;
+}
+
 void DirectionalLight::RenderShadowMaps_(GameObject *go)
 {
+    BANG_UNUSED(go);
+
     GL::Push(GL::Pushable::VIEWPORT);
     GL::Push(GL::Pushable::COLOR_MASK);
     GL::Push(GL::Pushable::DEPTH_STATES);
@@ -116,11 +130,16 @@ void DirectionalLight::RenderShadowMaps_(GameObject *go)
     // Set up viewport
     GL::SetViewport(0, 0, shadowMapSize.x, shadowMapSize.y);
 
-    // Set up shadow map matrices
-    const Array<Renderer *> shadowCastersRenderers = GetShadowCastersIn(go);
+    // Cull the casters, and set up shadow map matrices to fit them
+    const Matrix4 worldToLight = GetLightToWorldMatrix().Inversed();
+    const AABox camAABoxLS = GetCameraFrustumAABoxInLightSpace(worldToLight);
+    const Array<ShadowCaster> shadowCasters =
+        GetShadowCastersInRange(camAABoxLS, worldToLight);
     Matrix4 shadowMapViewMatrix, shadowMapProjMatrix;
-    GetWorldToShadowMapMatrices(
-        &shadowMapViewMatrix, &shadowMapProjMatrix, shadowCastersRenderers);
+    GetWorldToShadowMapMatrices(&shadowMapViewMatrix,
+                                &shadowMapProjMatrix,
+                                camAABoxLS,
+                                shadowCasters);
     GLUniforms::SetModelMatrix(Matrix4::Identity());
     GLUniforms::SetViewMatrix(shadowMapViewMatrix);
     GLUniforms::SetProjectionMatrix(shadowMapProjMatrix);
@@ -133,9 +152,9 @@ void DirectionalLight::RenderShadowMaps_(GameObject *go)
     float limit = Math::Exp(GetShadowExponentConstant());
     GL::ClearColorBuffer(Color(limit));
 
-    for (Renderer *rend : shadowCastersRenderers)
+    for (const ShadowCaster &shadowCaster : shadowCasters)
     {
-        rend->OnRender(RenderPass::SCENE_OPAQUE);
+        shadowCaster.renderer->OnRender(RenderPass::SCENE_OPAQUE);
     }
 
     ge->PopActiveRenderingCamera();
@@ -143,12 +162,20 @@ void DirectionalLight::RenderShadowMaps_(GameObject *go)
     // Blur shadow map
     if (GetShadowSoftness() > 0)
     {
-        GEngine::GetInstance()->BlurTexture(
-            m_shadowMapFramebuffer->GetAttachmentTex2D(GL::Attachment::COLOR0),
-            m_blurAuxiliarTexture.Get(),
-            m_blurredShadowMapTexture.Get(),
-            GetShadowSoftness(),
-            BlurType::KAWASE);
+        // The shadow map and the blurred one are used later in the frame, but
+        // the auxiliar texture is only needed during the blur
+        RenderTargetPool *rtPool = ge->GetRenderTargetPool();
+        Texture2D *shadowMapTex =
+            m_shadowMapFramebuffer->GetAttachmentTex2D(GL::Attachment::COLOR0);
+        Texture2D *blurAuxiliarTexture = rtPool->Acquire(
+            RenderTargetDesc(shadowMapTex->GetSize(), GL::ColorFormat::RGBA32F),
+            "DirectionalLight");
+        ge->BlurTexture(shadowMapTex,
+                        blurAuxiliarTexture,
+                        m_blurredShadowMapTexture.Get(),
+                        GetShadowSoftness(),
+                        BlurType::KAWASE);
+        rtPool->Release(blurAuxiliarTexture);
     }
 
     GL::Pop(GL::Pushable::FRAMEBUFFER_AND_READ_DRAW_ATTACHMENTS);
@@ -208,11 +235,13 @@ Texture2D *DirectionalLight::GetShadowMapTexture() const
 void DirectionalLight::GetWorldToShadowMapMatrices(
     Matrix4 *viewMatrix,
     Matrix4 *projMatrix,
-    const Array<Renderer *> &shadowCastersRenderers) const
+    const AABox &camAABoxLS,
+    const Array<ShadowCaster> &shadowCasters) const
 {
     // The ortho box will be the AABox in light space of the AABox of the
     // scene in world space
-    AABox orthoBoxInLightSpace = GetShadowMapOrthoBox(shadowCastersRenderers);
+    AABox orthoBoxInLightSpace =
+        GetShadowMapOrthoBox(camAABoxLS, shadowCasters);
     Vector3 orthoBoxExtents = orthoBoxInLightSpace.GetExtents();
     Matrix4 lightToWorld = GetLightToWorldMatrix();
     Vector3 fwd = lightToWorld.TransformedVector(Vector3::Forward());
@@ -232,8 +261,8 @@ void DirectionalLight::GetWorldToShadowMapMatrices(
                                  orthoBoxExtents.z);
 }
 
-AABox DirectionalLight::GetShadowMapOrthoBox(
-    const Array<Renderer *> &shadowCastersRenderers) const
+AABox DirectionalLight::GetCameraFrustumAABoxInLightSpace(
+    const Matrix4 &worldToLight) const
 {
     // Adjust zFar so that we take into account shadow distance, and get our
     // camera frustum quads, then restore zFar
@@ -258,10 +287,6 @@ AABox DirectionalLight::GetShadowMapOrthoBox(
         }
     }
 
-    // Get light space matrix
-    const Matrix4 lightToWorld = GetLightToWorldMatrix();
-    const Matrix4 worldToLight = lightToWorld.Inversed();
-
     // Get the cam frustum AABox in light space (aligned with light direction)
     AABox camAABoxLS;
     for (const Vector3 &camFrustumPointWS : camFrustumPointsWS)
@@ -270,9 +295,19 @@ AABox DirectionalLight::GetShadowMapOrthoBox(
             worldToLight.TransformedPoint(camFrustumPointWS);
         camAABoxLS.AddPoint(camFrustumPointLS);
     }
+    return camAABoxLS;
+}
+
+AABox DirectionalLight::GetShadowMapOrthoBox(
+    const AABox &camAABoxLS,
+    const Array<ShadowCaster> &shadowCasters) const
+{
+    // Get light space matrix
+    const Matrix4 lightToWorld = GetLightToWorldMatrix();
+    const Matrix4 worldToLight = lightToWorld.Inversed();
 
     // Get scene AABox
-    const AABox sceneAABox = GetShadowCastersAABox(shadowCastersRenderers);
+    const AABox sceneAABox = GetShadowCastersAABox(shadowCasters);
 
     // Extend light box in y and z back and forth, so that we can intersect in
     // the next step
@@ -219,33 +219,10 @@ void Light::SetShadowLightCommonUniforms(ShaderProgram *sp) const
     }
 }
 
-Array<Renderer *> Light::GetShadowCastersIn(GameObject *go) const
+void Light::GetShadowCasters(const AABoxBVH::OverlapsFunction &overlaps,
+                             Array<ShadowCaster> *shadowCasters) const
 {
-    Array<Renderer *> validShadowCastersRends;
-
-    Array<Renderer *> shadowCastersRends =
-        go->GetComponentsInDescendantsAndThis<Renderer>();
-    for (Renderer *rend : shadowCastersRends)
-    {
-        if (rend->IsActiveRecursively() && rend->GetCastsShadows())
-        {
-            bool isValidShadowCaster = false;
-            if (const Material *mat = rend->GetActiveMaterial())
-            {
-                isValidShadowCaster =
-                    (mat->GetShaderProgramProperties().GetRenderPass() ==
-                         RenderPass::SCENE_OPAQUE &&
-                     rend->GetCastsShadows());
-            }
-
-            if (isValidShadowCaster)
-            {
-                validShadowCastersRends.PushBack(rend);
-            }
-        }
-    }
-
-    return validShadowCastersRends;
+    GEngine::GetInstance()->GetShadowCasters(overlaps, shadowCasters);
 }
 
 void Light::SetLightScreenPassShaderProgram(ShaderProgram *sp)
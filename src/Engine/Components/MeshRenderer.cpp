@@ -2,8 +2,10 @@
 
 #include "Bang/Assets.h"
 #include "Bang/Assets.tcc"
+#include "Bang/Camera.h"
 #include "Bang/ClassDB.h"
 #include "Bang/Extensions.h"
+#include "Bang/GEngine.h"
 #include "Bang/GL.h"
 #include "Bang/GUID.h"
 #include "Bang/GameObject.h"
@@ -21,6 +23,7 @@
 #include "Bang/ShaderProgram.h"
 #include "Bang/Transform.h"
 #include "Bang/Triangle.h"
+#include "Bang/UMap.tcc"
 
 using namespace Bang;
 
@@ -42,6 +45,11 @@ void MeshRenderer::SetMesh(Mesh *m)
     {
         p_sharedMesh.Set(m);
         p_mesh.Set(nullptr);
+
+        if (GetAutoLOD() && GetSharedMesh())
+        {
+            GetSharedMesh()->CalculateLODsAsync();
+        }
     }
 }
 
@@ -84,6 +92,11 @@ void MeshRenderer::SetCurrentLOD(int lod)
 void MeshRenderer::SetAutoLOD(bool autoLOD)
 {
     m_autoLOD = autoLOD;
+    if (GetAutoLOD() && GetActiveMesh())
+    {
+        // LODs are generated in background, and swapped in when ready
+        GetActiveMesh()->CalculateLODsAsync();
+    }
 }
 
 bool MeshRenderer::GetAutoLOD() const
@@ -102,6 +115,99 @@ Mesh *MeshRenderer::GetCurrentLODActiveMesh() const
                            : nullptr;
 }
 
+float MeshRenderer::GetScreenCoverage(Camera *camera) const
+{
+    Mesh *mesh = GetActiveMesh();
+    if (!camera || !mesh)
+    {
+        return 1.0f;
+    }
+
+    // Fraction of the camera half-height covered by the projected bounding
+    // sphere of the mesh
+    const Transform *tr = GetGameObject()->GetTransform();
+    const Sphere &localBSphere = mesh->GetBoundingSphere();
+    const Vector3 scale = tr->GetScale();
+    const float maxScale = Math::Max(
+        Math::Abs(scale.x), Math::Max(Math::Abs(scale.y), Math::Abs(scale.z)));
+    const float radius = localBSphere.GetRadius() * maxScale;
+    const Vector3 center =
+        tr->GetLocalToWorldMatrix().TransformedPoint(localBSphere.GetCenter());
+
+    if (camera->GetProjectionMode() == CameraProjectionMode::ORTHOGRAPHIC)
+    {
+        return radius / Math::Max(camera->GetOrthoHeight(), 0.0001f);
+    }
+
+    const Vector3 camPos = camera->GetGameObject()->GetTransform()->GetPosition();
+    const float distance = Vector3::Distance(camPos, center);
+    if (distance <= radius)
+    {
+        return 1.0f;
+    }
+
+    const float tanHalfFov =
+        Math::Tan(Math::DegToRad(camera->GetFovDegrees()) * 0.5f);
+    return radius / Math::Max(distance * tanHalfFov, 0.0001f);
+}
+
+int MeshRenderer::SelectAutoLOD(Camera *camera)
+{
+    // Full detail while the projected sphere covers at least this fraction of
+    // the screen half-height. Every LOD after it halves the coverage.
+    constexpr float FullDetailCoverage = 0.5f;
+    constexpr float Hysteresis = 0.2f;
+
+    Mesh *mesh = GetActiveMesh();
+    if (!mesh || !mesh->GetBonesPool().IsEmpty())
+    {
+        return 0;  // LODs do not keep the bones info
+    }
+
+    mesh->CalculateLODsAsync();
+    const int maxLOD = mesh->GetNumLODs() - 1;
+    if (maxLOD <= 0)
+    {
+        return 0;
+    }
+
+    GEngine *ge = GEngine::GetInstance();
+    const float lodBias = ge->GetLODBias();
+    const float coverage = Math::Max(GetScreenCoverage(camera), 0.00001f);
+    const float continuousLOD = Math::Max(
+        Math::Log(FullDetailCoverage / (coverage * lodBias)) / Math::Log(2.0f),
+        0.0f);
+
+    // Hysteresis: keep the previous LOD of this camera while the continuous
+    // LOD stays near its bucket, to avoid popping back and forth
+    int lod = SCAST<int>(continuousLOD);
+    const auto prevLODIt = m_camerasAutoLODs.Find(camera);
+    if (prevLODIt != m_camerasAutoLODs.End())
+    {
+        const int prevLOD = prevLODIt->second;
+        if (continuousLOD >= prevLOD - Hysteresis &&
+            continuousLOD < prevLOD + 1 + Hysteresis)
+        {
+            lod = prevLOD;
+        }
+    }
+    lod = Math::Clamp(lod, 0, maxLOD);
+
+    if (ge->IsRenderingShadowMaps())
+    {
+        // Shadow maps are low-res, use cheaper LODs, and do not touch the
+        // hysteresis state of the camera
+        return Math::Min(lod + ge->GetShadowMapsLODOffset(), maxLOD);
+    }
+
+    if (prevLODIt == m_camerasAutoLODs.End())
+    {
+        camera->EventEmitter<IEventsDestroy>::RegisterListener(this);
+    }
+    m_camerasAutoLODs[camera] = lod;
+    return lod;
+}
+
 void MeshRenderer::IntersectRay(const Ray &ray,
                                 bool *outIntersected,
                                 Vector3 *outIntersectionPoint,
@@ -249,17 +355,28 @@ AABox MeshRenderer::GetAABBox() const
     return GetActiveMesh() ? GetActiveMesh()->GetAABBox() : AABox::Empty();
 }
 
+void MeshRenderer::OnDestroyed(EventEmitter<IEventsDestroy> *object)
+{
+    m_camerasAutoLODs.Remove(DCAST<Camera *>(object));
+}
+
 void MeshRenderer::OnRender()
 {
     Renderer::OnRender();
 
     if (Mesh *baseMeshToRender = GetActiveMesh())
     {
-        Mesh *lodMeshToRender =
-            baseMeshToRender->GetLODMesh(GetCurrentLOD()).Get();
+        const int lod =
+            GetAutoLOD() ? SelectAutoLOD(GEngine::GetActiveRenderingCamera())
+                         : GetCurrentLOD();
+        Mesh *lodMeshToRender = baseMeshToRender->GetLODMesh(lod).Get();
         GL::Render(lodMeshToRender->GetVAO(),
                    GetRenderPrimitive(),
                    lodMeshToRender->GetNumVerticesIds());
+
+        GEngine::GetInstance()->AddRenderedTriangles(
+            lodMeshToRender->GetNumTriangles(),
+            baseMeshToRender->GetNumTriangles());
     }
 }
 
@@ -283,4 +400,5 @@ void MeshRenderer::Reflect()
         Mesh,
         BANG_REFLECT_HINT_EXTENSIONS(Extensions::GetMeshExtension()) +
             BANG_REFLECT_HINT_ZOOMABLE_PREVIEW(true));
+    BANG_REFLECT_VAR_MEMBER(MeshRenderer, "Auto LOD", SetAutoLOD, GetAutoLOD);
 }
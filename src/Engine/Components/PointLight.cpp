@@ -131,6 +131,8 @@ void PointLight::Reflect()
 
 void PointLight::RenderShadowMaps_(GameObject *go)
 {
+    BANG_UNUSED(go);
+
     GL::Push(GL::Pushable::VIEWPORT);
     GL::Push(GL::Pushable::COLOR_MASK);
     GL::Push(GL::Pushable::ALL_MATRICES);
@@ -162,24 +164,22 @@ void PointLight::RenderShadowMaps_(GameObject *go)
     float limit = Math::Exp(GetShadowExponentConstant());
     GL::ClearColorBuffer(Color(limit));
 
-    float rangeLimit = Math::Pow(GetRange(), 1.0f);
+    // Only render the casters that touch the light range sphere
+    const float sqRange = (GetRange() * GetRange());
     const Vector3 pointLightPos =
         GetGameObject()->GetTransform()->GetPosition();
-    const Array<Renderer *> shadowCastersRenderers = GetShadowCastersIn(go);
-    for (Renderer *shadowCasterRend : shadowCastersRenderers)
+    Array<ShadowCaster> shadowCastersInRange;
+    GetShadowCasters(
+        [&](const AABox &aaBoxWorld) {
+            const Vector3 closestPointInAABox =
+                aaBoxWorld.GetClosestPointInAABB(pointLightPos);
+            return (Vector3::SqDistance(closestPointInAABox, pointLightPos) <=
+                    sqRange);
+        },
+        &shadowCastersInRange);
+    for (const ShadowCaster &shadowCaster : shadowCastersInRange)
     {
-        AABox shadowCasterAABoxWorld = shadowCasterRend->GetGameObject()
-                                           ->GetTransform()
-                                           ->GetLocalToWorldMatrix() *
-                                       shadowCasterRend->GetAABBox();
-        Vector3 closestPointInAABox =
-            shadowCasterAABoxWorld.GetClosestPointInAABB(pointLightPos);
-        bool isCompletelyOutside =
-            Vector3::Distance(closestPointInAABox, pointLightPos) > rangeLimit;
-        if (!isCompletelyOutside)
-        {
-            shadowCasterRend->OnRender(RenderPass::SCENE_OPAQUE);
-        }
+        shadowCaster.renderer->OnRender(RenderPass::SCENE_OPAQUE);
     }
 
     // Blur shadow map
@@ -4,6 +4,10 @@
 #include "Bang/Framebuffer.h"
 #include "Bang/GBuffer.h"
 #include "Bang/GEngine.h"
+#include "Bang/GameObject.h"
+#include "Bang/PostProcessEffectToneMapping.h"
+#include "Bang/RenderTargetPool.h"
+#include "Bang/Scene.h"
 #include "Bang/ShaderProgram.h"
 #include "Bang/ShaderProgramFactory.h"
 #include "Bang/Texture2D.h"
@@ -14,36 +18,21 @@ PostProcessEffectBloom::PostProcessEffectBloom()
 {
     SET_INSTANCE_CLASS_ID(PostProcessEffectBloom);
 
-    m_brightnessTexture = Assets::Create<Texture2D>();
-    m_brightnessTexture.Get()->CreateEmpty(1, 1);
-    m_brightnessTexture.Get()->SetFilterMode(GL::FilterMode::BILINEAR);
-    m_brightnessTexture.Get()->SetWrapMode(GL::WrapMode::CLAMP_TO_EDGE);
-
-    m_blurAuxiliarTexture = Assets::Create<Texture2D>();
-    m_blurAuxiliarTexture.Get()->CreateEmpty(1, 1);
-    m_blurAuxiliarTexture.Get()->SetFilterMode(GL::FilterMode::BILINEAR);
-    m_blurAuxiliarTexture.Get()->SetWrapMode(GL::WrapMode::CLAMP_TO_EDGE);
-
-    m_blurredBloomTexture = Assets::Create<Texture2D>();
-    m_blurredBloomTexture.Get()->CreateEmpty(1, 1);
-    m_blurredBloomTexture.Get()->SetFilterMode(GL::FilterMode::BILINEAR);
-    m_blurredBloomTexture.Get()->SetWrapMode(GL::WrapMode::CLAMP_TO_EDGE);
-
     m_bloomFramebuffer = new Framebuffer();
-    m_bloomFramebuffer->SetAttachmentTexture(m_brightnessTexture.Get(),
-                                             GL::Attachment::COLOR0);
 
     p_bloomSP.Set(ShaderProgramFactory::Get(
         ShaderProgramFactory::GetScreenPassVertexShaderPath(),
         ShaderProgramFactory::GetEngineShadersDir().Append("Bloom.frag")));
 
-    // Trigger high bit depth format change
-    m_useHighBitDepthTextures = false;
     SetUseHighBitDepthTextures(true);
 }
 
 PostProcessEffectBloom::~PostProcessEffectBloom()
 {
+    if (GEngine::GetInstance())
+    {
+        ReleaseBloomTextures();
+    }
 }
 
 void PostProcessEffectBloom::OnRender(RenderPass renderPass)
@@ -52,6 +41,9 @@ void PostProcessEffectBloom::OnRender(RenderPass renderPass)
 
     if (MustBeRendered(renderPass))
     {
+        // In case the tone mapping did not render last frame
+        ReleaseBloomTextures();
+
         GL::Push(GL::Pushable::VIEWPORT);
         GL::Push(GL::Pushable::BLEND_STATES);
         GL::Push(GL::BindTarget::SHADER_PROGRAM);
@@ -67,13 +59,19 @@ void PostProcessEffectBloom::OnRender(RenderPass renderPass)
 
         GL::Disable(GL::Enablable::BLEND);
 
-        m_brightnessTexture.Get()->Resize(bloomTexSize);
-        m_blurAuxiliarTexture.Get()->Resize(bloomTexSize);
-        m_blurredBloomTexture.Get()->Resize(bloomTexSize);
-
         GEngine *ge = GEngine::GetInstance();
+        RenderTargetPool *rtPool = ge->GetRenderTargetPool();
+        const RenderTargetDesc bloomTexDesc(
+            bloomTexSize,
+            (GetUseHighBitDepthTextures() ? GL::ColorFormat::RGBA16F
+                                          : GL::ColorFormat::RGB10_A2));
+        p_brightnessTexture = rtPool->Acquire(bloomTexDesc, "Bloom");
+        p_blurAuxiliarTexture = rtPool->Acquire(bloomTexDesc, "Bloom");
+        p_blurredBloomTexture = rtPool->Acquire(bloomTexDesc, "Bloom");
 
         m_bloomFramebuffer->Bind();
+        m_bloomFramebuffer->SetAttachmentTexture(p_brightnessTexture,
+                                                 GL::Attachment::COLOR0);
         m_bloomFramebuffer->SetAllDrawBuffers();
 
         // Extract bright pixels
@@ -91,9 +89,9 @@ void PostProcessEffectBloom::OnRender(RenderPass renderPass)
         if (GetBlurRadius() > 0)
         {
             ge->BlurTexture(
-                m_brightnessTexture.Get(),
-                m_blurAuxiliarTexture.Get(),
-                m_blurredBloomTexture.Get(),
+                p_brightnessTexture,
+                p_blurAuxiliarTexture,
+                p_blurredBloomTexture,
                 GetBlurRadius(),
                 (GetUseKawaseBlur() ? BlurType::KAWASE : BlurType::GAUSSIAN));
         }
@@ -101,9 +99,27 @@ void PostProcessEffectBloom::OnRender(RenderPass renderPass)
         GL::Pop(GL::Pushable::FRAMEBUFFER_AND_READ_DRAW_ATTACHMENTS);
         GL::Pop(GL::Pushable::VIEWPORT);
 
-        sp->SetBool("B_ExtractingBrightPixels", false);
-        sp->SetTexture2D("B_BlurredBloomTexture", GetFinalBloomTexture());
-        ge->GetActiveGBuffer()->ApplyPass(sp, true);
+        // Bloom is additive, so adding it in the tone mapping pass is the
+        // same, and saves a full resolution pass
+        p_compositingToneMapping = FindCompositingToneMapping();
+        if (!GetCompositingToneMapping())
+        {
+            sp->SetBool("B_ExtractingBrightPixels", false);
+            sp->SetTexture2D("B_BlurredBloomTexture", GetFinalBloomTexture());
+            ge->GetActiveGBuffer()->ApplyPass(sp, true);
+            ReleaseBloomTextures();
+        }
+        else
+        {
+            // Only the final texture is kept until the tone mapping
+            if (p_brightnessTexture != GetFinalBloomTexture())
+            {
+                rtPool->Release(p_brightnessTexture);
+                p_brightnessTexture = nullptr;
+            }
+            rtPool->Release(p_blurAuxiliarTexture);
+            p_blurAuxiliarTexture = nullptr;
+        }
 
         GL::Pop(GL::BindTarget::SHADER_PROGRAM);
         GL::Pop(GL::Pushable::BLEND_STATES);
@@ -138,18 +154,7 @@ void PostProcessEffectBloom::SetBrightnessThreshold(float brightnessThreshold)
 void PostProcessEffectBloom::SetUseHighBitDepthTextures(
     bool useHighBitDepthTextures)
 {
-    if (useHighBitDepthTextures != GetUseHighBitDepthTextures())
-    {
-        m_useHighBitDepthTextures = useHighBitDepthTextures;
-
-        GL::ColorFormat colorFormat =
-            (GetUseHighBitDepthTextures() ? GL::ColorFormat::RGBA16F
-                                          : GL::ColorFormat::RGB10_A2);
-
-        m_brightnessTexture.Get()->SetFormat(colorFormat);
-        m_blurAuxiliarTexture.Get()->SetFormat(colorFormat);
-        m_blurredBloomTexture.Get()->SetFormat(colorFormat);
-    }
+    m_useHighBitDepthTextures = useHighBitDepthTextures;
 }
 
 uint PostProcessEffectBloom::GetDownscale() const
@@ -179,8 +184,7 @@ float PostProcessEffectBloom::GetBrightnessThreshold() const
 
 Texture2D *PostProcessEffectBloom::GetFinalBloomTexture() const
 {
-    return GetBlurRadius() > 0 ? m_blurredBloomTexture.Get()
-                               : m_brightnessTexture.Get();
+    return GetBlurRadius() > 0 ? p_blurredBloomTexture : p_brightnessTexture;
 }
 
 bool PostProcessEffectBloom::GetUseHighBitDepthTextures() const
@@ -193,6 +197,84 @@ ShaderProgram *PostProcessEffectBloom::GetBloomShaderProgram() const
     return p_bloomSP.Get();
 }
 
+void PostProcessEffectBloom::SetCompositeInToneMapping(
+    bool compositeInToneMapping)
+{
+    m_compositeInToneMapping = compositeInToneMapping;
+}
+
+bool PostProcessEffectBloom::GetCompositeInToneMapping() const
+{
+    return m_compositeInToneMapping;
+}
+
+PostProcessEffectToneMapping *
+PostProcessEffectBloom::GetCompositingToneMapping() const
+{
+    return p_compositingToneMapping;
+}
+
+PostProcessEffectToneMapping *
+PostProcessEffectBloom::FindCompositingToneMapping() const
+{
+    if (!GetCompositeInToneMapping() || !GetGameObject())
+    {
+        return nullptr;
+    }
+
+    // The passes of other types are apart, with the lights or the canvas
+    // rendered in between
+    PostProcessEffectToneMapping *toneMapping =
+        GetGameObject()->GetComponent<PostProcessEffectToneMapping>();
+    if (!toneMapping || !toneMapping->IsEnabledRecursively() ||
+        toneMapping->GetType() != GetType())
+    {
+        return nullptr;
+    }
+
+    // Within a pass, the effects render in the order of the hierarchy, the
+    // components of a game object before its children
+    GameObject *root = GetGameObject()->GetScene();
+    if (!root)
+    {
+        root = GetGameObject();
+    }
+    const Array<PostProcessEffect *> effects =
+        root->GetComponentsInDescendantsAndThis<PostProcessEffect>();
+    const int bloomIndex =
+        effects.IndexOf(const_cast<PostProcessEffectBloom *>(this));
+    const int toneMappingIndex = effects.IndexOf(toneMapping);
+    if (bloomIndex >= toneMappingIndex)
+    {
+        return nullptr;
+    }
+
+    for (int i = bloomIndex + 1; i < toneMappingIndex; ++i)
+    {
+        if (effects[i]->GetType() == GetType() &&
+            effects[i]->IsEnabledRecursively())
+        {
+            return nullptr;
+        }
+    }
+    return toneMapping;
+}
+
+void PostProcessEffectBloom::ReleaseBloomTextures()
+{
+    RenderTargetPool *rtPool = GEngine::GetInstance()->GetRenderTargetPool();
+    for (Texture2D **texture : {&p_brightnessTexture,
+                                &p_blurAuxiliarTexture,
+                                &p_blurredBloomTexture})
+    {
+        if (*texture)
+        {
+            rtPool->Release(*texture);
+            *texture = nullptr;
+        }
+    }
+}
+
 void PostProcessEffectBloom::Reflect()
 {
     PostProcessEffect::Reflect();
@@ -231,4 +313,9 @@ void PostProcessEffectBloom::Reflect()
                                    SetDownscale,
                                    GetDownscale,
                                    BANG_REFLECT_HINT_MIN_VALUE(1.0f));
+
+    BANG_REFLECT_VAR_MEMBER(PostProcessEffectBloom,
+                            "Composite in tone mapping",
+                            SetCompositeInToneMapping,
+                            GetCompositeInToneMapping);
 }
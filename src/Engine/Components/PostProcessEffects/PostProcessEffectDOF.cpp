@@ -3,6 +3,8 @@
 #include "Bang/Assets.h"
 #include "Bang/GBuffer.h"
 #include "Bang/GEngine.h"
+#include "Bang/Math.h"
+#include "Bang/RenderTargetPool.h"
 #include "Bang/ShaderProgram.h"
 #include "Bang/ShaderProgramFactory.h"
 #include "Bang/Texture2D.h"
@@ -13,16 +15,6 @@ PostProcessEffectDOF::PostProcessEffectDOF()
 {
     SET_INSTANCE_CLASS_ID(PostProcessEffectDOF);
 
-    m_blurredTexture = Assets::Create<Texture2D>();
-    m_blurredTexture.Get()->CreateEmpty(1, 1);
-    m_blurredTexture.Get()->SetFilterMode(GL::FilterMode::BILINEAR);
-    m_blurredTexture.Get()->SetWrapMode(GL::WrapMode::CLAMP_TO_EDGE);
-
-    m_blurAuxiliarTexture = Assets::Create<Texture2D>();
-    m_blurAuxiliarTexture.Get()->CreateEmpty(1, 1);
-    m_blurAuxiliarTexture.Get()->SetFilterMode(GL::FilterMode::BILINEAR);
-    m_blurAuxiliarTexture.Get()->SetWrapMode(GL::WrapMode::CLAMP_TO_EDGE);
-
     m_dofSP.Set(ShaderProgramFactory::Get(
         ShaderProgramFactory::GetScreenPassVertexShaderPath(),
         ShaderProgramFactory::GetEngineShadersDir().Append(
@@ -45,22 +37,42 @@ void PostProcessEffectDOF::OnRender(RenderPass renderPass)
         GL::Push(GL::Pushable::BLEND_STATES);
         GL::Push(GL::BindTarget::SHADER_PROGRAM);
 
-        Vector2i dofTexSize = GL::GetViewportSize();
-        GL::SetViewport(0, 0, dofTexSize.x, dofTexSize.y);
-
         GL::Push(GL::Pushable::FRAMEBUFFER_AND_READ_DRAW_ATTACHMENTS);
 
         GL::Disable(GL::Enablable::BLEND);
 
         GEngine *ge = GEngine::GetInstance();
+        RenderTargetPool *rtPool = ge->GetRenderTargetPool();
 
+        // The blurred color is only seen out of focus, so it is blurred at a
+        // fraction of the resolution and upsampled bilinearly when mixing
         Texture2D *sceneColorTexture =
             ge->GetActiveGBuffer()->GetDrawColorTexture();
-        ge->BlurTexture(sceneColorTexture,
-                        m_blurAuxiliarTexture.Get(),
-                        m_blurredTexture.Get(),
+        const Vector2i blurTexSize =
+            Vector2i::Max(sceneColorTexture->GetSize() /
+                              SCAST<int>(Math::Max(GetDownscale(), 1u)),
+                          Vector2i::One());
+        const RenderTargetDesc blurTexDesc(blurTexSize,
+                                           sceneColorTexture->GetFormat());
+
+        Texture2D *downscaledTexture = sceneColorTexture;
+        if (blurTexSize != sceneColorTexture->GetSize())
+        {
+            downscaledTexture = rtPool->Acquire(blurTexDesc, "DOF");
+            ge->DownscaleTexture(sceneColorTexture, downscaledTexture);
+        }
+
+        Texture2D *blurAuxiliarTexture = rtPool->Acquire(blurTexDesc, "DOF");
+        Texture2D *blurredTexture = rtPool->Acquire(blurTexDesc, "DOF");
+        ge->BlurTexture(downscaledTexture,
+                        blurAuxiliarTexture,
+                        blurredTexture,
                         GetBlurRadius(),
                         BlurType::KAWASE);
+        if (downscaledTexture != sceneColorTexture)
+        {
+            rtPool->Release(downscaledTexture);
+        }
 
         GL::Pop(GL::Pushable::FRAMEBUFFER_AND_READ_DRAW_ATTACHMENTS);
         GL::Pop(GL::Pushable::VIEWPORT);
@@ -82,10 +94,13 @@ void PostProcessEffectDOF::OnRender(RenderPass renderPass)
         sp->SetFloat("B_FarDistance", GetFarDistance());
         sp->SetTexture2D("B_SceneDepthTexture", sceneDepthTexture);
         sp->SetTexture2D("B_SceneColorTexture", sceneColorTexture);
-        sp->SetTexture2D("B_BlurredSceneColorTexture", m_blurredTexture.Get());
+        sp->SetTexture2D("B_BlurredSceneColorTexture", blurredTexture);
 
         ge->GetActiveGBuffer()->ApplyPass(sp, true);
 
+        rtPool->Release(blurAuxiliarTexture);
+        rtPool->Release(blurredTexture);
+
         GL::Pop(GL::BindTarget::SHADER_PROGRAM);
         GL::Pop(GL::Pushable::BLEND_STATES);
     }
@@ -161,6 +176,16 @@ uint PostProcessEffectDOF::GetBlurRadius() const
     return m_blurRadius;
 }
 
+void PostProcessEffectDOF::SetDownscale(uint downscale)
+{
+    m_downscale = downscale;
+}
+
+uint PostProcessEffectDOF::GetDownscale() const
+{
+    return m_downscale;
+}
+
 void PostProcessEffectDOF::Reflect()
 {
     PostProcessEffect::Reflect();
@@ -218,4 +243,10 @@ void PostProcessEffectDOF::Reflect()
                                    SetBlurRadius,
                                    GetBlurRadius,
                                    BANG_REFLECT_HINT_MIN_VALUE(1.0f));
+
+    BANG_REFLECT_VAR_MEMBER_HINTED(PostProcessEffectDOF,
+                                   "Downscale",
+                                   SetDownscale,
+                                   GetDownscale,
+                                   BANG_REFLECT_HINT_MIN_VALUE(1.0f));
 }
@@ -21,6 +21,7 @@
 #include "Bang/MetaNode.tcc"
 #include "Bang/Paths.h"
 #include "Bang/Random.h"
+#include "Bang/RenderTargetPool.h"
 #include "Bang/ShaderProgram.h"
 #include "Bang/ShaderProgramFactory.h"
 #include "Bang/Texture2D.h"
@@ -43,10 +44,6 @@ PostProcessEffectSSAO::PostProcessEffectSSAO()
     m_ssaoFB->GetAttachmentTex2D(GL::Attachment::COLOR0)
         ->SetWrapMode(GL::WrapMode::CLAMP_TO_EDGE);
 
-    m_blurAuxiliarTexture = Assets::Create<Texture2D>();
-    m_blurAuxiliarTexture.Get()->SetFormat(GL::ColorFormat::RGB10_A2);
-    m_blurAuxiliarTexture.Get()->SetWrapMode(GL::WrapMode::CLAMP_TO_EDGE);
-
     m_blurredSSAOTexture = Assets::Create<Texture2D>();
     m_blurredSSAOTexture.Get()->SetFormat(GL::ColorFormat::RGB10_A2);
     m_blurredSSAOTexture.Get()->SetWrapMode(GL::WrapMode::CLAMP_TO_EDGE);
@@ -87,9 +84,14 @@ void PostProcessEffectSSAO::OnRender(RenderPass renderPass)
         // Get references
         GBuffer *gbuffer = GEngine::GetActiveGBuffer();
 
-        // Prepare state
+        // Prepare state. The occlusion is low frequency, so it is computed
+        // at a fraction of the resolution, and upsampled when applying it
         m_ssaoFB->Bind();
-        SetFBSize(Vector2(GL::GetViewportSize()));
+        const Vector2i ssaoSize =
+            Vector2i::Max(GL::GetViewportSize() /
+                              SCAST<int>(Math::Max(GetDownscale(), 1u)),
+                          Vector2i::One());
+        SetFBSize(Vector2(ssaoSize));
         GL::SetViewport(0, 0, GetFBSize().x, GetFBSize().y);
 
         // First do SSAO
@@ -98,8 +100,7 @@ void PostProcessEffectSSAO::OnRender(RenderPass renderPass)
 
             // Bind random textures and set uniforms
             Vector2 randomAxesUvMult(
-                (Vector2(GL::GetViewportSize()) /
-                 Vector2(m_randomAxesTexture.Get()->GetSize())));
+                (GetFBSize() / Vector2(m_randomAxesTexture.Get()->GetSize())));
             p_ssaoShaderProgram.Get()->SetFloat("B_SSAORadius",
                                                 GetSSAORadius());
             p_ssaoShaderProgram.Get()->SetVector2("B_RandomAxesUvMultiply",
@@ -128,12 +129,19 @@ void PostProcessEffectSSAO::OnRender(RenderPass renderPass)
         if (GetBlurRadius() > 0)
         {
             GEngine *ge = GEngine::GetInstance();
-            ge->BlurTexture(
-                m_ssaoFB->GetAttachmentTex2D(GL::Attachment::COLOR0),
-                m_blurAuxiliarTexture.Get(),
-                m_blurredSSAOTexture.Get(),
-                GetBlurRadius(),
-                BlurType::KAWASE);
+            RenderTargetPool *rtPool = ge->GetRenderTargetPool();
+            Texture2D *ssaoTexture =
+                m_ssaoFB->GetAttachmentTex2D(GL::Attachment::COLOR0);
+            Texture2D *blurAuxiliarTexture = rtPool->Acquire(
+                RenderTargetDesc(ssaoTexture->GetSize(),
+                                 GL::ColorFormat::RGB10_A2),
+                "SSAO");
+            ge->BlurTexture(ssaoTexture,
+                            blurAuxiliarTexture,
+                            m_blurredSSAOTexture.Get(),
+                            GetBlurRadius(),
+                            BlurType::KAWASE);
+            rtPool->Release(blurAuxiliarTexture);
         }
 
         GL::Pop(GL::Pushable::FRAMEBUFFER_AND_READ_DRAW_ATTACHMENTS);
@@ -145,6 +153,8 @@ void PostProcessEffectSSAO::OnRender(RenderPass renderPass)
                                                      GetSSAOIntensity());
             p_applySSAOShaderProgram.Get()->SetTexture2D("B_SSAOMap",
                                                          GetSSAOTexture());
+            p_applySSAOShaderProgram.Get()->SetVector2("B_SSAOMapSize",
+                                                       GetFBSize());
             gbuffer->ApplyPass(p_applySSAOShaderProgram.Get(), true);
         }
 
@@ -273,6 +283,16 @@ const Vector2 &PostProcessEffectSSAO::GetFBSize() const
     return m_fbSize;
 }
 
+void PostProcessEffectSSAO::SetDownscale(uint downscale)
+{
+    m_downscale = downscale;
+}
+
+uint PostProcessEffectSSAO::GetDownscale() const
+{
+    return m_downscale;
+}
+
 Texture2D *PostProcessEffectSSAO::GetSSAOTexture() const
 {
     return (GetBlurRadius() > 0
@@ -313,6 +333,12 @@ void PostProcessEffectSSAO::Reflect()
                                    SetNumRandomSamples,
                                    GetNumRandomSamples,
                                    BANG_REFLECT_HINT_MIN_VALUE(1.0f));
+
+    BANG_REFLECT_VAR_MEMBER_HINTED(PostProcessEffectSSAO,
+                                   "Downscale",
+                                   SetDownscale,
+                                   GetDownscale,
+                                   BANG_REFLECT_HINT_MIN_VALUE(1.0f));
 }
 
 void PostProcessEffectSSAO::GenerateRandomAxesTexture(int numAxes)
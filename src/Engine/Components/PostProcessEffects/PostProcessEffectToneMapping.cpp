@@ -2,6 +2,8 @@
 
 #include "Bang/GBuffer.h"
 #include "Bang/GEngine.h"
+#include "Bang/GameObject.h"
+#include "Bang/PostProcessEffectBloom.h"
 #include "Bang/ShaderProgram.h"
 #include "Bang/ShaderProgramFactory.h"
 
@@ -34,8 +36,25 @@ void PostProcessEffectToneMapping::OnRender(RenderPass renderPass)
         sp->Bind();
         sp->SetFloat("B_Exposure", GetExposure());
 
+        // Composite of the bloom, if it left it for this pass
+        PostProcessEffectBloom *bloom =
+            GetGameObject()->GetComponent<PostProcessEffectBloom>();
+        Texture2D *bloomTexture = nullptr;
+        if (bloom && bloom->GetCompositingToneMapping() == this)
+        {
+            bloomTexture = bloom->GetFinalBloomTexture();
+        }
+        sp->SetBool("B_CompositeBloom", (bloomTexture != nullptr));
+        sp->SetTexture2D("B_BloomTexture", bloomTexture);
+        sp->SetFloat("B_BloomIntensity", bloom ? bloom->GetIntensity() : 0.0f);
+
         ge->GetActiveGBuffer()->ApplyPass(sp, true);
 
+        if (bloomTexture)
+        {
+            bloom->ReleaseBloomTextures();
+        }
+
         GL::Pop(GL::BindTarget::SHADER_PROGRAM);
     }
 }
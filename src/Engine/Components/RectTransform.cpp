@@ -19,6 +19,7 @@
 #include "Bang/Rect.h"
 #include "Bang/StreamOperators.h"
 #include "Bang/Transform.h"
+#include "Bang/UIFocusIndex.h"
 #include "Bang/Vector4.h"
 #include "Bang/Window.h"
 
@@ -548,6 +549,24 @@ void RectTransform::InvalidateTransform()
     m_vpInWhichRectTransformLocalToWorldWasCalc = AARecti::Zero();
 }
 
+void RectTransform::OnTransformChanged()
+{
+    // Only where the change starts, the invalidation covers the subtree
+    if (!m_propagatedTransformChange)
+    {
+        UIFocusIndex::Invalidate(GetGameObject());
+    }
+    Transform::OnTransformChanged();
+}
+
+void RectTransform::OnParentTransformChanged()
+{
+    const bool prevPropagatedTransformChange = m_propagatedTransformChange;
+    m_propagatedTransformChange = true;
+    Transform::OnParentTransformChanged();
+    m_propagatedTransformChange = prevPropagatedTransformChange;
+}
+
 void RectTransform::CalculateRectLocalToWorldMatrix() const
 {
     const AARect parentAARect = GetParentViewportAARectWithoutTransform();
@@ -706,13 +725,23 @@ void RectTransform::WarnWrongAnchorsIfNeeded()
 void RectTransform::OnEnabled(Object *object)
 {
     Transform::OnEnabled(object);
-    OnTransformChanged();
+    OnEnabledChanged(object);
 }
 
 void RectTransform::OnDisabled(Object *object)
 {
     Transform::OnDisabled(object);
+    OnEnabledChanged(object);
+}
+
+void RectTransform::OnEnabledChanged(Object *object)
+{
+    // Game objects invalidate the focus indices themselves when enabled or
+    // disabled, for all their descendants
+    const bool prevPropagatedTransformChange = m_propagatedTransformChange;
+    m_propagatedTransformChange = (object != this);
     OnTransformChanged();
+    m_propagatedTransformChange = prevPropagatedTransformChange;
 }
 
 void RectTransform::Reflect()
@@ -1,14 +1,18 @@
 #include "Bang/ReflectionProbe.h"
 
+#include <array>
+#include <cstring>
 #include <istream>
 
 #include "Bang/Assert.h"
 #include "Bang/Assets.h"
 #include "Bang/Assets.tcc"
+#include "Bang/CacheFile.h"
 #include "Bang/Camera.h"
 #include "Bang/ClassDB.h"
 #include "Bang/CubeMapIBLGenerator.h"
 #include "Bang/Extensions.h"
+#include "Bang/File.h"
 #include "Bang/Flags.h"
 #include "Bang/GBuffer.h"
 #include "Bang/GEngine.h"
@@ -16,14 +20,21 @@
 #include "Bang/GameObject.h"
 #include "Bang/GameObject.tcc"
 #include "Bang/GameObjectFactory.h"
+#include "Bang/Hash.h"
+#include "Bang/Material.h"
 #include "Bang/Math.h"
+#include "Bang/Mesh.h"
+#include "Bang/MeshRenderer.h"
 #include "Bang/MetaNode.h"
 #include "Bang/MetaNode.tcc"
+#include "Bang/Paths.h"
 #include "Bang/RenderFlags.h"
 #include "Bang/RenderPass.h"
+#include "Bang/RenderTargetPool.h"
 #include "Bang/Renderer.h"
 #include "Bang/Scene.h"
 #include "Bang/ShaderProgram.h"
+#include "Bang/Texture2D.h"
 #include "Bang/TextureCubeMap.h"
 #include "Bang/TextureFactory.h"
 #include "Bang/Transform.h"
@@ -38,11 +49,27 @@ class Array;
 
 using namespace Bang;
 
+constexpr uint ReflectionProbe::BakeCacheMagic;
+constexpr uint ReflectionProbe::BakeCacheVersion;
+
+bool ReflectionProbe::BakeCacheHeader::operator!=(
+    const BakeCacheHeader &rhs) const
+{
+    return (magic != rhs.magic) || (version != rhs.version) ||
+           (renderSize != rhs.renderSize) ||
+           (filterForIBL != rhs.filterForIBL) ||
+           (diffuseIBLSize != rhs.diffuseIBLSize) ||
+           (specularIBLSize != rhs.specularIBLSize) ||
+           (sceneGeometryHash != rhs.sceneGeometryHash) ||
+           (position != rhs.position);
+}
+
 ReflectionProbe::ReflectionProbe()
 {
     SET_INSTANCE_CLASS_ID(ReflectionProbe);
 
     m_restTime.SetSeconds(0.5);
+    m_faceTextures.fill(nullptr);
     p_textureCubeMapWithoutFiltering.Set(new TextureCubeMap());
     p_textureCubeMapDiffuse.Set(new TextureCubeMap());
     p_textureCubeMapSpecular.Set(new TextureCubeMap());
@@ -72,9 +99,14 @@ ReflectionProbe::ReflectionProbe()
         }
 
         GameObject *camGo = GameObjectFactory::CreateGameObject();
+        // The cameras render into a GBuffer of the RenderTargetPool, so their
+        // own GBuffer is left at 1x1. Captures skip the shadow maps, decals
+        // and post-processes, which barely show in the blurry reflections
         Camera *cam = camGo->AddComponent<Camera>();
-        cam->SetRenderSize(Vector2i(256));
         cam->SetFovDegrees(90.0f);
+        cam->RemoveRenderPass(RenderPass::SCENE_DECALS);
+        cam->RemoveRenderPass(RenderPass::SCENE_BEFORE_ADDING_LIGHTS);
+        cam->RemoveRenderPass(RenderPass::SCENE_AFTER_ADDING_LIGHTS);
         cam->RemoveRenderPass(RenderPass::OVERLAY);
         cam->RemoveRenderPass(RenderPass::OVERLAY_POSTPROCESS);
         cam->RemoveRenderPass(RenderPass::CANVAS);
@@ -97,6 +129,7 @@ ReflectionProbe::ReflectionProbe()
 
 ReflectionProbe::~ReflectionProbe()
 {
+    ReleaseFaceTextures();
     for (uint i = 0; i < GL::GetAllCubeMapDirs().size(); ++i)
     {
         GameObject::Destroy(GetCameras()[i]->GetGameObject());
@@ -107,48 +140,398 @@ void ReflectionProbe::RenderReflectionProbe(bool force)
 {
     bool hasRested =
         (Time::GetPassedTimeSince(m_lastRenderTime) >= GetRestTime());
-    if (hasRested || force)
+    if (hasRested || force || IsUpdateInProgress())
     {
-        // Render from each of the 6 cameras...
-        for (uint i = 0; i < GL::GetAllCubeMapDirs().size(); ++i)
+        if (!IsUpdateInProgress())
         {
-            GameObject *camGo = GetCameras()[i]->GetGameObject();
-            camGo->GetTransform()->SetPosition(
-                GetGameObject()->GetTransform()->GetPosition());
+            m_updateStep = 0;
+            m_updateInProgress = true;
+        }
+        RenderReflectionProbeSteps(GetNumUpdateSteps());
+    }
+}
 
-            Camera *cam = camGo->GetComponent<Camera>();
-            GEngine::GetInstance()->RenderToGBuffer(GetGameObject()->GetScene(),
-                                                    cam);
+uint ReflectionProbe::RenderReflectionProbeSteps(uint maxSteps)
+{
+    // Static probes are captured only once, or loaded from their cached bake.
+    // They do not take any budget afterwards
+    if (GetIsStatic())
+    {
+        if (!m_isBaked)
+        {
+            m_isBaked = true;
+            if (!LoadBakeFromCache())
+            {
+                m_updateStep = 0;
+                m_updateInProgress = true;
+                RenderReflectionProbeSteps(GetNumUpdateSteps());
+                SaveBakeToCache();
+            }
+            m_hasBeenRendered = true;
         }
 
-#define BANG_GET_TEX(CubeMapDir)                     \
-    GetCameras()[GL::GetCubeMapDirIndex(CubeMapDir)] \
-        ->GetGBuffer()                               \
-        ->GetDrawColorTexture()
+        if (!IsUpdateInProgress())
+        {
+            return 0;
+        }
+    }
 
-        GEngine::GetInstance()->FillCubeMapFromTextures(
-            GetTextureCubeMapWithoutFiltering(),
-            BANG_GET_TEX(GL::CubeMapDir::TOP),
-            BANG_GET_TEX(GL::CubeMapDir::BOT),
-            BANG_GET_TEX(GL::CubeMapDir::LEFT),
-            BANG_GET_TEX(GL::CubeMapDir::RIGHT),
-            BANG_GET_TEX(GL::CubeMapDir::FRONT),
-            BANG_GET_TEX(GL::CubeMapDir::BACK));
-
-        if (GetFilterForIBL())
+    if (!IsUpdateInProgress())
+    {
+        bool hasRested =
+            (Time::GetPassedTimeSince(m_lastRenderTime) >= GetRestTime());
+        if (!hasRested || maxSteps == 0)
+        {
+            return 0;
+        }
+
+        m_updateStep = 0;
+        m_updateInProgress = true;
+
+        // Nothing valid would be shown until the first capture finishes, so
+        // that one is not sliced
+        if (!m_hasBeenRendered)
         {
-            p_textureCubeMapDiffuse =
-                CubeMapIBLGenerator::GenerateDiffuseIBLCubeMap(
-                    GetTextureCubeMapWithoutFiltering(), 16, 10);
-            p_textureCubeMapSpecular =
-                CubeMapIBLGenerator::GenerateSpecularIBLCubeMap(
-                    GetTextureCubeMapWithoutFiltering(), 128, 64);
+            maxSteps = GetNumUpdateSteps();
         }
+    }
+
+    uint usedSteps = 0;
+    while (IsUpdateInProgress() && usedSteps < maxSteps)
+    {
+        RenderUpdateStep(m_updateStep);
+        ++m_updateStep;
+        ++usedSteps;
 
-        m_lastRenderTime = Time::GetNow();
+        if (m_updateStep >= GetNumUpdateSteps())
+        {
+            m_updateInProgress = false;
+            m_hasBeenRendered = true;
+            m_lastRenderTime = Time::GetNow();
+        }
     }
+    return usedSteps;
+}
+
+bool ReflectionProbe::IsUpdateInProgress() const
+{
+    return m_updateInProgress;
+}
+
+void ReflectionProbe::Rebake()
+{
+    const Path bakeCachePath = GetBakeCachePath();
+    if (bakeCachePath.IsFile())
+    {
+        File::Remove(bakeCachePath);
+    }
+    m_isBaked = false;
+}
+
+uint ReflectionProbe::GetNumUpdateSteps() const
+{
+    // 6 faces + cube map fill [+ diffuse + specular mip levels]
+    uint numUpdateSteps = 7;
+    if (GetFilterForIBL())
+    {
+        numUpdateSteps +=
+            1 + CubeMapIBLGenerator::GetSpecularIBLNumMipMaps(SpecularIBLSize);
+    }
+    return numUpdateSteps;
+}
+
+void ReflectionProbe::RenderUpdateStep(uint updateStep)
+{
+    const uint numFaces = GL::GetAllCubeMapDirs().size();
+    if (updateStep < numFaces)
+    {
+        RenderFace(updateStep);
+    }
+    else if (updateStep == numFaces)
+    {
+        FillCubeMapFromFaces();
+    }
+    else if (updateStep == numFaces + 1)
+    {
+        CubeMapIBLGenerator::FillDiffuseIBLCubeMap(
+            GetTextureCubeMapWithoutFiltering(),
+            p_textureCubeMapDiffuse.Get(),
+            DiffuseIBLSize,
+            DiffuseIBLSampleCount);
+    }
+    else
+    {
+        const uint mipMapLevel = (updateStep - (numFaces + 2));
+        CubeMapIBLGenerator::FillSpecularIBLCubeMapMipMap(
+            GetTextureCubeMapWithoutFiltering(),
+            p_textureCubeMapSpecular.Get(),
+            SpecularIBLSize,
+            SpecularIBLSampleCount,
+            mipMapLevel);
+    }
+}
+
+void ReflectionProbe::RenderFace(uint faceIndex)
+{
+    GEngine *ge = GEngine::GetInstance();
+    RenderTargetPool *rtPool = ge->GetRenderTargetPool();
+
+    // Render the face camera into a transient GBuffer, and keep a copy of
+    // its color until the cube map is filled
+    const Vector2i renderSize(GetRenderSize());
+    GBuffer *gbuffer = rtPool->AcquireGBuffer(renderSize, "ReflectionProbe");
+
+    GameObject *camGo = GetCameras()[faceIndex]->GetGameObject();
+    camGo->GetTransform()->SetPosition(
+        GetGameObject()->GetTransform()->GetPosition());
+
+    Camera *cam = camGo->GetComponent<Camera>();
+    cam->SetReplacementGBuffer(gbuffer);
+    ge->RenderToGBuffer(GetGameObject()->GetScene(), cam);
+    cam->SetReplacementGBuffer(nullptr);
+
+    Texture2D *colorTex = gbuffer->GetDrawColorTexture();
+    Texture2D *&faceTexture = m_faceTextures[faceIndex];
+    if (faceTexture && faceTexture->GetSize() != renderSize)
+    {
+        rtPool->Release(faceTexture);
+        faceTexture = nullptr;
+    }
+
+    if (!faceTexture)
+    {
+        faceTexture =
+            rtPool->Acquire(RenderTargetDesc(renderSize, colorTex->GetFormat()),
+                            "ReflectionProbe");
+    }
+    ge->CopyTexture(colorTex, faceTexture);
+    rtPool->ReleaseGBuffer(gbuffer);
+}
+
+void ReflectionProbe::FillCubeMapFromFaces()
+{
+#define BANG_GET_TEX(CubeMapDir) \
+    m_faceTextures[GL::GetCubeMapDirIndex(CubeMapDir)]
+
+    GEngine::GetInstance()->FillCubeMapFromTextures(
+        GetTextureCubeMapWithoutFiltering(),
+        BANG_GET_TEX(GL::CubeMapDir::TOP),
+        BANG_GET_TEX(GL::CubeMapDir::BOT),
+        BANG_GET_TEX(GL::CubeMapDir::LEFT),
+        BANG_GET_TEX(GL::CubeMapDir::RIGHT),
+        BANG_GET_TEX(GL::CubeMapDir::FRONT),
+        BANG_GET_TEX(GL::CubeMapDir::BACK));
 
 #undef BANG_GET_TEX
+
+    ReleaseFaceTextures();
+}
+
+void ReflectionProbe::ReleaseFaceTextures()
+{
+    RenderTargetPool *rtPool = RenderTargetPool::GetInstance();
+    for (Texture2D *&faceTexture : m_faceTextures)
+    {
+        if (faceTexture && rtPool)
+        {
+            rtPool->Release(faceTexture);
+        }
+        faceTexture = nullptr;
+    }
+}
+
+Path ReflectionProbe::GetBakeCachePath() const
+{
+    if (Paths::GetProjectDir().IsEmpty())
+    {
+        return Path::Empty();
+    }
+
+    const String guidStr = String::ToString(GetGUID()).Replace(" ", "_");
+    return Paths::GetProjectCacheDir()
+        .Append("ReflectionProbes")
+        .Append(guidStr)
+        .AppendExtension("bprobe");
+}
+
+bool ReflectionProbe::LoadBakeFromCache()
+{
+    const Path bakeCachePath = GetBakeCachePath();
+    if (!bakeCachePath.IsFile())
+    {
+        return false;
+    }
+
+    const Array<Byte> bytes = File::GetBytes(bakeCachePath);
+    std::size_t offset = 0;
+    BakeCacheHeader header;
+    if (!CacheFile::ReadValue(bytes, &offset, &header) ||
+        header != GetBakeCacheHeader())
+    {
+        // Baked with other settings
+        return false;
+    }
+
+    if (GetFilterForIBL())
+    {
+        CubeMapIBLGenerator::PrepareIBLCubeMap(
+            p_textureCubeMapDiffuse.Get(),
+            CubeMapIBLGenerator::IBLType::DIFFUSE,
+            DiffuseIBLSize);
+        CubeMapIBLGenerator::PrepareIBLCubeMap(
+            p_textureCubeMapSpecular.Get(),
+            CubeMapIBLGenerator::IBLType::SPECULAR,
+            SpecularIBLSize);
+    }
+
+    std::size_t expectedBytesSize = offset;
+    for (TextureCubeMap *cubeMap : GetBakedCubeMaps())
+    {
+        expectedBytesSize += GetCubeMapBytesSize(cubeMap);
+    }
+    if (bytes.Size() != expectedBytesSize)
+    {
+        return false;
+    }
+
+    for (TextureCubeMap *cubeMap : GetBakedCubeMaps())
+    {
+        for (uint mipMapLevel = 0; mipMapLevel < GetNumMipMaps(cubeMap);
+             ++mipMapLevel)
+        {
+            for (GL::CubeMapDir cubeMapDir : GL::GetAllCubeMapDirs())
+            {
+                cubeMap->FillMipMap(cubeMapDir,
+                                    bytes.Data() + offset,
+                                    mipMapLevel,
+                                    GL::ColorComp::RGBA,
+                                    GL::DataType::FLOAT);
+                offset += GetFaceBytesSize(cubeMap, mipMapLevel);
+            }
+        }
+    }
+    return true;
+}
+
+void ReflectionProbe::SaveBakeToCache() const
+{
+    const Path bakeCachePath = GetBakeCachePath();
+    if (bakeCachePath.IsEmpty() ||
+        !File::CreateDir(bakeCachePath.GetDirectory().GetDirectory()) ||
+        !File::CreateDir(bakeCachePath.GetDirectory()))
+    {
+        return;
+    }
+
+    Array<Byte> bytes;
+    CacheFile::WriteValue(&bytes, GetBakeCacheHeader());
+    for (TextureCubeMap *cubeMap : GetBakedCubeMaps())
+    {
+        for (uint mipMapLevel = 0; mipMapLevel < GetNumMipMaps(cubeMap);
+             ++mipMapLevel)
+        {
+            for (GL::CubeMapDir cubeMapDir : GL::GetAllCubeMapDirs())
+            {
+                const std::size_t offset = bytes.Size();
+                bytes.Resize(offset + GetFaceBytesSize(cubeMap, mipMapLevel));
+                cubeMap->ReadMipMap(cubeMapDir,
+                                    mipMapLevel,
+                                    GL::ColorComp::RGBA,
+                                    GL::DataType::FLOAT,
+                                    bytes.Data() + offset);
+            }
+        }
+    }
+    File::Write(bakeCachePath, bytes.Data(), bytes.Size());
+}
+
+ReflectionProbe::BakeCacheHeader ReflectionProbe::GetBakeCacheHeader() const
+{
+    BakeCacheHeader header;
+    header.magic = BakeCacheMagic;
+    header.version = BakeCacheVersion;
+    header.renderSize = GetRenderSize();
+    header.filterForIBL = GetFilterForIBL();
+    header.diffuseIBLSize = DiffuseIBLSize;
+    header.specularIBLSize = SpecularIBLSize;
+    header.sceneGeometryHash = GetSceneGeometryHash();
+    header.position = GetGameObject()->GetTransform()->GetPosition();
+    return header;
+}
+
+Hash::HashType ReflectionProbe::GetSceneGeometryHash() const
+{
+    // What the probe cameras see: every active renderer, with its placement,
+    // bounds, mesh and material
+    Hash::HashType hash = Hash::InitialSeed;
+    Scene *scene = GetGameObject()->GetScene();
+    if (!scene)
+    {
+        return hash;
+    }
+
+    auto hashGUID = [&hash](const Asset *asset) {
+        const GUID &guid = (asset ? asset->GetGUID() : GUID::Empty());
+        hash = Hash::ComputeValue(guid.GetTimeGUID(), hash);
+        hash = Hash::ComputeValue(guid.GetRandGUID(), hash);
+        hash = Hash::ComputeValue(guid.GetEmbeddedAssetGUID(), hash);
+    };
+
+    for (Renderer *rend : scene->GetComponentsInDescendantsAndThis<Renderer>())
+    {
+        if (!rend->IsActiveRecursively())
+        {
+            continue;
+        }
+
+        const Matrix4 &localToWorld =
+            rend->GetGameObject()->GetTransform()->GetLocalToWorldMatrix();
+        hash = Hash::ComputeValue(localToWorld, hash);
+        hash = Hash::ComputeValue(rend->GetAABBox(), hash);
+        if (MeshRenderer *mr = DCAST<MeshRenderer *>(rend))
+        {
+            hashGUID(mr->GetActiveMesh());
+        }
+        hashGUID(rend->GetActiveMaterial());
+    }
+    return hash;
+}
+
+Array<TextureCubeMap *> ReflectionProbe::GetBakedCubeMaps() const
+{
+    // Only the cube maps that are used to render are baked
+    if (GetFilterForIBL())
+    {
+        return {p_textureCubeMapDiffuse.Get(), p_textureCubeMapSpecular.Get()};
+    }
+    return {GetTextureCubeMapWithoutFiltering()};
+}
+
+uint ReflectionProbe::GetNumMipMaps(const TextureCubeMap *cubeMap) const
+{
+    return (cubeMap == p_textureCubeMapSpecular.Get())
+               ? CubeMapIBLGenerator::GetSpecularIBLNumMipMaps(SpecularIBLSize)
+               : 1;
+}
+
+std::size_t ReflectionProbe::GetCubeMapBytesSize(
+    const TextureCubeMap *cubeMap) const
+{
+    std::size_t bytesSize = 0;
+    for (uint mipMapLevel = 0; mipMapLevel < GetNumMipMaps(cubeMap);
+         ++mipMapLevel)
+    {
+        bytesSize += GetFaceBytesSize(cubeMap, mipMapLevel) *
+                     GL::GetAllCubeMapDirs().size();
+    }
+    return bytesSize;
+}
+
+std::size_t ReflectionProbe::GetFaceBytesSize(const TextureCubeMap *cubeMap,
+                                              uint mipMapLevel)
+{
+    const std::size_t mipSize = cubeMap->GetMipMapSize(mipMapLevel);
+    return (mipSize * mipSize * 4 * sizeof(float));
 }
 
 void ReflectionProbe::SetRenderSize(int size)
@@ -161,11 +544,8 @@ void ReflectionProbe::SetRenderSize(int size)
         ASSERT(Math::IsPowerOfTwo(size));
 #endif
 
-        for (Camera *cam : GetCameras())
-        {
-            cam->SetRenderSize(Vector2i(size));
-            GetTextureCubeMapWithoutFiltering()->Resize(size);
-        }
+        GetTextureCubeMapWithoutFiltering()->Resize(size);
+        m_isBaked = false;
     }
 }
 
@@ -259,6 +639,16 @@ void ReflectionProbe::SetFilterForIBL(bool filterForIBL)
     if (filterForIBL != GetFilterForIBL())
     {
         m_filterForIBL = filterForIBL;
+        m_isBaked = false;
+    }
+}
+
+void ReflectionProbe::SetIsStatic(bool isStatic)
+{
+    if (isStatic != GetIsStatic())
+    {
+        m_isStatic = isStatic;
+        m_isBaked = false;
     }
 }
 
@@ -272,6 +662,11 @@ bool ReflectionProbe::GetIsBoxed() const
     return m_isBoxed;
 }
 
+bool ReflectionProbe::GetIsStatic() const
+{
+    return m_isStatic;
+}
+
 const Time &ReflectionProbe::GetRestTime() const
 {
     return m_restTime;
@@ -393,6 +788,8 @@ void ReflectionProbe::Reflect()
 
     BANG_REFLECT_VAR_MEMBER(
         ReflectionProbe, "Is Boxed", SetIsBoxed, GetIsBoxed);
+    BANG_REFLECT_VAR_MEMBER(
+        ReflectionProbe, "Static", SetIsStatic, GetIsStatic);
     BANG_REFLECT_VAR_MEMBER(
         ReflectionProbe, "ZNear", SetCamerasZNear, GetCamerasZNear);
     BANG_REFLECT_VAR_MEMBER(
@@ -446,6 +843,7 @@ void ReflectionProbe::CloneInto(ICloneable *clone, bool cloneGUID) const
     rpClone->SetFilterForIBL(GetFilterForIBL());
     rpClone->SetRestTimeSeconds(GetRestTime().GetSeconds());
     rpClone->SetIsBoxed(GetIsBoxed());
+    rpClone->SetIsStatic(GetIsStatic());
     rpClone->SetCamerasZNear(GetCamerasZNear());
     rpClone->SetCamerasZFar(GetCamerasZFar());
     rpClone->SetCamerasClearMode(GetCamerasClearMode());
@@ -467,6 +865,11 @@ void ReflectionProbe::ImportMeta(const MetaNode &metaNode)
         SetIsBoxed(metaNode.Get<bool>("IsBoxed"));
     }
 
+    if (metaNode.Contains("IsStatic"))
+    {
+        SetIsStatic(metaNode.Get<bool>("IsStatic"));
+    }
+
     if (metaNode.Contains("RenderSize"))
     {
         SetRenderSize(metaNode.Get<int>("RenderSize"));
@@ -517,6 +920,7 @@ void ReflectionProbe::ExportMeta(MetaNode *metaNode) const
 
     metaNode->Set("Size", GetSize());
     metaNode->Set("IsBoxed", GetIsBoxed());
+    metaNode->Set("IsStatic", GetIsStatic());
     metaNode->Set("RenderSize", GetRenderSize());
     metaNode->Set("FilterForIBL", GetFilterForIBL());
     metaNode->Set("RestTimeSeconds", GetRestTime().GetSeconds());
@@ -8,6 +8,7 @@
 #include "Bang/BoxCollider.h"
 #include "Bang/Camera.h"
 #include "Bang/CapsuleCollider.h"
+#include "Bang/DirectionalLight.h"
 #include "Bang/GL.h"
 #include "Bang/GameObject.h"
 #include "Bang/GameObject.tcc"
@@ -29,6 +30,7 @@
 #include "Bang/UIComboBox.h"
 #include "Bang/UIDirLayout.h"
 #include "Bang/UIDirLayoutMovableSeparator.h"
+#include "Bang/UIGridLayout.h"
 #include "Bang/UIImageRenderer.h"
 #include "Bang/UIInputNumber.h"
 #include "Bang/UIInputText.h"
@@ -44,6 +46,7 @@
 #include "Bang/UITheme.h"
 #include "Bang/UIToolButton.h"
 #include "Bang/UITree.h"
+#include "Bang/UIVerticalLayout.h"
 
 using namespace Bang;
 
@@ -203,6 +206,92 @@ Scene *GameObjectFactory::CreateDefaultSceneInto(Scene *scene)
     return scene;
 }
 
+Scene *GameObjectFactory::CreateLODBenchmarkSceneInto(Scene *scene,
+                                                      int gridSize)
+{
+    ASSERT(scene->GetTransform());
+
+    GameObject *cameraGo = GameObjectFactory::CreateGameObjectNamed("Camera");
+    Camera *cam = GameObjectFactory::CreateDefaultCameraInto(cameraGo);
+    cam->SetZFar(Math::Max(cam->GetZFar(), gridSize * 8.0f));
+    cameraGo->GetTransform()->SetPosition(Vector3(0, 3, 0));
+    cameraGo->GetTransform()->LookAt(Vector3(0, 0, -gridSize * 4.0f));
+    cameraGo->SetParent(scene);
+    scene->SetCamera(cam);
+
+    GameObject *lightGo = GameObjectFactory::CreateGameObjectNamed("Light");
+    DirectionalLight *light = lightGo->AddComponent<DirectionalLight>();
+    light->SetCastShadows(true);
+    lightGo->GetTransform()->SetPosition(Vector3(10, 10, 10));
+    lightGo->GetTransform()->LookAt(Vector3::Zero());
+    lightGo->SetParent(scene);
+
+    // Each row gets further from the camera, so that each of them ends up
+    // selecting a coarser LOD
+    AH<Mesh> sphereMesh = MeshFactory::GetSphere();
+    for (int z = 0; z < gridSize; ++z)
+    {
+        for (int x = 0; x < gridSize; ++x)
+        {
+            GameObject *sphereGo = GameObjectFactory::CreateGameObjectWithMesh(
+                sphereMesh.Get(), "Sphere_" + String(x) + "_" + String(z));
+            MeshRenderer *mr = sphereGo->GetComponent<MeshRenderer>();
+            mr->SetAutoLOD(true);
+            sphereGo->GetTransform()->SetPosition(
+                Vector3((x - gridSize * 0.5f) * 3.0f, 0, -z * 4.0f - 2.0f));
+            sphereGo->SetParent(scene);
+        }
+    }
+
+    return scene;
+}
+
+UILabel *GameObjectFactory::CreateUILayoutBenchmarkInto(
+    GameObject *container,
+    int numSections,
+    int numGridsPerSection,
+    int numLabelsPerGrid)
+{
+    UIVerticalLayout *rootVL = container->AddComponent<UIVerticalLayout>();
+    rootVL->SetSpacing(4);
+
+    UILabel *benchmarkLabel = nullptr;
+    for (int s = 0; s < numSections; ++s)
+    {
+        GameObject *sectionGo = GameObjectFactory::CreateUIGameObjectNamed(
+            "Section_" + String(s));
+        sectionGo->AddComponent<UIVerticalLayout>()->SetSpacing(2);
+        sectionGo->SetParent(container);
+
+        for (int g = 0; g < numGridsPerSection; ++g)
+        {
+            GameObject *gridGo = GameObjectFactory::CreateUIGameObjectNamed(
+                "Grid_" + String(g));
+            UIGridLayout *gridLayout = gridGo->AddComponent<UIGridLayout>();
+            gridLayout->SetCellSize(Vector2i(40, 16));
+            gridLayout->SetSpacing(1);
+            gridGo->SetParent(sectionGo);
+
+            for (int l = 0; l < numLabelsPerGrid; ++l)
+            {
+                UILabel *label = GameObjectFactory::CreateUILabel();
+                label->GetText()->SetContent(String(l));
+                label->GetText()->SetTextSize(10);
+                label->GetGameObject()->SetParent(gridGo);
+
+                // One in the middle of the tree
+                if (s == numSections / 2 && g == numGridsPerSection / 2 &&
+                    l == numLabelsPerGrid / 2)
+                {
+                    benchmarkLabel = label;
+                }
+            }
+        }
+    }
+
+    return benchmarkLabel;
+}
+
 Camera *GameObjectFactory::CreateDefaultCameraInto(GameObject *go)
 {
     Camera *cam = go->AddComponent<Camera>();
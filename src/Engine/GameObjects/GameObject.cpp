@@ -31,6 +31,8 @@
 #include "Bang/Sphere.h"
 #include "Bang/StreamOperators.h"
 #include "Bang/Transform.h"
+#include "Bang/UIFocusIndex.h"
+#include "Bang/UILayoutManager.h"
 #include "Bang/USet.h"
 #include "Bang/USet.tcc"
 
@@ -183,6 +185,8 @@ void GameObject::AddChild_(GameObject *child,
 
     int index = (index_ != -1 ? index_ : GetChildren().Size());
     ASSERT(index >= 0 && index <= GetChildren().Size());
+    UIFocusIndex::Invalidate(child);  // Its previous canvases
+    UIFocusIndex::Invalidate(this);
     if (child->GetParent() != this)  // Parent change
     {
         Matrix4 prevWorldTransform = Matrix4::Identity();
@@ -213,6 +217,7 @@ void GameObject::AddChild_(GameObject *child,
                          child->GetComponents<EventListener<IEventsChildren>>(),
                          oldParent,
                          this);
+        UILayoutManager::ClaimInvalidations(child);
     }
     else  // Its a movement
     {
@@ -239,6 +244,7 @@ void GameObject::RemoveChild(GameObject *child)
     {
         m_children[i] = nullptr;
         TryToClearDeletedChildren();
+        UIFocusIndex::Invalidate(this);
         ChildRemoved(child, this);
     }
 }
@@ -278,6 +284,8 @@ Component *GameObject::AddComponent_(Component *component, int index_)
         }
 
         component->SetGameObject(this);
+        UIFocusIndex::Invalidate(this);
+        UILayoutManager::ClaimInvalidations(component);
 
         EventEmitter<IEventsComponent>::PropagateToListeners(
             &IEventsComponent::OnComponentAdded, component, index);
@@ -330,6 +338,7 @@ void GameObject::RemoveComponent(Component *component)
     if (i >= 0)
     {
         m_components[i] = nullptr;
+        UIFocusIndex::Invalidate(this);
 
         EventEmitter<IEventsComponent>::PropagateToListeners(
             &IEventsComponent::OnComponentRemoved, component, this);
@@ -349,6 +358,10 @@ void GameObject::RemoveComponent(Component *component)
 void GameObject::OnEnabled(Object *object)
 {
     Object::OnEnabled(object);
+    if (object == this)
+    {
+        UIFocusIndex::Invalidate(this);
+    }
     PropagateToArray(&EventListener<IEventsObject>::OnEnabled,
                      GetComponents<EventListener<IEventsObject>>(),
                      object);
@@ -357,6 +370,10 @@ void GameObject::OnEnabled(Object *object)
 void GameObject::OnDisabled(Object *object)
 {
     Object::OnDisabled(object);
+    if (object == this)
+    {
+        UIFocusIndex::Invalidate(this);
+    }
     PropagateToArray(&EventListener<IEventsObject>::OnDisabled,
                      GetComponents<EventListener<IEventsObject>>(),
                      object);
@@ -736,6 +753,7 @@ void GameObject::SetVisible(bool visible)
     {
         m_visible = visible;
         InvalidateVisibleRecursively();
+        UIFocusIndex::Invalidate(this);
 
         EventEmitter<IEventsGameObjectVisibilityChanged>::PropagateToListeners(
             &IEventsGameObjectVisibilityChanged::OnVisibilityChanged, this);
@@ -1055,6 +1073,8 @@ void GameObject::CloneInto(ICloneable *clone, bool cloneGUID) const
 
     GameObject *go = SCAST<GameObject *>(clone);
     go->SetName(m_name);
+    go->SetVisible(IsVisible());
+    go->SetDontDestroyOnLoad(IsDontDestroyOnLoad());
     go->SetParent(nullptr);
 
     for (GameObject *child : GetChildren())
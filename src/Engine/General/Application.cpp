@@ -9,6 +9,7 @@
 #include "Bang/ClassDB.h"
 #include "Bang/Debug.h"
 #include "Bang/GEngine.h"
+#include "Bang/JobSystem.h"
 #include "Bang/MetaFilesManager.h"
 #include "Bang/Paths.h"
 #include "Bang/Physics.h"
@@ -48,6 +49,9 @@ void Application::Init_(const Path &engineRootPath)
 
     m_time = new TimeSingleton();
 
+    m_jobSystem = new JobSystem();
+    m_jobSystem->Init();
+
     m_systemUtils = new SystemUtils();
     m_debug = CreateDebug();
 
@@ -55,6 +59,12 @@ void Application::Init_(const Path &engineRootPath)
     m_paths->InitPaths(engineRootPath);
 }
 
+void Application::InitHeadless_(const Path &engineRootPath)
+{
+    Init_(engineRootPath);
+    m_metaFilesManager = new MetaFilesManager();
+}
+
 void Application::InitAfterPathsInit_()
 {
     m_settings = CreateSettings();
@@ -90,6 +100,10 @@ void Application::InitAfterPathsInit_()
 
 Application::~Application()
 {
+    // Let the pending jobs finish while every subsystem is still alive
+    delete m_jobSystem;
+    m_jobSystem = nullptr;
+
     delete m_classDB;
     delete m_time;
     delete m_debug;
@@ -100,12 +114,16 @@ Application::~Application()
     delete m_physics;
     m_physics = nullptr;
 
-    m_assets->Destroy();
-    delete m_assets;
-    m_assets = nullptr;
+    if (m_assets)
+    {
+        m_assets->Destroy();
+        delete m_assets;
+        m_assets = nullptr;
+    }
 
     delete m_settings;
     delete m_audioManager;
+    m_audioManager = nullptr;
     delete m_windowManager;
     delete m_metaFilesManager;
 
@@ -158,6 +176,8 @@ int Application::MainLoop()
 
 bool Application::MainLoopIteration()
 {
+    GetAssets()->UpdateAsyncLoads();
+    GetAudioManager()->Update();
     bool exit = GetWindowManager()->MainLoopIteration();
     return exit;
 }
@@ -194,6 +214,11 @@ GEngine *Application::GetGEngine() const
     return m_gEngine;
 }
 
+JobSystem *Application::GetJobSystem() const
+{
+    return m_jobSystem;
+}
+
 Physics *Application::GetPhysics() const
 {
     return m_physics;
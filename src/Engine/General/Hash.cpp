@@ -0,0 +1,47 @@
+#include "Bang/Hash.h"
+
+#include <cstdio>
+
+#include "Bang/File.h"
+#include "Bang/Path.h"
+
+using namespace Bang;
+
+constexpr Hash::HashType Hash::InitialSeed;
+
+Hash::HashType Hash::Compute(const void *data,
+                             std::size_t dataSize,
+                             HashType seed)
+{
+    constexpr HashType FNVPrime = 1099511628211ULL;
+
+    HashType hash = seed;
+    const Byte *bytes = SCAST<const Byte *>(data);
+    for (std::size_t i = 0; i < dataSize; ++i)
+    {
+        hash ^= SCAST<HashType>(bytes[i]);
+        hash *= FNVPrime;
+    }
+    return hash;
+}
+
+Hash::HashType Hash::Compute(const String &str, HashType seed)
+{
+    return Hash::Compute(str.ToCString(), str.Size(), seed);
+}
+
+Hash::HashType Hash::ComputeFile(const Path &filepath, HashType seed)
+{
+    return Hash::Compute(File::GetBytes(filepath), seed);
+}
+
+String Hash::ToHexString(HashType hash)
+{
+    char hexStr[17];
+    std::snprintf(hexStr,
+                  sizeof(hexStr),
+                  "%08x%08x",
+                  SCAST<uint>(hash >> 32),
+                  SCAST<uint>(hash & 0xFFFFFFFF));
+    return String(hexStr);
+}
@@ -100,6 +100,12 @@ void Project::ImportMeta(const MetaNode &metaNode)
         SetInitialSceneGUID(initialSceneGUID);
     }
 
+    if (metaNode.Contains("MetaFormat"))
+    {
+        MetaFilesManager::SetMetaFormat(
+            SCAST<MetaFormat>(metaNode.Get<int>("MetaFormat")));
+    }
+
     if (metaNode.Contains("Physics_StepSleepTime"))
     {
         Physics::GetInstance()->SetStepSleepTime(
@@ -124,6 +130,7 @@ void Project::ExportMeta(MetaNode *metaNode) const
     metaNode->SetName("Project");
 
     metaNode->Set("InitialSceneGUID", GetInitialScenePathGUID());
+    metaNode->Set("MetaFormat", SCAST<int>(MetaFilesManager::GetMetaFormat()));
 
     metaNode->Set("Physics_StepSleepTime",
                   Physics::GetInstance()->GetStepSleepTime().GetSeconds());
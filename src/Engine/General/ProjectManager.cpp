@@ -10,6 +10,7 @@
 #include "Bang/Path.h"
 #include "Bang/Paths.h"
 #include "Bang/Project.h"
+#include "Bang/ShaderProgramFactory.h"
 #include "Bang/StreamOperators.h"
 #include "Bang/String.h"
 
@@ -40,6 +41,10 @@ Project *ProjectManager::OpenProject(const Path &projectFilepath)
 
         currentProject->Init();
         currentProject->ImportMetaFromFile(projectFilepath);
+        if (GetWarmUpShaderBinaryCacheOnOpen())
+        {
+            ShaderProgramFactory::WarmUpBinaryCache();
+        }
         currentProject->OpenInitialScene();
 
         EventEmitter<IEventsProjectManager>::PropagateToListeners(
@@ -48,6 +53,16 @@ Project *ProjectManager::OpenProject(const Path &projectFilepath)
     return GetCurrentProject();
 }
 
+void ProjectManager::SetWarmUpShaderBinaryCacheOnOpen(bool warmUp)
+{
+    m_warmUpShaderBinaryCacheOnOpen = warmUp;
+}
+
+bool ProjectManager::GetWarmUpShaderBinaryCacheOnOpen() const
+{
+    return m_warmUpShaderBinaryCacheOnOpen;
+}
+
 Project *ProjectManager::GetCurrentProject() const
 {
     return m_currentProject;
@@ -260,6 +260,24 @@ Texture2D *GBuffer::GetReadColorTexture() const
     return p_readColorTexture;
 }
 
+uint GBuffer::GetBytesSize() const
+{
+    uint bytesSize = 0;
+    for (Texture2D *tex : {GetColorTexture0(),
+                           GetColorTexture1(),
+                           GetSceneDepthStencilTexture(),
+                           GetCanvasDepthStencilTexture(),
+                           GetOverlayDepthStencilTexture(),
+                           GetAttachmentTex2D(GBuffer::AttAlbedo),
+                           GetAttachmentTex2D(GBuffer::AttLight),
+                           GetAttachmentTex2D(GBuffer::AttNormal),
+                           GetAttachmentTex2D(GBuffer::AttMisc)})
+    {
+        bytesSize += (tex ? tex->GetBytesSize() : 0);
+    }
+    return bytesSize;
+}
+
 String GBuffer::GetMiscTexName()
 {
     return "B_GTex_Misc";
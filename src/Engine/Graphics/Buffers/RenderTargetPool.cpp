@@ -0,0 +1,284 @@
+#include "Bang/RenderTargetPool.h"
+
+#include <sstream>
+
+#include "Bang/Array.tcc"
+#include "Bang/Assert.h"
+#include "Bang/Assets.h"
+#include "Bang/Assets.tcc"
+#include "Bang/Debug.h"
+#include "Bang/GBuffer.h"
+#include "Bang/GEngine.h"
+#include "Bang/Map.h"
+#include "Bang/Map.tcc"
+#include "Bang/Texture2D.h"
+#include "Bang/UMap.tcc"
+
+using namespace Bang;
+
+RenderTargetDesc::RenderTargetDesc(const Vector2i &size_,
+                                   GL::ColorFormat format_,
+                                   GL::FilterMode filterMode_,
+                                   GL::WrapMode wrapMode_)
+    : size(size_), format(format_), filterMode(filterMode_), wrapMode(wrapMode_)
+{
+}
+
+RenderTargetPool::RenderTargetPool()
+{
+}
+
+RenderTargetPool::~RenderTargetPool()
+{
+    Clear();
+}
+
+Texture2D *RenderTargetPool::Acquire(const RenderTargetDesc &desc,
+                                     const String &owner)
+{
+    const Vector2i size = Vector2i::Max(desc.size, Vector2i::One());
+
+    PooledTexture *pooledTex = nullptr;
+    for (PooledTexture &pt : m_pooledTextures)
+    {
+        if (!pt.inUse && pt.desc.format == desc.format &&
+            pt.texture.Get()->GetSize() == size)
+        {
+            pooledTex = &pt;
+            break;
+        }
+    }
+
+    if (!pooledTex)
+    {
+        PooledTexture newPooledTex;
+        newPooledTex.texture = Assets::Create<Texture2D>();
+        newPooledTex.texture.Get()->SetFormat(desc.format);
+        newPooledTex.texture.Get()->CreateEmpty(size);
+        m_pooledTextures.PushBack(newPooledTex);
+        pooledTex = &m_pooledTextures.Back();
+    }
+
+    Texture2D *tex = pooledTex->texture.Get();
+    tex->SetFilterMode(desc.filterMode);
+    tex->SetWrapMode(desc.wrapMode);
+
+    pooledTex->desc = desc;
+    pooledTex->desc.size = size;
+    pooledTex->owner = owner;
+    pooledTex->inUse = true;
+    pooledTex->lastUsedFrame = m_frame;
+    return tex;
+}
+
+void RenderTargetPool::Release(Texture2D *renderTarget)
+{
+    for (PooledTexture &pt : m_pooledTextures)
+    {
+        if (pt.texture.Get() == renderTarget)
+        {
+            ASSERT(pt.inUse);
+            pt.inUse = false;
+            pt.lastUsedFrame = m_frame;
+            return;
+        }
+    }
+    ASSERT_MSG(false, "Releasing a texture that does not belong to the pool");
+}
+
+GBuffer *RenderTargetPool::AcquireGBuffer(const Vector2i &size,
+                                          const String &owner)
+{
+    const Vector2i gbSize = Vector2i::Max(size, Vector2i::One());
+
+    PooledGBuffer *pooledGB = nullptr;
+    for (PooledGBuffer &pgb : m_pooledGBuffers)
+    {
+        if (!pgb.inUse && pgb.gbuffer->GetSize() == gbSize)
+        {
+            pooledGB = &pgb;
+            break;
+        }
+    }
+
+    if (!pooledGB)
+    {
+        PooledGBuffer newPooledGB;
+        newPooledGB.gbuffer = new GBuffer(gbSize.x, gbSize.y);
+        m_pooledGBuffers.PushBack(newPooledGB);
+        pooledGB = &m_pooledGBuffers.Back();
+    }
+
+    pooledGB->owner = owner;
+    pooledGB->inUse = true;
+    pooledGB->lastUsedFrame = m_frame;
+    return pooledGB->gbuffer;
+}
+
+void RenderTargetPool::ReleaseGBuffer(GBuffer *gbuffer)
+{
+    for (PooledGBuffer &pgb : m_pooledGBuffers)
+    {
+        if (pgb.gbuffer == gbuffer)
+        {
+            ASSERT(pgb.inUse);
+            pgb.inUse = false;
+            pgb.lastUsedFrame = m_frame;
+            return;
+        }
+    }
+    ASSERT_MSG(false, "Releasing a GBuffer that does not belong to the pool");
+}
+
+void RenderTargetPool::RegisterPersistentGBuffer(const GBuffer *gbuffer,
+                                                 const String &owner)
+{
+    m_persistentGBuffers.Add(gbuffer, owner);
+}
+
+void RenderTargetPool::UnRegisterPersistentGBuffer(const GBuffer *gbuffer)
+{
+    m_persistentGBuffers.Remove(gbuffer);
+}
+
+void RenderTargetPool::EndFrame()
+{
+    ++m_frame;
+
+    for (auto it = m_pooledTextures.Begin(); it != m_pooledTextures.End();)
+    {
+        const PooledTexture &pt = *it;
+        if (!pt.inUse && (m_frame - pt.lastUsedFrame) > GetMaxIdleFrames())
+        {
+            it = m_pooledTextures.Remove(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (auto it = m_pooledGBuffers.Begin(); it != m_pooledGBuffers.End();)
+    {
+        const PooledGBuffer &pgb = *it;
+        if (!pgb.inUse && (m_frame - pgb.lastUsedFrame) > GetMaxIdleFrames())
+        {
+            delete pgb.gbuffer;
+            it = m_pooledGBuffers.Remove(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    if (GetLogMemoryReport())
+    {
+        const uint64_t totalBytes = GetTotalBytes();
+        if (totalBytes != m_lastLoggedTotalBytes)
+        {
+            m_lastLoggedTotalBytes = totalBytes;
+            Debug_Log("Render targets memory:\n" << GetMemoryReportString());
+        }
+    }
+}
+
+void RenderTargetPool::Clear()
+{
+    m_pooledTextures.Clear();
+    for (PooledGBuffer &pgb : m_pooledGBuffers)
+    {
+        delete pgb.gbuffer;
+    }
+    m_pooledGBuffers.Clear();
+}
+
+void RenderTargetPool::SetMaxIdleFrames(uint maxIdleFrames)
+{
+    m_maxIdleFrames = maxIdleFrames;
+}
+
+void RenderTargetPool::SetLogMemoryReport(bool logMemoryReport)
+{
+    if (logMemoryReport != GetLogMemoryReport())
+    {
+        m_logMemoryReport = logMemoryReport;
+        m_lastLoggedTotalBytes = 0;
+    }
+}
+
+uint RenderTargetPool::GetMaxIdleFrames() const
+{
+    return m_maxIdleFrames;
+}
+
+bool RenderTargetPool::GetLogMemoryReport() const
+{
+    return m_logMemoryReport;
+}
+
+Array<RenderTargetMemoryEntry> RenderTargetPool::GetMemoryReport() const
+{
+    const String freeOwner = "Pool (free)";
+    Map<String, RenderTargetMemoryEntry> entries;
+    auto addToEntry = [&entries](const String &owner, uint64_t bytes) {
+        RenderTargetMemoryEntry &entry = entries[owner];
+        entry.owner = owner;
+        entry.numTargets += 1;
+        entry.bytes += bytes;
+    };
+
+    for (const PooledTexture &pt : m_pooledTextures)
+    {
+        addToEntry(pt.inUse ? pt.owner : freeOwner,
+                   pt.texture.Get()->GetBytesSize());
+    }
+
+    for (const PooledGBuffer &pgb : m_pooledGBuffers)
+    {
+        addToEntry(pgb.inUse ? pgb.owner : freeOwner,
+                   pgb.gbuffer->GetBytesSize());
+    }
+
+    for (const auto &pair : m_persistentGBuffers)
+    {
+        addToEntry(pair.second, pair.first->GetBytesSize());
+    }
+
+    Array<RenderTargetMemoryEntry> report;
+    for (const auto &pair : entries)
+    {
+        report.PushBack(pair.second);
+    }
+    return report;
+}
+
+uint64_t RenderTargetPool::GetTotalBytes() const
+{
+    uint64_t totalBytes = 0;
+    for (const RenderTargetMemoryEntry &entry : GetMemoryReport())
+    {
+        totalBytes += entry.bytes;
+    }
+    return totalBytes;
+}
+
+String RenderTargetPool::GetMemoryReportString() const
+{
+    constexpr double MB = (1024.0 * 1024.0);
+
+    std::ostringstream oss;
+    for (const RenderTargetMemoryEntry &entry : GetMemoryReport())
+    {
+        oss << entry.owner << ": " << entry.numTargets << " targets, "
+            << (entry.bytes / MB) << " MB" << std::endl;
+    }
+    oss << "Total: " << (GetTotalBytes() / MB) << " MB";
+    return String(oss.str());
+}
+
+RenderTargetPool *RenderTargetPool::GetInstance()
+{
+    GEngine *ge = GEngine::GetInstance();
+    return ge ? ge->GetRenderTargetPool() : nullptr;
+}
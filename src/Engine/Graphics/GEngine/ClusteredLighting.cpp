@@ -0,0 +1,367 @@
+#include "Bang/ClusteredLighting.h"
+
+#include "Bang/Array.tcc"
+#include "Bang/Assets.h"
+#include "Bang/Assets.tcc"
+#include "Bang/Camera.h"
+#include "Bang/GBuffer.h"
+#include "Bang/GEngine.h"
+#include "Bang/GL.h"
+#include "Bang/GameObject.h"
+#include "Bang/JobSystem.h"
+#include "Bang/Math.h"
+#include "Bang/Matrix4.tcc"
+#include "Bang/PointLight.h"
+#include "Bang/ShaderProgram.h"
+#include "Bang/ShaderProgramFactory.h"
+#include "Bang/Texture2D.h"
+#include "Bang/Transform.h"
+
+using namespace Bang;
+
+constexpr uint ClusteredLighting::NumTilesX;
+constexpr uint ClusteredLighting::NumTilesY;
+constexpr uint ClusteredLighting::NumSlices;
+constexpr uint ClusteredLighting::TexRowWidth;
+constexpr uint ClusteredLighting::NumClusters;
+
+ClusteredLighting::ClusteredLighting()
+{
+}
+
+ClusteredLighting::~ClusteredLighting()
+{
+}
+
+void ClusteredLighting::Init()
+{
+    m_slicesLightIndices.Resize(NumSlices);
+    m_slicesClusterOffsets.Resize(NumClusters * 2, 0);
+    m_gridData.Resize(NumClusters, Vector4::Zero());
+
+    for (AH<Texture2D> *tex : {&m_lightDataTex, &m_gridTex, &m_lightIndicesTex})
+    {
+        *tex = Assets::Create<Texture2D>();
+        tex->Get()->SetFormat(GL::ColorFormat::RGBA32F);
+        tex->Get()->SetFilterMode(GL::FilterMode::NEAREST);
+        tex->Get()->SetWrapMode(GL::WrapMode::CLAMP_TO_EDGE);
+    }
+
+    p_clusteredLightsSP.Set(
+        ShaderProgramFactory::GetClusteredLightsDeferredScreenPass());
+}
+
+void ClusteredLighting::Build(Camera *camera, const Array<Light *> &lights)
+{
+    m_clusterLights.Clear();
+    m_numDeferredLights = 0;
+
+    const float zNear = Math::Max(camera->GetZNear(), 0.001f);
+    const float zFar = Math::Max(camera->GetZFar(), zNear * 1.01f);
+    const float logDepthRange = Math::Log(zFar / zNear);
+    m_depthSliceScale = (NumSlices / logDepthRange);
+    m_depthSliceBias = -(NumSlices * Math::Log(zNear) / logDepthRange);
+
+    for (Light *light : lights)
+    {
+        PointLight *pointLight = DCAST<PointLight *>(light);
+        if (!pointLight || !pointLight->IsEnabledRecursively() ||
+            pointLight->GetRange() <= 0.0f)
+        {
+            continue;
+        }
+
+        // Shadow casters are flagged with a negative w, so that the deferred
+        // pass skips them (forward rendering does not use shadows)
+        const bool castsShadows = !IsResolvedClustered(pointLight);
+        const Color &color = pointLight->GetColor();
+        Transform *tr = pointLight->GetGameObject()->GetTransform();
+
+        ClusterLight clusterLight;
+        clusterLight.positionRange =
+            Vector4(tr->GetPosition(), pointLight->GetRange());
+        clusterLight.colorIntensity =
+            Vector4(color.r,
+                    color.g,
+                    color.b,
+                    pointLight->GetIntensity() * (castsShadows ? -1 : 1));
+        clusterLight.visible = false;
+        m_clusterLights.PushBack(clusterLight);
+
+        if (!castsShadows)
+        {
+            ++m_numDeferredLights;
+        }
+    }
+
+    const Matrix4 viewMatrix = camera->GetViewMatrix();
+    const Matrix4 projMatrix = camera->GetProjectionMatrix();
+    JobSystem *jobSystem = JobSystem::GetInstance();
+    auto computeRanges = [&](uint beginLight, uint endLight) {
+        for (uint i = beginLight; i < endLight; ++i)
+        {
+            ComputeLightClusterRange(
+                &m_clusterLights[i], viewMatrix, projMatrix, zNear, zFar);
+        }
+    };
+    auto binSlices = [this](uint beginSlice, uint endSlice) {
+        BinSlices(beginSlice, endSlice);
+    };
+
+    if (jobSystem)
+    {
+        jobSystem->ParallelFor(0, m_clusterLights.Size(), 64, computeRanges);
+        jobSystem->ParallelFor(0, NumSlices, 1, binSlices);
+    }
+    else
+    {
+        computeRanges(0, m_clusterLights.Size());
+        binSlices(0, NumSlices);
+    }
+
+    Upload();
+}
+
+void ClusteredLighting::ApplyClusteredLights(Camera *camera,
+                                             const AARect &renderRect)
+{
+    ShaderProgram *sp = p_clusteredLightsSP.Get();
+    if (!sp || m_numDeferredLights == 0)
+    {
+        return;
+    }
+
+    GL::Push(GL::Pushable::FRAMEBUFFER_AND_READ_DRAW_ATTACHMENTS);
+    GL::Push(GL::BindTarget::SHADER_PROGRAM);
+    GL::Push(GL::Pushable::BLEND_STATES);
+
+    sp->Bind();
+    SetUniforms(sp);
+
+    // Additive blend, same as the per-light passes
+    GL::Enable(GL::Enablable::BLEND);
+    GL::BlendFunc(GL::BlendFactor::ONE, GL::BlendFactor::ONE);
+
+    GBuffer *gbuffer = camera->GetGBuffer();
+    gbuffer->SetLightDrawBuffer();
+    gbuffer->BindAttachmentsForReading(sp);
+    GEngine::GetInstance()->RenderViewportRect(sp, renderRect);
+
+    GL::Pop(GL::Pushable::BLEND_STATES);
+    GL::Pop(GL::BindTarget::SHADER_PROGRAM);
+    GL::Pop(GL::Pushable::FRAMEBUFFER_AND_READ_DRAW_ATTACHMENTS);
+}
+
+void ClusteredLighting::SetUniforms(ShaderProgram *sp) const
+{
+    ASSERT(GL::IsBound(sp));
+    sp->SetTexture2D("B_ClusterLightData", m_lightDataTex.Get(), false);
+    sp->SetTexture2D("B_ClusterGrid", m_gridTex.Get(), false);
+    sp->SetTexture2D("B_ClusterLightIndices", m_lightIndicesTex.Get(), false);
+    sp->SetInt("B_ClusterNumTilesX", NumTilesX, false);
+    sp->SetInt("B_ClusterNumTilesY", NumTilesY, false);
+    sp->SetInt("B_ClusterNumSlices", NumSlices, false);
+    sp->SetInt("B_ClusterTexRowWidth", TexRowWidth, false);
+    sp->SetVector2("B_ClusterDepthSliceParams",
+                   Vector2(m_depthSliceScale, m_depthSliceBias),
+                   false);
+    sp->SetInt("B_ClusterNumLights", m_clusterLights.Size(), false);
+}
+
+bool ClusteredLighting::IsResolvedClustered(const Light *light)
+{
+    return DCAST<const PointLight *>(light) && !light->GetCastShadows();
+}
+
+uint ClusteredLighting::GetNumClusteredLights() const
+{
+    return m_clusterLights.Size();
+}
+
+uint ClusteredLighting::GetNumLightIndices() const
+{
+    return m_numLightIndices;
+}
+
+void ClusteredLighting::ComputeLightClusterRange(ClusterLight *clusterLight,
+                                                 const Matrix4 &viewMatrix,
+                                                 const Matrix4 &projMatrix,
+                                                 float zNear,
+                                                 float zFar) const
+{
+    const float range = clusterLight->positionRange.w;
+    const Vector4 centerView =
+        viewMatrix * Vector4(clusterLight->positionRange.xyz(), 1.0f);
+
+    // Camera looks towards -z
+    const float centerDepth = -centerView.z;
+    const float minDepth = Math::Max(centerDepth - range, zNear);
+    const float maxDepth = Math::Min(centerDepth + range, zFar);
+    if (minDepth > maxDepth)
+    {
+        clusterLight->visible = false;
+        return;
+    }
+
+    // Project the corners of the view space box around the sphere, clamped
+    // to the visible depths. The extremes of x/depth and y/depth are always
+    // at the corners, so this bounds the sphere conservatively
+    Vector2 minNDC = Vector2::Infinity();
+    Vector2 maxNDC = Vector2::NInfinity();
+    for (uint i = 0; i < 8; ++i)
+    {
+        const float x = centerView.x + ((i & 1) ? range : -range);
+        const float y = centerView.y + ((i & 2) ? range : -range);
+        const float depth = ((i & 4) ? maxDepth : minDepth);
+        Vector4 cornerClip = projMatrix * Vector4(x, y, -depth, 1.0f);
+        Vector2 cornerNDC = cornerClip.xy() / Math::Max(cornerClip.w, 0.0001f);
+        minNDC = Vector2::Min(minNDC, cornerNDC);
+        maxNDC = Vector2::Max(maxNDC, cornerNDC);
+    }
+
+    if (maxNDC.x < -1.0f || maxNDC.y < -1.0f || minNDC.x > 1.0f ||
+        minNDC.y > 1.0f)
+    {
+        clusterLight->visible = false;
+        return;
+    }
+
+    auto ndcToTile = [](float ndc, uint numTiles) {
+        float uv = Math::Clamp(ndc * 0.5f + 0.5f, 0.0f, 1.0f);
+        return Math::Min(SCAST<uint>(uv * numTiles), numTiles - 1);
+    };
+    clusterLight->minTileX = ndcToTile(minNDC.x, NumTilesX);
+    clusterLight->maxTileX = ndcToTile(maxNDC.x, NumTilesX);
+    clusterLight->minTileY = ndcToTile(minNDC.y, NumTilesY);
+    clusterLight->maxTileY = ndcToTile(maxNDC.y, NumTilesY);
+    clusterLight->minSlice = GetSlice(minDepth);
+    clusterLight->maxSlice = GetSlice(maxDepth);
+    clusterLight->visible = true;
+}
+
+void ClusteredLighting::BinSlices(uint beginSlice, uint endSlice)
+{
+    constexpr uint NumTilesPerSlice = (NumTilesX * NumTilesY);
+    for (uint slice = beginSlice; slice < endSlice; ++slice)
+    {
+        // Counting sort of the (tile, light) pairs of this slice by tile
+        uint *clusterOffsets =
+            &m_slicesClusterOffsets[slice * NumTilesPerSlice * 2];
+        for (uint i = 0; i < NumTilesPerSlice * 2; ++i)
+        {
+            clusterOffsets[i] = 0;
+        }
+
+        for (const ClusterLight &cl : m_clusterLights)
+        {
+            if (cl.visible && slice >= cl.minSlice && slice <= cl.maxSlice)
+            {
+                for (uint ty = cl.minTileY; ty <= cl.maxTileY; ++ty)
+                {
+                    for (uint tx = cl.minTileX; tx <= cl.maxTileX; ++tx)
+                    {
+                        ++clusterOffsets[(ty * NumTilesX + tx) * 2 + 1];
+                    }
+                }
+            }
+        }
+
+        uint numSliceIndices = 0;
+        for (uint tile = 0; tile < NumTilesPerSlice; ++tile)
+        {
+            clusterOffsets[tile * 2 + 0] = numSliceIndices;
+            numSliceIndices += clusterOffsets[tile * 2 + 1];
+        }
+
+        Array<uint> &sliceLightIndices = m_slicesLightIndices[slice];
+        sliceLightIndices.Resize(numSliceIndices);
+
+        Array<uint> tileFill(NumTilesPerSlice, 0);
+        for (uint i = 0; i < m_clusterLights.Size(); ++i)
+        {
+            const ClusterLight &cl = m_clusterLights[i];
+            if (cl.visible && slice >= cl.minSlice && slice <= cl.maxSlice)
+            {
+                for (uint ty = cl.minTileY; ty <= cl.maxTileY; ++ty)
+                {
+                    for (uint tx = cl.minTileX; tx <= cl.maxTileX; ++tx)
+                    {
+                        const uint tile = (ty * NumTilesX + tx);
+                        const uint idx =
+                            clusterOffsets[tile * 2] + (tileFill[tile]++);
+                        sliceLightIndices[idx] = i;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ClusteredLighting::Upload()
+{
+    constexpr uint NumTilesPerSlice = (NumTilesX * NumTilesY);
+
+    m_lightData.Resize(m_clusterLights.Size() * 2);
+    for (uint i = 0; i < m_clusterLights.Size(); ++i)
+    {
+        m_lightData[i * 2 + 0] = m_clusterLights[i].positionRange;
+        m_lightData[i * 2 + 1] = m_clusterLights[i].colorIntensity;
+    }
+
+    // Flatten the slices lists, packing 4 indices per texel
+    m_numLightIndices = 0;
+    for (uint slice = 0; slice < NumSlices; ++slice)
+    {
+        m_numLightIndices += m_slicesLightIndices[slice].Size();
+    }
+    m_indexData.Resize((m_numLightIndices + 3) / 4);
+
+    uint sliceBaseOffset = 0;
+    for (uint slice = 0; slice < NumSlices; ++slice)
+    {
+        const uint *clusterOffsets =
+            &m_slicesClusterOffsets[slice * NumTilesPerSlice * 2];
+        for (uint tile = 0; tile < NumTilesPerSlice; ++tile)
+        {
+            m_gridData[slice * NumTilesPerSlice + tile] =
+                Vector4(sliceBaseOffset + clusterOffsets[tile * 2 + 0],
+                        clusterOffsets[tile * 2 + 1],
+                        0.0f,
+                        0.0f);
+        }
+
+        const Array<uint> &sliceLightIndices = m_slicesLightIndices[slice];
+        for (uint i = 0; i < sliceLightIndices.Size(); ++i)
+        {
+            const uint idx = (sliceBaseOffset + i);
+            m_indexData[idx / 4][idx % 4] = sliceLightIndices[i];
+        }
+        sliceBaseOffset += sliceLightIndices.Size();
+    }
+
+    UploadTexture(m_lightDataTex.Get(), &m_lightData);
+    UploadTexture(m_gridTex.Get(), &m_gridData);
+    UploadTexture(m_lightIndicesTex.Get(), &m_indexData);
+}
+
+uint ClusteredLighting::GetSlice(float viewDepth) const
+{
+    const float slice =
+        Math::Log(viewDepth) * m_depthSliceScale + m_depthSliceBias;
+    return SCAST<uint>(Math::Clamp(slice, 0.0f, NumSlices - 1.0f));
+}
+
+void ClusteredLighting::UploadTexture(Texture2D *tex, Array<Vector4> *texels)
+{
+    // Texels are laid out in rows of TexRowWidth, the last row padded
+    const uint numTexels = Math::Max(texels->Size(), 1u);
+    const uint width = Math::Min(numTexels, TexRowWidth);
+    const uint height = (numTexels + width - 1) / width;
+    texels->Resize(width * height, Vector4::Zero());
+
+    tex->Fill(RCAST<const Byte *>(texels->Data()),
+              width,
+              height,
+              GL::ColorComp::RGBA,
+              GL::DataType::FLOAT);
+}
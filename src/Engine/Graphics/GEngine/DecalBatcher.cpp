@@ -0,0 +1,600 @@
+#include "Bang/DecalBatcher.h"
+
+#include "Bang/Array.tcc"
+#include "Bang/Assets.h"
+#include "Bang/Assets.tcc"
+#include "Bang/Camera.h"
+#include "Bang/Framebuffer.h"
+#include "Bang/GBuffer.h"
+#include "Bang/GEngine.h"
+#include "Bang/GL.h"
+#include "Bang/Math.h"
+#include "Bang/Matrix4.tcc"
+#include "Bang/ShaderProgram.h"
+#include "Bang/ShaderProgramFactory.h"
+#include "Bang/Texture2D.h"
+#include "Bang/UMap.tcc"
+
+using namespace Bang;
+
+constexpr int DecalBatcher::TileSize;
+constexpr int DecalBatcher::AtlasMaxMipLevel;
+constexpr uint DecalBatcher::TexRowWidth;
+constexpr uint DecalBatcher::NumTexelsPerDecal;
+constexpr int DecalBatcher::AtlasSize;
+constexpr int DecalBatcher::AtlasEntryPadding;
+
+DecalBatcher::DecalBatcher()
+    : m_spawnedDecals(1024),
+      m_atlasPacker(Vector2i(AtlasSize), AtlasEntryPadding * 2)
+{
+}
+
+DecalBatcher::~DecalBatcher()
+{
+    delete m_atlasFramebuffer;
+}
+
+void DecalBatcher::Init()
+{
+    for (AH<Texture2D> *tex : {&m_decalDataTex, &m_gridTex, &m_decalIndicesTex})
+    {
+        *tex = Assets::Create<Texture2D>();
+        tex->Get()->SetFormat(GL::ColorFormat::RGBA32F);
+        tex->Get()->SetFilterMode(GL::FilterMode::NEAREST);
+        tex->Get()->SetWrapMode(GL::WrapMode::CLAMP_TO_EDGE);
+    }
+
+    m_atlasTex = Assets::Create<Texture2D>();
+    m_atlasTex.Get()->SetFormat(GL::ColorFormat::RGBA8);
+    m_atlasTex.Get()->SetWrapMode(GL::WrapMode::CLAMP_TO_EDGE);
+    m_atlasTex.Get()->CreateEmpty(AtlasSize, AtlasSize);
+
+    // Allocate the mip levels, they are regenerated when entries are copied
+    GL::Push(GL::BindTarget::TEXTURE_2D);
+    m_atlasTex.Get()->Bind();
+    GL::TexParameteri(m_atlasTex.Get()->GetTextureTarget(),
+                      GL::TexParameter::TEXTURE_MAX_LEVEL,
+                      AtlasMaxMipLevel);
+    m_atlasTex.Get()->GenerateMipMaps();
+    m_atlasTex.Get()->SetFilterMode(GL::FilterMode::TRILINEAR_LL);
+    GL::Pop(GL::BindTarget::TEXTURE_2D);
+
+    m_atlasFramebuffer = new Framebuffer();
+    p_decalsSP.Set(ShaderProgramFactory::GetDecalsDeferredScreenPass());
+    p_atlasCopySP.Set(ShaderProgramFactory::GetDecalAtlasCopy());
+}
+
+void DecalBatcher::AddDecal(const Matrix4 &worldToDecalMatrix,
+                            Texture2D *texture,
+                            float fade)
+{
+    if (!texture || fade <= 0.0f)
+    {
+        return;
+    }
+
+    QueuedDecal decal;
+    decal.worldToDecalMatrix = worldToDecalMatrix;
+    decal.texture = texture;
+    decal.fade = Math::Min(fade, 1.0f);
+    decal.atlasKey = 0;
+    decal.atlasUvRect = Vector4::Zero();
+    decal.visible = false;
+    m_queuedDecals.PushBack(decal);
+}
+
+void DecalBatcher::SpawnDecal(const Vector3 &position,
+                              const Quaternion &rotation,
+                              const Vector3 &boxSize,
+                              Texture2D *texture,
+                              float lifeTimeSeconds,
+                              float fadeOutSeconds)
+{
+    if (!texture || lifeTimeSeconds <= 0.0f)
+    {
+        return;
+    }
+
+    // Same matrices as the ones of an ortho DecalRenderer
+    const Matrix4 decalToWorld = Matrix4::TranslateMatrix(position) *
+                                 Matrix4::RotateMatrix(rotation) *
+                                 Matrix4::ScaleMatrix(boxSize);
+    SpawnedDecal spawnedDecal;
+    spawnedDecal.worldToDecalMatrix =
+        Matrix4::Ortho(-0.5f, 0.5f, -0.5f, 0.5f, -0.5f, 0.5f) *
+        decalToWorld.Inversed();
+    spawnedDecal.texture.Set(texture);
+    spawnedDecal.spawnTime = Time::GetNow();
+    spawnedDecal.lifeTimeSeconds = lifeTimeSeconds;
+    spawnedDecal.fadeOutSeconds = Math::Max(fadeOutSeconds, 0.0f);
+
+    // The oldest one is recycled when the budget is full
+    m_spawnedDecals.PushBack(spawnedDecal);
+}
+
+void DecalBatcher::ClearSpawnedDecals()
+{
+    m_spawnedDecals.Clear();
+}
+
+void DecalBatcher::Flush(Camera *camera)
+{
+    m_numFlushedDecals = 0;
+    m_numFlushDrawCalls = 0;
+
+    ShaderProgram *sp = p_decalsSP.Get();
+    if (m_enabled)
+    {
+        QueueSpawnedDecals();
+    }
+    if (!sp || m_queuedDecals.IsEmpty())
+    {
+        m_queuedDecals.Clear();
+        return;
+    }
+
+    ResolveAtlasRects();
+    if (m_atlasMipMapsDirty)
+    {
+        m_atlasTex.Get()->GenerateMipMaps();
+        m_atlasMipMapsDirty = false;
+    }
+
+    // Tiles are sized in pixels, so their number follows the viewport
+    const Vector2i viewportSize = GL::GetViewportSize();
+    const Vector2i numTiles = ComputeNumTiles(viewportSize);
+    if (numTiles != GetNumTiles())
+    {
+        m_numTiles = numTiles;
+        m_tileOffsetsCounts.Resize(numTiles.x * numTiles.y * 2, 0);
+        m_gridData.Resize(numTiles.x * numTiles.y, Vector4::Zero());
+    }
+
+    const Matrix4 cameraViewProjMatrix =
+        camera->GetProjectionMatrix() * camera->GetViewMatrix();
+    for (QueuedDecal &decal : m_queuedDecals)
+    {
+        if (decal.atlasKey != 0)
+        {
+            ComputeDecalTileRange(
+                &decal, cameraViewProjMatrix, viewportSize);
+            m_numFlushedDecals += (decal.visible ? 1 : 0);
+        }
+    }
+
+    if (m_numFlushedDecals > 0)
+    {
+        BinTiles();
+        Upload();
+
+        GL::Push(GL::BindTarget::SHADER_PROGRAM);
+
+        sp->Bind();
+        SetUniforms(sp);
+        camera->GetGBuffer()->BindAttachmentsForReading(sp);
+        GEngine::GetInstance()->RenderViewportRect(sp, AARect::NDCRect());
+        ++m_numFlushDrawCalls;
+
+        GL::Pop(GL::BindTarget::SHADER_PROGRAM);
+    }
+
+    m_queuedDecals.Clear();
+}
+
+void DecalBatcher::SetEnabled(bool enabled)
+{
+    m_enabled = enabled;
+}
+
+void DecalBatcher::SetSpawnedDecalsBudget(uint spawnedDecalsBudget)
+{
+    if (spawnedDecalsBudget != GetSpawnedDecalsBudget())
+    {
+        m_spawnedDecals.SetCapacity(spawnedDecalsBudget);
+    }
+}
+
+void DecalBatcher::SetAtlasEntryMaxSize(int atlasEntryMaxSize)
+{
+    m_atlasEntryMaxSize = Math::Clamp(atlasEntryMaxSize, 1, AtlasSize);
+}
+
+bool DecalBatcher::IsEnabled() const
+{
+    return m_enabled;
+}
+
+uint DecalBatcher::GetSpawnedDecalsBudget() const
+{
+    return m_spawnedDecals.GetCapacity();
+}
+
+int DecalBatcher::GetAtlasEntryMaxSize() const
+{
+    return m_atlasEntryMaxSize;
+}
+
+uint DecalBatcher::GetNumSpawnedDecals() const
+{
+    return m_spawnedDecals.Size();
+}
+
+uint DecalBatcher::GetNumAtlasEntries() const
+{
+    return m_atlasPacker.GetNumEntries();
+}
+
+Texture2D *DecalBatcher::GetAtlasTexture() const
+{
+    return m_atlasTex.Get();
+}
+
+uint DecalBatcher::GetNumFlushedDecals() const
+{
+    return m_numFlushedDecals;
+}
+
+uint DecalBatcher::GetNumFlushDrawCalls() const
+{
+    return m_numFlushDrawCalls;
+}
+
+const Vector2i &DecalBatcher::GetNumTiles() const
+{
+    return m_numTiles;
+}
+
+Vector2i DecalBatcher::ComputeNumTiles(const Vector2i &viewportSize)
+{
+    return Vector2i::Max(
+        (viewportSize + Vector2i(TileSize - 1)) / TileSize, Vector2i::One());
+}
+
+void DecalBatcher::OnAssetChanged(Asset *asset)
+{
+    // Copied again the next time it is used
+    RemoveAtlasEntry(DCAST<Texture2D *>(asset));
+}
+
+void DecalBatcher::OnDestroyed(EventEmitter<IEventsDestroy> *object)
+{
+    RemoveAtlasEntry(DCAST<Texture2D *>(object));
+}
+
+void DecalBatcher::QueueSpawnedDecals()
+{
+    // Drop the expired ones and queue the rest, from the oldest
+    m_spawnedDecals.RemoveIf([this](const SpawnedDecal &spawnedDecal) {
+        const float ageSeconds = SCAST<float>(
+            Time::GetPassedTimeSince(spawnedDecal.spawnTime).GetSeconds());
+        const float lifeLeftSeconds =
+            (spawnedDecal.lifeTimeSeconds - ageSeconds);
+        if (lifeLeftSeconds <= 0.0f)
+        {
+            return true;
+        }
+
+        const float fade =
+            (spawnedDecal.fadeOutSeconds > 0.0f
+                 ? Math::Min(lifeLeftSeconds / spawnedDecal.fadeOutSeconds,
+                             1.0f)
+                 : 1.0f);
+        AddDecal(spawnedDecal.worldToDecalMatrix,
+                 spawnedDecal.texture.Get(),
+                 fade);
+        return false;
+    });
+}
+
+void DecalBatcher::ResolveAtlasRects()
+{
+    for (QueuedDecal &decal : m_queuedDecals)
+    {
+        if (!AddToAtlas(decal.texture, &decal.atlasKey))
+        {
+            decal.atlasKey = 0;
+        }
+    }
+
+    // If the atlas ran out of room during this flush, the textures of the
+    // first decals may have been evicted. Those are skipped
+    const Vector2 atlasSize(m_atlasPacker.GetPageSize());
+    for (QueuedDecal &decal : m_queuedDecals)
+    {
+        if (decal.atlasKey != 0 && m_atlasPacker.Contains(decal.atlasKey))
+        {
+            // No inset needed, the filtering past the entry edges reads
+            // its padding, which repeats the edge texels
+            const AARecti &rect = m_atlasPacker.GetRect(decal.atlasKey);
+            const Vector2 uvMin = Vector2(rect.GetMin()) / atlasSize;
+            const Vector2 uvMax = Vector2(rect.GetMax()) / atlasSize;
+            decal.atlasUvRect = Vector4(uvMin.x, uvMin.y, uvMax.x, uvMax.y);
+        }
+        else
+        {
+            decal.atlasKey = 0;
+        }
+    }
+}
+
+bool DecalBatcher::AddToAtlas(Texture2D *texture, uint *atlasKey)
+{
+    auto it = m_atlasTexturesToKeys.Find(texture);
+    if (it != m_atlasTexturesToKeys.End())
+    {
+        *atlasKey = it->second;
+        m_atlasPacker.Touch(*atlasKey);
+        return true;
+    }
+
+    // Big textures are scaled down into the atlas, keeping the aspect
+    const Vector2i texSize = Vector2i::Max(texture->GetSize(), Vector2i::One());
+    const int texMaxSize = Math::Max(texSize.x, texSize.y);
+    Vector2i entrySize = texSize;
+    if (texMaxSize > m_atlasEntryMaxSize)
+    {
+        entrySize = Vector2i::Max(
+            (texSize * m_atlasEntryMaxSize) / texMaxSize, Vector2i::One());
+    }
+
+    AARecti atlasRect;
+    Array<uint> evictedKeys;
+    const uint newAtlasKey = ++m_atlasKeysCounter;
+    if (!m_atlasPacker.Insert(newAtlasKey, entrySize, &atlasRect, &evictedKeys))
+    {
+        return false;
+    }
+
+    for (uint evictedKey : evictedKeys)
+    {
+        RemoveAtlasEntry(m_atlasKeysToTextures.Get(evictedKey));
+    }
+
+    m_atlasTexturesToKeys.Add(texture, newAtlasKey);
+    m_atlasKeysToTextures.Add(newAtlasKey, texture);
+    texture->EventEmitter<IEventsAsset>::RegisterListener(this);
+    texture->EventEmitter<IEventsDestroy>::RegisterListener(this);
+
+    CopyToAtlas(texture, atlasRect);
+    m_atlasMipMapsDirty = true;
+    *atlasKey = newAtlasKey;
+    return true;
+}
+
+void DecalBatcher::CopyToAtlas(Texture2D *texture, const AARecti &atlasRect)
+{
+    ShaderProgram *sp = p_atlasCopySP.Get();
+    if (!sp)
+    {
+        return;
+    }
+
+    GL::Push(GL::Pushable::VIEWPORT);
+    GL::Push(GL::Pushable::BLEND_STATES);
+    GL::Push(GL::Pushable::FRAMEBUFFER_AND_READ_DRAW_ATTACHMENTS);
+    GL::Push(GL::BindTarget::SHADER_PROGRAM);
+
+    GL::Disable(GL::Enablable::BLEND);
+    m_atlasFramebuffer->Bind();
+    m_atlasFramebuffer->SetAttachmentTexture(m_atlasTex.Get(),
+                                             GL::Attachment::COLOR0);
+    m_atlasFramebuffer->SetDrawBuffers({GL::Attachment::COLOR0});
+
+    // The padding around the entry gets its edge texels, clamped in the
+    // shader, whatever the wrap mode of the texture is
+    const Vector2i padding(AtlasEntryPadding);
+    const AARecti paddedRect(atlasRect.GetMin() - padding,
+                             atlasRect.GetMax() + padding);
+    GL::SetViewport(paddedRect);
+
+    // Unlike RenderTexture, this keeps the alpha. Sampling with the
+    // texture mipmaps (if it has them) filters the scaled down entries
+    sp->Bind();
+    sp->SetTexture2D("B_RenderTexture_Texture", texture, false);
+    sp->SetVector2("B_DecalAtlasEntryPadding",
+                   Vector2(padding) / Vector2(atlasRect.GetSize()),
+                   false);
+    GEngine::GetInstance()->RenderViewportRect(sp, AARect::NDCRect());
+
+    GL::Pop(GL::BindTarget::SHADER_PROGRAM);
+    GL::Pop(GL::Pushable::FRAMEBUFFER_AND_READ_DRAW_ATTACHMENTS);
+    GL::Pop(GL::Pushable::BLEND_STATES);
+    GL::Pop(GL::Pushable::VIEWPORT);
+}
+
+void DecalBatcher::RemoveAtlasEntry(Texture2D *texture)
+{
+    auto it = m_atlasTexturesToKeys.Find(texture);
+    if (it == m_atlasTexturesToKeys.End())
+    {
+        return;
+    }
+
+    const uint atlasKey = it->second;
+    if (m_atlasPacker.Contains(atlasKey))
+    {
+        m_atlasPacker.Remove(atlasKey);
+    }
+    m_atlasKeysToTextures.Remove(atlasKey);
+    m_atlasTexturesToKeys.Remove(it);
+
+    texture->EventEmitter<IEventsAsset>::UnRegisterListener(this);
+    texture->EventEmitter<IEventsDestroy>::UnRegisterListener(this);
+}
+
+void DecalBatcher::ComputeDecalTileRange(
+    QueuedDecal *decal,
+    const Matrix4 &cameraViewProjMatrix,
+    const Vector2i &viewportSize) const
+{
+    // Project the corners of the decal box. If any of them is behind the
+    // camera, the decal may cover any part of the screen
+    const Matrix4 decalToWorld = decal->worldToDecalMatrix.Inversed();
+    Vector2 minNDC = Vector2::Infinity();
+    Vector2 maxNDC = Vector2::NInfinity();
+    bool isBehindCamera = false;
+    for (uint i = 0; i < 8; ++i)
+    {
+        const Vector4 cornerDecal((i & 1) ? 1.0f : -1.0f,
+                                  (i & 2) ? 1.0f : -1.0f,
+                                  (i & 4) ? 1.0f : -1.0f,
+                                  1.0f);
+        Vector4 cornerWorld = decalToWorld * cornerDecal;
+        cornerWorld /= cornerWorld.w;
+        const Vector4 cornerClip =
+            cameraViewProjMatrix * Vector4(cornerWorld.xyz(), 1.0f);
+        if (cornerClip.w <= 0.0001f)
+        {
+            isBehindCamera = true;
+            break;
+        }
+
+        const Vector2 cornerNDC = (cornerClip.xy() / cornerClip.w);
+        minNDC = Vector2::Min(minNDC, cornerNDC);
+        maxNDC = Vector2::Max(maxNDC, cornerNDC);
+    }
+
+    if (isBehindCamera)
+    {
+        minNDC = Vector2(-1.0f);
+        maxNDC = Vector2(1.0f);
+    }
+    else if (maxNDC.x < -1.0f || maxNDC.y < -1.0f || minNDC.x > 1.0f ||
+             minNDC.y > 1.0f)
+    {
+        decal->visible = false;
+        return;
+    }
+
+    // Same tile as the one the shader gets from the pixel coordinates
+    auto ndcToTile = [](float ndc, int viewportSize, int numTiles) {
+        float uv = Math::Clamp(ndc * 0.5f + 0.5f, 0.0f, 1.0f);
+        int tile = SCAST<int>(uv * viewportSize) / TileSize;
+        return SCAST<uint>(Math::Min(tile, numTiles - 1));
+    };
+    const Vector2i &numTiles = GetNumTiles();
+    decal->minTileX = ndcToTile(minNDC.x, viewportSize.x, numTiles.x);
+    decal->maxTileX = ndcToTile(maxNDC.x, viewportSize.x, numTiles.x);
+    decal->minTileY = ndcToTile(minNDC.y, viewportSize.y, numTiles.y);
+    decal->maxTileY = ndcToTile(maxNDC.y, viewportSize.y, numTiles.y);
+    decal->visible = true;
+}
+
+void DecalBatcher::BinTiles()
+{
+    // Counting sort of the (tile, decal) pairs by tile. It keeps the order
+    // in which decals were added inside every tile
+    const uint numTilesX = SCAST<uint>(GetNumTiles().x);
+    const uint numTiles = numTilesX * SCAST<uint>(GetNumTiles().y);
+    for (uint i = 0; i < numTiles * 2; ++i)
+    {
+        m_tileOffsetsCounts[i] = 0;
+    }
+
+    for (const QueuedDecal &decal : m_queuedDecals)
+    {
+        if (decal.visible)
+        {
+            for (uint ty = decal.minTileY; ty <= decal.maxTileY; ++ty)
+            {
+                for (uint tx = decal.minTileX; tx <= decal.maxTileX; ++tx)
+                {
+                    ++m_tileOffsetsCounts[(ty * numTilesX + tx) * 2 + 1];
+                }
+            }
+        }
+    }
+
+    uint numDecalIndices = 0;
+    for (uint tile = 0; tile < numTiles; ++tile)
+    {
+        m_tileOffsetsCounts[tile * 2 + 0] = numDecalIndices;
+        numDecalIndices += m_tileOffsetsCounts[tile * 2 + 1];
+    }
+    m_decalIndices.Resize(numDecalIndices);
+
+    Array<uint> tileFill(numTiles, 0);
+    for (uint i = 0; i < m_queuedDecals.Size(); ++i)
+    {
+        const QueuedDecal &decal = m_queuedDecals[i];
+        if (decal.visible)
+        {
+            for (uint ty = decal.minTileY; ty <= decal.maxTileY; ++ty)
+            {
+                for (uint tx = decal.minTileX; tx <= decal.maxTileX; ++tx)
+                {
+                    const uint tile = (ty * numTilesX + tx);
+                    const uint idx =
+                        m_tileOffsetsCounts[tile * 2] + (tileFill[tile]++);
+                    m_decalIndices[idx] = i;
+                }
+            }
+        }
+    }
+}
+
+void DecalBatcher::Upload()
+{
+    m_decalData.Resize(m_queuedDecals.Size() * NumTexelsPerDecal);
+    for (uint i = 0; i < m_queuedDecals.Size(); ++i)
+    {
+        const QueuedDecal &decal = m_queuedDecals[i];
+        Vector4 *decalTexels = &m_decalData[i * NumTexelsPerDecal];
+        decalTexels[0] = decal.worldToDecalMatrix.c0;
+        decalTexels[1] = decal.worldToDecalMatrix.c1;
+        decalTexels[2] = decal.worldToDecalMatrix.c2;
+        decalTexels[3] = decal.worldToDecalMatrix.c3;
+        decalTexels[4] = decal.atlasUvRect;
+        decalTexels[5] = Vector4(decal.fade, 0.0f, 0.0f, 0.0f);
+    }
+
+    for (uint tile = 0; tile < m_gridData.Size(); ++tile)
+    {
+        m_gridData[tile] = Vector4(m_tileOffsetsCounts[tile * 2 + 0],
+                                   m_tileOffsetsCounts[tile * 2 + 1],
+                                   0.0f,
+                                   0.0f);
+    }
+
+    // 4 indices per texel
+    m_indexData.Resize((m_decalIndices.Size() + 3) / 4);
+    for (uint i = 0; i < m_decalIndices.Size(); ++i)
+    {
+        m_indexData[i / 4][i % 4] = m_decalIndices[i];
+    }
+
+    UploadTexture(m_decalDataTex.Get(), &m_decalData);
+    UploadTexture(m_gridTex.Get(), &m_gridData);
+    UploadTexture(m_decalIndicesTex.Get(), &m_indexData);
+}
+
+void DecalBatcher::SetUniforms(ShaderProgram *sp) const
+{
+    ASSERT(GL::IsBound(sp));
+    sp->SetTexture2D("B_DecalData", m_decalDataTex.Get(), false);
+    sp->SetTexture2D("B_DecalGrid", m_gridTex.Get(), false);
+    sp->SetTexture2D("B_DecalIndices", m_decalIndicesTex.Get(), false);
+    sp->SetTexture2D("B_DecalAtlas", m_atlasTex.Get(), false);
+    sp->SetInt("B_DecalTileSize", TileSize, false);
+    sp->SetInt("B_DecalNumTilesX", GetNumTiles().x, false);
+    sp->SetInt("B_DecalNumTilesY", GetNumTiles().y, false);
+    sp->SetFloat(
+        "B_DecalAtlasMaxMipLevel", SCAST<float>(AtlasMaxMipLevel), false);
+    sp->SetInt("B_DecalTexRowWidth", TexRowWidth, false);
+}
+
+void DecalBatcher::UploadTexture(Texture2D *tex, Array<Vector4> *texels)
+{
+    // Texels are laid out in rows of TexRowWidth, the last row padded
+    const uint numTexels = Math::Max(texels->Size(), 1u);
+    const uint width = Math::Min(numTexels, TexRowWidth);
+    const uint height = (numTexels + width - 1) / width;
+    texels->Resize(width * height, Vector4::Zero());
+
+    tex->Fill(RCAST<const Byte *>(texels->Data()),
+              width,
+              height,
+              GL::ColorComp::RGBA,
+              GL::DataType::FLOAT);
+}
@@ -5,7 +5,9 @@
 #include "Bang/Application.h"
 #include "Bang/Assert.h"
 #include "Bang/Camera.h"
+#include "Bang/ClusteredLighting.h"
 #include "Bang/DebugRenderer.h"
+#include "Bang/DecalBatcher.h"
 #include "Bang/EventEmitter.h"
 #include "Bang/Framebuffer.h"
 #include "Bang/GBuffer.h"
@@ -16,6 +18,7 @@
 #include "Bang/IEventsDestroy.h"
 #include "Bang/Light.h"
 #include "Bang/Material.h"
+#include "Bang/Math.h"
 #include "Bang/Mesh.h"
 #include "Bang/MeshFactory.h"
 #include "Bang/MultiObjectGatherer.tcc"
@@ -25,6 +28,7 @@
 #include "Bang/ReflectionProbe.h"
 #include "Bang/RenderFactory.h"
 #include "Bang/RenderFlags.h"
+#include "Bang/RenderTargetPool.h"
 #include "Bang/Renderer.h"
 #include "Bang/Scene.h"
 #include "Bang/ShaderProgram.h"
@@ -32,6 +36,7 @@
 #include "Bang/TextureCubeMap.h"
 #include "Bang/TextureUnitManager.h"
 #include "Bang/Transform.h"
+#include "Bang/UIBatcher.h"
 #include "Bang/USet.tcc"
 
 namespace Bang
@@ -50,6 +55,9 @@ GEngine::~GEngine()
 {
     delete m_auxiliarFramebuffer;
     delete m_auxiliarFramebufferCM;
+    delete m_clusteredLighting;
+    delete m_decalBatcher;
+    delete m_renderTargetPool;
 
     if (m_debugRenderer)
     {
@@ -83,6 +91,7 @@ void GEngine::Init()
     m_gl->Init();
 
     m_texUnitManager = new TextureUnitManager();
+    m_renderTargetPool = new RenderTargetPool();
     m_renderFactory = new RenderFactory();
     m_debugRenderer = new DebugRenderer();
 
@@ -109,6 +118,12 @@ void GEngine::Init()
         shadersDir.Append("FillCubeMapFromTextures.vert"),
         shadersDir.Append("FillCubeMapFromTextures.geom"),
         shadersDir.Append("FillCubeMapFromTextures.frag")));
+
+    m_clusteredLighting = new ClusteredLighting();
+    m_clusteredLighting->Init();
+
+    m_decalBatcher = new DecalBatcher();
+    m_decalBatcher->Init();
 }
 
 void GEngine::Render(GameObject *go)
@@ -119,18 +134,24 @@ void GEngine::Render(GameObject *go)
         {
             RenderFlags renderFlags = camera->GetRenderFlags();
 
+            m_numRenderedTriangles = 0;
+            m_numFullDetailTriangles = 0;
+
             go->BeforeRender();
 
             if (renderFlags.IsOn(RenderFlag::RENDER_SHADOW_MAPS))
             {
                 RenderShadowMaps(go);
+                GL_CheckPassErrors("ShadowMaps");
             }
 
             RenderToGBuffer(go, camera);
+            GL_CheckPassErrors("GBuffer");
 
             if (renderFlags.IsOn(RenderFlag::RENDER_REFLECTION_PROBES))
             {
                 RenderReflectionProbes(go);
+                GL_CheckPassErrors("ReflectionProbes");
             }
         }
     }
@@ -160,16 +181,20 @@ void GEngine::ApplyStenciledDeferredLightsToGBuffer(GameObject *lightsContainer,
     GL::SetStencilFunc(GL::Function::EQUAL);
     GL::SetStencilValue(1);
 
+    // Shadowless point lights were binned in the clusters, and are all
+    // applied in a single screen pass. The rest go one by one
     const Array<Light *> &lights =
         m_lightsCache.GetGatheredArray(lightsContainer);
     for (Light *light : lights)
     {
-        if (!light || !light->IsEnabledRecursively())
+        if (!light || !light->IsEnabledRecursively() ||
+            ClusteredLighting::IsResolvedClustered(light))
         {
             continue;
         }
         light->ApplyLight(camera, maskRectNDC);
     }
+    m_clusteredLighting->ApplyClusteredLights(camera, maskRectNDC);
 
     GL::Pop(GL::Pushable::STENCIL_STATES);
 }
@@ -183,20 +208,16 @@ void GEngine::RetrieveForwardRenderingInformation(GameObject *go)
     m_currentForwardRenderingLightIntensities.Clear();
     m_currentForwardRenderingLightRanges.Clear();
 
+    // Point lights are read from the clusters built in RenderToGBuffer
     int i = 0;
     const Array<Light *> &lights = m_lightsCache.GetGatheredArray(go);
     for (Light *light : lights)
     {
-        if (light->IsActiveRecursively())
+        if (light->IsActiveRecursively() && !DCAST<PointLight *>(light))
         {
             uint lightType = 0;
             Transform *lightTR = light->GetGameObject()->GetTransform();
             float range = 0.0f;
-            if (PointLight *pl = DCAST<PointLight *>(light))
-            {
-                range = pl->GetRange();
-                lightType = 1;
-            }
 
             m_currentForwardRenderingLightTypes.PushBack(lightType);
             m_currentForwardRenderingLightColors.PushBack(light->GetColor());
@@ -245,6 +266,7 @@ void GEngine::PrepareForForwardRendering(Renderer *rend)
                             false);
         }
         sp->SetInt("B_ForwardRenderingLightNumber", numLights, false);
+        m_clusteredLighting->SetUniforms(sp);
     }
 }
 
@@ -258,6 +280,48 @@ Material *GEngine::GetReplacementMaterial() const
     return m_replacementMaterial.Get();
 }
 
+void GEngine::SetLODBias(float lodBias)
+{
+    m_lodBias = Math::Max(lodBias, 0.01f);
+}
+
+void GEngine::SetShadowMapsLODOffset(int shadowMapsLODOffset)
+{
+    m_shadowMapsLODOffset = Math::Max(shadowMapsLODOffset, 0);
+}
+
+float GEngine::GetLODBias() const
+{
+    return m_lodBias;
+}
+
+int GEngine::GetShadowMapsLODOffset() const
+{
+    return m_shadowMapsLODOffset;
+}
+
+bool GEngine::IsRenderingShadowMaps() const
+{
+    return m_renderingShadowMaps;
+}
+
+void GEngine::AddRenderedTriangles(uint numRenderedTriangles,
+                                   uint numFullDetailTriangles)
+{
+    m_numRenderedTriangles += numRenderedTriangles;
+    m_numFullDetailTriangles += numFullDetailTriangles;
+}
+
+uint GEngine::GetNumRenderedTriangles() const
+{
+    return m_numRenderedTriangles;
+}
+
+uint GEngine::GetNumFullDetailTriangles() const
+{
+    return m_numFullDetailTriangles;
+}
+
 Camera *GEngine::GetActiveRenderingCamera()
 {
     GEngine *ge = GEngine::GetInstance();
@@ -395,6 +459,8 @@ void GEngine::RenderToGBuffer(GameObject *go, Camera *camera)
         gbuffer->SetSceneDepthStencil();
         ClearDepthStencilIfNeeded(renderFlags);
 
+        m_clusteredLighting->Build(camera, m_lightsCache.GetGatheredArray(go));
+
         GL::SetDepthMask(true);
         GL::SetDepthFunc(GL::Function::LEQUAL);
 
@@ -418,6 +484,7 @@ void GEngine::RenderToGBuffer(GameObject *go, Camera *camera)
 
             GL::Disable(GL::Enablable::STENCIL_TEST);
             RenderWithPass(go, RenderPass::SCENE_DECALS);
+            m_decalBatcher->Flush(camera);
 
             GL::Pop(GL::Pushable::BLEND_STATES);
             GL::Pop(GL::Pushable::STENCIL_STATES);
@@ -731,20 +798,68 @@ void GEngine::FillTexture(Texture2D *texture, const Color &color)
 
 void GEngine::CopyTexture(Texture2D *source, Texture2D *destiny)
 {
+    GL::Push(GL::Pushable::VIEWPORT);
     GL::Push(GL::Pushable::BLEND_STATES);
     GL::Push(GL::Pushable::FRAMEBUFFER_AND_READ_DRAW_ATTACHMENTS);
 
     destiny->Resize(source->GetSize());
 
     GL::Disable(GL::Enablable::BLEND);
+    GL::SetViewport(0, 0, source->GetWidth(), source->GetHeight());
 
     m_auxiliarFramebuffer->Bind();
     m_auxiliarFramebuffer->SetAttachmentTexture(destiny,
                                                 GL::Attachment::COLOR0);
+    m_auxiliarFramebuffer->SetDrawBuffers({GL::Attachment::COLOR0});
     GEngine::RenderTexture(source);
 
     GL::Pop(GL::Pushable::FRAMEBUFFER_AND_READ_DRAW_ATTACHMENTS);
     GL::Pop(GL::Pushable::BLEND_STATES);
+    GL::Pop(GL::Pushable::VIEWPORT);
+}
+
+void GEngine::DownscaleTexture(Texture2D *source, Texture2D *destiny)
+{
+    GL::Push(GL::Pushable::VIEWPORT);
+    GL::Push(GL::Pushable::BLEND_STATES);
+    GL::Push(GL::Pushable::FRAMEBUFFER_AND_READ_DRAW_ATTACHMENTS);
+
+    GL::Disable(GL::Enablable::BLEND);
+    m_auxiliarFramebuffer->Bind();
+    m_auxiliarFramebuffer->SetDrawBuffers({GL::Attachment::COLOR0});
+
+    // Bilinear sampling averages 2x2 texels, so go down by halves
+    RenderTargetPool *rtPool = GetRenderTargetPool();
+    const Vector2i destinySize = destiny->GetSize();
+    Texture2D *levelTexture = source;
+    Vector2i levelSize = source->GetSize();
+    bool isLastLevel = false;
+    while (!isLastLevel)
+    {
+        levelSize = Vector2i::Max(levelSize / 2, destinySize);
+        isLastLevel = (levelSize == destinySize);
+
+        Texture2D *nextLevelTexture = destiny;
+        if (!isLastLevel)
+        {
+            nextLevelTexture = rtPool->Acquire(
+                RenderTargetDesc(levelSize, destiny->GetFormat()), "Downscale");
+        }
+        m_auxiliarFramebuffer->SetAttachmentTexture(nextLevelTexture,
+                                                    GL::Attachment::COLOR0);
+        GL::SetViewport(0, 0, levelSize.x, levelSize.y);
+        GEngine::RenderTexture(levelTexture);
+
+        if (levelTexture != source)
+        {
+            rtPool->Release(levelTexture);
+        }
+        levelTexture = nextLevelTexture;
+    }
+
+    GL::Pop(GL::Pushable::FRAMEBUFFER_AND_READ_DRAW_ATTACHMENTS);
+    GL::Pop(GL::Pushable::BLEND_STATES);
+    GL::Pop(GL::Pushable::VIEWPORT);
 }
 
 bool GEngine::CanRenderNow(Renderer *rend, RenderPass renderPass) const
@@ -897,6 +1012,8 @@ GEngine *GEngine::GetInstance()
 
 void GEngine::RenderShadowMaps(GameObject *go)
 {
+    m_renderingShadowMaps = true;
+    GatherShadowCasters(go);
     const Array<Light *> &lights = m_lightsCache.GetGatheredArray(go);
     for (Light *light : lights)
     {
@@ -905,17 +1022,69 @@ void GEngine::RenderShadowMaps(GameObject *go)
             light->RenderShadowMaps(go);
         }
     }
+    m_shadowCasters.Clear();
+    m_shadowCastersBVH.Clear();
+    m_renderingShadowMaps = false;
+}
+
+void GEngine::GatherShadowCasters(GameObject *go)
+{
+    // The renderers are kept up to date by the gatherer, so this only
+    // filters them, computes their world bounds and builds a hierarchy over
+    // them, once for all the lights
+    m_shadowCasters.Clear();
+    m_shadowCastersAABoxes.Clear();
+    const Array<Renderer *> &renderers = m_renderersCache.GetGatheredArray(go);
+    for (Renderer *rend : renderers)
+    {
+        if (!rend->GetCastsShadows() || !rend->IsActiveRecursively())
+        {
+            continue;
+        }
+
+        const Material *mat = rend->GetActiveMaterial();
+        if (!mat || mat->GetShaderProgramProperties().GetRenderPass() !=
+                        RenderPass::SCENE_OPAQUE)
+        {
+            continue;
+        }
+
+        ShadowCaster shadowCaster;
+        shadowCaster.renderer = rend;
+        const AABox rendAABox = rend->GetAABBox();
+        if (rendAABox != AABox::Empty())
+        {
+            shadowCaster.aaBoxWorld = rend->GetGameObject()
+                                          ->GetTransform()
+                                          ->GetLocalToWorldMatrix() *
+                                      rendAABox;
+        }
+        m_shadowCasters.PushBack(shadowCaster);
+        m_shadowCastersAABoxes.PushBack(shadowCaster.aaBoxWorld);
+    }
+    m_shadowCastersBVH.Build(m_shadowCastersAABoxes);
 }
 
 void GEngine::RenderReflectionProbes(GameObject *go)
 {
+    // Probes with an update in progress go first, so that they finish before
+    // other probes start theirs
     const Array<ReflectionProbe *> &reflProbes =
         m_reflProbesCache.GetGatheredArray(go);
-    for (ReflectionProbe *reflProbe : reflProbes)
+    for (bool updateInProgress : {true, false})
     {
-        if (reflProbe->IsActiveRecursively())
+        for (ReflectionProbe *reflProbe : reflProbes)
         {
-            reflProbe->RenderReflectionProbe();
+            if (reflProbe->IsActiveRecursively() &&
+                reflProbe->IsUpdateInProgress() == updateInProgress)
+            {
+                // The first capture of a probe is not sliced, so it can use
+                // more steps than the ones left
+                const uint usedSteps = reflProbe->RenderReflectionProbeSteps(
+                    m_reflProbesUpdateStepsLeft);
+                m_reflProbesUpdateStepsLeft -=
+                    Math::Min(usedSteps, m_reflProbesUpdateStepsLeft);
+            }
         }
     }
 }
@@ -1021,6 +1190,9 @@ void GEngine::Render(Renderer *rend)
         return;
     }
 
+    // Pending batched UI goes first, to keep the paint order
+    UIBatcher::FlushActive();
+
     // If we have a replacement shader currently, change the renderer sp
     AH<Material> previousRendSharedMat, previousRendCopiedMat;
     previousRendSharedMat.Set(rend->GetSharedMaterial());
@@ -1064,6 +1236,54 @@ TextureUnitManager *GEngine::GetTextureUnitManager() const
     return m_texUnitManager;
 }
 
+ClusteredLighting *GEngine::GetClusteredLighting() const
+{
+    return m_clusteredLighting;
+}
+
+DecalBatcher *GEngine::GetDecalBatcher() const
+{
+    return m_decalBatcher;
+}
+
+const Array<ShadowCaster> &GEngine::GetShadowCasters() const
+{
+    return m_shadowCasters;
+}
+
+void GEngine::GetShadowCasters(const AABoxBVH::OverlapsFunction &overlaps,
+                               Array<ShadowCaster> *shadowCasters) const
+{
+    m_shadowCastersQueryIndices.Clear();
+    m_shadowCastersBVH.Query(overlaps, &m_shadowCastersQueryIndices);
+    for (uint shadowCasterIndex : m_shadowCastersQueryIndices)
+    {
+        shadowCasters->PushBack(m_shadowCasters[shadowCasterIndex]);
+    }
+}
+
+RenderTargetPool *GEngine::GetRenderTargetPool() const
+{
+    return m_renderTargetPool;
+}
+
+void GEngine::SetReflectionProbesUpdateStepsPerFrame(uint updateStepsPerFrame)
+{
+    m_reflProbesUpdateStepsPerFrame = updateStepsPerFrame;
+}
+
+uint GEngine::GetReflectionProbesUpdateStepsPerFrame() const
+{
+    return m_reflProbesUpdateStepsPerFrame;
+}
+
+void GEngine::EndFrame()
+{
+    m_reflProbesUpdateStepsLeft = GetReflectionProbesUpdateStepsPerFrame();
+    GetRenderTargetPool()->EndFrame();
+    GL::EndFrame();
+}
+
 void GEngine::OnDestroyed(EventEmitter<IEventsDestroy> *object)
 {
     Camera *cam = DCAST<Camera *>(object);
@@ -0,0 +1,198 @@
+#include "Bang/AtlasPacker.h"
+
+#include "Bang/Array.tcc"
+#include "Bang/Assert.h"
+#include "Bang/Math.h"
+#include "Bang/UMap.tcc"
+
+using namespace Bang;
+
+AtlasPacker::AtlasPacker(const Vector2i &pageSize, int margin)
+    : m_pageSize(pageSize), m_margin(Math::Max(margin, 0))
+{
+}
+
+bool AtlasPacker::Insert(uint key,
+                              const Vector2i &size,
+                              AARecti *rect,
+                              Array<uint> *evictedKeys)
+{
+    const Vector2i maxSize = (GetPageSize() - Vector2i(m_margin * 2));
+    if (size.x <= 0 || size.y <= 0 || size.x > maxSize.x || size.y > maxSize.y)
+    {
+        return false;
+    }
+
+    Remove(key);
+
+    // Shelves first, then the slots of evicted entries. If there is still
+    // no room, keep evicting the least recently used entries
+    AARecti slot;
+    bool packed =
+        (PackInShelves(size, &slot) || PackInFreeSlots(size, &slot));
+    while (!packed && EvictLeastRecentlyUsed(evictedKeys))
+    {
+        packed = PackInFreeSlots(size, &slot);
+    }
+
+    // Everything got evicted but the free slots are too fragmented, so
+    // start the page from scratch
+    if (!packed)
+    {
+        m_shelves.Clear();
+        m_freeSlots.Clear();
+        packed = PackInShelves(size, &slot);
+    }
+    ASSERT(packed);
+
+    Entry entry;
+    entry.slot = slot;
+    entry.rect = AARecti(slot.GetMin(), slot.GetMin() + size);
+    entry.lastUse = ++m_useCounter;
+    m_entries.Add(key, entry);
+
+    if (rect)
+    {
+        *rect = entry.rect;
+    }
+    return true;
+}
+
+void AtlasPacker::Remove(uint key)
+{
+    if (Contains(key))
+    {
+        m_freeSlots.PushBack(m_entries.Get(key).slot);
+        m_entries.Remove(key);
+    }
+}
+
+void AtlasPacker::Touch(uint key)
+{
+    if (Contains(key))
+    {
+        m_entries.Get(key).lastUse = ++m_useCounter;
+    }
+}
+
+void AtlasPacker::Clear()
+{
+    m_shelves.Clear();
+    m_freeSlots.Clear();
+    m_entries.Clear();
+}
+
+bool AtlasPacker::Contains(uint key) const
+{
+    return m_entries.ContainsKey(key);
+}
+
+const AARecti &AtlasPacker::GetRect(uint key) const
+{
+    return m_entries.Get(key).rect;
+}
+
+const Vector2i &AtlasPacker::GetPageSize() const
+{
+    return m_pageSize;
+}
+
+uint AtlasPacker::GetNumEntries() const
+{
+    return m_entries.Size();
+}
+
+bool AtlasPacker::PackInShelves(const Vector2i &size, AARecti *slot)
+{
+    const int maxX = (GetPageSize().x - m_margin);
+    const int maxY = (GetPageSize().y - m_margin);
+
+    // Best shelf is the shortest one that is tall enough and has room left
+    Shelf *bestShelf = nullptr;
+    for (Shelf &shelf : m_shelves)
+    {
+        if (shelf.height >= size.y && shelf.usedWidth + size.x <= maxX &&
+            (!bestShelf || shelf.height < bestShelf->height))
+        {
+            bestShelf = &shelf;
+        }
+    }
+
+    // Open a new shelf if the best one would waste too much height
+    const int newShelfY =
+        (m_shelves.IsEmpty() ? m_margin
+                             : (m_shelves.Back().y + m_shelves.Back().height +
+                                m_margin));
+    const bool canOpenShelf = (newShelfY + size.y <= maxY);
+    if (canOpenShelf && (!bestShelf || bestShelf->height * 3 > size.y * 4))
+    {
+        Shelf newShelf;
+        newShelf.y = newShelfY;
+        newShelf.height = size.y;
+        newShelf.usedWidth = m_margin;
+        m_shelves.PushBack(newShelf);
+        bestShelf = &m_shelves.Back();
+    }
+
+    if (!bestShelf)
+    {
+        return false;
+    }
+
+    const Vector2i slotMin(bestShelf->usedWidth, bestShelf->y);
+    *slot = AARecti(slotMin,
+                    slotMin + Vector2i(size.x + m_margin, bestShelf->height));
+    bestShelf->usedWidth += (size.x + m_margin);
+    return true;
+}
+
+bool AtlasPacker::PackInFreeSlots(const Vector2i &size, AARecti *slot)
+{
+    // Best fit, to keep the big slots for the big rects
+    int bestSlotIndex = -1;
+    for (uint i = 0; i < m_freeSlots.Size(); ++i)
+    {
+        const AARecti &freeSlot = m_freeSlots[i];
+        if (freeSlot.GetWidth() >= size.x + m_margin &&
+            freeSlot.GetHeight() >= size.y &&
+            (bestSlotIndex < 0 ||
+             freeSlot.GetArea() < m_freeSlots[bestSlotIndex].GetArea()))
+        {
+            bestSlotIndex = SCAST<int>(i);
+        }
+    }
+
+    if (bestSlotIndex < 0)
+    {
+        return false;
+    }
+
+    *slot = m_freeSlots[bestSlotIndex];
+    m_freeSlots.RemoveByIndex(bestSlotIndex);
+    return true;
+}
+
+bool AtlasPacker::EvictLeastRecentlyUsed(Array<uint> *evictedKeys)
+{
+    if (m_entries.IsEmpty())
+    {
+        return false;
+    }
+
+    auto lruIt = m_entries.Begin();
+    for (auto it = m_entries.Begin(); it != m_entries.End(); ++it)
+    {
+        if (it->second.lastUse < lruIt->second.lastUse)
+        {
+            lruIt = it;
+        }
+    }
+
+    if (evictedKeys)
+    {
+        evictedKeys->PushBack(lruIt->first);
+    }
+    m_freeSlots.PushBack(lruIt->second.slot);
+    m_entries.Remove(lruIt);
+    return true;
+}
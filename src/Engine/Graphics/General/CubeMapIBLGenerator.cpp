@@ -47,40 +47,119 @@ AH<TextureCubeMap> CubeMapIBLGenerator::GenerateSpecularIBLCubeMap(
         textureCubeMap, IBLType::SPECULAR, IBLCubeMapSize, sampleCount);
 }
 
+void CubeMapIBLGenerator::FillDiffuseIBLCubeMap(TextureCubeMap *textureCubeMap,
+                                                TextureCubeMap *iblCubeMap,
+                                                uint IBLCubeMapSize,
+                                                uint sampleCount)
+{
+    PrepareIBLCubeMap(iblCubeMap, IBLType::DIFFUSE, IBLCubeMapSize);
+    RenderIBLCubeMap(
+        textureCubeMap, iblCubeMap, IBLType::DIFFUSE, sampleCount, 0);
+}
+
+void CubeMapIBLGenerator::FillSpecularIBLCubeMapMipMap(
+    TextureCubeMap *textureCubeMap,
+    TextureCubeMap *iblCubeMap,
+    uint IBLCubeMapSize,
+    uint sampleCount,
+    uint mipMapLevel)
+{
+    PrepareIBLCubeMap(iblCubeMap, IBLType::SPECULAR, IBLCubeMapSize);
+    RenderIBLCubeMap(textureCubeMap,
+                     iblCubeMap,
+                     IBLType::SPECULAR,
+                     sampleCount,
+                     mipMapLevel);
+}
+
+uint CubeMapIBLGenerator::GetSpecularIBLNumMipMaps(uint IBLCubeMapSize)
+{
+    return Math::Round(Math::Log10(float(IBLCubeMapSize)) /
+                       Math::Log10(2.0f));
+}
+
 AH<TextureCubeMap> CubeMapIBLGenerator::GenerateIBLCubeMap(
     TextureCubeMap *textureCubeMap,
     IBLType iblType,
     uint IBLCubeMapSize,
     uint sampleCount)
+{
+    AH<TextureCubeMap> iblCubeMapAH = Assets::Create<TextureCubeMap>();
+    if (iblType == IBLType::DIFFUSE)
+    {
+        FillDiffuseIBLCubeMap(
+            textureCubeMap, iblCubeMapAH.Get(), IBLCubeMapSize, sampleCount);
+    }
+    else
+    {
+        const uint numMipMaps = GetSpecularIBLNumMipMaps(IBLCubeMapSize);
+        for (uint mipMapLevel = 0; mipMapLevel < numMipMaps; ++mipMapLevel)
+        {
+            FillSpecularIBLCubeMapMipMap(textureCubeMap,
+                                         iblCubeMapAH.Get(),
+                                         IBLCubeMapSize,
+                                         sampleCount,
+                                         mipMapLevel);
+        }
+    }
+    return iblCubeMapAH;
+}
+
+void CubeMapIBLGenerator::PrepareIBLCubeMap(TextureCubeMap *iblCubeMap,
+                                            IBLType iblType,
+                                            uint IBLCubeMapSize)
 {
 #ifdef DEBUG
     ASSERT(Math::IsPowerOfTwo(IBLCubeMapSize));
 #endif
 
-    GL::Push(GL::Pushable::VIEWPORT);
-    GL::Push(GL::Enablable::CULL_FACE);
-    GL::Push(GL::Pushable::COLOR_MASK);
-    GL::Push(GL::Pushable::DEPTH_STATES);
-    GL::Push(GL::Pushable::ALL_MATRICES);
-    GL::Push(GL::BindTarget::SHADER_PROGRAM);
-    GL::Push(GL::BindTarget::TEXTURE_CUBE_MAP);
-    GL::Push(GL::Pushable::FRAMEBUFFER_AND_READ_DRAW_ATTACHMENTS);
+    if (iblCubeMap->GetFormat() == GL::ColorFormat::RGBA16F &&
+        iblCubeMap->GetSize() == IBLCubeMapSize)
+    {
+        return;
+    }
 
-    GL::Enable(GL::Enablable::TEXTURE_CUBE_MAP_SEAMLESS);
+    GL::Push(GL::BindTarget::TEXTURE_CUBE_MAP);
 
-    // Create cube map
-    AH<TextureCubeMap> iblCubeMapAH = Assets::Create<TextureCubeMap>();
-    TextureCubeMap *iblCubeMap = iblCubeMapAH.Get();
     iblCubeMap->SetFormat(GL::ColorFormat::RGBA16F);
     iblCubeMap->Bind();
-    iblCubeMap->Resize(IBLCubeMapSize);
+    iblCubeMap->CreateEmpty(IBLCubeMapSize);
     iblCubeMap->SetWrapMode(GL::WrapMode::CLAMP_TO_EDGE);
     if (iblType == IBLType::SPECULAR)
     {
+        // Allocate the mip levels of the specular cube map, each one is
+        // filled later with more roughness progressively
+        const uint maxMipLevels = GetSpecularIBLNumMipMaps(IBLCubeMapSize);
         iblCubeMap->GenerateMipMaps();
         iblCubeMap->SetFilterMode(GL::FilterMode::TRILINEAR_LL);
+        GL::TexParameteri(iblCubeMap->GetTextureTarget(),
+                          GL::TexParameter::TEXTURE_BASE_LEVEL,
+                          0);
+        GL::TexParameteri(iblCubeMap->GetTextureTarget(),
+                          GL::TexParameter::TEXTURE_MAX_LEVEL,
+                          maxMipLevels - 1);
     }
 
+    GL::Pop(GL::BindTarget::TEXTURE_CUBE_MAP);
+}
+
+void CubeMapIBLGenerator::RenderIBLCubeMap(TextureCubeMap *textureCubeMap,
+                                           TextureCubeMap *iblCubeMap,
+                                           IBLType iblType,
+                                           uint sampleCount,
+                                           uint mipMapLevel)
+{
+    GL::Push(GL::Pushable::VIEWPORT);
+    GL::Push(GL::Enablable::CULL_FACE);
+    GL::Push(GL::Pushable::COLOR_MASK);
+    GL::Push(GL::Pushable::DEPTH_STATES);
+    GL::Push(GL::Pushable::ALL_MATRICES);
+    GL::Push(GL::BindTarget::SHADER_PROGRAM);
+    GL::Push(GL::BindTarget::TEXTURE_CUBE_MAP);
+    GL::Push(GL::Pushable::FRAMEBUFFER_AND_READ_DRAW_ATTACHMENTS);
+
+    GL::Enable(GL::Enablable::TEXTURE_CUBE_MAP_SEAMLESS);
+
     CubeMapIBLGenerator *cmg = CubeMapIBLGenerator::GetInstance();
     cmg->m_iblFramebuffer->Bind();
     cmg->m_iblShaderProgram->Bind();
@@ -89,46 +168,22 @@ AH<TextureCubeMap> CubeMapIBLGenerator::GenerateIBLCubeMap(
     cmg->m_iblShaderProgram->SetTextureCubeMap("B_InputCubeMap",
                                                textureCubeMap);
 
-    // Draw to cubemap
-    if (iblType == IBLType::DIFFUSE)
+    if (iblType == IBLType::SPECULAR)
     {
-        GL::SetViewport(0, 0, IBLCubeMapSize, IBLCubeMapSize);
-        cmg->m_iblFramebuffer->SetAttachmentTexture(iblCubeMap,
-                                                    GL::Attachment::COLOR0);
-        cmg->m_iblFramebuffer->SetAllDrawBuffers();
-
-        GEngine::GetInstance()->RenderViewportPlane();
+        const uint maxMipLevels =
+            GetSpecularIBLNumMipMaps(iblCubeMap->GetSize());
+        const float roughness =
+            SCAST<float>(mipMapLevel) / Math::Max(maxMipLevels - 1, 1u);
+        cmg->m_iblShaderProgram->SetFloat("B_InputRoughness", roughness);
     }
-    else
-    {
-        // Fill mipmap levels of the specular skybox, each one with more
-        // roughness progressively
-        const uint MaxMipLevels =
-            Math::Round(Math::Log10(float(IBLCubeMapSize)) / Math::Log10(2.0f));
-        GL::TexParameteri(iblCubeMap->GetTextureTarget(),
-                          GL::TexParameter::TEXTURE_BASE_LEVEL,
-                          0);
-        GL::TexParameteri(iblCubeMap->GetTextureTarget(),
-                          GL::TexParameter::TEXTURE_MAX_LEVEL,
-                          MaxMipLevels - 1);
 
-        for (uint mipMapLevel = 0; mipMapLevel < MaxMipLevels; ++mipMapLevel)
-        {
-            const float mipMapLevelF = SCAST<float>(mipMapLevel);
-            const uint mipSize =
-                SCAST<uint>(IBLCubeMapSize * Math::Pow(0.5f, mipMapLevelF));
-
-            const float roughness =
-                SCAST<float>(mipMapLevel) / (MaxMipLevels - 1);
-            cmg->m_iblShaderProgram->SetFloat("B_InputRoughness", roughness);
-
-            GL::SetViewport(0, 0, mipSize, mipSize);
-            cmg->m_iblFramebuffer->SetAttachmentTexture(
-                iblCubeMap, GL::Attachment::COLOR0, mipMapLevel);
-            cmg->m_iblFramebuffer->SetAllDrawBuffers();
-            GEngine::GetInstance()->RenderViewportPlane();
-        }
-    }
+    // Draw to the cubemap level
+    const uint mipSize = iblCubeMap->GetMipMapSize(mipMapLevel);
+    GL::SetViewport(0, 0, mipSize, mipSize);
+    cmg->m_iblFramebuffer->SetAttachmentTexture(
+        iblCubeMap, GL::Attachment::COLOR0, mipMapLevel);
+    cmg->m_iblFramebuffer->SetAllDrawBuffers();
+    GEngine::GetInstance()->RenderViewportPlane();
 
     cmg->m_iblFramebuffer->UnBind();
 
@@ -141,8 +196,6 @@ AH<TextureCubeMap> CubeMapIBLGenerator::GenerateIBLCubeMap(
     GL::Pop(GL::BindTarget::SHADER_PROGRAM);
     GL::Pop(GL::BindTarget::TEXTURE_CUBE_MAP);
     GL::Pop(GL::Pushable::FRAMEBUFFER_AND_READ_DRAW_ATTACHMENTS);
-
-    return iblCubeMapAH;
 }
 
 CubeMapIBLGenerator *CubeMapIBLGenerator::GetInstance()
@@ -18,6 +18,7 @@
 #include "Bang/Debug.h"
 #include "Bang/FontSheetCreator.h"
 #include "Bang/GL.h"
+#include "Bang/Image.h"
 #include "Bang/Math.h"
 #include "Bang/MetaNode.h"
 #include "Bang/Path.h"
@@ -27,6 +28,10 @@
 
 using namespace Bang;
 
+constexpr int Font::SDFGlyphSize;
+constexpr int Font::SDFSpread;
+constexpr int Font::AtlasPageSize;
+
 Font::Font()
 {
 }
@@ -60,33 +65,9 @@ void Font::Import(const Path &ttfFilepath)
         m_referenceFontDataCache.lineSkip =
             float(TTF_FontLineSkip(GetReferenceFont()));
 
-        unsigned int c = 0;
-        while (c <= 255)
-        {
-            int minx, maxx, miny, maxy, advance;
-            TTF_GlyphMetrics(GetReferenceFont(),
-                             SCAST<unsigned char>(c),
-                             &minx,
-                             &maxx,
-                             &miny,
-                             &maxy,
-                             &advance);
-
-            GlyphMetrics cm;
-            cm.size = Vector2((maxx - minx), (maxy - miny));
-            cm.bearing = Vector2(minx, maxy);
-            cm.advance = float(advance);
-
-            if (c == ' ')
-            {
-                cm.size =
-                    Vector2(cm.advance, m_referenceFontDataCache.lineSkip);
-            }
-
-            m_referenceFontDataCache.charMetrics.Add(SCAST<unsigned char>(c),
-                                                     cm);
-            ++c;
-        }
+        m_sdfFont = TTF_OpenFont(m_ttfFilepath.GetAbsolute().ToCString(),
+                                 Font::SDFGlyphSize);
+        CatchTTFError();
     }
     else
     {
@@ -136,45 +117,70 @@ Vector2 Font::ScaleMagnitude(int fontSize, const Vector2 &magnitude)
     return Vector2::Round(magnitude * GetScaleProportion(fontSize));
 }
 
-Texture2D *Font::GetFontAtlas(int fontSize) const
+Texture2D *Font::GetFontAtlas() const
 {
-    if (!HasFontSizeLoaded(fontSize))
+    if (!m_atlasTexture)
     {
-        // Create atlas
-        Array<AARecti> charRects;
-        AH<Texture2D> atlasTex = Assets::Create<Texture2D>();
-        String chars = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"
-                       "0123456789.,-;:_?!+*#<>[]{}@$%&=/\\()|\"'";
-
-        FontSheetCreator::LoadAtlasTexture(
-            GetTTFFont(fontSize), atlasTex.Get(), chars, &charRects, 1);
-
-        m_cachedAtlas[fontSize] = atlasTex;
-        m_cachedAtlasChars[fontSize] = chars;
-        for (uint i = 0; i < chars.Size() && i < charRects.Size(); ++i)
-        {
-            m_cachedAtlasCharRects[fontSize].Add(chars[i], charRects[i]);
-        }
-
-        atlasTex.Get()->SetFilterMode(GL::FilterMode::NEAREST);
+        // Single channel, the distance is all the text shaders read
+        const int numPixels = (Font::AtlasPageSize * Font::AtlasPageSize);
+        Array<Byte> clearPixels(numPixels, 0);
+
+        m_atlasTexture = Assets::Create<Texture2D>();
+        Texture2D *atlasTex = m_atlasTexture.Get();
+        atlasTex->SetFormat(GL::ColorFormat::R8);
+        atlasTex->Fill(clearPixels.Data(),
+                       Font::AtlasPageSize,
+                       Font::AtlasPageSize,
+                       GL::ColorComp::RED,
+                       GL::DataType::UNSIGNED_BYTE);
+        atlasTex->SetWrapMode(GL::WrapMode::CLAMP_TO_EDGE);
+        atlasTex->SetFilterMode(GL::FilterMode::BILINEAR);
+
+        m_atlasPacker = AtlasPacker(Vector2i(Font::AtlasPageSize), 1);
+        m_atlasCharRects.Clear();
     }
+    return m_atlasTexture.Get();
+}
 
-    return m_cachedAtlas.Get(fontSize).Get();
+uint Font::GetAtlasGeneration() const
+{
+    return m_atlasGeneration;
 }
 
-Font::GlyphMetrics Font::GetCharMetrics(int fontSize, char c) const
+Font::GlyphMetrics Font::GetCharMetrics(int fontSize, uint c) const
 {
     Font::GlyphMetrics cm;
-    if (!GetReferenceFont())
+    if (!HasCharacter(c))
     {
         return cm;
     }
-    if (!m_referenceFontDataCache.charMetrics.ContainsKey(c))
+
+    UMap<uint, GlyphMetrics> &charMetrics =
+        m_referenceFontDataCache.charMetrics;
+    if (!charMetrics.ContainsKey(c))
     {
-        return cm;
+        int minx, maxx, miny, maxy, advance;
+        TTF_GlyphMetrics(GetReferenceFont(),
+                         SCAST<Uint16>(c),
+                         &minx,
+                         &maxx,
+                         &miny,
+                         &maxy,
+                         &advance);
+
+        GlyphMetrics refCm;
+        refCm.size = Vector2((maxx - minx), (maxy - miny));
+        refCm.bearing = Vector2(minx, maxy);
+        refCm.advance = float(advance);
+        if (c == ' ')
+        {
+            refCm.size =
+                Vector2(refCm.advance, m_referenceFontDataCache.lineSkip);
+        }
+        charMetrics.Add(c, refCm);
     }
 
-    cm = m_referenceFontDataCache.charMetrics.Get(c);
+    cm = charMetrics.Get(c);
     cm.size = ScaleMagnitude(fontSize, cm.size);
     cm.bearing = ScaleMagnitude(fontSize, cm.bearing);
     cm.advance = ScaleMagnitude(fontSize, cm.advance);
@@ -182,40 +188,28 @@ Font::GlyphMetrics Font::GetCharMetrics(int fontSize, char c) const
     return cm;
 }
 
-Vector2 Font::GetCharMaxUv(int fontSize, char c) const
+Vector2 Font::GetCharMaxUv(uint c) const
 {
-    ASSERT(HasFontSizeLoaded(fontSize));
-    if (m_cachedAtlasCharRects.Get(fontSize).ContainsKey(c))
-    {
-        return Vector2(m_cachedAtlasCharRects.Get(fontSize).Get(c).GetMax()) /
-               Vector2(m_cachedAtlas.Get(fontSize).Get()->GetSize());
-    }
-    else
-    {
-        return Vector2::Zero();
-    }
+    const AARecti *charRect = GetAtlasCharRect(c);
+    return charRect ? (Vector2(charRect->GetMax()) / float(AtlasPageSize))
+                    : Vector2::Zero();
 }
-Vector2 Font::GetCharMinUv(int fontSize, char c) const
+
+Vector2 Font::GetCharMinUv(uint c) const
 {
-    ASSERT(HasFontSizeLoaded(fontSize));
-    if (m_cachedAtlasCharRects.Get(fontSize).ContainsKey(c))
-    {
-        return Vector2(m_cachedAtlasCharRects.Get(fontSize).Get(c).GetMin()) /
-               Vector2(m_cachedAtlas.Get(fontSize).Get()->GetSize());
-    }
-    else
-    {
-        return Vector2::Zero();
-    }
+    const AARecti *charRect = GetAtlasCharRect(c);
+    return charRect ? (Vector2(charRect->GetMin()) / float(AtlasPageSize))
+                    : Vector2::Zero();
 }
 
-bool Font::HasCharacter(char c) const
+bool Font::HasCharacter(uint c) const
 {
-    return GetReferenceFont() &&
-           m_referenceFontDataCache.charMetrics.ContainsKey(c);
+    // The TTF version we use only handles the basic multilingual plane
+    return GetReferenceFont() && c <= 0xFFFF &&
+           TTF_GlyphIsProvided(GetReferenceFont(), SCAST<Uint16>(c));
 }
 
-float Font::GetKerning(int fontSize, char leftChar, char rightChar) const
+float Font::GetKerning(int fontSize, uint leftChar, uint rightChar) const
 {
     return -1;
 }
@@ -256,20 +250,69 @@ float Font::GetFontHeight(int fontSize) const
     return ScaleMagnitude(fontSize, m_referenceFontDataCache.height);
 }
 
-Vector2i Font::GetAtlasCharRectSize(int fontSize, char c) const
+Vector2i Font::GetAtlasCharRectSize(int fontSize, uint c) const
 {
-    if (!GetReferenceFont())
+    const AARecti *charRect = GetAtlasCharRect(c);
+    if (!charRect)
     {
         return Vector2i::Zero();
     }
-    GetFontAtlas(fontSize);  // Load if not loaded yet
-    const AARecti &charRect = m_cachedAtlasCharRects[fontSize][c];
-    return charRect.IsValid() ? charRect.GetSize() : Vector2i::Zero();
+
+    // The distance field scales to any size
+    const float scale = (SCAST<float>(fontSize) / Font::SDFGlyphSize);
+    return Vector2i(Vector2::Round(Vector2(charRect->GetSize()) * scale));
 }
 
-bool Font::HasFontSizeLoaded(int fontSize) const
+const AARecti *Font::GetAtlasCharRect(uint c) const
 {
-    return GetReferenceFont() && m_cachedAtlas.ContainsKey(fontSize);
+    Texture2D *atlasTex = GetFontAtlas();
+    if (m_atlasCharRects.ContainsKey(c))
+    {
+        m_atlasPacker.Touch(c);
+        return &m_atlasCharRects.Get(c);
+    }
+
+    const Image glyphImage = FontSheetCreator::RenderGlyph(GetSDFFont(), c);
+    if (glyphImage.GetWidth() <= 0 || glyphImage.GetHeight() <= 0)
+    {
+        return nullptr;
+    }
+
+    const Image sdfImage =
+        FontSheetCreator::CreateSDF(glyphImage, Font::SDFSpread);
+    AARecti sdfRect;
+    Array<uint> evictedChars;
+    if (!m_atlasPacker.Insert(c, sdfImage.GetSize(), &sdfRect, &evictedChars))
+    {
+        return nullptr;
+    }
+
+    for (uint evictedChar : evictedChars)
+    {
+        m_atlasCharRects.Remove(evictedChar);
+    }
+    if (!evictedChars.IsEmpty())
+    {
+        ++m_atlasGeneration;
+    }
+
+    // The distance is in the alpha of the SDF image
+    const int numSDFPixels = (sdfImage.GetWidth() * sdfImage.GetHeight());
+    Array<Byte> sdfDistances(numSDFPixels);
+    for (int i = 0; i < numSDFPixels; ++i)
+    {
+        sdfDistances[i] = sdfImage.GetData()[i * 4 + 3];
+    }
+    atlasTex->FillRegion(sdfDistances.Data(),
+                         sdfRect,
+                         GL::ColorComp::RED,
+                         GL::DataType::UNSIGNED_BYTE);
+
+    // The char rect is the glyph cell, without the distance field padding
+    const AARecti charRect(sdfRect.GetMin() + Vector2i(Font::SDFSpread),
+                           sdfRect.GetMax() - Vector2i(Font::SDFSpread));
+    m_atlasCharRects.Add(c, charRect);
+    return &m_atlasCharRects.Get(c);
 }
 
 TTF_Font *Font::GetReferenceFont() const
@@ -277,28 +320,27 @@ TTF_Font *Font::GetReferenceFont() const
     return m_referenceFont;
 }
 
-TTF_Font *Font::GetTTFFont(int fontSize) const
+TTF_Font *Font::GetSDFFont() const
 {
-    if (!m_openFonts.ContainsKey(fontSize))
-    {
-        ClearTTFError();
-        TTF_Font *font =
-            TTF_OpenFont(m_ttfFilepath.GetAbsolute().ToCString(), fontSize);
-        CatchTTFError();
-
-        m_openFonts[fontSize] = font;
-    }
-
-    return m_openFonts.Get(fontSize);
+    return m_sdfFont;
 }
 
 void Font::Free()
 {
-    for (const auto &it : m_openFonts)
+    for (TTF_Font **ttfFont : {&m_referenceFont, &m_sdfFont})
     {
-        ClearTTFError();
-        TTF_CloseFont(it.second);
-        CatchTTFError();
+        if (*ttfFont)
+        {
+            ClearTTFError();
+            TTF_CloseFont(*ttfFont);
+            CatchTTFError();
+            *ttfFont = nullptr;
+        }
     }
-    m_openFonts.Clear();
+
+    m_referenceFontDataCache.charMetrics.Clear();
+    m_atlasTexture.Set(nullptr);
+    m_atlasCharRects.Clear();
+    m_atlasPacker.Clear();
+    ++m_atlasGeneration;
 }
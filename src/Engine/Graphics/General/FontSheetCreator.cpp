@@ -1,5 +1,7 @@
 #include "Bang/FontSheetCreator.h"
 
+#include <algorithm>
+
 #include <SDL_pixels.h>
 #include <SDL_stdinc.h>
 #include <SDL_surface.h>
@@ -17,80 +19,177 @@
 
 using namespace Bang;
 
-bool FontSheetCreator::LoadAtlasTexture(TTF_Font *ttfFont,
-                                        Texture2D *atlasTexture,
-                                        const String &charsToLoad,
-                                        Array<AARecti> *imagesOutputRects,
-                                        int extraMargin)
+namespace
+{
+constexpr float EDTInfinity = 1e20f;
+
+// Squared euclidean distance transform of a sampled function, from
+// "Distance Transforms of Sampled Functions" (Felzenszwalb, Huttenlocher)
+void DistanceTransform1D(const float *f,
+                         float *d,
+                         int n,
+                         Array<int> *vBuffer,
+                         Array<float> *zBuffer)
 {
-    if (!ttfFont)
+    int *v = vBuffer->Data();
+    float *z = zBuffer->Data();
+
+    int k = 0;
+    v[0] = 0;
+    z[0] = -EDTInfinity;
+    z[1] = EDTInfinity;
+    auto intersection = [f](int q, int p) {
+        return ((f[q] + q * q) - (f[p] + p * p)) / (2 * q - 2 * p);
+    };
+
+    for (int q = 1; q < n; ++q)
     {
-        return false;
+        float s = intersection(q, v[k]);
+        while (s <= z[k])
+        {
+            --k;
+            s = intersection(q, v[k]);
+        }
+
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = EDTInfinity;
     }
 
-    Array<Image> charImages;
-    for (const char c : charsToLoad)
+    k = 0;
+    for (int q = 0; q < n; ++q)
     {
-        if (TTF_GlyphIsProvided(ttfFont, c))
+        while (z[k + 1] < q)
         {
-            // Create bitmap
-            constexpr SDL_Color WhiteColor = {255, 255, 255, 255};
-            TTF_SetFontHinting(ttfFont, TTF_HINTING_LIGHT);
-            SDL_Surface *charBitmap =
-                TTF_RenderGlyph_Blended(ttfFont, c, WhiteColor);
-            if (!charBitmap)
-            {
-                continue;
-            }
+            ++k;
+        }
+        d[q] = (q - v[k]) * (q - v[k]) + f[v[k]];
+    }
+}
 
-            SDL_PixelFormat *fmt = charBitmap->format;
-            Uint32 *charPixels = SCAST<Uint32 *>(charBitmap->pixels);
-            Image charImage(charBitmap->w, charBitmap->h);
-            for (int y = 0; y < charBitmap->h; ++y)
-            {
-                for (int x = 0; x < charBitmap->w; ++x)
-                {
-                    Uint32 color32 = charPixels[y * charBitmap->w + x];
-                    Uint32 alpha = ((color32 & fmt->Amask) >> fmt->Ashift)
-                                   << fmt->Aloss;
-                    Color pxColor = Color::Zero();
-                    pxColor.a = (alpha / 255.0f);
-                    charImage.SetPixel(x, y, pxColor);
-                }
-            }
-            // charImage.Export( Path("Char_" + String(int(c)) + "_" +
-            // String(charBitmap->w) + ".png") );
+// In place. Cells must be 0 at the seeds and EDTInfinity elsewhere
+void DistanceTransform2D(Array<float> *grid, int width, int height)
+{
+    const int maxSide = Math::Max(width, height);
+    Array<float> f(maxSide), d(maxSide), z(maxSide + 1);
+    Array<int> v(maxSide);
 
-            charImages.PushBack(charImage);
-            SDL_FreeSurface(charBitmap);
+    for (int x = 0; x < width; ++x)
+    {
+        for (int y = 0; y < height; ++y)
+        {
+            f[y] = grid->At(y * width + x);
         }
-        else
+        DistanceTransform1D(f.Data(), d.Data(), height, &v, &z);
+        for (int y = 0; y < height; ++y)
         {
-            Image empty;
-            empty.Create(1, 1, Color::Zero());
-            charImages.PushBack(empty);
+            grid->At(y * width + x) = d[y];
         }
     }
 
-    // Resize the atlas to fit only the used area
-    Image atlasImage = FontSheetCreator::PackImages(
-        charImages, extraMargin, imagesOutputRects);
-    // atlasImage.Export(Path("font_" + String(atlasImage.GetWidth()) +
-    // ".png"));
+    for (int y = 0; y < height; ++y)
+    {
+        float *row = grid->Data() + (y * width);
+        DistanceTransform1D(row, d.Data(), width, &v, &z);
+        std::copy(d.Data(), d.Data() + width, row);
+    }
+}
+}  // namespace
 
-    if (atlasTexture)  // Create final atlas texture
+Image FontSheetCreator::RenderGlyph(TTF_Font *ttfFont, uint codepoint)
+{
+    // The TTF version we use only handles the basic multilingual plane
+    if (!ttfFont || codepoint > 0xFFFF ||
+        !TTF_GlyphIsProvided(ttfFont, SCAST<Uint16>(codepoint)))
     {
-        GL::PixelStore(GL::UNPACK_ALIGNMENT, 1);
-        atlasTexture->Import(atlasImage);
-        atlasTexture->SetWrapMode(GL::WrapMode::CLAMP_TO_EDGE);
-        atlasTexture->SetFilterMode(GL::FilterMode::NEAREST);
-        atlasTexture->SetAlphaCutoff(0.5f);
-        atlasTexture->Bind();
-        atlasTexture->GenerateMipMaps();
-        atlasTexture->UnBind();
+        return Image();
     }
 
-    return true;
+    constexpr SDL_Color WhiteColor = {255, 255, 255, 255};
+    TTF_SetFontHinting(ttfFont, TTF_HINTING_LIGHT);
+    SDL_Surface *glyphBitmap = TTF_RenderGlyph_Blended(
+        ttfFont, SCAST<Uint16>(codepoint), WhiteColor);
+    if (!glyphBitmap)
+    {
+        return Image();
+    }
+
+    SDL_LockSurface(glyphBitmap);
+    const SDL_PixelFormat *fmt = glyphBitmap->format;
+    Image glyphImage;
+    glyphImage.Create(
+        glyphBitmap->w, glyphBitmap->h, Color::White().WithAlpha(0.0f));
+    Byte *glyphPixels = glyphImage.GetData();
+    for (int y = 0; y < glyphBitmap->h; ++y)
+    {
+        const Uint32 *bitmapRow = RCAST<const Uint32 *>(
+            SCAST<const Byte *>(glyphBitmap->pixels) + y * glyphBitmap->pitch);
+        for (int x = 0; x < glyphBitmap->w; ++x)
+        {
+            const Uint32 color32 = bitmapRow[x];
+            const Uint32 alpha = ((color32 & fmt->Amask) >> fmt->Ashift)
+                                 << fmt->Aloss;
+            glyphPixels[(y * glyphBitmap->w + x) * 4 + 3] = SCAST<Byte>(alpha);
+        }
+    }
+    SDL_UnlockSurface(glyphBitmap);
+    SDL_FreeSurface(glyphBitmap);
+
+    return glyphImage;
+}
+
+Image FontSheetCreator::CreateSDF(const Image &glyphImage, int spread)
+{
+    spread = Math::Max(spread, 1);
+    const int width = glyphImage.GetWidth() + spread * 2;
+    const int height = glyphImage.GetHeight() + spread * 2;
+    const uint numPixels = SCAST<uint>(width * height);
+
+    // Coverage of the padded image, and distances to the nearest pixel
+    // inside and outside the glyph
+    Array<float> coverage(numPixels, 0.0f);
+    const Byte *glyphPixels = glyphImage.GetData();
+    for (int y = 0; y < glyphImage.GetHeight(); ++y)
+    {
+        for (int x = 0; x < glyphImage.GetWidth(); ++x)
+        {
+            const Byte a = glyphPixels[(y * glyphImage.GetWidth() + x) * 4 + 3];
+            coverage[(y + spread) * width + (x + spread)] = (a / 255.0f);
+        }
+    }
+
+    Array<float> distToInside(numPixels), distToOutside(numPixels);
+    for (uint i = 0; i < numPixels; ++i)
+    {
+        const bool inside = (coverage[i] >= 0.5f);
+        distToInside[i] = (inside ? 0.0f : EDTInfinity);
+        distToOutside[i] = (inside ? EDTInfinity : 0.0f);
+    }
+    DistanceTransform2D(&distToInside, width, height);
+    DistanceTransform2D(&distToOutside, width, height);
+
+    Image sdfImage;
+    sdfImage.Create(width, height, Color::White().WithAlpha(0.0f));
+    Byte *sdfPixels = sdfImage.GetData();
+    for (uint i = 0; i < numPixels; ++i)
+    {
+        // Distance to the edge, which lies between the pixel centers of
+        // the inside and outside pixels. Partially covered pixels know
+        // their distance to the edge better, from the coverage itself
+        const float cov = coverage[i];
+        float dist = (cov >= 0.5f) ? -(Math::Sqrt(distToOutside[i]) - 0.5f)
+                                   : (Math::Sqrt(distToInside[i]) - 0.5f);
+        if (cov > 0.0f && cov < 1.0f)
+        {
+            dist = (0.5f - cov);
+        }
+
+        const float value =
+            Math::Clamp(0.5f - dist / (2.0f * spread), 0.0f, 1.0f);
+        sdfPixels[i * 4 + 3] = SCAST<Byte>(Math::Round(value * 255.0f));
+    }
+    return sdfImage;
 }
 
 Image FontSheetCreator::PackImages(const Array<Image> &images,
@@ -182,6 +182,13 @@ void GL::Init()
     SetGLContextValue(&GL::m_boundReadFramebufferIds, 0u);
     SetGLContextValue(&GL::m_boundShaderProgramIds, 0u);
     SetGLContextValue(&GL::m_boundUniformBufferIds, 0u);
+    m_activeTextureUnit = 0;
+    m_boundTextureIdsPerUnit.Resize(GL::GetInteger(
+        SCAST<GL::Enum>(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS)));
+    for (std::array<GLId, 4> &unitTextureIds : m_boundTextureIdsPerUnit)
+    {
+        unitTextureIds = {{0u, 0u, 0u, 0u}};
+    }
     SetGLContextValue(&GL::m_colorMasks, {{true, true, true, true}});
     SetGLContextValue(&GL::m_lineWidths, 0.0f);
     SetGLContextValue(&GL::m_stencilValues, SCAST<Byte>(0));
@@ -269,11 +276,19 @@ Vector3 GL::GetCubeMapDirVector(GL::CubeMapDir cmDir)
 
 void GL::ClearError()
 {
-    glGetError();
+    if (!GL::IsBatchedErrorChecking())
+    {
+        glGetError();
+    }
 }
 
 bool GL::CheckError(int line, const String &func, const String &file)
 {
+    if (GL::IsBatchedErrorChecking())
+    {
+        return true;
+    }
+
     bool ok = true;
     while (true)
     {
@@ -298,6 +313,52 @@ bool GL::CheckError(int line, const String &func, const String &file)
     return ok;
 }
 
+void GL::SetBatchedErrorChecking(bool batchedErrorChecking)
+{
+    GL *gl = GL::GetInstance();
+    ASSERT(gl);
+    if (batchedErrorChecking != gl->m_batchedErrorChecking)
+    {
+        // Do not blame the first pass for the errors of before
+        glGetError();
+        gl->m_batchedErrorChecking = batchedErrorChecking;
+    }
+}
+
+bool GL::IsBatchedErrorChecking()
+{
+    GL *gl = GL::GetInstance();
+    return gl && gl->m_batchedErrorChecking;
+}
+
+bool GL::CheckPassErrors(const String &passName)
+{
+    // Without batching, errors have already been checked call by call
+    if (!GL::IsBatchedErrorChecking())
+    {
+        return true;
+    }
+
+    bool ok = true;
+    while (true)
+    {
+        GLenum glError = glGetError();
+        if (glError == GL_NO_ERROR)
+        {
+            break;
+        }
+
+        const char *err =
+            reinterpret_cast<const char *>(gluErrorString(glError));
+        Debug_Error("OpenGL error \"" << String(err).ToUpper()
+                                      << "\" during pass \""
+                                      << passName
+                                      << "\"");
+        ok = false;
+    }
+    return ok;
+}
+
 bool GL::CheckFramebufferError()
 {
     const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
@@ -456,7 +517,7 @@ void GL::VertexAttribPointer(int location,
 
 void GL::PolygonMode(GL::Face face, GL::Enum mode)
 {
-    if (GL::GetPolygonMode(face) != mode)
+    if (GL::CountStateCall(GL::GetPolygonMode(face) != mode))
     {
         switch (face)
         {
@@ -503,7 +564,7 @@ void GL::UnMapBuffer(GL::BindTarget target)
 
 void GL::BlendColor(const Color &blendColor)
 {
-    if (blendColor != GL::GetBlendColor())
+    if (GL::CountStateCall(blendColor != GL::GetBlendColor()))
     {
         SetGLContextValue(&GL::m_blendColors, blendColor);
         GL_CALL(glBlendColor(
@@ -545,10 +606,10 @@ void GL::BlendFuncSeparate(GL::BlendFactor srcFactorColor,
                            GL::BlendFactor srcFactorAlpha,
                            GL::BlendFactor dstFactorAlpha)
 {
-    if (srcFactorColor != GL::GetBlendSrcFactorColor() ||
-        dstFactorColor != GL::GetBlendDstFactorColor() ||
-        srcFactorAlpha != GL::GetBlendSrcFactorAlpha() ||
-        dstFactorAlpha != GL::GetBlendDstFactorAlpha())
+    if (GL::CountStateCall(srcFactorColor != GL::GetBlendSrcFactorColor() ||
+                           dstFactorColor != GL::GetBlendDstFactorColor() ||
+                           srcFactorAlpha != GL::GetBlendSrcFactorAlpha() ||
+                           dstFactorAlpha != GL::GetBlendDstFactorAlpha()))
     {
         SetGLContextValue(&GL::m_blendSrcFactorColors, srcFactorColor);
         SetGLContextValue(&GL::m_blendDstFactorColors, dstFactorColor);
@@ -569,8 +630,9 @@ void GL::BlendEquation(GL::BlendEquationE blendEquation)
 void GL::BlendEquationSeparate(GL::BlendEquationE blendEquationColor,
                                GL::BlendEquationE blendEquationAlpha)
 {
-    if (blendEquationColor != GL::GetBlendEquationColor() ||
-        blendEquationAlpha != GL::GetBlendEquationAlpha())
+    if (GL::CountStateCall(
+            blendEquationColor != GL::GetBlendEquationColor() ||
+            blendEquationAlpha != GL::GetBlendEquationAlpha()))
     {
         SetGLContextValue(&GL::m_blendEquationColors, blendEquationColor);
         SetGLContextValue(&GL::m_blendEquationAlphas, blendEquationAlpha);
@@ -594,8 +656,18 @@ void GL::SetEnabled(GL::Enablable glEnablable, bool enabled)
     GL *gl = GL::GetInstance();
     ASSERT(gl);
 
+    // Indexable ones are redundant only if all their indices match
     bool canBeIndexed = (GL::CanEnablableBeIndexed(glEnablable));
-    if (enabled != GL::IsEnabled(glEnablable) || canBeIndexed)
+    bool changed = (enabled != GL::IsEnabled(glEnablable));
+    if (canBeIndexed)
+    {
+        for (int i = 1; i < GL::GetEnablableIndexMax(glEnablable); ++i)
+        {
+            changed |= (enabled != GL::IsEnabledi(glEnablable, i));
+        }
+    }
+
+    if (GL::CountStateCall(changed))
     {
         if (enabled)
         {
@@ -625,7 +697,7 @@ void GL::SetEnabledi(GL::Enablable glEnablable, int i, bool enabled)
 {
     ASSERT(i >= 0 && i <= GL::GetEnablableIndexMax(glEnablable));
 
-    if (enabled != GL::IsEnabledi(glEnablable, i))
+    if (GL::CountStateCall(enabled != GL::IsEnabledi(glEnablable, i)))
     {
         if (enabled)
         {
@@ -740,7 +812,7 @@ void GL::Scissor(int x, int y, int width, int height)
 
 void GL::Scissor(const AARecti &scissorRectPx)
 {
-    if (scissorRectPx != GL::GetScissorRect())
+    if (GL::CountStateCall(scissorRectPx != GL::GetScissorRect()))
     {
         if (scissorRectPx.IsValid())
         {
@@ -791,6 +863,12 @@ bool GL::CompileShader(GLId shaderId)
     return ok;
 }
 
+String GL::GetString(GLenum glEnum)
+{
+    GL_CALL(const GLubyte *str = glGetString(glEnum));
+    return str ? String(RCAST<const char *>(str)) : String();
+}
+
 int GL::GetShaderInteger(GLId shaderId, GL::Enum glEnum)
 {
     int v = false;
@@ -904,6 +982,72 @@ void GL::DeleteProgram(GLId programId)
     GL_CALL(glDeleteProgram(programId));
 }
 
+bool GL::IsProgramBinarySupported()
+{
+    return (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary) &&
+           GL::GetInteger(SCAST<GL::Enum>(GL_NUM_PROGRAM_BINARY_FORMATS)) > 0;
+}
+
+bool GL::IsProgramBinaryFormatSupported(GLenum binaryFormat)
+{
+    const int numFormats =
+        GL::GetInteger(SCAST<GL::Enum>(GL_NUM_PROGRAM_BINARY_FORMATS));
+    if (numFormats <= 0)
+    {
+        return false;
+    }
+
+    Array<int> formats(numFormats);
+    GL::GetInteger(SCAST<GL::Enum>(GL_PROGRAM_BINARY_FORMATS), formats.Data());
+    return formats.Contains(SCAST<int>(binaryFormat));
+}
+
+void GL::SetProgramBinaryRetrievable(GLId programId, bool retrievable)
+{
+    GL_CALL(glProgramParameteri(programId,
+                                GL_PROGRAM_BINARY_RETRIEVABLE_HINT,
+                                retrievable ? GL_TRUE : GL_FALSE));
+}
+
+bool GL::GetProgramBinary(GLId programId,
+                          GLenum *binaryFormat,
+                          Array<Byte> *binary)
+{
+    const int binaryLength = GL::GetProgramInteger(
+        programId, SCAST<GL::Enum>(GL_PROGRAM_BINARY_LENGTH));
+    if (binaryLength <= 0)
+    {
+        return false;
+    }
+
+    GLsizei writtenLength = 0;
+    binary->Resize(binaryLength);
+    GL_CALL(glGetProgramBinary(programId,
+                               binaryLength,
+                               &writtenLength,
+                               binaryFormat,
+                               binary->Data()));
+    binary->Resize(writtenLength);
+    return (writtenLength > 0);
+}
+
+bool GL::ProgramBinary(GLId programId,
+                       GLenum binaryFormat,
+                       const Array<Byte> &binary)
+{
+    // A format that is not supported anymore would be an INVALID_ENUM, so it
+    // is checked beforehand. Any other binary rejected by the driver (after
+    // an update...) is not an error, just a link failure
+    if (!GL::IsProgramBinaryFormatSupported(binaryFormat))
+    {
+        return false;
+    }
+
+    GL_CALL(glProgramBinary(
+        programId, binaryFormat, binary.Data(), binary.Size()));
+    return GL::GetProgramInteger(programId, GL::LINK_STATUS);
+}
+
 void GL::FramebufferTexture(GL::FramebufferTarget target,
                             GL::Attachment attachment,
                             GLId textureId,
@@ -1281,10 +1425,11 @@ void GL::TexImage2D(GL::TextureTarget textureTarget,
                     GL::ColorFormat textureColorFormat,
                     GL::ColorComp inputDataColorComp,
                     GL::DataType inputDataType,
-                    const void *data)
+                    const void *data,
+                    uint mipMapLevel)
 {
     GL_CALL(glTexImage2D(GLCAST(textureTarget),
-                         0,
+                         mipMapLevel,
                          GLCAST(textureColorFormat),
                          textureWidth,
                          textureHeight,
@@ -1294,6 +1439,24 @@ void GL::TexImage2D(GL::TextureTarget textureTarget,
                          data));
 }
 
+void GL::CompressedTexImage2D(GL::TextureTarget textureTarget,
+                              uint textureWidth,
+                              uint textureHeight,
+                              GLenum compressedFormat,
+                              uint dataSize,
+                              const void *data,
+                              uint mipMapLevel)
+{
+    GL_CALL(glCompressedTexImage2D(GLCAST(textureTarget),
+                                   mipMapLevel,
+                                   compressedFormat,
+                                   textureWidth,
+                                   textureHeight,
+                                   0,
+                                   dataSize,
+                                   data));
+}
+
 void GL::TexImage3D(GL::TextureTarget textureTarget,
                     uint textureWidth,
                     uint textureHeight,
@@ -1325,6 +1488,27 @@ void GL::TexImage3D(GL::TextureTarget textureTarget,
                          data));
 }
 
+void GL::TexSubImage2D(GL::TextureTarget textureTarget,
+                       uint offsetX,
+                       uint offsetY,
+                       uint width,
+                       uint height,
+                       GL::ColorComp inputDataColorComp,
+                       GL::DataType inputDataType,
+                       const void *data,
+                       uint mipMapLevel)
+{
+    GL_CALL(glTexSubImage2D(GLCAST(textureTarget),
+                            mipMapLevel,
+                            offsetX,
+                            offsetY,
+                            width,
+                            height,
+                            GLCAST(inputDataColorComp),
+                            GLCAST(inputDataType),
+                            data));
+}
+
 void GL::TexSubImage3D(GL::TextureTarget textureTarget,
                        uint offsetX,
                        uint offsetY,
@@ -1400,10 +1584,11 @@ void GL::GetTexImage(GL::TextureTarget textureTarget,
 void GL::GetTexImage(GL::TextureTarget textureTarget,
                      GL::ColorComp colorComp,
                      GL::DataType dataType,
-                     void *pixels)
+                     void *pixels,
+                     uint mipMapLevel)
 {
     GL_CALL(glGetTexImage(GLCAST(textureTarget),
-                          0,
+                          mipMapLevel,
                           GLCAST(colorComp),
                           GLCAST(dataType),
                           SCAST<void *>(pixels)));
@@ -1462,12 +1647,30 @@ void GL::GetInteger(GL::Enum glEnum, int *values)
 void GL::ActiveTexture(int activeTexture)
 {
     ASSERT(activeTexture >= GL_TEXTURE0);
-    GL_CALL(glActiveTexture(activeTexture));
+
+    GL *gl = GL::GetInstance();
+    ASSERT(gl);
+
+    const int textureUnit = (activeTexture - GL_TEXTURE0);
+    ASSERT(textureUnit < gl->m_boundTextureIdsPerUnit.Size());
+    if (GL::CountStateCall(textureUnit != gl->m_activeTextureUnit))
+    {
+        gl->m_activeTextureUnit = textureUnit;
+        GL_CALL(glActiveTexture(activeTexture));
+
+        // The bound texture ids are the ones of the active unit
+        const std::array<GLId, 4> &unitTextureIds =
+            gl->m_boundTextureIdsPerUnit[textureUnit];
+        SetGLContextValue(&GL::m_boundTexture1DIds, unitTextureIds[0]);
+        SetGLContextValue(&GL::m_boundTexture2DIds, unitTextureIds[1]);
+        SetGLContextValue(&GL::m_boundTexture3DIds, unitTextureIds[2]);
+        SetGLContextValue(&GL::m_boundTextureCubeMapIds, unitTextureIds[3]);
+    }
 }
 
 void GL::LineWidth(float lineWidth)
 {
-    if (GL::GetLineWidth() != lineWidth)
+    if (GL::CountStateCall(GL::GetLineWidth() != lineWidth))
     {
         SetGLContextValue(&GL::m_lineWidths, lineWidth);
         GL_CALL(glLineWidth(lineWidth));
@@ -1507,6 +1710,8 @@ void GL::GenBuffers(int n, GLId *glIds)
 void GL::DeleteFramebuffers(int n, const GLId *glIds)
 {
     GL::OnDeletedGLObjects(GL::BindTarget::FRAMEBUFFER, n, glIds);
+    GL::OnDeletedGLObjects(GL::BindTarget::DRAW_FRAMEBUFFER, n, glIds);
+    GL::OnDeletedGLObjects(GL::BindTarget::READ_FRAMEBUFFER, n, glIds);
     GL_CALL(glDeleteFramebuffers(n, glIds));
 }
 
@@ -1522,6 +1727,24 @@ void GL::DeleteTextures(int n, const GLId *glIds)
     GL::OnDeletedGLObjects(GL::BindTarget::TEXTURE_3D, n, glIds);
     GL::OnDeletedGLObjects(GL::BindTarget::TEXTURE_CUBE_MAP, n, glIds);
     GL_CALL(glDeleteTextures(n, glIds));
+
+    // Deleted textures are unbound from all the units, and their ids can be
+    // reused, so forget them in the cached bindings of the other units too
+    GL *gl = GL::GetInstance();
+    ASSERT(gl);
+    for (std::array<GLId, 4> &unitTextureIds : gl->m_boundTextureIdsPerUnit)
+    {
+        for (GLId &unitTextureId : unitTextureIds)
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                if (unitTextureId == glIds[i])
+                {
+                    unitTextureId = 0;
+                }
+            }
+        }
+    }
 }
 
 void GL::DeleteVertexArrays(int n, const GLId *glIds)
@@ -1532,6 +1755,8 @@ void GL::DeleteVertexArrays(int n, const GLId *glIds)
 
 void GL::DeleteBuffers(int n, const GLId *glIds)
 {
+    GL::OnDeletedGLObjects(GL::BindTarget::ARRAY_BUFFER, n, glIds);
+    GL::OnDeletedGLObjects(GL::BindTarget::UNIFORM_BUFFER, n, glIds);
     GL_CALL(glDeleteBuffers(n, glIds));
 }
 
@@ -1570,7 +1795,7 @@ void GL::SetViewport(const AARecti &viewport)
 void GL::SetViewport(int x, int y, int width, int height)
 {
     AARecti vpRect(Vector2i(x, y), Vector2i(x + width, y + height));
-    if (GL::GetViewportRect() != vpRect)
+    if (GL::CountStateCall(GL::GetViewportRect() != vpRect))
     {
         SetGLContextValue(&GL::m_viewportRects, vpRect);
         GL_CALL(glViewport(x, y, width, height));
@@ -1581,6 +1806,11 @@ void GL::SetViewport(int x, int y, int width, int height)
 
 AARecti GL::GetViewportRect()
 {
+    // Headless (no context), the UI layouts can still be calculated
+    if (!GL::GetInstance())
+    {
+        return AARecti::Zero();
+    }
     return GetGLContextValue(&GL::m_viewportRects);
 }
 
@@ -1813,6 +2043,34 @@ void GL::Bind(const GLObject *bindable)
 
 void GL::Bind(GL::BindTarget bindTarget, GLId glId)
 {
+    bool alreadyBound = false;
+    switch (bindTarget)
+    {
+        case GL::BindTarget::FRAMEBUFFER:
+            alreadyBound =
+                (GL::IsBound(GL::BindTarget::DRAW_FRAMEBUFFER, glId) &&
+                 GL::IsBound(GL::BindTarget::READ_FRAMEBUFFER, glId));
+            break;
+
+        // Part of the VAO state, so it is not known after a VAO bind
+        case GL::BindTarget::ELEMENT_ARRAY_BUFFER: break;
+
+        default: alreadyBound = GL::IsBound(bindTarget, glId); break;
+    }
+
+    if (!GL::CountStateCall(!alreadyBound))
+    {
+        return;
+    }
+
+    const int textureTargetIndex = GL::GetTextureTargetIndex(bindTarget);
+    if (textureTargetIndex >= 0)
+    {
+        GL *gl = GL::GetInstance();
+        gl->m_boundTextureIdsPerUnit[gl->m_activeTextureUnit]
+                                    [textureTargetIndex] = glId;
+    }
+
     switch (bindTarget)
     {
         case GL::BindTarget::TEXTURE_1D:
@@ -1832,10 +2090,6 @@ void GL::Bind(GL::BindTarget bindTarget, GLId glId)
             GL_CALL(glBindTexture(GLCAST(bindTarget), glId));
             break;
         case GL::BindTarget::SHADER_PROGRAM:
-            if (GL::IsBound(bindTarget, glId))
-            {
-                return;
-            }
             SetGLContextValue(&GL::m_boundShaderProgramIds, glId);
             GL_CALL(glUseProgram(glId));
             break;
@@ -1853,10 +2107,6 @@ void GL::Bind(GL::BindTarget bindTarget, GLId glId)
             GL_CALL(glBindFramebuffer(GLCAST(bindTarget), glId));
             break;
         case GL::BindTarget::VAO:
-            if (GL::IsBound(bindTarget, glId))
-            {
-                return;
-            }
             SetGLContextValue(&GL::m_boundVAOIds, glId);
             GL_CALL(glBindVertexArray(glId));
             break;
@@ -1898,7 +2148,7 @@ void GL::SetColorMask(bool maskR, bool maskG, bool maskB, bool maskA)
 {
     GL *gl = GL::GetInstance();
     std::array<bool, 4> newColorMask = {{maskR, maskG, maskB, maskA}};
-    if (!gl || (GL::GetColorMask() != newColorMask))
+    if (!gl || GL::CountStateCall(GL::GetColorMask() != newColorMask))
     {
         SetGLContextValue(&GL::m_colorMasks, newColorMask);
         GL_CALL(glColorMask(maskR, maskG, maskB, maskA));
@@ -1927,8 +2177,9 @@ void GL::SetStencilFunc(GL::Function stencilFunction,
                         Byte stencilValue,
                         uint mask)
 {
-    if (stencilFunction != GL::GetStencilFunc() ||
-        stencilValue != GL::GetStencilValue() || mask != GL::GetStencilMask())
+    if (GL::CountStateCall(stencilFunction != GL::GetStencilFunc() ||
+                           stencilValue != GL::GetStencilValue() ||
+                           mask != GL::GetStencilMask()))
     {
         SetGLContextValue(&GL::m_stencilFuncs, stencilFunction);
         SetGLContextValue(&GL::m_stencilValues, stencilValue);
@@ -1939,7 +2190,7 @@ void GL::SetStencilFunc(GL::Function stencilFunction,
 
 void GL::SetStencilOp(GL::StencilOperation zPass)
 {
-    if (GL::GetStencilOp() != zPass)
+    if (GL::CountStateCall(GL::GetStencilOp() != zPass))
     {
         GL::SetStencilOp(
             GL::StencilOperation::KEEP, GL::StencilOperation::KEEP, zPass);
@@ -1953,7 +2204,7 @@ void GL::SetStencilValue(Byte value)
 
 void GL::SetDepthMask(bool writeDepth)
 {
-    if (GL::GetInstance()->GetDepthMask() != writeDepth)
+    if (GL::CountStateCall(GL::GetDepthMask() != writeDepth))
     {
         SetGLContextValue(&GL::m_depthMasks, writeDepth);
         GL_CALL(glDepthMask(writeDepth));
@@ -1962,7 +2213,7 @@ void GL::SetDepthMask(bool writeDepth)
 
 void GL::SetDepthFunc(GL::Function depthFunc)
 {
-    if (GL::GetDepthFunc() != depthFunc)
+    if (GL::CountStateCall(GL::GetDepthFunc() != depthFunc))
     {
         SetGLContextValue(&GL::m_depthFuncs, depthFunc);
         GL_CALL(glDepthFunc(GLCAST(depthFunc)));
@@ -1971,7 +2222,7 @@ void GL::SetDepthFunc(GL::Function depthFunc)
 
 void GL::SetCullFace(GL::Face cullFace)
 {
-    if (GL::GetCullFace() != cullFace)
+    if (GL::CountStateCall(GL::GetCullFace() != cullFace))
     {
         SetGLContextValue(&GL::m_cullFaces, cullFace);
         GL_CALL(glCullFace(GLCAST(cullFace)));
@@ -2234,6 +2485,8 @@ GLId GL::GetBoundId(GL::BindTarget bindTarget)
             return GetGLContextValue(&GL::m_boundVBOArrayBufferIds);
         case GL::BindTarget::ELEMENT_ARRAY_BUFFER:
             return GetGLContextValue(&GL::m_boundVBOElementsBufferIds);
+        case GL::BindTarget::UNIFORM_BUFFER:
+            return GetGLContextValue(&GL::m_boundUniformBufferIds);
         case GL::BindTarget::SHADER_PROGRAM:
             return GetGLContextValue(&GL::m_boundShaderProgramIds);
         default: ASSERT(false);
@@ -2247,6 +2500,59 @@ bool GL::IsBound(GL::BindTarget bindTarget, GLId glId)
     return GL::GetBoundId(bindTarget) == glId;
 }
 
+int GL::GetTextureTargetIndex(GL::BindTarget textureTarget)
+{
+    switch (textureTarget)
+    {
+        case GL::BindTarget::TEXTURE_1D: return 0;
+        case GL::BindTarget::TEXTURE_2D: return 1;
+        case GL::BindTarget::TEXTURE_3D: return 2;
+        case GL::BindTarget::TEXTURE_CUBE_MAP: return 3;
+        default: break;
+    }
+    return -1;
+}
+
+bool GL::CountStateCall(bool issued)
+{
+    if (GL *gl = GL::GetInstance())
+    {
+        if (issued)
+        {
+            ++gl->m_numIssuedStateCalls;
+        }
+        else
+        {
+            ++gl->m_numSkippedStateCalls;
+        }
+    }
+    return issued;
+}
+
+uint GL::GetNumIssuedStateCalls()
+{
+    GL *gl = GL::GetInstance();
+    return gl ? gl->m_lastFrameNumIssuedStateCalls : 0;
+}
+
+uint GL::GetNumSkippedStateCalls()
+{
+    GL *gl = GL::GetInstance();
+    return gl ? gl->m_lastFrameNumSkippedStateCalls : 0;
+}
+
+void GL::EndFrame()
+{
+    GL_CheckPassErrors("EndFrame");
+
+    GL *gl = GL::GetInstance();
+    ASSERT(gl);
+    gl->m_lastFrameNumIssuedStateCalls = gl->m_numIssuedStateCalls;
+    gl->m_lastFrameNumSkippedStateCalls = gl->m_numSkippedStateCalls;
+    gl->m_numIssuedStateCalls = 0;
+    gl->m_numSkippedStateCalls = 0;
+}
+
 uint GL::GetPixelBytesSize(GL::ColorFormat texFormat)
 {
     switch (texFormat)
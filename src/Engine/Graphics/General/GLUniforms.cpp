@@ -38,6 +38,7 @@ const String GLUniforms::UniformName_MetalnessTexture = "B_MetalnessTexture";
 const String GLUniforms::UniformName_NormalMapTexture = "B_NormalMapTexture";
 const String GLUniforms::UniformName_HasNormalMapTexture =
     "B_HasNormalMapTexture";
+const String GLUniforms::UniformName_NormalMapIsRG = "B_NormalMapIsRG";
 const String GLUniforms::UniformName_TimeSeconds = "B_TimeSeconds";
 const String GLUniforms::UniformName_Model = "B_Model";
 const String GLUniforms::UniformName_ModelInv = "B_ModelInv";
@@ -1,11 +1,60 @@
 #include "Bang/Image.h"
 
+#include <cstring>
+
 #include "Bang/AARect.h"
+#include "Bang/Array.tcc"
 #include "Bang/Debug.h"
 #include "Bang/ImageIO.h"
 
 namespace Bang
 {
+namespace
+{
+constexpr int BytesPerPixel = 4;
+
+Byte ColorCompToByte(float colorComp)
+{
+    return SCAST<Byte>(colorComp * 255);
+}
+
+void CopyPixel(const Byte *srcPixel, Byte *dstPixel)
+{
+    std::memcpy(dstPixel, srcPixel, BytesPerPixel);
+}
+
+// Copies a rect of rows between two RGBA8 buffers, clipping it to both
+void CopyRect(const Byte *src,
+              const Vector2i &srcSize,
+              const Vector2i &srcPos,
+              Byte *dst,
+              const Vector2i &dstSize,
+              const Vector2i &dstPos,
+              const Vector2i &copySize)
+{
+    const Vector2i offset = Vector2i::Max(-srcPos, -dstPos);
+    const Vector2i begin = Vector2i::Max(offset, Vector2i::Zero());
+    const Vector2i end = Vector2i::Min(
+        copySize, Vector2i::Min(srcSize - srcPos, dstSize - dstPos));
+    if (begin.x >= end.x || begin.y >= end.y)
+    {
+        return;
+    }
+
+    const std::size_t rowBytes = (end.x - begin.x) * BytesPerPixel;
+    for (int y = begin.y; y < end.y; ++y)
+    {
+        const std::size_t srcCoord =
+            ((srcPos.y + y) * srcSize.x + (srcPos.x + begin.x));
+        const std::size_t dstCoord =
+            ((dstPos.y + y) * dstSize.x + (dstPos.x + begin.x));
+        std::memcpy(dst + dstCoord * BytesPerPixel,
+                    src + srcCoord * BytesPerPixel,
+                    rowBytes);
+    }
+}
+}  // namespace
+
 Image::Image()
 {
 }
@@ -24,12 +73,15 @@ void Image::Create(int width, int height)
 void Image::Create(int width, int height, const Color &backgroundColor)
 {
     Create(width, height);
-    for (int i = 0; i < GetHeight(); ++i)
+
+    const Byte bgPixel[BytesPerPixel] = {ColorCompToByte(backgroundColor.r),
+                                         ColorCompToByte(backgroundColor.g),
+                                         ColorCompToByte(backgroundColor.b),
+                                         ColorCompToByte(backgroundColor.a)};
+    Byte *pixels = GetData();
+    for (std::size_t i = 0; i < m_pixels.Size(); i += BytesPerPixel)
     {
-        for (int j = 0; j < GetWidth(); ++j)
-        {
-            SetPixel(j, i, backgroundColor);
-        }
+        CopyPixel(bgPixel, pixels + i);
     }
 }
 
@@ -37,16 +89,13 @@ Image Image::GetSubImage(const AARecti &subCoords) const
 {
     Vector2i subSize = subCoords.GetSize();
     Image subImage(subSize.x, subSize.y);
-    for (int y = 0; y < subSize.y; ++y)
-    {
-        for (int x = 0; x < subSize.x; ++x)
-        {
-            subImage.SetPixel(
-                x,
-                y,
-                GetPixel(x + subCoords.GetMin().x, y + subCoords.GetMin().y));
-        }
-    }
+    CopyRect(GetData(),
+             GetSize(),
+             subCoords.GetMin(),
+             subImage.GetData(),
+             subImage.GetSize(),
+             Vector2i::Zero(),
+             subSize);
     return subImage;
 }
 
@@ -59,19 +108,28 @@ void Image::Copy(const Image &image,
                  const AARecti &dstRect,
                  ImageResizeMode resizeMode)
 {
-    Image resizedImage = image;
-
-    Vector2i dstSize = dstRect.GetSize();
-    resizedImage.Resize(dstSize, resizeMode);
-    for (int y = 0; y < dstSize.y; ++y)
+    const Vector2i dstSize = dstRect.GetSize();
+    if (image.GetSize() == dstSize)
     {
-        for (int x = 0; x < dstSize.x; ++x)
-        {
-            SetPixel(dstRect.GetMin().x + x,
-                     dstRect.GetMin().y + y,
-                     resizedImage.GetPixel(x, y));
-        }
+        CopyRect(image.GetData(),
+                 image.GetSize(),
+                 Vector2i::Zero(),
+                 GetData(),
+                 GetSize(),
+                 dstRect.GetMin(),
+                 dstSize);
+        return;
     }
+
+    Image resizedImage = image;
+    resizedImage.Resize(dstSize, resizeMode);
+    CopyRect(resizedImage.GetData(),
+             resizedImage.GetSize(),
+             Vector2i::Zero(),
+             GetData(),
+             GetSize(),
+             dstRect.GetMin(),
+             dstSize);
 }
 
 void Image::Copy(const Image &image,
@@ -79,6 +137,18 @@ void Image::Copy(const Image &image,
                  const AARecti &dstCopyRect,
                  ImageResizeMode resizeMode)
 {
+    if (srcCopyRect.GetSize() == dstCopyRect.GetSize())
+    {
+        CopyRect(image.GetData(),
+                 image.GetSize(),
+                 srcCopyRect.GetMin(),
+                 GetData(),
+                 GetSize(),
+                 dstCopyRect.GetMin(),
+                 dstCopyRect.GetSize());
+        return;
+    }
+
     Image subImageSrc = image.GetSubImage(srcCopyRect);
     subImageSrc.Resize(dstCopyRect.GetSize(), resizeMode);
     Copy(subImageSrc, dstCopyRect);
@@ -171,52 +241,75 @@ void Image::Resize(int _newWidth,
         return;
     }
 
-    // Now do the resizing
+    // Now do the resizing. The source ranges of each destination column and
+    // row are computed once, and then the bytes are averaged directly
     Image original = *this;
-
-    Vector2 sizeProp(original.GetWidth() / SCAST<float>(newSize.x),
-                     original.GetHeight() / SCAST<float>(newSize.y));
-
-    Create(newSize.x, newSize.y);
-    for (int y = 0; y < newSize.y; ++y)
-    {
-        for (int x = 0; x < newSize.x; ++x)
+    const Vector2i oriSize = original.GetSize();
+    Vector2 sizeProp(oriSize.x / SCAST<float>(newSize.x),
+                     oriSize.y / SCAST<float>(newSize.y));
+
+    auto ComputeRanges = [resizeMode](int newLength,
+                                      int oriLength,
+                                      float prop,
+                                      Array<int> *rangeBegins,
+                                      Array<int> *rangeEnds) {
+        rangeBegins->Resize(newLength);
+        rangeEnds->Resize(newLength);
+        for (int i = 0; i < newLength; ++i)
         {
-            Color newColor;
             if (resizeMode == ImageResizeMode::NEAREST)
             {
                 // Pick nearest original pixel
-                Vector2 oriCoord = Vector2(x, y) * sizeProp;
-                int nearestX = Math::Round(oriCoord.x);
-                int nearestY = Math::Round(oriCoord.y);
-                newColor = original.GetPixel(nearestX, nearestY);
+                const int nearest = Math::Clamp(
+                    SCAST<int>(Math::Round(i * prop)), 0, oriLength - 1);
+                (*rangeBegins)[i] = nearest;
+                (*rangeEnds)[i] = nearest + 1;
             }
             else
             {
                 // Average all the original pixels mapping to this resized px
-                Vector2 oriTopLeftF = Vector2(x, y) * sizeProp;
-                Vector2 oriBotRightF = Vector2(x + 1, y + 1) * sizeProp;
-                Vector2i oriTopLeft(Math::Floor(oriTopLeftF.x),
-                                    Math::Floor(oriTopLeftF.y));
-                oriTopLeft = Vector2i::Max(oriTopLeft, Vector2i::Zero());
-                Vector2i oriBotRight(Math::Ceil(oriBotRightF.x),
-                                     Math::Ceil(oriBotRightF.y));
-                oriBotRight = Vector2i::Min(oriBotRight, original.GetSize());
-
-                newColor = Color::Zero();
-                for (int oriY = oriTopLeft.y; oriY < oriBotRight.y; ++oriY)
+                (*rangeBegins)[i] =
+                    Math::Max(SCAST<int>(Math::Floor(i * prop)), 0);
+                (*rangeEnds)[i] = Math::Min(
+                    SCAST<int>(Math::Ceil((i + 1) * prop)), oriLength);
+            }
+        }
+    };
+
+    Array<int> xBegins, xEnds, yBegins, yEnds;
+    ComputeRanges(newSize.x, oriSize.x, sizeProp.x, &xBegins, &xEnds);
+    ComputeRanges(newSize.y, oriSize.y, sizeProp.y, &yBegins, &yEnds);
+
+    Create(newSize.x, newSize.y);
+    const Byte *oriPixels = original.GetData();
+    Byte *newPixels = GetData();
+    for (int y = 0; y < newSize.y; ++y)
+    {
+        for (int x = 0; x < newSize.x; ++x)
+        {
+            uint sum[BytesPerPixel] = {0, 0, 0, 0};
+            for (int oriY = yBegins[y]; oriY < yEnds[y]; ++oriY)
+            {
+                const Byte *oriRow =
+                    oriPixels + (oriY * oriSize.x * BytesPerPixel);
+                for (int oriX = xBegins[x]; oriX < xEnds[x]; ++oriX)
                 {
-                    for (int oriX = oriTopLeft.x; oriX < oriBotRight.x; ++oriX)
+                    const Byte *oriPixel = oriRow + (oriX * BytesPerPixel);
+                    for (int c = 0; c < BytesPerPixel; ++c)
                     {
-                        newColor += original.GetPixel(oriX, oriY);
+                        sum[c] += oriPixel[c];
                     }
                 }
+            }
 
-                int pixels = (oriBotRight.x - oriTopLeft.x) *
-                             (oriBotRight.y - oriTopLeft.y);
-                newColor /= Math::Max(pixels, 1);
+            const uint numPixels = Math::Max(
+                (xEnds[x] - xBegins[x]) * (yEnds[y] - yBegins[y]), 1);
+            Byte *newPixel = newPixels + ((y * newSize.x + x) * BytesPerPixel);
+            for (int c = 0; c < BytesPerPixel; ++c)
+            {
+                newPixel[c] =
+                    SCAST<Byte>((sum[c] + numPixels / 2) / numPixels);
             }
-            SetPixel(x, y, newColor);
         }
     }
 }
@@ -229,8 +322,11 @@ Image Image::Rotated90DegreesRight() const
     {
         for (int x = 0; x < GetWidth(); ++x)
         {
-            result.SetPixel(
-                GetHeight() - y - 1, GetWidth() - x - 1, GetPixel(x, y));
+            const int dstX = GetHeight() - y - 1;
+            const int dstY = GetWidth() - x - 1;
+            CopyPixel(GetData() + (y * GetWidth() + x) * BytesPerPixel,
+                      result.GetData() +
+                          (dstY * result.GetWidth() + dstX) * BytesPerPixel);
         }
     }
     return result;
@@ -244,8 +340,11 @@ Image Image::Rotated180DegreesRight() const
     {
         for (int x = 0; x < GetWidth(); ++x)
         {
-            result.SetPixel(
-                GetWidth() - x - 1, GetHeight() - y - 1, GetPixel(x, y));
+            const int dstX = GetWidth() - x - 1;
+            const int dstY = GetHeight() - y - 1;
+            CopyPixel(GetData() + (y * GetWidth() + x) * BytesPerPixel,
+                      result.GetData() +
+                          (dstY * result.GetWidth() + dstX) * BytesPerPixel);
         }
     }
     return result;
@@ -259,7 +358,9 @@ Image Image::Rotated270DegreesRight() const
     {
         for (int x = 0; x < GetWidth(); ++x)
         {
-            result.SetPixel(y, x, GetPixel(x, y));
+            CopyPixel(GetData() + (y * GetWidth() + x) * BytesPerPixel,
+                      result.GetData() +
+                          (x * result.GetWidth() + y) * BytesPerPixel);
         }
     }
     return result;
@@ -267,14 +368,16 @@ Image Image::Rotated270DegreesRight() const
 
 void Image::FillTransparentPixels(const Color &color)
 {
-    for (int y = 0; y < GetHeight(); ++y)
+    const Byte fillPixel[BytesPerPixel] = {ColorCompToByte(color.r),
+                                           ColorCompToByte(color.g),
+                                           ColorCompToByte(color.b),
+                                           ColorCompToByte(color.a)};
+    Byte *pixels = GetData();
+    for (std::size_t i = 0; i < m_pixels.Size(); i += BytesPerPixel)
     {
-        for (int x = 0; x < GetWidth(); ++x)
+        if (pixels[i + 3] == 0)
         {
-            if (GetPixel(x, y).a == 0)
-            {
-                SetPixel(x, y, color);
-            }
+            CopyPixel(fillPixel, pixels + i);
         }
     }
 }
@@ -293,11 +396,11 @@ void Image::SetPixel(int x, int y, const Color &color)
 {
     ASSERT_MSG(x >= 0 && y >= 0 && x < GetWidth() && y < GetHeight(),
                "Pixel (" << x << ", " << y << ") out of bounds");
-    const int coord = (y * GetWidth() + x) * 4;
-    m_pixels[coord + 0] = SCAST<Byte>(color.r * 255);
-    m_pixels[coord + 1] = SCAST<Byte>(color.g * 255);
-    m_pixels[coord + 2] = SCAST<Byte>(color.b * 255);
-    m_pixels[coord + 3] = SCAST<Byte>(color.a * 255);
+    const int coord = (y * GetWidth() + x) * BytesPerPixel;
+    m_pixels[coord + 0] = ColorCompToByte(color.r);
+    m_pixels[coord + 1] = ColorCompToByte(color.g);
+    m_pixels[coord + 2] = ColorCompToByte(color.b);
+    m_pixels[coord + 3] = ColorCompToByte(color.a);
 }
 
 Color Image::GetPixel(int x, int y) const
@@ -329,13 +432,12 @@ const Vector2i &Image::GetSize() const
 Image Image::InvertedVertically()
 {
     Image img = *this;
+    const std::size_t rowBytes = GetWidth() * BytesPerPixel;
     for (int y = 0; y < GetHeight(); ++y)
     {
-        for (int x = 0; x < GetWidth(); ++x)
-        {
-            Color c = GetPixel(x, y);
-            img.SetPixel(x, GetHeight() - y - 1, c);
-        }
+        std::memcpy(img.GetData() + (GetHeight() - y - 1) * rowBytes,
+                    GetData() + y * rowBytes,
+                    rowBytes);
     }
     return img;
 }
@@ -345,10 +447,12 @@ Image Image::InvertedHorizontally()
     Image img = *this;
     for (int y = 0; y < GetHeight(); ++y)
     {
+        const Byte *srcRow = GetData() + (y * GetWidth()) * BytesPerPixel;
+        Byte *dstRow = img.GetData() + (y * GetWidth()) * BytesPerPixel;
         for (int x = 0; x < GetWidth(); ++x)
         {
-            Color c = GetPixel(x, y);
-            img.SetPixel(GetWidth() - x - 1, y, c);
+            CopyPixel(srcRow + x * BytesPerPixel,
+                      dstRow + (GetWidth() - x - 1) * BytesPerPixel);
         }
     }
     return img;
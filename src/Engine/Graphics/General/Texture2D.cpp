@@ -11,6 +11,8 @@
 #include "Bang/MetaNode.tcc"
 #include "Bang/Path.h"
 #include "Bang/StreamOperators.h"
+#include "Bang/TextureCompressionCache.h"
+#include "Bang/TextureCompressor.h"
 
 using namespace Bang;
 
@@ -35,9 +37,7 @@ void Texture2D::OnFormatChanged()
     {
         if (GetAssetFilepath().IsFile())
         {
-            Image img;
-            ImageIO::Import(GetAssetFilepath(), &img);
-            Import(img);
+            ImportFromFile(GetAssetFilepath());
         }
     }
 }
@@ -75,6 +75,7 @@ void Texture2D::Fill(const Byte *newData,
 {
     SetWidth(width);
     SetHeight(height);
+    m_compressedBytesSize = 0;
 
     GL::Push(GetGLBindTarget());
 
@@ -97,6 +98,89 @@ void Texture2D::Fill(const Byte *newData,
     PropagateAssetChanged();
 }
 
+void Texture2D::FillRegion(const Byte *newData,
+                           const AARecti &region,
+                           GL::ColorComp inputDataColorComp,
+                           GL::DataType inputDataType)
+{
+    ASSERT(!IsCompressed());
+    ASSERT(region.GetMin() >= Vector2i::Zero() &&
+           region.GetMax() <= GetSize());
+
+    GL::Push(GetGLBindTarget());
+
+    Bind();
+    GL::PixelStore(GL::UNPACK_ALIGNMENT, 1);
+    GL::TexSubImage2D(GetTextureTarget(),
+                      region.GetMin().x,
+                      region.GetMin().y,
+                      region.GetWidth(),
+                      region.GetHeight(),
+                      inputDataColorComp,
+                      inputDataType,
+                      newData);
+
+    GL::Pop(GetGLBindTarget());
+}
+
+void Texture2D::FillCompressed(const Array<CompressedMipMap> &mipMaps,
+                               TextureCompression compression)
+{
+    ASSERT(!mipMaps.IsEmpty());
+
+    SetWidth(mipMaps.Front().size.x);
+    SetHeight(mipMaps.Front().size.y);
+
+    const bool sRGB = (GetFormat() == GL::ColorFormat::SRGB ||
+                       GetFormat() == GL::ColorFormat::SRGBA);
+    const GLenum glFormat =
+        TextureCompressor::GetGLInternalFormat(compression, sRGB);
+
+    GL::Push(GetGLBindTarget());
+
+    Bind();
+    m_compressedBytesSize = 0;
+    for (uint i = 0; i < mipMaps.Size(); ++i)
+    {
+        const CompressedMipMap &mipMap = mipMaps[i];
+        GL::CompressedTexImage2D(GetTextureTarget(),
+                                 mipMap.size.x,
+                                 mipMap.size.y,
+                                 glFormat,
+                                 mipMap.data.Size(),
+                                 mipMap.data.Data(),
+                                 i);
+        m_compressedBytesSize += mipMap.data.Size();
+    }
+
+    GL::Pop(GetGLBindTarget());
+
+    PropagateAssetChanged();
+}
+
+void Texture2D::SetCompression(TextureCompression compression)
+{
+    if (compression != GetCompression())
+    {
+        m_compression = compression;
+        if (GetAssetFilepath().IsFile())
+        {
+            ImportFromFile(GetAssetFilepath());
+        }
+        PropagateAssetChanged();
+    }
+}
+
+TextureCompression Texture2D::GetCompression() const
+{
+    return m_compression;
+}
+
+bool Texture2D::IsCompressed() const
+{
+    return (m_compressedBytesSize > 0);
+}
+
 void Texture2D::SetAlphaCutoff(float alphaCutoff)
 {
     if (alphaCutoff != GetAlphaCutoff())
@@ -161,6 +245,10 @@ void Texture2D::SetHeight(int height)
 
 uint Texture2D::GetBytesSize() const
 {
+    if (IsCompressed())
+    {
+        return m_compressedBytesSize;
+    }
     return GetWidth() * GetHeight() * GL::GetPixelBytesSize(GetFormat());
 }
 
@@ -170,9 +258,8 @@ Image Texture2D::ToImage() const
     const int height = GetHeight();
     Image img(width, height);
 
-    const int numComps = GL::GetNumComponents(GL::ColorComp::RGBA);
-    Byte *pixels = new Byte[width * height * numComps];
-
+    // Read back straight into the image pixels, which are RGBA8 too
+    Byte *pixels = img.GetData();
     GL::Push(GL::BindTarget::TEXTURE_2D);
     Bind();
     GL::GetTexImage(GetTextureTarget(),
@@ -181,22 +268,15 @@ Image Texture2D::ToImage() const
                     pixels);
     GL::Pop(GL::BindTarget::TEXTURE_2D);
 
-    for (int y = 0; y < height; ++y)
+    if (GetColorComp() == GL::ColorComp::RED)
     {
-        for (int x = 0; x < width; ++x)
+        for (int i = 0; i < width * height * 4; i += 4)
         {
-            const int i = (y * width + x) * numComps;
-            Color pixelColor = GetColorFromByteArray(pixels, i);
-            if (GetColorComp() == GL::ColorComp::RED)
-            {
-                pixelColor = Color(pixelColor.r, pixelColor.r, pixelColor.r, 1);
-            }
-            img.SetPixel(x, y, pixelColor);
+            pixels[i + 1] = pixels[i + 2] = pixels[i + 0];
+            pixels[i + 3] = 255;
         }
     }
 
-    delete[] pixels;
-
     return img;
 }
 
@@ -234,6 +314,11 @@ void Texture2D::ImportMeta(const MetaNode &metaNode)
     {
         SetAlphaCutoff(metaNode.Get<float>("AlphaCutoff"));
     }
+
+    if (metaNode.Contains("Compression"))
+    {
+        SetCompression(metaNode.Get<TextureCompression>("Compression"));
+    }
 }
 
 void Texture2D::ExportMeta(MetaNode *metaNode) const
@@ -246,14 +331,70 @@ void Texture2D::ExportMeta(MetaNode *metaNode) const
     metaNode->Set("WrapModeT", GetWrapMode(GL::WrapCoord::WRAP_T));
     metaNode->Set("WrapModeR", GetWrapMode(GL::WrapCoord::WRAP_R));
     metaNode->Set("AlphaCutoff", GetAlphaCutoff());
+    metaNode->Set("Compression", GetCompression());
 }
 
 void Texture2D::Import(const Path &imageFilepath)
 {
-    ImageIO::Import(imageFilepath, &m_image, this, nullptr);
+    // The meta is parsed once. The compression is set before importing the
+    // image, so that it is not imported twice when the meta sets it
+    const Path metaFilepath = MetaFilesManager::GetMetaFilepath(imageFilepath);
+    const bool hasMeta = metaFilepath.IsFile();
+    MetaNode metaNode;
+    if (hasMeta)
+    {
+        metaNode.Import(metaFilepath);
+    }
+    m_compression = Texture2D::GetCompressionFromMeta(metaNode);
 
-    Path importFilepath = MetaFilesManager::GetMetaFilepath(imageFilepath);
-    ImportMetaFromFile(importFilepath);
+    if (m_hasPreImportedImage)
+    {
+        if (!m_preImportedCompressedMipMaps.IsEmpty())
+        {
+            ImportCompressed(m_preImportedImage,
+                             m_preImportedCompressedMipMaps);
+        }
+        else
+        {
+            Import(m_preImportedImage);
+        }
+        m_preImportedImage = Image();
+        m_preImportedCompressedMipMaps.Clear();
+        m_hasPreImportedImage = false;
+    }
+    else
+    {
+        ImportFromFile(imageFilepath);
+    }
+
+    if (hasMeta)
+    {
+        ImportMeta(metaNode);
+    }
+}
+
+void Texture2D::PreImport(const Path &imageFilepath)
+{
+    // DDS textures go straight to the GPU, so they can not be pre-imported
+    if (!imageFilepath.HasExtension("dds"))
+    {
+        const TextureCompression compression =
+            Texture2D::GetCompressionFromMeta(imageFilepath);
+        if (compression != TextureCompression::NONE)
+        {
+            m_hasPreImportedImage = Texture2D::ImportCompressedMipMaps(
+                imageFilepath,
+                compression,
+                &m_preImportedImage,
+                &m_preImportedCompressedMipMaps);
+        }
+        else
+        {
+            ImageIO::Import(imageFilepath,
+                            &m_preImportedImage,
+                            &m_hasPreImportedImage);
+        }
+    }
 }
 
 void Texture2D::Import(const Image &image)
@@ -273,6 +414,77 @@ void Texture2D::Import(const Image &image)
     }
 }
 
+void Texture2D::ImportFromFile(const Path &imageFilepath)
+{
+    if (GetCompression() != TextureCompression::NONE &&
+        !imageFilepath.HasExtension("dds"))
+    {
+        Image image;
+        Array<CompressedMipMap> mipMaps;
+        if (Texture2D::ImportCompressedMipMaps(
+                imageFilepath, GetCompression(), &image, &mipMaps))
+        {
+            ImportCompressed(image, mipMaps);
+            return;
+        }
+    }
+
+    ImageIO::Import(imageFilepath, &m_image, this, nullptr);
+}
+
+void Texture2D::ImportCompressed(const Image &image,
+                                 const Array<CompressedMipMap> &mipMaps)
+{
+    m_image = image;
+    FillCompressed(mipMaps, GetCompression());
+}
+
+TextureCompression Texture2D::GetCompressionFromMeta(
+    const Path &imageFilepath)
+{
+    MetaNode metaNode;
+    metaNode.Import(MetaFilesManager::GetMetaFilepath(imageFilepath));
+    return Texture2D::GetCompressionFromMeta(metaNode);
+}
+
+TextureCompression Texture2D::GetCompressionFromMeta(const MetaNode &metaNode)
+{
+    return metaNode.Contains("Compression")
+               ? metaNode.Get<TextureCompression>("Compression")
+               : TextureCompression::NONE;
+}
+
+bool Texture2D::ImportCompressedMipMaps(const Path &imageFilepath,
+                                        TextureCompression compression,
+                                        Image *image,
+                                        Array<CompressedMipMap> *mipMaps)
+{
+    const Hash::HashType cacheHash =
+        TextureCompressionCache::GetCacheHash(imageFilepath, compression);
+    const Path cacheFilepath =
+        TextureCompressionCache::GetCacheFilepath(imageFilepath, cacheHash);
+    if (TextureCompressionCache::Read(cacheFilepath, cacheHash, mipMaps))
+    {
+        // Decoding the blocks back is way cheaper than decoding the image
+        // file, and keeps the CPU-side image available
+        const CompressedMipMap &mipMap = mipMaps->Front();
+        TextureCompressor::Decompress(
+            mipMap.data.Data(), mipMap.size, compression, image);
+        return true;
+    }
+
+    bool ok = false;
+    ImageIO::Import(imageFilepath, image, &ok);
+    if (!ok || image->GetWidth() <= 0 || image->GetHeight() <= 0)
+    {
+        return false;
+    }
+
+    TextureCompressor::CompressMipMaps(*image, compression, mipMaps);
+    TextureCompressionCache::Write(cacheFilepath, cacheHash, *mipMaps);
+    return true;
+}
+
 GL::BindTarget Texture2D::GetGLBindTarget() const
 {
     return GL::BindTarget::TEXTURE_2D;
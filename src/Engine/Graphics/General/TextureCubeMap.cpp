@@ -75,11 +75,57 @@ void TextureCubeMap::Fill(GL::CubeMapDir cubeMapDir,
     PropagateAssetChanged();
 }
 
+void TextureCubeMap::FillMipMap(GL::CubeMapDir cubeMapDir,
+                                const Byte *newData,
+                                uint mipMapLevel,
+                                GL::ColorComp inputDataColorComp,
+                                GL::DataType inputDataType)
+{
+    GL::Push(GetGLBindTarget());
+
+    Bind();
+    GL::TexImage2D(SCAST<GL::TextureTarget>(cubeMapDir),
+                   GetMipMapSize(mipMapLevel),
+                   GetMipMapSize(mipMapLevel),
+                   GetFormat(),
+                   inputDataColorComp,
+                   inputDataType,
+                   newData,
+                   mipMapLevel);
+
+    GL::Pop(GetGLBindTarget());
+
+    PropagateAssetChanged();
+}
+
+void TextureCubeMap::ReadMipMap(GL::CubeMapDir cubeMapDir,
+                                uint mipMapLevel,
+                                GL::ColorComp outputDataColorComp,
+                                GL::DataType outputDataType,
+                                Byte *outputData) const
+{
+    GL::Push(GetGLBindTarget());
+
+    Bind();
+    GL::GetTexImage(SCAST<GL::TextureTarget>(cubeMapDir),
+                    outputDataColorComp,
+                    outputDataType,
+                    outputData,
+                    mipMapLevel);
+
+    GL::Pop(GetGLBindTarget());
+}
+
 uint TextureCubeMap::GetSize() const
 {
     return m_size;
 }
 
+uint TextureCubeMap::GetMipMapSize(uint mipMapLevel) const
+{
+    return Math::Max(GetSize() >> mipMapLevel, 1u);
+}
+
 void TextureCubeMap::SetSideTexture(GL::CubeMapDir cubeMapDir, Texture2D *tex)
 {
     if (GetSideTexture(cubeMapDir).Get() != tex)
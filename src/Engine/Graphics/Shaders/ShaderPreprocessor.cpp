@@ -12,6 +12,7 @@
 using namespace Bang;
 
 const String ShaderPreprocessor::GLSLVersionString = "#version 330 core";
+const String ShaderPreprocessor::NoKeyword = "_";
 
 void ShaderPreprocessor::PreprocessCode(String *shaderSourceCode)
 {
@@ -207,6 +208,66 @@ ShaderProgramProperties ShaderPreprocessor::GetShaderProperties(
     return spProps;
 }
 
+Array<Array<String>> ShaderPreprocessor::GetMultiCompileKeywordSets(
+    const String &sourceCode)
+{
+    Array<Array<String>> keywordSets;
+    Array<String> sourceCodeLines = sourceCode.Split<Array>('\n');
+    for (const String &line : sourceCodeLines)
+    {
+        Array<String> lineParts = line.Split<Array>(' ', true);
+        lineParts.RemoveAll("");
+        if (lineParts.Size() >= 3 && lineParts[0] == "#pragma" &&
+            lineParts[1] == "multi_compile")
+        {
+            Array<String> keywordSet;
+            for (uint i = 2; i < lineParts.Size(); ++i)
+            {
+                const String &keyword = lineParts[i];
+                if (!keywordSet.Contains(keyword))
+                {
+                    keywordSet.PushBack(keyword);
+                }
+            }
+
+            if (!keywordSet.IsEmpty() && !keywordSets.Contains(keywordSet))
+            {
+                keywordSets.PushBack(keywordSet);
+            }
+        }
+    }
+    return keywordSets;
+}
+
+void ShaderPreprocessor::AddDefines(String *shaderSourceCode,
+                                    const Array<String> &keywords)
+{
+    String definesCode = "";
+    for (const String &keyword : keywords)
+    {
+        if (keyword != ShaderPreprocessor::NoKeyword)
+        {
+            definesCode += "#define " + keyword + "\n";
+        }
+    }
+
+    String &code = *shaderSourceCode;
+    if (code.BeginsWith("#version"))
+    {
+        long versionLineEnd = code.IndexOf("\n");
+        if (versionLineEnd == -1)
+        {
+            code += "\n";
+            versionLineEnd = code.Size() - 1;
+        }
+        code.Insert(SCAST<int>(versionLineEnd + 1), definesCode);
+    }
+    else
+    {
+        code.Prepend(definesCode);
+    }
+}
+
 Array<String> ShaderPreprocessor::GetSectionKeywords()
 {
     const String PropertiesKeyWord = "#properties";
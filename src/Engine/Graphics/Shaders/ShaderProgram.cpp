@@ -25,6 +25,7 @@
 #include "Bang/Path.h"
 #include "Bang/Shader.h"
 #include "Bang/ShaderPreprocessor.h"
+#include "Bang/ShaderProgramBinaryCache.h"
 #include "Bang/StreamOperators.h"
 #include "Bang/Texture.h"
 #include "Bang/Texture2D.h"
@@ -37,6 +38,10 @@
 
 using namespace Bang;
 
+constexpr uint ShaderProgram::MaxNumKeywords;
+ShaderProgram::VariantStrippingFunction
+    ShaderProgram::s_variantStrippingFunction;
+
 ShaderProgram::ShaderProgram()
 {
     m_idGL = GL::CreateProgram();
@@ -97,7 +102,6 @@ bool ShaderProgram::Load(const Path &unifiedShaderPath)
             {
                 AH<Shader> shader = Assets::Create<Shader>(shaderType);
                 shader.Get()->SetSourceCode(shaderSectionSourceCode);
-                shader.Get()->CompileIfNeeded();
                 AddShader(shader.Get());
             }
         }
@@ -185,16 +189,9 @@ bool ShaderProgram::Link()
     }
 
     ASSERT(GetVertexShader()->GetType() == GL::ShaderType::VERTEX);
-    GetVertexShader()->CompileIfNeeded();
-
-    if (GetGeometryShader())
-    {
-        ASSERT(GetGeometryShader()->GetType() == GL::ShaderType::GEOMETRY);
-        GetGeometryShader()->CompileIfNeeded();
-    }
-
+    ASSERT(!GetGeometryShader() ||
+           GetGeometryShader()->GetType() == GL::ShaderType::GEOMETRY);
     ASSERT(GetFragmentShader()->GetType() == GL::ShaderType::FRAGMENT);
-    GetFragmentShader()->CompileIfNeeded();
 
     if (GetGLId() > 0)
     {
@@ -204,14 +201,58 @@ bool ShaderProgram::Link()
 
     m_idGL = GL::CreateProgram();
 
-    GL::AttachShader(GetGLId(), GetVertexShader()->GetGLId());
-    if (GetGeometryShader())
+    // A cached binary of the same sources skips compiling and linking
+    const Hash::HashType binaryCacheHash =
+        ShaderProgramBinaryCache::GetCacheHash(
+            GetVertexShader()->GetPreprocessedSourceCode(),
+            (GetGeometryShader()
+                 ? GetGeometryShader()->GetPreprocessedSourceCode()
+                 : String()),
+            GetFragmentShader()->GetPreprocessedSourceCode());
+
+    // Programs of in-memory shaders are only identified by their sources
+    Hash::HashType binaryCacheIdentityHash =
+        (IsVariant() ? m_variantIdentityHash
+                     : GetBinaryCacheIdentityHash(Array<String>()));
+    if (binaryCacheIdentityHash == 0)
     {
-        GL::AttachShader(GetGLId(), GetGeometryShader()->GetGLId());
+        binaryCacheIdentityHash = binaryCacheHash;
+    }
+
+    m_isLinked = ShaderProgramBinaryCache::Load(
+        GetGLId(), binaryCacheIdentityHash, binaryCacheHash);
+    if (!IsLinked())
+    {
+        // Start from a clean program, in case a binary was rejected
+        GL::DeleteProgram(GetGLId());
+        m_idGL = GL::CreateProgram();
+
+        GetVertexShader()->CompileIfNeeded();
+        if (GetGeometryShader())
+        {
+            GetGeometryShader()->CompileIfNeeded();
+        }
+        GetFragmentShader()->CompileIfNeeded();
+
+        GL::AttachShader(GetGLId(), GetVertexShader()->GetGLId());
+        if (GetGeometryShader())
+        {
+            GL::AttachShader(GetGLId(), GetGeometryShader()->GetGLId());
+        }
+        GL::AttachShader(GetGLId(), GetFragmentShader()->GetGLId());
+
+        if (GL::IsProgramBinarySupported())
+        {
+            GL::SetProgramBinaryRetrievable(GetGLId(), true);
+        }
+        m_isLinked = GL::LinkProgram(GetGLId());
+        if (IsLinked())
+        {
+            ShaderProgramBinaryCache::Save(
+                GetGLId(), binaryCacheIdentityHash, binaryCacheHash);
+        }
     }
-    GL::AttachShader(GetGLId(), GetFragmentShader()->GetGLId());
 
-    m_isLinked = GL::LinkProgram(GetGLId());
     if (!IsLinked())
     {
         Path vsPath = (GetVertexShader() ? GetVertexShader()->GetAssetFilepath()
@@ -245,6 +286,10 @@ bool ShaderProgram::Link()
     m_uniformCacheMatrix4.Clear();
     m_namesToTexture.Clear();
 
+    // Variants are compiled again from the new sources, when asked for
+    m_variants.Clear();
+    GatherKeywordSets();
+
     GLUniforms::GetActive()->BindUniformBuffers(this);
 
     return true;
@@ -663,6 +708,234 @@ GLint ShaderProgram::GetUniformLocation(const String &name) const
     return location;
 }
 
+ShaderProgram *ShaderProgram::GetVariant(const USet<String> &enabledKeywords)
+{
+    if (IsVariant() || GetKeywordSets().IsEmpty())
+    {
+        return this;
+    }
+
+    // No keyword is the same as the program itself
+    const uint64_t keywordsMask = GetKeywordsMask(enabledKeywords);
+    if (keywordsMask == 0)
+    {
+        return this;
+    }
+
+    if (!m_variants.ContainsKey(keywordsMask))
+    {
+        Array<String> variantKeywords;
+        for (const Array<String> &keywordSet : GetKeywordSets())
+        {
+            String setKeyword = ShaderPreprocessor::NoKeyword;
+            for (const String &keyword : keywordSet)
+            {
+                const int keywordIndex = m_keywords.IndexOf(keyword);
+                if (keywordIndex >= 0 &&
+                    (keywordsMask & (uint64_t(1) << keywordIndex)))
+                {
+                    setKeyword = keyword;
+                    break;
+                }
+            }
+            variantKeywords.PushBack(setKeyword);
+        }
+
+        // Stripped variants are kept as null, not to test them again
+        AH<ShaderProgram> variant;
+        if (!IsVariantStripped(variantKeywords))
+        {
+            variant = CreateVariant(variantKeywords);
+        }
+        m_variants.Add(keywordsMask, variant);
+    }
+
+    ShaderProgram *variant = m_variants.Get(keywordsMask).Get();
+    return (variant && variant->IsLinked()) ? variant : this;
+}
+
+uint64_t ShaderProgram::GetKeywordsMask(
+    const USet<String> &enabledKeywords) const
+{
+    // Per set, the first enabled keyword. If there is none, no keyword if
+    // the set allows it, or the first one of the set otherwise
+    uint64_t keywordsMask = 0;
+    for (const Array<String> &keywordSet : GetKeywordSets())
+    {
+        String setKeyword = "";
+        for (const String &keyword : keywordSet)
+        {
+            if (enabledKeywords.Contains(keyword))
+            {
+                setKeyword = keyword;
+                break;
+            }
+        }
+
+        if (setKeyword.IsEmpty() &&
+            !keywordSet.Contains(ShaderPreprocessor::NoKeyword))
+        {
+            setKeyword = keywordSet.Front();
+        }
+
+        const int keywordIndex = m_keywords.IndexOf(setKeyword);
+        if (keywordIndex >= 0)
+        {
+            keywordsMask |= (uint64_t(1) << keywordIndex);
+        }
+    }
+    return keywordsMask;
+}
+
+const Array<Array<String>> &ShaderProgram::GetKeywordSets() const
+{
+    return m_keywordSets;
+}
+
+bool ShaderProgram::IsVariant() const
+{
+    return m_isVariant;
+}
+
+Array<Array<String>> ShaderProgram::GetVariantsKeywords() const
+{
+    Array<Array<String>> permutations = {Array<String>()};
+    for (const Array<String> &keywordSet : GetKeywordSets())
+    {
+        Array<Array<String>> nextPermutations;
+        for (const Array<String> &permutation : permutations)
+        {
+            for (const String &keyword : keywordSet)
+            {
+                Array<String> nextPermutation = permutation;
+                nextPermutation.PushBack(keyword);
+                nextPermutations.PushBack(nextPermutation);
+            }
+        }
+        permutations = nextPermutations;
+    }
+
+    Array<Array<String>> variantsKeywords;
+    for (const Array<String> &permutation : permutations)
+    {
+        if (!IsVariantStripped(permutation))
+        {
+            variantsKeywords.PushBack(permutation);
+        }
+    }
+    return variantsKeywords;
+}
+
+void ShaderProgram::SetVariantStrippingFunction(
+    const VariantStrippingFunction &strippingFunction)
+{
+    ShaderProgram::s_variantStrippingFunction = strippingFunction;
+}
+
+void ShaderProgram::GatherKeywordSets()
+{
+    m_keywordSets.Clear();
+    m_keywords.Clear();
+    if (IsVariant())
+    {
+        return;
+    }
+
+    for (Shader *shader :
+         {GetVertexShader(), GetGeometryShader(), GetFragmentShader()})
+    {
+        if (!shader)
+        {
+            continue;
+        }
+
+        const Array<Array<String>> shaderKeywordSets =
+            ShaderPreprocessor::GetMultiCompileKeywordSets(
+                shader->GetPreprocessedSourceCode());
+        for (const Array<String> &keywordSet : shaderKeywordSets)
+        {
+            if (m_keywordSets.Contains(keywordSet))
+            {
+                continue;
+            }
+
+            Array<String> newKeywords;
+            for (const String &keyword : keywordSet)
+            {
+                if (keyword != ShaderPreprocessor::NoKeyword &&
+                    !m_keywords.Contains(keyword))
+                {
+                    newKeywords.PushBack(keyword);
+                }
+            }
+
+            if (m_keywords.Size() + newKeywords.Size() > MaxNumKeywords)
+            {
+                Debug_Warn("The shader program " << this << " has more than "
+                                                 << MaxNumKeywords
+                                                 << " keywords. Ignoring "
+                                                 << keywordSet);
+                continue;
+            }
+
+            m_keywordSets.PushBack(keywordSet);
+            m_keywords.PushBack(newKeywords.Begin(), newKeywords.End());
+        }
+    }
+}
+
+bool ShaderProgram::IsVariantStripped(
+    const Array<String> &variantKeywords) const
+{
+    return ShaderProgram::s_variantStrippingFunction &&
+           ShaderProgram::s_variantStrippingFunction(this, variantKeywords);
+}
+
+AH<ShaderProgram> ShaderProgram::CreateVariant(
+    const Array<String> &variantKeywords)
+{
+    Array<AH<Shader>> variantShaders;
+    for (Shader *shader :
+         {GetVertexShader(), GetGeometryShader(), GetFragmentShader()})
+    {
+        AH<Shader> variantShader;
+        if (shader)
+        {
+            String variantSourceCode = shader->GetSourceCode();
+            ShaderPreprocessor::AddDefines(&variantSourceCode,
+                                           variantKeywords);
+
+            variantShader = Assets::Create<Shader>(shader->GetType());
+            variantShader.Get()->SetSourceCode(variantSourceCode);
+        }
+        variantShaders.PushBack(variantShader);
+    }
+
+    AH<ShaderProgram> variant = Assets::Create<ShaderProgram>();
+    variant.Get()->m_isVariant = true;
+    variant.Get()->m_variantIdentityHash =
+        GetBinaryCacheIdentityHash(variantKeywords);
+    variant.Get()->m_loadedProperties = GetLoadedProperties();
+    variant.Get()->Load(variantShaders[0].Get(),
+                        variantShaders[1].Get(),
+                        variantShaders[2].Get());
+    return variant;
+}
+
+Hash::HashType ShaderProgram::GetBinaryCacheIdentityHash(
+    const Array<String> &variantKeywords) const
+{
+    Array<Path> shaderPaths = {GetUnifiedShaderPath()};
+    for (Shader *shader :
+         {GetVertexShader(), GetGeometryShader(), GetFragmentShader()})
+    {
+        shaderPaths.PushBack(shader ? shader->GetAssetFilepath()
+                                    : Path::Empty());
+    }
+    return ShaderProgramBinaryCache::GetIdentityHash(shaderPaths,
+                                                     variantKeywords);
+}
+
 void ShaderProgram::Reflect()
 {
     Asset::Reflect();
@@ -849,4 +1122,5 @@ void ShaderProgram::OnImported(Asset *res)
     ASSERT(res == GetVertexShader() || res == GetGeometryShader() ||
            res == GetFragmentShader());
     Link();
+    PropagateAssetChanged();
 }
@@ -1,10 +1,16 @@
 #include "Bang/ShaderProgramFactory.h"
 
+#include "Bang/Array.tcc"
 #include "Bang/Assets.h"
 #include "Bang/Assets.tcc"
+#include "Bang/Debug.h"
+#include "Bang/Extensions.h"
 #include "Bang/Map.tcc"
 #include "Bang/Paths.h"
 #include "Bang/ShaderProgram.h"
+#include "Bang/ShaderProgramBinaryCache.h"
+#include "Bang/USet.h"
+#include "Bang/USet.tcc"
 
 using namespace Bang;
 
@@ -83,6 +89,13 @@ ShaderProgram *ShaderProgramFactory::GetPointLightDeferredScreenPass()
                    "PointLightDeferred.frag"));
 }
 
+ShaderProgram *ShaderProgramFactory::GetClusteredLightsDeferredScreenPass()
+{
+    return Get(ShaderProgramFactory::GetScreenPassVertexShaderPath(),
+               ShaderProgramFactory::GetEngineShadersDir().Append(
+                   "ClusteredLightsDeferred.frag"));
+}
+
 ShaderProgram *ShaderProgramFactory::GetDecal()
 {
     return Get(
@@ -90,6 +103,27 @@ ShaderProgram *ShaderProgramFactory::GetDecal()
         ShaderProgramFactory::GetEngineShadersDir().Append("Decal.frag"));
 }
 
+ShaderProgram *ShaderProgramFactory::GetDecalsDeferredScreenPass()
+{
+    return Get(ShaderProgramFactory::GetScreenPassVertexShaderPath(),
+               ShaderProgramFactory::GetEngineShadersDir().Append(
+                   "DecalsDeferred.frag"));
+}
+
+ShaderProgram *ShaderProgramFactory::GetDecalAtlasCopy()
+{
+    return Get(ShaderProgramFactory::GetScreenPassVertexShaderPath(),
+               ShaderProgramFactory::GetEngineShadersDir().Append(
+                   "DecalAtlasCopy.frag"));
+}
+
+ShaderProgram *ShaderProgramFactory::GetUIBatch()
+{
+    return Get(
+        ShaderProgramFactory::GetEngineShadersDir().Append("UIBatch.vert"),
+        ShaderProgramFactory::GetEngineShadersDir().Append("UIBatch.frag"));
+}
+
 ShaderProgram *ShaderProgramFactory::GetKawaseBlur()
 {
     return Get(
@@ -171,6 +205,95 @@ Path ShaderProgramFactory::GetEngineShadersDir()
     return EPATH("Shaders");
 }
 
+uint ShaderProgramFactory::WarmUpBinaryCache()
+{
+    const uint prevNumHits = ShaderProgramBinaryCache::GetNumHits();
+    const uint prevNumMisses = ShaderProgramBinaryCache::GetNumMisses();
+
+    Array<ShaderProgram *> shaderPrograms = {
+        ShaderProgramFactory::GetDefault(RenderPass::SCENE_OPAQUE),
+        ShaderProgramFactory::GetDefault(RenderPass::SCENE_TRANSPARENT),
+        ShaderProgramFactory::GetDefaultPostProcess(),
+        ShaderProgramFactory::GetPointLightShadowMap(),
+        ShaderProgramFactory::GetPointLightDeferredScreenPass(),
+        ShaderProgramFactory::GetClusteredLightsDeferredScreenPass(),
+        ShaderProgramFactory::GetDecal(),
+        ShaderProgramFactory::GetDecalsDeferredScreenPass(),
+        ShaderProgramFactory::GetDecalAtlasCopy(),
+        ShaderProgramFactory::GetUIBatch(),
+        ShaderProgramFactory::GetKawaseBlur(),
+        ShaderProgramFactory::GetSeparableBlur(),
+        ShaderProgramFactory::GetSeparableBlurCubeMap(),
+        ShaderProgramFactory::GetRenderTextureToViewport(),
+        ShaderProgramFactory::GetRenderTextureToViewportGamma(),
+        ShaderProgramFactory::GetDirectionalLightShadowMap(),
+        ShaderProgramFactory::GetDirectionalLightDeferredScreenPass()};
+
+    // Loading the shader program assets is enough to link them. Keep them
+    // loaded until they are counted
+    Array<AH<ShaderProgram>> loadedShaderPrograms;
+    const Array<Path> assetsDirs = {Paths::GetEngineAssetsDir(),
+                                    Paths::GetProjectAssetsDir()};
+    for (const Path &assetsDir : assetsDirs)
+    {
+        const Array<Path> unifiedShaderPaths = assetsDir.GetFiles(
+            FindFlag::RECURSIVE, {Extensions::GetUnifiedShaderExtension()});
+        for (const Path &unifiedShaderPath : unifiedShaderPaths)
+        {
+            shaderPrograms.PushBack(
+                ShaderProgramFactory::Get(unifiedShaderPath));
+        }
+
+        const Array<Path> shaderProgramPaths = assetsDir.GetFiles(
+            FindFlag::RECURSIVE, {Extensions::GetShaderProgramExtension()});
+        for (const Path &shaderProgramPath : shaderProgramPaths)
+        {
+            loadedShaderPrograms.PushBack(
+                Assets::Load<ShaderProgram>(shaderProgramPath));
+            shaderPrograms.PushBack(loadedShaderPrograms.Back().Get());
+        }
+    }
+
+    // Plus all the keyword variants that are not stripped
+    for (uint i = 0, n = shaderPrograms.Size(); i < n; ++i)
+    {
+        if (ShaderProgram *shaderProgram = shaderPrograms[i])
+        {
+            for (const Array<String> &variantKeywords :
+                 shaderProgram->GetVariantsKeywords())
+            {
+                USet<String> enabledKeywords;
+                enabledKeywords.Add(variantKeywords.Begin(),
+                                    variantKeywords.End());
+                ShaderProgram *variant =
+                    shaderProgram->GetVariant(enabledKeywords);
+                if (variant != shaderProgram)
+                {
+                    shaderPrograms.PushBack(variant);
+                }
+            }
+        }
+    }
+
+    uint numLinked = 0;
+    for (ShaderProgram *shaderProgram : shaderPrograms)
+    {
+        if (shaderProgram && shaderProgram->IsLinked())
+        {
+            ++numLinked;
+        }
+    }
+
+    Debug_Log("Warmed up " << numLinked << " shader programs ("
+                           << (ShaderProgramBinaryCache::GetNumHits() -
+                               prevNumHits)
+                           << " binary cache hits, "
+                           << (ShaderProgramBinaryCache::GetNumMisses() -
+                               prevNumMisses)
+                           << " misses)");
+    return numLinked;
+}
+
 ShaderProgram *ShaderProgramFactory::Get(const Path &vShaderPath,
                                          const Path &gShaderPath,
                                          const Path &fShaderPath,
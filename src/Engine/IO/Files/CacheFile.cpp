@@ -0,0 +1,107 @@
+#include "Bang/CacheFile.h"
+
+#include "Bang/File.h"
+
+using namespace Bang;
+
+void CacheFile::WriteString(Array<Byte> *bytes, const String &str)
+{
+    CacheFile::WriteValue<uint>(bytes, str.Size());
+    bytes->PushBack(RCAST<const Byte *>(str.ToCString()),
+                    RCAST<const Byte *>(str.ToCString()) + str.Size());
+}
+
+void CacheFile::WriteHeader(Array<Byte> *bytes,
+                            uint magic,
+                            uint version,
+                            Hash::HashType key)
+{
+    CacheFile::WriteValue<uint>(bytes, magic);
+    CacheFile::WriteValue<uint>(bytes, version);
+    CacheFile::WriteValue<Hash::HashType>(bytes, key);
+}
+
+bool CacheFile::ReadString(const Array<Byte> &bytes,
+                           std::size_t *offset,
+                           String *str)
+{
+    uint strSize = 0;
+    if (!CacheFile::ReadValue(bytes, offset, &strSize) ||
+        *offset + strSize > bytes.Size())
+    {
+        return false;
+    }
+
+    *str = String(std::string(RCAST<const char *>(bytes.Data() + *offset),
+                              strSize));
+    *offset += strSize;
+    return true;
+}
+
+bool CacheFile::ReadHeader(const Array<Byte> &bytes,
+                           std::size_t *offset,
+                           uint magic,
+                           uint version,
+                           Hash::HashType key)
+{
+    uint readMagic = 0, readVersion = 0;
+    Hash::HashType readKey = 0;
+    return CacheFile::ReadValue(bytes, offset, &readMagic) &&
+           readMagic == magic &&
+           CacheFile::ReadValue(bytes, offset, &readVersion) &&
+           readVersion == version &&
+           CacheFile::ReadValue(bytes, offset, &readKey) && readKey == key;
+}
+
+Path CacheFile::GetFilepath(const Path &sourceFilepath,
+                            Hash::HashType key,
+                            const String &extension)
+{
+    return sourceFilepath.AppendExtension(Hash::ToHexString(key))
+        .AppendExtension(extension)
+        .WithHidden(true);
+}
+
+uint CacheFile::RemoveStaleEntries(const Path &cacheFilepath)
+{
+    if (!cacheFilepath.IsFile())
+    {
+        return 0;
+    }
+
+    // "<prefix><16 hex digits>.<ext>", where the prefix ends with a dot
+    const String cacheNameExt = cacheFilepath.GetNameExt();
+    const std::size_t keySize = Hash::ToHexString(0).Size();
+    const std::size_t extDot = cacheNameExt.RFind('.');
+    if (extDot == String::npos || extDot <= keySize ||
+        cacheNameExt[extDot - keySize - 1] != '.')
+    {
+        return 0;
+    }
+    const String prefix = cacheNameExt.SubString(0, extDot - keySize - 1);
+    const String suffix = cacheNameExt.SubString(extDot);
+
+    uint numRemoved = 0;
+    const Array<Path> siblingFilepaths =
+        cacheFilepath.GetDirectory().GetFiles(FindFlag::SIMPLE_HIDDEN);
+    for (const Path &siblingFilepath : siblingFilepaths)
+    {
+        const String siblingNameExt = siblingFilepath.GetNameExt();
+        if (siblingNameExt == cacheNameExt ||
+            siblingNameExt.Size() != cacheNameExt.Size() ||
+            !siblingNameExt.BeginsWith(prefix) ||
+            !siblingNameExt.EndsWith(suffix))
+        {
+            continue;
+        }
+
+        const String siblingKey =
+            siblingNameExt.SubString(prefix.Size(), prefix.Size() + keySize - 1);
+        if (siblingKey.IndexOfOneNotOf("0123456789abcdef") == -1 &&
+            File::Remove(siblingFilepath))
+        {
+            ++numRemoved;
+        }
+    }
+    return numRemoved;
+}
@@ -282,6 +282,33 @@ String File::GetContents(const Path &filepath)
     return contents;
 }
 
+Array<Byte> File::GetBytes(const Path &filepath)
+{
+    Array<Byte> bytes;
+    if (!filepath.IsFile())
+    {
+        return bytes;
+    }
+
+    std::ifstream ifs(filepath.GetAbsolute().ToCString(),
+                      std::ios::binary | std::ios::ate);
+    if (ifs.is_open() && ifs.good())
+    {
+        const std::streamsize bytesSize = ifs.tellg();
+        ifs.seekg(0, std::ios::beg);
+        if (bytesSize > 0)
+        {
+            bytes.Resize(SCAST<std::size_t>(bytesSize));
+            if (!ifs.read(RCAST<char *>(bytes.Data()), bytesSize))
+            {
+                bytes.Clear();
+            }
+        }
+        ifs.close();
+    }
+    return bytes;
+}
+
 String File::GetContents() const
 {
     return File::GetContents(GetPath());
@@ -19,6 +19,7 @@
 #include "Bang/Image.h"
 #include "Bang/ImageIODDS.h"
 #include "Bang/ImageIOTGA.h"
+#include "Bang/Math.h"
 #include "Bang/Path.h"
 #include "Bang/StreamOperators.h"
 #include "Bang/String.h"
@@ -271,28 +272,16 @@ void ImageIO::ExportPNG(const Path &filepath, const Image &img)
                  PNG_FILTER_TYPE_DEFAULT);
     png_write_info(png, info);
 
-    png_bytep *rowPointers = new png_bytep[img.GetHeight()];
+    // The image pixels are already RGBA8, so rows are written in place
+    Array<png_bytep> rowPointers(img.GetHeight());
+    Byte *imgData = const_cast<Byte *>(img.GetData());
     for (int y = 0; y < img.GetHeight(); y++)
     {
-        rowPointers[y] =
-            new png_byte[png_get_rowbytes(png, info) / sizeof(png_byte)];
-        for (int x = 0; x < img.GetWidth(); ++x)
-        {
-            rowPointers[y][x * 4 + 0] = SCAST<Byte>(img.GetPixel(x, y).r * 255);
-            rowPointers[y][x * 4 + 1] = SCAST<Byte>(img.GetPixel(x, y).g * 255);
-            rowPointers[y][x * 4 + 2] = SCAST<Byte>(img.GetPixel(x, y).b * 255);
-            rowPointers[y][x * 4 + 3] = SCAST<Byte>(img.GetPixel(x, y).a * 255);
-        }
+        rowPointers[y] = imgData + (y * img.GetWidth() * 4);
     }
-    png_write_image(png, rowPointers);
+    png_write_image(png, rowPointers.Data());
     png_write_end(png, NULL);
 
-    for (int y = 0; y < img.GetHeight(); y++)
-    {
-        delete[] rowPointers[y];
-    }
-    delete[] rowPointers;
-
     png_destroy_write_struct(&png, &info);
     fclose(fp);
 }
@@ -369,32 +358,20 @@ void ImageIO::ImportPNG(const Path &filepath, Image *img, bool *ok)
 
     png_read_update_info(png, info);
 
-    int height = png_get_image_height(png, info);
-    png_bytep *rowPointers = new png_bytep[height];
-    for (int y = 0; y < height; y++)
-    {
-        rowPointers[y] =
-            new png_byte[png_get_rowbytes(png, info) / sizeof(png_byte)];
-    }
-    png_read_image(png, rowPointers);
+    // After the transforms above every row is RGBA8, so libpng decodes
+    // straight into the image pixels
+    const int width = png_get_image_width(png, info);
+    const int height = png_get_image_height(png, info);
+    ASSERT(png_get_rowbytes(png, info) == SCAST<png_size_t>(width * 4));
 
-    int width = png_get_image_width(png, info);
     img->Create(width, height);
-    for (int y = 0; y < height; ++y)
+    Array<png_bytep> rowPointers(height);
+    for (int y = 0; y < height; y++)
     {
-        png_bytep row = rowPointers[y];
-        for (int x = 0; x < width; ++x)
-        {
-            Color c(row[x * 4 + 0] / 255.0f,
-                    row[x * 4 + 1] / 255.0f,
-                    row[x * 4 + 2] / 255.0f,
-                    row[x * 4 + 3] / 255.0f);
-            img->SetPixel(x, y, c);
-        }
-        delete[] row;
+        rowPointers[y] = img->GetData() + (y * width * 4);
     }
+    png_read_image(png, rowPointers.Data());
 
-    delete[] rowPointers;
     png_destroy_read_struct(&png, &info, nullptr);
     fclose(fp);
 
@@ -465,27 +442,46 @@ void ImageIO::ImportJPG(const Path &filepath, Image *img, bool *ok)
 
     jpeg_read_header(&cinfo, TRUE);
 
+    // Let libjpeg-turbo output RGBA8, so scanlines are decoded straight into
+    // the image pixels. CMYK images can not be converted by it
+    if (cinfo.jpeg_color_space != JCS_CMYK &&
+        cinfo.jpeg_color_space != JCS_YCCK)
+    {
+        cinfo.out_color_space = JCS_EXT_RGBA;
+    }
+
     jpeg_start_decompress(&cinfo);
     const int numComponents = cinfo.output_components;
-    const int rowStride = cinfo.output_width * numComponents;
-    JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)(
-        (j_common_ptr)&cinfo, JPOOL_IMAGE, rowStride, 1);
-
     img->Create(cinfo.output_width, cinfo.output_height);
-    while (SCAST<int>(cinfo.output_scanline) < img->GetHeight())
+
+    const int rowBytes = img->GetWidth() * 4;
+    if (numComponents == 4 && cinfo.out_color_space == JCS_EXT_RGBA)
     {
-        const int y = cinfo.output_scanline;
-        jpeg_read_scanlines(&cinfo, buffer, 1);
-        for (int x = 0; x < img->GetWidth(); ++x)
+        while (SCAST<int>(cinfo.output_scanline) < img->GetHeight())
         {
-            float a = numComponents == 4
-                          ? buffer[0][x * numComponents + 3] / 255.0f
-                          : 1.0f;
-            Color c(buffer[0][x * numComponents + 0] / 255.0f,
-                    buffer[0][x * numComponents + 1] / 255.0f,
-                    buffer[0][x * numComponents + 2] / 255.0f,
-                    a);
-            img->SetPixel(x, y, c);
+            JSAMPROW row = RCAST<JSAMPROW>(img->GetData() +
+                                           (cinfo.output_scanline * rowBytes));
+            jpeg_read_scanlines(&cinfo, &row, 1);
+        }
+    }
+    else
+    {
+        const int rowStride = cinfo.output_width * numComponents;
+        JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)(
+            (j_common_ptr)&cinfo, JPOOL_IMAGE, rowStride, 1);
+        while (SCAST<int>(cinfo.output_scanline) < img->GetHeight())
+        {
+            Byte *row = img->GetData() + (cinfo.output_scanline * rowBytes);
+            jpeg_read_scanlines(&cinfo, buffer, 1);
+            for (int x = 0; x < img->GetWidth(); ++x)
+            {
+                const JSAMPLE *srcPixel = buffer[0] + (x * numComponents);
+                Byte *dstPixel = row + (x * 4);
+                dstPixel[0] = srcPixel[0];
+                dstPixel[1] = srcPixel[Math::Min(1, numComponents - 1)];
+                dstPixel[2] = srcPixel[Math::Min(2, numComponents - 1)];
+                dstPixel[3] = 255;
+            }
         }
     }
 
@@ -563,21 +559,17 @@ void ImageIO::ImportTGA(const Path &filepath, Image *img, bool *ok)
         int height = tgaGetHeight(buffer);
 
         img->Create(width, height);
-        for (int y = 0; y < height; ++y)
+        Byte *imgPixels = img->GetData();
+        for (int i = 0; i < width * height; ++i)
         {
-            for (int x = 0; x < width; ++x)
-            {
-                const unsigned int coord = (y * width + x);
-                Color c = Color(
-                    SCAST<float>(pixels[coord] >> TGA_READER_ARGB.redShift),
-                    SCAST<float>(pixels[coord] >> TGA_READER_ARGB.greenShift),
-                    SCAST<float>(pixels[coord] >> TGA_READER_ARGB.blueShift),
-                    SCAST<float>(pixels[coord] >> TGA_READER_ARGB.alphaShift));
-                c /= 255.0f;
-
-                img->SetPixel(x, y, c);
-            }
+            const uint pixel = SCAST<uint>(pixels[i]);
+            imgPixels[i * 4 + 0] = (pixel >> TGA_READER_ARGB.redShift) & 0xFF;
+            imgPixels[i * 4 + 1] = (pixel >> TGA_READER_ARGB.greenShift) & 0xFF;
+            imgPixels[i * 4 + 2] = (pixel >> TGA_READER_ARGB.blueShift) & 0xFF;
+            imgPixels[i * 4 + 3] = (pixel >> TGA_READER_ARGB.alphaShift) & 0xFF;
         }
+        tgaFree(pixels);
+        tgaFree(buffer);
 
         *ok = true;
         fclose(file);
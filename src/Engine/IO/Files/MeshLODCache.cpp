@@ -0,0 +1,117 @@
+#include "Bang/MeshLODCache.h"
+
+#include "Bang/Array.tcc"
+#include "Bang/CacheFile.h"
+#include "Bang/File.h"
+#include "Bang/Vector2.h"
+#include "Bang/Vector3.h"
+
+using namespace Bang;
+
+constexpr uint MeshLODCache::CacheMagic;
+constexpr uint MeshLODCache::CacheVersion;
+
+Hash::HashType MeshLODCache::GetMeshDataHash(
+    const MeshSimplifier::MeshData &meshData,
+    MeshSimplifier::SimplificationMethod simplificationMethod)
+{
+    Hash::HashType hash = Hash::ComputeValue(CacheVersion);
+    hash = Hash::ComputeValue(SCAST<int>(simplificationMethod), hash);
+    hash = Hash::Compute(meshData.positions, hash);
+    hash = Hash::Compute(meshData.normals, hash);
+    hash = Hash::Compute(meshData.uvs, hash);
+    hash = Hash::Compute(meshData.tangents, hash);
+    hash = Hash::Compute(meshData.triangleVertexIds, hash);
+    return hash;
+}
+
+Path MeshLODCache::GetCacheFilepath(const Path &modelFilepath,
+                                    GUID::GUIDType meshEmbeddedGUID,
+                                    Hash::HashType meshDataHash)
+{
+    // Only meshes that come from a model file can be cached on disk. The
+    // mesh GUID is part of the source name, so that each mesh of the model
+    // keeps (and sweeps) its own entry
+    if (!modelFilepath.IsFile())
+    {
+        return Path::Empty();
+    }
+
+    return CacheFile::GetFilepath(
+        modelFilepath.AppendExtension(Hash::ToHexString(meshEmbeddedGUID)),
+        meshDataHash,
+        MeshLODCache::GetCacheExtension());
+}
+
+bool MeshLODCache::Read(const Path &cacheFilepath,
+                        Hash::HashType meshDataHash,
+                        Array<MeshSimplifier::LODData> *lodsData)
+{
+    if (!cacheFilepath.IsFile())
+    {
+        return false;
+    }
+
+    const Array<Byte> bytes = File::GetBytes(cacheFilepath);
+
+    std::size_t offset = 0;
+    uint numLODs = 0;
+    if (!CacheFile::ReadHeader(
+            bytes, &offset, CacheMagic, CacheVersion, meshDataHash) ||
+        !CacheFile::ReadValue(bytes, &offset, &numLODs))
+    {
+        return false;
+    }
+
+    Array<MeshSimplifier::LODData> readLODsData(numLODs);
+    for (MeshSimplifier::LODData &lodData : readLODsData)
+    {
+        if (!CacheFile::ReadArray(bytes, &offset, &lodData.positions) ||
+            !CacheFile::ReadArray(bytes, &offset, &lodData.normals) ||
+            !CacheFile::ReadArray(bytes, &offset, &lodData.uvs) ||
+            !CacheFile::ReadArray(bytes, &offset, &lodData.tangents) ||
+            !CacheFile::ReadArray(bytes, &offset, &lodData.triangleVertexIds))
+        {
+            return false;
+        }
+    }
+
+    *lodsData = readLODsData;
+    return true;
+}
+
+bool MeshLODCache::Write(const Path &cacheFilepath,
+                         Hash::HashType meshDataHash,
+                         const Array<MeshSimplifier::LODData> &lodsData)
+{
+    if (cacheFilepath.IsEmpty())
+    {
+        return false;
+    }
+
+    Array<Byte> bytes;
+    CacheFile::WriteHeader(&bytes, CacheMagic, CacheVersion, meshDataHash);
+    CacheFile::WriteValue<uint>(&bytes, lodsData.Size());
+    for (const MeshSimplifier::LODData &lodData : lodsData)
+    {
+        CacheFile::WriteArray(&bytes, lodData.positions);
+        CacheFile::WriteArray(&bytes, lodData.normals);
+        CacheFile::WriteArray(&bytes, lodData.uvs);
+        CacheFile::WriteArray(&bytes, lodData.tangents);
+        CacheFile::WriteArray(&bytes, lodData.triangleVertexIds);
+    }
+
+    File::Write(cacheFilepath, bytes.Data(), bytes.Size());
+    if (!cacheFilepath.IsFile())
+    {
+        return false;
+    }
+
+    CacheFile::RemoveStaleEntries(cacheFilepath);
+    return true;
+}
+
+String MeshLODCache::GetCacheExtension()
+{
+    return "lods";
+}
@@ -0,0 +1,337 @@
+#include "Bang/ModelCache.h"
+
+#include "Bang/Array.tcc"
+#include "Bang/CacheFile.h"
+#include "Bang/File.h"
+#include "Bang/Map.tcc"
+#include "Bang/Matrix4.h"
+#include "Bang/Quaternion.h"
+#include "Bang/Transformation.h"
+#include "Bang/Vector2.h"
+#include "Bang/Vector3.h"
+
+using namespace Bang;
+
+namespace
+{
+struct BoneWeight
+{
+    Mesh::VertexId vertexId;
+    float weight;
+};
+
+void WriteMesh(Array<Byte> *bytes, const ModelIOMeshData &meshData)
+{
+    CacheFile::WriteString(bytes, meshData.name);
+    CacheFile::WriteArray(bytes, meshData.triangleVertexIds);
+    CacheFile::WriteArray(bytes, meshData.positions);
+    CacheFile::WriteArray(bytes, meshData.normals);
+    CacheFile::WriteArray(bytes, meshData.uvs);
+    CacheFile::WriteArray(bytes, meshData.tangents);
+
+    // Bone weights are flattened to (vertexId, weight) pairs
+    CacheFile::WriteValue<uint>(bytes, meshData.bones.Size());
+    for (const auto &it : meshData.bones)
+    {
+        const Mesh::Bone &bone = it.second;
+        const Transformation &boneTransformation =
+            bone.rootSpaceToBoneBindSpaceTransformation;
+        CacheFile::WriteString(bytes, it.first);
+        CacheFile::WriteValue(bytes, boneTransformation.GetPosition());
+        CacheFile::WriteValue(bytes, boneTransformation.GetRotation());
+        CacheFile::WriteValue(bytes, boneTransformation.GetScale());
+
+        Array<BoneWeight> weights;
+        weights.Reserve(bone.weights.Size());
+        for (const auto &weightIt : bone.weights)
+        {
+            weights.PushBack({weightIt.first, weightIt.second});
+        }
+        CacheFile::WriteArray(bytes, weights);
+    }
+
+    CacheFile::WriteValue<uint>(bytes, meshData.bonesIds.Size());
+    for (const auto &it : meshData.bonesIds)
+    {
+        CacheFile::WriteString(bytes, it.first);
+        CacheFile::WriteValue<uint>(bytes, it.second);
+    }
+}
+
+bool ReadMesh(const Array<Byte> &bytes,
+              std::size_t *offset,
+              ModelIOMeshData *meshData)
+{
+    uint numBones = 0;
+    if (!CacheFile::ReadString(bytes, offset, &meshData->name) ||
+        !CacheFile::ReadArray(bytes, offset, &meshData->triangleVertexIds) ||
+        !CacheFile::ReadArray(bytes, offset, &meshData->positions) ||
+        !CacheFile::ReadArray(bytes, offset, &meshData->normals) ||
+        !CacheFile::ReadArray(bytes, offset, &meshData->uvs) ||
+        !CacheFile::ReadArray(bytes, offset, &meshData->tangents) ||
+        !CacheFile::ReadValue(bytes, offset, &numBones))
+    {
+        return false;
+    }
+
+    for (uint i = 0; i < numBones; ++i)
+    {
+        String boneName;
+        Vector3 position, scale;
+        Quaternion rotation;
+        Array<BoneWeight> weights;
+        if (!CacheFile::ReadString(bytes, offset, &boneName) ||
+            !CacheFile::ReadValue(bytes, offset, &position) ||
+            !CacheFile::ReadValue(bytes, offset, &rotation) ||
+            !CacheFile::ReadValue(bytes, offset, &scale) ||
+            !CacheFile::ReadArray(bytes, offset, &weights))
+        {
+            return false;
+        }
+
+        Mesh::Bone bone;
+        bone.rootSpaceToBoneBindSpaceTransformation =
+            Transformation(position, rotation, scale);
+        for (const BoneWeight &boneWeight : weights)
+        {
+            bone.weights.Add(boneWeight.vertexId, boneWeight.weight);
+        }
+        meshData->bones.Add(boneName, bone);
+    }
+
+    uint numBonesIds = 0;
+    if (!CacheFile::ReadValue(bytes, offset, &numBonesIds))
+    {
+        return false;
+    }
+
+    for (uint i = 0; i < numBonesIds; ++i)
+    {
+        String boneName;
+        uint boneId = 0;
+        if (!CacheFile::ReadString(bytes, offset, &boneName) ||
+            !CacheFile::ReadValue(bytes, offset, &boneId))
+        {
+            return false;
+        }
+        meshData->bonesIds.Add(boneName, boneId);
+    }
+    return true;
+}
+
+void WriteMaterial(Array<Byte> *bytes,
+                   const ModelIOMaterialData &materialData)
+{
+    CacheFile::WriteString(bytes, materialData.name);
+    CacheFile::WriteValue(bytes, materialData.albedoColor);
+    CacheFile::WriteString(bytes, materialData.albedoTexturePath);
+    CacheFile::WriteString(bytes, materialData.normalMapTexturePath);
+}
+
+bool ReadMaterial(const Array<Byte> &bytes,
+                  std::size_t *offset,
+                  ModelIOMaterialData *materialData)
+{
+    return CacheFile::ReadString(bytes, offset, &materialData->name) &&
+           CacheFile::ReadValue(bytes, offset, &materialData->albedoColor) &&
+           CacheFile::ReadString(
+               bytes, offset, &materialData->albedoTexturePath) &&
+           CacheFile::ReadString(
+               bytes, offset, &materialData->normalMapTexturePath);
+}
+
+void WriteAnimation(Array<Byte> *bytes,
+                    const ModelIOAnimationData &animationData)
+{
+    CacheFile::WriteString(bytes, animationData.name);
+    CacheFile::WriteValue(bytes, animationData.durationInFrames);
+    CacheFile::WriteValue(bytes, animationData.framesPerSecond);
+    CacheFile::WriteValue<uint>(bytes, animationData.channels.Size());
+    for (const ModelIOAnimationChannel &channel : animationData.channels)
+    {
+        CacheFile::WriteString(bytes, channel.boneName);
+        CacheFile::WriteArray(bytes, channel.positionKeyFrames);
+        CacheFile::WriteArray(bytes, channel.rotationKeyFrames);
+        CacheFile::WriteArray(bytes, channel.scaleKeyFrames);
+    }
+}
+
+bool ReadAnimation(const Array<Byte> &bytes,
+                   std::size_t *offset,
+                   ModelIOAnimationData *animationData)
+{
+    uint numChannels = 0;
+    if (!CacheFile::ReadString(bytes, offset, &animationData->name) ||
+        !CacheFile::ReadValue(
+            bytes, offset, &animationData->durationInFrames) ||
+        !CacheFile::ReadValue(
+            bytes, offset, &animationData->framesPerSecond) ||
+        !CacheFile::ReadValue(bytes, offset, &numChannels))
+    {
+        return false;
+    }
+
+    animationData->channels.Resize(numChannels);
+    for (ModelIOAnimationChannel &channel : animationData->channels)
+    {
+        if (!CacheFile::ReadString(bytes, offset, &channel.boneName) ||
+            !CacheFile::ReadArray(bytes, offset, &channel.positionKeyFrames) ||
+            !CacheFile::ReadArray(bytes, offset, &channel.rotationKeyFrames) ||
+            !CacheFile::ReadArray(bytes, offset, &channel.scaleKeyFrames))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void WriteNode(Array<Byte> *bytes, const ModelIONode &node, int parentIndex)
+{
+    CacheFile::WriteString(bytes, node.name);
+    CacheFile::WriteValue(bytes, node.localToParent);
+    CacheFile::WriteArray(bytes, node.meshIndices);
+    CacheFile::WriteArray(bytes, node.meshMaterialIndices);
+    CacheFile::WriteValue<int>(bytes, parentIndex);
+}
+
+bool ReadNode(const Array<Byte> &bytes,
+              std::size_t *offset,
+              ModelIONode *node,
+              int *parentIndex)
+{
+    return CacheFile::ReadString(bytes, offset, &node->name) &&
+           CacheFile::ReadValue(bytes, offset, &node->localToParent) &&
+           CacheFile::ReadArray(bytes, offset, &node->meshIndices) &&
+           CacheFile::ReadArray(bytes, offset, &node->meshMaterialIndices) &&
+           CacheFile::ReadValue(bytes, offset, parentIndex);
+}
+}  // namespace
+
+constexpr uint ModelCache::CacheMagic;
+constexpr uint ModelCache::CacheVersion;
+
+Path ModelCache::GetCacheFilepath(const Path &modelFilepath,
+                                  Hash::HashType modelFileHash)
+{
+    if (!modelFilepath.IsFile())
+    {
+        return Path::Empty();
+    }
+
+    return CacheFile::GetFilepath(
+        modelFilepath, modelFileHash, ModelCache::GetCacheExtension());
+}
+
+bool ModelCache::Read(const Path &cacheFilepath,
+                      Hash::HashType modelFileHash,
+                      ModelIOData *modelData)
+{
+    if (!cacheFilepath.IsFile())
+    {
+        return false;
+    }
+
+    const Array<Byte> bytes = File::GetBytes(cacheFilepath);
+
+    std::size_t offset = 0;
+    uint numMeshes = 0, numMaterials = 0, numAnimations = 0, numNodes = 0;
+    if (!CacheFile::ReadHeader(
+            bytes, &offset, CacheMagic, CacheVersion, modelFileHash) ||
+        !CacheFile::ReadValue(bytes, &offset, &numMeshes) ||
+        !CacheFile::ReadValue(bytes, &offset, &numMaterials) ||
+        !CacheFile::ReadValue(bytes, &offset, &numAnimations) ||
+        !CacheFile::ReadValue(bytes, &offset, &numNodes))
+    {
+        return false;
+    }
+
+    ModelIOData readModelData;
+    readModelData.meshes.Resize(numMeshes);
+    for (ModelIOMeshData &meshData : readModelData.meshes)
+    {
+        if (!ReadMesh(bytes, &offset, &meshData))
+        {
+            return false;
+        }
+    }
+
+    readModelData.materials.Resize(numMaterials);
+    for (ModelIOMaterialData &materialData : readModelData.materials)
+    {
+        if (!ReadMaterial(bytes, &offset, &materialData))
+        {
+            return false;
+        }
+    }
+
+    readModelData.animations.Resize(numAnimations);
+    for (ModelIOAnimationData &animationData : readModelData.animations)
+    {
+        if (!ReadAnimation(bytes, &offset, &animationData))
+        {
+            return false;
+        }
+    }
+
+    readModelData.nodes.Resize(numNodes);
+    readModelData.nodesParentIndices.Resize(numNodes);
+    for (uint i = 0; i < numNodes; ++i)
+    {
+        int &parentIndex = readModelData.nodesParentIndices[i];
+        if (!ReadNode(bytes, &offset, &readModelData.nodes[i], &parentIndex) ||
+            parentIndex >= SCAST<int>(i))
+        {
+            return false;
+        }
+    }
+
+    *modelData = readModelData;
+    return true;
+}
+
+bool ModelCache::Write(const Path &cacheFilepath,
+                       Hash::HashType modelFileHash,
+                       const ModelIOData &modelData)
+{
+    if (cacheFilepath.IsEmpty())
+    {
+        return false;
+    }
+
+    Array<Byte> bytes;
+    CacheFile::WriteHeader(&bytes, CacheMagic, CacheVersion, modelFileHash);
+    CacheFile::WriteValue<uint>(&bytes, modelData.meshes.Size());
+    CacheFile::WriteValue<uint>(&bytes, modelData.materials.Size());
+    CacheFile::WriteValue<uint>(&bytes, modelData.animations.Size());
+    CacheFile::WriteValue<uint>(&bytes, modelData.nodes.Size());
+    for (const ModelIOMeshData &meshData : modelData.meshes)
+    {
+        WriteMesh(&bytes, meshData);
+    }
+    for (const ModelIOMaterialData &materialData : modelData.materials)
+    {
+        WriteMaterial(&bytes, materialData);
+    }
+    for (const ModelIOAnimationData &animationData : modelData.animations)
+    {
+        WriteAnimation(&bytes, animationData);
+    }
+    for (uint i = 0; i < modelData.nodes.Size(); ++i)
+    {
+        WriteNode(&bytes, modelData.nodes[i], modelData.nodesParentIndices[i]);
+    }
+
+    File::Write(cacheFilepath, bytes.Data(), bytes.Size());
+    if (!cacheFilepath.IsFile())
+    {
+        return false;
+    }
+
+    CacheFile::RemoveStaleEntries(cacheFilepath);
+    return true;
+}
+
+String ModelCache::GetCacheExtension()
+{
+    return "bmodel";
+}
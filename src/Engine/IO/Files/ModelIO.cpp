@@ -33,11 +33,13 @@
 #include "Bang/Extensions.h"
 #include "Bang/GameObject.h"
 #include "Bang/GameObject.tcc"
+#include "Bang/Hash.h"
 #include "Bang/List.tcc"
 #include "Bang/Material.h"
 #include "Bang/Mesh.h"
 #include "Bang/MeshRenderer.h"
 #include "Bang/Model.h"
+#include "Bang/ModelCache.h"
 #include "Bang/Path.h"
 #include "Bang/Quaternion.h"
 #include "Bang/StreamOperators.h"
@@ -68,6 +70,18 @@ Quaternion AiQuatToQuat(const aiQuaternion &q)
 {
     return Quaternion(q.x, q.y, q.z, q.w);
 }
+String AiMaterialTextureToString(aiMaterial *aMaterial,
+                                 aiTextureType aTextureType)
+{
+    aiString aTexturePath;
+    aMaterial->GetTexture(aTextureType, 0, &aTexturePath);
+    return String(aTexturePath.C_Str());
+}
+Path ModelTexturePathToPath(const String &texturePath,
+                            const Path &modelDirectory)
+{
+    return modelDirectory.Append(Path(texturePath));
+}
 Color AiColor3ToColor(const aiColor3D &c)
 {
     return Color(c.r, c.g, c.b, 1);
@@ -132,37 +146,36 @@ Matrix4 AiMatrix4ToMatrix4(const aiMatrix4x4 &m)
 }
 // ==================================================
 
-Tree<ModelIONode> *ReadModelNode(const aiScene *scene, aiNode *node)
+bool ModelIO::ImportModel(const Path &modelFilepath,
+                          Model *model,
+                          ModelIOScene *modelScene)
 {
-    Tree<ModelIONode> *modelNodeTree = new Tree<ModelIONode>();
-    ModelIONode &modelNode = modelNodeTree->GetData();
+    ModelIOData modelData;
+    if (!ModelIO::ReadModel(modelFilepath, &modelData))
+    {
+        return false;
+    }
 
-    modelNode.name = AiStringToString(node->mName);
-    modelNode.localToParent = AiMatrix4ToMatrix4(node->mTransformation);
+    ModelIO::ImportModel(modelFilepath, modelData, model, modelScene);
+    return true;
+}
 
-    // Set mesh indices
-    for (uint i = 0; i < node->mNumMeshes; ++i)
+bool ModelIO::ReadModel(const Path &modelFilepath, ModelIOData *modelData)
+{
+    if (!modelFilepath.IsFile())
     {
-        uint meshIndex = node->mMeshes[i];
-        modelNode.meshIndices.PushBack(meshIndex);
-        modelNode.meshMaterialIndices.PushBack(
-            scene->mMeshes[meshIndex]->mMaterialIndex);
+        return false;
     }
 
-    for (uint i = 0; i < node->mNumChildren; ++i)
+    // Assimp post-processing is way slower than reading the compiled model
+    const Hash::HashType modelFileHash = Hash::ComputeFile(modelFilepath);
+    const Path cacheFilepath =
+        ModelCache::GetCacheFilepath(modelFilepath, modelFileHash);
+    if (ModelCache::Read(cacheFilepath, modelFileHash, modelData))
     {
-        aiNode *child = node->mChildren[i];
-        Tree<ModelIONode> *childModelTree = ReadModelNode(scene, child);
-        childModelTree->SetParent(modelNodeTree);
+        return true;
     }
 
-    return modelNodeTree;
-}
-
-bool ModelIO::ImportModel(const Path &modelFilepath,
-                          Model *model,
-                          ModelIOScene *modelScene)
-{
     Assimp::Importer importer;
     const aiScene *aScene = ImportScene(&importer, modelFilepath);
     if (!aScene)
@@ -170,12 +183,43 @@ bool ModelIO::ImportModel(const Path &modelFilepath,
         return false;
     }
 
+    ModelIO::ReadScene(aScene, modelData);
+    ModelCache::Write(cacheFilepath, modelFileHash, *modelData);
+    return true;
+}
+
+void ModelIO::GetTexturesFilepaths(const Path &modelFilepath,
+                                   const ModelIOData &modelData,
+                                   Array<Path> *texturesFilepaths)
+{
+    const Path modelDirectory = modelFilepath.GetDirectory();
+    for (const ModelIOMaterialData &materialData : modelData.materials)
+    {
+        for (const String &texturePathStr : {materialData.albedoTexturePath,
+                                             materialData.normalMapTexturePath})
+        {
+            const Path texturePath =
+                ModelTexturePathToPath(texturePathStr, modelDirectory);
+            if (texturePath.IsFile() &&
+                !texturesFilepaths->Contains(texturePath))
+            {
+                texturesFilepaths->PushBack(texturePath);
+            }
+        }
+    }
+}
+
+void ModelIO::ImportModel(const Path &modelFilepath,
+                          const ModelIOData &modelData,
+                          Model *model,
+                          ModelIOScene *modelScene)
+{
     // Load materials
-    for (int i = 0; i < SCAST<int>(aScene->mNumMaterials); ++i)
+    for (const ModelIOMaterialData &materialData : modelData.materials)
     {
         String materialName;
         AH<Material> materialAH;
-        ModelIO::ImportEmbeddedMaterial(aScene->mMaterials[i],
+        ModelIO::ImportEmbeddedMaterial(materialData,
                                         modelFilepath.GetDirectory(),
                                         model,
                                         &materialAH,
@@ -186,12 +230,11 @@ bool ModelIO::ImportModel(const Path &modelFilepath,
 
     // Load meshes
     Map<String, Mesh::Bone> allBones;
-    for (int i = 0; i < SCAST<int>(aScene->mNumMeshes); ++i)
+    for (const ModelIOMeshData &meshData : modelData.meshes)
     {
         AH<Mesh> meshAH;
         String meshName;
-        ModelIO::ImportEmbeddedMesh(
-            aScene->mMeshes[i], model, &meshAH, &meshName);
+        ModelIO::ImportEmbeddedMesh(meshData, model, &meshAH, &meshName);
         modelScene->meshes.PushBack(meshAH);
         modelScene->meshesNames.PushBack(meshName);
 
@@ -202,67 +245,38 @@ bool ModelIO::ImportModel(const Path &modelFilepath,
         }
     }
 
-    // Load animations and store them into arrays
-    for (int i = 0; i < SCAST<int>(aScene->mNumAnimations); ++i)
+    // Load animations
+    for (const ModelIOAnimationData &animationData : modelData.animations)
     {
-        aiAnimation *aAnimation = aScene->mAnimations[i];
-        String animationName = AiStringToString(aAnimation->mName);
-        if (animationName.IsEmpty())
-        {
-            animationName = "Animation";
-        }
-        animationName.Append("." + Extensions::GetAnimationExtension());
-        animationName = Path::GetDuplicateStringWithExtension(
-            animationName, model->GetAnimationsNames());
-        AH<Animation> animationAH =
-            Assets::CreateEmbeddedAsset<Animation>(model, animationName);
-        Animation *animation = animationAH.Get();
-        double animDuration = aAnimation->mDuration;
-        animation->SetDurationInFrames(animDuration);
-        animation->SetFramesPerSecond(aAnimation->mTicksPerSecond);
-        for (int j = 0; j < SCAST<int>(aAnimation->mNumChannels); ++j)
-        {
-            aiNodeAnim *aNodeAnim = aAnimation->mChannels[j];
-            String boneName = AiStringToString(aNodeAnim->mNodeName);
-
-            for (uint k = 0; k < aNodeAnim->mNumPositionKeys;
-                 ++k)  // Position keys
-            {
-                Animation::KeyFrame<Vector3> keyFrame;
-                keyFrame.timeInFrames = aNodeAnim->mPositionKeys[k].mTime;
-                keyFrame.value =
-                    AiVec3ToVec3(aNodeAnim->mPositionKeys[k].mValue);
-                animation->AddPositionKeyFrame(boneName, keyFrame);
-            }
+        AH<Animation> animationAH;
+        String animationName;
+        ModelIO::ImportEmbeddedAnimation(
+            animationData, model, &animationAH, &animationName);
+        modelScene->animations.PushBack(animationAH);
+        modelScene->animationsNames.PushBack(animationName);
+    }
 
-            for (uint k = 0; k < aNodeAnim->mNumRotationKeys;
-                 ++k)  // Rotation keys
-            {
-                Animation::KeyFrame<Quaternion> keyFrame;
-                keyFrame.timeInFrames = aNodeAnim->mRotationKeys[k].mTime;
-                keyFrame.value =
-                    AiQuatToQuat(aNodeAnim->mRotationKeys[k].mValue);
-                animation->AddRotationKeyFrame(boneName, keyFrame);
-            }
+    // Rebuild the node tree
+    Array<Tree<ModelIONode> *> nodeTrees;
+    for (uint i = 0; i < modelData.nodes.Size(); ++i)
+    {
+        Tree<ModelIONode> *nodeTree = new Tree<ModelIONode>();
+        nodeTree->GetData() = modelData.nodes[i];
 
-            for (uint k = 0; k < aNodeAnim->mNumScalingKeys; ++k)  // Scale keys
-            {
-                Animation::KeyFrame<Vector3> keyFrame;
-                keyFrame.timeInFrames = aNodeAnim->mScalingKeys[k].mTime;
-                keyFrame.value =
-                    AiVec3ToVec3(aNodeAnim->mScalingKeys[k].mValue);
-                animation->AddScaleKeyFrame(boneName, keyFrame);
-            }
+        const int parentIndex = modelData.nodesParentIndices[i];
+        if (parentIndex >= 0)
+        {
+            nodeTree->SetParent(nodeTrees[parentIndex]);
         }
-        modelScene->animations.PushBack(animationAH);
-        modelScene->animationsNames.PushBack(animationName);
+        nodeTrees.PushBack(nodeTree);
     }
 
     modelScene->allBones = allBones;
-    modelScene->rootGameObjectName = AiStringToString(aScene->mRootNode->mName);
-    modelScene->modelTree = ReadModelNode(aScene, aScene->mRootNode);
-
-    return true;
+    if (!nodeTrees.IsEmpty())
+    {
+        modelScene->rootGameObjectName = modelData.nodes.Front().name;
+        modelScene->modelTree = nodeTrees.Front();
+    }
 }
 
 void ModelIO::ImportMeshRaw(aiMesh *aMesh,
@@ -274,47 +288,58 @@ void ModelIO::ImportMeshRaw(aiMesh *aMesh,
                             Map<String, Mesh::Bone> *bones,
                             Map<String, uint> *bonesIndices)
 {
+    // The arrays are resized once, and then filled in place
+    uint numIndices = 0;
     for (uint i = 0; i < aMesh->mNumFaces; ++i)
     {
-        for (uint j = 0; j < aMesh->mFaces[i].mNumIndices; ++j)
-        {
-            Mesh::VertexId vIndex = aMesh->mFaces[i].mIndices[j];
-            vertexIndices->PushBack(vIndex);
-        }
+        numIndices += aMesh->mFaces[i].mNumIndices;
     }
 
-    // Positions
-    for (uint i = 0; i < aMesh->mNumVertices; ++i)
+    uint prevSize = vertexIndices->Size();
+    vertexIndices->Resize(prevSize + numIndices);
+    Mesh::VertexId *indicesData = vertexIndices->Data() + prevSize;
+    for (uint i = 0; i < aMesh->mNumFaces; ++i)
     {
-        Vector3 pos = AiVec3ToVec3(aMesh->mVertices[i]);
-        vertexPositionsPool->PushBack(pos);
+        const aiFace &aFace = aMesh->mFaces[i];
+        for (uint j = 0; j < aFace.mNumIndices; ++j)
+        {
+            *(indicesData++) = aFace.mIndices[j];
+        }
     }
 
-    // Normals
-    for (uint i = 0; i < aMesh->mNumVertices; ++i)
-    {
-        Vector3 normal = AiVec3ToVec3(aMesh->mNormals[i]);
-        vertexNormalsPool->PushBack(normal);
-    }
+    const uint numVertices = aMesh->mNumVertices;
+    auto CopyVec3s = [numVertices](const aiVector3D *aVecs,
+                                   Array<Vector3> *vecs) {
+        const uint prevVecsSize = vecs->Size();
+        vecs->Resize(prevVecsSize + numVertices);
+        Vector3 *vecsData = vecs->Data() + prevVecsSize;
+        for (uint i = 0; i < numVertices; ++i)
+        {
+            vecsData[i] = AiVec3ToVec3(aVecs[i]);
+        }
+    };
+
+    // Positions and normals
+    CopyVec3s(aMesh->mVertices, vertexPositionsPool);
+    CopyVec3s(aMesh->mNormals, vertexNormalsPool);
 
     // Uvs
     if (aMesh->GetNumUVChannels() > 0)
     {
-        for (uint i = 0; i < aMesh->mNumVertices; ++i)
+        prevSize = vertexUvsPool->Size();
+        vertexUvsPool->Resize(prevSize + numVertices);
+        Vector2 *uvsData = vertexUvsPool->Data() + prevSize;
+        for (uint i = 0; i < numVertices; ++i)
         {
-            Vector3 uvs = AiVec3ToVec3(aMesh->mTextureCoords[0][i]);
-            vertexUvsPool->PushBack(uvs.xy());
+            const aiVector3D &aUv = aMesh->mTextureCoords[0][i];
+            uvsData[i] = Vector2(aUv.x, aUv.y);
         }
     }
 
     // Tangents
     if (aMesh->HasTangentsAndBitangents())
     {
-        for (uint i = 0; i < aMesh->mNumVertices; ++i)
-        {
-            Vector3 tangent = AiVec3ToVec3(aMesh->mTangents[i]);
-            vertexTangentsPool->PushBack(tangent);
-        }
+        CopyVec3s(aMesh->mTangents, vertexTangentsPool);
     }
 
     // Bones
@@ -586,15 +611,135 @@ aiMaterial *ModelIO::MaterialToAiMaterial(const Material *material)
 #endif
 }
 
-void ModelIO::ImportEmbeddedMaterial(aiMaterial *aMaterial,
+void ModelIO::ReadScene(const aiScene *aScene, ModelIOData *modelData)
+{
+    modelData->materials.Resize(aScene->mNumMaterials);
+    for (uint i = 0; i < aScene->mNumMaterials; ++i)
+    {
+        ModelIO::ReadMaterial(aScene->mMaterials[i], &modelData->materials[i]);
+    }
+
+    modelData->meshes.Resize(aScene->mNumMeshes);
+    for (uint i = 0; i < aScene->mNumMeshes; ++i)
+    {
+        ModelIO::ReadMesh(aScene->mMeshes[i], &modelData->meshes[i]);
+    }
+
+    modelData->animations.Resize(aScene->mNumAnimations);
+    for (uint i = 0; i < aScene->mNumAnimations; ++i)
+    {
+        ModelIO::ReadAnimation(aScene->mAnimations[i],
+                               &modelData->animations[i]);
+    }
+
+    ModelIO::ReadNode(aScene, aScene->mRootNode, -1, modelData);
+}
+
+void ModelIO::ReadMesh(aiMesh *aMesh, ModelIOMeshData *meshData)
+{
+    meshData->name = AiStringToString(aMesh->mName);
+    ModelIO::ImportMeshRaw(aMesh,
+                           &meshData->triangleVertexIds,
+                           &meshData->positions,
+                           &meshData->normals,
+                           &meshData->uvs,
+                           &meshData->tangents,
+                           &meshData->bones,
+                           &meshData->bonesIds);
+}
+
+void ModelIO::ReadMaterial(aiMaterial *aMaterial,
+                           ModelIOMaterialData *materialData)
+{
+    aiString aMatName;
+    aiGetMaterialString(aMaterial, AI_MATKEY_NAME, &aMatName);
+    materialData->name = AiStringToString(aMatName);
+
+    aiColor3D aDiffuseColor = aiColor3D(1.0f, 1.0f, 1.0f);
+    aMaterial->Get(AI_MATKEY_COLOR_DIFFUSE, aDiffuseColor);
+    materialData->albedoColor = AiColor3ToColor(aDiffuseColor);
+
+    materialData->albedoTexturePath =
+        AiMaterialTextureToString(aMaterial, aiTextureType_DIFFUSE);
+    materialData->normalMapTexturePath =
+        AiMaterialTextureToString(aMaterial, aiTextureType_NORMALS);
+}
+
+void ModelIO::ReadAnimation(aiAnimation *aAnimation,
+                            ModelIOAnimationData *animationData)
+{
+    animationData->name = AiStringToString(aAnimation->mName);
+    animationData->durationInFrames = aAnimation->mDuration;
+    animationData->framesPerSecond = aAnimation->mTicksPerSecond;
+
+    animationData->channels.Resize(aAnimation->mNumChannels);
+    for (uint i = 0; i < aAnimation->mNumChannels; ++i)
+    {
+        aiNodeAnim *aNodeAnim = aAnimation->mChannels[i];
+        ModelIOAnimationChannel &channel = animationData->channels[i];
+        channel.boneName = AiStringToString(aNodeAnim->mNodeName);
+
+        channel.positionKeyFrames.Resize(aNodeAnim->mNumPositionKeys);
+        for (uint k = 0; k < aNodeAnim->mNumPositionKeys; ++k)
+        {
+            const aiVectorKey &aKey = aNodeAnim->mPositionKeys[k];
+            channel.positionKeyFrames[k].timeInFrames = aKey.mTime;
+            channel.positionKeyFrames[k].value = AiVec3ToVec3(aKey.mValue);
+        }
+
+        channel.rotationKeyFrames.Resize(aNodeAnim->mNumRotationKeys);
+        for (uint k = 0; k < aNodeAnim->mNumRotationKeys; ++k)
+        {
+            const aiQuatKey &aKey = aNodeAnim->mRotationKeys[k];
+            channel.rotationKeyFrames[k].timeInFrames = aKey.mTime;
+            channel.rotationKeyFrames[k].value = AiQuatToQuat(aKey.mValue);
+        }
+
+        channel.scaleKeyFrames.Resize(aNodeAnim->mNumScalingKeys);
+        for (uint k = 0; k < aNodeAnim->mNumScalingKeys; ++k)
+        {
+            const aiVectorKey &aKey = aNodeAnim->mScalingKeys[k];
+            channel.scaleKeyFrames[k].timeInFrames = aKey.mTime;
+            channel.scaleKeyFrames[k].value = AiVec3ToVec3(aKey.mValue);
+        }
+    }
+}
+
+void ModelIO::ReadNode(const aiScene *aScene,
+                       aiNode *aNode,
+                       int parentIndex,
+                       ModelIOData *modelData)
+{
+    ModelIONode modelNode;
+    modelNode.name = AiStringToString(aNode->mName);
+    modelNode.localToParent = AiMatrix4ToMatrix4(aNode->mTransformation);
+
+    // Set mesh indices
+    for (uint i = 0; i < aNode->mNumMeshes; ++i)
+    {
+        uint meshIndex = aNode->mMeshes[i];
+        modelNode.meshIndices.PushBack(meshIndex);
+        modelNode.meshMaterialIndices.PushBack(
+            aScene->mMeshes[meshIndex]->mMaterialIndex);
+    }
+
+    const int nodeIndex = modelData->nodes.Size();
+    modelData->nodes.PushBack(modelNode);
+    modelData->nodesParentIndices.PushBack(parentIndex);
+
+    for (uint i = 0; i < aNode->mNumChildren; ++i)
+    {
+        ModelIO::ReadNode(aScene, aNode->mChildren[i], nodeIndex, modelData);
+    }
+}
+
+void ModelIO::ImportEmbeddedMaterial(const ModelIOMaterialData &materialData,
                                      const Path &modelDirectory,
                                      Model *model,
                                      AH<Material> *outMaterial,
                                      String *outMaterialName)
 {
-    aiString aMatName;
-    aiGetMaterialString(aMaterial, AI_MATKEY_NAME, &aMatName);
-    String materialName = AiStringToString(aMatName);
+    String materialName = materialData.name;
     if (materialName.IsEmpty())
     {
         materialName = "Material";
@@ -606,17 +751,8 @@ void ModelIO::ImportEmbeddedMaterial(aiMaterial *aMaterial,
     *outMaterialName = materialName;
     *outMaterial = Assets::CreateEmbeddedAsset<Material>(model, materialName);
 
-    aiColor3D aAmbientColor = aiColor3D(0.0f, 0.0f, 0.0f);
-    aiColor3D aDiffuseColor = aiColor3D(1.0f, 1.0f, 1.0f);
-    aMaterial->Get(AI_MATKEY_COLOR_AMBIENT, aAmbientColor);
-    aMaterial->Get(AI_MATKEY_COLOR_DIFFUSE, aDiffuseColor);
-
-    Color albedoColor = AiColor3ToColor(aDiffuseColor);
-
-    aiString aAlbedoTexturePath;
-    aMaterial->GetTexture(aiTextureType_DIFFUSE, 0, &aAlbedoTexturePath);
-    Path albedoTexturePath(String(aAlbedoTexturePath.C_Str()));
-    albedoTexturePath = modelDirectory.Append(albedoTexturePath);
+    const Path albedoTexturePath = ModelTexturePathToPath(
+        materialData.albedoTexturePath, modelDirectory);
     AH<Texture2D> matAlbedoTexture;
     if (albedoTexturePath.IsFile())
     {
@@ -627,10 +763,8 @@ void ModelIO::ImportEmbeddedMaterial(aiMaterial *aMaterial,
         outMaterial->Get()->SetAlbedoUvMultiply(Vector2(1, -1));
     }
 
-    aiString aNormalsTexturePath;
-    aMaterial->GetTexture(aiTextureType_NORMALS, 0, &aNormalsTexturePath);
-    Path normalsTexturePath(String(aNormalsTexturePath.C_Str()));
-    normalsTexturePath = modelDirectory.Append(normalsTexturePath);
+    const Path normalsTexturePath = ModelTexturePathToPath(
+        materialData.normalMapTexturePath, modelDirectory);
     AH<Texture2D> matNormalTexture;
     if (normalsTexturePath.IsFile())
     {
@@ -645,17 +779,16 @@ void ModelIO::ImportEmbeddedMaterial(aiMaterial *aMaterial,
     outMaterial->Get()->SetMetalness(0.1f);
     outMaterial->Get()->SetAlbedoTexture(matAlbedoTexture.Get());
     outMaterial->Get()->SetNormalMapTexture(matNormalTexture.Get());
-    outMaterial->Get()->SetAlbedoColor(matAlbedoTexture ? Color::White()
-                                                        : albedoColor);
+    outMaterial->Get()->SetAlbedoColor(
+        matAlbedoTexture ? Color::White() : materialData.albedoColor);
 }
 
-void ModelIO::ImportEmbeddedMesh(aiMesh *aMesh,
+void ModelIO::ImportEmbeddedMesh(const ModelIOMeshData &meshData,
                                  Model *model,
                                  AH<Mesh> *outMeshAH,
                                  String *outMeshName)
 {
-    aiString aMeshName = aMesh->mName;
-    String meshName = AiStringToString(aMeshName);
+    String meshName = meshData.name;
     if (meshName.IsEmpty())
     {
         meshName = "Mesh";
@@ -667,34 +800,55 @@ void ModelIO::ImportEmbeddedMesh(aiMesh *aMesh,
     *outMeshAH = Assets::CreateEmbeddedAsset<Mesh>(model, meshName);
     *outMeshName = meshName;
 
-    Array<Mesh::VertexId> vertexIndices;
-    Array<Vector3> vertexPositionsPool;
-    Array<Vector3> vertexNormalsPool;
-    Array<Vector2> vertexUvsPool;
-    Array<Vector3> vertexTangentsPool;
-    Map<String, Mesh::Bone> bonesPool;
-    Map<String, uint> bonesIndices;
-
-    ModelIO::ImportMeshRaw(aMesh,
-                           &vertexIndices,
-                           &vertexPositionsPool,
-                           &vertexNormalsPool,
-                           &vertexUvsPool,
-                           &vertexTangentsPool,
-                           &bonesPool,
-                           &bonesIndices);
-
     Mesh *outMesh = outMeshAH->Get();
-    outMesh->SetPositionsPool(vertexPositionsPool);
-    outMesh->SetNormalsPool(vertexNormalsPool);
-    outMesh->SetUvsPool(vertexUvsPool);
-    outMesh->SetTangentsPool(vertexTangentsPool);
-    outMesh->SetTrianglesVertexIds(vertexIndices);
-    outMesh->SetBonesPool(bonesPool);
-    outMesh->SetBonesIds(bonesIndices);
+    outMesh->SetPositionsPool(meshData.positions);
+    outMesh->SetNormalsPool(meshData.normals);
+    outMesh->SetUvsPool(meshData.uvs);
+    outMesh->SetTangentsPool(meshData.tangents);
+    outMesh->SetTrianglesVertexIds(meshData.triangleVertexIds);
+    outMesh->SetBonesPool(meshData.bones);
+    outMesh->SetBonesIds(meshData.bonesIds);
     outMesh->UpdateVAOs();
 }
 
+void ModelIO::ImportEmbeddedAnimation(const ModelIOAnimationData &animationData,
+                                      Model *model,
+                                      AH<Animation> *outAnimationAH,
+                                      String *outAnimationName)
+{
+    String animationName = animationData.name;
+    if (animationName.IsEmpty())
+    {
+        animationName = "Animation";
+    }
+    animationName.Append("." + Extensions::GetAnimationExtension());
+    animationName = Path::GetDuplicateStringWithExtension(
+        animationName, model->GetAnimationsNames());
+
+    *outAnimationAH =
+        Assets::CreateEmbeddedAsset<Animation>(model, animationName);
+    *outAnimationName = animationName;
+
+    Animation *animation = outAnimationAH->Get();
+    animation->SetDurationInFrames(animationData.durationInFrames);
+    animation->SetFramesPerSecond(animationData.framesPerSecond);
+    for (const ModelIOAnimationChannel &channel : animationData.channels)
+    {
+        for (const auto &keyFrame : channel.positionKeyFrames)
+        {
+            animation->AddPositionKeyFrame(channel.boneName, keyFrame);
+        }
+        for (const auto &keyFrame : channel.rotationKeyFrames)
+        {
+            animation->AddRotationKeyFrame(channel.boneName, keyFrame);
+        }
+        for (const auto &keyFrame : channel.scaleKeyFrames)
+        {
+            animation->AddScaleKeyFrame(channel.boneName, keyFrame);
+        }
+    }
+}
+
 const aiScene *ModelIO::ImportScene(Assimp::Importer *importer,
                                     const Path &modelFilepath)
 {
@@ -0,0 +1,179 @@
+#include "Bang/ShaderProgramBinaryCache.h"
+
+#include <cstring>
+
+#include "Bang/Array.tcc"
+#include "Bang/CacheFile.h"
+#include "Bang/File.h"
+#include "Bang/Paths.h"
+
+using namespace Bang;
+
+constexpr uint ShaderProgramBinaryCache::CacheMagic;
+constexpr uint ShaderProgramBinaryCache::CacheVersion;
+bool ShaderProgramBinaryCache::s_enabled = true;
+uint ShaderProgramBinaryCache::s_numHits = 0;
+uint ShaderProgramBinaryCache::s_numMisses = 0;
+
+Hash::HashType ShaderProgramBinaryCache::GetIdentityHash(
+    const Array<Path> &shaderPaths,
+    const Array<String> &keywords)
+{
+    bool hasPaths = false;
+    Hash::HashType hash = Hash::ComputeValue(CacheVersion);
+    for (const Path &shaderPath : shaderPaths)
+    {
+        hasPaths = hasPaths || !shaderPath.IsEmpty();
+        hash = Hash::Compute(shaderPath.GetAbsolute(), hash);
+    }
+    for (const String &keyword : keywords)
+    {
+        hash = Hash::Compute(keyword, hash);
+    }
+    return hasPaths ? hash : 0;
+}
+
+Hash::HashType ShaderProgramBinaryCache::GetCacheHash(
+    const String &vShaderSource,
+    const String &gShaderSource,
+    const String &fShaderSource)
+{
+    // A driver update can change the binaries, or stop accepting them
+    static const String DriverString = GL::GetString(GL_VENDOR) + "|" +
+                                       GL::GetString(GL_RENDERER) + "|" +
+                                       GL::GetString(GL_VERSION);
+
+    Hash::HashType hash = Hash::ComputeValue(CacheVersion);
+    hash = Hash::Compute(DriverString, hash);
+    hash = Hash::Compute(vShaderSource, hash);
+    hash = Hash::Compute(gShaderSource, hash);
+    hash = Hash::Compute(fShaderSource, hash);
+    return hash;
+}
+
+Path ShaderProgramBinaryCache::GetCacheFilepath(Hash::HashType identityHash,
+                                                Hash::HashType cacheHash)
+{
+    if (Paths::GetProjectDir().IsEmpty())
+    {
+        return Path::Empty();
+    }
+
+    return Paths::GetProjectCacheDir()
+        .Append("ShaderPrograms")
+        .Append(Hash::ToHexString(identityHash))
+        .AppendExtension(Hash::ToHexString(cacheHash))
+        .AppendExtension(ShaderProgramBinaryCache::GetCacheExtension());
+}
+
+bool ShaderProgramBinaryCache::Load(GLId programId,
+                                    Hash::HashType identityHash,
+                                    Hash::HashType cacheHash)
+{
+    if (!ShaderProgramBinaryCache::IsEnabled() ||
+        !GL::IsProgramBinarySupported())
+    {
+        return false;
+    }
+
+    const Path cacheFilepath =
+        ShaderProgramBinaryCache::GetCacheFilepath(identityHash, cacheHash);
+    if (!cacheFilepath.IsFile())
+    {
+        ++ShaderProgramBinaryCache::s_numMisses;
+        return false;
+    }
+
+    const Array<Byte> bytes = File::GetBytes(cacheFilepath);
+
+    std::size_t offset = 0;
+    uint binaryFormat = 0, binarySize = 0;
+    bool linked =
+        (CacheFile::ReadHeader(
+             bytes, &offset, CacheMagic, CacheVersion, cacheHash) &&
+         CacheFile::ReadValue(bytes, &offset, &binaryFormat) &&
+         CacheFile::ReadValue(bytes, &offset, &binarySize) && binarySize > 0 &&
+         offset + binarySize == bytes.Size());
+    if (linked)
+    {
+        Array<Byte> binary(binarySize);
+        std::memcpy(binary.Data(), bytes.Data() + offset, binarySize);
+        linked = GL::ProgramBinary(programId, binaryFormat, binary);
+    }
+
+    // Rejected or corrupt binaries get replaced on the next save
+    if (!linked)
+    {
+        File::Remove(cacheFilepath);
+        ++ShaderProgramBinaryCache::s_numMisses;
+        return false;
+    }
+
+    ++ShaderProgramBinaryCache::s_numHits;
+    return true;
+}
+
+bool ShaderProgramBinaryCache::Save(GLId programId,
+                                    Hash::HashType identityHash,
+                                    Hash::HashType cacheHash)
+{
+    const Path cacheFilepath =
+        ShaderProgramBinaryCache::GetCacheFilepath(identityHash, cacheHash);
+    if (cacheFilepath.IsEmpty() || !ShaderProgramBinaryCache::IsEnabled() ||
+        !GL::IsProgramBinarySupported())
+    {
+        return false;
+    }
+
+    GLenum binaryFormat = 0;
+    Array<Byte> binary;
+    if (!GL::GetProgramBinary(programId, &binaryFormat, &binary))
+    {
+        return false;
+    }
+
+    Array<Byte> bytes;
+    CacheFile::WriteHeader(&bytes, CacheMagic, CacheVersion, cacheHash);
+    CacheFile::WriteValue<uint>(&bytes, SCAST<uint>(binaryFormat));
+    CacheFile::WriteValue<uint>(&bytes, binary.Size());
+    bytes.PushBack(binary.Begin(), binary.End());
+
+    if (!File::CreateDir(cacheFilepath.GetDirectory().GetDirectory()) ||
+        !File::CreateDir(cacheFilepath.GetDirectory()))
+    {
+        return false;
+    }
+    File::Write(cacheFilepath, bytes.Data(), bytes.Size());
+    if (!cacheFilepath.IsFile())
+    {
+        return false;
+    }
+
+    CacheFile::RemoveStaleEntries(cacheFilepath);
+    return true;
+}
+
+void ShaderProgramBinaryCache::SetEnabled(bool enabled)
+{
+    ShaderProgramBinaryCache::s_enabled = enabled;
+}
+
+bool ShaderProgramBinaryCache::IsEnabled()
+{
+    return ShaderProgramBinaryCache::s_enabled;
+}
+
+uint ShaderProgramBinaryCache::GetNumHits()
+{
+    return ShaderProgramBinaryCache::s_numHits;
+}
+
+uint ShaderProgramBinaryCache::GetNumMisses()
+{
+    return ShaderProgramBinaryCache::s_numMisses;
+}
+
+String ShaderProgramBinaryCache::GetCacheExtension()
+{
+    return "bprog";
+}
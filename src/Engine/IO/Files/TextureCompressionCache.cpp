@@ -0,0 +1,112 @@
+#include "Bang/TextureCompressionCache.h"
+
+#include <cstring>
+
+#include "Bang/Array.tcc"
+#include "Bang/CacheFile.h"
+#include "Bang/File.h"
+#include "Bang/Vector2.h"
+
+using namespace Bang;
+
+constexpr uint TextureCompressionCache::CacheMagic;
+constexpr uint TextureCompressionCache::CacheVersion;
+
+Hash::HashType TextureCompressionCache::GetCacheHash(
+    const Path &imageFilepath,
+    TextureCompression compression)
+{
+    Hash::HashType hash = Hash::ComputeValue(CacheVersion);
+    hash = Hash::ComputeValue(SCAST<int>(compression), hash);
+    hash = Hash::ComputeFile(imageFilepath, hash);
+    return hash;
+}
+
+Path TextureCompressionCache::GetCacheFilepath(const Path &imageFilepath,
+                                               Hash::HashType cacheHash)
+{
+    if (!imageFilepath.IsFile())
+    {
+        return Path::Empty();
+    }
+
+    return CacheFile::GetFilepath(
+        imageFilepath, cacheHash, TextureCompressionCache::GetCacheExtension());
+}
+
+bool TextureCompressionCache::Read(const Path &cacheFilepath,
+                                   Hash::HashType cacheHash,
+                                   Array<CompressedMipMap> *mipMaps)
+{
+    if (!cacheFilepath.IsFile())
+    {
+        return false;
+    }
+
+    const Array<Byte> bytes = File::GetBytes(cacheFilepath);
+
+    std::size_t offset = 0;
+    uint numMipMaps = 0;
+    if (!CacheFile::ReadHeader(
+            bytes, &offset, CacheMagic, CacheVersion, cacheHash) ||
+        !CacheFile::ReadValue(bytes, &offset, &numMipMaps) || numMipMaps == 0)
+    {
+        return false;
+    }
+
+    Array<CompressedMipMap> readMipMaps(numMipMaps);
+    for (CompressedMipMap &mipMap : readMipMaps)
+    {
+        uint dataSize = 0;
+        if (!CacheFile::ReadValue(bytes, &offset, &mipMap.size) ||
+            !CacheFile::ReadValue(bytes, &offset, &dataSize) ||
+            offset + dataSize > bytes.Size())
+        {
+            return false;
+        }
+
+        mipMap.data.Resize(dataSize);
+        if (dataSize > 0)
+        {
+            std::memcpy(mipMap.data.Data(), bytes.Data() + offset, dataSize);
+        }
+        offset += dataSize;
+    }
+
+    *mipMaps = readMipMaps;
+    return true;
+}
+
+bool TextureCompressionCache::Write(const Path &cacheFilepath,
+                                    Hash::HashType cacheHash,
+                                    const Array<CompressedMipMap> &mipMaps)
+{
+    if (cacheFilepath.IsEmpty())
+    {
+        return false;
+    }
+
+    Array<Byte> bytes;
+    CacheFile::WriteHeader(&bytes, CacheMagic, CacheVersion, cacheHash);
+    CacheFile::WriteValue<uint>(&bytes, mipMaps.Size());
+    for (const CompressedMipMap &mipMap : mipMaps)
+    {
+        CacheFile::WriteValue<Vector2i>(&bytes, mipMap.size);
+        CacheFile::WriteValue<uint>(&bytes, mipMap.data.Size());
+        bytes.PushBack(mipMap.data.Begin(), mipMap.data.End());
+    }
+
+    File::Write(cacheFilepath, bytes.Data(), bytes.Size());
+    if (!cacheFilepath.IsFile())
+    {
+        return false;
+    }
+
+    CacheFile::RemoveStaleEntries(cacheFilepath);
+    return true;
+}
+
+String TextureCompressionCache::GetCacheExtension()
+{
+    return "btex";
+}
@@ -221,6 +221,11 @@ Path Paths::GetProjectLibrariesDir()
     return GetProjectDir().Append("Libraries");
 }
 
+Path Paths::GetProjectCacheDir()
+{
+    return GetProjectDir().Append("Cache");
+}
+
 void Paths::FindCompilerPaths(Path *compilerPath,
                               Path *linkerPath,
                               Path *msvcConfigureArchitectureBatPath,
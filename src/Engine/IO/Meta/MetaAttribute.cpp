@@ -1,7 +1,29 @@
 #include "Bang/MetaAttribute.h"
 
+#include <sstream>
+
+#include "Bang/Color.h"
+#include "Bang/Quaternion.h"
+#include "Bang/StreamOperators.h"
+#include "Bang/Vector2.h"
+#include "Bang/Vector3.h"
+#include "Bang/Vector4.h"
+
 using namespace Bang;
 
+namespace
+{
+template <class T>
+String NativeToString(const Byte *bytes)
+{
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    std::ostringstream oss;
+    oss << value;
+    return String(oss.str());
+}
+}  // namespace
+
 MetaAttribute::MetaAttribute()
 {
 }
@@ -24,9 +46,110 @@ const String &MetaAttribute::GetName() const
 
 const String &MetaAttribute::GetStringValue() const
 {
+    if (m_valueStringOutdated)
+    {
+        m_value = IsArray() ? "" : GetElementStringValue(0);
+        m_valueStringOutdated = false;
+    }
     return m_value;
 }
 
+void MetaAttribute::SetNativeValue(MetaValueType type,
+                                   const Byte *bytes,
+                                   std::size_t numElements,
+                                   bool isArray)
+{
+    m_type = type;
+    m_isArray = isArray;
+    m_numElements = numElements;
+
+    const std::size_t numBytes =
+        numElements * MetaAttribute::GetNativeTypeSize(type);
+    m_nativeBytes.Resize(numBytes);
+    if (numBytes > 0)
+    {
+        std::memcpy(m_nativeBytes.Data(), bytes, numBytes);
+    }
+
+    m_value = "";
+    m_valueStringOutdated = (m_type != MetaValueType::STRING);
+}
+
+MetaValueType MetaAttribute::GetType() const
+{
+    return m_type;
+}
+
+bool MetaAttribute::IsNative() const
+{
+    return (GetType() != MetaValueType::STRING);
+}
+
+bool MetaAttribute::IsArray() const
+{
+    return m_isArray;
+}
+
+std::size_t MetaAttribute::GetNumElements() const
+{
+    return m_numElements;
+}
+
+const Array<Byte> &MetaAttribute::GetNativeBytes() const
+{
+    return m_nativeBytes;
+}
+
+String MetaAttribute::GetElementStringValue(uint elementIndex) const
+{
+    if (!IsNative() || elementIndex >= GetNumElements())
+    {
+        return IsArray() ? "" : m_value;
+    }
+
+    const Byte *bytes = GetNativeBytes().Data() +
+                        elementIndex * GetNativeTypeSize(GetType());
+    switch (GetType())
+    {
+        case MetaValueType::INT: return NativeToString<int>(bytes);
+        case MetaValueType::UINT: return NativeToString<uint>(bytes);
+        case MetaValueType::FLOAT: return NativeToString<float>(bytes);
+        case MetaValueType::DOUBLE: return NativeToString<double>(bytes);
+        case MetaValueType::VECTOR2: return NativeToString<Vector2>(bytes);
+        case MetaValueType::VECTOR3: return NativeToString<Vector3>(bytes);
+        case MetaValueType::VECTOR4: return NativeToString<Vector4>(bytes);
+        case MetaValueType::VECTOR2i: return NativeToString<Vector2i>(bytes);
+        case MetaValueType::VECTOR3i: return NativeToString<Vector3i>(bytes);
+        case MetaValueType::VECTOR4i: return NativeToString<Vector4i>(bytes);
+        case MetaValueType::QUATERNION:
+            return NativeToString<Quaternion>(bytes);
+        case MetaValueType::COLOR: return NativeToString<Color>(bytes);
+        case MetaValueType::STRING: break;
+    }
+    return "";
+}
+
+uint MetaAttribute::GetNativeTypeSize(MetaValueType type)
+{
+    switch (type)
+    {
+        case MetaValueType::INT: return sizeof(int);
+        case MetaValueType::UINT: return sizeof(uint);
+        case MetaValueType::FLOAT: return sizeof(float);
+        case MetaValueType::DOUBLE: return sizeof(double);
+        case MetaValueType::VECTOR2: return sizeof(Vector2);
+        case MetaValueType::VECTOR3: return sizeof(Vector3);
+        case MetaValueType::VECTOR4: return sizeof(Vector4);
+        case MetaValueType::VECTOR2i: return sizeof(Vector2i);
+        case MetaValueType::VECTOR3i: return sizeof(Vector3i);
+        case MetaValueType::VECTOR4i: return sizeof(Vector4i);
+        case MetaValueType::QUATERNION: return sizeof(Quaternion);
+        case MetaValueType::COLOR: return sizeof(Color);
+        case MetaValueType::STRING: break;
+    }
+    return 0;
+}
+
 String MetaAttribute::ToString() const
 {
     String str = "";
@@ -78,7 +201,18 @@ MetaAttribute MetaAttribute::FromString(const String &string)
 
 bool MetaAttribute::operator==(const MetaAttribute &rhs) const
 {
-    return GetName() == rhs.GetName() && m_value == rhs.m_value;
+    if (GetName() != rhs.GetName())
+    {
+        return false;
+    }
+
+    if (IsNative() && GetType() == rhs.GetType() &&
+        IsArray() == rhs.IsArray())
+    {
+        return GetNativeBytes() == rhs.GetNativeBytes();
+    }
+    return !IsArray() && !rhs.IsArray() &&
+           GetStringValue() == rhs.GetStringValue();
 }
 
 bool MetaAttribute::operator!=(const MetaAttribute &rhs) const
@@ -89,6 +223,11 @@ bool MetaAttribute::operator!=(const MetaAttribute &rhs) const
 void MetaAttribute::SetValue(const String &value)
 {
     m_value = value;
+    m_valueStringOutdated = false;
+    m_type = MetaValueType::STRING;
+    m_isArray = false;
+    m_numElements = 0;
+    m_nativeBytes.Clear();
 }
 
 void MetaAttribute::SetName(const String &name)
@@ -72,7 +72,7 @@ std::pair<Path, GUID> MetaFilesManager::CreateMetaFileIfMissing(
         MetaNode metaNode;
         newGUID = GUIDManager::GetNewGUID();
         metaNode.Set("GUID", newGUID);
-        File::Write(metaFilepath, metaNode.ToString());
+        metaNode.ExportToFile(metaFilepath, MetaFilesManager::GetMetaFormat());
         MetaFilesManager::RegisterMetaFilepath(metaFilepath);
     }
     else
@@ -115,10 +115,39 @@ void MetaFilesManager::DuplicateMetaFile(const Path &filepath,
     originalMetaNode.Import(originalMetaFilepath);
     originalMetaNode.Set("GUID", newGUID);
 
-    File::Write(dupMetaFilepath, originalMetaNode.ToString());
+    originalMetaNode.ExportToFile(
+        dupMetaFilepath, MetaNode::GetFileFormat(originalMetaFilepath));
     RegisterMetaFilepath(dupMetaFilepath);
 }
 
+void MetaFilesManager::SetMetaFormat(MetaFormat metaFormat)
+{
+    MetaFilesManager::GetInstance()->m_metaFormat = metaFormat;
+}
+
+MetaFormat MetaFilesManager::GetMetaFormat()
+{
+    return MetaFilesManager::GetInstance()->m_metaFormat;
+}
+
+void MetaFilesManager::ConvertMetaFiles(const Path &directory,
+                                        MetaFormat metaFormat)
+{
+    Array<String> extensions = {GetMetaExtension()};
+    Array<Path> metaFilepaths =
+        directory.GetFiles(FindFlag::RECURSIVE_HIDDEN, extensions);
+    for (const Path &metaFilepath : metaFilepaths)
+    {
+        if (IsMetaFile(metaFilepath) &&
+            MetaNode::GetFileFormat(metaFilepath) != metaFormat)
+        {
+            MetaNode metaNode;
+            metaNode.Import(metaFilepath);
+            metaNode.ExportToFile(metaFilepath, metaFormat);
+        }
+    }
+}
+
 GUIDManager *MetaFilesManager::GetGUIDManager()
 {
     return &(MetaFilesManager::GetInstance()->m_GUIDManager);
@@ -1,5 +1,7 @@
 #include "Bang/MetaNode.h"
 
+#include <cstring>
+#include <fstream>
 #include <map>
 #include <ostream>
 #include <string>
@@ -11,6 +13,7 @@
 #include "Bang/MetaNode.tcc"
 #include "Bang/Path.h"
 #include "Bang/StreamOperators.h"
+#include "Bang/UMap.tcc"
 #include "yaml-cpp/emitter.h"
 #include "yaml-cpp/emittermanip.h"
 #include "yaml-cpp/node/detail/iterator.h"
@@ -21,6 +24,59 @@
 
 using namespace Bang;
 
+namespace
+{
+void WriteUint(Array<Byte> *bytes, uint value)
+{
+    const Byte *valueBytes = RCAST<const Byte *>(&value);
+    bytes->PushBack(valueBytes, valueBytes + sizeof(uint));
+}
+
+bool ReadUint(const Array<Byte> &bytes, std::size_t *offset, uint *value)
+{
+    if (*offset + sizeof(uint) > bytes.Size())
+    {
+        return false;
+    }
+    std::memcpy(value, bytes.Data() + *offset, sizeof(uint));
+    *offset += sizeof(uint);
+    return true;
+}
+
+bool ReadStringId(const Array<Byte> &bytes,
+                  std::size_t *offset,
+                  const Array<String> &strings,
+                  const String **str)
+{
+    uint stringId = 0;
+    if (!ReadUint(bytes, offset, &stringId) || stringId >= strings.Size())
+    {
+        return false;
+    }
+    *str = &strings[stringId];
+    return true;
+}
+
+uint GetStringId(const String &str,
+                 UMap<String, uint> *stringIds,
+                 Array<String> *strings)
+{
+    auto it = stringIds->Find(str);
+    if (it != stringIds->End())
+    {
+        return it->second;
+    }
+
+    const uint stringId = strings->Size();
+    stringIds->Add(str, stringId);
+    strings->PushBack(str);
+    return stringId;
+}
+}  // namespace
+
+constexpr uint MetaNode::BinaryMagic;
+constexpr uint MetaNode::BinaryVersion;
+
 MetaNode::MetaNode()
 {
 }
@@ -64,6 +120,13 @@ bool MetaNode::Contains(const String &attrName) const
 
 void MetaNode::Set(const MetaAttribute &attribute)
 {
+    // A native array replaces the flattened one too (from YAML, or from a
+    // previous Import)
+    if (attribute.IsArray())
+    {
+        RemoveArray(attribute.GetName());
+    }
+
     MetaAttribute *attr = GetAttribute(attribute.GetName());
     if (!attr)
     {
@@ -86,6 +149,20 @@ void MetaNode::RemoveChildren(const String &childrenContainerName)
     m_children.Remove(childrenContainerName);
 }
 
+void MetaNode::RemoveArray(const String &name)
+{
+    m_attributes.Remove(name);
+    for (uint i = 0;; ++i)
+    {
+        const String attrNamei = name + "_" + String::ToString(i);
+        if (!Contains(attrNamei))
+        {
+            break;
+        }
+        m_attributes.Remove(attrNamei);
+    }
+}
+
 void MetaNode::RemoveAttribute(const String &attributeName)
 {
     for (auto it = m_attributes.Begin(); it != m_attributes.End();)
@@ -104,15 +181,8 @@ void MetaNode::RemoveAttribute(const String &attributeName)
 
 MetaAttribute *MetaNode::GetAttribute(const String &attributeName) const
 {
-    for (auto &itPair : m_attributes)
-    {
-        MetaAttribute &attr = itPair.second;
-        if (attr.GetName() == attributeName)
-        {
-            return &attr;
-        }
-    }
-    return nullptr;
+    auto it = m_attributes.Find(attributeName);
+    return (it != m_attributes.End()) ? &(it->second) : nullptr;
 }
 
 String MetaNode::GetAttributeValue(const String &attributeName) const
@@ -176,8 +246,19 @@ void MetaNode::ToStringInner(YAML::Emitter &out) const
     for (const auto &pair : GetAttributes())
     {
         const MetaAttribute &attr = pair.second;
-        out << YAML::Key << attr.GetName();
-        out << YAML::Value << attr.GetStringValue();
+        if (attr.IsArray())
+        {
+            for (uint i = 0; i < attr.GetNumElements(); ++i)
+            {
+                out << YAML::Key << attr.GetName() + "_" + String::ToString(i);
+                out << YAML::Value << attr.GetElementStringValue(i);
+            }
+        }
+        else
+        {
+            out << YAML::Key << attr.GetName();
+            out << YAML::Value << attr.GetStringValue();
+        }
     }
 
     for (const auto &pair : GetAllChildren())
@@ -202,6 +283,85 @@ void MetaNode::ToString(YAML::Emitter &out) const
     out << YAML::EndMap;
 }
 
+void MetaNode::ToBinary(Array<Byte> *bytes) const
+{
+    // Names and values are very repetitive (class names, booleans, etc.), so
+    // they are stored once in a strings table, and the nodes only keep ids
+    UMap<String, uint> stringIds;
+    Array<String> strings;
+    Array<Byte> nodeBytes;
+    ToBinaryInner(&nodeBytes, &stringIds, &strings);
+
+    WriteUint(bytes, BinaryMagic);
+    WriteUint(bytes, BinaryVersion);
+    WriteUint(bytes, strings.Size());
+    for (const String &str : strings)
+    {
+        WriteUint(bytes, str.Size());
+        const Byte *strBytes = RCAST<const Byte *>(str.ToCString());
+        bytes->PushBack(strBytes, strBytes + str.Size());
+    }
+    bytes->PushBack(nodeBytes.Begin(), nodeBytes.End());
+}
+
+void MetaNode::ToBinaryInner(Array<Byte> *bytes,
+                             UMap<String, uint> *stringIds,
+                             Array<String> *strings) const
+{
+    WriteUint(bytes, GetStringId(GetName(), stringIds, strings));
+
+    WriteUint(bytes, GetAttributes().Size());
+    for (const auto &pair : GetAttributes())
+    {
+        const MetaAttribute &attr = pair.second;
+        WriteUint(bytes, GetStringId(attr.GetName(), stringIds, strings));
+        WriteUint(bytes, SCAST<uint>(attr.GetType()));
+        if (attr.IsNative())
+        {
+            // Raw values, no strings involved
+            WriteUint(bytes, attr.IsArray() ? 1 : 0);
+            WriteUint(bytes, SCAST<uint>(attr.GetNumElements()));
+            bytes->PushBack(attr.GetNativeBytes().Begin(),
+                            attr.GetNativeBytes().End());
+        }
+        else
+        {
+            WriteUint(bytes,
+                      GetStringId(attr.GetStringValue(), stringIds, strings));
+        }
+    }
+
+    WriteUint(bytes, GetAllChildren().Size());
+    for (const auto &pair : GetAllChildren())
+    {
+        const String &childrenContainerName = pair.first;
+        const Array<MetaNode> &childrenMetas = pair.second;
+        WriteUint(bytes,
+                  GetStringId(childrenContainerName, stringIds, strings));
+        WriteUint(bytes, childrenMetas.Size());
+        for (const MetaNode &childMeta : childrenMetas)
+        {
+            childMeta.ToBinaryInner(bytes, stringIds, strings);
+        }
+    }
+}
+
+void MetaNode::ExportToFile(const Path &filepath, MetaFormat format) const
+{
+    switch (format)
+    {
+        case MetaFormat::YAML: File::Write(filepath, ToString()); break;
+
+        case MetaFormat::BINARY:
+        {
+            Array<Byte> bytes;
+            ToBinary(&bytes);
+            File::Write(filepath, bytes.Data(), bytes.Size());
+        }
+        break;
+    }
+}
+
 const String &MetaNode::GetName() const
 {
     return m_name;
@@ -219,7 +379,23 @@ const Map<String, Array<MetaNode>> &MetaNode::GetAllChildren() const
 
 void MetaNode::Import(const MetaNode &metaNode)
 {
-    Import(metaNode.ToString());
+    // Same result as importing metaNode.ToString(), but without going through
+    // YAML emission and parsing
+    SetName(metaNode.GetName());
+
+    for (const auto &pair : metaNode.GetAttributes())
+    {
+        Set(pair.second);
+    }
+
+    for (const auto &pair : metaNode.GetAllChildren())
+    {
+        const String &childrenContainerName = pair.first;
+        for (const MetaNode &childMetaNode : pair.second)
+        {
+            AddChild(childMetaNode, childrenContainerName);
+        }
+    }
 }
 
 const Array<MetaNode> &MetaNode::GetChildren(
@@ -289,8 +465,20 @@ void MetaNode::Import(const Path &filepath)
 {
     if (filepath.IsFile())
     {
-        String fileContents = File::GetContents(filepath);
-        Import(fileContents);
+        const Array<Byte> fileBytes = File::GetBytes(filepath);
+        if (MetaNode::IsBinary(fileBytes))
+        {
+            if (!ImportBinary(fileBytes))
+            {
+                Debug_Error("Binary meta file " << filepath
+                                                << " could not be read");
+            }
+        }
+        else
+        {
+            Import(String(std::string(
+                RCAST<const char *>(fileBytes.Data()), fileBytes.Size())));
+        }
     }
     else
     {
@@ -298,10 +486,163 @@ void MetaNode::Import(const Path &filepath)
     }
 }
 
+bool MetaNode::ImportBinary(const Array<Byte> &bytes)
+{
+    if (!MetaNode::IsBinary(bytes))
+    {
+        return false;
+    }
+
+    std::size_t offset = sizeof(uint);
+    uint version = 0;
+    if (!ReadUint(bytes, &offset, &version) || version != BinaryVersion)
+    {
+        return false;
+    }
+
+    uint numStrings = 0;
+    if (!ReadUint(bytes, &offset, &numStrings))
+    {
+        return false;
+    }
+
+    Array<String> strings;
+    strings.Reserve(numStrings);
+    for (uint i = 0; i < numStrings; ++i)
+    {
+        uint strSize = 0;
+        if (!ReadUint(bytes, &offset, &strSize) ||
+            offset + strSize > bytes.Size())
+        {
+            return false;
+        }
+        strings.PushBack(String(std::string(
+            RCAST<const char *>(bytes.Data() + offset), strSize)));
+        offset += strSize;
+    }
+
+    return ImportBinaryInner(bytes, &offset, strings);
+}
+
+bool MetaNode::ImportBinaryInner(const Array<Byte> &bytes,
+                                 std::size_t *offset,
+                                 const Array<String> &strings)
+{
+    const String *name = nullptr;
+    if (!ReadStringId(bytes, offset, strings, &name))
+    {
+        return false;
+    }
+    SetName(*name);
+
+    uint numAttributes = 0;
+    if (!ReadUint(bytes, offset, &numAttributes))
+    {
+        return false;
+    }
+    for (uint i = 0; i < numAttributes; ++i)
+    {
+        const String *attrName = nullptr;
+        uint attrType = 0;
+        if (!ReadStringId(bytes, offset, strings, &attrName) ||
+            !ReadUint(bytes, offset, &attrType) ||
+            attrType > SCAST<uint>(MetaValueType::COLOR))
+        {
+            return false;
+        }
+
+        const MetaValueType type = SCAST<MetaValueType>(attrType);
+        if (type == MetaValueType::STRING)
+        {
+            const String *attrValue = nullptr;
+            if (!ReadStringId(bytes, offset, strings, &attrValue))
+            {
+                return false;
+            }
+            Set(*attrName, *attrValue);
+        }
+        else
+        {
+            uint isArray = 0, numElements = 0;
+            if (!ReadUint(bytes, offset, &isArray) ||
+                !ReadUint(bytes, offset, &numElements))
+            {
+                return false;
+            }
+
+            // Checked with a division, so that a corrupt number of elements
+            // can not wrap the size around
+            const std::size_t typeSize = MetaAttribute::GetNativeTypeSize(type);
+            if (SCAST<std::size_t>(numElements) >
+                    (bytes.Size() - *offset) / typeSize ||
+                (isArray == 0 && numElements != 1))
+            {
+                return false;
+            }
+            const std::size_t numBytes = numElements * typeSize;
+
+            MetaAttribute attr;
+            attr.SetName(*attrName);
+            attr.SetNativeValue(
+                type, bytes.Data() + *offset, numElements, (isArray != 0));
+            *offset += numBytes;
+            Set(attr);
+        }
+    }
+
+    uint numChildrenContainers = 0;
+    if (!ReadUint(bytes, offset, &numChildrenContainers))
+    {
+        return false;
+    }
+    for (uint i = 0; i < numChildrenContainers; ++i)
+    {
+        const String *childrenContainerName = nullptr;
+        uint numChildren = 0;
+        if (!ReadStringId(bytes, offset, strings, &childrenContainerName) ||
+            !ReadUint(bytes, offset, &numChildren))
+        {
+            return false;
+        }
+
+        CreateChildrenContainer(*childrenContainerName);
+        Array<MetaNode> &children = m_children[*childrenContainerName];
+        for (uint j = 0; j < numChildren; ++j)
+        {
+            children.PushBack(MetaNode());
+            if (!children.Back().ImportBinaryInner(bytes, offset, strings))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool MetaNode::IsBinary(const Array<Byte> &bytes)
+{
+    uint magic = 0;
+    std::size_t offset = 0;
+    return ReadUint(bytes, &offset, &magic) && (magic == BinaryMagic);
+}
+
+MetaFormat MetaNode::GetFileFormat(const Path &filepath)
+{
+    Array<Byte> headerBytes(sizeof(uint), 0);
+    std::ifstream ifs(filepath.GetAbsolute().ToCString(), std::ios::binary);
+    if (ifs.is_open() &&
+        ifs.read(RCAST<char *>(headerBytes.Data()), headerBytes.Size()) &&
+        MetaNode::IsBinary(headerBytes))
+    {
+        return MetaFormat::BINARY;
+    }
+    return MetaFormat::YAML;
+}
+
 bool MetaNode::operator==(const MetaNode &rhs) const
 {
     return (m_name == rhs.m_name) && (m_children == rhs.m_children) &&
-           (m_attributes == m_attributes);
+           (m_attributes == rhs.m_attributes);
 }
 
 bool MetaNode::operator!=(const MetaNode &rhs) const
@@ -0,0 +1,146 @@
+#include "Bang/AABoxBVH.h"
+
+#include <algorithm>
+#include <array>
+
+#include "Bang/Array.tcc"
+#include "Bang/Assert.h"
+
+using namespace Bang;
+
+constexpr uint AABoxBVH::MaxLeafSize;
+
+AABoxBVH::AABoxBVH()
+{
+}
+
+void AABoxBVH::Build(const Array<AABox> &aaBoxes)
+{
+    Clear();
+    m_aaBoxes = aaBoxes;
+    m_centers.Resize(aaBoxes.Size());
+    for (uint i = 0; i < aaBoxes.Size(); ++i)
+    {
+        if (aaBoxes[i] == AABox::Empty())
+        {
+            m_unboundedIndices.PushBack(i);
+        }
+        else
+        {
+            m_centers[i] = aaBoxes[i].GetCenter();
+            m_indices.PushBack(i);
+        }
+    }
+
+    if (!m_indices.IsEmpty())
+    {
+        m_nodes.Reserve(2 * (m_indices.Size() / MaxLeafSize) + 1);
+        BuildNode(0, m_indices.Size());
+    }
+}
+
+void AABoxBVH::Clear()
+{
+    m_nodes.Clear();
+    m_aaBoxes.Clear();
+    m_centers.Clear();
+    m_indices.Clear();
+    m_unboundedIndices.Clear();
+}
+
+void AABoxBVH::Query(const OverlapsFunction &overlaps,
+                     Array<uint> *indices) const
+{
+    const uint prevNumIndices = indices->Size();
+    indices->PushBack(m_unboundedIndices);
+
+    // Median splits keep the depth logarithmic, so the stack can not grow
+    // past a few dozens of nodes
+    std::array<uint, 64> nodesStack;
+    uint stackSize = 0;
+    if (!m_nodes.IsEmpty())
+    {
+        nodesStack[stackSize++] = 0;
+    }
+
+    while (stackSize > 0)
+    {
+        const uint nodeIndex = nodesStack[--stackSize];
+        const Node &node = m_nodes[nodeIndex];
+        if (!overlaps(node.aaBox))
+        {
+            continue;
+        }
+
+        if (node.count > 0)
+        {
+            for (uint i = node.begin; i < node.begin + node.count; ++i)
+            {
+                const uint index = m_indices[i];
+                if (overlaps(m_aaBoxes[index]))
+                {
+                    indices->PushBack(index);
+                }
+            }
+        }
+        else
+        {
+            ASSERT(stackSize + 2 <= nodesStack.size());
+            nodesStack[stackSize++] = node.secondChild;
+            nodesStack[stackSize++] = (nodeIndex + 1);
+        }
+    }
+
+    std::sort(indices->Begin() + prevNumIndices, indices->End());
+}
+
+uint AABoxBVH::GetNumNodes() const
+{
+    return m_nodes.Size();
+}
+
+void AABoxBVH::BuildNode(uint begin, uint end)
+{
+    const uint nodeIndex = m_nodes.Size();
+    m_nodes.PushBack(Node());
+
+    AABox nodeAABox;
+    AABox centersAABox;
+    for (uint i = begin; i < end; ++i)
+    {
+        nodeAABox = AABox::Union(nodeAABox, m_aaBoxes[m_indices[i]]);
+        centersAABox.AddPoint(m_centers[m_indices[i]]);
+    }
+    m_nodes[nodeIndex].aaBox = nodeAABox;
+
+    if (end - begin <= MaxLeafSize)
+    {
+        m_nodes[nodeIndex].begin = begin;
+        m_nodes[nodeIndex].count = (end - begin);
+        return;
+    }
+
+    // Split by the median center along the longest axis of the centers
+    const Vector3 centersSize = centersAABox.GetSize();
+    int axis = 0;
+    if (centersSize.y > centersSize[axis])
+    {
+        axis = 1;
+    }
+    if (centersSize.z > centersSize[axis])
+    {
+        axis = 2;
+    }
+
+    const uint middle = (begin + end) / 2;
+    std::nth_element(m_indices.Begin() + begin,
+                     m_indices.Begin() + middle,
+                     m_indices.Begin() + end,
+                     [this, axis](uint lhs, uint rhs) {
+                         return m_centers[lhs][axis] < m_centers[rhs][axis];
+                     });
+
+    BuildNode(begin, middle);
+    m_nodes[nodeIndex].secondChild = m_nodes.Size();
+    BuildNode(middle, end);
+}
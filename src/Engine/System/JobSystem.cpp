@@ -0,0 +1,330 @@
+#include "Bang/JobSystem.h"
+
+#include <thread>
+
+#include "Bang/Application.h"
+#include "Bang/Array.tcc"
+#include "Bang/Math.h"
+#include "Bang/MutexLocker.h"
+#include "Bang/Thread.h"
+
+using namespace Bang;
+
+// Set in every worker thread, so that jobs scheduled from a worker go to its
+// own deque instead of the shared one
+static thread_local JobSystem *s_workerJobSystem = nullptr;
+static thread_local int s_workerIndex = -1;
+
+Job::Job() : m_pendingDependencies(1), m_finished(false)
+{
+}
+
+Job::~Job()
+{
+}
+
+bool Job::IsFinished() const
+{
+    return m_finished;
+}
+
+JobSystem::JobSystem() : m_numQueuedJobs(0), m_exiting(false)
+{
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_exiting = true;
+    }
+    m_sleepCondition.notify_all();
+
+    // Workers drain the queues before exiting, so that every scheduled job
+    // (and the ThreadRunnables it may own) gets run
+    for (Thread *worker : m_workers)
+    {
+        worker->Join();
+        delete worker;
+    }
+
+    for (JobQueue *workerQueue : m_workerQueues)
+    {
+        delete workerQueue;
+    }
+}
+
+void JobSystem::Init(uint numWorkers)
+{
+    ASSERT(m_workers.IsEmpty());
+
+    if (numWorkers == 0)
+    {
+        numWorkers = JobSystem::GetDefaultNumWorkers();
+    }
+
+    for (uint i = 0; i < numWorkers; ++i)
+    {
+        m_workerQueues.PushBack(new JobQueue());
+    }
+
+    for (uint i = 0; i < numWorkers; ++i)
+    {
+        int workerIndex = SCAST<int>(i);
+        ThreadRunnable *workerRunnable = new ThreadRunnableLambda(
+            [this, workerIndex]() { WorkerLoop(workerIndex); });
+
+        String workerName = "BangJobWorker" + String::ToString(workerIndex);
+        Thread *worker = new Thread(workerRunnable, workerName);
+        m_workers.PushBack(worker);
+        worker->Start();
+    }
+}
+
+JobHandle JobSystem::Schedule(const JobFunction &jobFunction)
+{
+    return Schedule(jobFunction, Array<JobHandle>::Empty());
+}
+
+JobHandle JobSystem::Schedule(const JobFunction &jobFunction,
+                              const Array<JobHandle> &dependencies)
+{
+    JobHandle job = std::make_shared<Job>();
+    job->m_function = jobFunction;
+
+    for (const JobHandle &dependency : dependencies)
+    {
+        if (dependency)
+        {
+            MutexLocker ml(&dependency->m_continuationsMutex);
+            BANG_UNUSED(ml);
+            if (!dependency->IsFinished())
+            {
+                ++job->m_pendingDependencies;
+                dependency->m_continuations.PushBack(job);
+            }
+        }
+    }
+
+    // Release the scheduling reference. If all the dependencies were already
+    // finished, the job is ready right now
+    if (--job->m_pendingDependencies == 0)
+    {
+        Enqueue(job);
+    }
+    return job;
+}
+
+JobHandle JobSystem::ScheduleParallelFor(uint beginIndex,
+                                         uint endIndex,
+                                         uint grainSize,
+                                         const RangeFunction &rangeFunction)
+{
+    if (endIndex <= beginIndex)
+    {
+        return Schedule(nullptr);
+    }
+
+    const uint numIndices = (endIndex - beginIndex);
+    if (grainSize == 0)
+    {
+        // A few chunks per worker, so that stealing can balance the load
+        grainSize = Math::Max(numIndices / ((GetNumWorkers() + 1) * 4), 1u);
+    }
+
+    Array<JobHandle> chunkJobs;
+    chunkJobs.Reserve((numIndices + grainSize - 1) / grainSize);
+    for (uint chunkBegin = beginIndex; chunkBegin < endIndex;
+         chunkBegin += grainSize)
+    {
+        uint chunkEnd = Math::Min(chunkBegin + grainSize, endIndex);
+        chunkJobs.PushBack(Schedule([rangeFunction, chunkBegin, chunkEnd]() {
+            rangeFunction(chunkBegin, chunkEnd);
+        }));
+    }
+    return Schedule(nullptr, chunkJobs);
+}
+
+void JobSystem::ParallelFor(uint beginIndex,
+                            uint endIndex,
+                            uint grainSize,
+                            const RangeFunction &rangeFunction)
+{
+    Wait(ScheduleParallelFor(beginIndex, endIndex, grainSize, rangeFunction));
+}
+
+void JobSystem::Wait(const JobHandle &job)
+{
+    if (!job)
+    {
+        return;
+    }
+
+    while (!job->IsFinished())
+    {
+        if (!TryExecuteOneJob())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::Wait(const Array<JobHandle> &jobs)
+{
+    for (const JobHandle &job : jobs)
+    {
+        Wait(job);
+    }
+}
+
+uint JobSystem::GetNumWorkers() const
+{
+    return m_workers.Size();
+}
+
+bool JobSystem::IsWorkerThread() const
+{
+    return (s_workerJobSystem == this);
+}
+
+uint JobSystem::GetDefaultNumWorkers()
+{
+    // Leave one core for the main thread
+    uint numCores = std::thread::hardware_concurrency();
+    return Math::Max(numCores, 2u) - 1;
+}
+
+JobSystem *JobSystem::GetInstance()
+{
+    Application *app = Application::GetInstance();
+    return app ? app->GetJobSystem() : nullptr;
+}
+
+void JobSystem::Enqueue(const JobHandle &job)
+{
+    JobQueue *queue = IsWorkerThread() ? m_workerQueues[s_workerIndex]
+                                       : &m_sharedQueue;
+    {
+        MutexLocker ml(&queue->mutex);
+        BANG_UNUSED(ml);
+        queue->jobs.push_back(job);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        ++m_numQueuedJobs;
+    }
+    m_sleepCondition.notify_one();
+}
+
+JobHandle JobSystem::PopJob(int workerIndex)
+{
+    JobQueue *queue = m_workerQueues[workerIndex];
+    MutexLocker ml(&queue->mutex);
+    BANG_UNUSED(ml);
+    if (queue->jobs.empty())
+    {
+        return nullptr;
+    }
+
+    JobHandle job = queue->jobs.back();
+    queue->jobs.pop_back();
+    --m_numQueuedJobs;
+    return job;
+}
+
+JobHandle JobSystem::StealJob(int workerIndex)
+{
+    const int numQueues = SCAST<int>(m_workerQueues.Size()) + 1;
+    for (int i = 0; i < numQueues; ++i)
+    {
+        // Shared queue first, then the other workers, starting by the next
+        int queueIndex = (i == 0) ? -1 : ((workerIndex + i) % (numQueues - 1));
+        if (i > 0 && queueIndex == workerIndex)
+        {
+            continue;
+        }
+
+        JobQueue *queue =
+            (queueIndex < 0) ? &m_sharedQueue : m_workerQueues[queueIndex];
+        MutexLocker ml(&queue->mutex);
+        BANG_UNUSED(ml);
+        if (!queue->jobs.empty())
+        {
+            JobHandle job = queue->jobs.front();
+            queue->jobs.pop_front();
+            --m_numQueuedJobs;
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+bool JobSystem::TryExecuteOneJob()
+{
+    const int workerIndex = IsWorkerThread() ? s_workerIndex : -1;
+
+    JobHandle job = (workerIndex >= 0) ? PopJob(workerIndex) : nullptr;
+    if (!job)
+    {
+        job = StealJob(workerIndex);
+    }
+
+    if (job)
+    {
+        Execute(job);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::Execute(const JobHandle &job)
+{
+    if (job->m_function)
+    {
+        job->m_function();
+        job->m_function = nullptr;
+    }
+
+    Array<JobHandle> continuations;
+    {
+        MutexLocker ml(&job->m_continuationsMutex);
+        BANG_UNUSED(ml);
+        job->m_finished = true;
+        continuations = job->m_continuations;
+        job->m_continuations.Clear();
+    }
+
+    for (const JobHandle &continuation : continuations)
+    {
+        if (--continuation->m_pendingDependencies == 0)
+        {
+            Enqueue(continuation);
+        }
+    }
+}
+
+void JobSystem::WorkerLoop(int workerIndex)
+{
+    s_workerJobSystem = this;
+    s_workerIndex = workerIndex;
+
+    while (true)
+    {
+        if (TryExecuteOneJob())
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        if (m_exiting && m_numQueuedJobs <= 0)
+        {
+            break;
+        }
+        m_sleepCondition.wait(
+            lock, [this]() { return m_exiting || m_numQueuedJobs > 0; });
+    }
+
+    s_workerJobSystem = nullptr;
+    s_workerIndex = -1;
+}
@@ -2,7 +2,7 @@
 
 using namespace Bang;
 
-Mutex::Mutex()
+Mutex::Mutex() : m_isLocked(false)
 {
 }
 
@@ -12,29 +12,24 @@ Mutex::~Mutex()
 
 void Mutex::Lock()
 {
-    if (!IsLocked())
-    {
-        m_mutex.lock();
-        m_isLocked = true;
-    }
+    m_mutex.lock();
+    m_isLocked = true;
 }
 
 bool Mutex::TryLock()
 {
-    if (!IsLocked())
+    if (m_mutex.try_lock())
     {
-        return m_mutex.try_lock();
+        m_isLocked = true;
+        return true;
     }
-    return true;
+    return false;
 }
 
 void Mutex::UnLock()
 {
-    if (IsLocked())
-    {
-        m_mutex.unlock();
-        m_isLocked = false;
-    }
+    m_isLocked = false;
+    m_mutex.unlock();
 }
 
 bool Mutex::IsLocked() const
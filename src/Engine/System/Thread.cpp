@@ -10,7 +10,7 @@ namespace Bang
 {
 int ThreadFunc(ThreadRunnable *runnable, Thread *thread);
 
-Thread::Thread()
+Thread::Thread() : m_hasFinished(false)
 {
 }
 
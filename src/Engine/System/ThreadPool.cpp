@@ -1,13 +1,12 @@
 #include "Bang/ThreadPool.h"
 
-#include <list>
-
-#include "Bang/List.tcc"
+#include "Bang/JobSystem.h"
 #include "Bang/Thread.h"
 
 using namespace Bang;
 
 ThreadPool::ThreadPool()
+    : m_numRunningTasks(std::make_shared<std::atomic<int>>(0))
 {
 }
 
@@ -17,30 +16,31 @@ ThreadPool::~ThreadPool()
 
 bool ThreadPool::TryStart(ThreadRunnable *runnable)
 {
-    auto it = m_threadList.Begin();
-    while (it != m_threadList.End())
+    if (GetNumRunningTasks() >= GetMaxThreadCount())
     {
-        Thread *thread = *it;
-        if (thread->HasFinished())
-        {
-            it = m_threadList.Remove(it);
-        }
-        else
+        return false;
+    }
+
+    std::shared_ptr<std::atomic<int>> numRunningTasks = m_numRunningTasks;
+    auto runFunction = [runnable, numRunningTasks]() {
+        runnable->Run();
+        if (runnable->IsAutoDelete())
         {
-            ++it;
+            delete runnable;
         }
-    }
+        --(*numRunningTasks);
+    };
 
-    if (m_threadList.Size() >= m_maxThreadCount)
+    ++(*m_numRunningTasks);
+    if (JobSystem *jobSystem = JobSystem::GetInstance())
     {
-        return false;
+        jobSystem->Schedule(runFunction);
+    }
+    else
+    {
+        // No engine job workers (no Application), just run it right away
+        runFunction();
     }
-
-    String threadName = m_threadsName + String::ToString(m_threadList.Size());
-    Thread *thread = new Thread(runnable, threadName);
-    thread->Start();
-    thread->Detach();
-    m_threadList.PushBack(thread);
     return true;
 }
 
@@ -66,3 +66,8 @@ int ThreadPool::GetMaxThreadCount() const
 {
     return m_maxThreadCount;
 }
+
+int ThreadPool::GetNumRunningTasks() const
+{
+    return SCAST<int>(*m_numRunningTasks);
+}
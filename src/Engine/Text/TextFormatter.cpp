@@ -24,16 +24,17 @@ Array<TextFormatter::CharRect> TextFormatter::GetFormattedTextPositions(
     bool wrapping,
     uint *numberOfLines)
 {
-    if (content.IsEmpty())
+    const Array<uint> codepoints = TextFormatter::GetCodepoints(content);
+    if (codepoints.IsEmpty())
     {
         return Array<CharRect>();
     }
 
     // First create a list with all the character rects in the origin
     Array<CharRect> charRects;
-    for (uint i = 0; i < content.Size(); ++i)
+    for (uint i = 0; i < codepoints.Size(); ++i)
     {
-        const char c = content[i];
+        const uint c = codepoints[i];
         Vector2 size = Vector2(font->GetAtlasCharRectSize(fontSize, c));
         if (c == ' ')
         {
@@ -45,7 +46,7 @@ Array<TextFormatter::CharRect> TextFormatter::GetFormattedTextPositions(
     }
 
     Array<Array<CharRect>> linedCharRects =
-        SplitCharRectsInLines(content,
+        SplitCharRectsInLines(codepoints,
                               font,
                               fontSize,
                               limitsRect,
@@ -73,7 +74,7 @@ Array<TextFormatter::CharRect> TextFormatter::GetFormattedTextPositions(
 }
 
 Array<Array<TextFormatter::CharRect>> TextFormatter::SplitCharRectsInLines(
-    const String &content,
+    const Array<uint> &codepoints,
     const Font *font,
     int fontSize,
     const AARecti &limitsRect,
@@ -85,10 +86,10 @@ Array<Array<TextFormatter::CharRect>> TextFormatter::SplitCharRectsInLines(
 
     Vector2 penPosition(limitsRect.GetMinXMaxY());  // penPosition.y is baseline
     const float lineSkip = font->GetLineSkip(fontSize);
-    for (uint i = 0; i < content.Size(); ++i)
+    for (uint i = 0; i < codepoints.Size(); ++i)
     {
-        const float charAdvX = GetCharAdvanceX(content, font, fontSize, i);
-        bool lineBreak = (content[i] == '\n');
+        const float charAdvX = GetCharAdvanceX(codepoints, font, fontSize, i);
+        bool lineBreak = (codepoints[i] == '\n');
         bool addCharacterToLines = (!lineBreak);
         if (wrapping && !lineBreak)
         {
@@ -98,7 +99,7 @@ Array<Array<TextFormatter::CharRect>> TextFormatter::SplitCharRectsInLines(
             // Split the input char positions into the needed lines.
             // Each line will contain as many words as possible (split by
             // spaces).
-            if (content[i] != ' ')
+            if (codepoints[i] != ' ')
             {
                 breakLineBecauseOfWrapping =
                     (penPosition.x + charAdvX > limitsRect.GetMax().x);
@@ -109,14 +110,14 @@ Array<Array<TextFormatter::CharRect>> TextFormatter::SplitCharRectsInLines(
                 // Does the following word (after this space) still fits in
                 // the current line?
                 float tmpAdvX = penPosition.x + charAdvX;
-                for (uint j = i + 1; j < content.Size(); ++j)
+                for (uint j = i + 1; j < codepoints.Size(); ++j)
                 {
-                    if (content[j] == ' ')
+                    if (codepoints[j] == ' ')
                     {
                         break;
                     }
                     const float jCharAdvX =
-                        GetCharAdvanceX(content, font, fontSize, j);
+                        GetCharAdvanceX(codepoints, font, fontSize, j);
                     if (tmpAdvX + jCharAdvX > limitsRect.GetMax().x)
                     {
                         breakLineBecauseOfWrapping = true;
@@ -137,9 +138,9 @@ Array<Array<TextFormatter::CharRect>> TextFormatter::SplitCharRectsInLines(
             linedCharRects.PushBack(Array<CharRect>());
 
             // Skip all next ' '
-            if (content[i] == ' ')
+            if (codepoints[i] == ' ')
             {
-                while (i < content.Size() && content[i] == ' ')
+                while (i < codepoints.Size() && codepoints[i] == ' ')
                 {
                     ++i;
                 }
@@ -149,7 +150,7 @@ Array<Array<TextFormatter::CharRect>> TextFormatter::SplitCharRectsInLines(
 
         if (addCharacterToLines)
         {
-            CharRect cr(content[i], penPosition + charRects[i].rectPx);
+            CharRect cr(codepoints[i], penPosition + charRects[i].rectPx);
             linedCharRects.Back().PushBack(cr);
             penPosition.x += charAdvX * spacingMult.x;
         }
@@ -169,11 +170,12 @@ Vector2i TextFormatter::GetMinimumHeightTextSize(
         return Vector2i::Zero();
     }
 
+    const Array<uint> codepoints = TextFormatter::GetCodepoints(content);
     Vector2 textSize = Vector2::Zero();
     float currentLineWidth = 0.0f;
-    for (uint i = 0; i < content.Size(); ++i)
+    for (uint i = 0; i < codepoints.Size(); ++i)
     {
-        char c = content[i];
+        const uint c = codepoints[i];
         if (c == '\n')
         {
             textSize.y += font->GetLineSkip(fontSize);
@@ -182,7 +184,7 @@ Vector2i TextFormatter::GetMinimumHeightTextSize(
         else
         {
             int charAdvX =
-                SCAST<int>(GetCharAdvanceX(content, font, fontSize, i));
+                SCAST<int>(GetCharAdvanceX(codepoints, font, fontSize, i));
             currentLineWidth += charAdvX * spacingMultiplier.x;
             textSize.x = Math::Max(textSize.x, currentLineWidth);
         }
@@ -263,7 +265,7 @@ void TextFormatter::ApplyAlignment(Array<Array<CharRect>> *linesCharRects,
     }
 }
 
-AARectf TextFormatter::GetCharRect(char c, const Font *font, int fontSize)
+AARectf TextFormatter::GetCharRect(uint c, const Font *font, int fontSize)
 {
     if (!font)
     {
@@ -278,21 +280,22 @@ AARectf TextFormatter::GetCharRect(char c, const Font *font, int fontSize)
     return AARectf(charMin, charMax);
 }
 
-float TextFormatter::GetCharAdvanceX(const String &content,
+float TextFormatter::GetCharAdvanceX(const Array<uint> &codepoints,
                                      const Font *font,
                                      int fontSize,
                                      int currentCharIndex)
 {
     float advance = 0;
-    if (currentCharIndex < SCAST<int>(content.Size()) - 1)
+    if (currentCharIndex < SCAST<int>(codepoints.Size()) - 1)
     {
-        advance = font->GetKerning(
-            fontSize, content[currentCharIndex], content[currentCharIndex + 1]);
+        advance = font->GetKerning(fontSize,
+                                   codepoints[currentCharIndex],
+                                   codepoints[currentCharIndex + 1]);
     }
 
     if (advance <= 0)
     {
-        const char c = content[currentCharIndex];
+        const uint c = codepoints[currentCharIndex];
         Font::GlyphMetrics charMetrics = font->GetCharMetrics(fontSize, c);
         advance = charMetrics.advance;
     }
@@ -300,6 +303,62 @@ float TextFormatter::GetCharAdvanceX(const String &content,
     return advance;
 }
 
+Array<uint> TextFormatter::GetCodepoints(const String &content)
+{
+    constexpr uint ReplacementChar = 0xFFFD;
+
+    Array<uint> codepoints;
+    codepoints.Reserve(content.Size());
+    const uint size = content.Size();
+    for (uint i = 0; i < size;)
+    {
+        const uint lead = SCAST<unsigned char>(content[i]);
+        uint numContBytes = 0;
+        uint codepoint = lead;
+        if (lead >= 0xF0 && lead <= 0xF4)
+        {
+            numContBytes = 3;
+            codepoint = (lead & 0x07);
+        }
+        else if (lead >= 0xE0 && lead <= 0xEF)
+        {
+            numContBytes = 2;
+            codepoint = (lead & 0x0F);
+        }
+        else if (lead >= 0xC2 && lead <= 0xDF)
+        {
+            numContBytes = 1;
+            codepoint = (lead & 0x1F);
+        }
+        else if (lead >= 0x80)
+        {
+            codepoints.PushBack(ReplacementChar);
+            ++i;
+            continue;
+        }
+
+        uint j = 1;
+        for (; j <= numContBytes && i + j < size; ++j)
+        {
+            const uint cont = SCAST<unsigned char>(content[i + j]);
+            if ((cont & 0xC0) != 0x80)
+            {
+                break;
+            }
+            codepoint = (codepoint << 6) | (cont & 0x3F);
+        }
+
+        const bool overlong = (numContBytes == 2 && codepoint < 0x800) ||
+                              (numContBytes == 3 && codepoint < 0x10000);
+        const bool valid = (j == numContBytes + 1) && !overlong &&
+                           codepoint <= 0x10FFFF &&
+                           (codepoint < 0xD800 || codepoint > 0xDFFF);
+        codepoints.PushBack(valid ? codepoint : ReplacementChar);
+        i += j;
+    }
+    return codepoints;
+}
+
 Vector2 FindMinCoord(const Array<TextFormatter::CharRect> &rects)
 {
     Vector2 result;
@@ -141,6 +141,16 @@ void UIAspectRatioFitter::ApplyLayout(Axis axis)
     }
 }
 
+void UIAspectRatioFitter::CloneInto(ICloneable *clone, bool cloneGUID) const
+{
+    Component::CloneInto(clone, cloneGUID);
+    UIAspectRatioFitter *arf = SCAST<UIAspectRatioFitter *>(clone);
+    arf->SetAspectRatio(GetAspectRatio());
+    arf->SetAspectRatioMode(GetAspectRatioMode());
+    arf->SetPaddingLeftBot(GetPaddingLeftBot());
+    arf->SetPaddingRightTop(GetPaddingRightTop());
+}
+
 void UIAspectRatioFitter::ImportMeta(const MetaNode &metaNode)
 {
     Component::ImportMeta(metaNode);
@@ -0,0 +1,240 @@
+#include "Bang/UIBatcher.h"
+
+#include <cstddef>
+
+#include "Bang/Array.tcc"
+#include "Bang/GL.h"
+#include "Bang/GLUniforms.h"
+#include "Bang/Matrix4.h"
+#include "Bang/ShaderProgram.h"
+#include "Bang/ShaderProgramFactory.h"
+#include "Bang/String.h"
+#include "Bang/Texture2D.h"
+#include "Bang/VAO.h"
+#include "Bang/VBO.h"
+
+using namespace Bang;
+
+constexpr uint UIBatcher::MaxTextureSlots;
+UIBatcher *UIBatcher::s_activeBatcher = nullptr;
+
+UIBatcher::UIBatcher()
+{
+}
+
+UIBatcher::~UIBatcher()
+{
+    if (UIBatcher::s_activeBatcher == this)
+    {
+        UIBatcher::s_activeBatcher = p_previousActive;
+    }
+
+    if (m_vao)
+    {
+        delete m_vao;
+    }
+
+    if (m_vbo)
+    {
+        delete m_vbo;
+    }
+}
+
+void UIBatcher::Begin()
+{
+    // Without GL (headless) the batches are still built and counted
+    if (!m_vao && GL::GetInstance())
+    {
+        Init();
+    }
+
+    m_vertices.Clear();
+    p_textureSlots.Clear();
+    m_numDrawCalls = 0;
+    m_numBatchedVertices = 0;
+
+    // Canvases can be nested, so keep the outer batcher to restore it later
+    UIBatcher::FlushActive();
+    p_previousActive = UIBatcher::s_activeBatcher;
+    UIBatcher::s_activeBatcher = this;
+}
+
+void UIBatcher::End()
+{
+    Flush();
+    if (UIBatcher::s_activeBatcher == this)
+    {
+        UIBatcher::s_activeBatcher = p_previousActive;
+    }
+    p_previousActive = nullptr;
+}
+
+int UIBatcher::AcquireTextureSlot(Texture2D *texture)
+{
+    if (!texture)
+    {
+        return -1;
+    }
+
+    for (uint i = 0; i < p_textureSlots.Size(); ++i)
+    {
+        if (p_textureSlots[i] == texture)
+        {
+            return SCAST<int>(i);
+        }
+    }
+
+    if (p_textureSlots.Size() >= UIBatcher::MaxTextureSlots)
+    {
+        Flush();
+    }
+
+    p_textureSlots.PushBack(texture);
+    return SCAST<int>(p_textureSlots.Size() - 1);
+}
+
+void UIBatcher::SetDepthMask(bool depthMask)
+{
+    if (depthMask != m_depthMask)
+    {
+        Flush();
+        m_depthMask = depthMask;
+    }
+}
+
+void UIBatcher::AddVertex(const Vector3 &position,
+                          const Vector2 &uv,
+                          const Color &color,
+                          int textureSlot,
+                          float alphaCutoff,
+                          UIBatcher::Mode mode)
+{
+    Vertex vertex;
+    vertex.position = position;
+    vertex.uv = uv;
+    vertex.color = color;
+    vertex.params = Vector3(SCAST<float>(textureSlot),
+                            alphaCutoff,
+                            SCAST<float>(SCAST<int>(mode)));
+    m_vertices.PushBack(vertex);
+}
+
+void UIBatcher::Flush()
+{
+    if (m_vertices.IsEmpty())
+    {
+        p_textureSlots.Clear();
+        return;
+    }
+
+    ShaderProgram *sp = p_batchSP.Get();
+    if (m_vao && sp && sp->IsLinked())
+    {
+        m_vbo->CreateAndFill(m_vertices.Data(),
+                             m_vertices.Size() * sizeof(Vertex),
+                             GL::UsageHint::STREAM_DRAW);
+
+        GL::Push(GL::BindTarget::SHADER_PROGRAM);
+
+        // Vertices are already in canvas space, so the PVM is just the
+        // canvas projection
+        GL::SetViewProjMode(GL::ViewProjMode::CANVAS);
+        GLUniforms::SetModelMatrix(Matrix4::Identity());
+        GL::SetDepthMask(m_depthMask);
+        GL::Disable(GL::Enablable::CULL_FACE);
+        GL::SetWireframe(false);
+
+        sp->Bind();
+        for (uint i = 0; i < UIBatcher::MaxTextureSlots; ++i)
+        {
+            Texture2D *tex =
+                (i < p_textureSlots.Size()) ? p_textureSlots[i] : nullptr;
+            sp->SetTexture2D(
+                "B_BatchTexture" + String::ToString(SCAST<int>(i)), tex, false);
+        }
+
+        GL::Render(m_vao, GL::Primitive::TRIANGLES, m_vertices.Size());
+
+        GL::Pop(GL::BindTarget::SHADER_PROGRAM);
+    }
+
+    ++m_numDrawCalls;
+    m_numBatchedVertices += m_vertices.Size();
+    m_vertices.Clear();
+    p_textureSlots.Clear();
+}
+
+void UIBatcher::SetEnabled(bool enabled)
+{
+    if (enabled != IsEnabled())
+    {
+        Flush();
+        m_enabled = enabled;
+    }
+}
+
+bool UIBatcher::IsEnabled() const
+{
+    return m_enabled;
+}
+
+uint UIBatcher::GetNumDrawCalls() const
+{
+    return m_numDrawCalls;
+}
+
+uint UIBatcher::GetNumBatchedVertices() const
+{
+    return m_numBatchedVertices;
+}
+
+UIBatcher *UIBatcher::GetActive()
+{
+    return UIBatcher::s_activeBatcher;
+}
+
+void UIBatcher::FlushActive()
+{
+    if (UIBatcher *batcher = UIBatcher::GetActive())
+    {
+        batcher->Flush();
+    }
+}
+
+void UIBatcher::Init()
+{
+    m_vao = new VAO();
+    m_vbo = new VBO();
+
+    const uint stride = sizeof(Vertex);
+    m_vao->SetVBO(m_vbo,
+                  0,
+                  3,
+                  GL::VertexAttribDataType::FLOAT,
+                  false,
+                  stride,
+                  offsetof(Vertex, position));
+    m_vao->SetVBO(m_vbo,
+                  2,
+                  2,
+                  GL::VertexAttribDataType::FLOAT,
+                  false,
+                  stride,
+                  offsetof(Vertex, uv));
+    m_vao->SetVBO(m_vbo,
+                  3,
+                  4,
+                  GL::VertexAttribDataType::FLOAT,
+                  false,
+                  stride,
+                  offsetof(Vertex, color));
+    m_vao->SetVBO(m_vbo,
+                  4,
+                  3,
+                  GL::VertexAttribDataType::FLOAT,
+                  false,
+                  stride,
+                  offsetof(Vertex, params));
+
+    p_batchSP.Set(ShaderProgramFactory::GetUIBatch());
+}
@@ -24,7 +24,9 @@
 #include "Bang/RectTransform.h"
 #include "Bang/Set.tcc"
 #include "Bang/Transform.h"
+#include "Bang/UIBatcher.h"
 #include "Bang/UIDragDroppable.h"
+#include "Bang/UIFocusIndex.h"
 #include "Bang/UIFocusable.h"
 #include "Bang/UILayoutManager.h"
 #include "Bang/UIRectMask.h"
@@ -43,11 +45,17 @@ UICanvas::UICanvas()
 {
     SET_INSTANCE_CLASS_ID(UICanvas)
     m_uiLayoutManager = new UILayoutManager();
+    m_uiBatcher = new UIBatcher();
+    m_focusIndex = new UIFocusIndex();
+    UIFocusIndex::RegisterCanvas(this);
 }
 
 UICanvas::~UICanvas()
 {
+    UIFocusIndex::UnRegisterCanvas(this);
     delete m_uiLayoutManager;
+    delete m_uiBatcher;
+    delete m_focusIndex;
 }
 
 void UICanvas::OnStart()
@@ -146,18 +154,14 @@ void UICanvas::OnUpdate()
         return;
     }
 
-    Array<std::pair<UIFocusable *, AARecti>> focusablesAndRectsVP;
-    GetSortedFocusCandidatesByOcclusionOrder(GetGameObject(),
-                                             &focusablesAndRectsVP);
+    // Only gathers the focus candidates again if something changed
+    m_focusIndex->Update(this);
 
     // Process all enqueued InputEvents, transform them to UIEvents and
     // propagate them as we need.
 
-    Array<DPtr<UIFocusable>> focusables;
-    for (const auto &focusableAndRectVP : focusablesAndRectsVP)
-    {
-        focusables.PushBack(DPtr<UIFocusable>(focusableAndRectVP.first));
-    }
+    const Array<DPtr<UIFocusable>> &focusables =
+        m_focusIndex->GetFocusables();
 
     Vector2i currentMousePosVP = Input::GetMousePosition();
     Vector2 currentMousePosVPNDC = Input::GetMousePositionNDC();
@@ -173,28 +177,9 @@ void UICanvas::OnUpdate()
             GL::FromViewportPointToViewportPointNDC(currentMousePosVP);
 
         // First of all, know which focusable is under mouse top most
-        UIFocusable *focusableUnderMouseTopMost = nullptr;
-        for (const auto &pair : focusablesAndRectsVP)
-        {
-            UIFocusable *focusable = pair.first;
-            const AARecti &aaRectMaskVP = pair.second;
-            if (focusable)
-            {
-                if (GameObject *focusableGo = focusable->GetGameObject())
-                {
-                    if (RectTransform *rt = focusableGo->GetRectTransform())
-                    {
-                        if (aaRectMaskVP.Contains(currentMousePosVP) &&
-                            rt->IsMouseOver(currentMouseWindow, false) &&
-                            focusable->IsEnabledRecursively())
-                        {
-                            focusableUnderMouseTopMost = focusable;
-                            break;
-                        }
-                    }
-                }
-            }
-        }
+        UIFocusable *focusableUnderMouseTopMost =
+            m_focusIndex->GetFocusableUnderMouse(currentMousePosVP,
+                                                 currentMouseWindow);
         SetFocusableUnderMouseTopMost(focusableUnderMouseTopMost, inputEvent);
 
         switch (inputEvent.type)
@@ -546,6 +531,16 @@ void UICanvas::OnBeforeChildrenRender(RenderPass rp)
     {
         Component::OnBeforeChildrenRender(rp);
         GetLayoutManager()->RebuildLayout(GetGameObject());
+        GetBatcher()->Begin();
+    }
+}
+
+void UICanvas::OnAfterChildrenRender(RenderPass rp)
+{
+    if (rp == RenderPass::CANVAS)
+    {
+        GetBatcher()->End();
+        Component::OnAfterChildrenRender(rp);
     }
 }
 
@@ -748,6 +743,16 @@ UILayoutManager *UICanvas::GetLayoutManager() const
     return m_uiLayoutManager;
 }
 
+UIBatcher *UICanvas::GetBatcher() const
+{
+    return m_uiBatcher;
+}
+
+UIFocusIndex *UICanvas::GetFocusIndex() const
+{
+    return m_focusIndex;
+}
+
 UICanvas *UICanvas::GetActive(const GameObject *go)
 {
     return go->GetComponentInAncestorsAndThis<UICanvas>();
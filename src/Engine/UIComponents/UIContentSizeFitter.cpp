@@ -86,6 +86,14 @@ LayoutSizeType UIContentSizeFitter::GetVerticalSizeType() const
     return m_verticalSizeType;
 }
 
+void UIContentSizeFitter::CloneInto(ICloneable *clone, bool cloneGUID) const
+{
+    Component::CloneInto(clone, cloneGUID);
+    UIContentSizeFitter *csf = SCAST<UIContentSizeFitter *>(clone);
+    csf->SetHorizontalSizeType(GetHorizontalSizeType());
+    csf->SetVerticalSizeType(GetVerticalSizeType());
+}
+
 void UIContentSizeFitter::ImportMeta(const MetaNode &metaNode)
 {
     Component::ImportMeta(metaNode);
@@ -11,10 +11,13 @@
 #include "Bang/UIFocusable.h"
 #include "Bang/UIList.h"
 #include "Bang/UITextRenderer.h"
+#include "Bang/UIScrollPanel.h"
 #include "Bang/UIVerticalLayout.h"
 
 using namespace Bang;
 
+const int UIFileList::ItemHeightPx = 26;
+
 UIFileList::UIFileList()
 {
     SET_INSTANCE_CLASS_ID(UIFileList)
@@ -35,6 +38,17 @@ void UIFileList::OnUpdate()
     Component::OnUpdate();
 }
 
+void UIFileList::OnDestroy()
+{
+    Component::OnDestroy();
+
+    UIList *uiList = GetUIList();
+    if (uiList && uiList->GetDataSource() == this)
+    {
+        uiList->SetDataSource(nullptr);
+    }
+}
+
 void UIFileList::SetFileExtensions(const Array<String> &extensions)
 {
     m_fileExtensions = extensions;
@@ -62,9 +76,11 @@ void UIFileList::SetShowOnlyDirectories(bool showOnlyDirectories)
 
 Path UIFileList::GetCurrentSelectedPath() const
 {
-    if (p_selectedItem)
+    UIList *uiList = GetUIList();
+    const int selectedIndex = (uiList ? uiList->GetSelectedIndex() : -1);
+    if (selectedIndex >= 0 && selectedIndex < GetNumItems())
     {
-        return p_selectedItem->GetPath();
+        return m_paths[selectedIndex];
     }
     return GetCurrentPath();
 }
@@ -97,6 +113,29 @@ const Array<String> &UIFileList::GetFileExtensions() const
     return m_fileExtensions;
 }
 
+int UIFileList::GetNumItems() const
+{
+    return m_paths.Size();
+}
+
+int UIFileList::GetItemHeight() const
+{
+    return UIFileList::ItemHeightPx;
+}
+
+GameObject *UIFileList::CreateItem()
+{
+    return new UIFileListItem();
+}
+
+void UIFileList::BindItem(GameObject *item, int index)
+{
+    if (UIFileListItem *fileItem = DCAST<UIFileListItem *>(item))
+    {
+        fileItem->SetPath(m_paths[index]);
+    }
+}
+
 void UIFileList::UpdateEntries()
 {
     Array<Path> paths = GetCurrentPath().GetSubPaths(FindFlag::SIMPLE);
@@ -113,33 +152,31 @@ void UIFileList::UpdateEntries()
     }
     paths.PushFront(Path(".."));
 
-    UIList *uiList = GetGameObject()->GetComponent<UIList>();
-    uiList->Clear();
+    UIList *uiList = GetUIList();
+    uiList->ClearSelection();
+    m_paths = paths;
 
-    for (const Path &path : paths)
+    // Only the visible entries get an item, so that big directories do not
+    // create a GameObject per file
+    uiList->SetDataSource(this);
+    if (uiList->GetScrollPanel())
     {
-        UIFileListItem *item = new UIFileListItem();
-        item->SetPath(path);
-
-        uiList->AddItem(item);
+        uiList->ScrollToBegin();
     }
-    // uiList->SetSelection(1);
 
     uiList->SetSelectionCallback(
         [this, uiList](GameObject *go, UIList::Action action) {
-            UIFileListItem *item = DCAST<UIFileListItem *>(go);
-            if (action == UIList::Action::SELECTION_IN)
-            {
-                p_selectedItem = item;
-            }
-            else if (action == UIList::Action::SELECTION_OUT)
+            if (action == UIList::Action::PRESSED ||
+                action == UIList::Action::DOUBLE_CLICKED_LEFT)
             {
-                p_selectedItem = nullptr;
-            }
-            else if (action == UIList::Action::PRESSED ||
-                     action == UIList::Action::DOUBLE_CLICKED_LEFT)
-            {
-                Path itemPath = item->GetPath();
+                const int index = uiList->GetItemIndex(go);
+                if (index < 0 || index >= GetNumItems())
+                {
+                    return;
+                }
+
+                // Copied, since changing the path refills the entries
+                Path itemPath = m_paths[index];
                 if (itemPath.GetAbsolute() == "..")
                 {
                     this->SetCurrentPath(GetCurrentPath().GetDirectory());
@@ -160,6 +197,11 @@ void UIFileList::UpdateEntries()
         });
 }
 
+UIList *UIFileList::GetUIList() const
+{
+    return GetGameObject() ? GetGameObject()->GetComponent<UIList>() : nullptr;
+}
+
 // UIFileListItem
 UIFileListItem::UIFileListItem()
 {
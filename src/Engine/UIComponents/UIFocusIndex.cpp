@@ -0,0 +1,213 @@
+#include "Bang/UIFocusIndex.h"
+
+#include <utility>
+
+#include "Bang/Array.tcc"
+#include "Bang/DPtr.tcc"
+#include "Bang/GL.h"
+#include "Bang/GameObject.h"
+#include "Bang/GameObject.tcc"
+#include "Bang/Math.h"
+#include "Bang/RectTransform.h"
+#include "Bang/UICanvas.h"
+#include "Bang/UIFocusable.h"
+
+using namespace Bang;
+
+constexpr int UIFocusIndex::GridCellSizePx;
+Array<const UICanvas *> UIFocusIndex::s_canvases;
+
+UIFocusIndex::UIFocusIndex()
+{
+}
+
+void UIFocusIndex::Update(const UICanvas *canvas)
+{
+    const AARecti viewportRect = GL::GetViewportRect();
+    if (IsInvalid() || m_viewportRect != viewportRect)
+    {
+        m_viewportRect = viewportRect;
+        m_invalid = false;
+        Rebuild(canvas);
+    }
+}
+
+UIFocusable *UIFocusIndex::GetFocusableUnderMouse(
+    const Vector2i &mousePosVP,
+    const Vector2i &mousePosWindow) const
+{
+    auto IsUnderMouse = [&](uint i) {
+        UIFocusable *focusable = m_focusables[i].Get();
+        if (focusable)
+        {
+            if (GameObject *focusableGo = focusable->GetGameObject())
+            {
+                if (RectTransform *rt = focusableGo->GetRectTransform())
+                {
+                    return m_maskRectsVP[i].Contains(mousePosVP) &&
+                           rt->IsMouseOver(mousePosWindow, false) &&
+                           focusable->IsEnabledRecursively();
+                }
+            }
+        }
+        return false;
+    };
+
+    const int index = GetFirstIndexAt(mousePosVP, IsUnderMouse);
+    return (index >= 0) ? m_focusables[index].Get() : nullptr;
+}
+
+const Array<DPtr<UIFocusable>> &UIFocusIndex::GetFocusables() const
+{
+    return m_focusables;
+}
+
+const Array<AARecti> &UIFocusIndex::GetMaskRectsVP() const
+{
+    return m_maskRectsVP;
+}
+
+void UIFocusIndex::BuildGrid(const AARecti &viewportRect,
+                             const Array<AARect> &rectsVP)
+{
+    m_numCandidates = rectsVP.Size();
+
+    const Vector2i vpSize =
+        Vector2i::Max(viewportRect.GetSize(), Vector2i::One());
+    m_gridSize = Vector2i((vpSize.x + GridCellSizePx - 1) / GridCellSizePx,
+                          (vpSize.y + GridCellSizePx - 1) / GridCellSizePx);
+    m_gridCells = Array<Array<uint>>(m_gridSize.x * m_gridSize.y);
+
+    const Vector2i maxPx = (m_gridSize * GridCellSizePx - Vector2i::One());
+    for (uint i = 0; i < rectsVP.Size(); ++i)
+    {
+        const AARect &rectVP = rectsVP[i];
+        if (!rectVP.IsValid())
+        {
+            continue;
+        }
+
+        // One pixel of slack, for the rounding of the rect
+        const Vector2i rectMinPx = Vector2i::Max(
+            Vector2i(Vector2::Floor(rectVP.GetMin())) - Vector2i::One(),
+            Vector2i::Zero());
+        const Vector2i rectMaxPx =
+            Vector2i::Min(Vector2i(Vector2::Ceil(rectVP.GetMax())), maxPx);
+        if (rectMinPx.x > rectMaxPx.x || rectMinPx.y > rectMaxPx.y)
+        {
+            continue;
+        }
+
+        const Vector2i minCell = (rectMinPx / GridCellSizePx);
+        const Vector2i maxCell = (rectMaxPx / GridCellSizePx);
+        for (int y = minCell.y; y <= maxCell.y; ++y)
+        {
+            for (int x = minCell.x; x <= maxCell.x; ++x)
+            {
+                m_gridCells[GetCellIndex(Vector2i(x, y))].PushBack(i);
+            }
+        }
+    }
+}
+
+int UIFocusIndex::GetFirstIndexAt(
+    const Vector2i &pointVP,
+    const std::function<bool(uint)> &passesTest) const
+{
+    // Out of the grid, just go through all of them
+    const int cellIndex = (pointVP.x < 0 || pointVP.y < 0)
+                              ? -1
+                              : GetCellIndex(pointVP / GridCellSizePx);
+    if (cellIndex < 0)
+    {
+        for (uint i = 0; i < m_numCandidates; ++i)
+        {
+            if (passesTest(i))
+            {
+                return SCAST<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    // Cells keep the candidates in occlusion order too
+    for (uint i : m_gridCells[cellIndex])
+    {
+        if (passesTest(i))
+        {
+            return SCAST<int>(i);
+        }
+    }
+    return -1;
+}
+
+void UIFocusIndex::Invalidate()
+{
+    m_invalid = true;
+}
+
+bool UIFocusIndex::IsInvalid() const
+{
+    return m_invalid;
+}
+
+void UIFocusIndex::Invalidate(const GameObject *go)
+{
+    if (!go)
+    {
+        return;
+    }
+
+    for (const UICanvas *canvas : UIFocusIndex::s_canvases)
+    {
+        UIFocusIndex *focusIndex = canvas->GetFocusIndex();
+        const GameObject *canvasGo = canvas->GetGameObject();
+        if (!focusIndex->IsInvalid() && canvasGo &&
+            (go == canvasGo || go->IsChildOf(canvasGo) ||
+             canvasGo->IsChildOf(go)))
+        {
+            focusIndex->Invalidate();
+        }
+    }
+}
+
+void UIFocusIndex::Rebuild(const UICanvas *canvas)
+{
+    Array<std::pair<UIFocusable *, AARecti>> focusablesAndRectsVP;
+    canvas->GetSortedFocusCandidatesByOcclusionOrder(canvas->GetGameObject(),
+                                                     &focusablesAndRectsVP);
+
+    m_focusables.Clear();
+    m_maskRectsVP.Clear();
+    Array<AARect> rectsVP;
+    for (const auto &focusableAndRectVP : focusablesAndRectsVP)
+    {
+        UIFocusable *focusable = focusableAndRectVP.first;
+        RectTransform *rt = focusable->GetGameObject()->GetRectTransform();
+        m_focusables.PushBack(DPtr<UIFocusable>(focusable));
+        m_maskRectsVP.PushBack(focusableAndRectVP.second);
+        rectsVP.PushBack(rt ? rt->GetViewportAARect() : AARect());
+    }
+
+    BuildGrid(m_viewportRect, rectsVP);
+}
+
+void UIFocusIndex::RegisterCanvas(const UICanvas *canvas)
+{
+    UIFocusIndex::s_canvases.PushBack(canvas);
+}
+
+void UIFocusIndex::UnRegisterCanvas(const UICanvas *canvas)
+{
+    UIFocusIndex::s_canvases.Remove(canvas);
+}
+
+int UIFocusIndex::GetCellIndex(const Vector2i &cellCoords) const
+{
+    if (cellCoords.x < 0 || cellCoords.y < 0 || cellCoords.x >= m_gridSize.x ||
+        cellCoords.y >= m_gridSize.y)
+    {
+        return -1;
+    }
+    return (cellCoords.y * m_gridSize.x + cellCoords.x);
+}
@@ -160,6 +160,21 @@ Vector2i UIGroupLayout::GetPaddingSize() const
     return GetPaddingLeftBot() + GetPaddingRightTop();
 }
 
+void UIGroupLayout::CloneInto(ICloneable *clone, bool cloneGUID) const
+{
+    Component::CloneInto(clone, cloneGUID);
+    UIGroupLayout *gl = SCAST<UIGroupLayout *>(clone);
+    gl->SetSpacing(GetSpacing());
+    gl->SetPaddings(GetPaddingLeft(),
+                    GetPaddingBot(),
+                    GetPaddingRight(),
+                    GetPaddingTop());
+    gl->SetChildrenHorizontalAlignment(GetChildrenHorizontalAlignment());
+    gl->SetChildrenVerticalAlignment(GetChildrenVerticalAlignment());
+    gl->SetChildrenHorizontalStretch(GetChildrenHorizontalStretch());
+    gl->SetChildrenVerticalStretch(GetChildrenVerticalStretch());
+}
+
 void UIGroupLayout::ImportMeta(const MetaNode &metaNode)
 {
     Component::ImportMeta(metaNode);
@@ -10,6 +10,7 @@
 #include "Bang/ICloneable.h"
 #include "Bang/Material.h"
 #include "Bang/MaterialFactory.h"
+#include "Bang/Matrix4.h"
 #include "Bang/Mesh.h"
 #include "Bang/MeshFactory.h"
 #include "Bang/MetaNode.h"
@@ -17,6 +18,8 @@
 #include "Bang/Path.h"
 #include "Bang/ShaderProgram.h"
 #include "Bang/Texture2D.h"
+#include "Bang/UIBatcher.h"
+#include "Bang/Vector4.h"
 
 namespace Bang
 {
@@ -59,6 +62,72 @@ void UIImageRenderer::OnRender()
     }
 }
 
+bool UIImageRenderer::AddToBatch(UIBatcher *batcher)
+{
+    Material *mat = GetActiveMaterial();
+    if (mat->GetBaseShaderProgram() !=
+        MaterialFactory::GetUIImage().Get()->GetBaseShaderProgram())
+    {
+        return false;
+    }
+
+    if (GetTint().a <= 0.0f)
+    {
+        return true;
+    }
+
+    // Same transformations as UIImageRenderer.vert, but in the CPU
+    Texture2D *tex = mat->GetAlbedoTexture();
+    const int texSlot = batcher->AcquireTextureSlot(tex);
+    const float alphaCutoff = (tex ? tex->GetAlphaCutoff() : 0.0f);
+    const Matrix4 model = GetModelMatrixUniform();
+    const bool isSlice9 = (GetMode() == Mode::SLICE_9 ||
+                           GetMode() == Mode::SLICE_9_INV_UVY);
+    Vector2 strokeSizeLocal = Vector2::Zero();
+    if (isSlice9)
+    {
+        strokeSizeLocal = (model.Inversed() *
+                           Vector4(Vector2(GetSlice9BorderStrokePx()), 0, 0))
+                              .xy();
+    }
+
+    const Mesh *mesh = p_quadMesh.Get();
+    const Array<Vector3> &positions = mesh->GetPositionsPool();
+    const Array<Vector2> &uvs = mesh->GetUvsPool();
+    const Array<Mesh::VertexId> &vertexIds = mesh->GetTrianglesVertexIds();
+    const uint numVertices = mesh->GetNumVerticesIds();
+    for (uint i = 0; i < numVertices; ++i)
+    {
+        const Mesh::VertexId vId = (mesh->IsIndexed() ? vertexIds[i] : i);
+        const Vector2 &uv = uvs[vId];
+        Vector3 localPos = positions[vId];
+        if (isSlice9)
+        {
+            switch (SCAST<int>(uv.x * 4))
+            {
+                case 1: localPos.x = (-1.0f + strokeSizeLocal.x); break;
+                case 2: localPos.x = (1.0f - strokeSizeLocal.x); break;
+            }
+            switch (SCAST<int>(uv.y * 4))
+            {
+                case 1: localPos.y = (-1.0f + strokeSizeLocal.y); break;
+                case 2: localPos.y = (1.0f - strokeSizeLocal.y); break;
+            }
+        }
+
+        const Vector2 albedoUv =
+            (tex ? (uv * mat->GetAlbedoUvMultiply() + mat->GetAlbedoUvOffset())
+                 : uv);
+        batcher->AddVertex((model * Vector4(localPos, 1)).xyz(),
+                           albedoUv,
+                           mat->GetAlbedoColor(),
+                           texSlot,
+                           alphaCutoff,
+                           UIBatcher::Mode::IMAGE);
+    }
+    return true;
+}
+
 void UIImageRenderer::SetImageTexture(const Path &imagePath)
 {
     if (imagePath.IsFile())
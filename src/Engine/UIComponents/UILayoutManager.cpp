@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <map>
 #include <queue>
 #include <unordered_map>
@@ -23,6 +24,7 @@
 #include "Bang/UILayoutIgnorer.h"
 #include "Bang/UMap.h"
 #include "Bang/UMap.tcc"
+#include "Bang/USet.tcc"
 
 using namespace Bang;
 
@@ -30,6 +32,20 @@ UILayoutManager::UILayoutManager()
 {
 }
 
+template <class T>
+GameObject *GetGameObjectOf(T *layoutObject)
+{
+    GameObject *go = DCAST<GameObject *>(layoutObject);
+    if (!go)
+    {
+        if (Component *comp = DCAST<Component *>(layoutObject))
+        {
+            go = comp->GetGameObject();
+        }
+    }
+    return go;
+}
+
 template <class T>
 const Array<T *> &GetGatheredArrayOf(
     UILayoutManager *layoutMgr,
@@ -73,13 +89,16 @@ const Array<ILayoutController *> &UILayoutManager::GetLayoutControllersIn(
 
 void UILayoutManager::PropagateInvalidation(ILayoutElement *element)
 {
-    Component *comp = DCAST<Component *>(element);
-    GameObject *go = DCAST<GameObject *>(element);
-    if (!go && comp)
+    // The parent layout is invalidated later, only if the recalculated
+    // sizes of the element game object end up being different
+    if (GameObject *go = GetGameObjectOf(element))
     {
-        go = comp->GetGameObject();
+        MarkInvalid(go, nullptr);
     }
+}
 
+void UILayoutManager::InvalidateParentControllers(GameObject *go)
+{
     if (go)
     {
         const Array<ILayoutController *> &layoutControllers =
@@ -105,14 +124,11 @@ void UILayoutManager::PropagateInvalidation(ILayoutElement *element)
 void UILayoutManager::PropagateInvalidation(ILayoutController *controller)
 {
     Component *comp = DCAST<Component *>(controller);
-    GameObject *go = DCAST<GameObject *>(controller);
-    if (!go && comp)
-    {
-        go = comp->GetGameObject();
-    }
-
+    GameObject *go = GetGameObjectOf(controller);
     if (go)
     {
+        MarkInvalid(nullptr, go);
+
         ILayoutElement *lElm = comp ? DCAST<ILayoutElement *>(comp) : nullptr;
         if (!lElm)
         {
@@ -143,38 +159,47 @@ Vector2 UILayoutManager::GetFlexibleSize(GameObject *go)
 
 Vector2 UILayoutManager::GetSize(GameObject *go, LayoutSizeType sizeType)
 {
-    // Retrieve layout elements and their respective priority
-    Map<int, Array<ILayoutElement *>> priorLayoutElms;
-    Array<ILayoutElement *> les = go->GetComponents<ILayoutElement>();
-    if (les.IsEmpty())
-    {
-        return Vector2::Zero();
-    }
-
-    for (ILayoutElement *le : les)
+    // Get the max size between the elements ordered by priority.
+    // Sizes less than zero will be ignored. Priorities are visited from the
+    // highest to the lowest one, walking the components directly, since
+    // this is queried a lot while calculating the layouts.
+    const Array<Component *> &comps = go->GetComponents();
+    Vector2 size = Vector2(-1);
+    bool sizeXFound = false, sizeYFound = false;
+    int prior = std::numeric_limits<int>::max();
+    bool firstPrior = true;
+    while (true)
     {
-        int prior = le->GetLayoutPriority();
-        if (!priorLayoutElms.ContainsKey(prior))
+        bool nextPriorFound = false;
+        int nextPrior = std::numeric_limits<int>::min();
+        for (Component *comp : comps)
         {
-            priorLayoutElms.Add(prior, Array<ILayoutElement *>());
+            if (ILayoutElement *le = DCAST<ILayoutElement *>(comp))
+            {
+                const int lePrior = le->GetLayoutPriority();
+                if ((firstPrior || lePrior < prior) && lePrior >= nextPrior)
+                {
+                    nextPrior = lePrior;
+                    nextPriorFound = true;
+                }
+            }
         }
-        priorLayoutElms.Get(prior).PushBack(le);
-    }
 
-    if (priorLayoutElms.IsEmpty())
-    {
-        return Vector2::Zero();
-    }
+        if (!nextPriorFound)
+        {
+            break;
+        }
+        prior = nextPrior;
+        firstPrior = false;
 
-    // Get the max size between the elements ordered by priority.
-    // Sizes less than zero will be ignored.
-    Vector2 size = Vector2(-1);
-    bool sizeXFound = false, sizeYFound = false;
-    for (auto it = priorLayoutElms.RBegin(); it != priorLayoutElms.REnd(); ++it)
-    {
-        const Array<ILayoutElement *> &les = (*it).second;
-        for (ILayoutElement *le : les)
+        for (Component *comp : comps)
         {
+            ILayoutElement *le = DCAST<ILayoutElement *>(comp);
+            if (!le || le->GetLayoutPriority() != prior)
+            {
+                continue;
+            }
+
             Vector2 leSize = le->GetSize(sizeType);
             if (!sizeXFound)
             {
@@ -226,35 +251,141 @@ void UILayoutManager::RebuildLayout(GameObject *rootGo)
 {
     if (rootGo)
     {
-        CalculateLayout(rootGo, Axis::HORIZONTAL);
-        ApplyLayout(rootGo, Axis::HORIZONTAL);
-        CalculateLayout(rootGo, Axis::VERTICAL);
-        ApplyLayout(rootGo, Axis::VERTICAL);
+        // The canvas may have been added to an already built hierarchy
+        if (!m_claimedRootInvalidations)
+        {
+            UILayoutManager::ClaimInvalidations(rootGo);
+            m_claimedRootInvalidations = true;
+        }
+
+        m_numCalculatedLayouts = 0;
+        m_numAppliedLayouts = 0;
+        CalculateLayout(Axis::HORIZONTAL);
+        ApplyLayout(Axis::HORIZONTAL);
+        CalculateLayout(Axis::VERTICAL);
+        ApplyLayout(Axis::VERTICAL);
     }
 }
 
-void UILayoutManager::CalculateLayout(GameObject *gameObject, Axis axis)
+uint UILayoutManager::GetNumCalculatedLayouts() const
+{
+    return m_numCalculatedLayouts;
+}
+
+uint UILayoutManager::GetNumAppliedLayouts() const
+{
+    return m_numAppliedLayouts;
+}
+
+void UILayoutManager::CalculateLayout(Axis axis)
 {
-    for (GameObject *child : gameObject->GetChildren())
+    // Deepest first, so that the children sizes are up to date by the time
+    // their parents are calculated
+    using DepthGo = std::pair<int, GameObject *>;
+    std::priority_queue<DepthGo> goQueue;
+    for (GameObject *go : m_invalidElementsGos)
+    {
+        goQueue.push(DepthGo(GetDepth(go), go));
+    }
+    m_newInvalidElementsGos.Clear();
+
+    USet<GameObject *> calculatedGos;
+    while (!goQueue.empty())
+    {
+        GameObject *go = goQueue.top().second;
+        goQueue.pop();
+        if (calculatedGos.Contains(go) || ForwardIfNotOwned(go))
+        {
+            continue;
+        }
+        calculatedGos.Add(go);
+
+        const Vector2 prevMinSize = GetSize(go, LayoutSizeType::MIN);
+        const Vector2 prevPrefSize = GetSize(go, LayoutSizeType::PREFERRED);
+        const Vector2 prevFlexSize = GetSize(go, LayoutSizeType::FLEXIBLE);
+
+        const Array<ILayoutElement *> &goLEs = GetLayoutElementsIn(go);
+        for (ILayoutElement *goLE : goLEs)
+        {
+            if (goLE->IsInvalid())
+            {
+                goLE->_CalculateLayout(axis);
+                ++m_numCalculatedLayouts;
+            }
+        }
+
+        // Only the parent layout and the self controllers depend on these
+        // sizes, so if they have not changed the invalidation stops here
+        const Vector2 minSize = GetSize(go, LayoutSizeType::MIN);
+        const Vector2 prefSize = GetSize(go, LayoutSizeType::PREFERRED);
+        const Vector2 flexSize = GetSize(go, LayoutSizeType::FLEXIBLE);
+        if (minSize.GetAxis(axis) != prevMinSize.GetAxis(axis) ||
+            prefSize.GetAxis(axis) != prevPrefSize.GetAxis(axis) ||
+            flexSize.GetAxis(axis) != prevFlexSize.GetAxis(axis))
+        {
+            InvalidateParentControllers(go);
+            for (ILayoutController *layoutController :
+                 GetLayoutControllersIn(go))
+            {
+                if (layoutController->IsSelfController())
+                {
+                    layoutController->Invalidate();
+                }
+            }
+        }
+
+        for (GameObject *newInvalidGo : m_newInvalidElementsGos)
+        {
+            goQueue.push(DepthGo(GetDepth(newInvalidGo), newInvalidGo));
+        }
+        m_newInvalidElementsGos.Clear();
+    }
+
+    // Elements get validated after their vertical calculation
+    Array<GameObject *> validGos;
+    for (GameObject *go : m_invalidElementsGos)
     {
-        CalculateLayout(child, axis);
+        bool allValid = true;
+        for (ILayoutElement *goLE : GetLayoutElementsIn(go))
+        {
+            allValid = allValid && !goLE->IsInvalid();
+        }
+
+        if (allValid)
+        {
+            validGos.PushBack(go);
+        }
     }
 
-    const Array<ILayoutElement *> &goLEs = GetLayoutElementsIn(gameObject);
-    for (ILayoutElement *goLE : goLEs)
+    for (GameObject *validGo : validGos)
     {
-        goLE->_CalculateLayout(axis);
+        m_invalidElementsGos.Remove(validGo);
     }
 }
 
-void UILayoutManager::ApplyLayout(GameObject *gameObject, Axis axis)
+void UILayoutManager::ApplyLayout(Axis axis)
 {
-    std::queue<GameObject *> goQueue;
-    goQueue.push(gameObject);
+    // Parents first, since applying a layout moves the children, which
+    // invalidates their controllers too
+    using DepthGo = std::pair<int, GameObject *>;
+    std::priority_queue<DepthGo, std::vector<DepthGo>, std::greater<DepthGo>>
+        goQueue;
+    for (GameObject *go : m_invalidControllersGos)
+    {
+        goQueue.push(DepthGo(GetDepth(go), go));
+    }
+    m_newInvalidControllersGos.Clear();
+
+    USet<GameObject *> appliedGos;
     while (!goQueue.empty())
     {
-        GameObject *go = goQueue.front();
+        GameObject *go = goQueue.top().second;
         goQueue.pop();
+        if (appliedGos.Contains(go) || ForwardIfNotOwned(go))
+        {
+            continue;
+        }
+        appliedGos.Add(go);
 
         const Array<ILayoutController *> &layoutControllers =
             GetLayoutControllersIn(go);
@@ -262,45 +393,175 @@ void UILayoutManager::ApplyLayout(GameObject *gameObject, Axis axis)
         // SelfLayoutControllers
         for (ILayoutController *layoutController : layoutControllers)
         {
-            if (layoutController->IsSelfController())
+            if (layoutController->IsSelfController() &&
+                layoutController->IsInvalid())
             {
                 layoutController->_ApplyLayout(axis);
+                ++m_numAppliedLayouts;
             }
         }
 
         // Normal LayoutControllers
         for (ILayoutController *layoutController : layoutControllers)
         {
-            if (!layoutController->IsSelfController())
+            if (!layoutController->IsSelfController() &&
+                layoutController->IsInvalid())
             {
                 layoutController->_ApplyLayout(axis);
+                ++m_numAppliedLayouts;
             }
         }
 
-        for (GameObject *child : go->GetChildren())
+        for (GameObject *newInvalidGo : m_newInvalidControllersGos)
         {
-            goQueue.push(child);
+            goQueue.push(DepthGo(GetDepth(newInvalidGo), newInvalidGo));
         }
+        m_newInvalidControllersGos.Clear();
+    }
+
+    // Controllers get validated after their vertical layout is applied
+    Array<GameObject *> validGos;
+    for (GameObject *go : m_invalidControllersGos)
+    {
+        bool allValid = true;
+        for (ILayoutController *layoutController : GetLayoutControllersIn(go))
+        {
+            allValid = allValid && !layoutController->IsInvalid();
+        }
+
+        if (allValid)
+        {
+            validGos.PushBack(go);
+        }
+    }
+
+    for (GameObject *validGo : validGos)
+    {
+        m_invalidControllersGos.Remove(validGo);
     }
 }
 
+void UILayoutManager::MarkInvalid(GameObject *elementsGo,
+                                  GameObject *controllersGo)
+{
+    // Gathering their layout objects also makes us listen to their
+    // destruction, so that no dangling game objects are kept here
+    if (elementsGo && !m_invalidElementsGos.Contains(elementsGo))
+    {
+        GetLayoutElementsIn(elementsGo);
+        m_invalidElementsGos.Add(elementsGo);
+        m_newInvalidElementsGos.PushBack(elementsGo);
+    }
+
+    if (controllersGo && !m_invalidControllersGos.Contains(controllersGo))
+    {
+        GetLayoutControllersIn(controllersGo);
+        m_invalidControllersGos.Add(controllersGo);
+        m_newInvalidControllersGos.PushBack(controllersGo);
+    }
+}
+
+bool UILayoutManager::ForwardIfNotOwned(GameObject *gameObject)
+{
+    UILayoutManager *activeLM = UILayoutManager::GetActive(gameObject);
+    if (activeLM == this)
+    {
+        return false;
+    }
+
+    // It has been moved to another canvas (or out of any canvas)
+    // since it was invalidated. Out of any canvas, its elements and
+    // controllers stay invalid until it is attached to one again
+    if (activeLM)
+    {
+        const bool elementsInvalid = m_invalidElementsGos.Contains(gameObject);
+        const bool controllersInvalid =
+            m_invalidControllersGos.Contains(gameObject);
+        activeLM->MarkInvalid(elementsInvalid ? gameObject : nullptr,
+                              controllersInvalid ? gameObject : nullptr);
+    }
+
+    m_invalidElementsGos.Remove(gameObject);
+    m_invalidControllersGos.Remove(gameObject);
+    return true;
+}
+
+int UILayoutManager::GetDepth(GameObject *gameObject)
+{
+    int depth = 0;
+    for (GameObject *go = gameObject->GetParent(); go; go = go->GetParent())
+    {
+        ++depth;
+    }
+    return depth;
+}
+
 void UILayoutManager::OnDestroyed(EventEmitter<IEventsDestroy> *object)
 {
     ASSERT(DCAST<GameObject *>(object));
     if (GameObject *go = SCAST<GameObject *>(object))
     {
+        auto elementsIt = m_iLayoutElementsPerGameObject.Find(go);
+        if (elementsIt != m_iLayoutElementsPerGameObject.End())
+        {
+            delete elementsIt->second;
+            m_iLayoutElementsPerGameObject.Remove(elementsIt);
+        }
+
+        auto controllersIt = m_iLayoutControllersPerGameObject.Find(go);
+        if (controllersIt != m_iLayoutControllersPerGameObject.End())
+        {
+            delete controllersIt->second;
+            m_iLayoutControllersPerGameObject.Remove(controllersIt);
+        }
+
+        m_invalidElementsGos.Remove(go);
+        m_invalidControllersGos.Remove(go);
+        m_newInvalidElementsGos.RemoveAll(go);
+        m_newInvalidControllersGos.RemoveAll(go);
+    }
+}
+
+void UILayoutManager::ClaimInvalidations(GameObject *attachedGo)
+{
+    // Nested canvases get forwarded their own ones in the next rebuild
+    if (UILayoutManager *activeLM = UILayoutManager::GetActive(attachedGo))
+    {
+        for (ILayoutElement *le :
+             attachedGo->GetComponentsInDescendantsAndThis<ILayoutElement>())
+        {
+            if (le->IsInvalid())
+            {
+                activeLM->PropagateInvalidation(le);
+            }
+        }
+
+        for (ILayoutController *lc :
+             attachedGo
+                 ->GetComponentsInDescendantsAndThis<ILayoutController>())
+        {
+            if (lc->IsInvalid())
+            {
+                activeLM->PropagateInvalidation(lc);
+            }
+        }
+    }
+}
+
+void UILayoutManager::ClaimInvalidations(Component *addedComponent)
+{
+    if (UILayoutManager *activeLM = UILayoutManager::GetActive(addedComponent))
+    {
+        ILayoutElement *le = DCAST<ILayoutElement *>(addedComponent);
+        if (le && le->IsInvalid())
         {
-            auto it = m_iLayoutElementsPerGameObject.Find(go);
-            ASSERT(it != m_iLayoutElementsPerGameObject.End());
-            m_iLayoutElementsPerGameObject.Remove(it);
-            delete it->second;
+            activeLM->PropagateInvalidation(le);
         }
 
+        ILayoutController *lc = DCAST<ILayoutController *>(addedComponent);
+        if (lc && lc->IsInvalid())
         {
-            auto it = m_iLayoutControllersPerGameObject.Find(go);
-            ASSERT(it != m_iLayoutControllersPerGameObject.End());
-            m_iLayoutControllersPerGameObject.Remove(it);
-            delete it->second;
+            activeLM->PropagateInvalidation(lc);
         }
     }
 }
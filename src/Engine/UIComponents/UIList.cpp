@@ -9,9 +9,11 @@
 #include "Bang/GameObjectFactory.h"
 #include "Bang/IEventsDestroy.h"
 #include "Bang/IEventsUIList.h"
+#include "Bang/IUIListDataSource.h"
 #include "Bang/Input.h"
 #include "Bang/Key.h"
 #include "Bang/LayoutSizeType.h"
+#include "Bang/Math.h"
 #include "Bang/MouseButton.h"
 #include "Bang/Rect.h"
 #include "Bang/RectTransform.h"
@@ -20,6 +22,7 @@
 #include "Bang/UIContentSizeFitter.h"
 #include "Bang/UIFocusable.h"
 #include "Bang/UIImageRenderer.h"
+#include "Bang/UILayoutElement.h"
 #include "Bang/UIScrollArea.h"
 #include "Bang/UIScrollPanel.h"
 #include "Bang/UIVerticalLayout.h"
@@ -28,6 +31,8 @@
 
 using namespace Bang;
 
+const int UIList::VirtualMarginItems = 4;
+
 UIList::UIList()
 {
     SET_INSTANCE_CLASS_ID(UIList)
@@ -49,6 +54,7 @@ void UIList::AddItem(GOItem *newItem, int index)
 
 void UIList::MoveItem(GOItem *item, int index)
 {
+    ASSERT(!IsVirtualized());
     ASSERT(index >= 0 && index <= GetNumItems());
 
     int oldIndexOfItem = p_items.IndexOf(item);
@@ -74,23 +80,10 @@ void UIList::RemoveItem(GOItem *item)
 
 void UIList::AddItem_(GOItem *newItem, int index, bool moving)
 {
+    ASSERT(!IsVirtualized());
     ASSERT(index >= 0 && index <= GetNumItems());
 
-    Array<UIFocusable *> newItemFocusables =
-        newItem->GetComponentsInDescendantsAndThis<UIFocusable>();
-
-    UIImageRenderer *itemBg = newItem->AddComponent<UIImageRenderer>(0);
-    itemBg->SetTint(GetIdleColor());
-
-    for (UIFocusable *newItemFocusable : newItemFocusables)
-    {
-        newItemFocusable->EventEmitter<IEventsFocus>::RegisterListener(this);
-    }
-
-    newItem->EventEmitter<IEventsDestroy>::RegisterListener(this);
-    newItem->SetParent(GetContainer(), index);
-
-    p_itemsBackground.Add(newItem, itemBg);
+    SetupItem(newItem, index);
     p_items.Insert(newItem, index);
 
     if (!moving)
@@ -105,8 +98,29 @@ void UIList::AddItem_(GOItem *newItem, int index, bool moving)
     }
 }
 
+void UIList::SetupItem(GOItem *item, int indexInContainer)
+{
+    Array<UIFocusable *> itemFocusables =
+        item->GetComponentsInDescendantsAndThis<UIFocusable>();
+
+    UIImageRenderer *itemBg = item->AddComponent<UIImageRenderer>(0);
+    itemBg->SetTint(GetIdleColor());
+
+    for (UIFocusable *itemFocusable : itemFocusables)
+    {
+        itemFocusable->EventEmitter<IEventsFocus>::RegisterListener(this);
+    }
+
+    item->EventEmitter<IEventsDestroy>::RegisterListener(this);
+    item->SetParent(GetContainer(), indexInContainer);
+
+    p_itemsBackground.Add(item, itemBg);
+}
+
 void UIList::RemoveItem_(GOItem *item, bool moving)
 {
+    ASSERT(!IsVirtualized());
+
     int indexOfItem = p_items.IndexOf(item);
     if (indexOfItem < 0)
     {
@@ -255,6 +269,12 @@ void UIList::ClearSelection()
 
 void UIList::Clear()
 {
+    if (IsVirtualized())
+    {
+        DestroyVirtualItems(true);
+        p_dataSource = nullptr;
+    }
+
     while (!p_items.IsEmpty())
     {
         RemoveItem(p_items.Back());
@@ -280,6 +300,14 @@ const Array<GOItem *> &UIList::GetItems() const
 
 GOItem *UIList::GetItem(int i) const
 {
+    if (IsVirtualized())
+    {
+        const int rowIndex = (i - m_firstVirtualIndex);
+        return (rowIndex >= 0 && rowIndex < SCAST<int>(p_items.Size()))
+                   ? p_items[rowIndex]
+                   : nullptr;
+    }
+
     if (i >= 0 && i < SCAST<int>(p_items.Size()))
     {
         return GetItems()[i];
@@ -299,11 +327,48 @@ void UIList::ScrollToBegin()
 
 void UIList::ScrollTo(int i)
 {
-    ScrollTo(GetItem(i));
+    if (!IsVirtualized())
+    {
+        ScrollTo(GetItem(i));
+        return;
+    }
+
+    // The row of the item may not exist, so scroll using the model index
+    UIScrollPanel *scrollPanel = GetScrollPanel();
+    if (!scrollPanel || i < 0 || i >= GetNumItems())
+    {
+        return;
+    }
+
+    const int itemHeight = Math::Max(GetDataSource()->GetItemHeight(), 1);
+    const int viewHeight = SCAST<int>(scrollPanel->GetContainerSize().y);
+    const int itemTop = (i * itemHeight);
+    const int itemBot = (itemTop + itemHeight);
+    int scrollingY = scrollPanel->GetScrolling().y;
+    if (itemTop < scrollingY)
+    {
+        scrollingY = itemTop;
+    }
+    else if (itemBot > scrollingY + viewHeight)
+    {
+        scrollingY = (itemBot - viewHeight);
+    }
+
+    if (scrollingY != scrollPanel->GetScrolling().y)
+    {
+        scrollPanel->SetScrolling(Vector2i(0, scrollingY));
+    }
+    UpdateVirtualItems();
 }
 
 void UIList::ScrollTo(GOItem *item)
 {
+    if (IsVirtualized())
+    {
+        ScrollTo(GetItemIndex(item));
+        return;
+    }
+
     if (!GetScrollPanel())
     {
         return;
@@ -357,6 +422,10 @@ void UIList::ScrollToEnd()
 
 int UIList::GetNumItems() const
 {
+    if (IsVirtualized())
+    {
+        return GetDataSource()->GetNumItems();
+    }
     return p_items.Size();
 }
 
@@ -378,11 +447,12 @@ void UIList::SetSelection(int index)
 
         if (index >= 0 && index < GetNumItems())
         {
+            // Scroll first, so that virtualized lists bind its row
             m_selectionIndex = index;
+            ScrollTo(index);
             GOItem *selectedItem = GetSelectedItem();
             if (selectedItem)
             {
-                ScrollTo(selectedItem);
                 GetItemBg(selectedItem)->SetTint(GetSelectedColor());
                 CallSelectionCallback(selectedItem, Action::SELECTION_IN);
             }
@@ -483,6 +553,7 @@ UIEventResult UIList::OnUIEvent(UIFocusable *, const UIEvent &event)
                             break;
                         }
                     } while (newSelectedIndex != GetSelectedIndex() &&
+                             newSelectedItem &&
                              !newSelectedItem->IsEnabledRecursively());
                 }
                 break;
@@ -521,7 +592,7 @@ UIEventResult UIList::OnUIEvent(UIFocusable *, const UIEvent &event)
 
 void UIList::SetSelection(GOItem *item)
 {
-    SetSelection(p_items.IndexOf(item));
+    SetSelection(GetItemIndex(item));
 }
 
 GameObject *UIList::GetContainer() const
@@ -558,6 +629,214 @@ void UIList::SetWideSelectionMode(bool wideSelectionMode)
     m_wideSelectionMode = wideSelectionMode;
 }
 
+void UIList::SetDataSource(IUIListDataSource *dataSource)
+{
+    if (dataSource == GetDataSource())
+    {
+        RefreshItems();
+        return;
+    }
+
+    Clear();
+    p_dataSource = dataSource;
+    if (dataSource)
+    {
+        // The spacers take the place of the rows above and below the
+        // visible ones, so that the container keeps the full model height
+        p_virtualTopSpacer =
+            GameObjectFactory::CreateUIVSpacer(LayoutSizeType::MIN, 0);
+        p_virtualTopSpacer->SetParent(GetContainer());
+        p_virtualBotSpacer =
+            GameObjectFactory::CreateUIVSpacer(LayoutSizeType::MIN, 0);
+        p_virtualBotSpacer->SetParent(GetContainer());
+
+        m_firstVirtualIndex = 0;
+        RefreshItems();
+    }
+}
+
+void UIList::RefreshItems()
+{
+    if (!IsVirtualized())
+    {
+        return;
+    }
+
+    if (GetSelectedIndex() >= GetNumItems())
+    {
+        ClearSelection();
+    }
+
+    // Rows have their height fixed on creation
+    if (GetDataSource()->GetItemHeight() != m_virtualItemHeight)
+    {
+        DestroyVirtualItems(false);
+        m_virtualItemHeight = GetDataSource()->GetItemHeight();
+    }
+
+    m_virtualItemsInvalid = true;
+    UpdateVirtualItems();
+}
+
+IUIListDataSource *UIList::GetDataSource() const
+{
+    return p_dataSource;
+}
+
+bool UIList::IsVirtualized() const
+{
+    return (GetDataSource() != nullptr);
+}
+
+int UIList::GetItemIndex(GOItem *item) const
+{
+    const int rowIndex = p_items.IndexOf(item);
+    if (rowIndex >= 0 && IsVirtualized())
+    {
+        return (m_firstVirtualIndex + rowIndex);
+    }
+    return rowIndex;
+}
+
+void UIList::OnUpdate()
+{
+    Component::OnUpdate();
+    if (IsVirtualized())
+    {
+        UpdateVirtualItems();
+    }
+}
+
+void UIList::UpdateVirtualItems()
+{
+    IUIListDataSource *dataSource = GetDataSource();
+    const int numItems = dataSource->GetNumItems();
+    const int itemHeight = Math::Max(m_virtualItemHeight, 1);
+
+    int viewTop = 0;
+    int viewHeight = 0;
+    if (UIScrollPanel *scrollPanel = GetScrollPanel())
+    {
+        viewTop = Math::Max(scrollPanel->GetScrolling().y, 0);
+        viewHeight = SCAST<int>(scrollPanel->GetContainerSize().y);
+    }
+    else
+    {
+        RectTransform *rt = GetGameObject()->GetRectTransform();
+        viewHeight = SCAST<int>(AARect(rt->GetViewportRect()).GetHeight());
+    }
+
+    int firstIndex = 0, numRows = 0;
+    UIList::GetVirtualRange(
+        numItems, itemHeight, viewTop, viewHeight, &firstIndex, &numRows);
+
+    // The pool only changes when the list is resized
+    while (SCAST<int>(p_items.Size()) < numRows)
+    {
+        GOItem *row = dataSource->CreateItem();
+        UILayoutElement *rowLE = row->AddComponent<UILayoutElement>();
+        rowLE->SetLayoutPriority(1);
+        rowLE->SetMinHeight(itemHeight);
+        rowLE->SetPreferredHeight(itemHeight);
+        rowLE->SetFlexibleHeight(0.0f);
+
+        SetupItem(row, p_items.Size() + 1);
+        p_items.PushBack(row);
+        m_virtualItemsInvalid = true;
+    }
+
+    while (SCAST<int>(p_items.Size()) > numRows)
+    {
+        GOItem *row = p_items.Back();
+        if (p_itemUnderMouse == row)
+        {
+            p_itemUnderMouse = nullptr;
+        }
+        p_items.Remove(row);
+        p_itemsBackground.Remove(row);
+        GameObject::Destroy(row);
+        m_virtualItemsInvalid = true;
+    }
+
+    if (firstIndex == m_firstVirtualIndex && !m_virtualItemsInvalid)
+    {
+        return;
+    }
+
+    m_firstVirtualIndex = firstIndex;
+    m_virtualItemsInvalid = false;
+    for (int i = 0; i < numRows; ++i)
+    {
+        GOItem *row = p_items[i];
+        const int index = (firstIndex + i);
+        dataSource->BindItem(row, index);
+
+        if (UIImageRenderer *rowBg = GetItemBg(row))
+        {
+            if (index == GetSelectedIndex())
+            {
+                rowBg->SetTint(GetSelectedColor());
+            }
+            else
+            {
+                rowBg->SetTint(row == p_itemUnderMouse ? GetOverColor()
+                                                       : GetIdleColor());
+            }
+        }
+    }
+
+    const int topSpace = (firstIndex * itemHeight);
+    const int botSpace = ((numItems - firstIndex - numRows) * itemHeight);
+    UILayoutElement *topLE =
+        p_virtualTopSpacer->GetComponent<UILayoutElement>();
+    topLE->SetMinHeight(topSpace);
+    topLE->SetPreferredHeight(topSpace);
+    UILayoutElement *botLE =
+        p_virtualBotSpacer->GetComponent<UILayoutElement>();
+    botLE->SetMinHeight(botSpace);
+    botLE->SetPreferredHeight(botSpace);
+}
+
+void UIList::GetVirtualRange(int numItems,
+                             int itemHeight,
+                             int viewTop,
+                             int viewHeight,
+                             int *firstIndex,
+                             int *numRows)
+{
+    itemHeight = Math::Max(itemHeight, 1);
+    *numRows = Math::Min(
+        Math::Max(viewHeight, 0) / itemHeight + 2 + VirtualMarginItems * 2,
+        Math::Max(numItems, 0));
+    *firstIndex = Math::Clamp(Math::Max(viewTop, 0) / itemHeight -
+                                  VirtualMarginItems,
+                              0,
+                              Math::Max(numItems - *numRows, 0));
+}
+
+void UIList::DestroyVirtualItems(bool destroySpacers)
+{
+    for (GOItem *row : p_items)
+    {
+        if (p_itemUnderMouse == row)
+        {
+            p_itemUnderMouse = nullptr;
+        }
+        p_itemsBackground.Remove(row);
+        GameObject::Destroy(row);
+    }
+    p_items.Clear();
+    m_virtualItemsInvalid = true;
+
+    if (destroySpacers)
+    {
+        GameObject::Destroy(p_virtualTopSpacer);
+        GameObject::Destroy(p_virtualBotSpacer);
+        p_virtualTopSpacer = nullptr;
+        p_virtualBotSpacer = nullptr;
+    }
+}
+
 void UIList::SetOverColor(const Color &overColor)
 {
     m_overColor = overColor;
@@ -5,6 +5,7 @@
 #include "Bang/GameObject.h"
 #include "Bang/MetaNode.h"
 #include "Bang/MetaNode.tcc"
+#include "Bang/UIBatcher.h"
 
 using namespace Bang;
 
@@ -46,6 +47,9 @@ void UIMask::OnAfterChildrenRender(RenderPass renderPass)
 
 void UIMask::PrepareStencilToDrawMask()
 {
+    // Batched UI must be drawn with the stencil state it was added with
+    UIBatcher::FlushActive();
+
     // Save values for later restoring
     m_colorMaskBefore = GL::GetColorMask();
     m_stencilFuncBefore = GL::GetStencilFunc();
@@ -63,6 +67,8 @@ void UIMask::PrepareStencilToDrawMask()
 
 void UIMask::PrepareStencilToDrawChildren()
 {
+    UIBatcher::FlushActive();
+
     // Restore color mask for children
     GL::SetColorMask(m_colorMaskBefore[0],
                      m_colorMaskBefore[1],
@@ -86,6 +92,7 @@ void UIMask::RestoreStencilBuffer(RenderPass renderPass)
     }
 
     // Restore stencil as it was before, decrementing marked mask pixels
+    UIBatcher::FlushActive();
     GL::SetColorMask(false, false, false, false);
     GL::SetStencilFunc(GL::Function::EQUAL);
     GL::SetStencilOp(GL::StencilOperation::DECR);
@@ -93,6 +100,7 @@ void UIMask::RestoreStencilBuffer(RenderPass renderPass)
     m_restoringStencil = true;
     GetGameObject()->Render(renderPass, false);
     m_restoringStencil = false;
+    UIBatcher::FlushActive();
 
     GL::SetStencilValue(GL::GetStencilValue() - 1);
     GL::SetColorMask(m_colorMaskBefore[0],
@@ -121,6 +129,14 @@ bool UIMask::IsDrawMask() const
     return true;
 }  // m_drawMask; }
 
+void UIMask::CloneInto(ICloneable *clone, bool cloneGUID) const
+{
+    Component::CloneInto(clone, cloneGUID);
+    UIMask *mask = SCAST<UIMask *>(clone);
+    mask->SetMasking(IsMasking());
+    mask->SetDrawMask(IsDrawMask());
+}
+
 void UIMask::ImportMeta(const MetaNode &metaNode)
 {
     Component::ImportMeta(metaNode);
@@ -8,6 +8,8 @@
 #include "Bang/MetaNode.tcc"
 #include "Bang/Rect.h"
 #include "Bang/RectTransform.h"
+#include "Bang/UIBatcher.h"
+#include "Bang/UIFocusIndex.h"
 
 using namespace Bang;
 
@@ -20,12 +22,25 @@ UIRectMask::~UIRectMask()
 {
 }
 
+void UIRectMask::OnEnabled(Object *object)
+{
+    Component::OnEnabled(object);
+    UIFocusIndex::Invalidate(GetGameObject());
+}
+
+void UIRectMask::OnDisabled(Object *object)
+{
+    Component::OnDisabled(object);
+    UIFocusIndex::Invalidate(GetGameObject());
+}
+
 void UIRectMask::OnBeforeChildrenRender(RenderPass renderPass)
 {
     Component::OnBeforeChildrenRender(renderPass);
 
     if (IsMasking() && renderPass == RenderPass::CANVAS)
     {
+        UIBatcher::FlushActive();
         m_wasScissorEnabled = GL::IsEnabled(GL::Enablable::SCISSOR_TEST);
         m_prevScissor = GL::GetScissorRect();
 
@@ -43,6 +58,7 @@ void UIRectMask::OnAfterChildrenRender(RenderPass renderPass)
     if (IsMasking() && renderPass == RenderPass::CANVAS)
     {
         // Restore
+        UIBatcher::FlushActive();
         GL::Scissor(m_prevScissor);
         GL::SetEnabled(GL::Enablable::SCISSOR_TEST, m_wasScissorEnabled);
     }
@@ -50,13 +66,24 @@ void UIRectMask::OnAfterChildrenRender(RenderPass renderPass)
 
 void UIRectMask::SetMasking(bool maskEnabled)
 {
-    m_masking = maskEnabled;
+    if (maskEnabled != IsMasking())
+    {
+        m_masking = maskEnabled;
+        UIFocusIndex::Invalidate(GetGameObject());
+    }
 }
 bool UIRectMask::IsMasking() const
 {
     return m_masking;
 }
 
+void UIRectMask::CloneInto(ICloneable *clone, bool cloneGUID) const
+{
+    Component::CloneInto(clone, cloneGUID);
+    UIRectMask *rectMask = SCAST<UIRectMask *>(clone);
+    rectMask->SetMasking(IsMasking());
+}
+
 void UIRectMask::ImportMeta(const MetaNode &metaNode)
 {
     Component::ImportMeta(metaNode);
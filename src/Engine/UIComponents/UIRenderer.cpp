@@ -3,11 +3,15 @@
 #include "Bang/AARect.h"
 #include "Bang/ClassDB.h"
 #include "Bang/EventListener.tcc"
+#include "Bang/GEngine.h"
 #include "Bang/GL.h"
 #include "Bang/GameObject.h"
 #include "Bang/IEventsChildren.h"
 #include "Bang/IEventsTransform.h"
+#include "Bang/Material.h"
 #include "Bang/RectTransform.h"
+#include "Bang/ShaderProgramProperties.h"
+#include "Bang/UIBatcher.h"
 
 namespace Bang
 {
@@ -49,11 +53,55 @@ void UIRenderer::OnRender(RenderPass renderPass)
 
         if (render)
         {
-            Renderer::OnRender(renderPass);
+            if (TryAddToBatch(renderPass))
+            {
+                Component::OnRender(renderPass);
+            }
+            else
+            {
+                Renderer::OnRender(renderPass);
+            }
         }
     }
 }
 
+bool UIRenderer::AddToBatch(UIBatcher *)
+{
+    return false;
+}
+
+bool UIRenderer::TryAddToBatch(RenderPass renderPass)
+{
+    UIBatcher *batcher = UIBatcher::GetActive();
+    if (!batcher || !batcher->IsEnabled() ||
+        renderPass != RenderPass::CANVAS ||
+        GetViewProjMode() != GL::ViewProjMode::CANVAS)
+    {
+        return false;
+    }
+
+    // Replacement materials (selection and so on) need the regular path
+    GEngine *ge = GEngine::GetInstance();
+    Material *mat = GetActiveMaterial();
+    if (ge->GetReplacementMaterial() || !mat ||
+        !GetGameObject()->IsVisibleRecursively() || !IsVisible())
+    {
+        return false;
+    }
+
+    const ShaderProgramProperties &spProps = mat->GetShaderProgramProperties();
+    if (spProps.GetRenderPass() != renderPass ||
+        GetRenderPrimitive() != GL::Primitive::TRIANGLES ||
+        spProps.GetCullFace() != GL::CullFaceExt::NONE ||
+        spProps.GetWireframe())
+    {
+        return false;
+    }
+
+    batcher->SetDepthMask(GetDepthMask());
+    return AddToBatch(batcher);
+}
+
 void UIRenderer::SetCullByRectTransform(bool cullByRectTransform)
 {
     m_cullByRectTransform = cullByRectTransform;
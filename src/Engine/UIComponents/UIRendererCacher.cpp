@@ -23,6 +23,7 @@
 #include "Bang/Renderer.h"
 #include "Bang/Texture2D.h"
 #include "Bang/Transform.h"
+#include "Bang/UIBatcher.h"
 #include "Bang/UIImageRenderer.h"
 #include "Bang/Vector2.h"
 
@@ -77,6 +78,8 @@ void UIRendererCacher::OnRender(RenderPass renderPass)
     {
         if (IsCachingEnabled() && m_needNewImageToSnapshot)
         {
+            // Batched UI has to land in the framebuffer it was added for
+            UIBatcher::FlushActive();
             GL::Push(GL::Pushable::FRAMEBUFFER_AND_READ_DRAW_ATTACHMENTS);
             GL::Push(GL::Pushable::BLEND_STATES);
 
@@ -108,6 +111,7 @@ void UIRendererCacher::OnRender(RenderPass renderPass)
                                   GL::BlendFactor::ONE,
                                   GL::BlendFactor::ONE_MINUS_SRC_ALPHA);
             GetContainer()->Render(renderPass);
+            UIBatcher::FlushActive();
 
             GL::Pop(GL::Pushable::BLEND_STATES);
             GL::Pop(GL::Pushable::FRAMEBUFFER_AND_READ_DRAW_ATTACHMENTS);
@@ -15,6 +15,7 @@
 #include "Bang/Material.h"
 #include "Bang/MaterialFactory.h"
 #include "Bang/Math.h"
+#include "Bang/Matrix4.h"
 #include "Bang/Mesh.h"
 #include "Bang/MetaNode.h"
 #include "Bang/MetaNode.tcc"
@@ -22,7 +23,9 @@
 #include "Bang/Rect.h"
 #include "Bang/RectTransform.h"
 #include "Bang/TextFormatter.h"
+#include "Bang/UIBatcher.h"
 #include "Bang/Vector2.h"
+#include "Bang/Vector4.h"
 
 namespace Bang
 {
@@ -103,7 +106,10 @@ void UITextRenderer::CalculateLayout(Axis axis)
 
 void UITextRenderer::RegenerateCharQuadsVAO() const
 {
-    if (!IInvalidatable<UITextRenderer>::IsInvalid())
+    // Glyphs evicted from the font atlas invalidate the uvs we had
+    const bool atlasChanged =
+        (GetFont() && GetFont()->GetAtlasGeneration() != m_atlasGeneration);
+    if (!IInvalidatable<UITextRenderer>::IsInvalid() && !atlasChanged)
     {
         return;
     }
@@ -139,6 +145,10 @@ void UITextRenderer::RegenerateCharQuadsVAO() const
                                                  IsWrapping(),
                                                  &m_numberOfLines);
 
+    // Taken before reading the uvs. If reading them evicts glyphs of this same
+    // text, the generation will not match, and the quads are regenerated
+    const uint atlasGeneration = GetFont()->GetAtlasGeneration();
+
     // Generate quad positions and uvs for the mesh, and load them
     Array<Vector2> textQuadUvs;
     Array<Vector2> textQuadPos2D;
@@ -160,9 +170,8 @@ void UITextRenderer::RegenerateCharQuadsVAO() const
         Vector2f maxViewportNDC(
             GL::FromViewportPointToViewportPointNDC(maxPxPerf));
 
-        GetFont()->GetFontAtlas(GetTextSize());  // Load atlas
-        Vector2 minUv = GetFont()->GetCharMinUv(GetTextSize(), cr.character);
-        Vector2 maxUv = GetFont()->GetCharMaxUv(GetTextSize(), cr.character);
+        Vector2 minUv = GetFont()->GetCharMinUv(cr.character);
+        Vector2 maxUv = GetFont()->GetCharMaxUv(cr.character);
         // std::swap(minUv.y, maxUv.y);
 
         AARect charRectViewportNDC(minViewportNDC, maxViewportNDC);
@@ -200,6 +209,7 @@ void UITextRenderer::RegenerateCharQuadsVAO() const
     p_mesh.Get()->SetPositionsPool(textQuadPos3D);
     p_mesh.Get()->SetUvsPool(textQuadUvs);
     p_mesh.Get()->UpdateVAOs(false);
+    m_atlasGeneration = atlasGeneration;
 }
 
 void UITextRenderer::Bind()
@@ -208,9 +218,7 @@ void UITextRenderer::Bind()
 
     if (GetFont())
     {
-        const int textSize = Math::Max(GetTextSize(), 1);
-        Texture2D *fontAtlas = GetFont()->GetFontAtlas(textSize);
-        GetMaterial()->SetAlbedoTexture(fontAtlas);
+        GetMaterial()->SetAlbedoTexture(GetFont()->GetFontAtlas());
     }
 }
 
@@ -226,6 +234,44 @@ void UITextRenderer::OnRender()
     }
 }
 
+bool UITextRenderer::AddToBatch(UIBatcher *batcher)
+{
+    if (GetActiveMaterial()->GetBaseShaderProgram() !=
+        MaterialFactory::GetUIText().Get()->GetBaseShaderProgram())
+    {
+        return false;
+    }
+
+    RegenerateCharQuadsVAO();
+    if (GetFont())
+    {
+        GetMaterial()->SetAlbedoTexture(GetFont()->GetFontAtlas());
+    }
+
+    const Mesh *mesh = p_mesh.Get();
+    const uint vertCount = mesh->GetNumVerticesIds();
+    if (vertCount < 3)
+    {
+        return true;
+    }
+
+    Material *mat = GetActiveMaterial();
+    const int texSlot = batcher->AcquireTextureSlot(mat->GetAlbedoTexture());
+    const Matrix4 model = GetModelMatrixUniform();
+    const Array<Vector3> &positions = mesh->GetPositionsPool();
+    const Array<Vector2> &uvs = mesh->GetUvsPool();
+    for (uint i = 0; i < vertCount; ++i)
+    {
+        batcher->AddVertex((model * Vector4(positions[i], 1)).xyz(),
+                           uvs[i],
+                           mat->GetAlbedoColor(),
+                           texSlot,
+                           0.0f,
+                           UIBatcher::Mode::TEXT);
+    }
+    return true;
+}
+
 void UITextRenderer::UnBind()
 {
     UIRenderer::UnBind();
@@ -76,11 +76,9 @@ void UITree::OnUpdate()
             {
                 UITreeItemContainer *selectedItemCont =
                     SCAST<UITreeItemContainer *>(selItemCont);
-                GOItem *selectedItem = selectedItemCont->GetContainedItem();
 
                 bool isCollapsed = selectedItemCont->IsCollapsed();
-                int numChildren =
-                    GetItemTree(selectedItem)->GetChildren().Size();
+                int numChildren = GetRowNumChildren(selectedItemCont);
 
                 int newSelIndex = GetUIList()->GetSelectedIndex();
 
@@ -97,8 +95,7 @@ void UITree::OnUpdate()
                 if (newSelIndex == GetUIList()->GetSelectedIndex())
                 {
                     // Normal Collapse/UnCollapse
-                    GOItem *selectedItem = selectedItemCont->GetContainedItem();
-                    SetItemCollapsed(selectedItem, (collapseOnOff == -1));
+                    SetRowCollapsed(selectedItemCont, (collapseOnOff == -1));
                 }
                 else
                 {
@@ -122,8 +119,7 @@ UIEventResult UITree::OnUIEvent(UIFocusable *focusable, const UIEvent &event)
             cCollapseButton->GetGameObject()->GetParent());
         if (itemContainer)
         {
-            SetItemCollapsed(itemContainer->GetContainedItem(),
-                             !itemContainer->IsCollapsed());
+            SetRowCollapsed(itemContainer, !itemContainer->IsCollapsed());
         }
 
         return UIEventResult::INTERCEPT;
@@ -135,6 +131,10 @@ UIEventResult UITree::OnUIEvent(UIFocusable *focusable, const UIEvent &event)
 void UITree::OnDragStarted(EventEmitter<IEventsDragDrop> *dd_)
 {
     IEventsDragDrop::OnDragStarted(dd_);
+    if (IsVirtualized())
+    {
+        return;
+    }
 
     UIDragDroppable *dd = DCAST<UIDragDroppable *>(dd_);
     if (UITreeItemContainer *draggedTreeItemCont =
@@ -154,6 +154,10 @@ void UITree::OnDragStarted(EventEmitter<IEventsDragDrop> *dd_)
 void UITree::OnDragUpdate(EventEmitter<IEventsDragDrop> *dd_)
 {
     IEventsDragDrop::OnDragUpdate(dd_);
+    if (IsVirtualized())
+    {
+        return;
+    }
 
     UIDragDroppable *dragDroppable = DCAST<UIDragDroppable *>(dd_);
 
@@ -243,6 +247,10 @@ void UITree::OnDragUpdate(EventEmitter<IEventsDragDrop> *dd_)
 void UITree::OnDrop(EventEmitter<IEventsDragDrop> *dd_)
 {
     IEventsDragDrop::OnDrop(dd_);
+    if (IsVirtualized())
+    {
+        return;
+    }
 
     UIDragDroppable *dragDroppable = DCAST<UIDragDroppable *>(dd_);
 
@@ -372,6 +380,7 @@ void UITree::MoveItem(GOItem *itemToMove,
                       GOItem *newParentItem,
                       int newIndexInsideParent_)
 {
+    ASSERT(!IsVirtualized());
     ASSERT(!itemToMove || !DCAST<UITreeItemContainer *>(itemToMove));
     ASSERT(!ItemIsChildOfRecursive(newParentItem, itemToMove));
 
@@ -446,6 +455,7 @@ GOItem *UITree::AddItem_(GOItem *newItem,
                          int indexInsideParent,
                          bool moving)
 {
+    ASSERT(!IsVirtualized());
     ASSERT(!newItem || !DCAST<UITreeItemContainer *>(newItem));
 
     Tree<GOItem *> *parentTree = GetItemTree(parentItem);
@@ -588,10 +598,12 @@ void UITree::Clear()
     GetUIList()->Clear();
     m_rootTree.Clear();
     m_itemToTree.Clear();
+    m_virtualTree.SetDataSource(nullptr);
 }
 
 void UITree::SetSelection(GOItem *item)
 {
+    ASSERT(!IsVirtualized());
     ASSERT(!item || !DCAST<UITreeItemContainer *>(item));
 
     SetItemCollapsed(GetParentItem(item), false);
@@ -659,6 +671,140 @@ UIList *UITree::GetUIList() const
     return p_uiList;
 }
 
+void UITree::SetDataSource(IUITreeDataSource *dataSource)
+{
+    if (dataSource && !IsVirtualized())
+    {
+        Clear();
+    }
+
+    m_virtualTree.SetDataSource(dataSource);
+    GetUIList()->SetDataSource(dataSource ? this : nullptr);
+}
+
+void UITree::RefreshItems()
+{
+    if (IsVirtualized())
+    {
+        m_virtualTree.Refresh();
+        GetUIList()->RefreshItems();
+    }
+}
+
+void UITree::SetNodeCollapsed(NodeId node, bool collapsed)
+{
+    if (!IsVirtualized() || collapsed == IsNodeCollapsed(node))
+    {
+        return;
+    }
+
+    // The rows below the node shift, so the selection (a model index of the
+    // list) is moved along with its node. If the node gets hidden, the
+    // collapsed one is selected instead
+    NodeId selectedNode = 0;
+    const bool hasSelection = GetSelectedNode(&selectedNode);
+    m_virtualTree.SetExpanded(node, !collapsed);
+
+    int newSelectionIndex = -1;
+    if (hasSelection)
+    {
+        newSelectionIndex = m_virtualTree.GetVisibleNodeIndex(selectedNode);
+        if (newSelectionIndex < 0)
+        {
+            newSelectionIndex = m_virtualTree.GetVisibleNodeIndex(node);
+        }
+    }
+
+    const bool selectionMoved =
+        (hasSelection && newSelectionIndex != GetUIList()->GetSelectedIndex());
+    if (selectionMoved)
+    {
+        GetUIList()->ClearSelection();
+    }
+
+    GetUIList()->RefreshItems();
+
+    if (selectionMoved && newSelectionIndex >= 0)
+    {
+        GetUIList()->SetSelection(newSelectionIndex);
+    }
+}
+
+void UITree::SetSelectedNode(NodeId node)
+{
+    if (IsVirtualized())
+    {
+        GetUIList()->SetSelection(m_virtualTree.GetVisibleNodeIndex(node));
+    }
+}
+
+IUITreeDataSource *UITree::GetDataSource() const
+{
+    return m_virtualTree.GetDataSource();
+}
+
+bool UITree::IsVirtualized() const
+{
+    return (GetDataSource() != nullptr);
+}
+
+bool UITree::IsNodeCollapsed(NodeId node) const
+{
+    return !m_virtualTree.IsExpanded(node);
+}
+
+bool UITree::GetSelectedNode(NodeId *node) const
+{
+    const int selectedIndex = GetUIList()->GetSelectedIndex();
+    if (!IsVirtualized() || selectedIndex < 0 ||
+        selectedIndex >= m_virtualTree.GetNumVisibleNodes())
+    {
+        return false;
+    }
+
+    *node = m_virtualTree.GetVisibleNode(selectedIndex);
+    return true;
+}
+
+const UIVirtualTree &UITree::GetVirtualTree() const
+{
+    return m_virtualTree;
+}
+
+int UITree::GetNumItems() const
+{
+    return m_virtualTree.GetNumVisibleNodes();
+}
+
+int UITree::GetItemHeight() const
+{
+    return GetDataSource()->GetItemHeight();
+}
+
+GameObject *UITree::CreateItem()
+{
+    UITreeItemContainer *itemCont = new UITreeItemContainer();
+    itemCont->SetContainedItem(GetDataSource()->CreateItem());
+    itemCont->GetDragDroppable()->SetEnabled(false);
+    itemCont->GetCollapseButton()
+        ->GetFocusable()
+        ->EventEmitter<IEventsFocus>::RegisterListener(this);
+    return itemCont;
+}
+
+void UITree::BindItem(GameObject *item, int index)
+{
+    // Same indentation as the top level items of the normal mode, which hang
+    // from the root tree
+    UITreeItemContainer *itemCont = SCAST<UITreeItemContainer *>(item);
+    const NodeId node = m_virtualTree.GetVisibleNode(index);
+    const int depth = m_virtualTree.GetVisibleNodeDepth(index);
+    itemCont->SetIndentation(UITree::IndentationPx * (depth + 1));
+    itemCont->SetCollapsable(GetDataSource()->GetNumChildren(node) > 0);
+    itemCont->SetCollapsed(IsNodeCollapsed(node));
+    GetDataSource()->BindItem(itemCont->GetContainedItem(), node);
+}
+
 void UITree::GetMousePositionInTree(
     GOItem **itemOverOut,
     UITree::MouseItemRelativePosition *itemRelPosOut) const
@@ -841,6 +987,33 @@ void UITree::IndentItem(GOItem *item)
                                                itemTree->GetDepth());
 }
 
+void UITree::SetRowCollapsed(UITreeItemContainer *itemCont, bool collapsed)
+{
+    if (IsVirtualized())
+    {
+        SetNodeCollapsed(GetRowNode(itemCont), collapsed);
+    }
+    else
+    {
+        SetItemCollapsed(itemCont->GetContainedItem(), collapsed);
+    }
+}
+
+int UITree::GetRowNumChildren(UITreeItemContainer *itemCont) const
+{
+    if (IsVirtualized())
+    {
+        return GetDataSource()->GetNumChildren(GetRowNode(itemCont));
+    }
+    return GetItemTree(itemCont->GetContainedItem())->GetChildren().Size();
+}
+
+UITree::NodeId UITree::GetRowNode(UITreeItemContainer *itemCont) const
+{
+    ASSERT(IsVirtualized());
+    return m_virtualTree.GetVisibleNode(GetUIList()->GetItemIndex(itemCont));
+}
+
 bool UITree::Contains(UITreeItemContainer *itemCont) const
 {
     return itemCont && GetUIList()->GetItems().Contains(itemCont);
@@ -0,0 +1,130 @@
+#include "Bang/UIVirtualTree.h"
+
+#include "Bang/Array.tcc"
+#include "Bang/Assert.h"
+#include "Bang/USet.tcc"
+
+using namespace Bang;
+
+constexpr IUITreeDataSource::NodeId IUITreeDataSource::RootNode;
+
+void UIVirtualTree::SetDataSource(IUITreeDataSource *dataSource)
+{
+    p_dataSource = dataSource;
+    m_expandedNodes.Clear();
+    Refresh();
+}
+
+void UIVirtualTree::Refresh()
+{
+    m_visibleNodes.Clear();
+    if (GetDataSource())
+    {
+        AppendVisibleChildren(IUITreeDataSource::RootNode, 0, &m_visibleNodes);
+    }
+}
+
+void UIVirtualTree::SetExpanded(NodeId node, bool expanded)
+{
+    if (expanded == IsExpanded(node))
+    {
+        return;
+    }
+
+    if (expanded)
+    {
+        m_expandedNodes.Add(node);
+    }
+    else
+    {
+        m_expandedNodes.Remove(node);
+    }
+
+    // Only its descendants change, and only if it is visible itself
+    const int index = GetVisibleNodeIndex(node);
+    if (index < 0)
+    {
+        return;
+    }
+
+    const int depth = m_visibleNodes[index].depth;
+    if (expanded)
+    {
+        Array<VisibleNode> visibleNodes;
+        visibleNodes.Reserve(m_visibleNodes.Size());
+        visibleNodes.PushBack(m_visibleNodes.Begin(),
+                              m_visibleNodes.Begin() + index + 1);
+        AppendVisibleChildren(node, depth + 1, &visibleNodes);
+        visibleNodes.PushBack(m_visibleNodes.Begin() + index + 1,
+                              m_visibleNodes.End());
+        m_visibleNodes = visibleNodes;
+    }
+    else
+    {
+        int end = index + 1;
+        while (end < GetNumVisibleNodes() && m_visibleNodes[end].depth > depth)
+        {
+            ++end;
+        }
+        m_visibleNodes.Remove(m_visibleNodes.Begin() + index + 1,
+                              m_visibleNodes.Begin() + end);
+    }
+}
+
+bool UIVirtualTree::IsExpanded(NodeId node) const
+{
+    return m_expandedNodes.Contains(node);
+}
+
+int UIVirtualTree::GetNumVisibleNodes() const
+{
+    return SCAST<int>(m_visibleNodes.Size());
+}
+
+UIVirtualTree::NodeId UIVirtualTree::GetVisibleNode(int index) const
+{
+    ASSERT(index >= 0 && index < GetNumVisibleNodes());
+    return m_visibleNodes[index].node;
+}
+
+int UIVirtualTree::GetVisibleNodeDepth(int index) const
+{
+    ASSERT(index >= 0 && index < GetNumVisibleNodes());
+    return m_visibleNodes[index].depth;
+}
+
+int UIVirtualTree::GetVisibleNodeIndex(NodeId node) const
+{
+    for (int i = 0; i < GetNumVisibleNodes(); ++i)
+    {
+        if (m_visibleNodes[i].node == node)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+IUITreeDataSource *UIVirtualTree::GetDataSource() const
+{
+    return p_dataSource;
+}
+
+void UIVirtualTree::AppendVisibleChildren(
+    NodeId node,
+    int depth,
+    Array<VisibleNode> *visibleNodes) const
+{
+    const int numChildren = GetDataSource()->GetNumChildren(node);
+    for (int i = 0; i < numChildren; ++i)
+    {
+        VisibleNode child;
+        child.node = GetDataSource()->GetChild(node, i);
+        child.depth = depth;
+        visibleNodes->PushBack(child);
+        if (IsExpanded(child.node))
+        {
+            AppendVisibleChildren(child.node, depth + 1, visibleNodes);
+        }
+    }
+}
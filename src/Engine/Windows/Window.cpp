@@ -106,6 +106,11 @@ void Window::Update()
 void Window::Render()
 {
     GetSceneManager()->Render();
+
+    if (GEngine *ge = GEngine::GetInstance())
+    {
+        ge->EndFrame();
+    }
 }
 
 bool Window::HandleEvent(const SDL_Event &sdlEvent)